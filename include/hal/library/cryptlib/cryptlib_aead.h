@@ -76,6 +76,96 @@ extern bool libspdm_aead_aes_gcm_decrypt(const uint8_t *key, size_t key_size,
                                          const uint8_t *data_in, size_t data_in_size,
                                          const uint8_t *tag, size_t tag_size,
                                          uint8_t *data_out, size_t *data_out_size);
+
+/**
+ * Allocates and initializes one AEAD AES-GCM context for subsequent use.
+ *
+ * The context holds the key set by libspdm_aead_aes_gcm_set_key, so that the encryption
+ * and decryption with the context do not allocate memory.
+ *
+ * @return  Pointer to the AEAD AES-GCM context that has been initialized.
+ *          If the allocations fails or the context is not supported, NULL is returned.
+ **/
+extern void *libspdm_aead_aes_gcm_new(void);
+
+/**
+ * Release the specified AEAD AES-GCM context.
+ *
+ * @param[in]  aead_ctx  Pointer to the AEAD AES-GCM context to be released.
+ **/
+extern void libspdm_aead_aes_gcm_free(void *aead_ctx);
+
+/**
+ * Set the key of an AEAD AES-GCM context.
+ *
+ * key_size must be 16, 24 or 32, otherwise false is returned.
+ *
+ * @param[in, out]  aead_ctx  Pointer to the AEAD AES-GCM context.
+ * @param[in]       key       Pointer to the encryption key.
+ * @param[in]       key_size  Size of the encryption key in bytes.
+ *
+ * @retval true   The key is set.
+ * @retval false  The key is not set.
+ **/
+extern bool libspdm_aead_aes_gcm_set_key(void *aead_ctx, const uint8_t *key, size_t key_size);
+
+/**
+ * Performs AEAD AES-GCM authenticated encryption with the key of an AEAD context.
+ *
+ * iv_size must be 12, otherwise false is returned.
+ * tag_size must be 12, 13, 14, 15, 16, otherwise false is returned.
+ *
+ * @param[in, out]  aead_ctx       Pointer to the AEAD AES-GCM context.
+ * @param[in]       iv             Pointer to the IV value.
+ * @param[in]       iv_size        Size of the IV value in bytes.
+ * @param[in]       a_data         Pointer to the additional authenticated data.
+ * @param[in]       a_data_size    Size of the additional authenticated data in bytes.
+ * @param[in]       data_in        Pointer to the input data buffer to be encrypted.
+ * @param[in]       data_in_size   Size of the input data buffer in bytes.
+ * @param[out]      tag_out        Pointer to a buffer that receives the authentication tag.
+ * @param[in]       tag_size       Size of the authentication tag in bytes.
+ * @param[out]      data_out       Pointer to a buffer that receives the encryption output.
+ * @param[out]      data_out_size  Size of the output data buffer in bytes.
+ *
+ * @retval true   AEAD AES-GCM authenticated encryption succeeded.
+ * @retval false  AEAD AES-GCM authenticated encryption failed.
+ **/
+extern bool libspdm_aead_aes_gcm_encrypt_with_context(void *aead_ctx,
+                                                      const uint8_t *iv, size_t iv_size,
+                                                      const uint8_t *a_data, size_t a_data_size,
+                                                      const uint8_t *data_in, size_t data_in_size,
+                                                      uint8_t *tag_out, size_t tag_size,
+                                                      uint8_t *data_out, size_t *data_out_size);
+
+/**
+ * Performs AEAD AES-GCM authenticated decryption with the key of an AEAD context.
+ *
+ * iv_size must be 12, otherwise false is returned.
+ * tag_size must be 12, 13, 14, 15, 16, otherwise false is returned.
+ *
+ * If data verification fails, false is returned.
+ *
+ * @param[in, out]  aead_ctx       Pointer to the AEAD AES-GCM context.
+ * @param[in]       iv             Pointer to the IV value.
+ * @param[in]       iv_size        Size of the IV value in bytes.
+ * @param[in]       a_data         Pointer to the additional authenticated data.
+ * @param[in]       a_data_size    Size of the additional authenticated data in bytes.
+ * @param[in]       data_in        Pointer to the input data buffer to be decrypted.
+ * @param[in]       data_in_size   Size of the input data buffer in bytes.
+ * @param[in]       tag            Pointer to a buffer that contains the authentication tag.
+ * @param[in]       tag_size       Size of the authentication tag in bytes.
+ * @param[out]      data_out       Pointer to a buffer that receives the decryption output.
+ * @param[out]      data_out_size  Size of the output data buffer in bytes.
+ *
+ * @retval true   AEAD AES-GCM authenticated decryption succeeded.
+ * @retval false  AEAD AES-GCM authenticated decryption failed.
+ **/
+extern bool libspdm_aead_aes_gcm_decrypt_with_context(void *aead_ctx,
+                                                      const uint8_t *iv, size_t iv_size,
+                                                      const uint8_t *a_data, size_t a_data_size,
+                                                      const uint8_t *data_in, size_t data_in_size,
+                                                      const uint8_t *tag, size_t tag_size,
+                                                      uint8_t *data_out, size_t *data_out_size);
 #endif /* LIBSPDM_AEAD_GCM_SUPPORT */
 
 #if LIBSPDM_AEAD_CHACHA20_POLY1305_SUPPORT
@@ -140,6 +230,95 @@ extern bool libspdm_aead_chacha20_poly1305_decrypt(
     size_t iv_size, const uint8_t *a_data, size_t a_data_size,
     const uint8_t *data_in, size_t data_in_size, const uint8_t *tag,
     size_t tag_size, uint8_t *data_out, size_t *data_out_size);
+
+/**
+ * Allocates and initializes one AEAD ChaCha20Poly1305 context for subsequent use.
+ *
+ * The context holds the key set by libspdm_aead_chacha20_poly1305_set_key, so that the encryption
+ * and decryption with the context do not allocate memory.
+ *
+ * @return  Pointer to the AEAD ChaCha20Poly1305 context that has been initialized.
+ *          If the allocations fails or the context is not supported, NULL is returned.
+ **/
+extern void *libspdm_aead_chacha20_poly1305_new(void);
+
+/**
+ * Release the specified AEAD ChaCha20Poly1305 context.
+ *
+ * @param[in]  aead_ctx  Pointer to the AEAD ChaCha20Poly1305 context to be released.
+ **/
+extern void libspdm_aead_chacha20_poly1305_free(void *aead_ctx);
+
+/**
+ * Set the key of an AEAD ChaCha20Poly1305 context.
+ *
+ * key_size must be 32, otherwise false is returned.
+ *
+ * @param[in, out]  aead_ctx  Pointer to the AEAD ChaCha20Poly1305 context.
+ * @param[in]       key       Pointer to the encryption key.
+ * @param[in]       key_size  Size of the encryption key in bytes.
+ *
+ * @retval true   The key is set.
+ * @retval false  The key is not set.
+ **/
+extern bool libspdm_aead_chacha20_poly1305_set_key(void *aead_ctx, const uint8_t *key,
+                                                   size_t key_size);
+
+/**
+ * Performs AEAD ChaCha20Poly1305 authenticated encryption with the key of an AEAD context.
+ *
+ * iv_size must be 12, otherwise false is returned.
+ * tag_size must be 16, otherwise false is returned.
+ *
+ * @param[in, out]  aead_ctx       Pointer to the AEAD ChaCha20Poly1305 context.
+ * @param[in]       iv             Pointer to the IV value.
+ * @param[in]       iv_size        Size of the IV value in bytes.
+ * @param[in]       a_data         Pointer to the additional authenticated data.
+ * @param[in]       a_data_size    Size of the additional authenticated data in bytes.
+ * @param[in]       data_in        Pointer to the input data buffer to be encrypted.
+ * @param[in]       data_in_size   Size of the input data buffer in bytes.
+ * @param[out]      tag_out        Pointer to a buffer that receives the authentication tag.
+ * @param[in]       tag_size       Size of the authentication tag in bytes.
+ * @param[out]      data_out       Pointer to a buffer that receives the encryption output.
+ * @param[out]      data_out_size  Size of the output data buffer in bytes.
+ *
+ * @retval true   AEAD ChaCha20Poly1305 authenticated encryption succeeded.
+ * @retval false  AEAD ChaCha20Poly1305 authenticated encryption failed.
+ **/
+extern bool libspdm_aead_chacha20_poly1305_encrypt_with_context(
+    void *aead_ctx, const uint8_t *iv, size_t iv_size,
+    const uint8_t *a_data, size_t a_data_size,
+    const uint8_t *data_in, size_t data_in_size, uint8_t *tag_out,
+    size_t tag_size, uint8_t *data_out, size_t *data_out_size);
+
+/**
+ * Performs AEAD ChaCha20Poly1305 authenticated decryption with the key of an AEAD context.
+ *
+ * iv_size must be 12, otherwise false is returned.
+ * tag_size must be 16, otherwise false is returned.
+ *
+ * If data verification fails, false is returned.
+ *
+ * @param[in, out]  aead_ctx       Pointer to the AEAD ChaCha20Poly1305 context.
+ * @param[in]       iv             Pointer to the IV value.
+ * @param[in]       iv_size        Size of the IV value in bytes.
+ * @param[in]       a_data         Pointer to the additional authenticated data.
+ * @param[in]       a_data_size    Size of the additional authenticated data in bytes.
+ * @param[in]       data_in        Pointer to the input data buffer to be decrypted.
+ * @param[in]       data_in_size   Size of the input data buffer in bytes.
+ * @param[in]       tag            Pointer to a buffer that contains the authentication tag.
+ * @param[in]       tag_size       Size of the authentication tag in bytes.
+ * @param[out]      data_out       Pointer to a buffer that receives the decryption output.
+ * @param[out]      data_out_size  Size of the output data buffer in bytes.
+ *
+ * @retval true   AEAD ChaCha20Poly1305 authenticated decryption succeeded.
+ * @retval false  AEAD ChaCha20Poly1305 authenticated decryption failed.
+ **/
+extern bool libspdm_aead_chacha20_poly1305_decrypt_with_context(
+    void *aead_ctx, const uint8_t *iv, size_t iv_size,
+    const uint8_t *a_data, size_t a_data_size,
+    const uint8_t *data_in, size_t data_in_size, const uint8_t *tag,
+    size_t tag_size, uint8_t *data_out, size_t *data_out_size);
 #endif /* LIBSPDM_AEAD_CHACHA20_POLY1305_SUPPORT */
 
 #if LIBSPDM_AEAD_SM4_SUPPORT
@@ -33,6 +33,25 @@
  *                      based on the format string specified by format.
  **/
 extern void libspdm_debug_print(size_t error_level, const char *format, ...);
+
+#if LIBSPDM_DEBUG_LEVEL_FILTER_ENABLE
+/**
+ * Check if debug messages of the specified error level are enabled at run time.
+ *
+ * LIBSPDM_DEBUG calls this function before evaluating the arguments of a message, so it should be
+ * cheap. It is not called for the levels removed at compile time by LIBSPDM_DEBUG_LEVEL_MASK.
+ *
+ * @param  error_level  The error level of the debug message, either LIBSPDM_DEBUG_INFO or
+ *                      LIBSPDM_DEBUG_ERROR.
+ *
+ * @retval true   libspdm_debug_print() outputs messages of this level.
+ * @retval false  libspdm_debug_print() discards messages of this level.
+ **/
+extern bool libspdm_debug_print_enabled(size_t error_level);
+#else
+/* Every message compiled in is passed to libspdm_debug_print(), which filters it. */
+#define libspdm_debug_print_enabled(error_level) true
+#endif /* LIBSPDM_DEBUG_LEVEL_FILTER_ENABLE */
 #endif /* LIBSPDM_DEBUG_PRINT_ENABLE */
 
 #if LIBSPDM_DEBUG_ASSERT_ENABLE
@@ -77,6 +96,10 @@ extern void libspdm_debug_assert(const char *file_name, size_t line_number,
  * @param argument_list  List of arguments.
  *
  * Note that format_string and argument_list are the same as those defined by the C printf function.
+ *
+ * The message is removed at compile time if print_level is not in LIBSPDM_DEBUG_LEVEL_MASK. If
+ * LIBSPDM_DEBUG_LEVEL_FILTER_ENABLE is set, argument_list is only evaluated if
+ * libspdm_debug_print_enabled(print_level) returns true.
  **/
 #if LIBSPDM_DEBUG_PRINT_ENABLE
 #define LIBSPDM_DEBUG(expression) \
@@ -86,7 +109,10 @@ extern void libspdm_debug_assert(const char *file_name, size_t line_number,
 
 #define LIBSPDM_DEBUG_PRINT_INTERNAL(print_level, ...) \
     do { \
-        libspdm_debug_print(print_level, ## __VA_ARGS__); \
+        if ((((print_level) & (LIBSPDM_DEBUG_LEVEL_MASK)) != 0) && \
+            libspdm_debug_print_enabled(print_level)) { \
+            libspdm_debug_print(print_level, ## __VA_ARGS__); \
+        } \
     } while (false)
 
 #define LIBSPDM_DEBUG_INTERNAL(expression) LIBSPDM_DEBUG_PRINT_INTERNAL expression
@@ -54,6 +54,35 @@
 int libspdm_copy_mem(void *dst_buf, size_t dst_len,
                      const void *src_buf, size_t src_len);
 
+/**
+ * Copies bytes from a source buffer to a destination buffer that may overlap it.
+ *
+ * This function copies "src_len" bytes from "src_buf" to "dst_buf" as if the bytes were first
+ * copied to a temporary buffer.
+ *
+ * Asserts and returns a non-zero value if any of the following are true:
+ *   1) "src_buf" or "dst_buf" are NULL.
+ *   2) "src_len" or "dst_len" is greater than (SIZE_MAX >> 1).
+ *   3) "src_len" is greater than "dst_len".
+ *
+ * If any of these cases fail, a non-zero value is returned. Additionally if
+ * "dst_buf" points to a non-NULL value and "dst_len" is valid, then "dst_len"
+ * bytes of "dst_buf" are zeroed.
+ *
+ * This function follows the C11 cppreference description of memmove_s.
+ * https://en.cppreference.com/w/c/string/byte/memmove
+ *
+ * @param    dst_buf   Destination buffer to copy to.
+ * @param    dst_len   Maximum length in bytes of the destination buffer.
+ * @param    src_buf   Source buffer to copy from.
+ * @param    src_len   The number of bytes to copy from the source buffer.
+ *
+ * @return   0 on success. non-zero on error.
+ *
+ **/
+int libspdm_move_mem(void *dst_buf, size_t dst_len,
+                     const void *src_buf, size_t src_len);
+
 /**
  * Fills a target buffer with a byte value, and returns the target buffer.
  *
@@ -70,6 +70,35 @@ extern libspdm_return_t libspdm_measurement_collection(
     void *measurements,
     size_t *measurements_size);
 
+#if LIBSPDM_MEASUREMENT_COLLECTION_EX_SUPPORT
+/**
+ * Collect the device measurement, within an L1/L2 transcript.
+ *
+ * libspdm calls this function instead of libspdm_measurement_collection if
+ * LIBSPDM_MEASUREMENT_COLLECTION_EX_SUPPORT is 1. The parameters are the same, except for
+ * "transcript_state".
+ *
+ * @param  transcript_state
+ * A pointer to a value that libspdm keeps for the L1/L2 transcript of the request, in the
+ * connection or in the session of the request. libspdm sets it to 0 when the transcript is reset,
+ * including when the SPDM context is initialized or reset and when the session starts.
+ * Otherwise the value is only changed by this function. The device secret library may use it
+ * to report "content_changed", for example by storing the version of the measurements when the
+ * transcript starts.
+ **/
+extern libspdm_return_t libspdm_measurement_collection_ex(
+    spdm_version_number_t spdm_version,
+    uint8_t measurement_specification,
+    uint32_t measurement_hash_algo,
+    uint8_t measurement_index,
+    uint8_t request_attribute,
+    uint8_t *content_changed,
+    uint8_t *measurements_count,
+    void *measurements,
+    size_t *measurements_size,
+    uint32_t *transcript_state);
+#endif /* LIBSPDM_MEASUREMENT_COLLECTION_EX_SUPPORT */
+
 /**
  * This function calculates the measurement summary hash.
  *
@@ -0,0 +1,21 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2022-2023 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+#ifndef TIMELIB_H
+#define TIMELIB_H
+
+#include "hal/base.h"
+
+/**
+ * Return a monotonic timestamp.
+ *
+ * Only the difference between two timestamps is meaningful. An implementation that has no time
+ * source may return 0, in which case all measured durations are 0.
+ *
+ * @return  The current timestamp, in units of microseconds.
+ **/
+extern uint64_t libspdm_get_timestamp_us(void);
+
+#endif /* TIMELIB_H */
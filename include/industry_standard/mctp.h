@@ -40,6 +40,19 @@ typedef struct {
     uint8_t message_tag;
 } mctp_header_t;
 
+#define MCTP_HEADER_VERSION 0x01
+#define MCTP_HEADER_VERSION_MASK 0x0F
+
+#define MCTP_MESSAGE_TAG_MASK 0x07
+#define MCTP_MESSAGE_TAG_OWNER 0x08
+#define MCTP_PACKET_SEQUENCE_NUMBER_MASK 0x30
+#define MCTP_PACKET_SEQUENCE_NUMBER_SHIFT 4
+#define MCTP_END_OF_MESSAGE 0x40
+#define MCTP_START_OF_MESSAGE 0x80
+
+/* Baseline transmission unit: the packet payload size that every MCTP endpoint supports. */
+#define MCTP_BASELINE_TRANSMISSION_UNIT 64
+
 typedef struct {
     /* B[0~6]: message_type
      * B[7]  : integrity_check*/
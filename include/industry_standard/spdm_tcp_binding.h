@@ -0,0 +1,36 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2021-2022 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+/** @file
+ * Definitions of the SPDM over TCP binding header, modelled on DSP0287 SPDM over TCP
+ * Binding Specification in Distributed Management Task Force (DMTF).
+ *
+ * Every message on the stream starts with this header, so messages can follow each other
+ * on one connection and the receiver finds their boundaries from payload_length.
+ **/
+
+#ifndef SPDM_TCP_BINDING_H
+#define SPDM_TCP_BINDING_H
+
+#pragma pack(1)
+
+typedef struct {
+    /* Size in bytes of the message following this header. */
+    uint16_t payload_length;
+    uint8_t binding_version;
+    uint8_t message_type;
+} spdm_tcp_binding_header_t;
+
+#define SPDM_TCP_BINDING_VERSION 0x01
+
+#define SPDM_TCP_MESSAGE_TYPE_OUT_OF_SESSION 0x05
+#define SPDM_TCP_MESSAGE_TYPE_IN_SESSION 0x06
+
+#define SPDM_TCP_MAX_PAYLOAD_LENGTH 0xFFFF
+
+#pragma pack()
+
+#endif /* SPDM_TCP_BINDING_H */
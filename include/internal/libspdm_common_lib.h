@@ -16,6 +16,7 @@
 #include "hal/library/requester_secretlib.h"
 #include "hal/library/responder_secretlib.h"
 #include "hal/library/cryptlib.h"
+#include "hal/library/timelib.h"
 
 #define INVALID_SESSION_ID 0
 
@@ -54,9 +55,11 @@ typedef struct {
 #else
     uint8_t buffer_hash[LIBSPDM_MAX_HASH_SIZE];
     uint32_t buffer_hash_size;
-    /* leaf cert public key of the peer */
-    void *leaf_cert_public_key;
 #endif
+    /* Leaf cert public key of the peer. It is parsed once when the cert chain is stored and
+     * kept for the lifetime of the connection, so that each signature verification reuses the
+     * backend key object (and any precomputation the backend attaches to it). */
+    void *leaf_cert_public_key;
 } libspdm_peer_used_cert_chain_t;
 
 typedef struct {
@@ -83,6 +86,21 @@ typedef struct {
     /* Peer Cert verify*/
     libspdm_verify_spdm_cert_chain_func verify_peer_spdm_cert_chain;
 
+#if LIBSPDM_PARALLEL_TASK_SUPPORT
+    /* Task dispatcher for independent cryptographic operations */
+    libspdm_dispatch_task_func dispatch_task;
+#endif /* LIBSPDM_PARALLEL_TASK_SUPPORT */
+
+#if LIBSPDM_TRACE_SUPPORT
+    /* Trace function of the Integrator, see libspdm_register_trace_func */
+    libspdm_trace_func trace;
+#endif /* LIBSPDM_TRACE_SUPPORT */
+
+#if LIBSPDM_ALLOC_SCOPE_SUPPORT
+    /* Allocation scope function of the Integrator, see libspdm_register_alloc_scope_func */
+    libspdm_alloc_scope_func alloc_scope;
+#endif /* LIBSPDM_ALLOC_SCOPE_SUPPORT */
+
     /* opaque_data provision locally*/
     size_t opaque_challenge_auth_rsp_size;
     uint8_t *opaque_challenge_auth_rsp;
@@ -98,6 +116,77 @@ typedef struct {
     bool is_requester;
 } libspdm_local_context_t;
 
+#if LIBSPDM_RESPONDER_ASYNC_SIGN_SUPPORT
+typedef struct {
+    /* Registered libspdm_responder_data_sign_submit_func and libspdm_responder_data_sign_poll_func */
+    void *submit;
+    void *poll;
+
+    /* Set when a signature is submitted and the response handler has to defer its response */
+    bool submitted;
+    uint8_t rd_exponent;
+
+    /* The deferred response. request_code is 0 if no response is deferred. */
+    uint8_t request_code;
+    uint8_t token;
+    bool signature_ready;
+    bool signature_result;
+    uint32_t session_id;
+    /* The session in which the deferred request arrived, if request_in_session is true.
+     * RESPOND_IF_READY must arrive in the same session to get the deferred response. */
+    bool request_in_session;
+    uint32_t request_session_id;
+    size_t signature_offset;
+    size_t signature_size;
+    size_t response_size;
+    uint8_t response[LIBSPDM_ASYNC_SIGN_RESPONSE_BUFFER_SIZE];
+} libspdm_async_sign_context_t;
+#endif /* LIBSPDM_RESPONDER_ASYNC_SIGN_SUPPORT */
+
+#if LIBSPDM_DHE_KEY_POOL_SUPPORT
+typedef struct {
+    spdm_version_number_t spdm_version;
+    uint16_t dhe_named_group;
+    bool is_initiator;
+    void *dhe_context;
+    size_t public_key_size;
+    uint8_t public_key[LIBSPDM_MAX_DHE_KEY_SIZE];
+} libspdm_dhe_key_pool_entry_t;
+#endif /* LIBSPDM_DHE_KEY_POOL_SUPPORT */
+
+#if LIBSPDM_MEASUREMENT_CACHE_SUPPORT
+typedef struct {
+    bool valid;
+    /* The session the record was got in, or INVALID_SESSION_ID */
+    uint32_t session_id;
+    uint8_t slot_id;
+    /* The request attributes of the record, other than the signature request */
+    uint8_t request_attribute;
+    uint8_t number_of_blocks;
+    uint32_t measurement_record_length;
+    uint8_t measurement_record[LIBSPDM_MAX_MEASUREMENT_RECORD_SIZE];
+    /* The summary hash of all the measurements, as in CHALLENGE_AUTH and KEY_EXCHANGE_RSP */
+    uint8_t measurement_summary_hash[LIBSPDM_MAX_HASH_SIZE];
+} libspdm_measurement_cache_t;
+#endif /* LIBSPDM_MEASUREMENT_CACHE_SUPPORT */
+
+#if LIBSPDM_ADAPTIVE_RETRY_SUPPORT
+typedef struct {
+    /* LIBSPDM_DATA_REQUEST_RETRY_MAX_DELAY_TIME and LIBSPDM_DATA_REQUEST_RETRY_DEADLINE */
+    uint64_t max_delay_time;
+    uint64_t deadline;
+    /* Smoothed time for the peer to respond, and to stop being Busy */
+    uint64_t response_time_us;
+    uint64_t busy_time_us;
+    /* When the last request is sent, and the first request answered Busy in a row */
+    uint64_t request_start_us;
+    uint64_t busy_start_us;
+    /* The next request is a retry after Busy, and the last request is */
+    bool retry_pending;
+    bool request_is_retry;
+} libspdm_retry_policy_t;
+#endif /* LIBSPDM_ADAPTIVE_RETRY_SUPPORT */
+
 typedef struct {
     /* Connection State */
     libspdm_connection_state_t connection_state;
@@ -115,11 +204,23 @@ typedef struct {
     /* Peer CertificateChain */
     libspdm_peer_used_cert_chain_t peer_used_cert_chain[SPDM_MAX_SLOT_COUNT];
     uint8_t peer_used_cert_chain_slot_id;
+#if LIBSPDM_CONNECTION_SNAPSHOT_SUPPORT && !(LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT)
+    /* The last cert chain retrieved, for the slot peer_used_cert_chain_buffer_slot_id.
+     * See libspdm_get_connection_snapshot. */
+    uint8_t peer_used_cert_chain_buffer[LIBSPDM_MAX_CERT_CHAIN_SIZE];
+    size_t peer_used_cert_chain_buffer_size;
+    uint8_t peer_used_cert_chain_buffer_slot_id;
+#endif /* LIBSPDM_CONNECTION_SNAPSHOT_SUPPORT */
 
     /* Local Used CertificateChain (for responder, or requester in mut auth) */
     const uint8_t *local_used_cert_chain_buffer;
     size_t local_used_cert_chain_buffer_size;
     uint8_t local_used_cert_chain_slot_id;
+
+#if LIBSPDM_MEASUREMENT_CACHE_SUPPORT
+    /* The last signed measurement record, see libspdm_get_measurement_blocks_cached */
+    libspdm_measurement_cache_t measurement_cache;
+#endif /* LIBSPDM_MEASUREMENT_CACHE_SUPPORT */
 } libspdm_connection_info_t;
 
 typedef struct {
@@ -166,18 +267,6 @@ typedef struct {
     uint8_t buffer[LIBSPDM_MAX_MESSAGE_F_BUFFER_SIZE];
 } libspdm_message_f_managed_buffer_t;
 
-typedef struct {
-    size_t max_buffer_size;
-    size_t buffer_size;
-    uint8_t buffer[LIBSPDM_MAX_MESSAGE_L1L2_BUFFER_SIZE];
-} libspdm_l1l2_managed_buffer_t;
-
-typedef struct {
-    size_t max_buffer_size;
-    size_t buffer_size;
-    uint8_t buffer[LIBSPDM_MAX_MESSAGE_M1M2_BUFFER_SIZE];
-} libspdm_m1m2_managed_buffer_t;
-
 typedef struct {
     size_t max_buffer_size;
     size_t buffer_size;
@@ -224,6 +313,10 @@ typedef struct {
     void *digest_context_mut_m1m2;
     void *digest_context_l1l2;
 #endif
+#if LIBSPDM_MEASUREMENT_COLLECTION_EX_SUPPORT
+    /* The device secret library state of the L1/L2 transcript, reset with message M. */
+    uint32_t measurement_transcript_state;
+#endif /* LIBSPDM_MEASUREMENT_COLLECTION_EX_SUPPORT */
 } libspdm_transcript_t;
 
 /* TH for KEY_EXCHANGE response signature: Concatenate (A, Ct, K)
@@ -286,6 +379,10 @@ typedef struct {
     /* this is back up for message F reset.*/
     void *digest_context_th_backup;
 #endif
+#if LIBSPDM_MEASUREMENT_COLLECTION_EX_SUPPORT
+    /* The device secret library state of the L1/L2 transcript, reset with message M. */
+    uint32_t measurement_transcript_state;
+#endif /* LIBSPDM_MEASUREMENT_COLLECTION_EX_SUPPORT */
 } libspdm_session_transcript_t;
 
 typedef struct {
@@ -298,6 +395,11 @@ typedef struct {
     libspdm_session_transcript_t session_transcript;
     /* Register for the last KEY_UPDATE token and operation (responder only)*/
     spdm_key_update_request_t last_key_update_request;
+#if LIBSPDM_STATISTICS_SUPPORT
+    /* The secured message counters, and the AEAD and HMAC time, are kept in
+     * secured_message_context. */
+    libspdm_statistics_t statistics;
+#endif /* LIBSPDM_STATISTICS_SUPPORT */
     void *secured_message_context;
 } libspdm_session_info_t;
 
@@ -480,6 +582,38 @@ typedef struct {
 #if LIBSPDM_FIPS_MODE
     libspdm_fips_selftest_context fips_selftest_context;
 #endif /* LIBSPDM_FIPS_MODE */
+
+#if LIBSPDM_RESPONDER_ASYNC_SIGN_SUPPORT
+    /* Asynchronous signer and the response waiting for its signature (responder only) */
+    libspdm_async_sign_context_t async_sign;
+#endif /* LIBSPDM_RESPONDER_ASYNC_SIGN_SUPPORT */
+
+#if LIBSPDM_DHE_KEY_POOL_SUPPORT
+    /* Pre-generated ephemeral DHE key pairs, see libspdm_dhe_key_pool_fill */
+    libspdm_dhe_key_pool_entry_t dhe_key_pool[LIBSPDM_DHE_KEY_POOL_SIZE];
+    size_t dhe_key_pool_count;
+#endif /* LIBSPDM_DHE_KEY_POOL_SUPPORT */
+
+#if LIBSPDM_ADAPTIVE_RETRY_SUPPORT
+    /* Delays before retries, learned from the peer (requester only) */
+    libspdm_retry_policy_t retry_policy;
+#endif /* LIBSPDM_ADAPTIVE_RETRY_SUPPORT */
+
+#if LIBSPDM_STATISTICS_SUPPORT
+    /* The secured message counters, and the AEAD and HMAC time, of active sessions are kept in
+     * their secured_message_context, and are added here when the session ends. */
+    libspdm_statistics_t statistics;
+    /* The request sent by libspdm_send_spdm_request (requester only) */
+    uint8_t statistics_request_code;
+    uint64_t statistics_request_start_us;
+    /* The request whose messages are in the buffers, until the next request (requester only) */
+    uint8_t statistics_buffer_request_code;
+#endif /* LIBSPDM_STATISTICS_SUPPORT */
+
+#if LIBSPDM_TRACE_SUPPORT
+    /* The request sent by libspdm_send_spdm_request (requester only) */
+    uint8_t trace_request_code;
+#endif /* LIBSPDM_TRACE_SUPPORT */
 } libspdm_context_t;
 
 #define LIBSPDM_CONTEXT_SIZE_WITHOUT_SECURED_CONTEXT (sizeof(libspdm_context_t))
@@ -495,10 +629,29 @@ typedef struct {
  * @return request code name according to the request code.
  **/
 const char *libspdm_get_code_str(uint8_t request_code);
+#endif /* LIBSPDM_DEBUG_PRINT_ENABLE */
+
+/* The hex dumps print at LIBSPDM_DEBUG_INFO level. They are compiled out if that level is not in
+ * LIBSPDM_DEBUG_LEVEL_MASK, and in binary log mode since the data cannot be recorded by reference. */
+#if (LIBSPDM_DEBUG_PRINT_ENABLE) && ((LIBSPDM_DEBUG_LEVEL_MASK) & (LIBSPDM_DEBUG_INFO)) && \
+    !(LIBSPDM_DEBUG_BINARY_LOG_ENABLE)
+#define LIBSPDM_INTERNAL_DUMP_ENABLE 1
+#else
+#define LIBSPDM_INTERNAL_DUMP_ENABLE 0
+#endif
+
+#if LIBSPDM_INTERNAL_DUMP_ENABLE
+#define LIBSPDM_INTERNAL_DUMP(dump_func, data, size) \
+    do { \
+        if (libspdm_debug_print_enabled(LIBSPDM_DEBUG_INFO)) { \
+            dump_func(data, size); \
+        } \
+    } while (false)
 
 #ifdef LIBSPDM_INTERNAL_DUMP_HEX_STR_OVERRIDE
 extern void LIBSPDM_INTERNAL_DUMP_HEX_STR_OVERRIDE(const uint8_t *data, size_t size);
-#define LIBSPDM_INTERNAL_DUMP_HEX_STR(data, size) LIBSPDM_INTERNAL_DUMP_HEX_STR_OVERRIDE(data, size)
+#define LIBSPDM_INTERNAL_DUMP_HEX_STR(data, size) \
+    LIBSPDM_INTERNAL_DUMP(LIBSPDM_INTERNAL_DUMP_HEX_STR_OVERRIDE, data, size)
 #else
 /**
  * This function dump raw data.
@@ -507,12 +660,14 @@ extern void LIBSPDM_INTERNAL_DUMP_HEX_STR_OVERRIDE(const uint8_t *data, size_t s
  * @param  size  raw data size
  **/
 void libspdm_internal_dump_hex_str(const uint8_t *data, size_t size);
-#define LIBSPDM_INTERNAL_DUMP_HEX_STR(data, size) libspdm_internal_dump_hex_str(data, size)
+#define LIBSPDM_INTERNAL_DUMP_HEX_STR(data, size) \
+    LIBSPDM_INTERNAL_DUMP(libspdm_internal_dump_hex_str, data, size)
 #endif /* LIBSPDM_INTERNAL_DUMP_HEX_STR_OVERRIDE */
 
 #ifdef LIBSPDM_INTERNAL_DUMP_DATA_OVERRIDE
 extern void LIBSPDM_INTERNAL_DUMP_DATA_OVERRIDE(const uint8_t *data, size_t size);
-#define LIBSPDM_INTERNAL_DUMP_DATA(data, size) LIBSPDM_INTERNAL_DUMP_DATA_OVERRIDE(data, size)
+#define LIBSPDM_INTERNAL_DUMP_DATA(data, size) \
+    LIBSPDM_INTERNAL_DUMP(LIBSPDM_INTERNAL_DUMP_DATA_OVERRIDE, data, size)
 #else
 /**
  * This function dump raw data.
@@ -521,12 +676,14 @@ extern void LIBSPDM_INTERNAL_DUMP_DATA_OVERRIDE(const uint8_t *data, size_t size
  * @param  size  raw data size
  **/
 void libspdm_internal_dump_data(const uint8_t *data, size_t size);
-#define LIBSPDM_INTERNAL_DUMP_DATA(data, size) libspdm_internal_dump_data(data, size)
+#define LIBSPDM_INTERNAL_DUMP_DATA(data, size) \
+    LIBSPDM_INTERNAL_DUMP(libspdm_internal_dump_data, data, size)
 #endif /* LIBSPDM_INTERNAL_DUMP_DATA_OVERRIDE */
 
 #ifdef LIBSPDM_INTERNAL_DUMP_HEX_OVERRIDE
 extern void LIBSPDM_INTERNAL_DUMP_HEX_OVERRIDE(const uint8_t *data, size_t size);
-#define LIBSPDM_INTERNAL_DUMP_HEX(data, size) LIBSPDM_INTERNAL_DUMP_HEX_OVERRIDE(data, size)
+#define LIBSPDM_INTERNAL_DUMP_HEX(data, size) \
+    LIBSPDM_INTERNAL_DUMP(LIBSPDM_INTERNAL_DUMP_HEX_OVERRIDE, data, size)
 #else
 /**
  * This function dump raw data with column format.
@@ -535,14 +692,25 @@ extern void LIBSPDM_INTERNAL_DUMP_HEX_OVERRIDE(const uint8_t *data, size_t size)
  * @param  size  raw data size
  **/
 void libspdm_internal_dump_hex(const uint8_t *data, size_t size);
-#define LIBSPDM_INTERNAL_DUMP_HEX(data, size) libspdm_internal_dump_hex(data, size)
+#define LIBSPDM_INTERNAL_DUMP_HEX(data, size) \
+    LIBSPDM_INTERNAL_DUMP(libspdm_internal_dump_hex, data, size)
 #endif /* LIBSPDM_INTERNAL_DUMP_HEX_OVERRIDE */
 
-#else /* LIBSPDM_DEBUG_PRINT_ENABLE */
+#elif LIBSPDM_DEBUG_PRINT_ENABLE
+/* Keep the data referenced, it may be set only for the dump in a LIBSPDM_DEBUG_CODE block. */
+#define LIBSPDM_INTERNAL_DUMP(data, size) \
+    do { \
+        (void)(data); \
+        (void)(size); \
+    } while (false)
+#define LIBSPDM_INTERNAL_DUMP_HEX(data, size) LIBSPDM_INTERNAL_DUMP(data, size)
+#define LIBSPDM_INTERNAL_DUMP_HEX_STR(data, size) LIBSPDM_INTERNAL_DUMP(data, size)
+#define LIBSPDM_INTERNAL_DUMP_DATA(data, size) LIBSPDM_INTERNAL_DUMP(data, size)
+#else
 #define LIBSPDM_INTERNAL_DUMP_HEX(data, size)
 #define LIBSPDM_INTERNAL_DUMP_HEX_STR(data, size)
 #define LIBSPDM_INTERNAL_DUMP_DATA(data, size)
-#endif /* LIBSPDM_DEBUG_PRINT_ENABLE */
+#endif /* LIBSPDM_INTERNAL_DUMP_ENABLE */
 
 /* Required scratch buffer size for libspdm internal usage.
  * It may be used to hold the encrypted/decrypted message and/or last sent/received message.
@@ -562,6 +730,10 @@ void libspdm_internal_dump_hex(const uint8_t *data, size_t size);
  * +---------------+--------------+--------------------------+------------------------------+-----------------+-----------------+
  * |<-Secure msg ->|<-Large msg ->|<-Snd/Rcv buf for chunk ->|<-Snd/Rcv buf for large msg ->|<-last request ->|<-cache request->|
  *
+ * The sections do not overlap. In a chunked transfer within a session, each chunk is encoded or
+ * decoded in the secure message section while the large message is assembled, and the large
+ * sender/receiver buffer holds the whole message while it is sent in chunks.
+ *
  *
  * The value is configurable based on max_spdm_msg_size.
  * The value MAY be changed in different libspdm version.
@@ -680,6 +852,21 @@ void libspdm_session_info_set_psk_hint(libspdm_session_info_t *session_info,
                                        const void *psk_hint,
                                        size_t psk_hint_size);
 
+#if LIBSPDM_SESSION_PREALLOCATION_SUPPORT
+/**
+ * Allocate the AEAD contexts of the data keys of a session, after they are derived by
+ * libspdm_generate_session_data_key.
+ *
+ * The contexts live as long as the session, so they are allocated in a persistent allocation scope
+ * even if the flow deriving the data keys runs in an allocation scope.
+ *
+ * @param  spdm_context                  A pointer to the SPDM context.
+ * @param  session_info                  A pointer to a session info.
+ */
+void libspdm_session_info_new_aead_context(libspdm_context_t *spdm_context,
+                                           libspdm_session_info_t *session_info);
+#endif /* LIBSPDM_SESSION_PREALLOCATION_SUPPORT */
+
 /**
  * This function returns if a given version is supported based upon the GET_VERSION/VERSION.
  *
@@ -865,22 +1052,6 @@ uint32_t libspdm_get_measurement_summary_hash_size(libspdm_context_t *spdm_conte
                                                    bool is_requester,
                                                    uint8_t measurement_summary_hash_type);
 
-#if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
-/*
- * This function calculates l1l2.
- * If session_info is NULL, this function will use M cache of SPDM context,
- * else will use M cache of SPDM session context.
- *
- * @param  spdm_context                  A pointer to the SPDM context.
- * @param  session_info                  A pointer to the SPDM session context.
- * @param  l1l2                          The buffer to store the l1l2.
- *
- * @retval RETURN_SUCCESS  l1l2 is calculated.
- */
-bool libspdm_calculate_l1l2(libspdm_context_t *spdm_context,
-                            void *session_info,
-                            libspdm_l1l2_managed_buffer_t *l1l2);
-#else
 /*
  * This function calculates l1l2 hash.
  * If session_info is NULL, this function will use M cache of SPDM context,
@@ -896,7 +1067,6 @@ bool libspdm_calculate_l1l2(libspdm_context_t *spdm_context,
 bool libspdm_calculate_l1l2_hash(libspdm_context_t *spdm_context,
                                  void *session_info,
                                  size_t *l1l2_hash_size, void *l1l2_hash);
-#endif /* LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT */
 
 /**
  * Get element from multi element opaque data by element id.
@@ -1071,6 +1241,187 @@ uint8_t libspdm_get_cert_slot_mask (libspdm_context_t *spdm_context);
  **/
 uint8_t libspdm_get_cert_slot_count(libspdm_context_t *spdm_context);
 
+/**
+ * Return the leaf certificate public key of the peer certificate chain in a slot.
+ *
+ * The key object cached in peer_used_cert_chain is returned when present. Otherwise the key is
+ * parsed from the recorded certificate chain and the caller must free it after use.
+ *
+ * @param  spdm_context  A pointer to the SPDM context.
+ * @param  is_requester  Indicate if the key verifies a responder (true) or a requester (false) signature.
+ * @param  slot_id       The slot ID of the peer certificate chain.
+ * @param  public_key    On output, the public key object.
+ * @param  need_free     On output, true if the caller owns the returned public key object.
+ *
+ * @retval true   The public key is returned.
+ * @retval false  The public key cannot be found or parsed.
+ **/
+bool libspdm_get_peer_leaf_cert_public_key(libspdm_context_t *spdm_context, bool is_requester,
+                                           uint8_t slot_id, void **public_key, bool *need_free);
+
+/**
+ * Free the cached leaf certificate public key of the peer certificate chain in a slot.
+ *
+ * @param  spdm_context  A pointer to the SPDM context.
+ * @param  slot_id       The slot ID of the peer certificate chain.
+ **/
+void libspdm_free_peer_leaf_cert_public_key(libspdm_context_t *spdm_context, uint8_t slot_id);
+
+/**
+ * Sign an SPDM message data as a responder.
+ *
+ * If an asynchronous signer is registered and no response is waiting for a signature, the signing
+ * operation is submitted to it, async_sign.submitted is set and signature is not filled.
+ * The caller must then defer its response with libspdm_responder_defer_response.
+ * Otherwise the message is signed synchronously by libspdm_responder_data_sign.
+ *
+ * The parameters are the same as libspdm_responder_data_sign.
+ *
+ * @retval true  Signing success, or the signing operation is submitted.
+ * @retval false Signing fail.
+ **/
+bool libspdm_responder_data_sign_deferrable(
+    libspdm_context_t *spdm_context, spdm_version_number_t spdm_version,
+    uint8_t op_code, uint32_t base_asym_algo,
+    uint32_t base_hash_algo, bool is_data_hash,
+    const uint8_t *message, size_t message_size,
+    uint8_t *signature, size_t *sig_size);
+
+#if LIBSPDM_DHE_KEY_POOL_SUPPORT
+/**
+ * Take a pre-generated ephemeral DHE key pair out of the pool.
+ *
+ * The key pair is removed from the pool and the caller owns the returned DHE context.
+ *
+ * @param  spdm_context     A pointer to the SPDM context.
+ * @param  spdm_version     The negotiated SPDM version.
+ * @param  dhe_named_group  SPDM dhe_named_group.
+ * @param  is_initiator     If the caller is the initiator of the key exchange.
+ * @param  public_key       Pointer to the buffer to receive the public key.
+ * @param  public_key_size  On input, the size of public_key buffer in bytes.
+ *                          On output, the size of data returned in public_key buffer in bytes.
+ *
+ * @return Pointer to the DHE context, or NULL if no matching key pair is in the pool.
+ **/
+void *libspdm_dhe_key_pool_take(libspdm_context_t *spdm_context,
+                                spdm_version_number_t spdm_version,
+                                uint16_t dhe_named_group, bool is_initiator,
+                                uint8_t *public_key, size_t *public_key_size);
+#endif /* LIBSPDM_DHE_KEY_POOL_SUPPORT */
+
+#if LIBSPDM_TRACE_SUPPORT
+/* Call a trace function, if it is registered. */
+#define LIBSPDM_TRACE(trace, spdm_context, event, phase, request_code, session_id, size) \
+    do { \
+        if ((trace) != NULL) { \
+            (trace)((spdm_context), (event), (phase), (request_code), (session_id), (size)); \
+        } \
+    } while (false)
+
+/* Trace the begin and the end of an operation on an SPDM context (libspdm_context_t *). */
+#define LIBSPDM_TRACE_BEGIN(spdm_context, event, request_code, session_id, size) \
+    LIBSPDM_TRACE((spdm_context)->local_context.trace, (spdm_context), (event), \
+                  LIBSPDM_TRACE_PHASE_BEGIN, (request_code), (session_id), (size))
+#define LIBSPDM_TRACE_END(spdm_context, event, request_code, session_id, size) \
+    LIBSPDM_TRACE((spdm_context)->local_context.trace, (spdm_context), (event), \
+                  LIBSPDM_TRACE_PHASE_END, (request_code), (session_id), (size))
+#else
+#define LIBSPDM_TRACE_BEGIN(spdm_context, event, request_code, session_id, size)
+#define LIBSPDM_TRACE_END(spdm_context, event, request_code, session_id, size)
+#endif /* LIBSPDM_TRACE_SUPPORT */
+
+#if LIBSPDM_ALLOC_SCOPE_SUPPORT
+/* Enter or leave an allocation scope on an SPDM context (libspdm_context_t *). */
+#define LIBSPDM_ALLOC_SCOPE(spdm_context, scope, request_code) \
+    do { \
+        if ((spdm_context)->local_context.alloc_scope != NULL) { \
+            (spdm_context)->local_context.alloc_scope((spdm_context), (scope), (request_code)); \
+        } \
+    } while (false)
+#else
+#define LIBSPDM_ALLOC_SCOPE(spdm_context, scope, request_code)
+#endif /* LIBSPDM_ALLOC_SCOPE_SUPPORT */
+
+#if LIBSPDM_STATISTICS_SUPPORT
+/**
+ * Record the handling time of a request in the SPDM context and the session.
+ *
+ * @param  spdm_context  A pointer to the SPDM context.
+ * @param  session_info  A pointer to the session info, or NULL if the request is not in a session.
+ * @param  request_code  The SPDM request code.
+ * @param  start_us      The timestamp, from libspdm_get_timestamp_us, when handling started.
+ **/
+void libspdm_statistics_record_request(libspdm_context_t *spdm_context,
+                                       libspdm_session_info_t *session_info,
+                                       uint8_t request_code, uint64_t start_us);
+
+/**
+ * Record an SPDM message received or sent, in the SPDM context and the session.
+ *
+ * A Busy or ResponseNotReady ERROR message is also counted.
+ *
+ * @param  spdm_context  A pointer to the SPDM context.
+ * @param  session_info  A pointer to the session info, or NULL if the message is not in a session.
+ * @param  is_received   Indicates if the message is received or sent.
+ * @param  message_size  Size in bytes of the message.
+ * @param  message       A pointer to the message, or NULL if only its size is recorded.
+ **/
+void libspdm_statistics_record_message(libspdm_context_t *spdm_context,
+                                       libspdm_session_info_t *session_info,
+                                       bool is_received, size_t message_size,
+                                       const void *message);
+
+/**
+ * Record the time spent in a class of cryptographic operation in the SPDM context.
+ *
+ * @param  spdm_context  A pointer to the SPDM context.
+ * @param  crypto_class  The class of cryptographic operation.
+ * @param  start_us      The timestamp, from libspdm_get_timestamp_us, when the operation started.
+ **/
+void libspdm_statistics_record_crypto(libspdm_context_t *spdm_context,
+                                      libspdm_statistics_crypto_class_t crypto_class,
+                                      uint64_t start_us);
+
+/**
+ * Record the size of the data held in a buffer in the SPDM context.
+ *
+ * @param  spdm_context  A pointer to the SPDM context.
+ * @param  request_code  The SPDM request code being handled, or 0 if it is not known.
+ * @param  buffer        The buffer or scratch buffer region.
+ * @param  size          The size in bytes of the data.
+ **/
+void libspdm_statistics_record_buffer(libspdm_context_t *spdm_context, uint8_t request_code,
+                                      libspdm_statistics_buffer_t buffer, size_t size);
+
+/**
+ * Add the secured message statistics of an ending session to the SPDM context.
+ *
+ * @param  spdm_context  A pointer to the SPDM context.
+ * @param  session_info  A pointer to the session info.
+ **/
+void libspdm_statistics_end_session(libspdm_context_t *spdm_context,
+                                    libspdm_session_info_t *session_info);
+
+/**
+ * Get the statistics of the SPDM context or a session.
+ *
+ * @param  spdm_context  A pointer to the SPDM context.
+ * @param  session_info  A pointer to the session info, or NULL for the whole SPDM context.
+ * @param  statistics    A pointer to the statistics returned.
+ **/
+void libspdm_statistics_get(libspdm_context_t *spdm_context,
+                            libspdm_session_info_t *session_info,
+                            libspdm_statistics_t *statistics);
+
+/* Record the size of the data in a buffer, if LIBSPDM_STATISTICS_SUPPORT is enabled. buffer is
+ * the libspdm_statistics_buffer_t name without the LIBSPDM_STATISTICS_BUFFER_ prefix. */
+#define LIBSPDM_STATISTICS_RECORD_BUFFER(spdm_context, request_code, buffer, size) \
+    libspdm_statistics_record_buffer(spdm_context, request_code, \
+                                     LIBSPDM_STATISTICS_BUFFER_##buffer, size)
+#else
+#define LIBSPDM_STATISTICS_RECORD_BUFFER(spdm_context, request_code, buffer, size)
+#endif /* LIBSPDM_STATISTICS_SUPPORT */
+
 #if LIBSPDM_ENABLE_MSG_LOG
 void libspdm_append_msg_log(libspdm_context_t *spdm_context, void *message, size_t message_size);
 #endif
@@ -105,6 +105,26 @@
 
 #endif /* LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT */
 
+#if LIBSPDM_RESPONDER_ASYNC_SIGN_SUPPORT
+#if !LIBSPDM_RESPOND_IF_READY_SUPPORT
+#error LIBSPDM_RESPONDER_ASYNC_SIGN_SUPPORT requires LIBSPDM_RESPOND_IF_READY_SUPPORT
+#endif
+
+/*
+ * The largest response that waits for an asynchronous signature.
+ * +--------------------------+------------------------------------------+
+ * | CHALLENGE_AUTH 1.2       | 38 + H * 2 + S [+ O]                     |
+ * | MEASUREMENTS 1.2         | 42 + MeasRecLen + S [+ O]                |
+ * | KEY_EXCHANGE_RSP 1.2     | 42 + D + H + S (+ H) [+ O]               |
+ * +--------------------------+------------------------------------------+
+ */
+#define LIBSPDM_ASYNC_SIGN_RESPONSE_BUFFER_SIZE (42 + LIBSPDM_MAX_MEASUREMENT_RECORD_SIZE + \
+                                                 LIBSPDM_MAX_DHE_KEY_SIZE + \
+                                                 LIBSPDM_MAX_HASH_SIZE * 2 + \
+                                                 LIBSPDM_MAX_ASYM_KEY_SIZE + \
+                                                 SPDM_MAX_OPAQUE_DATA_SIZE)
+#endif /* LIBSPDM_RESPONDER_ASYNC_SIGN_SUPPORT */
+
 /*when in FIPS mode, only support approved algo in FIPS */
 #if LIBSPDM_FIPS_MODE
 #undef LIBSPDM_SM2_DSA_P256_SUPPORT
@@ -647,4 +647,49 @@ bool libspdm_verify_measurement_signature(libspdm_context_t *spdm_context,
                                           const void *sign_data,
                                           size_t sign_data_size);
 
+/**
+ * Wait before retrying a request after a Busy ERROR response.
+ *
+ * The delay is LIBSPDM_DATA_REQUEST_RETRY_DELAY_TIME, or with LIBSPDM_ADAPTIVE_RETRY_SUPPORT it is
+ * learned from the peer.
+ *
+ * @param  spdm_context  A pointer to the SPDM context.
+ * @param  retry_count   The number of retries of the request already sent.
+ *
+ * @retval true   The request may be retried.
+ * @retval false  The deadline of the retries is reached, the request must not be retried.
+ **/
+bool libspdm_wait_before_retry(libspdm_context_t *spdm_context, size_t retry_count);
+
+#if LIBSPDM_RESPOND_IF_READY_SUPPORT
+/**
+ * Wait before sending RESPOND_IF_READY after a ResponseNotReady ERROR response.
+ *
+ * @param  spdm_context  A pointer to the SPDM context.
+ * @param  rd_exponent   The RDTExponent of the ERROR response.
+ * @param  rd_tm         The RDTM of the ERROR response.
+ **/
+void libspdm_wait_before_respond_if_ready(libspdm_context_t *spdm_context, uint8_t rd_exponent,
+                                          uint8_t rd_tm);
+#endif /* LIBSPDM_RESPOND_IF_READY_SUPPORT */
+
+#if LIBSPDM_ADAPTIVE_RETRY_SUPPORT
+/**
+ * Record that a request is sent, for the response time of the peer.
+ *
+ * @param  spdm_context  A pointer to the SPDM context.
+ **/
+void libspdm_retry_policy_request_sent(libspdm_context_t *spdm_context);
+
+/**
+ * Learn the response time of the peer, and the time it stayed Busy, from a response.
+ *
+ * @param  spdm_context   A pointer to the SPDM context.
+ * @param  response_size  Size in bytes of the response.
+ * @param  response       The SPDM response message.
+ **/
+void libspdm_retry_policy_response_received(libspdm_context_t *spdm_context,
+                                            size_t response_size, const void *response);
+#endif /* LIBSPDM_ADAPTIVE_RETRY_SUPPORT */
+
 #endif /* SPDM_REQUESTER_LIB_INTERNAL_H */
@@ -865,4 +865,73 @@ bool libspdm_generate_measurement_signature(libspdm_context_t *spdm_context,
                                             libspdm_session_info_t *session_info,
                                             uint8_t *signature);
 
+#if LIBSPDM_ENABLE_CAPABILITY_KEY_EX_CAP
+/**
+ * Finalize KEY_EXCHANGE_RSP once its signature is generated.
+ *
+ * It appends the signature to the transcript, derives the handshake keys, fills the HMAC
+ * and moves the session to the handshaking state. The session is freed on failure.
+ *
+ * @param  spdm_context   A pointer to the SPDM context.
+ * @param  spdm_request   A pointer to the KEY_EXCHANGE request.
+ * @param  session_id     The session ID of the session being established.
+ * @param  signature      A pointer to the signature in the response.
+ * @param  response_size  size in bytes of the response data.
+ * @param  response       A pointer to the response data.
+ **/
+libspdm_return_t libspdm_finalize_response_key_exchange(
+    libspdm_context_t *spdm_context, const spdm_key_exchange_request_t *spdm_request,
+    uint32_t session_id, uint8_t *signature, size_t *response_size, void *response);
+#endif /* LIBSPDM_ENABLE_CAPABILITY_KEY_EX_CAP */
+
+#if LIBSPDM_RESPONDER_ASYNC_SIGN_SUPPORT
+/**
+ * Defer a response whose signature is submitted to the asynchronous signer.
+ *
+ * The response is kept in the SPDM context until the signature is ready and
+ * ERROR(ResponseNotReady) is returned instead.
+ *
+ * @param  spdm_context      A pointer to the SPDM context.
+ * @param  request_code      The request code of the deferred response.
+ * @param  session_id        The session ID of the session being established by KEY_EXCHANGE.
+ * @param  signature_offset  The offset of the signature in the response.
+ * @param  signature_size    The size in bytes of the signature.
+ * @param  response_size     On input, the size in bytes of the deferred response.
+ *                           On output, the size in bytes of the error response.
+ * @param  response          A pointer to the response data.
+ **/
+libspdm_return_t libspdm_responder_defer_response(libspdm_context_t *spdm_context,
+                                                  uint8_t request_code, uint32_t session_id,
+                                                  size_t signature_offset,
+                                                  size_t signature_size,
+                                                  size_t *response_size, void *response);
+
+/**
+ * Poll the asynchronous signer for the signature of the deferred response.
+ *
+ * async_sign.signature_ready is set once the signature is ready or the signing failed.
+ *
+ * @param  spdm_context  A pointer to the SPDM context.
+ **/
+void libspdm_responder_poll_deferred_response(libspdm_context_t *spdm_context);
+
+/**
+ * Return the deferred response for RESPOND_IF_READY.
+ *
+ * @param  spdm_context   A pointer to the SPDM context.
+ * @param  response_size  size in bytes of the response data.
+ * @param  response       A pointer to the response data.
+ **/
+libspdm_return_t libspdm_responder_complete_deferred_response(libspdm_context_t *spdm_context,
+                                                              size_t *response_size,
+                                                              void *response);
+
+/**
+ * Drop the deferred response and free the session it was establishing, if any.
+ *
+ * @param  spdm_context  A pointer to the SPDM context.
+ **/
+void libspdm_responder_discard_deferred_response(libspdm_context_t *spdm_context);
+#endif /* LIBSPDM_RESPONDER_ASYNC_SIGN_SUPPORT */
+
 #endif /* SPDM_RESPONDER_LIB_INTERNAL_H */
@@ -43,6 +43,17 @@ typedef struct {
     uint64_t response_data_sequence_number;
 } libspdm_session_info_struct_application_secret_t;
 
+#if LIBSPDM_SESSION_PREALLOCATION_SUPPORT
+typedef struct {
+    /* AEAD context from libspdm_aead_new, or NULL to encrypt with libspdm_aead_encryption. */
+    void *context;
+    /* The data key set in the context. It is compared to the current data key at each message,
+     * so that the context follows a KEY_UPDATE and its rollback. */
+    uint8_t key[LIBSPDM_MAX_AEAD_KEY_SIZE];
+    bool is_key_set;
+} libspdm_session_info_struct_aead_context_t;
+#endif /* LIBSPDM_SESSION_PREALLOCATION_SUPPORT */
+
 typedef struct {
     libspdm_session_type_t session_type;
     spdm_version_number_t version;
@@ -64,6 +75,12 @@ typedef struct {
     libspdm_session_info_struct_application_secret_t application_secret_backup;
     bool requester_backup_valid;
     bool responder_backup_valid;
+#if LIBSPDM_SESSION_PREALLOCATION_SUPPORT
+    /* Allocated by libspdm_secured_message_new_aead_context and freed by
+     * libspdm_secured_message_free_aead_context. */
+    libspdm_session_info_struct_aead_context_t request_data_aead;
+    libspdm_session_info_struct_aead_context_t response_data_aead;
+#endif /* LIBSPDM_SESSION_PREALLOCATION_SUPPORT */
     size_t psk_hint_size;
     uint8_t psk_hint[LIBSPDM_PSK_MAX_HINT_LENGTH];
     uint8_t export_master_secret[LIBSPDM_MAX_HASH_SIZE];
@@ -71,10 +88,35 @@ typedef struct {
     /* Cache the error in libspdm_decode_secured_message.
      * It is handled in libspdm_build_response. */
     libspdm_error_struct_t last_spdm_error;
+
+#if LIBSPDM_STATISTICS_SUPPORT
+    /* Updated by libspdm_encode_secured_message and libspdm_decode_secured_message. */
+    uint64_t secured_message_encoded;
+    uint64_t secured_message_decoded;
+    uint64_t decrypt_failure;
+    libspdm_latency_statistics_t aead;
+    /* Updated by libspdm_hmac_all_with_request/response_finished_key. */
+    libspdm_latency_statistics_t hmac;
+#endif /* LIBSPDM_STATISTICS_SUPPORT */
+
+#if LIBSPDM_TRACE_SUPPORT
+    /* Trace function of the SPDM context that owns the session. */
+    libspdm_trace_func trace;
+    void *spdm_context;
+#endif /* LIBSPDM_TRACE_SUPPORT */
 } libspdm_secured_message_context_t;
 
 #define LIBSPDM_SECURED_MESSAGE_CONTEXT_SIZE (sizeof(libspdm_secured_message_context_t))
 
+#if LIBSPDM_TRACE_SUPPORT
+/* Trace an operation on a secured message context (libspdm_secured_message_context_t *). */
+#define LIBSPDM_SECURED_MESSAGE_TRACE(secured_message_context, event, phase, session_id, size) \
+    LIBSPDM_TRACE((secured_message_context)->trace, (secured_message_context)->spdm_context, \
+                  (event), (phase), 0, (session_id), (size))
+#else
+#define LIBSPDM_SECURED_MESSAGE_TRACE(secured_message_context, event, phase, session_id, size)
+#endif /* LIBSPDM_TRACE_SUPPORT */
+
 /**
  * Initialize an SPDM secured message context.
  *
@@ -84,6 +126,33 @@ typedef struct {
  */
 void libspdm_secured_message_init_context(void *spdm_secured_message_context);
 
+#if LIBSPDM_SESSION_PREALLOCATION_SUPPORT
+/**
+ * Free the AEAD contexts of the data keys of an SPDM secured message context.
+ *
+ * It shall be called before the secured message context is initialized again or discarded.
+ *
+ * @param  spdm_secured_message_context    A pointer to the SPDM secured message context.
+ */
+void libspdm_secured_message_free_aead_context(void *spdm_secured_message_context);
+
+/**
+ * Allocate the AEAD context of the request or response data key of an SPDM secured message
+ * context, and set the current data key in it. The previous context of that key is freed.
+ *
+ * It is called after the data keys are derived by libspdm_generate_session_data_key, and after a
+ * data key is updated by libspdm_create_update_session_data_key. The context lives as long as the
+ * session, so it shall not be allocated in an allocation scope flow.
+ *
+ * @param  spdm_secured_message_context    A pointer to the SPDM secured message context.
+ * @param  action                          LIBSPDM_KEY_UPDATE_ACTION_REQUESTER for the request
+ *                                         data key, LIBSPDM_KEY_UPDATE_ACTION_RESPONDER for the
+ *                                         response data key.
+ */
+void libspdm_secured_message_new_aead_context(void *spdm_secured_message_context,
+                                              libspdm_key_update_action_t action);
+#endif /* LIBSPDM_SESSION_PREALLOCATION_SUPPORT */
+
 /**
  * Set use_psk to an SPDM secured message context.
  *
@@ -139,6 +208,18 @@ void libspdm_secured_message_set_psk_hint(void *spdm_secured_message_context,
                                           const void *psk_hint,
                                           size_t psk_hint_size);
 
+#if LIBSPDM_TRACE_SUPPORT
+/**
+ * Set the trace function to an SPDM secured message context.
+ *
+ * @param  spdm_secured_message_context    A pointer to the SPDM secured message context.
+ * @param  spdm_context                    A pointer to the SPDM context passed to the function.
+ * @param  trace                           The trace function, or NULL.
+ */
+void libspdm_secured_message_set_trace_func(void *spdm_secured_message_context,
+                                            void *spdm_context, libspdm_trace_func trace);
+#endif /* LIBSPDM_TRACE_SUPPORT */
+
 /**
  * Allocates and Initializes one Diffie-Hellman Ephemeral (DHE) context for subsequent use,
  * based upon negotiated DHE algorithm.
@@ -398,6 +479,43 @@ void libspdm_secured_message_set_last_spdm_error_struct(
     void *spdm_secured_message_context,
     const libspdm_error_struct_t *last_spdm_error);
 
+#if LIBSPDM_STATISTICS_SUPPORT
+/**
+ * Add a duration to latency statistics.
+ *
+ * @param  latency   A pointer to the latency statistics.
+ * @param  start_us  The timestamp, from libspdm_get_timestamp_us, when the duration started.
+ **/
+void libspdm_statistics_add_latency(libspdm_latency_statistics_t *latency, uint64_t start_us);
+
+/**
+ * Add a duration to latency statistics.
+ *
+ * @param  latency     A pointer to the latency statistics.
+ * @param  elapsed_us  The duration in microseconds.
+ **/
+void libspdm_statistics_add_duration(libspdm_latency_statistics_t *latency, uint64_t elapsed_us);
+
+/**
+ * Merge latency statistics into another one.
+ *
+ * @param  latency  A pointer to the latency statistics to update.
+ * @param  other    A pointer to the latency statistics to merge.
+ **/
+void libspdm_statistics_merge_latency(libspdm_latency_statistics_t *latency,
+                                      const libspdm_latency_statistics_t *other);
+
+/**
+ * Add the secured message counters, and the AEAD and HMAC time, of an SPDM secured message context
+ * to a statistics block.
+ *
+ * @param  spdm_secured_message_context  A pointer to the SPDM secured message context.
+ * @param  statistics                    A pointer to the statistics to update.
+ **/
+void libspdm_secured_message_merge_statistics(const void *spdm_secured_message_context,
+                                              libspdm_statistics_t *statistics);
+#endif /* LIBSPDM_STATISTICS_SUPPORT */
+
 /**
  * This function generates SPDM HandshakeKey for a session.
  *
@@ -11,6 +11,7 @@
 #include "hal/base.h"
 #include "library/spdm_secured_message_lib.h"
 #include "library/spdm_return_status.h"
+#include "library/spdm_task_dispatch.h"
 
 #define LIBSPDM_MAJOR_VERSION 0x03
 #define LIBSPDM_MINOR_VERSION 0x00
@@ -126,6 +127,28 @@ typedef enum {
     LIBSPDM_DATA_MAX_DHE_SESSION_COUNT,
     LIBSPDM_DATA_MAX_PSK_SESSION_COUNT,
 
+    /* The statistics block, as libspdm_statistics_t. It is read-only.
+     * With LIBSPDM_DATA_LOCATION_LOCAL or LIBSPDM_DATA_LOCATION_CONNECTION it covers the whole SPDM
+     * context, including the sessions that are active or have ended. With
+     * LIBSPDM_DATA_LOCATION_SESSION it covers only the session in additional_data.
+     * It requires LIBSPDM_STATISTICS_SUPPORT.
+     **/
+    LIBSPDM_DATA_STATISTICS,
+
+    /* The maximum delay time in microseconds before a retry after a Busy `ERROR` response, as
+     * uint64_t. If its value is 0 then the maximum is the larger of
+     * LIBSPDM_DATA_REQUEST_RETRY_DELAY_TIME and the CT of the peer.
+     * It requires LIBSPDM_ADAPTIVE_RETRY_SUPPORT.
+     **/
+    LIBSPDM_DATA_REQUEST_RETRY_MAX_DELAY_TIME,
+
+    /* The time in microseconds after the first Busy `ERROR` response to a request, as uint64_t,
+     * beyond which the request is not retried anymore. If its value is 0 then the retries are
+     * only bounded by LIBSPDM_DATA_REQUEST_RETRY_TIMES.
+     * It requires LIBSPDM_ADAPTIVE_RETRY_SUPPORT.
+     **/
+    LIBSPDM_DATA_REQUEST_RETRY_DEADLINE,
+
     /* MAX */
     LIBSPDM_DATA_MAX
 } libspdm_data_type_t;
@@ -488,8 +511,8 @@ typedef libspdm_return_t (*libspdm_device_receive_message_func)(
  * This function must be called after libspdm_init_context, and before any SPDM communication.
  *
  * @param  spdm_context                  A pointer to the SPDM context.
- * @param  send_message                  The fuction to send an SPDM transport layer message.
- * @param  receive_message               The fuction to receive an SPDM transport layer message.
+ * @param  send_message                  The function to send an SPDM transport layer message.
+ * @param  receive_message               The function to receive an SPDM transport layer message.
  **/
 void libspdm_register_device_io_func(
     void *spdm_context, libspdm_device_send_message_func send_message,
@@ -579,10 +602,10 @@ typedef void (*libspdm_device_release_receiver_buffer_func)(void *spdm_context,
  * @param  spdm_context             A pointer to the SPDM context.
  * @param  sender_buffer_size       Size in bytes of the sender buffer.
  * @param  receiver_buffer_size     Size in bytes of the receiver buffer.
- * @param  acquire_sender_buffer    The fuction to acquire transport layer sender buffer.
- * @param  release_sender_buffer    The fuction to release transport layer sender buffer.
- * @param  acquire_receiver_buffer  The fuction to acquire transport layer receiver buffer.
- * @param  release_receiver_buffer  The fuction to release transport layer receiver buffer.
+ * @param  acquire_sender_buffer    The function to acquire transport layer sender buffer.
+ * @param  release_sender_buffer    The function to release transport layer sender buffer.
+ * @param  acquire_receiver_buffer  The function to acquire transport layer receiver buffer.
+ * @param  release_receiver_buffer  The function to release transport layer receiver buffer.
  **/
 void libspdm_register_device_buffer_func(
     void *spdm_context,
@@ -613,7 +636,8 @@ void libspdm_register_device_buffer_func(
  * @param  message_size    Size in bytes of the message data buffer.
  * @param  message         A pointer to a source buffer to store the message.
  *                         For normal message, it shall point to the acquired sender buffer.
- *                         For secured message, it shall point to the scratch buffer in spdm_context.
+ *                         For secured message, it shall point to the scratch buffer in spdm_context,
+ *                         or to the transport header size in the sender buffer to be encoded in place.
  * @param  transport_message_size  Size in bytes of the transport message data buffer.
  * @param  transport_message       A pointer to a destination buffer to store the transport message.
  *                                 On input, it shall be msg_buf_ptr from sender buffer.
@@ -666,7 +690,8 @@ typedef libspdm_return_t (*libspdm_transport_decode_message_func)(
 
 /**
  * Return the maximum transport layer message header size.
- * Transport Message Header Size + sizeof(spdm_secured_message_cipher_header_t))
+ * Transport Message Header Size + secured message header + APP message header.
+ * An SPDM message at this offset in the sender buffer is encoded in place.
  *
  * For MCTP, Transport Message Header Size = sizeof(mctp_message_header_t)
  * For PCI_DOE, Transport Message Header Size = sizeof(pci_doe_data_object_header_t)
@@ -683,9 +708,9 @@ typedef uint32_t (*libspdm_transport_get_header_size_func)(void *spdm_context);
  * This function must be called after libspdm_init_context, and before any SPDM communication.
  *
  * @param  spdm_context               A pointer to the SPDM context.
- * @param  transport_encode_message   The fuction to encode an SPDM or APP message to a transport layer message.
- * @param  transport_decode_message   The fuction to decode an SPDM or APP message from a transport layer message.
- * @param  transport_get_header_size  The fuction to get the maximum transport layer message header size.
+ * @param  transport_encode_message   The function to encode an SPDM or APP message to a transport layer message.
+ * @param  transport_decode_message   The function to decode an SPDM or APP message from a transport layer message.
+ * @param  transport_get_header_size  The function to get the maximum transport layer message header size.
  **/
 void libspdm_register_transport_layer_func(
     void *spdm_context,
@@ -695,6 +720,24 @@ void libspdm_register_transport_layer_func(
     libspdm_transport_decode_message_func transport_decode_message,
     libspdm_transport_get_header_size_func transport_get_header_size);
 
+/* The size of required scratch buffer for a given max_spdm_msg_size and
+ * transport_additional_size, matching libspdm_get_sizeof_required_scratch_buffer().
+ * It is exposed so that the SPDM Integrator can allocate the scratch buffer statically.
+ * It is the sum of the sections of the scratch buffer enabled at build time. */
+#if LIBSPDM_ENABLE_CAPABILITY_CHUNK_CAP && LIBSPDM_RESPOND_IF_READY_SUPPORT
+#define LIBSPDM_REQUIRED_SCRATCH_BUFFER_SIZE(max_spdm_msg_size, transport_additional_size) \
+    (6 * (max_spdm_msg_size) + 3 * (transport_additional_size))
+#elif LIBSPDM_ENABLE_CAPABILITY_CHUNK_CAP
+#define LIBSPDM_REQUIRED_SCRATCH_BUFFER_SIZE(max_spdm_msg_size, transport_additional_size) \
+    (5 * (max_spdm_msg_size) + 3 * (transport_additional_size))
+#elif LIBSPDM_RESPOND_IF_READY_SUPPORT
+#define LIBSPDM_REQUIRED_SCRATCH_BUFFER_SIZE(max_spdm_msg_size, transport_additional_size) \
+    (3 * (max_spdm_msg_size) + (transport_additional_size))
+#else
+#define LIBSPDM_REQUIRED_SCRATCH_BUFFER_SIZE(max_spdm_msg_size, transport_additional_size) \
+    (2 * (max_spdm_msg_size) + (transport_additional_size))
+#endif
+
 /**
  * Get the size of required scratch buffer.
  *
@@ -779,12 +822,358 @@ typedef bool (*libspdm_verify_spdm_cert_chain_func)(
  * This function must be called after libspdm_init_context, and before any SPDM communication.
  *
  * @param  spdm_context        A pointer to the SPDM context.
- * @param  verify_certificate  The fuction to verify an SPDM certificate after GET_CERTIFICATE.
+ * @param  verify_certificate  The function to verify an SPDM certificate after GET_CERTIFICATE.
  **/
 void libspdm_register_verify_spdm_cert_chain_func(
     void *spdm_context,
     const libspdm_verify_spdm_cert_chain_func verify_spdm_cert_chain);
 
+#if LIBSPDM_RESPONDER_ASYNC_SIGN_SUPPORT
+/**
+ * Submit an SPDM message data to an asynchronous signer.
+ *
+ * The signer must copy the message before returning, as the buffer is not preserved.
+ * Only one signing operation is outstanding per SPDM context. A new submission replaces
+ * an abandoned one.
+ *
+ * @param  spdm_context     A pointer to the SPDM context.
+ * @param  spdm_version     Indicates the negotiated SPDM version.
+ * @param  op_code          Indicates the request code of the response being signed.
+ * @param  base_asym_algo   Indicates the signing algorithm.
+ * @param  base_hash_algo   Indicates the hash algorithm.
+ * @param  is_data_hash     Indicate the message type, see libspdm_responder_data_sign.
+ * @param  message          A pointer to a message to be signed.
+ * @param  message_size     The size, in bytes, of the message to be signed.
+ * @param  completion_time  The expected time, in microseconds, until the signature is ready.
+ *
+ * @retval true  The signing operation is submitted.
+ * @retval false The signing operation cannot be submitted.
+ **/
+typedef bool (*libspdm_responder_data_sign_submit_func)(
+    void *spdm_context, spdm_version_number_t spdm_version,
+    uint8_t op_code, uint32_t base_asym_algo,
+    uint32_t base_hash_algo, bool is_data_hash,
+    const uint8_t *message, size_t message_size,
+    uint64_t *completion_time);
+
+/**
+ * Poll the signing operation submitted by libspdm_responder_data_sign_submit_func.
+ *
+ * @param  spdm_context  A pointer to the SPDM context.
+ * @param  is_ready      Indicates if the signature is ready. signature is valid only if true.
+ * @param  signature     A pointer to a destination buffer to store the signature.
+ * @param  sig_size      On input, indicates the size, in bytes, of the destination buffer.
+ *                       On output, indicates the size, in bytes, of the signature in the buffer.
+ *
+ * @retval true  The signing operation is pending or complete.
+ * @retval false The signing operation failed.
+ **/
+typedef bool (*libspdm_responder_data_sign_poll_func)(
+    void *spdm_context, bool *is_ready, uint8_t *signature, size_t *sig_size);
+#endif /* LIBSPDM_RESPONDER_ASYNC_SIGN_SUPPORT */
+
+#if LIBSPDM_PARALLEL_TASK_SUPPORT
+/**
+ * Register a task dispatch function, for example one backed by a thread pool.
+ *
+ * If it is registered, libspdm submits independent cryptographic operations through it, such as
+ * the verification of each issuer/subject pair of the peer certificate chain after
+ * GET_CERTIFICATE. The spdm_context is passed as the dispatch_context of the function.
+ * If it is NOT registered, these operations are executed serially in the calling thread.
+ *
+ * This function must be called after libspdm_init_context, and before any SPDM communication.
+ *
+ * @param  spdm_context   A pointer to the SPDM context.
+ * @param  dispatch_task  The function to dispatch a batch of independent tasks.
+ **/
+void libspdm_register_dispatch_task_func(void *spdm_context,
+                                         libspdm_dispatch_task_func dispatch_task);
+#endif /* LIBSPDM_PARALLEL_TASK_SUPPORT */
+
+#if LIBSPDM_DHE_KEY_POOL_SUPPORT
+/**
+ * Pre-generate ephemeral DHE key pairs for a DHE named group.
+ *
+ * The key pairs are held in the SPDM context and are taken, one per key exchange, by
+ * libspdm_send_receive_key_exchange and the KEY_EXCHANGE responder. A key pair that is taken is
+ * destroyed with its session key exchange and is never reused. If the pool is empty then the key
+ * pair is generated inline as usual.
+ *
+ * The Integrator may call this function during idle time, or from a background worker as long as
+ * calls are serialized with the other libspdm calls on the same SPDM context. For the SM2 named
+ * group the key pair depends on the negotiated SPDM version, so this function should be called
+ * after VERSION negotiation.
+ *
+ * @param  spdm_context     A pointer to the SPDM context.
+ * @param  dhe_named_group  SPDM dhe_named_group of the key pairs.
+ * @param  count            The number of key pairs to hold for this group after the call.
+ *                          It is capped at LIBSPDM_DHE_KEY_POOL_SIZE.
+ *
+ * @retval LIBSPDM_STATUS_SUCCESS       The pool holds the requested number of key pairs.
+ * @retval LIBSPDM_STATUS_BUFFER_FULL   The pool is full with key pairs for other groups.
+ * @retval LIBSPDM_STATUS_CRYPTO_ERROR  A key pair cannot be generated.
+ **/
+libspdm_return_t libspdm_dhe_key_pool_fill(void *spdm_context, uint16_t dhe_named_group,
+                                           size_t count);
+
+/**
+ * Destroy all pre-generated ephemeral DHE key pairs in the SPDM context.
+ *
+ * @param  spdm_context  A pointer to the SPDM context.
+ **/
+void libspdm_dhe_key_pool_flush(void *spdm_context);
+#endif /* LIBSPDM_DHE_KEY_POOL_SUPPORT */
+
+#if LIBSPDM_CONNECTION_SNAPSHOT_SUPPORT
+/**
+ * Save the negotiated state of the connection of an SPDM context into a snapshot.
+ *
+ * The snapshot holds the negotiated version, capabilities and algorithms, the peer digests, the
+ * VCA transcript and the peer certificate chain in use. It is protected by an HMAC with the
+ * negotiated hash algorithm and a key of the Integrator, and can be restored into a fresh SPDM
+ * context via libspdm_set_connection_snapshot. It holds no secret, and no session.
+ * When LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT is 0, the peer certificate chain is saved only if
+ * the last certificate chain retrieved is the one of the slot in use.
+ *
+ * @param  spdm_context   A pointer to the SPDM context.
+ * @param  key            The HMAC key of the snapshot.
+ * @param  key_size       The size in bytes of the HMAC key.
+ * @param  snapshot       The buffer of the snapshot.
+ * @param  snapshot_size  On input, the size in bytes of the buffer.
+ *                        On output, the size in bytes of the snapshot, or the size required if
+ *                        the buffer is too small.
+ *
+ * @retval LIBSPDM_STATUS_SUCCESS              The snapshot is saved.
+ * @retval LIBSPDM_STATUS_INVALID_STATE_LOCAL  The connection is not negotiated yet.
+ * @retval LIBSPDM_STATUS_BUFFER_TOO_SMALL     The buffer is too small.
+ * @retval LIBSPDM_STATUS_CRYPTO_ERROR         The HMAC cannot be computed.
+ **/
+libspdm_return_t libspdm_get_connection_snapshot(void *spdm_context,
+                                                 const void *key, size_t key_size,
+                                                 void *snapshot, size_t *snapshot_size);
+
+/**
+ * Restore the negotiated state of a connection from a snapshot into an SPDM context.
+ *
+ * The SPDM context must be initialized and its local version, capabilities and algorithms must be
+ * set, as the negotiated ones are checked against them. After a successful call the connection is
+ * in the state it was when the snapshot was saved, and the peer certificate chain in use and its
+ * leaf public key are restored as if they were retrieved by GET_CERTIFICATE.
+ *
+ * @param  spdm_context   A pointer to the SPDM context.
+ * @param  key            The HMAC key of the snapshot.
+ * @param  key_size       The size in bytes of the HMAC key.
+ * @param  snapshot       The snapshot.
+ * @param  snapshot_size  The size in bytes of the snapshot.
+ *
+ * @retval LIBSPDM_STATUS_SUCCESS            The connection is restored.
+ * @retval LIBSPDM_STATUS_INVALID_PARAMETER  The snapshot is malformed, of another format version,
+ *                                           or negotiated settings the context does not support.
+ * @retval LIBSPDM_STATUS_VERIF_FAIL         The HMAC of the snapshot does not match.
+ * @retval LIBSPDM_STATUS_INVALID_CERT       The peer certificate chain cannot be parsed.
+ **/
+libspdm_return_t libspdm_set_connection_snapshot(void *spdm_context,
+                                                 const void *key, size_t key_size,
+                                                 const void *snapshot, size_t snapshot_size);
+#endif /* LIBSPDM_CONNECTION_SNAPSHOT_SUPPORT */
+
+#if LIBSPDM_STATISTICS_SUPPORT
+/* Bucket i of a latency histogram counts the durations below 2^i microseconds that do not fit a
+ * lower bucket. The last bucket also counts all longer durations. */
+#define LIBSPDM_STATISTICS_HISTOGRAM_SIZE 16
+
+/* SPDM request codes 0x80 - 0x8F and 0xE0 - 0xFF. */
+#define LIBSPDM_STATISTICS_REQUEST_CODE_COUNT 48
+
+typedef struct {
+    uint64_t count;
+    uint64_t min_us;
+    uint64_t max_us;
+    uint64_t total_us;
+    uint64_t histogram[LIBSPDM_STATISTICS_HISTOGRAM_SIZE];
+} libspdm_latency_statistics_t;
+
+typedef enum {
+    LIBSPDM_STATISTICS_CRYPTO_ASYM_SIGN,
+    LIBSPDM_STATISTICS_CRYPTO_ASYM_VERIFY,
+    LIBSPDM_STATISTICS_CRYPTO_DHE,
+    LIBSPDM_STATISTICS_CRYPTO_HMAC,
+    LIBSPDM_STATISTICS_CRYPTO_AEAD,
+    LIBSPDM_STATISTICS_CRYPTO_CERT_CHAIN_VERIFY,
+
+    /* MAX */
+    LIBSPDM_STATISTICS_CRYPTO_MAX
+} libspdm_statistics_crypto_class_t;
+
+/* The sender and receiver buffers, and the regions of the scratch buffer. Without
+ * LIBSPDM_ENABLE_CAPABILITY_CHUNK_CAP the secured message region is the sender receiver region. */
+typedef enum {
+    LIBSPDM_STATISTICS_BUFFER_SENDER,
+    LIBSPDM_STATISTICS_BUFFER_RECEIVER,
+    LIBSPDM_STATISTICS_BUFFER_SCRATCH_SECURE_MESSAGE,
+    LIBSPDM_STATISTICS_BUFFER_SCRATCH_LARGE_MESSAGE,
+    LIBSPDM_STATISTICS_BUFFER_SCRATCH_SENDER_RECEIVER,
+    LIBSPDM_STATISTICS_BUFFER_SCRATCH_LARGE_SENDER_RECEIVER,
+    LIBSPDM_STATISTICS_BUFFER_SCRATCH_LAST_SPDM_REQUEST,
+    LIBSPDM_STATISTICS_BUFFER_SCRATCH_CACHE_SPDM_REQUEST,
+
+    /* MAX */
+    LIBSPDM_STATISTICS_BUFFER_MAX
+} libspdm_statistics_buffer_t;
+
+typedef struct {
+    /* Peak size in bytes of the data held in each libspdm_statistics_buffer_t. For the sender and
+     * receiver buffers it is the transport message. */
+    uint32_t peak[LIBSPDM_STATISTICS_BUFFER_MAX];
+} libspdm_buffer_statistics_t;
+
+typedef struct {
+    /* Handling time of each request code, indexed via libspdm_statistics_get_request_index.
+     * For a Responder it is the time to build the response. For a Requester it is the time from
+     * sending the request to receiving the response. */
+    libspdm_latency_statistics_t request[LIBSPDM_STATISTICS_REQUEST_CODE_COUNT];
+    /* Size of the SPDM messages received and sent. */
+    uint64_t bytes_in;
+    uint64_t bytes_out;
+    /* Secured messages encoded and decoded, and secured messages that fail to decrypt. */
+    uint64_t secured_message_encoded;
+    uint64_t secured_message_decoded;
+    uint64_t decrypt_failure;
+    /* ERROR responses with ResponseNotReady and Busy, sent by a Responder or received by a
+     * Requester. */
+    uint64_t response_not_ready;
+    uint64_t busy;
+    /* Delays waited by a Requester before retrying a request after Busy, and before
+     * RESPOND_IF_READY after ResponseNotReady. */
+    libspdm_latency_statistics_t busy_retry_delay;
+    libspdm_latency_statistics_t response_not_ready_delay;
+    /* Time spent in each libspdm_statistics_crypto_class_t. Only AEAD and HMAC are tracked per
+     * session. */
+    libspdm_latency_statistics_t crypto[LIBSPDM_STATISTICS_CRYPTO_MAX];
+    /* Buffer usage over all messages, and while handling each request code, and the capacity of
+     * each buffer. They are tracked for the SPDM context only, so that an Integrator can size the
+     * buffers from the peaks of a representative run. */
+    libspdm_buffer_statistics_t buffer;
+    libspdm_buffer_statistics_t request_buffer[LIBSPDM_STATISTICS_REQUEST_CODE_COUNT];
+    uint32_t buffer_capacity[LIBSPDM_STATISTICS_BUFFER_MAX];
+} libspdm_statistics_t;
+
+/**
+ * Return the index of a request code in libspdm_statistics_t.request.
+ *
+ * @param  request_code  The SPDM request code.
+ *
+ * @return The index, or LIBSPDM_STATISTICS_REQUEST_CODE_COUNT if the code is not a request code.
+ **/
+size_t libspdm_statistics_get_request_index(uint8_t request_code);
+#endif /* LIBSPDM_STATISTICS_SUPPORT */
+
+#if LIBSPDM_TRACE_SUPPORT
+typedef enum {
+    /* Handling of one SPDM request. On a Requester it spans from sending the request to receiving
+     * the response. On a Responder it spans the processing of the request. */
+    LIBSPDM_TRACE_EVENT_REQUEST,
+    LIBSPDM_TRACE_EVENT_TRANSPORT_ENCODE,
+    LIBSPDM_TRACE_EVENT_TRANSPORT_DECODE,
+    LIBSPDM_TRACE_EVENT_AEAD_ENCRYPT,
+    LIBSPDM_TRACE_EVENT_AEAD_DECRYPT,
+    /* Transcript hash update and finalization. */
+    LIBSPDM_TRACE_EVENT_HASH_UPDATE,
+    LIBSPDM_TRACE_EVENT_HASH_FINAL,
+    LIBSPDM_TRACE_EVENT_ASYM_SIGN,
+    LIBSPDM_TRACE_EVENT_ASYM_VERIFY,
+    LIBSPDM_TRACE_EVENT_DHE_GENERATE_KEY,
+    LIBSPDM_TRACE_EVENT_DHE_COMPUTE_KEY,
+    LIBSPDM_TRACE_EVENT_CERT_CHAIN_VERIFY,
+
+    /* MAX */
+    LIBSPDM_TRACE_EVENT_MAX
+} libspdm_trace_event_t;
+
+typedef enum {
+    LIBSPDM_TRACE_PHASE_BEGIN,
+    LIBSPDM_TRACE_PHASE_END,
+} libspdm_trace_phase_t;
+
+/**
+ * Trace the begin or the end of an operation.
+ *
+ * Each LIBSPDM_TRACE_PHASE_BEGIN event is followed by the LIBSPDM_TRACE_PHASE_END event of the same
+ * operation on the same SPDM context. Operations may nest, for example AEAD_ENCRYPT inside
+ * TRANSPORT_ENCODE. The function is called inline, so it should return quickly.
+ *
+ * @param  spdm_context  A pointer to the SPDM context.
+ * @param  event         The traced operation.
+ * @param  phase         The begin or the end of the operation.
+ * @param  request_code  The SPDM request code being handled, or 0 if it is not known.
+ * @param  session_id    The SPDM session ID, or 0 if the operation is outside of a session or the
+ *                       session is not known.
+ * @param  size          For LIBSPDM_TRACE_PHASE_BEGIN, the size in bytes of the input of the
+ *                       operation. For LIBSPDM_TRACE_PHASE_END, the size in bytes of the output,
+ *                       or 0 if the operation does not have an output or failed.
+ **/
+typedef void (*libspdm_trace_func)(void *spdm_context, libspdm_trace_event_t event,
+                                   libspdm_trace_phase_t phase, uint8_t request_code,
+                                   uint32_t session_id, size_t size);
+
+/**
+ * Register a trace function.
+ *
+ * This function must be called after libspdm_init_context, and before any SPDM communication.
+ *
+ * @param  spdm_context  A pointer to the SPDM context.
+ * @param  trace         The function to trace the operations, or NULL to stop tracing.
+ **/
+void libspdm_register_trace_func(void *spdm_context, libspdm_trace_func trace);
+
+/**
+ * Return the name of a trace event, such as "aead_encrypt".
+ *
+ * @param  event  The trace event.
+ *
+ * @return The name, or "unknown" if the event is not valid.
+ **/
+const char *libspdm_trace_get_event_name(libspdm_trace_event_t event);
+#endif /* LIBSPDM_TRACE_SUPPORT */
+
+#if LIBSPDM_ALLOC_SCOPE_SUPPORT
+typedef enum {
+    /* A flow starts. The memory allocated until LIBSPDM_ALLOC_SCOPE_FLOW_END is freed by then. */
+    LIBSPDM_ALLOC_SCOPE_FLOW_BEGIN,
+    /* The flow completed or failed. */
+    LIBSPDM_ALLOC_SCOPE_FLOW_END,
+    /* The memory allocated until LIBSPDM_ALLOC_SCOPE_PERSISTENT_END outlives the flow, such as the
+     * session transcript hash context. It is only requested inside a flow. */
+    LIBSPDM_ALLOC_SCOPE_PERSISTENT_BEGIN,
+    LIBSPDM_ALLOC_SCOPE_PERSISTENT_END,
+} libspdm_alloc_scope_t;
+
+/**
+ * Enter or leave an allocation scope.
+ *
+ * A flow is the handling of one KEY_EXCHANGE, FINISH, PSK_EXCHANGE or PSK_FINISH: on a Requester
+ * one attempt to send the request and receive the response, on a Responder the processing of the
+ * request. Flows of different SPDM contexts may nest if they run in the same thread, for example
+ * when a Requester and a Responder are connected in the same process.
+ *
+ * @param  spdm_context  A pointer to the SPDM context.
+ * @param  scope         The scope being entered or left.
+ * @param  request_code  The SPDM request code of the flow.
+ **/
+typedef void (*libspdm_alloc_scope_func)(void *spdm_context, libspdm_alloc_scope_t scope,
+                                         uint8_t request_code);
+
+/**
+ * Register an allocation scope function.
+ *
+ * This function must be called after libspdm_init_context, and before any SPDM communication.
+ *
+ * @param  spdm_context  A pointer to the SPDM context.
+ * @param  alloc_scope   The function to enter and leave the allocation scopes, or NULL.
+ **/
+void libspdm_register_alloc_scope_func(void *spdm_context, libspdm_alloc_scope_func alloc_scope);
+#endif /* LIBSPDM_ALLOC_SCOPE_SUPPORT */
+
 /**
  * This function gets the session info via session ID.
  *
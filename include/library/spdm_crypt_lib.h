@@ -11,6 +11,7 @@
 
 #include "hal/base.h"
 #include "industry_standard/spdm.h"
+#include "library/spdm_task_dispatch.h"
 
 #if (LIBSPDM_FFDHE_4096_SUPPORT)
 #define LIBSPDM_MAX_DHE_KEY_SIZE 512
@@ -796,6 +797,97 @@ bool libspdm_aead_decryption(const spdm_version_number_t secured_message_version
                              size_t tag_size, uint8_t *data_out,
                              size_t *data_out_size);
 
+#if LIBSPDM_SESSION_PREALLOCATION_SUPPORT
+/**
+ * Allocates and initializes one AEAD context, based upon negotiated AEAD algorithm.
+ *
+ * The context holds a key, so that the encryption and decryption with it do not allocate memory.
+ *
+ * @param  aead_cipher_suite  SPDM aead_cipher_suite
+ *
+ * @return  Pointer to the AEAD context, or NULL if the allocation fails or the AEAD algorithm
+ *          does not support contexts. The caller then uses libspdm_aead_encryption and
+ *          libspdm_aead_decryption.
+ **/
+void *libspdm_aead_new(uint16_t aead_cipher_suite);
+
+/**
+ * Release an AEAD context, based upon negotiated AEAD algorithm.
+ *
+ * @param  aead_cipher_suite  SPDM aead_cipher_suite
+ * @param  aead_ctx           Pointer to the AEAD context.
+ **/
+void libspdm_aead_free(uint16_t aead_cipher_suite, void *aead_ctx);
+
+/**
+ * Set the key of an AEAD context, based upon negotiated AEAD algorithm.
+ *
+ * @param  aead_cipher_suite  SPDM aead_cipher_suite
+ * @param  aead_ctx           Pointer to the AEAD context.
+ * @param  key                Pointer to the encryption key.
+ * @param  key_size           Size of the encryption key in bytes.
+ *
+ * @retval true   The key is set.
+ * @retval false  The key is not set.
+ **/
+bool libspdm_aead_set_key(uint16_t aead_cipher_suite, void *aead_ctx,
+                          const uint8_t *key, size_t key_size);
+
+/**
+ * Performs AEAD authenticated encryption with the key of an AEAD context,
+ * based upon negotiated AEAD algorithm.
+ *
+ * @param  aead_cipher_suite  SPDM aead_cipher_suite
+ * @param  aead_ctx           Pointer to the AEAD context.
+ * @param  iv                 Pointer to the IV value.
+ * @param  iv_size            Size of the IV value in bytes.
+ * @param  a_data             Pointer to the additional authenticated data (AAD).
+ * @param  a_data_size        Size of the additional authenticated data (AAD) in bytes.
+ * @param  data_in            Pointer to the input data buffer to be encrypted.
+ * @param  data_in_size       Size of the input data buffer in bytes.
+ * @param  tag_out            Pointer to a buffer that receives the authentication tag output.
+ * @param  tag_size           Size of the authentication tag in bytes.
+ * @param  data_out           Pointer to a buffer that receives the encryption output.
+ * @param  data_out_size      Size of the output data buffer in bytes.
+ *
+ * @retval true   AEAD authenticated encryption succeeded.
+ * @retval false  AEAD authenticated encryption failed.
+ **/
+bool libspdm_aead_encryption_with_context(uint16_t aead_cipher_suite, void *aead_ctx,
+                                          const uint8_t *iv, size_t iv_size,
+                                          const uint8_t *a_data, size_t a_data_size,
+                                          const uint8_t *data_in, size_t data_in_size,
+                                          uint8_t *tag_out, size_t tag_size,
+                                          uint8_t *data_out, size_t *data_out_size);
+
+/**
+ * Performs AEAD authenticated decryption with the key of an AEAD context,
+ * based upon negotiated AEAD algorithm.
+ *
+ * @param  aead_cipher_suite  SPDM aead_cipher_suite
+ * @param  aead_ctx           Pointer to the AEAD context.
+ * @param  iv                 Pointer to the IV value.
+ * @param  iv_size            Size of the IV value in bytes.
+ * @param  a_data             Pointer to the additional authenticated data (AAD).
+ * @param  a_data_size        Size of the additional authenticated data (AAD) in bytes.
+ * @param  data_in            Pointer to the input data buffer to be decrypted.
+ * @param  data_in_size       Size of the input data buffer in bytes.
+ * @param  tag                Pointer to a buffer that contains the authentication tag.
+ * @param  tag_size           Size of the authentication tag in bytes.
+ * @param  data_out           Pointer to a buffer that receives the decryption output.
+ * @param  data_out_size      Size of the output data buffer in bytes.
+ *
+ * @retval true   AEAD authenticated decryption succeeded.
+ * @retval false  AEAD authenticated decryption failed.
+ **/
+bool libspdm_aead_decryption_with_context(uint16_t aead_cipher_suite, void *aead_ctx,
+                                          const uint8_t *iv, size_t iv_size,
+                                          const uint8_t *a_data, size_t a_data_size,
+                                          const uint8_t *data_in, size_t data_in_size,
+                                          const uint8_t *tag, size_t tag_size,
+                                          uint8_t *data_out, size_t *data_out_size);
+#endif /* LIBSPDM_SESSION_PREALLOCATION_SUPPORT */
+
 /**
  * Generates a random byte stream of the specified size.
  *
@@ -923,6 +1015,57 @@ bool libspdm_verify_certificate_chain_buffer(uint32_t base_hash_algo, uint32_t b
                                              size_t cert_chain_buffer_size,
                                              bool is_requester_cert, bool is_device_cert_model);
 
+#if LIBSPDM_PARALLEL_TASK_SUPPORT
+/**
+ * Verify that each certificate of a certificate chain is issued by its preceding certificate.
+ *
+ * Every issuer/subject pair is verified as an independent task through dispatch_task, and the
+ * results are reduced afterwards. If dispatch_task is NULL then the chain is verified serially
+ * through libspdm_x509_verify_cert_chain.
+ *
+ * @param  root_cert          Trusted root certificate that issued the first certificate.
+ * @param  root_cert_length   Size in bytes of the trusted root certificate.
+ * @param  cert_chain         One or more ASN.1 DER-encoded X.509 certificates.
+ * @param  cert_chain_length  Total size in bytes of the certificate chain.
+ * @param  dispatch_task      The function to dispatch the verification tasks.
+ * @param  dispatch_context   The context passed to dispatch_task.
+ *
+ * @retval true   All certificates are issued by their preceding certificate.
+ * @retval false  Invalid certificate chain or a signature verification failed.
+ **/
+bool libspdm_verify_cert_chain_parallel(const uint8_t *root_cert, size_t root_cert_length,
+                                        const uint8_t *cert_chain, size_t cert_chain_length,
+                                        libspdm_dispatch_task_func dispatch_task,
+                                        void *dispatch_context);
+
+/**
+ * This function verifies the integrity of certificate chain buffer including
+ * spdm_cert_chain_t header. The issuer/subject signatures are verified through dispatch_task.
+ *
+ * @param  base_hash_algo          SPDM base_hash_algo
+ * @param  base_asym_algo          SPDM base_asym_algo
+ * @param  cert_chain_buffer       The certificate chain buffer including spdm_cert_chain_t header.
+ * @param  cert_chain_buffer_size  Size in bytes of the certificate chain buffer.
+ * @param  is_requester_cert       Is the function verifying requester or responder cert.
+ * @param  is_device_cert_model    If true, the cert chain is DeviceCert model.
+ *                                 If false, the cert chain is AliasCert model.
+ * @param  dispatch_task           The function to dispatch the verification tasks.
+ *                                 If NULL, the chain is verified serially.
+ * @param  dispatch_context        The context passed to dispatch_task.
+ *
+ * @retval true   Certificate chain buffer integrity verification pass.
+ * @retval false  Certificate chain buffer integrity verification fail.
+ **/
+bool libspdm_verify_certificate_chain_buffer_parallel(uint32_t base_hash_algo,
+                                                      uint32_t base_asym_algo,
+                                                      const void *cert_chain_buffer,
+                                                      size_t cert_chain_buffer_size,
+                                                      bool is_requester_cert,
+                                                      bool is_device_cert_model,
+                                                      libspdm_dispatch_task_func dispatch_task,
+                                                      void *dispatch_context);
+#endif /* LIBSPDM_PARALLEL_TASK_SUPPORT */
+
 /**
  * Retrieve the asymmetric public key from one DER-encoded X509 certificate,
  * based upon negotiated asymmetric or requester asymmetric algorithm.
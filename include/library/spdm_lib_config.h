@@ -32,6 +32,35 @@
 #define LIBSPDM_DEBUG_ENABLE 1
 #endif
 
+/* Compile-time filter of debug messages. This is a bitwise OR of the `LIBSPDM_DEBUG_*` levels in
+ * `debuglib.h` that are compiled in. A `LIBSPDM_DEBUG` whose level is not in the mask, and the hex
+ * dumps if `LIBSPDM_DEBUG_INFO` is not in the mask, are removed by the compiler together with their
+ * arguments and format strings. For example, set it to `LIBSPDM_DEBUG_ERROR` to keep only errors.
+ * Messages that are compiled in are then filtered at run time, see
+ * `LIBSPDM_DEBUG_LEVEL_FILTER_ENABLE`.
+ */
+#ifndef LIBSPDM_DEBUG_LEVEL_MASK
+#define LIBSPDM_DEBUG_LEVEL_MASK (LIBSPDM_DEBUG_INFO | LIBSPDM_DEBUG_ERROR)
+#endif
+
+/* If enabled then the debuglib must provide `libspdm_debug_print_enabled`, and messages whose level
+ * is disabled at run time are dropped before their arguments are evaluated. If disabled then every
+ * message compiled in is passed to `libspdm_debug_print`, as with a debuglib that predates the
+ * run-time filter.
+ */
+#ifndef LIBSPDM_DEBUG_LEVEL_FILTER_ENABLE
+#define LIBSPDM_DEBUG_LEVEL_FILTER_ENABLE 0
+#endif
+
+/* If enabled then the sample debuglib records each debug message into a ring buffer as the address
+ * of its format string and its raw arguments instead of formatting and printing it. The ring is
+ * read and formatted offline through `debuglib_ext.h`, so diagnostics can stay enabled at a cost
+ * of a few stores per message. Hex dumps cannot be deferred and are compiled out in this mode.
+ */
+#ifndef LIBSPDM_DEBUG_BINARY_LOG_ENABLE
+#define LIBSPDM_DEBUG_BINARY_LOG_ENABLE 0
+#endif
+
 /* The SPDM specification allows a Responder to return up to 256 version entries in the `VERSION`
  * response to the Requester, including duplicate entries. For a Requester this value specifies the
  * maximum number of entries that libspdm will tolerate in a `VERSION` response before returning an
@@ -226,6 +255,103 @@
 #define LIBSPDM_CERT_PARSE_SUPPORT 1
 #endif
 
+/* If LIBSPDM_PARALLEL_TASK_SUPPORT is 1 then the Integrator can register a task dispatch function,
+ * for example one backed by a thread pool, via libspdm_register_dispatch_task_func. libspdm then
+ * submits independent cryptographic operations, such as the verification of each issuer/subject
+ * pair of a peer certificate chain, through that function. If no function is registered then the
+ * operations are executed serially in the calling thread.
+ */
+#ifndef LIBSPDM_PARALLEL_TASK_SUPPORT
+#define LIBSPDM_PARALLEL_TASK_SUPPORT 0
+#endif
+
+/* If LIBSPDM_DHE_KEY_POOL_SUPPORT is 1 then the Integrator can pre-generate ephemeral DHE key pairs
+ * via libspdm_dhe_key_pool_fill, for example from an idle loop, so that KEY_EXCHANGE and
+ * KEY_EXCHANGE_RSP take a ready key pair instead of generating one on the critical path. Each key
+ * pair is used for one key exchange only. LIBSPDM_DHE_KEY_POOL_SIZE is the maximum number of
+ * pre-generated key pairs held by one SPDM context.
+ */
+#ifndef LIBSPDM_DHE_KEY_POOL_SUPPORT
+#define LIBSPDM_DHE_KEY_POOL_SUPPORT 0
+#endif
+
+#ifndef LIBSPDM_DHE_KEY_POOL_SIZE
+#define LIBSPDM_DHE_KEY_POOL_SIZE 4
+#endif
+
+/* If LIBSPDM_STATISTICS_SUPPORT is 1 then libspdm keeps a statistics block per SPDM context and per
+ * session, such as the handling time of each request code, the number of bytes and secured
+ * messages, and the time spent in each class of cryptographic operation. The Integrator reads it
+ * via libspdm_get_data with LIBSPDM_DATA_STATISTICS and must provide libspdm_get_timestamp_us.
+ */
+#ifndef LIBSPDM_STATISTICS_SUPPORT
+#define LIBSPDM_STATISTICS_SUPPORT 0
+#endif
+
+/* If LIBSPDM_TRACE_SUPPORT is 1 then the Integrator can register a trace function via
+ * libspdm_register_trace_func. libspdm calls it at the begin and the end of each request, transport
+ * encode/decode, AEAD, transcript hash and asymmetric operation. If no function is registered then
+ * each trace point costs one branch. If LIBSPDM_TRACE_SUPPORT is 0 then the trace points are
+ * compiled out.
+ */
+#ifndef LIBSPDM_TRACE_SUPPORT
+#define LIBSPDM_TRACE_SUPPORT 0
+#endif
+
+/* If LIBSPDM_ALLOC_SCOPE_SUPPORT is 1 then the Integrator can register an allocation scope
+ * function via libspdm_register_alloc_scope_func. libspdm calls it at the begin and the end of each
+ * KEY_EXCHANGE, FINISH, PSK_EXCHANGE and PSK_FINISH flow, so that the memory allocated by the
+ * cryptography library during the flow can be served by an arena, such as the one of the sample
+ * malloclib, and released at once when the flow completes or fails.
+ */
+#ifndef LIBSPDM_ALLOC_SCOPE_SUPPORT
+#define LIBSPDM_ALLOC_SCOPE_SUPPORT 0
+#endif
+
+/* If LIBSPDM_SESSION_PREALLOCATION_SUPPORT is 1 then each session allocates one AEAD context per
+ * direction when its data keys are derived, and keeps it until the session is freed. The
+ * application data and the HEARTBEAT and KEY_UPDATE messages of an established session are then
+ * encrypted and decrypted with these contexts, without allocating memory per message. A KEY_UPDATE
+ * replaces the context of the updated key with one keyed with the new key. With
+ * LIBSPDM_ALLOC_SCOPE_SUPPORT the contexts are allocated in a persistent allocation scope.
+ */
+#ifndef LIBSPDM_SESSION_PREALLOCATION_SUPPORT
+#define LIBSPDM_SESSION_PREALLOCATION_SUPPORT 0
+#endif
+
+/* If LIBSPDM_CONNECTION_SNAPSHOT_SUPPORT is 1 then the Integrator can save the negotiated state of
+ * a connection via libspdm_get_connection_snapshot, such as before a process restart, and restore
+ * it into a fresh SPDM context via libspdm_set_connection_snapshot. The restored connection is
+ * ready for KEY_EXCHANGE or GET_MEASUREMENTS without VCA, GET_CERTIFICATE or CHALLENGE. When
+ * LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT is 0, the SPDM context keeps a copy of the last peer
+ * certificate chain retrieved, of up to LIBSPDM_MAX_CERT_CHAIN_SIZE bytes, for the snapshot.
+ */
+#ifndef LIBSPDM_CONNECTION_SNAPSHOT_SUPPORT
+#define LIBSPDM_CONNECTION_SNAPSHOT_SUPPORT 0
+#endif
+
+/* If LIBSPDM_MEASUREMENT_CACHE_SUPPORT is 1 then the SPDM context keeps the last signed measurement
+ * record got by libspdm_get_measurement_blocks, of up to LIBSPDM_MAX_MEASUREMENT_RECORD_SIZE bytes.
+ * libspdm_get_measurement_blocks_cached returns it, without getting the measurement blocks again,
+ * when the measurement summary hash or the content changed field of the device shows that the
+ * measurements have not changed.
+ */
+#ifndef LIBSPDM_MEASUREMENT_CACHE_SUPPORT
+#define LIBSPDM_MEASUREMENT_CACHE_SUPPORT 0
+#endif
+
+/* If LIBSPDM_ADAPTIVE_RETRY_SUPPORT is 1 then the Requester waits before retrying a request after
+ * a Busy ERROR response for a delay learned from the peer, instead of the fixed
+ * LIBSPDM_DATA_REQUEST_RETRY_DELAY_TIME. The delay starts from the smoothed response time of the
+ * peer and the time it stayed Busy before, doubles with each retry up to a maximum derived from
+ * CTExponent, and is jittered. The retries of a request may be bounded by a deadline. After a
+ * ResponseNotReady ERROR response the Requester waits between RDT and twice RDT, jittered and
+ * bounded by RDT * RDTM, instead of twice RDT.
+ */
+#ifndef LIBSPDM_ADAPTIVE_RETRY_SUPPORT
+#define LIBSPDM_ADAPTIVE_RETRY_SUPPORT 0
+#endif
+
 /* Code space optimization for Optional request/response messages.*/
 
 /* Consumers of libspdm may wish to not fully implement all of the optional
@@ -312,6 +438,25 @@
 #define LIBSPDM_RESPOND_IF_READY_SUPPORT 1
 #endif
 
+/* If LIBSPDM_RESPONDER_ASYNC_SIGN_SUPPORT is 1 then a Responder Integrator can register an
+ * asynchronous signer via libspdm_register_responder_data_sign_async_func. The CHALLENGE_AUTH,
+ * MEASUREMENTS and KEY_EXCHANGE_RSP signatures are then submitted to it, the Responder returns a
+ * ResponseNotReady ERROR response, and completes the response when the Requester sends
+ * RESPOND_IF_READY after the signature is ready. This requires LIBSPDM_RESPOND_IF_READY_SUPPORT.
+ */
+#ifndef LIBSPDM_RESPONDER_ASYNC_SIGN_SUPPORT
+#define LIBSPDM_RESPONDER_ASYNC_SIGN_SUPPORT 0
+#endif
+
+/* If LIBSPDM_MEASUREMENT_COLLECTION_EX_SUPPORT is 1 then the Responder collects measurements with
+ * libspdm_measurement_collection_ex instead of libspdm_measurement_collection. It passes a state
+ * that libspdm keeps for the L1/L2 transcript of the request, so that the device secret library
+ * can report content_changed per connection and per session.
+ */
+#ifndef LIBSPDM_MEASUREMENT_COLLECTION_EX_SUPPORT
+#define LIBSPDM_MEASUREMENT_COLLECTION_EX_SUPPORT 0
+#endif
+
 /*
  * MinDataTransferSize = 42
  *
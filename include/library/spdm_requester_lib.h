@@ -262,6 +262,111 @@ libspdm_return_t libspdm_get_measurement_ex(void *spdm_context, const uint32_t *
                                             void *requester_nonce,
                                             void *responder_nonce);
 
+/* A measurement block of the measurement record returned by libspdm_get_measurement_blocks. */
+typedef struct {
+    uint8_t index;
+    uint8_t measurement_specification;
+    uint16_t measurement_size;
+    /* The measurement of the block, within the measurement record. */
+    const uint8_t *measurement;
+} libspdm_measurement_block_t;
+
+/**
+ * This function sends GET_MEASUREMENT to get all the measurement blocks from the device, with at
+ * most one signature.
+ *
+ * All the blocks are requested at once. If the device returns an error, such as when the whole
+ * measurement record does not fit a response, the number of blocks is requested and then each
+ * block is requested by index. The indices without a measurement are skipped. If the signature is
+ * requested, it is requested with the last block only and covers all the blocks.
+ *
+ * @param  spdm_context               A pointer to the SPDM context.
+ * @param  session_id                 Indicates if it is a secured message protected via SPDM session.
+ *                                    If session_id is NULL, it is a normal message.
+ *                                    If session_id is NOT NULL, it is a secured message.
+ * @param  request_attribute          The request attribute of the request messages.
+ * @param  slot_id                    The number of slot for the certificate chain.
+ * @param  content_changed            The measurement content changed output param.
+ * @param  number_of_blocks           On input, indicate the number of entries of blocks.
+ *                                    On output, indicate the number of blocks of the measurement
+ *                                    record, or the number of entries required if blocks is too
+ *                                    small.
+ * @param  blocks                     The blocks of the measurement record, in the order returned
+ *                                    by the device. They point into measurement_record.
+ * @param  measurement_record_length  On input, indicate the size in bytes of the destination buffer to store the measurement record.
+ *                                    On output, indicate the size in bytes of the measurement record.
+ * @param  measurement_record         A pointer to a destination buffer to store the measurement record.
+ *
+ * @retval LIBSPDM_STATUS_SUCCESS           The measurement blocks are got successfully.
+ * @retval LIBSPDM_STATUS_BUFFER_TOO_SMALL  The measurement record or the blocks are too small.
+ * @retval LIBSPDM_STATUS_VERIF_FAIL        The signature verification fails.
+ **/
+libspdm_return_t libspdm_get_measurement_blocks(void *spdm_context, const uint32_t *session_id,
+                                                uint8_t request_attribute,
+                                                uint8_t slot_id,
+                                                uint8_t *content_changed,
+                                                uint8_t *number_of_blocks,
+                                                libspdm_measurement_block_t *blocks,
+                                                uint32_t *measurement_record_length,
+                                                void *measurement_record);
+
+#if LIBSPDM_MEASUREMENT_CACHE_SUPPORT
+/**
+ * This function gets all the measurement blocks from the device as libspdm_get_measurement_blocks,
+ * or returns the blocks kept from the last signed libspdm_get_measurement_blocks if the device
+ * shows that the measurements have not changed since then.
+ *
+ * The blocks are kept only if the signature is requested, so that the returned blocks are always
+ * verified. The kept blocks are returned if
+ * - measurement_summary_hash is not NULL, and is the measurement summary hash of all the
+ *   measurements kept, or
+ * - measurement_summary_hash is NULL, the SPDM version is 1.2 or later, and a signed
+ *   GET_MEASUREMENTS for the number of measurements reports no change of the measurements and the
+ *   same number of blocks.
+ * Otherwise, the measurement blocks are got from the device and kept.
+ *
+ * The kept blocks are dropped by any other signed GET_MEASUREMENTS, by the end of the session they
+ * were got in, and by a new certificate chain of their slot. They are returned only for the same
+ * session_id, slot_id and request_attribute.
+ *
+ * @param  spdm_context               A pointer to the SPDM context.
+ * @param  session_id                 Indicates if it is a secured message protected via SPDM session.
+ *                                    If session_id is NULL, it is a normal message.
+ *                                    If session_id is NOT NULL, it is a secured message.
+ * @param  request_attribute          The request attribute of the request messages.
+ * @param  slot_id                    The number of slot for the certificate chain.
+ * @param  measurement_summary_hash   The measurement summary hash of all the measurements, such as
+ *                                    from libspdm_challenge or libspdm_start_session with
+ *                                    SPDM_CHALLENGE_REQUEST_ALL_MEASUREMENTS_HASH, or NULL.
+ * @param  content_changed            The measurement content changed output param. It is
+ *                                    SPDM_MEASUREMENTS_RESPONSE_CONTENT_NO_CHANGE_DETECTED
+ *                                    if the kept blocks are returned.
+ * @param  number_of_blocks           On input, indicate the number of entries of blocks.
+ *                                    On output, indicate the number of blocks of the measurement
+ *                                    record, or the number of entries required if blocks is too
+ *                                    small.
+ * @param  blocks                     The blocks of the measurement record. They point into
+ *                                    measurement_record.
+ * @param  measurement_record_length  On input, indicate the size in bytes of the destination buffer to store the measurement record.
+ *                                    On output, indicate the size in bytes of the measurement record.
+ * @param  measurement_record         A pointer to a destination buffer to store the measurement record.
+ *
+ * @retval LIBSPDM_STATUS_SUCCESS           The measurement blocks are got successfully.
+ * @retval LIBSPDM_STATUS_BUFFER_TOO_SMALL  The measurement record or the blocks are too small.
+ * @retval LIBSPDM_STATUS_VERIF_FAIL        The signature verification fails.
+ **/
+libspdm_return_t libspdm_get_measurement_blocks_cached(void *spdm_context,
+                                                       const uint32_t *session_id,
+                                                       uint8_t request_attribute,
+                                                       uint8_t slot_id,
+                                                       const void *measurement_summary_hash,
+                                                       uint8_t *content_changed,
+                                                       uint8_t *number_of_blocks,
+                                                       libspdm_measurement_block_t *blocks,
+                                                       uint32_t *measurement_record_length,
+                                                       void *measurement_record);
+#endif /* LIBSPDM_MEASUREMENT_CACHE_SUPPORT */
+
 #if (LIBSPDM_ENABLE_CAPABILITY_KEY_EX_CAP) || (LIBSPDM_ENABLE_CAPABILITY_PSK_EX_CAP)
 /**
  * This function sends KEY_EXCHANGE/FINISH or PSK_EXCHANGE/PSK_FINISH
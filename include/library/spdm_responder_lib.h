@@ -239,6 +239,25 @@ void libspdm_trigger_key_update_callback(
 void libspdm_register_key_update_callback_func(
     void *spdm_context, libspdm_key_update_callback_func spdm_key_update_callback);
 
+#if LIBSPDM_RESPONDER_ASYNC_SIGN_SUPPORT
+/**
+ * Register an asynchronous signer for CHALLENGE_AUTH, MEASUREMENTS and KEY_EXCHANGE_RSP.
+ *
+ * When registered, the responder submits the signature to the signer and returns
+ * ERROR(ResponseNotReady). The requester then collects the response with RESPOND_IF_READY.
+ * Only one response waits for a signature at a time. Other signatures are generated by
+ * libspdm_responder_data_sign.
+ *
+ * @param  spdm_context  A pointer to the SPDM context.
+ * @param  submit_func   The function to submit a signing operation, or NULL to unregister.
+ * @param  poll_func     The function to poll the signing operation.
+ **/
+void libspdm_register_responder_data_sign_async_func(
+    void *spdm_context,
+    libspdm_responder_data_sign_submit_func submit_func,
+    libspdm_responder_data_sign_poll_func poll_func);
+#endif /* LIBSPDM_RESPONDER_ASYNC_SIGN_SUPPORT */
+
 /**
  * This function initializes the key_update encapsulated state.
  *
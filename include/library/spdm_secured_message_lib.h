@@ -225,6 +225,22 @@ typedef struct {
     uint32_t session_id;
 } libspdm_error_struct_t;
 
+/**
+ * Return the size of the secured message in front of the application message.
+ *
+ * It is the record header (session ID, sequence number and length), followed by the
+ * application data length if the session is encrypted. An application message placed this far
+ * into the secured message buffer is encoded in place by libspdm_encode_secured_message().
+ *
+ * @param  spdm_secured_message_context    A pointer to the SPDM secured message context.
+ * @param  spdm_secured_message_callbacks  A pointer to a secured message callback functions structure.
+ *
+ * @return the size in bytes of the secured message header.
+ **/
+size_t libspdm_get_secured_message_header_size(
+    void *spdm_secured_message_context,
+    const libspdm_secured_message_callbacks_t *spdm_secured_message_callbacks);
+
 /**
  * Encode an application message to a secured message.
  *
@@ -233,7 +249,9 @@ typedef struct {
  * @param  is_requester                  Indicates if it is a requester message.
  * @param  app_message_size               size in bytes of the application message data buffer.
  * @param  app_message                   A pointer to a source buffer to store the application message.
- *                                       It shall point to the scratch buffer in spdm_context.
+ *                                       It shall point to the scratch buffer in spdm_context,
+ *                                       or to secured_message + libspdm_get_secured_message_header_size()
+ *                                       to encode the application message in place.
  *                                       On input, the app_message pointer shall point to a big enough buffer.
  *                                         Before app_message, there is room for spdm_secured_message_cipher_header_t.
  *                                         After (app_message + app_message_size), there is room for random bytes.
@@ -0,0 +1,44 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2021-2022 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+#ifndef SPDM_TASK_DISPATCH_H
+#define SPDM_TASK_DISPATCH_H
+
+#include "hal/base.h"
+
+/**
+ * Execute one task that has been submitted through libspdm_dispatch_task_func.
+ *
+ * @param  task_param  A pointer to the task specific parameter.
+ **/
+typedef void (*libspdm_task_func)(void *task_param);
+
+/**
+ * Dispatch a batch of independent tasks, for example to a thread pool.
+ *
+ * The function shall call task_func exactly once for each of the task_count parameters in
+ * task_param_array, where parameter i is located at
+ * (uint8_t *)task_param_array + i * task_param_size. The tasks may be executed concurrently and
+ * in any order. The function shall not return until all tasks have completed.
+ *
+ * @param  dispatch_context  The context that was passed along with the dispatch function.
+ *                           For dispatch functions registered via
+ *                           libspdm_register_dispatch_task_func this is the SPDM context.
+ * @param  task_func         The function that executes one task.
+ * @param  task_param_array  The array of task parameters.
+ * @param  task_param_size   Size in bytes of one task parameter.
+ * @param  task_count        Number of tasks in task_param_array.
+ *
+ * @retval true   All tasks have been executed.
+ * @retval false  The tasks could not be dispatched.
+ **/
+typedef bool (*libspdm_dispatch_task_func)(void *dispatch_context,
+                                           libspdm_task_func task_func,
+                                           void *task_param_array,
+                                           size_t task_param_size,
+                                           size_t task_count);
+
+#endif /* SPDM_TASK_DISPATCH_H */
@@ -9,6 +9,7 @@
 
 #include "library/spdm_common_lib.h"
 #include "library/spdm_crypt_lib.h"
+#include "industry_standard/mctp.h"
 
 #define LIBSPDM_MCTP_ALIGNMENT 1
 #define LIBSPDM_MCTP_SEQUENCE_NUMBER_COUNT 2
@@ -22,11 +23,19 @@
  * | MCTP  |    1   |    4    |   2  | 2 |   2  |   1  |  |  32  | 16|   0    |  60 |
  * +-------+--------+---------------------------+------+--+------+---+--------+-----+
  */
-#define LIBSPDM_MCTP_TRANSPORT_ADDITIONAL_SIZE    (10 + \
-                                                   LIBSPDM_MCTP_SEQUENCE_NUMBER_COUNT + \
-                                                   LIBSPDM_MCTP_MAX_RANDOM_NUMBER_COUNT + \
-                                                   LIBSPDM_MAX_AEAD_TAG_SIZE + \
-                                                   (LIBSPDM_MCTP_ALIGNMENT - 1))
+
+/* Head room in front of the SPDM message: TransHdr + EncryptionHeader + AppHdr.
+ * An SPDM message built at this offset in the sender buffer is encoded in place. */
+#define LIBSPDM_MCTP_TRANSPORT_HEADER_SIZE    (10 + \
+                                               LIBSPDM_MCTP_SEQUENCE_NUMBER_COUNT)
+
+/* Tail room behind the SPDM message: Random + MAC + AlignPad. */
+#define LIBSPDM_MCTP_TRANSPORT_TAIL_SIZE    (LIBSPDM_MCTP_MAX_RANDOM_NUMBER_COUNT + \
+                                             LIBSPDM_MAX_AEAD_TAG_SIZE + \
+                                             (LIBSPDM_MCTP_ALIGNMENT - 1))
+
+#define LIBSPDM_MCTP_TRANSPORT_ADDITIONAL_SIZE    (LIBSPDM_MCTP_TRANSPORT_HEADER_SIZE + \
+                                                   LIBSPDM_MCTP_TRANSPORT_TAIL_SIZE)
 
 /**
  * Encode an SPDM or APP message to a transport layer message.
@@ -48,7 +57,8 @@
  * @param  message_size                  size in bytes of the message data buffer.
  * @param  message                      A pointer to a source buffer to store the message.
  *                                      For normal message, it shall point to the acquired sender buffer.
- *                                      For secured message, it shall point to the scratch buffer in spdm_context.
+ *                                      For secured message, it shall point to the scratch buffer in spdm_context,
+ *                                      or to the transport header size in the sender buffer to be encoded in place.
  * @param  transport_message_size         size in bytes of the transport message data buffer.
  * @param  transport_message             A pointer to a destination buffer to store the transport message.
  *                                      On input, it shall be msg_buf_ptr from sender buffer.
@@ -100,7 +110,8 @@ libspdm_return_t libspdm_transport_mctp_decode_message(
 
 /**
  * Return the maximum transport layer message header size.
- *   Transport Message Header Size + sizeof(spdm_secured_message_cipher_header_t))
+ *   Transport Message Header Size + secured message header + APP message header.
+ *   An SPDM message at this offset in the sender buffer is encoded in place.
  *
  *   For MCTP, Transport Message Header Size = sizeof(mctp_message_header_t)
  *   For PCI_DOE, Transport Message Header Size = sizeof(pci_doe_data_object_header_t)
@@ -150,4 +161,134 @@ uint32_t libspdm_mctp_get_max_random_number_count(void);
 spdm_version_number_t libspdm_mctp_get_secured_spdm_version(
     spdm_version_number_t secured_message_version);
 
+/* One MCTP packet of a message split by libspdm_mctp_packetize_message.
+ * The packet on the bus is the header followed by payload_size bytes at payload.
+ * The payload points into the message, it is not copied. */
+typedef struct {
+    mctp_header_t header;
+    const uint8_t *payload;
+    size_t payload_size;
+} libspdm_mctp_packet_t;
+
+#define LIBSPDM_MCTP_REASSEMBLY_SLOT_FREE 0
+#define LIBSPDM_MCTP_REASSEMBLY_SLOT_ASSEMBLING 1
+#define LIBSPDM_MCTP_REASSEMBLY_SLOT_COMPLETE 2
+
+/* A message being reassembled from the packets of one source EID and message tag. */
+typedef struct {
+    uint8_t *buffer;
+    size_t buffer_size;
+    size_t message_size;
+    /* Payload size of the first packet. Every packet but the last has this size. */
+    size_t packet_payload_size;
+    uint8_t state;
+    uint8_t source_id;
+    /* Message tag and tag owner bits of the packets. */
+    uint8_t message_tag;
+    uint8_t next_sequence_number;
+} libspdm_mctp_reassembly_slot_t;
+
+/* Reassembles the packets of up to slot_count concurrent messages into preallocated slots. */
+typedef struct {
+    size_t transmission_unit;
+    size_t slot_count;
+    libspdm_mctp_reassembly_slot_t *slot;
+} libspdm_mctp_reassembler_t;
+
+/**
+ * Return the number of MCTP packets needed to send a message.
+ *
+ * @param  transmission_unit  The packet payload size.
+ * @param  message_size       The size in bytes of the message, including the MCTP message type.
+ *
+ * @return the number of packets. 0 if transmission_unit or message_size is zero.
+ **/
+size_t libspdm_mctp_get_packet_count(size_t transmission_unit, size_t message_size);
+
+/**
+ * Split an MCTP message into packets of transmission_unit bytes of payload.
+ *
+ * The message is normally the transport message from libspdm_transport_mctp_encode_message,
+ * which starts with the MCTP message type. Every packet but the last has transmission_unit bytes
+ * of payload. The first packet has SOM set, the last has EOM set, and the packet sequence number
+ * starts at 0. The payload of each packet points into the message, so the message shall stay
+ * unchanged until the packets are sent.
+ *
+ * @param  destination_id     The destination EID.
+ * @param  source_id          The source EID.
+ * @param  message_tag        The message tag, optionally with MCTP_MESSAGE_TAG_OWNER.
+ * @param  transmission_unit  The packet payload size. At least MCTP_BASELINE_TRANSMISSION_UNIT.
+ * @param  message_size       The size in bytes of the message.
+ * @param  message            A pointer to the message.
+ * @param  packet_count       On input, the number of entries in packet.
+ *                            On output, the number of packets of the message.
+ * @param  packet             The packets of the message.
+ *
+ * @retval LIBSPDM_STATUS_SUCCESS            The message is split into *packet_count packets.
+ * @retval LIBSPDM_STATUS_INVALID_PARAMETER  A parameter is out of range.
+ * @retval LIBSPDM_STATUS_BUFFER_TOO_SMALL   packet has fewer than *packet_count entries.
+ **/
+libspdm_return_t libspdm_mctp_packetize_message(
+    uint8_t destination_id, uint8_t source_id, uint8_t message_tag,
+    size_t transmission_unit, size_t message_size, const void *message,
+    size_t *packet_count, libspdm_mctp_packet_t *packet);
+
+/**
+ * Initialize a reassembler.
+ *
+ * The buffer is split into slot_count slots of buffer_size / slot_count bytes. Each slot holds
+ * one message, so that is the largest message that can be reassembled.
+ *
+ * @param  reassembler        The reassembler.
+ * @param  transmission_unit  The largest packet payload size that is accepted.
+ *                            At least MCTP_BASELINE_TRANSMISSION_UNIT.
+ * @param  slot               An array of slot_count slots.
+ * @param  slot_count         The number of messages that can be reassembled at the same time.
+ * @param  buffer             The buffer of the slots.
+ * @param  buffer_size        The size in bytes of the buffer.
+ *
+ * @retval LIBSPDM_STATUS_SUCCESS            The reassembler is initialized.
+ * @retval LIBSPDM_STATUS_INVALID_PARAMETER  A slot cannot hold one packet.
+ **/
+libspdm_return_t libspdm_mctp_init_reassembler(
+    libspdm_mctp_reassembler_t *reassembler, size_t transmission_unit,
+    libspdm_mctp_reassembly_slot_t *slot, size_t slot_count,
+    void *buffer, size_t buffer_size);
+
+/**
+ * Add a received MCTP packet to the message of its source EID and message tag.
+ *
+ * A packet with SOM starts a message in a free slot, and drops the partial message with the same
+ * source EID and message tag if there is one. A packet with an unexpected sequence number or size
+ * drops the partial message. When the packet with EOM arrives, the message is returned in its
+ * slot, and the slot is held until libspdm_mctp_release_reassembled_message is called.
+ * The message starts with the MCTP message type and can be passed to
+ * libspdm_transport_mctp_decode_message.
+ *
+ * @param  reassembler   The reassembler.
+ * @param  packet_size   The size in bytes of the packet, including the MCTP header.
+ * @param  packet        A pointer to the packet.
+ * @param  message_size  The size in bytes of the reassembled message, or 0.
+ * @param  message       The reassembled message, or NULL if the message is not complete yet.
+ *
+ * @retval LIBSPDM_STATUS_SUCCESS             The packet is added.
+ * @retval LIBSPDM_STATUS_INVALID_MSG_FIELD   The header version or sequence number is wrong.
+ * @retval LIBSPDM_STATUS_INVALID_MSG_SIZE    The packet payload size is wrong.
+ * @retval LIBSPDM_STATUS_INVALID_STATE_PEER  The packet does not continue a message.
+ * @retval LIBSPDM_STATUS_BUFFER_FULL         No slot is free for a new message.
+ * @retval LIBSPDM_STATUS_BUFFER_TOO_SMALL    The message does not fit in a slot.
+ **/
+libspdm_return_t libspdm_mctp_reassemble_packet(
+    libspdm_mctp_reassembler_t *reassembler, size_t packet_size, const void *packet,
+    size_t *message_size, void **message);
+
+/**
+ * Free the slot of a message returned by libspdm_mctp_reassemble_packet.
+ *
+ * @param  reassembler  The reassembler.
+ * @param  message      The reassembled message.
+ **/
+void libspdm_mctp_release_reassembled_message(libspdm_mctp_reassembler_t *reassembler,
+                                              const void *message);
+
 #endif /* SPDM_MCTP_TRANSPORT_LIB_H */
@@ -22,11 +22,19 @@
  * |PCI_DOE|    8   |    4    |   0  | 2 |   2  |   0  |  |   0  | 16|   3    |  35 |
  * +-------+--------+---------------------------+------+--+------+---+--------+-----+
  */
-#define LIBSPDM_PCI_DOE_TRANSPORT_ADDITIONAL_SIZE    (16 + \
-                                                      LIBSPDM_PCI_DOE_SEQUENCE_NUMBER_COUNT + \
-                                                      LIBSPDM_PCI_DOE_MAX_RANDOM_NUMBER_COUNT + \
-                                                      LIBSPDM_MAX_AEAD_TAG_SIZE + \
-                                                      (LIBSPDM_PCI_DOE_ALIGNMENT - 1))
+
+/* Head room in front of the SPDM message: TransHdr + EncryptionHeader + AppHdr.
+ * An SPDM message built at this offset in the sender buffer is encoded in place. */
+#define LIBSPDM_PCI_DOE_TRANSPORT_HEADER_SIZE    (16 + \
+                                                  LIBSPDM_PCI_DOE_SEQUENCE_NUMBER_COUNT)
+
+/* Tail room behind the SPDM message: Random + MAC + AlignPad. */
+#define LIBSPDM_PCI_DOE_TRANSPORT_TAIL_SIZE    (LIBSPDM_PCI_DOE_MAX_RANDOM_NUMBER_COUNT + \
+                                                LIBSPDM_MAX_AEAD_TAG_SIZE + \
+                                                (LIBSPDM_PCI_DOE_ALIGNMENT - 1))
+
+#define LIBSPDM_PCI_DOE_TRANSPORT_ADDITIONAL_SIZE    (LIBSPDM_PCI_DOE_TRANSPORT_HEADER_SIZE + \
+                                                      LIBSPDM_PCI_DOE_TRANSPORT_TAIL_SIZE)
 
 /**
  * Encode an SPDM or APP message to a transport layer message.
@@ -48,7 +56,8 @@
  * @param  message_size                  size in bytes of the message data buffer.
  * @param  message                      A pointer to a source buffer to store the message.
  *                                      For normal message, it shall point to the acquired sender buffer.
- *                                      For secured message, it shall point to the scratch buffer in spdm_context.
+ *                                      For secured message, it shall point to the scratch buffer in spdm_context,
+ *                                      or to the transport header size in the sender buffer to be encoded in place.
  * @param  transport_message_size         size in bytes of the transport message data buffer.
  * @param  transport_message             A pointer to a destination buffer to store the transport message.
  *                                      On input, it shall be msg_buf_ptr from sender buffer.
@@ -100,7 +109,8 @@ libspdm_return_t libspdm_transport_pci_doe_decode_message(
 
 /**
  * Return the maximum transport layer message header size.
- *   Transport Message Header Size + sizeof(spdm_secured_message_cipher_header_t))
+ *   Transport Message Header Size + secured message header + APP message header.
+ *   An SPDM message at this offset in the sender buffer is encoded in place.
  *
  *   For MCTP, Transport Message Header Size = sizeof(mctp_message_header_t)
  *   For PCI_DOE, Transport Message Header Size = sizeof(pci_doe_data_object_header_t)
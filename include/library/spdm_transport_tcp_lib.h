@@ -0,0 +1,223 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2021-2022 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+#ifndef SPDM_TCP_TRANSPORT_LIB_H
+#define SPDM_TCP_TRANSPORT_LIB_H
+
+#include "library/spdm_common_lib.h"
+#include "library/spdm_crypt_lib.h"
+
+#define LIBSPDM_TCP_ALIGNMENT 1
+#define LIBSPDM_TCP_SEQUENCE_NUMBER_COUNT 0
+#define LIBSPDM_TCP_MAX_RANDOM_NUMBER_COUNT 0
+
+/* Required sender/receive buffer in device io.
+ * +-------+--------+---------------------------+------+--+------+---+--------+-----+
+ * | TYPE  |TransHdr|      EncryptionHeader     |AppHdr|  |Random|MAC|AlignPad|FINAL|
+ * |       |        |SessionId|SeqNum|Len|AppLen|      |  |      |   |        |     |
+ * +-------+--------+---------------------------+------+  +------+---+--------+-----+
+ * |  TCP  |    4   |    4    |   0  | 2 |   2  |   0  |  |   0  | 16|   0    |  28 |
+ * +-------+--------+---------------------------+------+--+------+---+--------+-----+
+ */
+
+/* Head room in front of the SPDM message: TransHdr + EncryptionHeader + AppHdr.
+ * An SPDM message built at this offset in the sender buffer is encoded in place. */
+#define LIBSPDM_TCP_TRANSPORT_HEADER_SIZE    (12 + \
+                                              LIBSPDM_TCP_SEQUENCE_NUMBER_COUNT)
+
+/* Tail room behind the SPDM message: Random + MAC + AlignPad. */
+#define LIBSPDM_TCP_TRANSPORT_TAIL_SIZE    (LIBSPDM_TCP_MAX_RANDOM_NUMBER_COUNT + \
+                                            LIBSPDM_MAX_AEAD_TAG_SIZE + \
+                                            (LIBSPDM_TCP_ALIGNMENT - 1))
+
+#define LIBSPDM_TCP_TRANSPORT_ADDITIONAL_SIZE    (LIBSPDM_TCP_TRANSPORT_HEADER_SIZE + \
+                                                  LIBSPDM_TCP_TRANSPORT_TAIL_SIZE)
+
+/* Receive side of a byte stream carrying SPDM over TCP messages.
+ * Bytes read from the connection are appended to the buffer, and each complete message is
+ * returned in place. A message can arrive in several reads, and one read can hold several
+ * messages, so a peer can send a message before the previous one is consumed. */
+typedef struct {
+    uint8_t *buffer;
+    size_t buffer_size;
+    /* Bytes in [data_offset, data_offset + data_size) are received but not consumed yet. */
+    size_t data_offset;
+    size_t data_size;
+} libspdm_tcp_stream_t;
+
+/**
+ * Encode an SPDM or APP message to a transport layer message.
+ *
+ * For normal SPDM message, it adds the transport layer wrapper.
+ * For secured SPDM message, it encrypts a secured message then adds the transport layer wrapper.
+ * For secured APP message, it encrypts a secured message then adds the transport layer wrapper.
+ *
+ * The APP message is encoded to a secured message directly in SPDM session.
+ * The APP message format is defined by the transport layer.
+ * Take MCTP as example: APP message == MCTP header (MCTP_MESSAGE_TYPE_SPDM) + SPDM message
+ *
+ * @param  spdm_context                  A pointer to the SPDM context.
+ * @param  session_id                    Indicates if it is a secured message protected via SPDM session.
+ *                                     If session_id is NULL, it is a normal message.
+ *                                     If session_id is NOT NULL, it is a secured message.
+ * @param  is_app_message                 Indicates if it is an APP message or SPDM message.
+ * @param  is_requester                  Indicates if it is a requester message.
+ * @param  message_size                  size in bytes of the message data buffer.
+ * @param  message                      A pointer to a source buffer to store the message.
+ *                                      For normal message, it shall point to the acquired sender buffer.
+ *                                      For secured message, it shall point to the scratch buffer in spdm_context,
+ *                                      or to the transport header size in the sender buffer to be encoded in place.
+ * @param  transport_message_size         size in bytes of the transport message data buffer.
+ * @param  transport_message             A pointer to a destination buffer to store the transport message.
+ *                                      On input, it shall be msg_buf_ptr from sender buffer.
+ *                                      On output, it will point to acquired sender buffer.
+ *
+ * @retval RETURN_SUCCESS               The message is encoded successfully.
+ * @retval RETURN_INVALID_PARAMETER     The message is NULL or the message_size is zero.
+ **/
+libspdm_return_t libspdm_transport_tcp_encode_message(
+    void *spdm_context, const uint32_t *session_id, bool is_app_message,
+    bool is_requester, size_t message_size, void *message,
+    size_t *transport_message_size, void **transport_message);
+
+/**
+ * Decode an SPDM or APP message from a transport layer message.
+ *
+ * For normal SPDM message, it removes the transport layer wrapper,
+ * For secured SPDM message, it removes the transport layer wrapper, then decrypts and verifies a secured message.
+ * For secured APP message, it removes the transport layer wrapper, then decrypts and verifies a secured message.
+ *
+ * The APP message is decoded from a secured message directly in SPDM session.
+ * The APP message format is defined by the transport layer.
+ * Take MCTP as example: APP message == MCTP header (MCTP_MESSAGE_TYPE_SPDM) + SPDM message
+ *
+ * @param  spdm_context                  A pointer to the SPDM context.
+ * @param  session_id                    Indicates if it is a secured message protected via SPDM session.
+ *                                     If *session_id is NULL, it is a normal message.
+ *                                     If *session_id is NOT NULL, it is a secured message.
+ * @param  is_app_message                 Indicates if it is an APP message or SPDM message.
+ * @param  is_requester                  Indicates if it is a requester message.
+ * @param  transport_message_size         size in bytes of the transport message data buffer.
+ * @param  transport_message             A pointer to a source buffer to store the transport message.
+ *                                      For normal message or secured message, it shall point to acquired receiver buffer.
+ * @param  message_size                  size in bytes of the message data buffer.
+ * @param  message                      A pointer to a destination buffer to store the message.
+ *                                      On input, it shall point to the scratch buffer in spdm_context.
+ *                                      On output, for normal message, it will point to the original receiver buffer.
+ *                                      On output, for secured message, it will point to the scratch buffer in spdm_context.
+ *
+ * @retval RETURN_SUCCESS               The message is decoded successfully.
+ * @retval RETURN_INVALID_PARAMETER     The message is NULL or the message_size is zero.
+ * @retval RETURN_UNSUPPORTED           The transport_message is unsupported.
+ **/
+libspdm_return_t libspdm_transport_tcp_decode_message(
+    void *spdm_context, uint32_t **session_id,
+    bool *is_app_message, bool is_requester,
+    size_t transport_message_size, void *transport_message,
+    size_t *message_size, void **message);
+
+/**
+ * Return the maximum transport layer message header size.
+ *   Transport Message Header Size + secured message header + APP message header.
+ *   An SPDM message at this offset in the sender buffer is encoded in place.
+ *
+ *   For TCP, Transport Message Header Size = sizeof(spdm_tcp_binding_header_t)
+ *
+ * @param  spdm_context                  A pointer to the SPDM context.
+ *
+ * @return size of maximum transport layer message header size
+ **/
+uint32_t libspdm_transport_tcp_get_header_size(
+    void *spdm_context);
+
+/**
+ * Get sequence number in an SPDM secure message.
+ *
+ * This value is transport layer specific.
+ * TCP delivers messages in order, so the secured message carries no sequence number.
+ *
+ * @param sequence_number        The current sequence number used to encode or decode message.
+ * @param sequence_number_buffer  A buffer to hold the sequence number output used in the secured message.
+ *                             The size in byte of the output buffer shall be 8.
+ *
+ * @return size in byte of the sequence_number_buffer.
+ *        It shall be no greater than 8.
+ *        0 means no sequence number is required.
+ **/
+uint8_t libspdm_tcp_get_sequence_number(uint64_t sequence_number,
+                                        uint8_t *sequence_number_buffer);
+
+/**
+ * Return max random number count in an SPDM secure message.
+ *
+ * This value is transport layer specific.
+ *
+ * @return Max random number count in an SPDM secured message.
+ *        0 means no random number is required.
+ **/
+uint32_t libspdm_tcp_get_max_random_number_count(void);
+
+/**
+ * This function translates the negotiated secured_message_version to a DSP0277 version.
+ *
+ * @param  secured_message_version  The version specified in binding specification and
+ *                                  negotiated in KEY_EXCHANGE/KEY_EXCHANGE_RSP.
+ *
+ * @return The DSP0277 version specified in binding specification,
+ *         which is bound to secured_message_version.
+ */
+spdm_version_number_t libspdm_tcp_get_secured_spdm_version(
+    spdm_version_number_t secured_message_version);
+
+/**
+ * Initialize the receive side of a stream.
+ *
+ * @param  stream       The stream.
+ * @param  buffer       The buffer of the stream. It shall hold the largest transport message.
+ * @param  buffer_size  The size in bytes of the buffer.
+ **/
+void libspdm_tcp_stream_init(libspdm_tcp_stream_t *stream, void *buffer, size_t buffer_size);
+
+/**
+ * Return the free space of a stream, where the next bytes read from the connection go.
+ *
+ * The bytes that are not consumed yet are first moved to the start of the buffer.
+ * This invalidates the messages returned by libspdm_tcp_stream_get_message.
+ *
+ * @param  stream      The stream.
+ * @param  space_size  The size in bytes of the free space.
+ * @param  space       The free space.
+ **/
+void libspdm_tcp_stream_get_free_space(libspdm_tcp_stream_t *stream,
+                                       size_t *space_size, void **space);
+
+/**
+ * Append bytes read into the free space of a stream.
+ *
+ * @param  stream  The stream.
+ * @param  size    The number of bytes read into the free space.
+ **/
+void libspdm_tcp_stream_append(libspdm_tcp_stream_t *stream, size_t size);
+
+/**
+ * Consume the next complete transport message of a stream.
+ *
+ * The message is returned in place in the stream buffer, with its header, and can be passed to
+ * libspdm_transport_tcp_decode_message. It stays valid until the next
+ * libspdm_tcp_stream_get_free_space.
+ *
+ * @param  stream        The stream.
+ * @param  message_size  The size in bytes of the transport message, or 0.
+ * @param  message       The transport message, or NULL if no complete message is received yet.
+ *
+ * @retval LIBSPDM_STATUS_SUCCESS            The next message, if complete, is returned.
+ * @retval LIBSPDM_STATUS_INVALID_MSG_FIELD  The binding version of the next message is wrong.
+ * @retval LIBSPDM_STATUS_BUFFER_TOO_SMALL   The next message does not fit in the stream buffer.
+ **/
+libspdm_return_t libspdm_tcp_stream_get_message(libspdm_tcp_stream_t *stream,
+                                                size_t *message_size, void **message);
+
+#endif /* SPDM_TCP_TRANSPORT_LIB_H */
@@ -422,6 +422,13 @@ libspdm_return_t libspdm_set_data(void *spdm_context, libspdm_data_type_t data_t
             return LIBSPDM_STATUS_BUFFER_FULL;
         }
         context->connection_info.peer_used_cert_chain_slot_id = slot_id;
+        libspdm_free_peer_leaf_cert_public_key(context, slot_id);
+#if LIBSPDM_MEASUREMENT_CACHE_SUPPORT
+        /* The kept measurements were signed with the replaced certificate chain. */
+        if (context->connection_info.measurement_cache.slot_id == slot_id) {
+            context->connection_info.measurement_cache.valid = false;
+        }
+#endif /* LIBSPDM_MEASUREMENT_CACHE_SUPPORT */
 #if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
         context->connection_info.peer_used_cert_chain[slot_id].buffer_size = data_size;
         libspdm_copy_mem(context->connection_info.peer_used_cert_chain[slot_id].buffer,
@@ -439,6 +446,13 @@ libspdm_return_t libspdm_set_data(void *spdm_context, libspdm_data_type_t data_t
 
         context->connection_info.peer_used_cert_chain[slot_id].buffer_hash_size =
             libspdm_get_hash_size(context->connection_info.algorithm.base_hash_algo);
+#if LIBSPDM_CONNECTION_SNAPSHOT_SUPPORT
+        context->connection_info.peer_used_cert_chain_buffer_slot_id = slot_id;
+        context->connection_info.peer_used_cert_chain_buffer_size = data_size;
+        libspdm_copy_mem(context->connection_info.peer_used_cert_chain_buffer,
+                         sizeof(context->connection_info.peer_used_cert_chain_buffer),
+                         data, data_size);
+#endif /* LIBSPDM_CONNECTION_SNAPSHOT_SUPPORT */
 
         /*process the SPDM cert header and hash*/
         data = (uint8_t *)data + sizeof(spdm_cert_chain_t) +
@@ -590,6 +604,20 @@ libspdm_return_t libspdm_set_data(void *spdm_context, libspdm_data_type_t data_t
         }
         context->retry_delay_time = *(uint64_t *)data;
         break;
+#if LIBSPDM_ADAPTIVE_RETRY_SUPPORT
+    case LIBSPDM_DATA_REQUEST_RETRY_MAX_DELAY_TIME:
+        if (data_size != sizeof(uint64_t)) {
+            return LIBSPDM_STATUS_INVALID_PARAMETER;
+        }
+        context->retry_policy.max_delay_time = *(uint64_t *)data;
+        break;
+    case LIBSPDM_DATA_REQUEST_RETRY_DEADLINE:
+        if (data_size != sizeof(uint64_t)) {
+            return LIBSPDM_STATUS_INVALID_PARAMETER;
+        }
+        context->retry_policy.deadline = *(uint64_t *)data;
+        break;
+#endif /* LIBSPDM_ADAPTIVE_RETRY_SUPPORT */
     case LIBSPDM_DATA_MAX_DHE_SESSION_COUNT:
         if (data_size != sizeof(uint32_t)) {
             return LIBSPDM_STATUS_INVALID_PARAMETER;
@@ -848,6 +876,35 @@ libspdm_return_t libspdm_get_data(void *spdm_context, libspdm_data_type_t data_t
         target_data_size = context->transcript.message_a.buffer_size;
         target_data = context->transcript.message_a.buffer;
         break;
+#if LIBSPDM_ADAPTIVE_RETRY_SUPPORT
+    case LIBSPDM_DATA_REQUEST_RETRY_MAX_DELAY_TIME:
+        target_data_size = sizeof(uint64_t);
+        target_data = &context->retry_policy.max_delay_time;
+        break;
+    case LIBSPDM_DATA_REQUEST_RETRY_DEADLINE:
+        target_data_size = sizeof(uint64_t);
+        target_data = &context->retry_policy.deadline;
+        break;
+#endif /* LIBSPDM_ADAPTIVE_RETRY_SUPPORT */
+#if LIBSPDM_STATISTICS_SUPPORT
+    case LIBSPDM_DATA_STATISTICS:
+        if (parameter->location == LIBSPDM_DATA_LOCATION_SESSION) {
+            session_id = *(const uint32_t *)parameter->additional_data;
+            session_info = libspdm_get_session_info_via_session_id(context, session_id);
+            if (session_info == NULL) {
+                return LIBSPDM_STATUS_INVALID_PARAMETER;
+            }
+        }
+        if (*data_size < sizeof(libspdm_statistics_t)) {
+            *data_size = sizeof(libspdm_statistics_t);
+            return LIBSPDM_STATUS_BUFFER_TOO_SMALL;
+        }
+        /* The block is assembled from the context, the sessions and their secured message
+         * contexts, so it is built in the caller buffer. */
+        libspdm_statistics_get(context, session_info, data);
+        *data_size = sizeof(libspdm_statistics_t);
+        return LIBSPDM_STATUS_SUCCESS;
+#endif /* LIBSPDM_STATISTICS_SUPPORT */
     default:
         return LIBSPDM_STATUS_UNSUPPORTED_CAP;
         break;
@@ -1026,6 +1083,13 @@ void libspdm_reset_message_m(libspdm_context_t *spdm_context, void *session_info
         }
     }
 #endif
+#if LIBSPDM_MEASUREMENT_COLLECTION_EX_SUPPORT
+    if (spdm_session_info == NULL) {
+        spdm_context->transcript.measurement_transcript_state = 0;
+    } else {
+        spdm_session_info->session_transcript.measurement_transcript_state = 0;
+    }
+#endif /* LIBSPDM_MEASUREMENT_COLLECTION_EX_SUPPORT */
 }
 
 /**
@@ -1206,9 +1270,11 @@ libspdm_return_t libspdm_append_message_b(libspdm_context_t *spdm_context, const
             }
         }
 
+        LIBSPDM_TRACE_BEGIN(spdm_context, LIBSPDM_TRACE_EVENT_HASH_UPDATE, 0, 0, message_size);
         result = libspdm_hash_update (spdm_context->connection_info.algorithm.base_hash_algo,
                                       spdm_context->transcript.digest_context_m1m2, message,
                                       message_size);
+        LIBSPDM_TRACE_END(spdm_context, LIBSPDM_TRACE_EVENT_HASH_UPDATE, 0, 0, 0);
         if (!result) {
             libspdm_hash_free (spdm_context->connection_info.algorithm.base_hash_algo,
                                spdm_context->transcript.digest_context_m1m2);
@@ -1269,9 +1335,11 @@ libspdm_return_t libspdm_append_message_c(libspdm_context_t *spdm_context, const
             }
         }
 
+        LIBSPDM_TRACE_BEGIN(spdm_context, LIBSPDM_TRACE_EVENT_HASH_UPDATE, 0, 0, message_size);
         result = libspdm_hash_update (spdm_context->connection_info.algorithm.base_hash_algo,
                                       spdm_context->transcript.digest_context_m1m2, message,
                                       message_size);
+        LIBSPDM_TRACE_END(spdm_context, LIBSPDM_TRACE_EVENT_HASH_UPDATE, 0, 0, 0);
         if (!result) {
             libspdm_hash_free (spdm_context->connection_info.algorithm.base_hash_algo,
                                spdm_context->transcript.digest_context_m1m2);
@@ -1337,9 +1405,11 @@ libspdm_return_t libspdm_append_message_mut_b(libspdm_context_t *spdm_context, c
             }
         }
 
+        LIBSPDM_TRACE_BEGIN(spdm_context, LIBSPDM_TRACE_EVENT_HASH_UPDATE, 0, 0, message_size);
         result = libspdm_hash_update (spdm_context->connection_info.algorithm.base_hash_algo,
                                       spdm_context->transcript.digest_context_mut_m1m2, message,
                                       message_size);
+        LIBSPDM_TRACE_END(spdm_context, LIBSPDM_TRACE_EVENT_HASH_UPDATE, 0, 0, 0);
         if (!result) {
             libspdm_hash_free (spdm_context->connection_info.algorithm.base_hash_algo,
                                spdm_context->transcript.digest_context_mut_m1m2);
@@ -1405,9 +1475,11 @@ libspdm_return_t libspdm_append_message_mut_c(libspdm_context_t *spdm_context, c
             }
         }
 
+        LIBSPDM_TRACE_BEGIN(spdm_context, LIBSPDM_TRACE_EVENT_HASH_UPDATE, 0, 0, message_size);
         result = libspdm_hash_update (spdm_context->connection_info.algorithm.base_hash_algo,
                                       spdm_context->transcript.digest_context_mut_m1m2, message,
                                       message_size);
+        LIBSPDM_TRACE_END(spdm_context, LIBSPDM_TRACE_EVENT_HASH_UPDATE, 0, 0, 0);
         if (!result) {
             libspdm_hash_free (spdm_context->connection_info.algorithm.base_hash_algo,
                                spdm_context->transcript.digest_context_mut_m1m2);
@@ -1485,9 +1557,11 @@ libspdm_return_t libspdm_append_message_m(libspdm_context_t *spdm_context, void
                     }
                 }
             }
+            LIBSPDM_TRACE_BEGIN(spdm_context, LIBSPDM_TRACE_EVENT_HASH_UPDATE, 0, 0, message_size);
             result = libspdm_hash_update (spdm_context->connection_info.algorithm.base_hash_algo,
                                           spdm_context->transcript.digest_context_l1l2, message,
                                           message_size);
+            LIBSPDM_TRACE_END(spdm_context, LIBSPDM_TRACE_EVENT_HASH_UPDATE, 0, 0, 0);
             if (!result) {
                 libspdm_hash_free (spdm_context->connection_info.algorithm.base_hash_algo,
                                    spdm_context->transcript.digest_context_l1l2);
@@ -1529,9 +1603,13 @@ libspdm_return_t libspdm_append_message_m(libspdm_context_t *spdm_context, void
                     }
                 }
             }
+            LIBSPDM_TRACE_BEGIN(spdm_context, LIBSPDM_TRACE_EVENT_HASH_UPDATE, 0,
+                                spdm_session_info->session_id, message_size);
             result = libspdm_hash_update (spdm_context->connection_info.algorithm.base_hash_algo,
                                           spdm_session_info->session_transcript.digest_context_l1l2,
                                           message, message_size);
+            LIBSPDM_TRACE_END(spdm_context, LIBSPDM_TRACE_EVENT_HASH_UPDATE, 0,
+                              spdm_session_info->session_id, 0);
             if (!result) {
                 libspdm_hash_free (spdm_context->connection_info.algorithm.base_hash_algo,
                                    spdm_session_info->session_transcript.digest_context_l1l2);
@@ -1643,13 +1721,18 @@ libspdm_return_t libspdm_append_message_k(libspdm_context_t *spdm_context,
         /* prepare digest_context_th*/
 
         if (spdm_session_info->session_transcript.digest_context_th == NULL) {
+            /* The transcript hash context lives as long as the session. The hash state may be
+             * allocated by libspdm_hash_init. */
+            LIBSPDM_ALLOC_SCOPE(spdm_context, LIBSPDM_ALLOC_SCOPE_PERSISTENT_BEGIN, 0);
             spdm_session_info->session_transcript.digest_context_th = libspdm_hash_new (
                 spdm_context->connection_info.algorithm.base_hash_algo);
+            result = (spdm_session_info->session_transcript.digest_context_th != NULL) &&
+                     libspdm_hash_init (spdm_context->connection_info.algorithm.base_hash_algo,
+                                        spdm_session_info->session_transcript.digest_context_th);
+            LIBSPDM_ALLOC_SCOPE(spdm_context, LIBSPDM_ALLOC_SCOPE_PERSISTENT_END, 0);
             if (spdm_session_info->session_transcript.digest_context_th == NULL) {
                 return LIBSPDM_STATUS_CRYPTO_ERROR;
             }
-            result = libspdm_hash_init (spdm_context->connection_info.algorithm.base_hash_algo,
-                                        spdm_session_info->session_transcript.digest_context_th);
             if (!result) {
                 libspdm_hash_free (spdm_context->connection_info.algorithm.base_hash_algo,
                                    spdm_session_info->session_transcript.digest_context_th);
@@ -1678,10 +1761,14 @@ libspdm_return_t libspdm_append_message_k(libspdm_context_t *spdm_context,
                 }
             }
         }
+        LIBSPDM_TRACE_BEGIN(spdm_context, LIBSPDM_TRACE_EVENT_HASH_UPDATE, 0,
+                            spdm_session_info->session_id, message_size);
         result = libspdm_hash_update (spdm_context->connection_info.algorithm.base_hash_algo,
                                       spdm_session_info->session_transcript.digest_context_th,
                                       message,
                                       message_size);
+        LIBSPDM_TRACE_END(spdm_context, LIBSPDM_TRACE_EVENT_HASH_UPDATE, 0,
+                          spdm_session_info->session_id, 0);
         if (!result) {
             libspdm_hash_free (spdm_context->connection_info.algorithm.base_hash_algo,
                                spdm_session_info->session_transcript.digest_context_th);
@@ -1802,14 +1889,18 @@ libspdm_return_t libspdm_append_message_f(libspdm_context_t *spdm_context,
              * this backup will be used in reset_message_f.*/
 
             LIBSPDM_ASSERT (spdm_session_info->session_transcript.digest_context_th != NULL);
+            LIBSPDM_ALLOC_SCOPE(spdm_context, LIBSPDM_ALLOC_SCOPE_PERSISTENT_BEGIN, 0);
             spdm_session_info->session_transcript.digest_context_th_backup = libspdm_hash_new (
                 spdm_context->connection_info.algorithm.base_hash_algo);
+            result = (spdm_session_info->session_transcript.digest_context_th_backup != NULL) &&
+                     libspdm_hash_duplicate (
+                spdm_context->connection_info.algorithm.base_hash_algo,
+                spdm_session_info->session_transcript.digest_context_th,
+                spdm_session_info->session_transcript.digest_context_th_backup);
+            LIBSPDM_ALLOC_SCOPE(spdm_context, LIBSPDM_ALLOC_SCOPE_PERSISTENT_END, 0);
             if (spdm_session_info->session_transcript.digest_context_th_backup == NULL) {
                 return LIBSPDM_STATUS_CRYPTO_ERROR;
             }
-            result = libspdm_hash_duplicate (spdm_context->connection_info.algorithm.base_hash_algo,
-                                             spdm_session_info->session_transcript.digest_context_th,
-                                             spdm_session_info->session_transcript.digest_context_th_backup);
             if (!result) {
                 libspdm_hash_free (spdm_context->connection_info.algorithm.base_hash_algo,
                                    spdm_session_info->session_transcript.digest_context_th_backup);
@@ -1836,10 +1927,14 @@ libspdm_return_t libspdm_append_message_f(libspdm_context_t *spdm_context,
                 }
             }
         }
+        LIBSPDM_TRACE_BEGIN(spdm_context, LIBSPDM_TRACE_EVENT_HASH_UPDATE, 0,
+                            spdm_session_info->session_id, message_size);
         result = libspdm_hash_update (spdm_context->connection_info.algorithm.base_hash_algo,
                                       spdm_session_info->session_transcript.digest_context_th,
                                       message,
                                       message_size);
+        LIBSPDM_TRACE_END(spdm_context, LIBSPDM_TRACE_EVENT_HASH_UPDATE, 0,
+                          spdm_session_info->session_id, 0);
         if (!result) {
             libspdm_hash_free (spdm_context->connection_info.algorithm.base_hash_algo,
                                spdm_session_info->session_transcript.digest_context_th);
@@ -1928,8 +2023,8 @@ bool libspdm_is_capabilities_flag_supported(const libspdm_context_t *spdm_contex
  * This function must be called after libspdm_init_context, and before any SPDM communication.
  *
  * @param  spdm_context                  A pointer to the SPDM context.
- * @param  send_message                  The fuction to send an SPDM transport layer message.
- * @param  receive_message               The fuction to receive an SPDM transport layer message.
+ * @param  send_message                  The function to send an SPDM transport layer message.
+ * @param  receive_message               The function to receive an SPDM transport layer message.
  **/
 void libspdm_register_device_io_func(
     void *spdm_context, libspdm_device_send_message_func send_message,
@@ -1980,10 +2075,10 @@ void libspdm_register_device_io_func(
  * @param  spdm_context                  A pointer to the SPDM context.
  * @param  sender_buffer_size            Size in bytes of the sender buffer.
  * @param  receiver_buffer_size          Size in bytes of the receiver buffer.
- * @param  acquire_sender_buffer         The fuction to acquire transport layer sender buffer.
- * @param  release_sender_buffer         The fuction to release transport layer sender buffer.
- * @param  acquire_receiver_buffer       The fuction to acquire transport layer receiver buffer.
- * @param  release_receiver_buffer       The fuction to release transport layer receiver buffer.
+ * @param  acquire_sender_buffer         The function to acquire transport layer sender buffer.
+ * @param  release_sender_buffer         The function to release transport layer sender buffer.
+ * @param  acquire_receiver_buffer       The function to acquire transport layer receiver buffer.
+ * @param  release_receiver_buffer       The function to release transport layer receiver buffer.
  **/
 void libspdm_register_device_buffer_func(
     void *spdm_context,
@@ -2023,9 +2118,9 @@ void libspdm_register_device_buffer_func(
  * This function must be called after libspdm_init_context, and before any SPDM communication.
  *
  * @param  spdm_context                  A pointer to the SPDM context.
- * @param  transport_encode_message       The fuction to encode an SPDM or APP message to a transport layer message.
- * @param  transport_decode_message       The fuction to decode an SPDM or APP message from a transport layer message.
- * @param  transport_get_header_size      The fuction to get the maximum transport layer message header size.
+ * @param  transport_encode_message       The function to encode an SPDM or APP message to a transport layer message.
+ * @param  transport_decode_message       The function to decode an SPDM or APP message from a transport layer message.
+ * @param  transport_get_header_size      The function to get the maximum transport layer message header size.
  **/
 void libspdm_register_transport_layer_func(
     void *spdm_context,
@@ -2072,7 +2167,7 @@ void libspdm_register_transport_layer_func(
  * This function must be called after libspdm_init_context, and before any SPDM communication.
  *
  * @param  context                  A pointer to the SPDM context.
- * @param  verify_spdm_cert_chain   The fuction to verify an SPDM certificate after GET_CERTIFICATE.
+ * @param  verify_spdm_cert_chain   The function to verify an SPDM certificate after GET_CERTIFICATE.
  **/
 void libspdm_register_verify_spdm_cert_chain_func(
     void *spdm_context,
@@ -2084,6 +2179,101 @@ void libspdm_register_verify_spdm_cert_chain_func(
     context->local_context.verify_peer_spdm_cert_chain = verify_spdm_cert_chain;
 }
 
+#if LIBSPDM_PARALLEL_TASK_SUPPORT
+/**
+ * Register a task dispatch function, for example one backed by a thread pool.
+ *
+ * If it is registered, libspdm submits independent cryptographic operations through it, such as
+ * the verification of each issuer/subject pair of the peer certificate chain after
+ * GET_CERTIFICATE. The spdm_context is passed as the dispatch_context of the function.
+ * If it is NOT registered, these operations are executed serially in the calling thread.
+ *
+ * This function must be called after libspdm_init_context, and before any SPDM communication.
+ *
+ * @param  spdm_context   A pointer to the SPDM context.
+ * @param  dispatch_task  The function to dispatch a batch of independent tasks.
+ **/
+void libspdm_register_dispatch_task_func(void *spdm_context,
+                                         libspdm_dispatch_task_func dispatch_task)
+{
+    libspdm_context_t *context;
+
+    context = spdm_context;
+    context->local_context.dispatch_task = dispatch_task;
+}
+#endif /* LIBSPDM_PARALLEL_TASK_SUPPORT */
+
+#if LIBSPDM_TRACE_SUPPORT
+/**
+ * Register a trace function.
+ *
+ * This function must be called after libspdm_init_context, and before any SPDM communication.
+ *
+ * @param  spdm_context  A pointer to the SPDM context.
+ * @param  trace         The function to trace the operations, or NULL to stop tracing.
+ **/
+void libspdm_register_trace_func(void *spdm_context, libspdm_trace_func trace)
+{
+    libspdm_context_t *context;
+    size_t index;
+
+    context = spdm_context;
+    context->local_context.trace = trace;
+    for (index = 0; index < LIBSPDM_MAX_SESSION_COUNT; index++) {
+        libspdm_secured_message_set_trace_func(context->session_info[index].secured_message_context,
+                                               context, trace);
+    }
+}
+
+/**
+ * Return the name of a trace event, such as "aead_encrypt".
+ *
+ * @param  event  The trace event.
+ *
+ * @return The name, or "unknown" if the event is not valid.
+ **/
+const char *libspdm_trace_get_event_name(libspdm_trace_event_t event)
+{
+    static const char *event_name[LIBSPDM_TRACE_EVENT_MAX] = {
+        "request",
+        "transport_encode",
+        "transport_decode",
+        "aead_encrypt",
+        "aead_decrypt",
+        "hash_update",
+        "hash_final",
+        "asym_sign",
+        "asym_verify",
+        "dhe_generate_key",
+        "dhe_compute_key",
+        "cert_chain_verify",
+    };
+
+    if ((size_t)event >= LIBSPDM_TRACE_EVENT_MAX) {
+        return "unknown";
+    }
+    return event_name[event];
+}
+#endif /* LIBSPDM_TRACE_SUPPORT */
+
+#if LIBSPDM_ALLOC_SCOPE_SUPPORT
+/**
+ * Register an allocation scope function.
+ *
+ * This function must be called after libspdm_init_context, and before any SPDM communication.
+ *
+ * @param  spdm_context  A pointer to the SPDM context.
+ * @param  alloc_scope   The function to enter and leave the allocation scopes, or NULL.
+ **/
+void libspdm_register_alloc_scope_func(void *spdm_context, libspdm_alloc_scope_func alloc_scope)
+{
+    libspdm_context_t *context;
+
+    context = spdm_context;
+    context->local_context.alloc_scope = alloc_scope;
+}
+#endif /* LIBSPDM_ALLOC_SCOPE_SUPPORT */
+
 /**
  * Get the size of required scratch buffer.
  *
@@ -2939,10 +3129,21 @@ void libspdm_reset_context(void *spdm_context)
     libspdm_zero_mem(&context->encap_context, sizeof(libspdm_encap_context_t));
     context->connection_info.local_used_cert_chain_buffer_size = 0;
     context->connection_info.local_used_cert_chain_buffer = NULL;
+#if LIBSPDM_MEASUREMENT_CACHE_SUPPORT
+    context->connection_info.measurement_cache.valid = false;
+#endif /* LIBSPDM_MEASUREMENT_CACHE_SUPPORT */
+#if LIBSPDM_MEASUREMENT_COLLECTION_EX_SUPPORT
+    context->transcript.measurement_transcript_state = 0;
+#endif /* LIBSPDM_MEASUREMENT_COLLECTION_EX_SUPPORT */
 #if LIBSPDM_RESPOND_IF_READY_SUPPORT
     context->cache_spdm_request_size = 0;
 #endif
     context->response_state = LIBSPDM_RESPONSE_STATE_NORMAL;
+#if LIBSPDM_RESPONDER_ASYNC_SIGN_SUPPORT
+    /* The sessions are gone, so is any response waiting for a signature. */
+    context->async_sign.submitted = false;
+    context->async_sign.request_code = 0;
+#endif /* LIBSPDM_RESPONDER_ASYNC_SIGN_SUPPORT */
     context->current_token = 0;
     context->last_spdm_request_session_id = INVALID_SESSION_ID;
     context->last_spdm_request_session_id_valid = false;
@@ -2961,6 +3162,34 @@ void libspdm_reset_context(void *spdm_context)
     #endif /* LIBSPDM_ENABLE_MSG_LOG */
 }
 
+/**
+ * Free the cached leaf certificate public key of the peer certificate chain in a slot.
+ *
+ * @param  spdm_context  A pointer to the SPDM context.
+ * @param  slot_id       The slot ID of the peer certificate chain.
+ **/
+void libspdm_free_peer_leaf_cert_public_key(libspdm_context_t *spdm_context, uint8_t slot_id)
+{
+    void *pubkey_context;
+
+    LIBSPDM_ASSERT(slot_id < SPDM_MAX_SLOT_COUNT);
+
+    pubkey_context = spdm_context->connection_info.peer_used_cert_chain[slot_id].
+                     leaf_cert_public_key;
+    if (pubkey_context == NULL) {
+        return;
+    }
+
+    if (spdm_context->local_context.is_requester) {
+        libspdm_asym_free(
+            spdm_context->connection_info.algorithm.base_asym_algo, pubkey_context);
+    } else {
+        libspdm_req_asym_free(
+            spdm_context->connection_info.algorithm.req_base_asym_alg, pubkey_context);
+    }
+    spdm_context->connection_info.peer_used_cert_chain[slot_id].leaf_cert_public_key = NULL;
+}
+
 /**
  * Free the memory of contexts within the SPDM context.
  * These are typically contexts whose memory has been allocated by the cryptography library.
@@ -2974,36 +3203,17 @@ void libspdm_deinit_context(void *spdm_context)
     uint32_t session_id;
     libspdm_context_t *context;
     libspdm_session_info_t *session_info;
-#if !(LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT)
-    void *pubkey_context;
-    bool is_requester;
     uint8_t slot_index;
-#endif
 
     context = spdm_context;
 
-#if !(LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT)
-    is_requester = context->local_context.is_requester;
-
     for (slot_index = 0; slot_index < SPDM_MAX_SLOT_COUNT; slot_index++) {
-        pubkey_context = context->connection_info.peer_used_cert_chain[slot_index].
-                         leaf_cert_public_key;
-
-        if (pubkey_context != NULL) {
-            if (is_requester) {
-                libspdm_asym_free(
-                    context->connection_info.algorithm.base_asym_algo, pubkey_context);
-            } else {
-                libspdm_req_asym_free(
-                    context->connection_info.algorithm.req_base_asym_alg, pubkey_context);
-            }
-
-            pubkey_context = NULL;
-            context->connection_info.peer_used_cert_chain[slot_index].
-            leaf_cert_public_key = NULL;
-        }
+        libspdm_free_peer_leaf_cert_public_key(context, slot_index);
     }
-#endif
+
+#if LIBSPDM_DHE_KEY_POOL_SUPPORT
+    libspdm_dhe_key_pool_flush(context);
+#endif /* LIBSPDM_DHE_KEY_POOL_SUPPORT */
 
     libspdm_reset_message_a(context);
     libspdm_reset_message_b(context);
@@ -3015,6 +3225,11 @@ void libspdm_deinit_context(void *spdm_context)
         libspdm_reset_message_m(context, session_info);
         libspdm_reset_message_k(context, session_info);
         libspdm_reset_message_f(context, session_info);
+#if LIBSPDM_SESSION_PREALLOCATION_SUPPORT
+        if (session_info->secured_message_context != NULL) {
+            libspdm_secured_message_free_aead_context(session_info->secured_message_context);
+        }
+#endif /* LIBSPDM_SESSION_PREALLOCATION_SUPPORT */
     }
 }
 
@@ -19,6 +19,12 @@ void libspdm_session_info_init(libspdm_context_t *spdm_context,
     libspdm_session_type_t session_type;
     uint32_t capabilities_flag;
 
+#if LIBSPDM_STATISTICS_SUPPORT
+    if (session_info->session_id != INVALID_SESSION_ID) {
+        libspdm_statistics_end_session(spdm_context, session_info);
+    }
+#endif /* LIBSPDM_STATISTICS_SUPPORT */
+
     if (session_id != INVALID_SESSION_ID) {
         if (use_psk) {
             LIBSPDM_ASSERT((spdm_context->max_psk_session_count == 0) ||
@@ -79,6 +85,9 @@ void libspdm_session_info_init(libspdm_context_t *spdm_context,
 
     libspdm_zero_mem (&(session_info->last_key_update_request), sizeof(spdm_key_update_request_t));
     libspdm_zero_mem(session_info, offsetof(libspdm_session_info_t, secured_message_context));
+#if LIBSPDM_SESSION_PREALLOCATION_SUPPORT
+    libspdm_secured_message_free_aead_context(session_info->secured_message_context);
+#endif /* LIBSPDM_SESSION_PREALLOCATION_SUPPORT */
     libspdm_secured_message_init_context(session_info->secured_message_context);
     session_info->session_id = session_id;
     session_info->use_psk = use_psk;
@@ -92,6 +101,10 @@ void libspdm_session_info_init(libspdm_context_t *spdm_context,
         spdm_context->connection_info.algorithm.dhe_named_group,
         spdm_context->connection_info.algorithm.aead_cipher_suite,
         spdm_context->connection_info.algorithm.key_schedule);
+#if LIBSPDM_TRACE_SUPPORT
+    libspdm_secured_message_set_trace_func(session_info->secured_message_context, spdm_context,
+                                           spdm_context->local_context.trace);
+#endif /* LIBSPDM_TRACE_SUPPORT */
 #if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
     session_info->session_transcript.message_k.max_buffer_size =
         sizeof(session_info->session_transcript.message_k.buffer);
@@ -119,6 +132,27 @@ void libspdm_session_info_set_psk_hint(libspdm_session_info_t *session_info,
         psk_hint_size);
 }
 
+#if LIBSPDM_SESSION_PREALLOCATION_SUPPORT
+/**
+ * Allocate the AEAD contexts of the data keys of a session, after they are derived by
+ * libspdm_generate_session_data_key.
+ *
+ * @param  spdm_context                  A pointer to the SPDM context.
+ * @param  session_info                  A pointer to a session info.
+ */
+void libspdm_session_info_new_aead_context(libspdm_context_t *spdm_context,
+                                           libspdm_session_info_t *session_info)
+{
+    /* The AEAD contexts live as long as the session. */
+    LIBSPDM_ALLOC_SCOPE(spdm_context, LIBSPDM_ALLOC_SCOPE_PERSISTENT_BEGIN, 0);
+    libspdm_secured_message_new_aead_context(session_info->secured_message_context,
+                                             LIBSPDM_KEY_UPDATE_ACTION_REQUESTER);
+    libspdm_secured_message_new_aead_context(session_info->secured_message_context,
+                                             LIBSPDM_KEY_UPDATE_ACTION_RESPONDER);
+    LIBSPDM_ALLOC_SCOPE(spdm_context, LIBSPDM_ALLOC_SCOPE_PERSISTENT_END, 0);
+}
+#endif /* LIBSPDM_SESSION_PREALLOCATION_SUPPORT */
+
 /**
  * This function gets the session info via session ID.
  *
@@ -272,6 +306,11 @@ void libspdm_free_session_id(libspdm_context_t *spdm_context, uint32_t session_i
     session_info = spdm_context->session_info;
     for (index = 0; index < LIBSPDM_MAX_SESSION_COUNT; index++) {
         if (session_info[index].session_id == session_id) {
+#if LIBSPDM_MEASUREMENT_CACHE_SUPPORT
+            if (spdm_context->connection_info.measurement_cache.session_id == session_id) {
+                spdm_context->connection_info.measurement_cache.valid = false;
+            }
+#endif /* LIBSPDM_MEASUREMENT_CACHE_SUPPORT */
             libspdm_session_info_init(spdm_context,
                                       &session_info[index],
                                       INVALID_SESSION_ID, false);
@@ -0,0 +1,359 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2021-2022 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+#include "internal/libspdm_common_lib.h"
+
+#if LIBSPDM_CONNECTION_SNAPSHOT_SUPPORT
+
+#define LIBSPDM_CONNECTION_SNAPSHOT_SIGNATURE 0x4e534453 /* "SDSN" */
+#define LIBSPDM_CONNECTION_SNAPSHOT_VERSION 1
+
+#pragma pack(1)
+
+/* The snapshot is this header, followed by the peer digests (hash size * SPDM_MAX_SLOT_COUNT),
+ * the VCA transcript (vca_size), the peer certificate chain in use (cert_chain_size), and an HMAC
+ * of all of them with base_hash_algo. */
+typedef struct {
+    uint32_t signature;
+    uint16_t snapshot_version;
+    uint16_t reserved;
+    uint32_t snapshot_size;
+    uint8_t connection_state;
+    uint8_t peer_digest_slot_mask;
+    uint8_t peer_used_cert_chain_slot_id;
+    uint8_t ct_exponent;
+    uint16_t spdm_version;
+    uint16_t secured_message_version;
+    uint32_t capability_flags;
+    uint32_t data_transfer_size;
+    uint32_t max_spdm_msg_size;
+    uint8_t measurement_spec;
+    uint8_t other_params_support;
+    uint16_t dhe_named_group;
+    uint32_t measurement_hash_algo;
+    uint32_t base_asym_algo;
+    uint32_t base_hash_algo;
+    uint16_t aead_cipher_suite;
+    uint16_t req_base_asym_alg;
+    uint16_t key_schedule;
+    uint16_t vca_size;
+    uint32_t cert_chain_size;
+} libspdm_connection_snapshot_header_t;
+
+#pragma pack()
+
+/**
+ * Get the peer certificate chain in use, or a size of 0 if no certificate chain is in use.
+ *
+ * Without LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT, the context keeps only the last certificate
+ * chain retrieved, so no certificate chain is saved if it was retrieved for another slot.
+ **/
+static void libspdm_snapshot_get_cert_chain(libspdm_context_t *spdm_context,
+                                            const uint8_t **cert_chain,
+                                            size_t *cert_chain_size)
+{
+    *cert_chain = NULL;
+    *cert_chain_size = 0;
+#if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
+    if (spdm_context->connection_info.peer_used_cert_chain_slot_id >= SPDM_MAX_SLOT_COUNT) {
+        return;
+    }
+    *cert_chain = spdm_context->connection_info.peer_used_cert_chain[
+        spdm_context->connection_info.peer_used_cert_chain_slot_id].buffer;
+    *cert_chain_size = spdm_context->connection_info.peer_used_cert_chain[
+        spdm_context->connection_info.peer_used_cert_chain_slot_id].buffer_size;
+#else
+    if (spdm_context->connection_info.peer_used_cert_chain_slot_id !=
+        spdm_context->connection_info.peer_used_cert_chain_buffer_slot_id) {
+        return;
+    }
+    *cert_chain = spdm_context->connection_info.peer_used_cert_chain_buffer;
+    *cert_chain_size = spdm_context->connection_info.peer_used_cert_chain_buffer_size;
+#endif
+}
+
+/**
+ * Check that a negotiated algorithm is one of the algorithms supported locally.
+ **/
+static bool libspdm_snapshot_algo_supported(uint32_t negotiated_algo, uint32_t local_algo)
+{
+    return (negotiated_algo & ~local_algo) == 0;
+}
+
+libspdm_return_t libspdm_get_connection_snapshot(void *spdm_context,
+                                                 const void *key, size_t key_size,
+                                                 void *snapshot, size_t *snapshot_size)
+{
+    libspdm_context_t *context;
+    libspdm_connection_snapshot_header_t header;
+    const uint8_t *cert_chain;
+    size_t cert_chain_size;
+    size_t digest_size;
+    size_t hash_size;
+    size_t total_size;
+    uint8_t *ptr;
+
+    context = spdm_context;
+    if (context->connection_info.connection_state < LIBSPDM_CONNECTION_STATE_NEGOTIATED) {
+        return LIBSPDM_STATUS_INVALID_STATE_LOCAL;
+    }
+
+    hash_size = libspdm_get_hash_size(context->connection_info.algorithm.base_hash_algo);
+    digest_size = hash_size * SPDM_MAX_SLOT_COUNT;
+    libspdm_snapshot_get_cert_chain(context, &cert_chain, &cert_chain_size);
+
+    total_size = sizeof(header) + digest_size + context->transcript.message_a.buffer_size +
+                 cert_chain_size + hash_size;
+    if (*snapshot_size < total_size) {
+        *snapshot_size = total_size;
+        return LIBSPDM_STATUS_BUFFER_TOO_SMALL;
+    }
+
+    libspdm_zero_mem(&header, sizeof(header));
+    header.signature = LIBSPDM_CONNECTION_SNAPSHOT_SIGNATURE;
+    header.snapshot_version = LIBSPDM_CONNECTION_SNAPSHOT_VERSION;
+    header.snapshot_size = (uint32_t)total_size;
+    header.connection_state = (uint8_t)context->connection_info.connection_state;
+    header.peer_digest_slot_mask = context->connection_info.peer_digest_slot_mask;
+    header.peer_used_cert_chain_slot_id = context->connection_info.peer_used_cert_chain_slot_id;
+    header.ct_exponent = context->connection_info.capability.ct_exponent;
+    header.spdm_version = context->connection_info.version;
+    header.secured_message_version = context->connection_info.secured_message_version;
+    header.capability_flags = context->connection_info.capability.flags;
+    header.data_transfer_size = context->connection_info.capability.data_transfer_size;
+    header.max_spdm_msg_size = context->connection_info.capability.max_spdm_msg_size;
+    header.measurement_spec = context->connection_info.algorithm.measurement_spec;
+    header.other_params_support = context->connection_info.algorithm.other_params_support;
+    header.dhe_named_group = context->connection_info.algorithm.dhe_named_group;
+    header.measurement_hash_algo = context->connection_info.algorithm.measurement_hash_algo;
+    header.base_asym_algo = context->connection_info.algorithm.base_asym_algo;
+    header.base_hash_algo = context->connection_info.algorithm.base_hash_algo;
+    header.aead_cipher_suite = context->connection_info.algorithm.aead_cipher_suite;
+    header.req_base_asym_alg = context->connection_info.algorithm.req_base_asym_alg;
+    header.key_schedule = context->connection_info.algorithm.key_schedule;
+    header.vca_size = (uint16_t)context->transcript.message_a.buffer_size;
+    header.cert_chain_size = (uint32_t)cert_chain_size;
+
+    ptr = snapshot;
+    libspdm_copy_mem(ptr, *snapshot_size, &header, sizeof(header));
+    ptr += sizeof(header);
+    libspdm_copy_mem(ptr, *snapshot_size - (ptr - (uint8_t *)snapshot),
+                     context->connection_info.peer_total_digest_buffer, digest_size);
+    ptr += digest_size;
+    libspdm_copy_mem(ptr, *snapshot_size - (ptr - (uint8_t *)snapshot),
+                     context->transcript.message_a.buffer,
+                     context->transcript.message_a.buffer_size);
+    ptr += context->transcript.message_a.buffer_size;
+    if (cert_chain_size != 0) {
+        libspdm_copy_mem(ptr, *snapshot_size - (ptr - (uint8_t *)snapshot),
+                         cert_chain, cert_chain_size);
+        ptr += cert_chain_size;
+    }
+
+    if (!libspdm_hmac_all(header.base_hash_algo, snapshot, ptr - (uint8_t *)snapshot,
+                          key, key_size, ptr)) {
+        return LIBSPDM_STATUS_CRYPTO_ERROR;
+    }
+
+    *snapshot_size = total_size;
+    return LIBSPDM_STATUS_SUCCESS;
+}
+
+libspdm_return_t libspdm_set_connection_snapshot(void *spdm_context,
+                                                 const void *key, size_t key_size,
+                                                 const void *snapshot, size_t snapshot_size)
+{
+    libspdm_context_t *context;
+    libspdm_connection_snapshot_header_t header;
+    const uint8_t *ptr;
+    const uint8_t *cert_chain;
+    uint8_t hmac[LIBSPDM_MAX_HASH_SIZE];
+    size_t digest_size;
+    size_t hash_size;
+    size_t index;
+    bool version_supported;
+#if !(LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT)
+    uint8_t cert_chain_hash[LIBSPDM_MAX_HASH_SIZE];
+    void *public_key;
+#if LIBSPDM_CERT_PARSE_SUPPORT
+    const uint8_t *leaf_cert;
+    size_t leaf_cert_size;
+    bool result;
+#endif /* LIBSPDM_CERT_PARSE_SUPPORT */
+#endif /* !(LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT) */
+
+    context = spdm_context;
+    if (snapshot_size < sizeof(header)) {
+        return LIBSPDM_STATUS_INVALID_PARAMETER;
+    }
+    libspdm_copy_mem(&header, sizeof(header), snapshot, sizeof(header));
+    if ((header.signature != LIBSPDM_CONNECTION_SNAPSHOT_SIGNATURE) ||
+        (header.snapshot_version != LIBSPDM_CONNECTION_SNAPSHOT_VERSION) ||
+        (header.snapshot_size != snapshot_size) ||
+        (header.connection_state < LIBSPDM_CONNECTION_STATE_NEGOTIATED) ||
+        (header.connection_state >= LIBSPDM_CONNECTION_STATE_MAX)) {
+        return LIBSPDM_STATUS_INVALID_PARAMETER;
+    }
+
+    /* The snapshot must be authentic before any of its content is used. */
+    hash_size = libspdm_get_hash_size(header.base_hash_algo);
+    if ((hash_size == 0) ||
+        !libspdm_snapshot_algo_supported(header.base_hash_algo,
+                                         context->local_context.algorithm.base_hash_algo)) {
+        return LIBSPDM_STATUS_INVALID_PARAMETER;
+    }
+    digest_size = hash_size * SPDM_MAX_SLOT_COUNT;
+    if ((header.vca_size > sizeof(context->transcript.message_a.buffer)) ||
+        (header.cert_chain_size > LIBSPDM_MAX_CERT_CHAIN_SIZE) ||
+        (snapshot_size != sizeof(header) + digest_size + header.vca_size +
+         header.cert_chain_size + hash_size)) {
+        return LIBSPDM_STATUS_INVALID_PARAMETER;
+    }
+    if (!libspdm_hmac_all(header.base_hash_algo, snapshot, snapshot_size - hash_size,
+                          key, key_size, hmac)) {
+        return LIBSPDM_STATUS_CRYPTO_ERROR;
+    }
+    if (!libspdm_consttime_is_mem_equal((const uint8_t *)snapshot + snapshot_size - hash_size,
+                                        hmac, hash_size)) {
+        return LIBSPDM_STATUS_VERIF_FAIL;
+    }
+
+    version_supported = false;
+    for (index = 0; index < context->local_context.version.spdm_version_count; index++) {
+        if ((context->local_context.version.spdm_version[index] >>
+             SPDM_VERSION_NUMBER_SHIFT_BIT) ==
+            (header.spdm_version >> SPDM_VERSION_NUMBER_SHIFT_BIT)) {
+            version_supported = true;
+        }
+    }
+    if (!version_supported ||
+        !libspdm_snapshot_algo_supported(header.measurement_spec,
+                                         context->local_context.algorithm.measurement_spec) ||
+        !libspdm_snapshot_algo_supported(
+            header.other_params_support,
+            context->local_context.algorithm.other_params_support) ||
+        !libspdm_snapshot_algo_supported(
+            header.measurement_hash_algo,
+            context->local_context.algorithm.measurement_hash_algo) ||
+        !libspdm_snapshot_algo_supported(header.base_asym_algo,
+                                         context->local_context.algorithm.base_asym_algo) ||
+        !libspdm_snapshot_algo_supported(header.dhe_named_group,
+                                         context->local_context.algorithm.dhe_named_group) ||
+        !libspdm_snapshot_algo_supported(header.aead_cipher_suite,
+                                         context->local_context.algorithm.aead_cipher_suite) ||
+        !libspdm_snapshot_algo_supported(header.req_base_asym_alg,
+                                         context->local_context.algorithm.req_base_asym_alg) ||
+        !libspdm_snapshot_algo_supported(header.key_schedule,
+                                         context->local_context.algorithm.key_schedule)) {
+        return LIBSPDM_STATUS_INVALID_PARAMETER;
+    }
+    if ((header.cert_chain_size != 0) &&
+        (header.peer_used_cert_chain_slot_id >= SPDM_MAX_SLOT_COUNT)) {
+        return LIBSPDM_STATUS_INVALID_PARAMETER;
+    }
+
+    /* Everything that can fail is done before the context is written, so that a snapshot that
+     * cannot be restored leaves the context unchanged. */
+    ptr = (const uint8_t *)snapshot + sizeof(header);
+    cert_chain = ptr + digest_size + header.vca_size;
+#if !(LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT)
+    public_key = NULL;
+    if (header.cert_chain_size != 0) {
+        if (header.cert_chain_size <= sizeof(spdm_cert_chain_t) + hash_size) {
+            return LIBSPDM_STATUS_INVALID_PARAMETER;
+        }
+        if (!libspdm_hash_all(header.base_hash_algo, cert_chain, header.cert_chain_size,
+                              cert_chain_hash)) {
+            return LIBSPDM_STATUS_CRYPTO_ERROR;
+        }
+#if LIBSPDM_CERT_PARSE_SUPPORT
+        /* The leaf public key is parsed again, as the key object of the cryptography library
+         * cannot be saved. */
+        if (!libspdm_x509_get_cert_from_cert_chain(
+                cert_chain + sizeof(spdm_cert_chain_t) + hash_size,
+                header.cert_chain_size - sizeof(spdm_cert_chain_t) - hash_size, -1,
+                &leaf_cert, &leaf_cert_size)) {
+            return LIBSPDM_STATUS_CRYPTO_ERROR;
+        }
+        if (context->local_context.is_requester) {
+            result = libspdm_asym_get_public_key_from_x509(header.base_asym_algo,
+                                                           leaf_cert, leaf_cert_size,
+                                                           &public_key);
+        } else {
+            result = libspdm_req_asym_get_public_key_from_x509(header.req_base_asym_alg,
+                                                               leaf_cert, leaf_cert_size,
+                                                               &public_key);
+        }
+        if (!result) {
+            return LIBSPDM_STATUS_INVALID_CERT;
+        }
+#else
+        LIBSPDM_ASSERT(false);
+#endif /* LIBSPDM_CERT_PARSE_SUPPORT */
+    }
+#endif /* !(LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT) */
+
+    /* The previous key of the slot is freed with the algorithms it was parsed for. */
+    if (header.cert_chain_size != 0) {
+        libspdm_free_peer_leaf_cert_public_key(context, header.peer_used_cert_chain_slot_id);
+    }
+
+    context->connection_info.version = header.spdm_version;
+    context->connection_info.secured_message_version = header.secured_message_version;
+    context->connection_info.capability.ct_exponent = header.ct_exponent;
+    context->connection_info.capability.flags = header.capability_flags;
+    context->connection_info.capability.data_transfer_size = header.data_transfer_size;
+    context->connection_info.capability.max_spdm_msg_size = header.max_spdm_msg_size;
+    context->connection_info.algorithm.measurement_spec = header.measurement_spec;
+    context->connection_info.algorithm.other_params_support = header.other_params_support;
+    context->connection_info.algorithm.measurement_hash_algo = header.measurement_hash_algo;
+    context->connection_info.algorithm.base_asym_algo = header.base_asym_algo;
+    context->connection_info.algorithm.base_hash_algo = header.base_hash_algo;
+    context->connection_info.algorithm.dhe_named_group = header.dhe_named_group;
+    context->connection_info.algorithm.aead_cipher_suite = header.aead_cipher_suite;
+    context->connection_info.algorithm.req_base_asym_alg = header.req_base_asym_alg;
+    context->connection_info.algorithm.key_schedule = header.key_schedule;
+    context->connection_info.peer_digest_slot_mask = header.peer_digest_slot_mask;
+
+    libspdm_copy_mem(context->connection_info.peer_total_digest_buffer,
+                     sizeof(context->connection_info.peer_total_digest_buffer),
+                     ptr, digest_size);
+    ptr += digest_size;
+
+    context->transcript.message_a.buffer_size = header.vca_size;
+    libspdm_copy_mem(context->transcript.message_a.buffer,
+                     sizeof(context->transcript.message_a.buffer),
+                     ptr, header.vca_size);
+
+    if (header.cert_chain_size != 0) {
+        index = header.peer_used_cert_chain_slot_id;
+#if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
+        context->connection_info.peer_used_cert_chain[index].buffer_size =
+            header.cert_chain_size;
+        libspdm_copy_mem(context->connection_info.peer_used_cert_chain[index].buffer,
+                         sizeof(context->connection_info.peer_used_cert_chain[index].buffer),
+                         cert_chain, header.cert_chain_size);
+#else
+        libspdm_copy_mem(context->connection_info.peer_used_cert_chain[index].buffer_hash,
+                         sizeof(context->connection_info.peer_used_cert_chain[index].buffer_hash),
+                         cert_chain_hash, hash_size);
+        context->connection_info.peer_used_cert_chain[index].buffer_hash_size = (uint32_t)hash_size;
+        context->connection_info.peer_used_cert_chain[index].leaf_cert_public_key = public_key;
+        context->connection_info.peer_used_cert_chain_buffer_slot_id = (uint8_t)index;
+        context->connection_info.peer_used_cert_chain_buffer_size = header.cert_chain_size;
+        libspdm_copy_mem(context->connection_info.peer_used_cert_chain_buffer,
+                         sizeof(context->connection_info.peer_used_cert_chain_buffer),
+                         cert_chain, header.cert_chain_size);
+#endif /* LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT */
+    }
+    context->connection_info.peer_used_cert_chain_slot_id = header.peer_used_cert_chain_slot_id;
+
+    context->connection_info.connection_state = header.connection_state;
+
+    return LIBSPDM_STATUS_SUCCESS;
+}
+
+#endif /* LIBSPDM_CONNECTION_SNAPSHOT_SUPPORT */
@@ -182,83 +182,102 @@ bool libspdm_get_local_public_key_buffer(void *spdm_context,
 
 #if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
 /*
- * This function calculates l1l2.
+ * This function hashes the concatenation of transcript managed buffers.
+ *
+ * The buffers are streamed into one hash context, so the concatenation is never built.
+ *
+ * @param  spdm_context                  A pointer to the SPDM context.
+ * @param  managed_buffer_count          The number of managed buffers.
+ * @param  managed_buffer                The managed buffers, in transcript order.
+ * @param  hash                          The buffer to store the hash.
+ *
+ * @retval true  the hash is calculated.
+ * @retval false the hash cannot be calculated.
+ */
+static bool libspdm_hash_managed_buffers(libspdm_context_t *spdm_context,
+                                         size_t managed_buffer_count,
+                                         void *const *managed_buffer, uint8_t *hash)
+{
+    uint32_t base_hash_algo;
+    void *hash_context;
+    size_t index;
+    bool result;
+
+    base_hash_algo = spdm_context->connection_info.algorithm.base_hash_algo;
+
+    hash_context = libspdm_hash_new(base_hash_algo);
+    if (hash_context == NULL) {
+        return false;
+    }
+    result = libspdm_hash_init(base_hash_algo, hash_context);
+    for (index = 0; result && (index < managed_buffer_count); index++) {
+        LIBSPDM_INTERNAL_DUMP_HEX(libspdm_get_managed_buffer(managed_buffer[index]),
+                                  libspdm_get_managed_buffer_size(managed_buffer[index]));
+        result = libspdm_hash_update(base_hash_algo, hash_context,
+                                     libspdm_get_managed_buffer(managed_buffer[index]),
+                                     libspdm_get_managed_buffer_size(managed_buffer[index]));
+    }
+    if (result) {
+        LIBSPDM_TRACE_BEGIN(spdm_context, LIBSPDM_TRACE_EVENT_HASH_FINAL, 0, 0, 0);
+        result = libspdm_hash_final(base_hash_algo, hash_context, hash);
+        LIBSPDM_TRACE_END(spdm_context, LIBSPDM_TRACE_EVENT_HASH_FINAL, 0, 0,
+                          result ? libspdm_get_hash_size(base_hash_algo) : 0);
+    }
+    libspdm_hash_free(base_hash_algo, hash_context);
+    return result;
+}
+
+/*
+ * This function calculates l1l2 hash from the recorded VCA and M messages.
  * If session_info is NULL, this function will use M cache of SPDM context,
  * else will use M cache of SPDM session context.
  *
  * @param  spdm_context                  A pointer to the SPDM context.
  * @param  session_info                  A pointer to the SPDM session context.
- * @param  l1l2                          The buffer to store the l1l2.
+ * @param  l1l2_hash_size               size in bytes of the l1l2 hash
+ * @param  l1l2_hash                   The buffer to store the l1l2 hash
  *
  * @retval RETURN_SUCCESS  l1l2 is calculated.
  */
-bool libspdm_calculate_l1l2(libspdm_context_t *spdm_context,
-                            void *session_info,
-                            libspdm_l1l2_managed_buffer_t *l1l2)
+bool libspdm_calculate_l1l2_hash(libspdm_context_t *spdm_context,
+                                 void *session_info,
+                                 size_t *l1l2_hash_size, void *l1l2_hash)
 {
-    libspdm_return_t status;
     libspdm_session_info_t *spdm_session_info;
+    void *managed_buffer[2];
+    size_t managed_buffer_count;
+    uint32_t hash_size;
 
     spdm_session_info = session_info;
 
-    libspdm_init_managed_buffer(l1l2, sizeof(l1l2->buffer));
+    hash_size = libspdm_get_hash_size(spdm_context->connection_info.algorithm.base_hash_algo);
 
+    managed_buffer_count = 0;
     if ((spdm_context->connection_info.version >> SPDM_VERSION_NUMBER_SHIFT_BIT) >
         SPDM_MESSAGE_VERSION_11) {
 
         /* Need append VCA since 1.2 script*/
 
-        LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "message_a data :\n"));
-        LIBSPDM_INTERNAL_DUMP_HEX(
-            libspdm_get_managed_buffer(&spdm_context->transcript.message_a),
-            libspdm_get_managed_buffer_size(&spdm_context->transcript.message_a));
-        status = libspdm_append_managed_buffer(
-            l1l2,
-            libspdm_get_managed_buffer(&spdm_context->transcript.message_a),
-            libspdm_get_managed_buffer_size(&spdm_context->transcript.message_a));
-        if (LIBSPDM_STATUS_IS_ERROR(status)) {
-            return false;
-        }
+        managed_buffer[managed_buffer_count++] = &spdm_context->transcript.message_a;
     }
-
     if (spdm_session_info == NULL) {
-        LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "message_m data :\n"));
-        LIBSPDM_INTERNAL_DUMP_HEX(
-            libspdm_get_managed_buffer(&spdm_context->transcript.message_m),
-            libspdm_get_managed_buffer_size(&spdm_context->transcript.message_m));
-        status = libspdm_append_managed_buffer(
-            l1l2,
-            libspdm_get_managed_buffer(&spdm_context->transcript.message_m),
-            libspdm_get_managed_buffer_size(&spdm_context->transcript.message_m));
+        managed_buffer[managed_buffer_count++] = &spdm_context->transcript.message_m;
     } else {
         LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "use message_m in session :\n"));
-        LIBSPDM_INTERNAL_DUMP_HEX(
-            libspdm_get_managed_buffer(&spdm_session_info->session_transcript.message_m),
-            libspdm_get_managed_buffer_size(&spdm_session_info->session_transcript.message_m));
-        status = libspdm_append_managed_buffer(
-            l1l2,
-            libspdm_get_managed_buffer(&spdm_session_info->session_transcript.message_m),
-            libspdm_get_managed_buffer_size(&spdm_session_info->session_transcript.message_m));
-    }
-    if (LIBSPDM_STATUS_IS_ERROR(status)) {
-        return false;
+        managed_buffer[managed_buffer_count++] =
+            &spdm_session_info->session_transcript.message_m;
     }
 
-    /* Debug code only - calculate and print value of l1l2 hash*/
-    LIBSPDM_DEBUG_CODE(
-        uint8_t hash_data[LIBSPDM_MAX_HASH_SIZE];
-        uint32_t hash_size = libspdm_get_hash_size(
-            spdm_context->connection_info.algorithm.base_hash_algo);
-        if (!libspdm_hash_all(
-                spdm_context->connection_info.algorithm.base_hash_algo,
-                libspdm_get_managed_buffer(l1l2),
-                libspdm_get_managed_buffer_size(l1l2), hash_data)) {
+    LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "l1l2 data :\n"));
+    if (!libspdm_hash_managed_buffers(spdm_context, managed_buffer_count, managed_buffer,
+                                      l1l2_hash)) {
         return false;
     }
-        LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "l1l2 hash - "));
-        LIBSPDM_INTERNAL_DUMP_DATA(hash_data, hash_size);
-        LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "\n"));
-        );
+    LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "l1l2 hash - "));
+    LIBSPDM_INTERNAL_DUMP_DATA(l1l2_hash, hash_size);
+    LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "\n"));
+
+    *l1l2_hash_size = hash_size;
 
     return true;
 }
@@ -289,13 +308,20 @@ bool libspdm_calculate_l1l2_hash(libspdm_context_t *spdm_context,
     hash_size = libspdm_get_hash_size(spdm_context->connection_info.algorithm.base_hash_algo);
 
     if (spdm_session_info == NULL) {
+        LIBSPDM_TRACE_BEGIN(spdm_context, LIBSPDM_TRACE_EVENT_HASH_FINAL, 0, 0, 0);
         result = libspdm_hash_final (spdm_context->connection_info.algorithm.base_hash_algo,
                                      spdm_context->transcript.digest_context_l1l2, l1l2_hash);
+        LIBSPDM_TRACE_END(spdm_context, LIBSPDM_TRACE_EVENT_HASH_FINAL, 0,
+                          0, result ? hash_size : 0);
     } else {
         LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "use message_m in session :\n"));
+        LIBSPDM_TRACE_BEGIN(spdm_context, LIBSPDM_TRACE_EVENT_HASH_FINAL, 0,
+                            spdm_session_info->session_id, 0);
         result = libspdm_hash_final (spdm_context->connection_info.algorithm.base_hash_algo,
                                      spdm_session_info->session_transcript.digest_context_l1l2,
                                      l1l2_hash);
+        LIBSPDM_TRACE_END(spdm_context, LIBSPDM_TRACE_EVENT_HASH_FINAL, 0,
+                          spdm_session_info->session_id, result ? hash_size : 0);
     }
     if (!result) {
         return false;
@@ -312,133 +338,52 @@ bool libspdm_calculate_l1l2_hash(libspdm_context_t *spdm_context,
 
 #if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
 /*
- * This function calculates m1m2.
+ * This function calculates m1m2 hash from the recorded A, B and C messages.
  *
  * @param  spdm_context                  A pointer to the SPDM context.
  * @param  is_mut                        Indicate if this is from mutual authentication.
- * @param  m1m2                          The buffer to store the m1m2
+ * @param  m1m2_hash_size               size in bytes of the m1m2 hash
+ * @param  m1m2_hash                   The buffer to store the m1m2 hash
  *
  * @retval RETURN_SUCCESS  m1m2 is calculated.
  */
-static bool libspdm_calculate_m1m2(void *context, bool is_mut,
-                                   libspdm_m1m2_managed_buffer_t *m1m2)
+static bool libspdm_calculate_m1m2_hash(void *context, bool is_mut,
+                                        size_t *m1m2_hash_size,
+                                        void *m1m2_hash)
 {
     libspdm_context_t *spdm_context;
-    libspdm_return_t status;
+    void *managed_buffer[3];
+    size_t managed_buffer_count;
+    uint32_t hash_size;
 
     spdm_context = context;
 
-    libspdm_init_managed_buffer(m1m2, sizeof(m1m2->buffer));
+    hash_size = libspdm_get_hash_size(spdm_context->connection_info.algorithm.base_hash_algo);
 
+    managed_buffer_count = 0;
     if (is_mut) {
         if ((spdm_context->connection_info.version >> SPDM_VERSION_NUMBER_SHIFT_BIT) >
             SPDM_MESSAGE_VERSION_11) {
-            LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "message_a data :\n"));
-            LIBSPDM_INTERNAL_DUMP_HEX(
-                libspdm_get_managed_buffer(&spdm_context->transcript.message_a),
-                libspdm_get_managed_buffer_size(&spdm_context->transcript.message_a));
-            status = libspdm_append_managed_buffer(
-                m1m2,
-                libspdm_get_managed_buffer(&spdm_context->transcript.message_a),
-                libspdm_get_managed_buffer_size(&spdm_context->transcript.message_a));
-            if (LIBSPDM_STATUS_IS_ERROR(status)) {
-                return false;
-            }
-        }
-
-        LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "message_mut_b data :\n"));
-        LIBSPDM_INTERNAL_DUMP_HEX(
-            libspdm_get_managed_buffer(&spdm_context->transcript.message_mut_b),
-            libspdm_get_managed_buffer_size(&spdm_context->transcript.message_mut_b));
-        status = libspdm_append_managed_buffer(
-            m1m2,
-            libspdm_get_managed_buffer(&spdm_context->transcript.message_mut_b),
-            libspdm_get_managed_buffer_size(&spdm_context->transcript.message_mut_b));
-        if (LIBSPDM_STATUS_IS_ERROR(status)) {
-            return false;
-        }
-
-        LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "message_mut_c data :\n"));
-        LIBSPDM_INTERNAL_DUMP_HEX(
-            libspdm_get_managed_buffer(&spdm_context->transcript.message_mut_c),
-            libspdm_get_managed_buffer_size(&spdm_context->transcript.message_mut_c));
-        status = libspdm_append_managed_buffer(
-            m1m2,
-            libspdm_get_managed_buffer(&spdm_context->transcript.message_mut_c),
-            libspdm_get_managed_buffer_size(&spdm_context->transcript.message_mut_c));
-        if (LIBSPDM_STATUS_IS_ERROR(status)) {
-            return false;
-        }
-
-        /* Debug code only - calculate and print value of m1m2 mut hash*/
-        LIBSPDM_DEBUG_CODE(
-            uint8_t hash_data[LIBSPDM_MAX_HASH_SIZE];
-            uint32_t hash_size = libspdm_get_hash_size(
-                spdm_context->connection_info.algorithm.base_hash_algo);
-            if (!libspdm_hash_all(
-                    spdm_context->connection_info.algorithm.base_hash_algo,
-                    libspdm_get_managed_buffer(m1m2),
-                    libspdm_get_managed_buffer_size(m1m2), hash_data)) {
-            return false;
+            managed_buffer[managed_buffer_count++] = &spdm_context->transcript.message_a;
         }
-            LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "m1m2 Mut hash - "));
-            LIBSPDM_INTERNAL_DUMP_DATA(hash_data, hash_size);
-            LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "\n"));
-            );
-
+        managed_buffer[managed_buffer_count++] = &spdm_context->transcript.message_mut_b;
+        managed_buffer[managed_buffer_count++] = &spdm_context->transcript.message_mut_c;
     } else {
-        LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "message_a data :\n"));
-        LIBSPDM_INTERNAL_DUMP_HEX(
-            libspdm_get_managed_buffer(&spdm_context->transcript.message_a),
-            libspdm_get_managed_buffer_size(&spdm_context->transcript.message_a));
-        status = libspdm_append_managed_buffer(
-            m1m2,
-            libspdm_get_managed_buffer(&spdm_context->transcript.message_a),
-            libspdm_get_managed_buffer_size(&spdm_context->transcript.message_a));
-        if (LIBSPDM_STATUS_IS_ERROR(status)) {
-            return false;
-        }
-
-        LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "message_b data :\n"));
-        LIBSPDM_INTERNAL_DUMP_HEX(
-            libspdm_get_managed_buffer(&spdm_context->transcript.message_b),
-            libspdm_get_managed_buffer_size(&spdm_context->transcript.message_b));
-        status = libspdm_append_managed_buffer(
-            m1m2,
-            libspdm_get_managed_buffer(&spdm_context->transcript.message_b),
-            libspdm_get_managed_buffer_size(&spdm_context->transcript.message_b));
-        if (LIBSPDM_STATUS_IS_ERROR(status)) {
-            return false;
-        }
-
-        LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "message_c data :\n"));
-        LIBSPDM_INTERNAL_DUMP_HEX(
-            libspdm_get_managed_buffer(&spdm_context->transcript.message_c),
-            libspdm_get_managed_buffer_size(&spdm_context->transcript.message_c));
-        status = libspdm_append_managed_buffer(
-            m1m2,
-            libspdm_get_managed_buffer(&spdm_context->transcript.message_c),
-            libspdm_get_managed_buffer_size(&spdm_context->transcript.message_c));
-        if (LIBSPDM_STATUS_IS_ERROR(status)) {
-            return false;
-        }
+        managed_buffer[managed_buffer_count++] = &spdm_context->transcript.message_a;
+        managed_buffer[managed_buffer_count++] = &spdm_context->transcript.message_b;
+        managed_buffer[managed_buffer_count++] = &spdm_context->transcript.message_c;
+    }
 
-        /* Debug code only - calculate and print value of m1m2 hash*/
-        LIBSPDM_DEBUG_CODE(
-            uint8_t hash_data[LIBSPDM_MAX_HASH_SIZE];
-            uint32_t hash_size = libspdm_get_hash_size(
-                spdm_context->connection_info.algorithm.base_hash_algo);
-            if (!libspdm_hash_all(
-                    spdm_context->connection_info.algorithm.base_hash_algo,
-                    libspdm_get_managed_buffer(m1m2),
-                    libspdm_get_managed_buffer_size(m1m2), hash_data)) {
-            return false;
-        }
-            LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "m1m2 hash - "));
-            LIBSPDM_INTERNAL_DUMP_DATA(hash_data, hash_size);
-            LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "\n"));
-            );
+    LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "m1m2 %sdata :\n", is_mut ? "Mut " : ""));
+    if (!libspdm_hash_managed_buffers(spdm_context, managed_buffer_count, managed_buffer,
+                                      m1m2_hash)) {
+        return false;
     }
+    LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "m1m2 %shash - ", is_mut ? "Mut " : ""));
+    LIBSPDM_INTERNAL_DUMP_DATA(m1m2_hash, hash_size);
+    LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "\n"));
+
+    *m1m2_hash_size = hash_size;
 
     return true;
 }
@@ -466,8 +411,11 @@ static bool libspdm_calculate_m1m2_hash(void *context, bool is_mut,
     hash_size = libspdm_get_hash_size(spdm_context->connection_info.algorithm.base_hash_algo);
 
     if (is_mut) {
+        LIBSPDM_TRACE_BEGIN(spdm_context, LIBSPDM_TRACE_EVENT_HASH_FINAL, 0, 0, 0);
         result = libspdm_hash_final (spdm_context->connection_info.algorithm.base_hash_algo,
                                      spdm_context->transcript.digest_context_mut_m1m2, m1m2_hash);
+        LIBSPDM_TRACE_END(spdm_context, LIBSPDM_TRACE_EVENT_HASH_FINAL, 0,
+                          0, result ? hash_size : 0);
         if (!result) {
             return false;
         }
@@ -476,8 +424,11 @@ static bool libspdm_calculate_m1m2_hash(void *context, bool is_mut,
         LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "\n"));
 
     } else {
+        LIBSPDM_TRACE_BEGIN(spdm_context, LIBSPDM_TRACE_EVENT_HASH_FINAL, 0, 0, 0);
         result = libspdm_hash_final (spdm_context->connection_info.algorithm.base_hash_algo,
                                      spdm_context->transcript.digest_context_m1m2, m1m2_hash);
+        LIBSPDM_TRACE_END(spdm_context, LIBSPDM_TRACE_EVENT_HASH_FINAL, 0,
+                          0, result ? hash_size : 0);
         if (!result) {
             return false;
         }
@@ -603,6 +554,27 @@ bool libspdm_verify_peer_cert_chain_buffer_integrity(libspdm_context_t *spdm_con
         is_device_cert_model = false;
     }
 
+#if LIBSPDM_PARALLEL_TASK_SUPPORT
+    if (spdm_context->local_context.dispatch_task != NULL) {
+        if (is_requester) {
+            result = libspdm_verify_certificate_chain_buffer_parallel(
+                spdm_context->connection_info.algorithm.base_hash_algo,
+                spdm_context->connection_info.algorithm.base_asym_algo,
+                cert_chain_buffer, cert_chain_buffer_size,
+                false, is_device_cert_model,
+                spdm_context->local_context.dispatch_task, spdm_context);
+        } else {
+            result = libspdm_verify_certificate_chain_buffer_parallel(
+                spdm_context->connection_info.algorithm.base_hash_algo,
+                spdm_context->connection_info.algorithm.req_base_asym_alg,
+                cert_chain_buffer, cert_chain_buffer_size,
+                true, is_device_cert_model,
+                spdm_context->local_context.dispatch_task, spdm_context);
+        }
+        return result;
+    }
+#endif /* LIBSPDM_PARALLEL_TASK_SUPPORT */
+
     if (is_requester) {
         result = libspdm_verify_certificate_chain_buffer(
             spdm_context->connection_info.algorithm.base_hash_algo,
@@ -751,11 +723,20 @@ bool libspdm_verify_peer_cert_chain_buffer(libspdm_context_t *spdm_context,
                                            size_t *trust_anchor_size)
 {
     bool result;
+#if LIBSPDM_STATISTICS_SUPPORT
+    uint64_t start_us;
+
+    start_us = libspdm_get_timestamp_us();
+#endif /* LIBSPDM_STATISTICS_SUPPORT */
+    LIBSPDM_TRACE_BEGIN(spdm_context, LIBSPDM_TRACE_EVENT_CERT_CHAIN_VERIFY, SPDM_GET_CERTIFICATE,
+                        0, cert_chain_buffer_size);
 
     /*verify peer cert chain integrity*/
     result = libspdm_verify_peer_cert_chain_buffer_integrity(spdm_context, cert_chain_buffer,
                                                              cert_chain_buffer_size);
     if (!result) {
+        LIBSPDM_TRACE_END(spdm_context, LIBSPDM_TRACE_EVENT_CERT_CHAIN_VERIFY,
+                          SPDM_GET_CERTIFICATE, 0, 0);
         return false;
     }
 
@@ -763,6 +744,12 @@ bool libspdm_verify_peer_cert_chain_buffer(libspdm_context_t *spdm_context,
     result = libspdm_verify_peer_cert_chain_buffer_authority(spdm_context, cert_chain_buffer,
                                                              cert_chain_buffer_size, trust_anchor,
                                                              trust_anchor_size);
+#if LIBSPDM_STATISTICS_SUPPORT
+    libspdm_statistics_record_crypto(spdm_context, LIBSPDM_STATISTICS_CRYPTO_CERT_CHAIN_VERIFY,
+                                     start_us);
+#endif /* LIBSPDM_STATISTICS_SUPPORT */
+    LIBSPDM_TRACE_END(spdm_context, LIBSPDM_TRACE_EVENT_CERT_CHAIN_VERIFY, SPDM_GET_CERTIFICATE,
+                      0, 0);
     if (!result) {
         return false;
     }
@@ -771,6 +758,62 @@ bool libspdm_verify_peer_cert_chain_buffer(libspdm_context_t *spdm_context,
 }
 #endif
 
+bool libspdm_responder_data_sign_deferrable(
+    libspdm_context_t *spdm_context, spdm_version_number_t spdm_version,
+    uint8_t op_code, uint32_t base_asym_algo,
+    uint32_t base_hash_algo, bool is_data_hash,
+    const uint8_t *message, size_t message_size,
+    uint8_t *signature, size_t *sig_size)
+{
+#if LIBSPDM_RESPONDER_ASYNC_SIGN_SUPPORT
+    libspdm_responder_data_sign_submit_func submit_func;
+    uint64_t completion_time;
+    uint8_t rd_exponent;
+#endif /* LIBSPDM_RESPONDER_ASYNC_SIGN_SUPPORT */
+    bool result;
+#if LIBSPDM_STATISTICS_SUPPORT
+    uint64_t start_us;
+#endif /* LIBSPDM_STATISTICS_SUPPORT */
+
+#if LIBSPDM_RESPONDER_ASYNC_SIGN_SUPPORT
+    submit_func = (libspdm_responder_data_sign_submit_func)spdm_context->async_sign.submit;
+    /* Only one response can wait for a signature. Sign others synchronously. */
+    if ((submit_func != NULL) && (spdm_context->async_sign.request_code == 0)) {
+        completion_time = 0;
+        if (!submit_func(spdm_context, spdm_version, op_code, base_asym_algo,
+                         base_hash_algo, is_data_hash, message, message_size,
+                         &completion_time)) {
+            return false;
+        }
+
+        /* RDT is 2^RDTExponent microseconds. */
+        rd_exponent = 0;
+        while ((rd_exponent < 63) && (((uint64_t)1 << rd_exponent) < completion_time)) {
+            rd_exponent++;
+        }
+        spdm_context->async_sign.rd_exponent = rd_exponent;
+        spdm_context->async_sign.submitted = true;
+        return true;
+    }
+#endif /* LIBSPDM_RESPONDER_ASYNC_SIGN_SUPPORT */
+
+#if LIBSPDM_STATISTICS_SUPPORT
+    start_us = libspdm_get_timestamp_us();
+#endif /* LIBSPDM_STATISTICS_SUPPORT */
+    /* The request code of each signed response is the response code with bit 7 set. */
+    LIBSPDM_TRACE_BEGIN(spdm_context, LIBSPDM_TRACE_EVENT_ASYM_SIGN, op_code | 0x80, 0,
+                        message_size);
+    result = libspdm_responder_data_sign(spdm_version, op_code, base_asym_algo, base_hash_algo,
+                                         is_data_hash, message, message_size,
+                                         signature, sig_size);
+#if LIBSPDM_STATISTICS_SUPPORT
+    libspdm_statistics_record_crypto(spdm_context, LIBSPDM_STATISTICS_CRYPTO_ASYM_SIGN, start_us);
+#endif /* LIBSPDM_STATISTICS_SUPPORT */
+    LIBSPDM_TRACE_END(spdm_context, LIBSPDM_TRACE_EVENT_ASYM_SIGN, op_code | 0x80, 0,
+                      result ? *sig_size : 0);
+    return result;
+}
+
 /**
  * This function generates the challenge signature based upon m1m2 for authentication.
  *
@@ -787,23 +830,14 @@ bool libspdm_generate_challenge_auth_signature(libspdm_context_t *spdm_context,
 {
     bool result;
     size_t signature_size;
-#if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
-    libspdm_m1m2_managed_buffer_t m1m2;
-    uint8_t *m1m2_buffer;
-    size_t m1m2_buffer_size;
-#else
     uint8_t m1m2_hash[LIBSPDM_MAX_HASH_SIZE];
     size_t m1m2_hash_size;
-#endif
+#if LIBSPDM_STATISTICS_SUPPORT
+    uint64_t start_us;
+#endif /* LIBSPDM_STATISTICS_SUPPORT */
 
-#if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
-    result = libspdm_calculate_m1m2(spdm_context, is_requester, &m1m2);
-    m1m2_buffer = libspdm_get_managed_buffer(&m1m2);
-    m1m2_buffer_size = libspdm_get_managed_buffer_size(&m1m2);
-#else
     m1m2_hash_size = sizeof(m1m2_hash);
     result = libspdm_calculate_m1m2_hash(spdm_context, is_requester, &m1m2_hash_size, &m1m2_hash);
-#endif
     if (is_requester) {
         libspdm_reset_message_mut_b(spdm_context);
         libspdm_reset_message_mut_c(spdm_context);
@@ -819,40 +853,34 @@ bool libspdm_generate_challenge_auth_signature(libspdm_context_t *spdm_context,
 #if LIBSPDM_ENABLE_CAPABILITY_MUT_AUTH_CAP
         signature_size = libspdm_get_req_asym_signature_size(
             spdm_context->connection_info.algorithm.req_base_asym_alg);
-#if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
-        result = libspdm_requester_data_sign(
-            spdm_context->connection_info.version, SPDM_CHALLENGE_AUTH,
-            spdm_context->connection_info.algorithm.req_base_asym_alg,
-            spdm_context->connection_info.algorithm.base_hash_algo,
-            false, m1m2_buffer, m1m2_buffer_size, signature, &signature_size);
-#else
+#if LIBSPDM_STATISTICS_SUPPORT
+        start_us = libspdm_get_timestamp_us();
+#endif /* LIBSPDM_STATISTICS_SUPPORT */
+        LIBSPDM_TRACE_BEGIN(spdm_context, LIBSPDM_TRACE_EVENT_ASYM_SIGN, SPDM_CHALLENGE, 0,
+                            m1m2_hash_size);
         result = libspdm_requester_data_sign(
             spdm_context->connection_info.version, SPDM_CHALLENGE_AUTH,
             spdm_context->connection_info.algorithm.req_base_asym_alg,
             spdm_context->connection_info.algorithm.base_hash_algo,
             true, m1m2_hash, m1m2_hash_size, signature, &signature_size);
-#endif
+#if LIBSPDM_STATISTICS_SUPPORT
+        libspdm_statistics_record_crypto(spdm_context, LIBSPDM_STATISTICS_CRYPTO_ASYM_SIGN,
+                                         start_us);
+#endif /* LIBSPDM_STATISTICS_SUPPORT */
+        LIBSPDM_TRACE_END(spdm_context, LIBSPDM_TRACE_EVENT_ASYM_SIGN, SPDM_CHALLENGE, 0,
+                          result ? signature_size : 0);
 #else /* LIBSPDM_ENABLE_CAPABILITY_MUT_AUTH_CAP */
         result = false;
 #endif /* LIBSPDM_ENABLE_CAPABILITY_MUT_AUTH_CAP */
     } else {
         signature_size = libspdm_get_asym_signature_size(
             spdm_context->connection_info.algorithm.base_asym_algo);
-#if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
-        result = libspdm_responder_data_sign(
-            spdm_context->connection_info.version, SPDM_CHALLENGE_AUTH,
-            spdm_context->connection_info.algorithm.base_asym_algo,
-            spdm_context->connection_info.algorithm.base_hash_algo,
-            false, m1m2_buffer, m1m2_buffer_size, signature,
-            &signature_size);
-#else
-        result = libspdm_responder_data_sign(
-            spdm_context->connection_info.version, SPDM_CHALLENGE_AUTH,
+        result = libspdm_responder_data_sign_deferrable(
+            spdm_context, spdm_context->connection_info.version, SPDM_CHALLENGE_AUTH,
             spdm_context->connection_info.algorithm.base_asym_algo,
             spdm_context->connection_info.algorithm.base_hash_algo,
             true, m1m2_hash, m1m2_hash_size, signature,
             &signature_size);
-#endif
     }
 
     return result;
@@ -978,6 +1006,74 @@ bool libspdm_verify_public_key_hash(libspdm_context_t *spdm_context,
     return true;
 }
 
+/**
+ * Return the leaf certificate public key of the peer certificate chain in a slot.
+ *
+ * The key object cached in peer_used_cert_chain is returned when present. Otherwise the key is
+ * parsed from the recorded certificate chain and the caller must free it after use.
+ *
+ * @param  spdm_context  A pointer to the SPDM context.
+ * @param  is_requester  Indicate if the key verifies a responder (true) or a requester (false) signature.
+ * @param  slot_id       The slot ID of the peer certificate chain.
+ * @param  public_key    On output, the public key object.
+ * @param  need_free     On output, true if the caller owns the returned public key object.
+ *
+ * @retval true   The public key is returned.
+ * @retval false  The public key cannot be found or parsed.
+ **/
+bool libspdm_get_peer_leaf_cert_public_key(libspdm_context_t *spdm_context, bool is_requester,
+                                           uint8_t slot_id, void **public_key, bool *need_free)
+{
+#if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
+    bool result;
+    const uint8_t *cert_buffer;
+    size_t cert_buffer_size;
+    const uint8_t *cert_chain_data;
+    size_t cert_chain_data_size;
+#endif
+
+    LIBSPDM_ASSERT(slot_id < SPDM_MAX_SLOT_COUNT);
+
+    *need_free = false;
+    *public_key = spdm_context->connection_info.peer_used_cert_chain[slot_id].leaf_cert_public_key;
+    if (*public_key != NULL) {
+        return true;
+    }
+
+#if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
+    /* The cert chain was provisioned without being parsed, so parse the key for this use only. */
+    result = libspdm_get_peer_cert_chain_data(
+        spdm_context, (const void **)&cert_chain_data, &cert_chain_data_size);
+    if (!result) {
+        return false;
+    }
+
+    /* Get leaf cert from cert chain*/
+    result = libspdm_x509_get_cert_from_cert_chain(
+        cert_chain_data, cert_chain_data_size, -1, &cert_buffer, &cert_buffer_size);
+    if (!result) {
+        return false;
+    }
+
+    if (is_requester) {
+        result = libspdm_asym_get_public_key_from_x509(
+            spdm_context->connection_info.algorithm.base_asym_algo,
+            cert_buffer, cert_buffer_size, public_key);
+    } else {
+        result = libspdm_req_asym_get_public_key_from_x509(
+            spdm_context->connection_info.algorithm.req_base_asym_alg,
+            cert_buffer, cert_buffer_size, public_key);
+    }
+    if (!result) {
+        return false;
+    }
+    *need_free = true;
+    return true;
+#else
+    return false;
+#endif
+}
+
 /**
  * This function verifies the challenge signature based upon m1m2.
  *
@@ -997,27 +1093,15 @@ bool libspdm_verify_challenge_auth_signature(libspdm_context_t *spdm_context,
     bool result;
     void *context;
     uint8_t slot_id;
-#if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
-    libspdm_m1m2_managed_buffer_t m1m2;
-    uint8_t *m1m2_buffer;
-    size_t m1m2_buffer_size;
-    const uint8_t *cert_buffer;
-    size_t cert_buffer_size;
-    const uint8_t *cert_chain_data;
-    size_t cert_chain_data_size;
-#else
+    bool need_free;
     uint8_t m1m2_hash[LIBSPDM_MAX_HASH_SIZE];
     size_t m1m2_hash_size;
-#endif
+#if LIBSPDM_STATISTICS_SUPPORT
+    uint64_t start_us;
+#endif /* LIBSPDM_STATISTICS_SUPPORT */
 
-#if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
-    result = libspdm_calculate_m1m2(spdm_context, !is_requester, &m1m2);
-    m1m2_buffer = libspdm_get_managed_buffer(&m1m2);
-    m1m2_buffer_size = libspdm_get_managed_buffer_size(&m1m2);
-#else
     m1m2_hash_size = sizeof(m1m2_hash);
     result = libspdm_calculate_m1m2_hash(spdm_context, !is_requester, &m1m2_hash_size, &m1m2_hash);
-#endif
     if (is_requester) {
         libspdm_reset_message_b(spdm_context);
         libspdm_reset_message_c(spdm_context);
@@ -1049,79 +1133,55 @@ bool libspdm_verify_challenge_auth_signature(libspdm_context_t *spdm_context,
         if (!result) {
             return false;
         }
+        need_free = true;
     } else {
-#if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
-        result = libspdm_get_peer_cert_chain_data(
-            spdm_context, (const void **)&cert_chain_data, &cert_chain_data_size);
-        if (!result) {
-            return false;
-        }
-
-        /* Get leaf cert from cert chain*/
-        result = libspdm_x509_get_cert_from_cert_chain(
-            cert_chain_data, cert_chain_data_size, -1, &cert_buffer, &cert_buffer_size);
-        if (!result) {
-            return false;
-        }
-
-        if (is_requester) {
-            result = libspdm_asym_get_public_key_from_x509(
-                spdm_context->connection_info.algorithm.base_asym_algo,
-                cert_buffer, cert_buffer_size, &context);
-        } else {
-            result = libspdm_req_asym_get_public_key_from_x509(
-                spdm_context->connection_info.algorithm.req_base_asym_alg,
-                cert_buffer, cert_buffer_size, &context);
-        }
+        result = libspdm_get_peer_leaf_cert_public_key(spdm_context, is_requester, slot_id,
+                                                       &context, &need_free);
         if (!result) {
             return false;
         }
-#else
-        context = spdm_context->connection_info.peer_used_cert_chain[slot_id].leaf_cert_public_key;
-        LIBSPDM_ASSERT(context != NULL);
-#endif
     }
 
     if (is_requester) {
-#if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
-        result = libspdm_asym_verify(
-            spdm_context->connection_info.version, SPDM_CHALLENGE_AUTH,
-            spdm_context->connection_info.algorithm.base_asym_algo,
-            spdm_context->connection_info.algorithm.base_hash_algo,
-            context, m1m2_buffer, m1m2_buffer_size, sign_data, sign_data_size);
-        libspdm_asym_free(
-            spdm_context->connection_info.algorithm.base_asym_algo, context);
-#else
+#if LIBSPDM_STATISTICS_SUPPORT
+        start_us = libspdm_get_timestamp_us();
+#endif /* LIBSPDM_STATISTICS_SUPPORT */
+        LIBSPDM_TRACE_BEGIN(spdm_context, LIBSPDM_TRACE_EVENT_ASYM_VERIFY, SPDM_CHALLENGE, 0,
+                            sign_data_size);
         result = libspdm_asym_verify_hash(
             spdm_context->connection_info.version, SPDM_CHALLENGE_AUTH,
             spdm_context->connection_info.algorithm.base_asym_algo,
             spdm_context->connection_info.algorithm.base_hash_algo,
             context, m1m2_hash, m1m2_hash_size, sign_data, sign_data_size);
-        if (slot_id == 0xFF) {
+#if LIBSPDM_STATISTICS_SUPPORT
+        libspdm_statistics_record_crypto(spdm_context, LIBSPDM_STATISTICS_CRYPTO_ASYM_VERIFY,
+                                         start_us);
+#endif /* LIBSPDM_STATISTICS_SUPPORT */
+        LIBSPDM_TRACE_END(spdm_context, LIBSPDM_TRACE_EVENT_ASYM_VERIFY, SPDM_CHALLENGE, 0, 0);
+        if (need_free) {
             libspdm_asym_free(
                 spdm_context->connection_info.algorithm.base_asym_algo, context);
         }
-#endif
     } else {
-#if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
-        result = libspdm_req_asym_verify(
-            spdm_context->connection_info.version, SPDM_CHALLENGE_AUTH,
-            spdm_context->connection_info.algorithm.req_base_asym_alg,
-            spdm_context->connection_info.algorithm.base_hash_algo,
-            context, m1m2_buffer, m1m2_buffer_size, sign_data, sign_data_size);
-        libspdm_req_asym_free(
-            spdm_context->connection_info.algorithm.req_base_asym_alg, context);
-#else
+#if LIBSPDM_STATISTICS_SUPPORT
+        start_us = libspdm_get_timestamp_us();
+#endif /* LIBSPDM_STATISTICS_SUPPORT */
+        LIBSPDM_TRACE_BEGIN(spdm_context, LIBSPDM_TRACE_EVENT_ASYM_VERIFY, SPDM_CHALLENGE, 0,
+                            sign_data_size);
         result = libspdm_req_asym_verify_hash(
             spdm_context->connection_info.version, SPDM_CHALLENGE_AUTH,
             spdm_context->connection_info.algorithm.req_base_asym_alg,
             spdm_context->connection_info.algorithm.base_hash_algo,
             context, m1m2_hash, m1m2_hash_size, sign_data, sign_data_size);
-        if (slot_id == 0xFF) {
+#if LIBSPDM_STATISTICS_SUPPORT
+        libspdm_statistics_record_crypto(spdm_context, LIBSPDM_STATISTICS_CRYPTO_ASYM_VERIFY,
+                                         start_us);
+#endif /* LIBSPDM_STATISTICS_SUPPORT */
+        LIBSPDM_TRACE_END(spdm_context, LIBSPDM_TRACE_EVENT_ASYM_VERIFY, SPDM_CHALLENGE, 0, 0);
+        if (need_free) {
             libspdm_req_asym_free(
                 spdm_context->connection_info.algorithm.req_base_asym_alg, context);
         }
-#endif
     }
     if (!result) {
         LIBSPDM_DEBUG((LIBSPDM_DEBUG_ERROR,
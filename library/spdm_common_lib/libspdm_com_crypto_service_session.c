@@ -117,8 +117,12 @@ bool libspdm_calculate_th_hash_for_exchange(
                            digest_context_th);
         return false;
     }
+    LIBSPDM_TRACE_BEGIN(spdm_context, LIBSPDM_TRACE_EVENT_HASH_FINAL, 0,
+                        session_info->session_id, 0);
     result = libspdm_hash_final (spdm_context->connection_info.algorithm.base_hash_algo,
                                  digest_context_th, th_hash_buffer);
+    LIBSPDM_TRACE_END(spdm_context, LIBSPDM_TRACE_EVENT_HASH_FINAL, 0,
+                      session_info->session_id, result ? hash_size : 0);
     libspdm_hash_free (spdm_context->connection_info.algorithm.base_hash_algo, digest_context_th);
     if (!result) {
         return false;
@@ -169,8 +173,12 @@ bool libspdm_calculate_th_hmac_for_exchange_rsp(
         libspdm_hash_free (spdm_context->connection_info.algorithm.base_hash_algo, hash_context_th);
         return false;
     }
+    LIBSPDM_TRACE_BEGIN(spdm_context, LIBSPDM_TRACE_EVENT_HASH_FINAL, 0,
+                        session_info->session_id, 0);
     result = libspdm_hash_final (spdm_context->connection_info.algorithm.base_hash_algo,
                                  hash_context_th, hash_data);
+    LIBSPDM_TRACE_END(spdm_context, LIBSPDM_TRACE_EVENT_HASH_FINAL, 0,
+                      session_info->session_id, result ? hash_size : 0);
     libspdm_hash_free (spdm_context->connection_info.algorithm.base_hash_algo, hash_context_th);
     if (!result) {
         return false;
@@ -333,8 +341,12 @@ bool libspdm_calculate_th_hash_for_finish(libspdm_context_t *spdm_context,
                            digest_context_th);
         return false;
     }
+    LIBSPDM_TRACE_BEGIN(spdm_context, LIBSPDM_TRACE_EVENT_HASH_FINAL, 0,
+                        session_info->session_id, 0);
     result = libspdm_hash_final (spdm_context->connection_info.algorithm.base_hash_algo,
                                  digest_context_th, th_hash_buffer);
+    LIBSPDM_TRACE_END(spdm_context, LIBSPDM_TRACE_EVENT_HASH_FINAL, 0,
+                      session_info->session_id, result ? hash_size : 0);
     libspdm_hash_free (spdm_context->connection_info.algorithm.base_hash_algo, digest_context_th);
     if (!result) {
         return false;
@@ -387,8 +399,12 @@ bool libspdm_calculate_th_hmac_for_finish_rsp(libspdm_context_t *spdm_context,
         libspdm_hash_free (spdm_context->connection_info.algorithm.base_hash_algo, hash_context_th);
         return false;
     }
+    LIBSPDM_TRACE_BEGIN(spdm_context, LIBSPDM_TRACE_EVENT_HASH_FINAL, 0,
+                        session_info->session_id, 0);
     result = libspdm_hash_final (spdm_context->connection_info.algorithm.base_hash_algo,
                                  hash_context_th, hash_data);
+    LIBSPDM_TRACE_END(spdm_context, LIBSPDM_TRACE_EVENT_HASH_FINAL, 0,
+                      session_info->session_id, result ? hash_size : 0);
     libspdm_hash_free (spdm_context->connection_info.algorithm.base_hash_algo, hash_context_th);
     if (!result) {
         return false;
@@ -446,8 +462,12 @@ bool libspdm_calculate_th_hmac_for_finish_req(libspdm_context_t *spdm_context,
         libspdm_hash_free (spdm_context->connection_info.algorithm.base_hash_algo, hash_context_th);
         return false;
     }
+    LIBSPDM_TRACE_BEGIN(spdm_context, LIBSPDM_TRACE_EVENT_HASH_FINAL, 0,
+                        session_info->session_id, 0);
     result = libspdm_hash_final (spdm_context->connection_info.algorithm.base_hash_algo,
                                  hash_context_th, hash_data);
+    LIBSPDM_TRACE_END(spdm_context, LIBSPDM_TRACE_EVENT_HASH_FINAL, 0,
+                      session_info->session_id, result ? hash_size : 0);
     libspdm_hash_free (spdm_context->connection_info.algorithm.base_hash_algo, hash_context_th);
     if (!result) {
         return false;
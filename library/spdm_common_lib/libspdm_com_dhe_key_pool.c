@@ -0,0 +1,159 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2021-2022 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+#include "internal/libspdm_common_lib.h"
+
+#if LIBSPDM_DHE_KEY_POOL_SUPPORT
+
+/**
+ * Check if a pooled key pair can be used for a key exchange.
+ *
+ * SM2 key exchange binds the SPDM version and the role into the DHE context,
+ * so they must match. Other groups only need the same named group.
+ **/
+static bool libspdm_dhe_key_pool_entry_match(const libspdm_dhe_key_pool_entry_t *entry,
+                                             spdm_version_number_t spdm_version,
+                                             uint16_t dhe_named_group, bool is_initiator)
+{
+    if (entry->dhe_named_group != dhe_named_group) {
+        return false;
+    }
+    if (dhe_named_group == SPDM_ALGORITHMS_DHE_NAMED_GROUP_SM2_P256) {
+        if ((entry->spdm_version != spdm_version) || (entry->is_initiator != is_initiator)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Remove the key pair at index from the pool without freeing its DHE context.
+ **/
+static void libspdm_dhe_key_pool_remove(libspdm_context_t *spdm_context, size_t index)
+{
+    size_t last;
+
+    LIBSPDM_ASSERT(index < spdm_context->dhe_key_pool_count);
+
+    last = spdm_context->dhe_key_pool_count - 1;
+    if (index != last) {
+        libspdm_copy_mem(&spdm_context->dhe_key_pool[index],
+                         sizeof(spdm_context->dhe_key_pool[index]),
+                         &spdm_context->dhe_key_pool[last],
+                         sizeof(spdm_context->dhe_key_pool[last]));
+    }
+    libspdm_zero_mem(&spdm_context->dhe_key_pool[last], sizeof(spdm_context->dhe_key_pool[last]));
+    spdm_context->dhe_key_pool_count--;
+}
+
+libspdm_return_t libspdm_dhe_key_pool_fill(void *spdm_context, uint16_t dhe_named_group,
+                                           size_t count)
+{
+    libspdm_context_t *context;
+    libspdm_dhe_key_pool_entry_t *entry;
+    size_t index;
+    size_t group_count;
+    bool is_initiator;
+    void *dhe_context;
+    bool result;
+
+    context = spdm_context;
+    is_initiator = context->local_context.is_requester;
+
+    if (count > LIBSPDM_DHE_KEY_POOL_SIZE) {
+        count = LIBSPDM_DHE_KEY_POOL_SIZE;
+    }
+
+    group_count = 0;
+    for (index = 0; index < context->dhe_key_pool_count; index++) {
+        if (libspdm_dhe_key_pool_entry_match(&context->dhe_key_pool[index],
+                                             context->connection_info.version,
+                                             dhe_named_group, is_initiator)) {
+            group_count++;
+        }
+    }
+
+    while (group_count < count) {
+        if (context->dhe_key_pool_count >= LIBSPDM_DHE_KEY_POOL_SIZE) {
+            return LIBSPDM_STATUS_BUFFER_FULL;
+        }
+
+        dhe_context = libspdm_dhe_new(context->connection_info.version, dhe_named_group,
+                                      is_initiator);
+        if (dhe_context == NULL) {
+            return LIBSPDM_STATUS_CRYPTO_ERROR;
+        }
+
+        entry = &context->dhe_key_pool[context->dhe_key_pool_count];
+        entry->public_key_size = libspdm_get_dhe_pub_key_size(dhe_named_group);
+        result = libspdm_dhe_generate_key(dhe_named_group, dhe_context,
+                                          entry->public_key, &entry->public_key_size);
+        if (!result) {
+            libspdm_dhe_free(dhe_named_group, dhe_context);
+            libspdm_zero_mem(entry, sizeof(*entry));
+            return LIBSPDM_STATUS_CRYPTO_ERROR;
+        }
+        entry->spdm_version = context->connection_info.version;
+        entry->dhe_named_group = dhe_named_group;
+        entry->is_initiator = is_initiator;
+        entry->dhe_context = dhe_context;
+
+        context->dhe_key_pool_count++;
+        group_count++;
+    }
+
+    return LIBSPDM_STATUS_SUCCESS;
+}
+
+void libspdm_dhe_key_pool_flush(void *spdm_context)
+{
+    libspdm_context_t *context;
+    size_t index;
+
+    context = spdm_context;
+
+    for (index = 0; index < context->dhe_key_pool_count; index++) {
+        libspdm_dhe_free(context->dhe_key_pool[index].dhe_named_group,
+                         context->dhe_key_pool[index].dhe_context);
+        libspdm_zero_mem(&context->dhe_key_pool[index], sizeof(context->dhe_key_pool[index]));
+    }
+    context->dhe_key_pool_count = 0;
+}
+
+void *libspdm_dhe_key_pool_take(libspdm_context_t *spdm_context,
+                                spdm_version_number_t spdm_version,
+                                uint16_t dhe_named_group, bool is_initiator,
+                                uint8_t *public_key, size_t *public_key_size)
+{
+    libspdm_dhe_key_pool_entry_t *entry;
+    size_t index;
+    void *dhe_context;
+
+    for (index = 0; index < spdm_context->dhe_key_pool_count; index++) {
+        entry = &spdm_context->dhe_key_pool[index];
+        if (!libspdm_dhe_key_pool_entry_match(entry, spdm_version, dhe_named_group,
+                                              is_initiator)) {
+            continue;
+        }
+        if (*public_key_size < entry->public_key_size) {
+            return NULL;
+        }
+
+        libspdm_copy_mem(public_key, *public_key_size,
+                         entry->public_key, entry->public_key_size);
+        *public_key_size = entry->public_key_size;
+        dhe_context = entry->dhe_context;
+        libspdm_dhe_key_pool_remove(spdm_context, index);
+
+        LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "dhe_key_pool - take key (0x%x), %d left\n",
+                       dhe_named_group, (uint32_t)spdm_context->dhe_key_pool_count));
+        return dhe_context;
+    }
+
+    return NULL;
+}
+
+#endif /* LIBSPDM_DHE_KEY_POOL_SUPPORT */
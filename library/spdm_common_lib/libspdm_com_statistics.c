@@ -0,0 +1,175 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2021-2022 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+#include "internal/libspdm_common_lib.h"
+#include "internal/libspdm_secured_message_lib.h"
+
+#if LIBSPDM_STATISTICS_SUPPORT
+
+size_t libspdm_statistics_get_request_index(uint8_t request_code)
+{
+    if ((request_code >= 0x80) && (request_code <= 0x8F)) {
+        return request_code - 0x80;
+    }
+    if (request_code >= 0xE0) {
+        return request_code - 0xE0 + 0x10;
+    }
+    return LIBSPDM_STATISTICS_REQUEST_CODE_COUNT;
+}
+
+void libspdm_statistics_record_request(libspdm_context_t *spdm_context,
+                                       libspdm_session_info_t *session_info,
+                                       uint8_t request_code, uint64_t start_us)
+{
+    size_t index;
+
+    index = libspdm_statistics_get_request_index(request_code);
+    if (index >= LIBSPDM_STATISTICS_REQUEST_CODE_COUNT) {
+        return;
+    }
+
+    libspdm_statistics_add_latency(&spdm_context->statistics.request[index], start_us);
+    if (session_info != NULL) {
+        libspdm_statistics_add_latency(&session_info->statistics.request[index], start_us);
+    }
+}
+
+/**
+ * Update the message counters of a statistics block.
+ **/
+static void libspdm_statistics_add_message(libspdm_statistics_t *statistics, bool is_received,
+                                           size_t message_size,
+                                           const spdm_message_header_t *spdm_message)
+{
+    if (is_received) {
+        statistics->bytes_in += message_size;
+    } else {
+        statistics->bytes_out += message_size;
+    }
+
+    if ((spdm_message == NULL) || (spdm_message->request_response_code != SPDM_ERROR)) {
+        return;
+    }
+    if (spdm_message->param1 == SPDM_ERROR_CODE_BUSY) {
+        statistics->busy++;
+    } else if (spdm_message->param1 == SPDM_ERROR_CODE_RESPONSE_NOT_READY) {
+        statistics->response_not_ready++;
+    }
+}
+
+void libspdm_statistics_record_message(libspdm_context_t *spdm_context,
+                                       libspdm_session_info_t *session_info,
+                                       bool is_received, size_t message_size,
+                                       const void *message)
+{
+    const spdm_message_header_t *spdm_message;
+
+    spdm_message = NULL;
+    if ((message != NULL) && (message_size >= sizeof(spdm_message_header_t))) {
+        spdm_message = message;
+    }
+
+    libspdm_statistics_add_message(&spdm_context->statistics, is_received, message_size,
+                                   spdm_message);
+    if (session_info != NULL) {
+        libspdm_statistics_add_message(&session_info->statistics, is_received, message_size,
+                                       spdm_message);
+    }
+}
+
+void libspdm_statistics_record_crypto(libspdm_context_t *spdm_context,
+                                      libspdm_statistics_crypto_class_t crypto_class,
+                                      uint64_t start_us)
+{
+    LIBSPDM_ASSERT(crypto_class < LIBSPDM_STATISTICS_CRYPTO_MAX);
+
+    libspdm_statistics_add_latency(&spdm_context->statistics.crypto[crypto_class], start_us);
+}
+
+void libspdm_statistics_record_buffer(libspdm_context_t *spdm_context, uint8_t request_code,
+                                      libspdm_statistics_buffer_t buffer, size_t size)
+{
+    size_t index;
+
+    LIBSPDM_ASSERT(buffer < LIBSPDM_STATISTICS_BUFFER_MAX);
+
+    if (size > spdm_context->statistics.buffer.peak[buffer]) {
+        spdm_context->statistics.buffer.peak[buffer] = (uint32_t)size;
+    }
+    index = libspdm_statistics_get_request_index(request_code);
+    if ((index < LIBSPDM_STATISTICS_REQUEST_CODE_COUNT) &&
+        (size > spdm_context->statistics.request_buffer[index].peak[buffer])) {
+        spdm_context->statistics.request_buffer[index].peak[buffer] = (uint32_t)size;
+    }
+}
+
+/**
+ * Fill the capacity of each buffer and scratch buffer region.
+ **/
+static void libspdm_statistics_get_buffer_capacity(libspdm_context_t *spdm_context,
+                                                   uint32_t *buffer_capacity)
+{
+    buffer_capacity[LIBSPDM_STATISTICS_BUFFER_SENDER] = (uint32_t)spdm_context->sender_buffer_size;
+    buffer_capacity[LIBSPDM_STATISTICS_BUFFER_RECEIVER] =
+        (uint32_t)spdm_context->receiver_buffer_size;
+    buffer_capacity[LIBSPDM_STATISTICS_BUFFER_SCRATCH_SENDER_RECEIVER] =
+        libspdm_get_scratch_buffer_sender_receiver_capacity(spdm_context);
+    buffer_capacity[LIBSPDM_STATISTICS_BUFFER_SCRATCH_LAST_SPDM_REQUEST] =
+        libspdm_get_scratch_buffer_last_spdm_request_capacity(spdm_context);
+#if LIBSPDM_ENABLE_CAPABILITY_CHUNK_CAP
+    buffer_capacity[LIBSPDM_STATISTICS_BUFFER_SCRATCH_SECURE_MESSAGE] =
+        libspdm_get_scratch_buffer_secure_message_capacity(spdm_context);
+    buffer_capacity[LIBSPDM_STATISTICS_BUFFER_SCRATCH_LARGE_MESSAGE] =
+        libspdm_get_scratch_buffer_large_message_capacity(spdm_context);
+    buffer_capacity[LIBSPDM_STATISTICS_BUFFER_SCRATCH_LARGE_SENDER_RECEIVER] =
+        libspdm_get_scratch_buffer_large_sender_receiver_capacity(spdm_context);
+#else
+    buffer_capacity[LIBSPDM_STATISTICS_BUFFER_SCRATCH_SECURE_MESSAGE] =
+        libspdm_get_scratch_buffer_sender_receiver_capacity(spdm_context);
+    buffer_capacity[LIBSPDM_STATISTICS_BUFFER_SCRATCH_LARGE_MESSAGE] = 0;
+    buffer_capacity[LIBSPDM_STATISTICS_BUFFER_SCRATCH_LARGE_SENDER_RECEIVER] = 0;
+#endif /* LIBSPDM_ENABLE_CAPABILITY_CHUNK_CAP */
+#if LIBSPDM_RESPOND_IF_READY_SUPPORT
+    buffer_capacity[LIBSPDM_STATISTICS_BUFFER_SCRATCH_CACHE_SPDM_REQUEST] =
+        libspdm_get_scratch_buffer_cache_spdm_request_capacity(spdm_context);
+#else
+    buffer_capacity[LIBSPDM_STATISTICS_BUFFER_SCRATCH_CACHE_SPDM_REQUEST] = 0;
+#endif /* LIBSPDM_RESPOND_IF_READY_SUPPORT */
+}
+
+void libspdm_statistics_end_session(libspdm_context_t *spdm_context,
+                                    libspdm_session_info_t *session_info)
+{
+    libspdm_secured_message_merge_statistics(session_info->secured_message_context,
+                                             &spdm_context->statistics);
+}
+
+void libspdm_statistics_get(libspdm_context_t *spdm_context,
+                            libspdm_session_info_t *session_info,
+                            libspdm_statistics_t *statistics)
+{
+    size_t index;
+
+    if (session_info != NULL) {
+        libspdm_copy_mem(statistics, sizeof(libspdm_statistics_t),
+                         &session_info->statistics, sizeof(session_info->statistics));
+        libspdm_secured_message_merge_statistics(session_info->secured_message_context,
+                                                 statistics);
+        return;
+    }
+
+    libspdm_copy_mem(statistics, sizeof(libspdm_statistics_t),
+                     &spdm_context->statistics, sizeof(spdm_context->statistics));
+    libspdm_statistics_get_buffer_capacity(spdm_context, statistics->buffer_capacity);
+    for (index = 0; index < LIBSPDM_MAX_SESSION_COUNT; index++) {
+        if (spdm_context->session_info[index].session_id != INVALID_SESSION_ID) {
+            libspdm_secured_message_merge_statistics(
+                spdm_context->session_info[index].secured_message_context, statistics);
+        }
+    }
+}
+
+#endif /* LIBSPDM_STATISTICS_SUPPORT */
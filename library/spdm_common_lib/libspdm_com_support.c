@@ -79,7 +79,9 @@ const char *libspdm_get_code_str(uint8_t request_code)
 
     return "<unknown>";
 }
+#endif /* LIBSPDM_DEBUG_PRINT_ENABLE */
 
+#if LIBSPDM_INTERNAL_DUMP_ENABLE
 void libspdm_internal_dump_hex_str(const uint8_t *data, size_t size)
 {
     size_t index;
@@ -118,7 +120,7 @@ void libspdm_internal_dump_hex(const uint8_t *data, size_t size)
         LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "\n"));
     }
 }
-#endif /* LIBSPDM_DEBUG_PRINT_ENABLE */
+#endif /* LIBSPDM_INTERNAL_DUMP_ENABLE */
 
 /**
  * Reads a 24-bit value from memory that may be unaligned.
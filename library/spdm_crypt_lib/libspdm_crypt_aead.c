@@ -201,3 +201,181 @@ bool libspdm_aead_decryption(const spdm_version_number_t secured_message_version
         return false;
     }
 }
+
+#if LIBSPDM_SESSION_PREALLOCATION_SUPPORT
+void *libspdm_aead_new(uint16_t aead_cipher_suite)
+{
+    switch (aead_cipher_suite) {
+    case SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_128_GCM:
+    case SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_256_GCM:
+#if LIBSPDM_AEAD_GCM_SUPPORT
+#if !LIBSPDM_AEAD_AES_128_GCM_SUPPORT
+        LIBSPDM_ASSERT(aead_cipher_suite != SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_128_GCM);
+#endif
+#if !LIBSPDM_AEAD_AES_256_GCM_SUPPORT
+        LIBSPDM_ASSERT(aead_cipher_suite != SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_256_GCM);
+#endif
+        return libspdm_aead_aes_gcm_new();
+#else
+        LIBSPDM_ASSERT(false);
+        return NULL;
+#endif
+    case SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_CHACHA20_POLY1305:
+#if LIBSPDM_AEAD_CHACHA20_POLY1305_SUPPORT
+        return libspdm_aead_chacha20_poly1305_new();
+#else
+        LIBSPDM_ASSERT(false);
+        return NULL;
+#endif
+    case SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AEAD_SM4_GCM:
+        /* SM4-GCM has no context, the caller falls back to libspdm_aead_encryption. */
+        return NULL;
+    default:
+        LIBSPDM_ASSERT(false);
+        return NULL;
+    }
+}
+
+void libspdm_aead_free(uint16_t aead_cipher_suite, void *aead_ctx)
+{
+    switch (aead_cipher_suite) {
+    case SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_128_GCM:
+    case SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_256_GCM:
+#if LIBSPDM_AEAD_GCM_SUPPORT
+#if !LIBSPDM_AEAD_AES_128_GCM_SUPPORT
+        LIBSPDM_ASSERT(aead_cipher_suite != SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_128_GCM);
+#endif
+#if !LIBSPDM_AEAD_AES_256_GCM_SUPPORT
+        LIBSPDM_ASSERT(aead_cipher_suite != SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_256_GCM);
+#endif
+        libspdm_aead_aes_gcm_free(aead_ctx);
+        break;
+#else
+        LIBSPDM_ASSERT(false);
+        break;
+#endif
+    case SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_CHACHA20_POLY1305:
+#if LIBSPDM_AEAD_CHACHA20_POLY1305_SUPPORT
+        libspdm_aead_chacha20_poly1305_free(aead_ctx);
+        break;
+#else
+        LIBSPDM_ASSERT(false);
+        break;
+#endif
+    default:
+        LIBSPDM_ASSERT(false);
+        break;
+    }
+}
+
+bool libspdm_aead_set_key(uint16_t aead_cipher_suite, void *aead_ctx,
+                          const uint8_t *key, size_t key_size)
+{
+    switch (aead_cipher_suite) {
+    case SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_128_GCM:
+    case SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_256_GCM:
+#if LIBSPDM_AEAD_GCM_SUPPORT
+#if !LIBSPDM_AEAD_AES_128_GCM_SUPPORT
+        LIBSPDM_ASSERT(aead_cipher_suite != SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_128_GCM);
+#endif
+#if !LIBSPDM_AEAD_AES_256_GCM_SUPPORT
+        LIBSPDM_ASSERT(aead_cipher_suite != SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_256_GCM);
+#endif
+        return libspdm_aead_aes_gcm_set_key(aead_ctx, key, key_size);
+#else
+        LIBSPDM_ASSERT(false);
+        return false;
+#endif
+    case SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_CHACHA20_POLY1305:
+#if LIBSPDM_AEAD_CHACHA20_POLY1305_SUPPORT
+        return libspdm_aead_chacha20_poly1305_set_key(aead_ctx, key, key_size);
+#else
+        LIBSPDM_ASSERT(false);
+        return false;
+#endif
+    default:
+        LIBSPDM_ASSERT(false);
+        return false;
+    }
+}
+
+bool libspdm_aead_encryption_with_context(uint16_t aead_cipher_suite, void *aead_ctx,
+                                          const uint8_t *iv, size_t iv_size,
+                                          const uint8_t *a_data, size_t a_data_size,
+                                          const uint8_t *data_in, size_t data_in_size,
+                                          uint8_t *tag_out, size_t tag_size,
+                                          uint8_t *data_out, size_t *data_out_size)
+{
+    switch (aead_cipher_suite) {
+    case SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_128_GCM:
+    case SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_256_GCM:
+#if LIBSPDM_AEAD_GCM_SUPPORT
+#if !LIBSPDM_AEAD_AES_128_GCM_SUPPORT
+        LIBSPDM_ASSERT(aead_cipher_suite != SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_128_GCM);
+#endif
+#if !LIBSPDM_AEAD_AES_256_GCM_SUPPORT
+        LIBSPDM_ASSERT(aead_cipher_suite != SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_256_GCM);
+#endif
+        return libspdm_aead_aes_gcm_encrypt_with_context(aead_ctx, iv, iv_size, a_data,
+                                                         a_data_size, data_in, data_in_size,
+                                                         tag_out, tag_size, data_out,
+                                                         data_out_size);
+#else
+        LIBSPDM_ASSERT(false);
+        return false;
+#endif
+    case SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_CHACHA20_POLY1305:
+#if LIBSPDM_AEAD_CHACHA20_POLY1305_SUPPORT
+        return libspdm_aead_chacha20_poly1305_encrypt_with_context(
+            aead_ctx, iv, iv_size, a_data, a_data_size, data_in, data_in_size, tag_out,
+            tag_size, data_out, data_out_size);
+#else
+        LIBSPDM_ASSERT(false);
+        return false;
+#endif
+    default:
+        LIBSPDM_ASSERT(false);
+        return false;
+    }
+}
+
+bool libspdm_aead_decryption_with_context(uint16_t aead_cipher_suite, void *aead_ctx,
+                                          const uint8_t *iv, size_t iv_size,
+                                          const uint8_t *a_data, size_t a_data_size,
+                                          const uint8_t *data_in, size_t data_in_size,
+                                          const uint8_t *tag, size_t tag_size,
+                                          uint8_t *data_out, size_t *data_out_size)
+{
+    switch (aead_cipher_suite) {
+    case SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_128_GCM:
+    case SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_256_GCM:
+#if LIBSPDM_AEAD_GCM_SUPPORT
+#if !LIBSPDM_AEAD_AES_128_GCM_SUPPORT
+        LIBSPDM_ASSERT(aead_cipher_suite != SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_128_GCM);
+#endif
+#if !LIBSPDM_AEAD_AES_256_GCM_SUPPORT
+        LIBSPDM_ASSERT(aead_cipher_suite != SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_256_GCM);
+#endif
+        return libspdm_aead_aes_gcm_decrypt_with_context(aead_ctx, iv, iv_size, a_data,
+                                                         a_data_size, data_in, data_in_size,
+                                                         tag, tag_size, data_out,
+                                                         data_out_size);
+#else
+        LIBSPDM_ASSERT(false);
+        return false;
+#endif
+    case SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_CHACHA20_POLY1305:
+#if LIBSPDM_AEAD_CHACHA20_POLY1305_SUPPORT
+        return libspdm_aead_chacha20_poly1305_decrypt_with_context(
+            aead_ctx, iv, iv_size, a_data, a_data_size, data_in, data_in_size, tag,
+            tag_size, data_out, data_out_size);
+#else
+        LIBSPDM_ASSERT(false);
+        return false;
+#endif
+    default:
+        LIBSPDM_ASSERT(false);
+        return false;
+    }
+}
+#endif /* LIBSPDM_SESSION_PREALLOCATION_SUPPORT */
@@ -27,6 +27,11 @@
 #define LIBSPDM_MAX_NAME_SIZE 100
 #endif
 
+/*max issuer/subject pairs that are dispatched as one batch of parallel verification tasks*/
+#ifndef LIBSPDM_MAX_CERT_VERIFY_TASK_COUNT
+#define LIBSPDM_MAX_CERT_VERIFY_TASK_COUNT 8
+#endif
+
 /*max public key encryption algo oid len*/
 #ifndef LIBSPDM_MAX_ENCRYPTION_ALGO_OID_LEN
 #define LIBSPDM_MAX_ENCRYPTION_ALGO_OID_LEN 10
@@ -1328,11 +1333,129 @@ bool libspdm_verify_cert_chain_data(uint8_t *cert_chain_data, size_t cert_chain_
     return true;
 }
 
+#if LIBSPDM_PARALLEL_TASK_SUPPORT
+typedef struct {
+    const uint8_t *cert;
+    size_t cert_size;
+    const uint8_t *issuer_cert;
+    size_t issuer_cert_size;
+    bool result;
+} libspdm_cert_verify_task_t;
+
+static void libspdm_cert_verify_task(void *task_param)
+{
+    libspdm_cert_verify_task_t *task;
+
+    task = task_param;
+    task->result = libspdm_x509_verify_cert(task->cert, task->cert_size,
+                                            task->issuer_cert, task->issuer_cert_size);
+}
+
+bool libspdm_verify_cert_chain_parallel(const uint8_t *root_cert, size_t root_cert_length,
+                                        const uint8_t *cert_chain, size_t cert_chain_length,
+                                        libspdm_dispatch_task_func dispatch_task,
+                                        void *dispatch_context)
+{
+    libspdm_cert_verify_task_t task[LIBSPDM_MAX_CERT_VERIFY_TASK_COUNT];
+    size_t task_count;
+    size_t index;
+    const uint8_t *preceding_cert;
+    size_t preceding_cert_len;
+    const uint8_t *current_cert;
+    size_t current_cert_len;
+    const uint8_t *end;
+    uint8_t *ptr;
+    size_t asn1_len;
+    bool end_of_chain;
+    bool verify_flag;
+
+    if (dispatch_task == NULL) {
+        return libspdm_x509_verify_cert_chain(root_cert, root_cert_length,
+                                              cert_chain, cert_chain_length);
+    }
+
+    preceding_cert = root_cert;
+    preceding_cert_len = root_cert_length;
+    current_cert = cert_chain;
+    end = cert_chain + cert_chain_length;
+    end_of_chain = false;
+    verify_flag = false;
+
+    while (!end_of_chain) {
+        /* Collect up to LIBSPDM_MAX_CERT_VERIFY_TASK_COUNT issuer/subject pairs. */
+        task_count = 0;
+        while (task_count < LIBSPDM_MAX_CERT_VERIFY_TASK_COUNT) {
+            ptr = (uint8_t *)(size_t)current_cert;
+            if (!libspdm_asn1_get_tag(&ptr, end, &asn1_len,
+                                      LIBSPDM_CRYPTO_ASN1_SEQUENCE |
+                                      LIBSPDM_CRYPTO_ASN1_CONSTRUCTED)) {
+                end_of_chain = true;
+                break;
+            }
+            current_cert_len = asn1_len + (size_t)(ptr - current_cert);
+            if (current_cert_len > (size_t)(end - current_cert)) {
+                end_of_chain = true;
+                break;
+            }
+
+            task[task_count].cert = current_cert;
+            task[task_count].cert_size = current_cert_len;
+            task[task_count].issuer_cert = preceding_cert;
+            task[task_count].issuer_cert_size = preceding_cert_len;
+            task[task_count].result = false;
+            task_count++;
+
+            preceding_cert = current_cert;
+            preceding_cert_len = current_cert_len;
+            current_cert = current_cert + current_cert_len;
+        }
+
+        if (task_count == 0) {
+            break;
+        }
+
+        if (!dispatch_task(dispatch_context, libspdm_cert_verify_task,
+                           task, sizeof(libspdm_cert_verify_task_t), task_count)) {
+            return false;
+        }
+
+        for (index = 0; index < task_count; index++) {
+            if (!task[index].result) {
+                return false;
+            }
+        }
+        verify_flag = true;
+    }
+
+    return verify_flag;
+}
+
 bool libspdm_verify_certificate_chain_buffer(uint32_t base_hash_algo, uint32_t base_asym_algo,
                                              const void *cert_chain_buffer,
                                              size_t cert_chain_buffer_size,
                                              bool is_requester_cert,
                                              bool is_device_cert_model)
+{
+    return libspdm_verify_certificate_chain_buffer_parallel(
+        base_hash_algo, base_asym_algo, cert_chain_buffer, cert_chain_buffer_size,
+        is_requester_cert, is_device_cert_model, NULL, NULL);
+}
+
+bool libspdm_verify_certificate_chain_buffer_parallel(uint32_t base_hash_algo,
+                                                      uint32_t base_asym_algo,
+                                                      const void *cert_chain_buffer,
+                                                      size_t cert_chain_buffer_size,
+                                                      bool is_requester_cert,
+                                                      bool is_device_cert_model,
+                                                      libspdm_dispatch_task_func dispatch_task,
+                                                      void *dispatch_context)
+#else
+bool libspdm_verify_certificate_chain_buffer(uint32_t base_hash_algo, uint32_t base_asym_algo,
+                                             const void *cert_chain_buffer,
+                                             size_t cert_chain_buffer_size,
+                                             bool is_requester_cert,
+                                             bool is_device_cert_model)
+#endif /* LIBSPDM_PARALLEL_TASK_SUPPORT */
 {
     const uint8_t *cert_chain_data;
     size_t cert_chain_data_size;
@@ -1392,9 +1515,17 @@ bool libspdm_verify_certificate_chain_buffer(uint32_t base_hash_algo, uint32_t b
     /*If the number of certificates in the certificate chain is more than 1,
      * other certificates need to be verified.*/
     if (cert_chain_data_size > first_cert_buffer_size) {
-        if (!libspdm_x509_verify_cert_chain(first_cert_buffer, first_cert_buffer_size,
-                                            cert_chain_data + first_cert_buffer_size,
-                                            cert_chain_data_size - first_cert_buffer_size)) {
+#if LIBSPDM_PARALLEL_TASK_SUPPORT
+        result = libspdm_verify_cert_chain_parallel(first_cert_buffer, first_cert_buffer_size,
+                                                    cert_chain_data + first_cert_buffer_size,
+                                                    cert_chain_data_size - first_cert_buffer_size,
+                                                    dispatch_task, dispatch_context);
+#else
+        result = libspdm_x509_verify_cert_chain(first_cert_buffer, first_cert_buffer_size,
+                                                cert_chain_data + first_cert_buffer_size,
+                                                cert_chain_data_size - first_cert_buffer_size);
+#endif /* LIBSPDM_PARALLEL_TASK_SUPPORT */
+        if (!result) {
             LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO,
                            "!!! VerifyCertificateChainBuffer - FAIL (cert chain verify failed)!!!\n"));
             return false;
@@ -340,13 +340,11 @@ libspdm_return_t libspdm_challenge(void *spdm_context, void *reserved,
 {
     libspdm_context_t *context;
     size_t retry;
-    uint64_t retry_delay_time;
     libspdm_return_t status;
 
     context = spdm_context;
     context->crypto_request = true;
     retry = context->retry_times;
-    retry_delay_time = context->retry_delay_time;
     do {
         status = libspdm_try_challenge(context, slot_id,
                                        measurement_hash_type,
@@ -355,7 +353,9 @@ libspdm_return_t libspdm_challenge(void *spdm_context, void *reserved,
             return status;
         }
 
-        libspdm_sleep(retry_delay_time);
+        if (!libspdm_wait_before_retry(context, context->retry_times - retry)) {
+            return status;
+        }
     } while (retry-- != 0);
 
     return status;
@@ -372,13 +372,11 @@ libspdm_return_t libspdm_challenge_ex(void *spdm_context, void *reserved,
 {
     libspdm_context_t *context;
     size_t retry;
-    uint64_t retry_delay_time;
     libspdm_return_t status;
 
     context = spdm_context;
     context->crypto_request = true;
     retry = context->retry_times;
-    retry_delay_time = context->retry_delay_time;
     do {
         status = libspdm_try_challenge(context, slot_id,
                                        measurement_hash_type,
@@ -390,7 +388,9 @@ libspdm_return_t libspdm_challenge_ex(void *spdm_context, void *reserved,
             return status;
         }
 
-        libspdm_sleep(retry_delay_time);
+        if (!libspdm_wait_before_retry(context, context->retry_times - retry)) {
+            return status;
+        }
     } while (retry-- != 0);
 
     return status;
@@ -331,6 +331,16 @@ libspdm_return_t libspdm_send_data(void *spdm_context, const uint32_t *session_i
 
     libspdm_release_sender_buffer(context);
 
+    #if LIBSPDM_STATISTICS_SUPPORT
+    if (status == LIBSPDM_STATUS_SUCCESS) {
+        libspdm_statistics_record_message(
+            context,
+            (session_id != NULL) ?
+            libspdm_get_session_info_via_session_id(context, *session_id) : NULL,
+            false, request_size, NULL);
+    }
+    #endif /* LIBSPDM_STATISTICS_SUPPORT */
+
     return status;
 }
 
@@ -362,6 +372,13 @@ libspdm_return_t libspdm_receive_data(void *spdm_context, const uint32_t *sessio
         return status;
     }
 
+    #if LIBSPDM_STATISTICS_SUPPORT
+    libspdm_statistics_record_message(
+        context,
+        (session_id != NULL) ? libspdm_get_session_info_via_session_id(context, *session_id) : NULL,
+        true, spdm_response_size, is_app_message ? NULL : spdm_response);
+    #endif /* LIBSPDM_STATISTICS_SUPPORT */
+
     if (spdm_response->header.request_response_code == SPDM_ERROR) {
         if ((spdm_response->header.param1 == SPDM_ERROR_CODE_DECRYPT_ERROR) &&
             (session_id != NULL)) {
@@ -154,12 +154,10 @@ libspdm_return_t libspdm_send_receive_end_session(libspdm_context_t *spdm_contex
                                                   uint8_t end_session_attributes)
 {
     size_t retry;
-    uint64_t retry_delay_time;
     libspdm_return_t status;
 
     spdm_context->crypto_request = true;
     retry = spdm_context->retry_times;
-    retry_delay_time = spdm_context->retry_delay_time;
     do {
         status = libspdm_try_send_receive_end_session(
             spdm_context, session_id, end_session_attributes);
@@ -167,7 +165,9 @@ libspdm_return_t libspdm_send_receive_end_session(libspdm_context_t *spdm_contex
             return status;
         }
 
-        libspdm_sleep(retry_delay_time);
+        if (!libspdm_wait_before_retry(spdm_context, spdm_context->retry_times - retry)) {
+            return status;
+        }
     } while (retry-- != 0);
 
     return status;
@@ -234,6 +234,9 @@ bool libspdm_generate_finish_req_signature(libspdm_context_t *spdm_context,
     !(LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT)
     uint8_t hash_data[LIBSPDM_MAX_HASH_SIZE];
 #endif
+#if LIBSPDM_STATISTICS_SUPPORT
+    uint64_t start_us;
+#endif /* LIBSPDM_STATISTICS_SUPPORT */
 
     signature_size = libspdm_get_req_asym_signature_size(
         spdm_context->connection_info.algorithm.req_base_asym_alg);
@@ -298,19 +301,31 @@ bool libspdm_generate_finish_req_signature(libspdm_context_t *spdm_context,
     LIBSPDM_INTERNAL_DUMP_DATA(hash_data, hash_size);
     LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "\n"));
 
+#if LIBSPDM_STATISTICS_SUPPORT
+    start_us = libspdm_get_timestamp_us();
+#endif /* LIBSPDM_STATISTICS_SUPPORT */
 #if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
+    LIBSPDM_TRACE_BEGIN(spdm_context, LIBSPDM_TRACE_EVENT_ASYM_SIGN, SPDM_FINISH,
+                        session_info->session_id, th_curr_data_size);
     result = libspdm_requester_data_sign(
         spdm_context->connection_info.version, SPDM_FINISH,
         spdm_context->connection_info.algorithm.req_base_asym_alg,
         spdm_context->connection_info.algorithm.base_hash_algo,
         false, th_curr_data, th_curr_data_size, signature, &signature_size);
 #else
+    LIBSPDM_TRACE_BEGIN(spdm_context, LIBSPDM_TRACE_EVENT_ASYM_SIGN, SPDM_FINISH,
+                        session_info->session_id, hash_size);
     result = libspdm_requester_data_sign(
         spdm_context->connection_info.version, SPDM_FINISH,
         spdm_context->connection_info.algorithm.req_base_asym_alg,
         spdm_context->connection_info.algorithm.base_hash_algo,
         true, hash_data, hash_size, signature, &signature_size);
 #endif
+#if LIBSPDM_STATISTICS_SUPPORT
+    libspdm_statistics_record_crypto(spdm_context, LIBSPDM_STATISTICS_CRYPTO_ASYM_SIGN, start_us);
+#endif /* LIBSPDM_STATISTICS_SUPPORT */
+    LIBSPDM_TRACE_END(spdm_context, LIBSPDM_TRACE_EVENT_ASYM_SIGN, SPDM_FINISH,
+                      session_info->session_id, result ? signature_size : 0);
     if (result) {
         LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "signature - "));
         LIBSPDM_INTERNAL_DUMP_DATA(signature, signature_size);
@@ -580,6 +595,9 @@ static libspdm_return_t libspdm_try_send_receive_finish(libspdm_context_t *spdm_
         status = LIBSPDM_STATUS_CRYPTO_ERROR;
         goto receive_done;
     }
+    #if LIBSPDM_SESSION_PREALLOCATION_SUPPORT
+    libspdm_session_info_new_aead_context(spdm_context, session_info);
+    #endif /* LIBSPDM_SESSION_PREALLOCATION_SUPPORT */
 
     /* -=[Update State Phase]=- */
     libspdm_secured_message_set_session_state(
@@ -609,20 +627,22 @@ libspdm_return_t libspdm_send_receive_finish(libspdm_context_t *spdm_context,
                                              uint8_t req_slot_id_param)
 {
     size_t retry;
-    uint64_t retry_delay_time;
     libspdm_return_t status;
 
     spdm_context->crypto_request = true;
     retry = spdm_context->retry_times;
-    retry_delay_time = spdm_context->retry_delay_time;
     do {
+        LIBSPDM_ALLOC_SCOPE(spdm_context, LIBSPDM_ALLOC_SCOPE_FLOW_BEGIN, SPDM_FINISH);
         status = libspdm_try_send_receive_finish(spdm_context, session_id,
                                                  req_slot_id_param);
+        LIBSPDM_ALLOC_SCOPE(spdm_context, LIBSPDM_ALLOC_SCOPE_FLOW_END, SPDM_FINISH);
         if ((status != LIBSPDM_STATUS_BUSY_PEER) || (retry == 0)) {
             return status;
         }
 
-        libspdm_sleep(retry_delay_time);
+        if (!libspdm_wait_before_retry(spdm_context, spdm_context->retry_times - retry)) {
+            return status;
+        }
     } while (retry-- != 0);
 
     return status;
@@ -322,19 +322,19 @@ receive_done:
 libspdm_return_t libspdm_get_capabilities(libspdm_context_t *spdm_context)
 {
     size_t retry;
-    uint64_t retry_delay_time;
     libspdm_return_t status;
 
     spdm_context->crypto_request = false;
     retry = spdm_context->retry_times;
-    retry_delay_time = spdm_context->retry_delay_time;
     do {
         status = libspdm_try_get_capabilities(spdm_context);
         if ((status != LIBSPDM_STATUS_BUSY_PEER) || (retry == 0)) {
             return status;
         }
 
-        libspdm_sleep(retry_delay_time);
+        if (!libspdm_wait_before_retry(spdm_context, spdm_context->retry_times - retry)) {
+            return status;
+        }
     } while (retry-- != 0);
 
     return status;
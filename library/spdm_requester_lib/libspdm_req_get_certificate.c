@@ -344,6 +344,13 @@ static libspdm_return_t libspdm_try_get_certificate(libspdm_context_t *spdm_cont
     }
 
     spdm_context->connection_info.peer_used_cert_chain_slot_id = slot_id;
+    libspdm_free_peer_leaf_cert_public_key(spdm_context, slot_id);
+#if LIBSPDM_MEASUREMENT_CACHE_SUPPORT
+    /* The kept measurements were signed with the replaced certificate chain. */
+    if (spdm_context->connection_info.measurement_cache.slot_id == slot_id) {
+        spdm_context->connection_info.measurement_cache.valid = false;
+    }
+#endif /* LIBSPDM_MEASUREMENT_CACHE_SUPPORT */
 #if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
     spdm_context->connection_info.peer_used_cert_chain[slot_id].buffer_size =
         cert_chain_size_internal;
@@ -362,6 +369,14 @@ static libspdm_return_t libspdm_try_get_certificate(libspdm_context_t *spdm_cont
 
     spdm_context->connection_info.peer_used_cert_chain[slot_id].buffer_hash_size =
         libspdm_get_hash_size(spdm_context->connection_info.algorithm.base_hash_algo);
+#if LIBSPDM_CONNECTION_SNAPSHOT_SUPPORT
+    spdm_context->connection_info.peer_used_cert_chain_buffer_slot_id = slot_id;
+    spdm_context->connection_info.peer_used_cert_chain_buffer_size = cert_chain_size_internal;
+    libspdm_copy_mem(spdm_context->connection_info.peer_used_cert_chain_buffer,
+                     sizeof(spdm_context->connection_info.peer_used_cert_chain_buffer),
+                     cert_chain, cert_chain_size_internal);
+#endif /* LIBSPDM_CONNECTION_SNAPSHOT_SUPPORT */
+#endif
 
     result = libspdm_get_leaf_cert_public_key_from_cert_chain(
         spdm_context->connection_info.algorithm.base_hash_algo,
@@ -372,7 +387,6 @@ static libspdm_return_t libspdm_try_get_certificate(libspdm_context_t *spdm_cont
         status = LIBSPDM_STATUS_INVALID_CERT;
         goto done;
     }
-#endif
 
     if (status != LIBSPDM_STATUS_VERIF_NO_AUTHORITY) {
         status = LIBSPDM_STATUS_SUCCESS;
@@ -413,13 +427,11 @@ libspdm_return_t libspdm_get_certificate_choose_length(void *spdm_context,
 {
     libspdm_context_t *context;
     size_t retry;
-    uint64_t retry_delay_time;
     libspdm_return_t status;
 
     context = spdm_context;
     context->crypto_request = true;
     retry = context->retry_times;
-    retry_delay_time = context->retry_delay_time;
     do {
         status = libspdm_try_get_certificate(context, session_id, slot_id, length,
                                              cert_chain_size, cert_chain, NULL, NULL);
@@ -427,7 +439,9 @@ libspdm_return_t libspdm_get_certificate_choose_length(void *spdm_context,
             return status;
         }
 
-        libspdm_sleep(retry_delay_time);
+        if (!libspdm_wait_before_retry(context, context->retry_times - retry)) {
+            return status;
+        }
     } while (retry-- != 0);
 
     return status;
@@ -444,13 +458,11 @@ libspdm_return_t libspdm_get_certificate_choose_length_ex(void *spdm_context,
 {
     libspdm_context_t *context;
     size_t retry;
-    uint64_t retry_delay_time;
     libspdm_return_t status;
 
     context = spdm_context;
     context->crypto_request = true;
     retry = context->retry_times;
-    retry_delay_time = context->retry_delay_time;
     do {
         status = libspdm_try_get_certificate(context, session_id, slot_id, length,
                                              cert_chain_size, cert_chain, trust_anchor,
@@ -459,7 +471,9 @@ libspdm_return_t libspdm_get_certificate_choose_length_ex(void *spdm_context,
             return status;
         }
 
-        libspdm_sleep(retry_delay_time);
+        if (!libspdm_wait_before_retry(context, context->retry_times - retry)) {
+            return status;
+        }
     } while (retry-- != 0);
 
     return status;
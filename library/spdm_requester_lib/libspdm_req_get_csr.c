@@ -180,13 +180,11 @@ libspdm_return_t libspdm_get_csr(void * spdm_context,
 {
     libspdm_context_t *context;
     size_t retry;
-    uint64_t retry_delay_time;
     libspdm_return_t status;
 
     context = spdm_context;
     context->crypto_request = true;
     retry = context->retry_times;
-    retry_delay_time = context->retry_delay_time;
     do {
         status = libspdm_try_get_csr(context, session_id,
                                      requester_info, requester_info_length,
@@ -196,7 +194,9 @@ libspdm_return_t libspdm_get_csr(void * spdm_context,
             return status;
         }
 
-        libspdm_sleep(retry_delay_time);
+        if (!libspdm_wait_before_retry(context, context->retry_times - retry)) {
+            return status;
+        }
     } while (retry-- != 0);
 
     return status;
@@ -16,27 +16,15 @@ bool libspdm_verify_measurement_signature(libspdm_context_t *spdm_context,
     bool result;
     void *context;
     uint8_t slot_id;
-#if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
-    libspdm_l1l2_managed_buffer_t l1l2;
-    uint8_t *l1l2_buffer;
-    size_t l1l2_buffer_size;
-    const uint8_t *cert_chain_data;
-    size_t cert_chain_data_size;
-    const uint8_t *cert_buffer;
-    size_t cert_buffer_size;
-#else
+    bool need_free;
     uint8_t l1l2_hash[LIBSPDM_MAX_HASH_SIZE];
     size_t l1l2_hash_size;
-#endif
+#if LIBSPDM_STATISTICS_SUPPORT
+    uint64_t start_us;
+#endif /* LIBSPDM_STATISTICS_SUPPORT */
 
-#if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
-    result = libspdm_calculate_l1l2(spdm_context, session_info, &l1l2);
-    l1l2_buffer = libspdm_get_managed_buffer(&l1l2);
-    l1l2_buffer_size = libspdm_get_managed_buffer_size(&l1l2);
-#else
     l1l2_hash_size = sizeof(l1l2_hash);
     result = libspdm_calculate_l1l2_hash(spdm_context, session_info, &l1l2_hash_size, l1l2_hash);
-#endif
     libspdm_reset_message_m(spdm_context, session_info);
     if (!result) {
         return false;
@@ -54,51 +42,33 @@ bool libspdm_verify_measurement_signature(libspdm_context_t *spdm_context,
         if (!result) {
             return false;
         }
+        need_free = true;
     } else {
-#if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
-        result = libspdm_get_peer_cert_chain_data(
-            spdm_context, (const void **)&cert_chain_data, &cert_chain_data_size);
+        result = libspdm_get_peer_leaf_cert_public_key(spdm_context, true, slot_id,
+                                                       &context, &need_free);
         if (!result) {
             return false;
         }
-
-        /* Get leaf cert from cert chain*/
-        result = libspdm_x509_get_cert_from_cert_chain(cert_chain_data,
-                                                       cert_chain_data_size, -1,
-                                                       &cert_buffer, &cert_buffer_size);
-        if (!result) {
-            return false;
-        }
-
-        result = libspdm_asym_get_public_key_from_x509(
-            spdm_context->connection_info.algorithm.base_asym_algo,
-            cert_buffer, cert_buffer_size, &context);
-        if (!result) {
-            return false;
-        }
-#else
-        context = spdm_context->connection_info.peer_used_cert_chain[slot_id].leaf_cert_public_key;
-        LIBSPDM_ASSERT(context != NULL);
-#endif
     }
 
-#if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
-    result = libspdm_asym_verify(
-        spdm_context->connection_info.version, SPDM_MEASUREMENTS,
-        spdm_context->connection_info.algorithm.base_asym_algo,
-        spdm_context->connection_info.algorithm.base_hash_algo,
-        context, l1l2_buffer, l1l2_buffer_size, sign_data, sign_data_size);
-    libspdm_asym_free(spdm_context->connection_info.algorithm.base_asym_algo, context);
-#else
+#if LIBSPDM_STATISTICS_SUPPORT
+    start_us = libspdm_get_timestamp_us();
+#endif /* LIBSPDM_STATISTICS_SUPPORT */
+    LIBSPDM_TRACE_BEGIN(spdm_context, LIBSPDM_TRACE_EVENT_ASYM_VERIFY, SPDM_GET_MEASUREMENTS,
+                        (session_info != NULL) ? session_info->session_id : 0, sign_data_size);
     result = libspdm_asym_verify_hash(
         spdm_context->connection_info.version, SPDM_MEASUREMENTS,
         spdm_context->connection_info.algorithm.base_asym_algo,
         spdm_context->connection_info.algorithm.base_hash_algo,
         context, l1l2_hash, l1l2_hash_size, sign_data, sign_data_size);
-    if (slot_id == 0xF) {
+#if LIBSPDM_STATISTICS_SUPPORT
+    libspdm_statistics_record_crypto(spdm_context, LIBSPDM_STATISTICS_CRYPTO_ASYM_VERIFY, start_us);
+#endif /* LIBSPDM_STATISTICS_SUPPORT */
+    LIBSPDM_TRACE_END(spdm_context, LIBSPDM_TRACE_EVENT_ASYM_VERIFY, SPDM_GET_MEASUREMENTS,
+                      (session_info != NULL) ? session_info->session_id : 0, 0);
+    if (need_free) {
         libspdm_asym_free(spdm_context->connection_info.algorithm.base_asym_algo, context);
     }
-#endif
     if (!result) {
         LIBSPDM_DEBUG((LIBSPDM_DEBUG_ERROR, "!!! verify_measurement_signature - FAIL !!!\n"));
         return false;
@@ -207,6 +177,11 @@ static libspdm_return_t libspdm_try_get_measurement(libspdm_context_t *spdm_cont
     if ((request_attribute & SPDM_GET_MEASUREMENTS_REQUEST_ATTRIBUTES_GENERATE_SIGNATURE) != 0) {
         signature_size = libspdm_get_asym_signature_size(
             spdm_context->connection_info.algorithm.base_asym_algo);
+#if LIBSPDM_MEASUREMENT_CACHE_SUPPORT
+        /* The next signed response reports the changes since this one, not since the kept
+         * record, so the record is kept again only when it is got or probed again. */
+        spdm_context->connection_info.measurement_cache.valid = false;
+#endif /* LIBSPDM_MEASUREMENT_CACHE_SUPPORT */
     } else {
         signature_size = 0;
     }
@@ -606,13 +581,11 @@ libspdm_return_t libspdm_get_measurement(void *spdm_context, const uint32_t *ses
 {
     libspdm_context_t *context;
     size_t retry;
-    uint64_t retry_delay_time;
     libspdm_return_t status;
 
     context = spdm_context;
     context->crypto_request = true;
     retry = context->retry_times;
-    retry_delay_time = context->retry_delay_time;
     do {
         status = libspdm_try_get_measurement(
             context, session_id, request_attribute,
@@ -622,7 +595,9 @@ libspdm_return_t libspdm_get_measurement(void *spdm_context, const uint32_t *ses
             return status;
         }
 
-        libspdm_sleep(retry_delay_time);
+        if (!libspdm_wait_before_retry(context, context->retry_times - retry)) {
+            return status;
+        }
     } while (retry-- != 0);
 
     return status;
@@ -642,13 +617,11 @@ libspdm_return_t libspdm_get_measurement_ex(void *spdm_context, const uint32_t *
 {
     libspdm_context_t *context;
     size_t retry;
-    uint64_t retry_delay_time;
     libspdm_return_t status;
 
     context = spdm_context;
     context->crypto_request = true;
     retry = context->retry_times;
-    retry_delay_time = context->retry_delay_time;
     do {
         status = libspdm_try_get_measurement(
             context, session_id, request_attribute,
@@ -660,10 +633,341 @@ libspdm_return_t libspdm_get_measurement_ex(void *spdm_context, const uint32_t *
             return status;
         }
 
-        libspdm_sleep(retry_delay_time);
+        if (!libspdm_wait_before_retry(context, context->retry_times - retry)) {
+            return status;
+        }
     } while (retry-- != 0);
 
     return status;
 }
 
+/**
+ * Get the blocks of the measurement record one by one, with the signature requested with the
+ * last block only.
+ **/
+static libspdm_return_t libspdm_get_measurement_blocks_by_index(
+    libspdm_context_t *spdm_context, const uint32_t *session_id, uint8_t request_attribute,
+    uint8_t slot_id_param, uint8_t *content_changed, uint8_t *number_of_blocks,
+    uint32_t *measurement_record_length, uint8_t *measurement_record)
+{
+    libspdm_return_t status;
+    uint8_t total_number_of_blocks;
+    uint8_t block_count;
+    uint8_t measurement_index;
+    uint8_t attribute;
+    uint8_t measurement_block_count;
+    uint32_t record_length;
+    uint32_t block_length;
+
+    status = libspdm_get_measurement(
+        spdm_context, session_id, 0,
+        SPDM_GET_MEASUREMENTS_REQUEST_MEASUREMENT_OPERATION_TOTAL_NUMBER_OF_MEASUREMENTS,
+        slot_id_param, NULL, &total_number_of_blocks, &block_length, NULL);
+    if (LIBSPDM_STATUS_IS_ERROR(status)) {
+        return status;
+    }
+
+    record_length = 0;
+    block_count = 0;
+    for (measurement_index = 1;
+         (measurement_index < SPDM_GET_MEASUREMENTS_REQUEST_MEASUREMENT_OPERATION_ALL_MEASUREMENTS)
+         && (block_count < total_number_of_blocks); measurement_index++) {
+        attribute = request_attribute;
+        if (block_count + 1 < total_number_of_blocks) {
+            attribute = (uint8_t)(attribute &
+                                  ~SPDM_GET_MEASUREMENTS_REQUEST_ATTRIBUTES_GENERATE_SIGNATURE);
+        }
+        block_length = *measurement_record_length - record_length;
+        status = libspdm_get_measurement(
+            spdm_context, session_id, attribute, measurement_index, slot_id_param,
+            content_changed, &measurement_block_count, &block_length,
+            measurement_record + record_length);
+        if (status == LIBSPDM_STATUS_ERROR_PEER) {
+            /* The index has no measurement. The transcript is not changed by an error. */
+            continue;
+        }
+        if (LIBSPDM_STATUS_IS_ERROR(status)) {
+            return status;
+        }
+        record_length += block_length;
+        block_count++;
+    }
+    if (block_count < total_number_of_blocks) {
+        return LIBSPDM_STATUS_INVALID_MSG_FIELD;
+    }
+
+    *number_of_blocks = block_count;
+    *measurement_record_length = record_length;
+    return LIBSPDM_STATUS_SUCCESS;
+}
+
+/**
+ * Get the next block of a measurement record, and move the offset past it.
+ *
+ * @retval true   The block header and its measurement are within the record.
+ * @retval false  The block does not fit the rest of the record.
+ **/
+static bool libspdm_get_next_measurement_block(
+    const uint8_t *measurement_record, uint32_t measurement_record_length, uint32_t *offset,
+    const spdm_measurement_block_common_header_t **measurement_block_header)
+{
+    const spdm_measurement_block_common_header_t *block_header;
+
+    if (measurement_record_length - *offset < sizeof(spdm_measurement_block_common_header_t)) {
+        return false;
+    }
+    block_header = (const void *)(measurement_record + *offset);
+    if (block_header->measurement_size > measurement_record_length - *offset -
+        sizeof(spdm_measurement_block_common_header_t)) {
+        return false;
+    }
+    *offset += (uint32_t)sizeof(spdm_measurement_block_common_header_t) +
+               block_header->measurement_size;
+    *measurement_block_header = block_header;
+    return true;
+}
+
+/**
+ * Check that a measurement record is made of exactly block_count blocks, and fill the blocks if
+ * blocks is not NULL.
+ **/
+static bool libspdm_parse_measurement_blocks(uint8_t block_count, const uint8_t *measurement_record,
+                                             uint32_t measurement_record_length,
+                                             libspdm_measurement_block_t *blocks)
+{
+    uint8_t index;
+    uint32_t offset;
+    const spdm_measurement_block_common_header_t *measurement_block_header;
+
+    offset = 0;
+    for (index = 0; index < block_count; index++) {
+        if (!libspdm_get_next_measurement_block(measurement_record, measurement_record_length,
+                                                &offset, &measurement_block_header)) {
+            return false;
+        }
+        if (blocks != NULL) {
+            blocks[index].index = measurement_block_header->index;
+            blocks[index].measurement_specification =
+                measurement_block_header->measurement_specification;
+            blocks[index].measurement_size = measurement_block_header->measurement_size;
+            blocks[index].measurement = (const uint8_t *)(measurement_block_header + 1);
+        }
+    }
+    return offset == measurement_record_length;
+}
+
+#if LIBSPDM_MEASUREMENT_CACHE_SUPPORT
+/**
+ * Generate the measurement summary hash of all the measurements of a measurement record, as the
+ * device does for SPDM_CHALLENGE_REQUEST_ALL_MEASUREMENTS_HASH.
+ *
+ * Since SPDM 1.2 the measurement blocks are hashed, before it the measurements of the blocks.
+ **/
+static bool libspdm_generate_measurement_record_summary_hash(
+    libspdm_context_t *spdm_context, uint8_t block_count, const uint8_t *measurement_record,
+    uint32_t measurement_record_length, uint8_t *measurement_summary_hash)
+{
+    uint32_t base_hash_algo;
+    void *hash_context;
+    bool result;
+    uint8_t index;
+    uint32_t offset;
+    const spdm_measurement_block_common_header_t *measurement_block_header;
+
+    base_hash_algo = spdm_context->connection_info.algorithm.base_hash_algo;
+    if (libspdm_get_connection_version(spdm_context) >= SPDM_MESSAGE_VERSION_12) {
+        return libspdm_hash_all(base_hash_algo, measurement_record, measurement_record_length,
+                                measurement_summary_hash);
+    }
+
+    hash_context = libspdm_hash_new(base_hash_algo);
+    if (hash_context == NULL) {
+        return false;
+    }
+    result = libspdm_hash_init(base_hash_algo, hash_context);
+    offset = 0;
+    for (index = 0; result && (index < block_count); index++) {
+        result = libspdm_get_next_measurement_block(measurement_record,
+                                                    measurement_record_length, &offset,
+                                                    &measurement_block_header) &&
+                 libspdm_hash_update(base_hash_algo, hash_context, measurement_block_header + 1,
+                                     measurement_block_header->measurement_size);
+    }
+    if (result) {
+        result = libspdm_hash_final(base_hash_algo, hash_context, measurement_summary_hash);
+    }
+    libspdm_hash_free(base_hash_algo, hash_context);
+    return result;
+}
+
+/**
+ * Keep a measurement record got by libspdm_get_measurement_blocks, if it is signed.
+ **/
+static void libspdm_fill_measurement_cache(libspdm_context_t *spdm_context,
+                                           const uint32_t *session_id,
+                                           uint8_t request_attribute, uint8_t slot_id_param,
+                                           uint8_t block_count, const uint8_t *measurement_record,
+                                           uint32_t measurement_record_length)
+{
+    libspdm_measurement_cache_t *measurement_cache;
+
+    measurement_cache = &spdm_context->connection_info.measurement_cache;
+    measurement_cache->valid = false;
+    if (((request_attribute & SPDM_GET_MEASUREMENTS_REQUEST_ATTRIBUTES_GENERATE_SIGNATURE) == 0) ||
+        (measurement_record_length > sizeof(measurement_cache->measurement_record))) {
+        return;
+    }
+    if (!libspdm_generate_measurement_record_summary_hash(
+            spdm_context, block_count, measurement_record, measurement_record_length,
+            measurement_cache->measurement_summary_hash)) {
+        return;
+    }
+
+    libspdm_copy_mem(measurement_cache->measurement_record,
+                     sizeof(measurement_cache->measurement_record),
+                     measurement_record, measurement_record_length);
+    measurement_cache->measurement_record_length = measurement_record_length;
+    measurement_cache->number_of_blocks = block_count;
+    measurement_cache->session_id = (session_id == NULL) ? INVALID_SESSION_ID : *session_id;
+    measurement_cache->slot_id = slot_id_param;
+    measurement_cache->request_attribute =
+        (uint8_t)(request_attribute & ~SPDM_GET_MEASUREMENTS_REQUEST_ATTRIBUTES_GENERATE_SIGNATURE);
+    measurement_cache->valid = true;
+}
+#endif /* LIBSPDM_MEASUREMENT_CACHE_SUPPORT */
+
+libspdm_return_t libspdm_get_measurement_blocks(void *spdm_context, const uint32_t *session_id,
+                                                uint8_t request_attribute,
+                                                uint8_t slot_id_param,
+                                                uint8_t *content_changed,
+                                                uint8_t *number_of_blocks,
+                                                libspdm_measurement_block_t *blocks,
+                                                uint32_t *measurement_record_length,
+                                                void *measurement_record)
+{
+    libspdm_return_t status;
+    uint8_t block_count;
+    uint32_t record_length;
+
+    record_length = *measurement_record_length;
+    status = libspdm_get_measurement(
+        spdm_context, session_id, request_attribute,
+        SPDM_GET_MEASUREMENTS_REQUEST_MEASUREMENT_OPERATION_ALL_MEASUREMENTS,
+        slot_id_param, content_changed, &block_count, &record_length, measurement_record);
+    if (status == LIBSPDM_STATUS_ERROR_PEER) {
+        record_length = *measurement_record_length;
+        status = libspdm_get_measurement_blocks_by_index(
+            spdm_context, session_id, request_attribute, slot_id_param, content_changed,
+            &block_count, &record_length, measurement_record);
+    }
+    if (LIBSPDM_STATUS_IS_ERROR(status)) {
+        return status;
+    }
+    if (!libspdm_parse_measurement_blocks(block_count, measurement_record, record_length, NULL)) {
+        return LIBSPDM_STATUS_INVALID_MSG_FIELD;
+    }
+
+#if LIBSPDM_MEASUREMENT_CACHE_SUPPORT
+    libspdm_fill_measurement_cache(spdm_context, session_id, request_attribute, slot_id_param,
+                                   block_count, measurement_record, record_length);
+#endif /* LIBSPDM_MEASUREMENT_CACHE_SUPPORT */
+
+    *measurement_record_length = record_length;
+    if (*number_of_blocks < block_count) {
+        *number_of_blocks = block_count;
+        return LIBSPDM_STATUS_BUFFER_TOO_SMALL;
+    }
+
+    libspdm_parse_measurement_blocks(block_count, measurement_record, record_length, blocks);
+    *number_of_blocks = block_count;
+
+    return LIBSPDM_STATUS_SUCCESS;
+}
+
+#if LIBSPDM_MEASUREMENT_CACHE_SUPPORT
+libspdm_return_t libspdm_get_measurement_blocks_cached(void *spdm_context,
+                                                       const uint32_t *session_id,
+                                                       uint8_t request_attribute,
+                                                       uint8_t slot_id_param,
+                                                       const void *measurement_summary_hash,
+                                                       uint8_t *content_changed,
+                                                       uint8_t *number_of_blocks,
+                                                       libspdm_measurement_block_t *blocks,
+                                                       uint32_t *measurement_record_length,
+                                                       void *measurement_record)
+{
+    libspdm_context_t *context;
+    libspdm_measurement_cache_t *measurement_cache;
+    libspdm_return_t status;
+    bool unchanged;
+    uint8_t probe_content_changed;
+    uint8_t block_count;
+    uint32_t record_length;
+
+    context = spdm_context;
+    measurement_cache = &context->connection_info.measurement_cache;
+
+    unchanged = false;
+    if (measurement_cache->valid &&
+        (measurement_cache->session_id ==
+         ((session_id == NULL) ? INVALID_SESSION_ID : *session_id)) &&
+        (measurement_cache->slot_id == slot_id_param) &&
+        (measurement_cache->request_attribute ==
+         (uint8_t)(request_attribute &
+                   ~SPDM_GET_MEASUREMENTS_REQUEST_ATTRIBUTES_GENERATE_SIGNATURE)) &&
+        ((request_attribute & SPDM_GET_MEASUREMENTS_REQUEST_ATTRIBUTES_GENERATE_SIGNATURE) != 0)) {
+        if (measurement_summary_hash != NULL) {
+            unchanged = libspdm_consttime_is_mem_equal(
+                measurement_summary_hash, measurement_cache->measurement_summary_hash,
+                libspdm_get_hash_size(context->connection_info.algorithm.base_hash_algo));
+        } else if (libspdm_get_connection_version(context) >= SPDM_MESSAGE_VERSION_12) {
+            /* The signed response reports whether the measurements changed since the last signed
+             * response, which is the one of the kept record or of the previous probe. */
+            status = libspdm_get_measurement(
+                context, session_id, request_attribute,
+                SPDM_GET_MEASUREMENTS_REQUEST_MEASUREMENT_OPERATION_TOTAL_NUMBER_OF_MEASUREMENTS,
+                slot_id_param, &probe_content_changed, &block_count, &record_length, NULL);
+            if (LIBSPDM_STATUS_IS_ERROR(status)) {
+                return status;
+            }
+            unchanged = (probe_content_changed ==
+                         SPDM_MEASUREMENTS_RESPONSE_CONTENT_NO_CHANGE_DETECTED) &&
+                        (block_count == measurement_cache->number_of_blocks);
+            /* The probe is signed, which dropped the kept record. */
+            measurement_cache->valid = unchanged;
+        }
+    }
+
+    if (!unchanged) {
+        return libspdm_get_measurement_blocks(context, session_id, request_attribute,
+                                              slot_id_param, content_changed, number_of_blocks,
+                                              blocks, measurement_record_length,
+                                              measurement_record);
+    }
+
+    if (*measurement_record_length < measurement_cache->measurement_record_length) {
+        *measurement_record_length = measurement_cache->measurement_record_length;
+        return LIBSPDM_STATUS_BUFFER_TOO_SMALL;
+    }
+    libspdm_copy_mem(measurement_record, *measurement_record_length,
+                     measurement_cache->measurement_record,
+                     measurement_cache->measurement_record_length);
+    *measurement_record_length = measurement_cache->measurement_record_length;
+    if (content_changed != NULL) {
+        *content_changed = SPDM_MEASUREMENTS_RESPONSE_CONTENT_NO_CHANGE_DETECTED;
+    }
+    if (*number_of_blocks < measurement_cache->number_of_blocks) {
+        *number_of_blocks = measurement_cache->number_of_blocks;
+        return LIBSPDM_STATUS_BUFFER_TOO_SMALL;
+    }
+
+    /* The kept record was checked when it was got. */
+    libspdm_parse_measurement_blocks(measurement_cache->number_of_blocks, measurement_record,
+                                     measurement_cache->measurement_record_length, blocks);
+    *number_of_blocks = measurement_cache->number_of_blocks;
+
+    return LIBSPDM_STATUS_SUCCESS;
+}
+#endif /* LIBSPDM_MEASUREMENT_CACHE_SUPPORT */
+
 #endif /* LIBSPDM_ENABLE_CAPABILITY_MEAS_CAP*/
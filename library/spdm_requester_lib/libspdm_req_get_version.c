@@ -206,12 +206,10 @@ libspdm_return_t libspdm_get_version(libspdm_context_t *spdm_context,
                                      spdm_version_number_t *version_number_entry)
 {
     size_t retry;
-    uint64_t retry_delay_time;
     libspdm_return_t status;
 
     spdm_context->crypto_request = false;
     retry = spdm_context->retry_times;
-    retry_delay_time = spdm_context->retry_delay_time;
     do {
         status = libspdm_try_get_version(spdm_context,
                                          version_number_entry_count, version_number_entry);
@@ -219,7 +217,9 @@ libspdm_return_t libspdm_get_version(libspdm_context_t *spdm_context,
             return status;
         }
 
-        libspdm_sleep(retry_delay_time);
+        if (!libspdm_wait_before_retry(spdm_context, spdm_context->retry_times - retry)) {
+            return status;
+        }
     } while (retry-- != 0);
 
     return status;
@@ -171,7 +171,8 @@ static libspdm_return_t libspdm_handle_response_not_ready(libspdm_context_t *spd
     spdm_context->error_data.token = extend_error_data->token;
     spdm_context->error_data.rd_tm = extend_error_data->rd_tm;
 
-    libspdm_sleep((2 << extend_error_data->rd_exponent));
+    libspdm_wait_before_respond_if_ready(spdm_context, extend_error_data->rd_exponent,
+                                         extend_error_data->rd_tm);
     return libspdm_requester_respond_if_ready(spdm_context, session_id,
                                               response_size, response,
                                               expected_response_code);
@@ -323,6 +324,9 @@ libspdm_return_t libspdm_handle_error_large_response(
                 status = LIBSPDM_STATUS_BUFFER_TOO_SMALL;
                 break;
             }
+            LIBSPDM_STATISTICS_RECORD_BUFFER(spdm_context,
+                                             spdm_context->statistics_buffer_request_code,
+                                             SCRATCH_LARGE_MESSAGE, large_response_size);
         }
         else {
             if (response_size < sizeof(spdm_chunk_response_response_t)) {
@@ -119,16 +119,16 @@ bool libspdm_verify_key_exchange_rsp_signature(
     bool result;
     void *context;
     uint8_t slot_id;
+    bool need_free;
+#if LIBSPDM_STATISTICS_SUPPORT
+    uint64_t start_us;
+#endif /* LIBSPDM_STATISTICS_SUPPORT */
 #if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
     uint8_t *cert_chain_buffer;
     size_t cert_chain_buffer_size;
     uint8_t *th_curr_data;
     size_t th_curr_data_size;
     libspdm_th_managed_buffer_t th_curr;
-    const uint8_t *cert_chain_data;
-    size_t cert_chain_data_size;
-    const uint8_t *cert_buffer;
-    size_t cert_buffer_size;
 #endif
 #if !(LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT) || (LIBSPDM_DEBUG_PRINT_ENABLE)
     size_t hash_size;
@@ -193,49 +193,41 @@ bool libspdm_verify_key_exchange_rsp_signature(
         if (!result) {
             return false;
         }
+        need_free = true;
     } else {
-#if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
-        /* Get leaf cert from cert chain*/
-        result = libspdm_get_peer_cert_chain_data(
-            spdm_context, (const void **)&cert_chain_data, &cert_chain_data_size);
-        if (!result) {
-            return false;
-        }
-        result = libspdm_x509_get_cert_from_cert_chain(
-            cert_chain_data, cert_chain_data_size, -1, &cert_buffer, &cert_buffer_size);
-        if (!result) {
-            return false;
-        }
-
-        result = libspdm_asym_get_public_key_from_x509(
-            spdm_context->connection_info.algorithm.base_asym_algo,
-            cert_buffer, cert_buffer_size, &context);
+        result = libspdm_get_peer_leaf_cert_public_key(spdm_context, true, slot_id,
+                                                       &context, &need_free);
         if (!result) {
             return false;
         }
-#else
-        context = spdm_context->connection_info.peer_used_cert_chain[slot_id].leaf_cert_public_key;
-        LIBSPDM_ASSERT(context != NULL);
-#endif
     }
 
+#if LIBSPDM_STATISTICS_SUPPORT
+    start_us = libspdm_get_timestamp_us();
+#endif /* LIBSPDM_STATISTICS_SUPPORT */
+    LIBSPDM_TRACE_BEGIN(spdm_context, LIBSPDM_TRACE_EVENT_ASYM_VERIFY, SPDM_KEY_EXCHANGE,
+                        session_info->session_id, sign_data_size);
 #if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
     result = libspdm_asym_verify(
         spdm_context->connection_info.version, SPDM_KEY_EXCHANGE_RSP,
         spdm_context->connection_info.algorithm.base_asym_algo,
         spdm_context->connection_info.algorithm.base_hash_algo,
         context, th_curr_data, th_curr_data_size, sign_data, sign_data_size);
-    libspdm_asym_free(spdm_context->connection_info.algorithm.base_asym_algo, context);
 #else
     result = libspdm_asym_verify_hash(
         spdm_context->connection_info.version, SPDM_KEY_EXCHANGE_RSP,
         spdm_context->connection_info.algorithm.base_asym_algo,
         spdm_context->connection_info.algorithm.base_hash_algo,
         context, hash_data, hash_size, sign_data, sign_data_size);
-    if (slot_id == 0xFF) {
+#endif
+#if LIBSPDM_STATISTICS_SUPPORT
+    libspdm_statistics_record_crypto(spdm_context, LIBSPDM_STATISTICS_CRYPTO_ASYM_VERIFY, start_us);
+#endif /* LIBSPDM_STATISTICS_SUPPORT */
+    LIBSPDM_TRACE_END(spdm_context, LIBSPDM_TRACE_EVENT_ASYM_VERIFY, SPDM_KEY_EXCHANGE,
+                      session_info->session_id, 0);
+    if (need_free) {
         libspdm_asym_free(spdm_context->connection_info.algorithm.base_asym_algo, context);
     }
-#endif
     if (!result) {
         LIBSPDM_DEBUG((LIBSPDM_DEBUG_ERROR, "!!! verify_key_exchange_signature - FAIL !!!\n"));
         return false;
@@ -294,6 +286,9 @@ static libspdm_return_t libspdm_try_send_receive_key_exchange(
     size_t message_size;
     size_t transport_header_size;
     uint8_t mut_auth_requested;
+#if LIBSPDM_STATISTICS_SUPPORT
+    uint64_t start_us;
+#endif /* LIBSPDM_STATISTICS_SUPPORT */
 
     /* -=[Check Parameters Phase]=- */
     LIBSPDM_ASSERT((slot_id < SPDM_MAX_SLOT_COUNT) || (slot_id == 0xff));
@@ -366,22 +361,41 @@ static libspdm_return_t libspdm_try_send_receive_key_exchange(
     ptr = spdm_request->exchange_data;
     dhe_key_size = libspdm_get_dhe_pub_key_size(
         spdm_context->connection_info.algorithm.dhe_named_group);
-    dhe_context = libspdm_secured_message_dhe_new(
-        spdm_context->connection_info.version,
-        spdm_context->connection_info.algorithm.dhe_named_group, true);
+#if LIBSPDM_DHE_KEY_POOL_SUPPORT
+    dhe_context = libspdm_dhe_key_pool_take(
+        spdm_context, spdm_context->connection_info.version,
+        spdm_context->connection_info.algorithm.dhe_named_group, true, ptr, &dhe_key_size);
+#else
+    dhe_context = NULL;
+#endif /* LIBSPDM_DHE_KEY_POOL_SUPPORT */
     if (dhe_context == NULL) {
-        libspdm_release_sender_buffer (spdm_context);
-        return LIBSPDM_STATUS_CRYPTO_ERROR;
-    }
+        dhe_context = libspdm_secured_message_dhe_new(
+            spdm_context->connection_info.version,
+            spdm_context->connection_info.algorithm.dhe_named_group, true);
+        if (dhe_context == NULL) {
+            libspdm_release_sender_buffer (spdm_context);
+            return LIBSPDM_STATUS_CRYPTO_ERROR;
+        }
 
-    result = libspdm_secured_message_dhe_generate_key(
-        spdm_context->connection_info.algorithm.dhe_named_group,
-        dhe_context, ptr, &dhe_key_size);
-    if (!result) {
-        libspdm_secured_message_dhe_free(
-            spdm_context->connection_info.algorithm.dhe_named_group, dhe_context);
-        libspdm_release_sender_buffer (spdm_context);
-        return LIBSPDM_STATUS_CRYPTO_ERROR;
+#if LIBSPDM_STATISTICS_SUPPORT
+        start_us = libspdm_get_timestamp_us();
+#endif /* LIBSPDM_STATISTICS_SUPPORT */
+        LIBSPDM_TRACE_BEGIN(spdm_context, LIBSPDM_TRACE_EVENT_DHE_GENERATE_KEY, SPDM_KEY_EXCHANGE,
+                            0, 0);
+        result = libspdm_secured_message_dhe_generate_key(
+            spdm_context->connection_info.algorithm.dhe_named_group,
+            dhe_context, ptr, &dhe_key_size);
+#if LIBSPDM_STATISTICS_SUPPORT
+        libspdm_statistics_record_crypto(spdm_context, LIBSPDM_STATISTICS_CRYPTO_DHE, start_us);
+#endif /* LIBSPDM_STATISTICS_SUPPORT */
+        LIBSPDM_TRACE_END(spdm_context, LIBSPDM_TRACE_EVENT_DHE_GENERATE_KEY, SPDM_KEY_EXCHANGE,
+                          0, result ? dhe_key_size : 0);
+        if (!result) {
+            libspdm_secured_message_dhe_free(
+                spdm_context->connection_info.algorithm.dhe_named_group, dhe_context);
+            libspdm_release_sender_buffer (spdm_context);
+            return LIBSPDM_STATUS_CRYPTO_ERROR;
+        }
     }
     LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "RequesterKey (0x%x):\n", dhe_key_size));
     LIBSPDM_INTERNAL_DUMP_HEX(ptr, dhe_key_size);
@@ -645,10 +659,20 @@ static libspdm_return_t libspdm_try_send_receive_key_exchange(
         goto receive_done;
     }
 
+#if LIBSPDM_STATISTICS_SUPPORT
+    start_us = libspdm_get_timestamp_us();
+#endif /* LIBSPDM_STATISTICS_SUPPORT */
+    LIBSPDM_TRACE_BEGIN(spdm_context, LIBSPDM_TRACE_EVENT_DHE_COMPUTE_KEY, SPDM_KEY_EXCHANGE,
+                        *session_id, dhe_key_size);
     result = libspdm_secured_message_dhe_compute_key(
         spdm_context->connection_info.algorithm.dhe_named_group,
         dhe_context, spdm_response->exchange_data, dhe_key_size,
         session_info->secured_message_context);
+#if LIBSPDM_STATISTICS_SUPPORT
+    libspdm_statistics_record_crypto(spdm_context, LIBSPDM_STATISTICS_CRYPTO_DHE, start_us);
+#endif /* LIBSPDM_STATISTICS_SUPPORT */
+    LIBSPDM_TRACE_END(spdm_context, LIBSPDM_TRACE_EVENT_DHE_COMPUTE_KEY, SPDM_KEY_EXCHANGE,
+                      *session_id, 0);
     libspdm_secured_message_dhe_free(
         spdm_context->connection_info.algorithm.dhe_named_group, dhe_context);
     if (!result) {
@@ -728,22 +752,24 @@ libspdm_return_t libspdm_send_receive_key_exchange(
     uint8_t *req_slot_id_param, void *measurement_hash)
 {
     size_t retry;
-    uint64_t retry_delay_time;
     libspdm_return_t status;
 
     spdm_context->crypto_request = true;
     retry = spdm_context->retry_times;
-    retry_delay_time = spdm_context->retry_delay_time;
     do {
+        LIBSPDM_ALLOC_SCOPE(spdm_context, LIBSPDM_ALLOC_SCOPE_FLOW_BEGIN, SPDM_KEY_EXCHANGE);
         status = libspdm_try_send_receive_key_exchange(
             spdm_context, measurement_hash_type, slot_id, session_policy,
             session_id, heartbeat_period, req_slot_id_param,
             measurement_hash, NULL, NULL, NULL);
+        LIBSPDM_ALLOC_SCOPE(spdm_context, LIBSPDM_ALLOC_SCOPE_FLOW_END, SPDM_KEY_EXCHANGE);
         if ((status != LIBSPDM_STATUS_BUSY_PEER) || (retry == 0)) {
             return status;
         }
 
-        libspdm_sleep(retry_delay_time);
+        if (!libspdm_wait_before_retry(spdm_context, spdm_context->retry_times - retry)) {
+            return status;
+        }
     } while (retry-- != 0);
 
     return status;
@@ -759,23 +785,25 @@ libspdm_return_t libspdm_send_receive_key_exchange_ex(
     void *responder_random)
 {
     size_t retry;
-    uint64_t retry_delay_time;
     libspdm_return_t status;
 
     spdm_context->crypto_request = true;
     retry = spdm_context->retry_times;
-    retry_delay_time = spdm_context->retry_delay_time;
     do {
+        LIBSPDM_ALLOC_SCOPE(spdm_context, LIBSPDM_ALLOC_SCOPE_FLOW_BEGIN, SPDM_KEY_EXCHANGE);
         status = libspdm_try_send_receive_key_exchange(
             spdm_context, measurement_hash_type, slot_id, session_policy,
             session_id, heartbeat_period, req_slot_id_param,
             measurement_hash, requester_random_in,
             requester_random, responder_random);
+        LIBSPDM_ALLOC_SCOPE(spdm_context, LIBSPDM_ALLOC_SCOPE_FLOW_END, SPDM_KEY_EXCHANGE);
         if ((status != LIBSPDM_STATUS_BUSY_PEER) || (retry == 0)) {
             return status;
         }
 
-        libspdm_sleep(retry_delay_time);
+        if (!libspdm_wait_before_retry(spdm_context, spdm_context->retry_times - retry)) {
+            return status;
+        }
     } while (retry-- != 0);
 
     return status;
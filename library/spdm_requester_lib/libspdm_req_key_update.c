@@ -320,7 +320,6 @@ libspdm_return_t libspdm_key_update(void *spdm_context, uint32_t session_id,
 {
     libspdm_context_t *context;
     size_t retry;
-    uint64_t retry_delay_time;
     libspdm_return_t status;
     bool key_updated;
 
@@ -328,7 +327,6 @@ libspdm_return_t libspdm_key_update(void *spdm_context, uint32_t session_id,
     key_updated = false;
     context->crypto_request = true;
     retry = context->retry_times;
-    retry_delay_time = context->retry_delay_time;
     do {
         status = libspdm_try_key_update(spdm_context, session_id,
                                         single_direction, &key_updated);
@@ -336,7 +334,9 @@ libspdm_return_t libspdm_key_update(void *spdm_context, uint32_t session_id,
             return status;
         }
 
-        libspdm_sleep(retry_delay_time);
+        if (!libspdm_wait_before_retry(context, context->retry_times - retry)) {
+            return status;
+        }
     } while (retry-- != 0);
 
     return status;
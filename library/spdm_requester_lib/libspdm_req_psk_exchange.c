@@ -506,6 +506,9 @@ static libspdm_return_t libspdm_try_send_receive_psk_exchange(
             status = LIBSPDM_STATUS_CRYPTO_ERROR;
             goto receive_done;
         }
+        #if LIBSPDM_SESSION_PREALLOCATION_SUPPORT
+        libspdm_session_info_new_aead_context(spdm_context, session_info);
+        #endif /* LIBSPDM_SESSION_PREALLOCATION_SUPPORT */
 
         libspdm_secured_message_set_session_state(
             session_info->secured_message_context,
@@ -536,23 +539,25 @@ libspdm_return_t libspdm_send_receive_psk_exchange(libspdm_context_t *spdm_conte
                                                    void *measurement_hash)
 {
     size_t retry;
-    uint64_t retry_delay_time;
     libspdm_return_t status;
 
     spdm_context->crypto_request = true;
     retry = spdm_context->retry_times;
-    retry_delay_time = spdm_context->retry_delay_time;
     do {
+        LIBSPDM_ALLOC_SCOPE(spdm_context, LIBSPDM_ALLOC_SCOPE_FLOW_BEGIN, SPDM_PSK_EXCHANGE);
         status = libspdm_try_send_receive_psk_exchange(
             spdm_context, psk_hint, psk_hint_size,
             measurement_hash_type, session_policy, session_id,
             heartbeat_period, measurement_hash,
             NULL, 0, NULL, NULL, NULL, NULL);
+        LIBSPDM_ALLOC_SCOPE(spdm_context, LIBSPDM_ALLOC_SCOPE_FLOW_END, SPDM_PSK_EXCHANGE);
         if ((status != LIBSPDM_STATUS_BUSY_PEER) || (retry == 0)) {
             return status;
         }
 
-        libspdm_sleep(retry_delay_time);
+        if (!libspdm_wait_before_retry(spdm_context, spdm_context->retry_times - retry)) {
+            return status;
+        }
     } while (retry-- != 0);
 
     return status;
@@ -574,13 +579,12 @@ libspdm_return_t libspdm_send_receive_psk_exchange_ex(libspdm_context_t *spdm_co
                                                       size_t *responder_context_size)
 {
     size_t retry;
-    uint64_t retry_delay_time;
     libspdm_return_t status;
 
     spdm_context->crypto_request = true;
     retry = spdm_context->retry_times;
-    retry_delay_time = spdm_context->retry_delay_time;
     do {
+        LIBSPDM_ALLOC_SCOPE(spdm_context, LIBSPDM_ALLOC_SCOPE_FLOW_BEGIN, SPDM_PSK_EXCHANGE);
         status = libspdm_try_send_receive_psk_exchange(
             spdm_context, psk_hint, psk_hint_size,
             measurement_hash_type, session_policy, session_id,
@@ -588,11 +592,14 @@ libspdm_return_t libspdm_send_receive_psk_exchange_ex(libspdm_context_t *spdm_co
             requester_context_in, requester_context_in_size,
             requester_context, requester_context_size,
             responder_context, responder_context_size);
+        LIBSPDM_ALLOC_SCOPE(spdm_context, LIBSPDM_ALLOC_SCOPE_FLOW_END, SPDM_PSK_EXCHANGE);
         if ((status != LIBSPDM_STATUS_BUSY_PEER) || (retry == 0)) {
             return status;
         }
 
-        libspdm_sleep(retry_delay_time);
+        if (!libspdm_wait_before_retry(spdm_context, spdm_context->retry_times - retry)) {
+            return status;
+        }
     } while (retry-- != 0);
 
     return status;
@@ -263,6 +263,9 @@ static libspdm_return_t libspdm_try_send_receive_psk_finish(libspdm_context_t *s
         status = LIBSPDM_STATUS_CRYPTO_ERROR;
         goto receive_done;
     }
+    #if LIBSPDM_SESSION_PREALLOCATION_SUPPORT
+    libspdm_session_info_new_aead_context(spdm_context, session_info);
+    #endif /* LIBSPDM_SESSION_PREALLOCATION_SUPPORT */
 
     libspdm_secured_message_set_session_state(
         session_info->secured_message_context,
@@ -289,20 +292,22 @@ libspdm_return_t libspdm_send_receive_psk_finish(libspdm_context_t *spdm_context
                                                  uint32_t session_id)
 {
     size_t retry;
-    uint64_t retry_delay_time;
     libspdm_return_t status;
 
     spdm_context->crypto_request = true;
     retry = spdm_context->retry_times;
-    retry_delay_time = spdm_context->retry_delay_time;
     do {
+        LIBSPDM_ALLOC_SCOPE(spdm_context, LIBSPDM_ALLOC_SCOPE_FLOW_BEGIN, SPDM_PSK_FINISH);
         status = libspdm_try_send_receive_psk_finish(spdm_context,
                                                      session_id);
+        LIBSPDM_ALLOC_SCOPE(spdm_context, LIBSPDM_ALLOC_SCOPE_FLOW_END, SPDM_PSK_FINISH);
         if ((status != LIBSPDM_STATUS_BUSY_PEER) || (retry == 0)) {
             return status;
         }
 
-        libspdm_sleep(retry_delay_time);
+        if (!libspdm_wait_before_retry(spdm_context, spdm_context->retry_times - retry)) {
+            return status;
+        }
     } while (retry-- != 0);
 
     return status;
@@ -0,0 +1,172 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2021-2022 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+#include "internal/libspdm_requester_lib.h"
+#include "internal/libspdm_secured_message_lib.h"
+
+#if LIBSPDM_ADAPTIVE_RETRY_SUPPORT
+
+/* The weight of a new sample in the smoothed times is 1 / 2^LIBSPDM_RETRY_SMOOTHING_SHIFT. */
+#define LIBSPDM_RETRY_SMOOTHING_SHIFT 3
+
+/* The delay doubles with each retry up to 2^LIBSPDM_RETRY_MAX_BACKOFF_SHIFT times the first one,
+ * before it is bounded by the maximum delay. */
+#define LIBSPDM_RETRY_MAX_BACKOFF_SHIFT 16
+
+/**
+ * Add a sample to a smoothed time.
+ **/
+static void libspdm_retry_smooth(uint64_t *smoothed_us, uint64_t sample_us)
+{
+    if (*smoothed_us == 0) {
+        *smoothed_us = sample_us;
+    } else {
+        *smoothed_us = *smoothed_us - (*smoothed_us >> LIBSPDM_RETRY_SMOOTHING_SHIFT) +
+                       (sample_us >> LIBSPDM_RETRY_SMOOTHING_SHIFT);
+    }
+}
+
+/**
+ * Return a random time from 0 to a time.
+ **/
+static uint64_t libspdm_retry_random(uint64_t time_us)
+{
+    uint32_t random;
+
+    if (!libspdm_get_random_number(sizeof(random), (uint8_t *)&random)) {
+        return time_us;
+    }
+    return (time_us >> 32) * random + (((time_us & 0xFFFFFFFF) * random) >> 32);
+}
+
+void libspdm_retry_policy_request_sent(libspdm_context_t *spdm_context)
+{
+    libspdm_retry_policy_t *retry_policy;
+
+    retry_policy = &spdm_context->retry_policy;
+    retry_policy->request_start_us = libspdm_get_timestamp_us();
+    retry_policy->request_is_retry = retry_policy->retry_pending;
+    retry_policy->retry_pending = false;
+}
+
+void libspdm_retry_policy_response_received(libspdm_context_t *spdm_context,
+                                            size_t response_size, const void *response)
+{
+    libspdm_retry_policy_t *retry_policy;
+    const spdm_message_header_t *spdm_response;
+    uint64_t now_us;
+
+    retry_policy = &spdm_context->retry_policy;
+    now_us = libspdm_get_timestamp_us();
+    spdm_response = response;
+    if ((response_size >= sizeof(spdm_message_header_t)) &&
+        (spdm_response->request_response_code == SPDM_ERROR) &&
+        ((spdm_response->param1 == SPDM_ERROR_CODE_BUSY) ||
+         (spdm_response->param1 == SPDM_ERROR_CODE_RESPONSE_NOT_READY))) {
+        /* The time of a response without the result is not the time to handle the request. */
+        return;
+    }
+
+    if (now_us > retry_policy->request_start_us) {
+        libspdm_retry_smooth(&retry_policy->response_time_us,
+                             now_us - retry_policy->request_start_us);
+    }
+    if (retry_policy->request_is_retry &&
+        (retry_policy->request_start_us > retry_policy->busy_start_us)) {
+        /* The peer stopped being Busy between the first request and this retry. */
+        libspdm_retry_smooth(&retry_policy->busy_time_us,
+                             retry_policy->request_start_us - retry_policy->busy_start_us);
+    }
+    retry_policy->request_is_retry = false;
+}
+
+#endif /* LIBSPDM_ADAPTIVE_RETRY_SUPPORT */
+
+bool libspdm_wait_before_retry(libspdm_context_t *spdm_context, size_t retry_count)
+{
+    uint64_t delay;
+#if LIBSPDM_ADAPTIVE_RETRY_SUPPORT
+    libspdm_retry_policy_t *retry_policy;
+    uint64_t max_delay;
+    uint64_t elapsed_us;
+    size_t shift;
+
+    retry_policy = &spdm_context->retry_policy;
+    if (retry_count == 0) {
+        retry_policy->busy_start_us = retry_policy->request_start_us;
+    }
+
+    /* Do not retry faster than the peer responds, or than it stopped being Busy before. */
+    delay = spdm_context->retry_delay_time;
+    if (retry_policy->response_time_us > delay) {
+        delay = retry_policy->response_time_us;
+    }
+    if (retry_policy->busy_time_us > delay) {
+        delay = retry_policy->busy_time_us;
+    }
+
+    max_delay = retry_policy->max_delay_time;
+    if (max_delay == 0) {
+        max_delay = (uint64_t)1 << spdm_context->connection_info.capability.ct_exponent;
+        if (spdm_context->retry_delay_time > max_delay) {
+            max_delay = spdm_context->retry_delay_time;
+        }
+    }
+    shift = (retry_count < LIBSPDM_RETRY_MAX_BACKOFF_SHIFT) ?
+            retry_count : LIBSPDM_RETRY_MAX_BACKOFF_SHIFT;
+    if (delay > (max_delay >> shift)) {
+        delay = max_delay;
+    } else {
+        delay <<= shift;
+    }
+    /* Retries of requesters that were Busy together are spread. */
+    delay = delay - (delay >> 1) + libspdm_retry_random(delay >> 1);
+
+    if (retry_policy->deadline != 0) {
+        elapsed_us = libspdm_get_timestamp_us() - retry_policy->busy_start_us;
+        if (elapsed_us >= retry_policy->deadline) {
+            return false;
+        }
+        if (delay > retry_policy->deadline - elapsed_us) {
+            delay = retry_policy->deadline - elapsed_us;
+        }
+    }
+    retry_policy->retry_pending = true;
+#else
+    delay = spdm_context->retry_delay_time;
+#endif /* LIBSPDM_ADAPTIVE_RETRY_SUPPORT */
+
+#if LIBSPDM_STATISTICS_SUPPORT
+    libspdm_statistics_add_duration(&spdm_context->statistics.busy_retry_delay, delay);
+#endif /* LIBSPDM_STATISTICS_SUPPORT */
+    libspdm_sleep(delay);
+    return true;
+}
+
+#if LIBSPDM_RESPOND_IF_READY_SUPPORT
+void libspdm_wait_before_respond_if_ready(libspdm_context_t *spdm_context, uint8_t rd_exponent,
+                                          uint8_t rd_tm)
+{
+    uint64_t delay;
+#if LIBSPDM_ADAPTIVE_RETRY_SUPPORT
+    uint64_t rdt;
+
+    /* The response is ready after RDT, and is dropped by the peer after RDT * RDTM. */
+    rdt = (uint64_t)1 << rd_exponent;
+    delay = rdt;
+    if (rd_tm != 1) {
+        delay += libspdm_retry_random(rdt);
+    }
+#else
+    delay = (uint64_t)2 << rd_exponent;
+#endif /* LIBSPDM_ADAPTIVE_RETRY_SUPPORT */
+
+#if LIBSPDM_STATISTICS_SUPPORT
+    libspdm_statistics_add_duration(&spdm_context->statistics.response_not_ready_delay, delay);
+#endif /* LIBSPDM_STATISTICS_SUPPORT */
+    libspdm_sleep(delay);
+}
+#endif /* LIBSPDM_RESPOND_IF_READY_SUPPORT */
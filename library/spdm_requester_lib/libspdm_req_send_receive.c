@@ -74,14 +74,18 @@ libspdm_return_t libspdm_send_request(void *spdm_context, const uint32_t *sessio
     message_size = sender_buffer_size;
     #endif /* LIBSPDM_ENABLE_CAPABILITY_CHUNK_CAP */
 
-    if (session_id != NULL) {
-        /* For secure message, message is in sender buffer, we need copy it to scratch buffer.
+    if ((session_id != NULL) && ((uint8_t *)request != message + transport_header_size)) {
+        /* For secure message, the transport layer encodes the message in place if it is at the
+         * transport header size in the sender buffer. Otherwise we need copy it to scratch buffer.
          * transport_message is always in sender buffer. */
 
         libspdm_copy_mem (scratch_buffer + transport_header_size,
                           scratch_buffer_size - transport_header_size,
                           request, request_size);
         request = scratch_buffer + transport_header_size;
+        LIBSPDM_STATISTICS_RECORD_BUFFER(
+            context, is_app_message ? 0 : context->statistics_buffer_request_code,
+            SCRATCH_SECURE_MESSAGE, transport_header_size + request_size);
     }
 
     /* backup it to last_spdm_request, because the caller wants to compare it with response */
@@ -94,17 +98,31 @@ libspdm_return_t libspdm_send_request(void *spdm_context, const uint32_t *sessio
                           request_size
                           );
         context->last_spdm_request_size = request_size;
+        LIBSPDM_STATISTICS_RECORD_BUFFER(
+            context, is_app_message ? 0 : context->statistics_buffer_request_code,
+            SCRATCH_LAST_SPDM_REQUEST, request_size);
     }
 
+    LIBSPDM_TRACE_BEGIN(context, LIBSPDM_TRACE_EVENT_TRANSPORT_ENCODE,
+                        is_app_message ? 0 : context->trace_request_code,
+                        (session_id != NULL) ? *session_id : 0, request_size);
     status = context->transport_encode_message(
         context, session_id, is_app_message, true, request_size,
         request, &message_size, (void **)&message);
+    LIBSPDM_TRACE_END(context, LIBSPDM_TRACE_EVENT_TRANSPORT_ENCODE,
+                      is_app_message ? 0 : context->trace_request_code,
+                      (session_id != NULL) ? *session_id : 0,
+                      LIBSPDM_STATUS_IS_ERROR(status) ? 0 : message_size);
     if (LIBSPDM_STATUS_IS_ERROR(status)) {
         LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "transport_encode_message status - %p\n",
                        status));
         return status;
     }
 
+    LIBSPDM_STATISTICS_RECORD_BUFFER(
+        context, is_app_message ? 0 : context->statistics_buffer_request_code,
+        SENDER, message_size);
+
     timeout = context->local_context.capability.rtt;
 
     status = context->send_message(context, message_size, message,
@@ -158,6 +176,9 @@ libspdm_return_t libspdm_receive_response(void *spdm_context, const uint32_t *se
                        (session_id != NULL) ? *session_id : 0x0, status));
         return status;
     }
+    LIBSPDM_STATISTICS_RECORD_BUFFER(
+        context, is_app_message ? 0 : context->statistics_buffer_request_code,
+        RECEIVER, message_size);
 
     message_session_id = NULL;
     is_message_app_message = false;
@@ -180,9 +201,16 @@ libspdm_return_t libspdm_receive_response(void *spdm_context, const uint32_t *se
     backup_response = *response;
     backup_response_size = *response_size;
 
+    LIBSPDM_TRACE_BEGIN(context, LIBSPDM_TRACE_EVENT_TRANSPORT_DECODE,
+                        is_app_message ? 0 : context->trace_request_code,
+                        (session_id != NULL) ? *session_id : 0, message_size);
     status = context->transport_decode_message(
         context, &message_session_id, &is_message_app_message,
         false, message_size, message, response_size, response);
+    LIBSPDM_TRACE_END(context, LIBSPDM_TRACE_EVENT_TRANSPORT_DECODE,
+                      is_app_message ? 0 : context->trace_request_code,
+                      (session_id != NULL) ? *session_id : 0,
+                      LIBSPDM_STATUS_IS_ERROR(status) ? 0 : *response_size);
 
     reset_key_update = false;
     temp_session_context = NULL;
@@ -211,9 +239,16 @@ libspdm_return_t libspdm_receive_response(void *spdm_context, const uint32_t *se
         is_message_app_message = false;
         *response = backup_response;
         *response_size = backup_response_size;
+        LIBSPDM_TRACE_BEGIN(context, LIBSPDM_TRACE_EVENT_TRANSPORT_DECODE,
+                            is_app_message ? 0 : context->trace_request_code,
+                            (session_id != NULL) ? *session_id : 0, message_size);
         status = context->transport_decode_message(
             context, &message_session_id, &is_message_app_message,
             false, message_size, message, response_size, response);
+        LIBSPDM_TRACE_END(context, LIBSPDM_TRACE_EVENT_TRANSPORT_DECODE,
+                          is_app_message ? 0 : context->trace_request_code,
+                          (session_id != NULL) ? *session_id : 0,
+                          LIBSPDM_STATUS_IS_ERROR(status) ? 0 : *response_size);
 
         reset_key_update = true;
     }
@@ -255,6 +290,11 @@ libspdm_return_t libspdm_receive_response(void *spdm_context, const uint32_t *se
                        "libspdm_receive_spdm_response[%x] status - %p\n",
                        (session_id != NULL) ? *session_id : 0x0, status));
     } else {
+        if (session_id != NULL) {
+            LIBSPDM_STATISTICS_RECORD_BUFFER(
+                context, is_app_message ? 0 : context->statistics_buffer_request_code,
+                SCRATCH_SECURE_MESSAGE, transport_header_size + *response_size);
+        }
         LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO,
                        "libspdm_receive_spdm_response[%x] msg %s(0x%x), size (0x%x): \n",
                        (session_id != NULL) ? *session_id : 0x0,
@@ -317,6 +357,7 @@ libspdm_return_t libspdm_handle_large_request(
     uint8_t *chunk_ptr;
     size_t copy_size;
     libspdm_chunk_info_t *send_info;
+    const uint8_t *large_request;
 
     /* Fail if requester or responder does not support chunk cap */
     if (!libspdm_is_capabilities_flag_supported(
@@ -339,15 +380,25 @@ libspdm_return_t libspdm_handle_large_request(
     send_info->chunk_in_use = true;
 
     /* The first section of the scratch
-     * buffer may be used for other purposes. Use only after that section. */
+     * buffer may be used for other purposes. Use only after that section.
+     * The response to the large request is stored there. */
     send_info->large_message = scratch_buffer +
                                libspdm_get_scratch_buffer_large_message_offset(spdm_context);
     send_info->large_message_capacity =
         libspdm_get_scratch_buffer_large_message_capacity(spdm_context);
 
-    libspdm_zero_mem(send_info->large_message, send_info->large_message_capacity);
-    libspdm_copy_mem(send_info->large_message, send_info->large_message_capacity,
-                     request, request_size);
+    /* The chunks are sent from the request in place. The request is only copied if it was built
+     * in the buffer the chunks are sent from. */
+    if (((uint8_t*)request + request_size > message) &&
+        ((uint8_t*)request < message + message_size)) {
+        libspdm_copy_mem(send_info->large_message, send_info->large_message_capacity,
+                         request, request_size);
+        LIBSPDM_STATISTICS_RECORD_BUFFER(spdm_context,
+                                         spdm_context->statistics_buffer_request_code,
+                                         SCRATCH_LARGE_MESSAGE, request_size);
+        request = send_info->large_message;
+    }
+    large_request = request;
 
     send_info->large_message_size = request_size;
     send_info->chunk_bytes_transferred = 0;
@@ -389,7 +440,7 @@ libspdm_return_t libspdm_handle_large_request(
 
         libspdm_copy_mem(
             chunk_ptr, spdm_request_size - ((uint8_t*) spdm_request - (uint8_t*) message),
-            (uint8_t*)send_info->large_message + send_info->chunk_bytes_transferred, copy_size);
+            large_request + send_info->chunk_bytes_transferred, copy_size);
 
         send_info->chunk_bytes_transferred += copy_size;
         if (send_info->chunk_bytes_transferred >= send_info->large_message_size) {
@@ -397,6 +448,10 @@ libspdm_return_t libspdm_handle_large_request(
         }
 
         spdm_request_size = (chunk_ptr + copy_size) - (uint8_t*)spdm_request;
+        LIBSPDM_STATISTICS_RECORD_BUFFER(spdm_context,
+                                         spdm_context->statistics_buffer_request_code,
+                                         SCRATCH_SENDER_RECEIVER,
+                                         transport_header_size + spdm_request_size);
         status = libspdm_send_request(
             spdm_context, session_id, false,
             spdm_request_size, spdm_request);
@@ -411,8 +466,6 @@ libspdm_return_t libspdm_handle_large_request(
         response = message;
         response_size = message_size;
 
-        libspdm_zero_mem(response, response_size);
-
         status = libspdm_receive_response(
             spdm_context, session_id, false,
             &response_size, &response);
@@ -529,6 +582,30 @@ libspdm_return_t libspdm_send_spdm_request(libspdm_context_t *spdm_context,
     libspdm_session_info_t *session_info;
     libspdm_session_state_t session_state;
     libspdm_return_t status;
+    #if LIBSPDM_TRACE_SUPPORT
+    uint32_t trace_session_id;
+    #endif /* LIBSPDM_TRACE_SUPPORT */
+
+    #if LIBSPDM_STATISTICS_SUPPORT
+    uint64_t start_us;
+    uint8_t request_code;
+    libspdm_session_info_t *statistics_session_info;
+
+    /* The request may be encrypted in place when it is sent. */
+    start_us = libspdm_get_timestamp_us();
+    request_code = ((const spdm_message_header_t *)request)->request_response_code;
+    statistics_session_info = NULL;
+    if (session_id != NULL) {
+        statistics_session_info = libspdm_get_session_info_via_session_id(
+            spdm_context, *session_id);
+    }
+    #endif /* LIBSPDM_STATISTICS_SUPPORT */
+    #if LIBSPDM_TRACE_SUPPORT
+    trace_session_id = (session_id != NULL) ? *session_id : 0;
+    #endif /* LIBSPDM_TRACE_SUPPORT */
+    #if LIBSPDM_STATISTICS_SUPPORT
+    spdm_context->statistics_buffer_request_code = request_code;
+    #endif /* LIBSPDM_STATISTICS_SUPPORT */
 
     /* large SPDM message is the SPDM message whose size is greater than the DataTransferSize of the receiving
      * SPDM endpoint or greater than the transmit buffer size of the sending SPDM endpoint */
@@ -562,6 +639,14 @@ libspdm_return_t libspdm_send_spdm_request(libspdm_context_t *spdm_context,
         }
     }
 
+    #if LIBSPDM_TRACE_SUPPORT
+    /* The request may be encrypted in place when it is sent. */
+    spdm_context->trace_request_code =
+        ((const spdm_message_header_t *)request)->request_response_code;
+    #endif /* LIBSPDM_TRACE_SUPPORT */
+    LIBSPDM_TRACE_BEGIN(spdm_context, LIBSPDM_TRACE_EVENT_REQUEST, spdm_context->trace_request_code,
+                        trace_session_id, request_size);
+
     /* large SPDM message is the SPDM message whose size is greater than the DataTransferSize of the receiving
      * SPDM endpoint or greater than the transmit buffer size of the sending SPDM endpoint */
     if (((const spdm_message_header_t*) request)->request_response_code != SPDM_GET_VERSION
@@ -586,6 +671,9 @@ libspdm_return_t libspdm_send_spdm_request(libspdm_context_t *spdm_context,
                 libspdm_get_scratch_buffer_last_spdm_request_capacity(spdm_context),
                 request, request_size);
             spdm_context->last_spdm_request_size = request_size;
+            LIBSPDM_STATISTICS_RECORD_BUFFER(spdm_context,
+                                             spdm_context->statistics_buffer_request_code,
+                                             SCRATCH_LAST_SPDM_REQUEST, request_size);
         }
 
         status = libspdm_handle_large_request(
@@ -605,6 +693,30 @@ libspdm_return_t libspdm_send_spdm_request(libspdm_context_t *spdm_context,
     }
     #endif
 
+    #if LIBSPDM_TRACE_SUPPORT
+    /* The request is complete when its response is received. */
+    if (status != LIBSPDM_STATUS_SUCCESS) {
+        LIBSPDM_TRACE_END(spdm_context, LIBSPDM_TRACE_EVENT_REQUEST,
+                          spdm_context->trace_request_code, trace_session_id, 0);
+    }
+    #endif /* LIBSPDM_TRACE_SUPPORT */
+
+    #if LIBSPDM_ADAPTIVE_RETRY_SUPPORT
+    if (status == LIBSPDM_STATUS_SUCCESS) {
+        libspdm_retry_policy_request_sent(spdm_context);
+    }
+    #endif /* LIBSPDM_ADAPTIVE_RETRY_SUPPORT */
+
+    #if LIBSPDM_STATISTICS_SUPPORT
+    if (status == LIBSPDM_STATUS_SUCCESS) {
+        libspdm_statistics_record_message(spdm_context, statistics_session_info, false,
+                                          request_size, NULL);
+        /* The handling time is recorded when the response is received. */
+        spdm_context->statistics_request_code = request_code;
+        spdm_context->statistics_request_start_us = start_us;
+    }
+    #endif /* LIBSPDM_STATISTICS_SUPPORT */
+
     return status;
 }
 
@@ -622,6 +734,22 @@ libspdm_return_t libspdm_receive_spdm_response(libspdm_context_t *spdm_context,
     size_t response_capacity;
     libspdm_chunk_info_t *send_info;
     #endif /* LIBSPDM_ENABLE_CAPABILITY_CHUNK_CAP */
+    #if LIBSPDM_TRACE_SUPPORT
+    uint32_t trace_session_id;
+    #endif /* LIBSPDM_TRACE_SUPPORT */
+
+    #if LIBSPDM_STATISTICS_SUPPORT
+    libspdm_session_info_t *statistics_session_info;
+
+    statistics_session_info = NULL;
+    if (session_id != NULL) {
+        statistics_session_info = libspdm_get_session_info_via_session_id(
+            spdm_context, *session_id);
+    }
+    #endif /* LIBSPDM_STATISTICS_SUPPORT */
+    #if LIBSPDM_TRACE_SUPPORT
+    trace_session_id = (session_id != NULL) ? *session_id : 0;
+    #endif /* LIBSPDM_TRACE_SUPPORT */
 
     if ((session_id != NULL) &&
         libspdm_is_capabilities_flag_supported(
@@ -709,5 +837,26 @@ libspdm_return_t libspdm_receive_spdm_response(libspdm_context_t *spdm_context,
 receive_done:
     #endif /* LIBSPDM_ENABLE_CAPABILITY_CHUNK_CAP */
 
+    #if LIBSPDM_ADAPTIVE_RETRY_SUPPORT
+    if (status == LIBSPDM_STATUS_SUCCESS) {
+        libspdm_retry_policy_response_received(spdm_context, *response_size, *response);
+    }
+    #endif /* LIBSPDM_ADAPTIVE_RETRY_SUPPORT */
+
+    #if LIBSPDM_STATISTICS_SUPPORT
+    if (status == LIBSPDM_STATUS_SUCCESS) {
+        libspdm_statistics_record_message(spdm_context, statistics_session_info, true,
+                                          *response_size, *response);
+        libspdm_statistics_record_request(spdm_context, statistics_session_info,
+                                          spdm_context->statistics_request_code,
+                                          spdm_context->statistics_request_start_us);
+        spdm_context->statistics_request_code = 0;
+    }
+    #endif /* LIBSPDM_STATISTICS_SUPPORT */
+
+    LIBSPDM_TRACE_END(spdm_context, LIBSPDM_TRACE_EVENT_REQUEST, spdm_context->trace_request_code,
+                      trace_session_id,
+                      (status == LIBSPDM_STATUS_SUCCESS) ? *response_size : 0);
+
     return status;
 }
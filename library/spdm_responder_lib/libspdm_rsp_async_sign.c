@@ -0,0 +1,159 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2021-2022 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+#include "internal/libspdm_responder_lib.h"
+
+#if LIBSPDM_RESPONDER_ASYNC_SIGN_SUPPORT
+
+libspdm_return_t libspdm_responder_defer_response(libspdm_context_t *spdm_context,
+                                                  uint8_t request_code, uint32_t session_id,
+                                                  size_t signature_offset,
+                                                  size_t signature_size,
+                                                  size_t *response_size, void *response)
+{
+    libspdm_async_sign_context_t *async_sign;
+    libspdm_return_t status;
+
+    async_sign = &spdm_context->async_sign;
+
+    LIBSPDM_ASSERT(async_sign->submitted);
+    LIBSPDM_ASSERT(*response_size <= sizeof(async_sign->response));
+    LIBSPDM_ASSERT(signature_offset + signature_size <= *response_size);
+
+    libspdm_copy_mem(async_sign->response, sizeof(async_sign->response),
+                     response, *response_size);
+    async_sign->response_size = *response_size;
+    async_sign->signature_offset = signature_offset;
+    async_sign->signature_size = signature_size;
+    async_sign->session_id = session_id;
+    async_sign->request_in_session = spdm_context->last_spdm_request_session_id_valid;
+    async_sign->request_session_id = spdm_context->last_spdm_request_session_id;
+    async_sign->request_code = request_code;
+    async_sign->signature_ready = false;
+    async_sign->signature_result = true;
+
+    LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "defer response (0x%x) for signature, RDTExponent %d\n",
+                   request_code, async_sign->rd_exponent));
+
+    /* async_sign.submitted lets the response state handler use the RDTExponent of the signer. */
+    spdm_context->response_state = LIBSPDM_RESPONSE_STATE_NOT_READY;
+    status = libspdm_responder_handle_response_state(spdm_context, request_code,
+                                                     response_size, response);
+    async_sign->submitted = false;
+    async_sign->token = spdm_context->error_data.token;
+
+    return status;
+}
+
+void libspdm_responder_poll_deferred_response(libspdm_context_t *spdm_context)
+{
+    libspdm_async_sign_context_t *async_sign;
+    libspdm_responder_data_sign_poll_func poll_func;
+    bool is_ready;
+    size_t sig_size;
+
+    async_sign = &spdm_context->async_sign;
+    if ((async_sign->request_code == 0) || async_sign->signature_ready) {
+        return;
+    }
+
+    poll_func = (libspdm_responder_data_sign_poll_func)async_sign->poll;
+    if (poll_func == NULL) {
+        async_sign->signature_result = false;
+        async_sign->signature_ready = true;
+        return;
+    }
+
+    is_ready = false;
+    sig_size = async_sign->signature_size;
+    if (!poll_func(spdm_context, &is_ready,
+                   async_sign->response + async_sign->signature_offset, &sig_size)) {
+        async_sign->signature_result = false;
+        async_sign->signature_ready = true;
+        return;
+    }
+    if (!is_ready) {
+        return;
+    }
+
+    if (sig_size != async_sign->signature_size) {
+        async_sign->signature_result = false;
+    }
+    async_sign->signature_ready = true;
+}
+
+libspdm_return_t libspdm_responder_complete_deferred_response(libspdm_context_t *spdm_context,
+                                                              size_t *response_size,
+                                                              void *response)
+{
+    libspdm_async_sign_context_t *async_sign;
+    uint8_t request_code;
+#if LIBSPDM_ENABLE_CAPABILITY_CHAL_CAP
+    spdm_challenge_auth_response_t *spdm_challenge_auth_response;
+#endif /* LIBSPDM_ENABLE_CAPABILITY_CHAL_CAP */
+
+    async_sign = &spdm_context->async_sign;
+    LIBSPDM_ASSERT(async_sign->signature_ready);
+
+    if (!async_sign->signature_result) {
+        libspdm_responder_discard_deferred_response(spdm_context);
+        return libspdm_generate_error_response(spdm_context,
+                                               SPDM_ERROR_CODE_UNSPECIFIED, 0,
+                                               response_size, response);
+    }
+
+    LIBSPDM_ASSERT(*response_size >= async_sign->response_size);
+    libspdm_copy_mem(response, *response_size, async_sign->response, async_sign->response_size);
+    *response_size = async_sign->response_size;
+
+    request_code = async_sign->request_code;
+    async_sign->request_code = 0;
+    async_sign->signature_ready = false;
+
+    switch (request_code) {
+#if LIBSPDM_ENABLE_CAPABILITY_CHAL_CAP
+    case SPDM_CHALLENGE:
+        spdm_challenge_auth_response = response;
+        if ((spdm_challenge_auth_response->header.param1 &
+             SPDM_CHALLENGE_AUTH_RESPONSE_ATTRIBUTE_BASIC_MUT_AUTH_REQ) == 0) {
+            libspdm_set_connection_state(spdm_context,
+                                         LIBSPDM_CONNECTION_STATE_AUTHENTICATED);
+        }
+        break;
+#endif /* LIBSPDM_ENABLE_CAPABILITY_CHAL_CAP */
+#if LIBSPDM_ENABLE_CAPABILITY_KEY_EX_CAP
+    case SPDM_KEY_EXCHANGE:
+        return libspdm_finalize_response_key_exchange(
+            spdm_context, (const spdm_key_exchange_request_t *)spdm_context->cache_spdm_request,
+            async_sign->session_id, (uint8_t *)response + async_sign->signature_offset,
+            response_size, response);
+#endif /* LIBSPDM_ENABLE_CAPABILITY_KEY_EX_CAP */
+    default:
+        break;
+    }
+
+    return LIBSPDM_STATUS_SUCCESS;
+}
+
+void libspdm_responder_discard_deferred_response(libspdm_context_t *spdm_context)
+{
+    libspdm_async_sign_context_t *async_sign;
+
+    async_sign = &spdm_context->async_sign;
+
+#if LIBSPDM_ENABLE_CAPABILITY_KEY_EX_CAP
+    if (async_sign->request_code == SPDM_KEY_EXCHANGE) {
+        libspdm_free_session_id(spdm_context, async_sign->session_id);
+    }
+#endif /* LIBSPDM_ENABLE_CAPABILITY_KEY_EX_CAP */
+
+    libspdm_zero_mem(async_sign->response, async_sign->response_size);
+    async_sign->response_size = 0;
+    async_sign->request_code = 0;
+    async_sign->signature_ready = false;
+}
+
+#endif /* LIBSPDM_RESPONDER_ASYNC_SIGN_SUPPORT */
@@ -253,6 +253,15 @@ libspdm_return_t libspdm_get_response_challenge_auth(libspdm_context_t *spdm_con
             spdm_context, SPDM_ERROR_CODE_UNSPECIFIED,
             0, response_size, response);
     }
+#if LIBSPDM_RESPONDER_ASYNC_SIGN_SUPPORT
+    if (spdm_context->async_sign.submitted) {
+        libspdm_reset_message_b(spdm_context);
+        libspdm_reset_message_c(spdm_context);
+        return libspdm_responder_defer_response(spdm_context, SPDM_CHALLENGE, 0,
+                                                (size_t)ptr - (size_t)spdm_response,
+                                                signature_size, response_size, response);
+    }
+#endif /* LIBSPDM_RESPONDER_ASYNC_SIGN_SUPPORT */
     ptr += signature_size;
 
     if ((auth_attribute & SPDM_CHALLENGE_AUTH_RESPONSE_ATTRIBUTE_BASIC_MUT_AUTH_REQ) == 0) {
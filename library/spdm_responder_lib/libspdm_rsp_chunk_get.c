@@ -94,7 +94,9 @@ libspdm_return_t libspdm_get_response_chunk_get(
             response_size, response);
     }
 
-    libspdm_zero_mem(response, *response_size);
+    /* Only the header is built here. The chunk is copied once from the large message region,
+     * straight to its place in the response. */
+    libspdm_zero_mem(response, sizeof(spdm_chunk_response_response_t));
 
     /* Assert the data transfer size is smaller than the response size.
      * Otherwise there is no reason to chunk this response. */
@@ -111,6 +111,8 @@ libspdm_return_t libspdm_get_response_chunk_send(libspdm_context_t *spdm_context
                 libspdm_get_scratch_buffer_large_message_capacity(spdm_context);
             send_info->large_message_size = large_message_size;
             send_info->chunk_bytes_transferred = spdm_request->chunk_size;
+            LIBSPDM_STATISTICS_RECORD_BUFFER(spdm_context, SPDM_CHUNK_SEND,
+                                             SCRATCH_LARGE_MESSAGE, large_message_size);
 
             libspdm_copy_mem(
                 send_info->large_message, send_info->large_message_capacity,
@@ -158,7 +160,8 @@ libspdm_return_t libspdm_get_response_chunk_send(libspdm_context_t *spdm_context
 
     LIBSPDM_ASSERT(*response_size >= sizeof(spdm_chunk_send_ack_response_t));
 
-    libspdm_zero_mem(response, *response_size);
+    /* The response to the large request clears its own buffer. */
+    libspdm_zero_mem(response, sizeof(spdm_chunk_send_ack_response_t));
     spdm_response = response;
 
     spdm_response->header.spdm_version = spdm_request->header.spdm_version;
@@ -204,6 +207,17 @@ libspdm_return_t libspdm_get_response_chunk_send(libspdm_context_t *spdm_context
                 send_info->large_message_size, send_info->large_message,
                 &chunk_response_size, chunk_response);
         }
+        else if (spdm_context->get_response_func != NULL) {
+            /* A large vendor defined request is handled by the integrator. */
+            libspdm_zero_mem(chunk_response, chunk_response_size);
+            status = ((libspdm_get_response_func) spdm_context->get_response_func)(
+                spdm_context,
+                spdm_context->last_spdm_request_session_id_valid ?
+                &spdm_context->last_spdm_request_session_id : NULL,
+                false,
+                send_info->large_message_size, send_info->large_message,
+                &chunk_response_size, chunk_response);
+        }
         else {
             status = LIBSPDM_STATUS_SUCCESS;
             libspdm_generate_error_response(
@@ -193,6 +193,7 @@ libspdm_return_t libspdm_process_encap_response_certificate(
         spdm_context->encap_context.req_slot_id;
     slot_id = spdm_context->encap_context.req_slot_id;
     LIBSPDM_ASSERT(slot_id < SPDM_MAX_SLOT_COUNT);
+    libspdm_free_peer_leaf_cert_public_key(spdm_context, slot_id);
 #if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
     spdm_context->connection_info.peer_used_cert_chain[slot_id].buffer_size =
         libspdm_get_managed_buffer_size(
@@ -216,6 +217,19 @@ libspdm_return_t libspdm_process_encap_response_certificate(
     }
     spdm_context->connection_info.peer_used_cert_chain[slot_id].buffer_hash_size =
         libspdm_get_hash_size(spdm_context->connection_info.algorithm.base_hash_algo);
+#if LIBSPDM_CONNECTION_SNAPSHOT_SUPPORT
+    spdm_context->connection_info.peer_used_cert_chain_buffer_slot_id = slot_id;
+    spdm_context->connection_info.peer_used_cert_chain_buffer_size =
+        libspdm_get_managed_buffer_size(
+            &spdm_context->encap_context.certificate_chain_buffer);
+    libspdm_copy_mem(spdm_context->connection_info.peer_used_cert_chain_buffer,
+                     sizeof(spdm_context->connection_info.peer_used_cert_chain_buffer),
+                     libspdm_get_managed_buffer(
+                         &spdm_context->encap_context.certificate_chain_buffer),
+                     libspdm_get_managed_buffer_size(
+                         &spdm_context->encap_context.certificate_chain_buffer));
+#endif /* LIBSPDM_CONNECTION_SNAPSHOT_SUPPORT */
+#endif
 
     result = libspdm_get_leaf_cert_public_key_from_cert_chain(
         spdm_context->connection_info.algorithm.base_hash_algo,
@@ -228,7 +242,7 @@ libspdm_return_t libspdm_process_encap_response_certificate(
     if (!result) {
         return LIBSPDM_STATUS_INVALID_CERT;
     }
-#endif
+
     if (status != LIBSPDM_STATUS_VERIF_NO_AUTHORITY) {
         return LIBSPDM_STATUS_SUCCESS;
     } else {
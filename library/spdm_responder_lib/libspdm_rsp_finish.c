@@ -113,6 +113,7 @@ bool libspdm_verify_finish_req_signature(libspdm_context_t *spdm_context,
     bool result;
     void *context;
     uint8_t slot_id;
+    bool need_free;
 #if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
     uint8_t *cert_chain_buffer;
     size_t cert_chain_buffer_size;
@@ -121,11 +122,10 @@ bool libspdm_verify_finish_req_signature(libspdm_context_t *spdm_context,
     uint8_t *th_curr_data;
     size_t th_curr_data_size;
     libspdm_th_managed_buffer_t th_curr;
-    const uint8_t *mut_cert_chain_data;
-    size_t mut_cert_chain_data_size;
-    const uint8_t *mut_cert_buffer;
-    size_t mut_cert_buffer_size;
 #endif
+#if LIBSPDM_STATISTICS_SUPPORT
+    uint64_t start_us;
+#endif /* LIBSPDM_STATISTICS_SUPPORT */
 #if ((LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT) && (LIBSPDM_DEBUG_BLOCK_ENABLE)) || \
     !(LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT)
     uint8_t hash_data[LIBSPDM_MAX_HASH_SIZE];
@@ -208,53 +208,41 @@ bool libspdm_verify_finish_req_signature(libspdm_context_t *spdm_context,
         if (!result) {
             return false;
         }
+        need_free = true;
     } else {
-#if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
-        /* Get leaf cert from cert chain*/
-        result = libspdm_get_peer_cert_chain_data(spdm_context,
-                                                  (const void **)&mut_cert_chain_data,
-                                                  &mut_cert_chain_data_size);
-        if (!result) {
-            return false;
-        }
-
-        result = libspdm_x509_get_cert_from_cert_chain(mut_cert_chain_data,
-                                                       mut_cert_chain_data_size, -1,
-                                                       &mut_cert_buffer,
-                                                       &mut_cert_buffer_size);
+        result = libspdm_get_peer_leaf_cert_public_key(spdm_context, false, slot_id,
+                                                       &context, &need_free);
         if (!result) {
             return false;
         }
-
-        result = libspdm_req_asym_get_public_key_from_x509(
-            spdm_context->connection_info.algorithm.req_base_asym_alg,
-            mut_cert_buffer, mut_cert_buffer_size, &context);
-        if (!result) {
-            return false;
-        }
-#else
-        context = spdm_context->connection_info.peer_used_cert_chain[slot_id].leaf_cert_public_key;
-        LIBSPDM_ASSERT(context != NULL);
-#endif
     }
 
+#if LIBSPDM_STATISTICS_SUPPORT
+    start_us = libspdm_get_timestamp_us();
+#endif /* LIBSPDM_STATISTICS_SUPPORT */
+    LIBSPDM_TRACE_BEGIN(spdm_context, LIBSPDM_TRACE_EVENT_ASYM_VERIFY, SPDM_FINISH,
+                        session_info->session_id, sign_data_size);
 #if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
     result = libspdm_req_asym_verify(
         spdm_context->connection_info.version, SPDM_FINISH,
         spdm_context->connection_info.algorithm.req_base_asym_alg,
         spdm_context->connection_info.algorithm.base_hash_algo,
         context, th_curr_data, th_curr_data_size, sign_data, sign_data_size);
-    libspdm_req_asym_free(spdm_context->connection_info.algorithm.req_base_asym_alg, context);
 #else
     result = libspdm_req_asym_verify_hash(
         spdm_context->connection_info.version, SPDM_FINISH,
         spdm_context->connection_info.algorithm.req_base_asym_alg,
         spdm_context->connection_info.algorithm.base_hash_algo,
         context, hash_data, hash_size, sign_data, sign_data_size);
-    if (slot_id == 0xFF) {
+#endif
+#if LIBSPDM_STATISTICS_SUPPORT
+    libspdm_statistics_record_crypto(spdm_context, LIBSPDM_STATISTICS_CRYPTO_ASYM_VERIFY, start_us);
+#endif /* LIBSPDM_STATISTICS_SUPPORT */
+    LIBSPDM_TRACE_END(spdm_context, LIBSPDM_TRACE_EVENT_ASYM_VERIFY, SPDM_FINISH,
+                      session_info->session_id, 0);
+    if (need_free) {
         libspdm_req_asym_free(spdm_context->connection_info.algorithm.req_base_asym_alg, context);
     }
-#endif
 
     if (!result) {
         LIBSPDM_DEBUG((LIBSPDM_DEBUG_ERROR, "!!! VerifyFinishSignature - FAIL !!!\n"));
@@ -623,6 +611,9 @@ libspdm_return_t libspdm_get_response_finish(libspdm_context_t *spdm_context, si
                                                SPDM_ERROR_CODE_UNSPECIFIED, 0,
                                                response_size, response);
     }
+    #if LIBSPDM_SESSION_PREALLOCATION_SUPPORT
+    libspdm_session_info_new_aead_context(spdm_context, session_info);
+    #endif /* LIBSPDM_SESSION_PREALLOCATION_SUPPORT */
 
     #if LIBSPDM_ENABLE_CAPABILITY_HBEAT_CAP
     if (libspdm_is_capabilities_flag_supported(
@@ -33,12 +33,30 @@ libspdm_return_t libspdm_responder_handle_response_state(libspdm_context_t *spdm
     case LIBSPDM_RESPONSE_STATE_NOT_READY:
         /*do not update ErrorData if a previous request has not been completed*/
         if(request_code != SPDM_RESPOND_IF_READY) {
+#if LIBSPDM_RESPONDER_ASYNC_SIGN_SUPPORT
+            if (!spdm_context->async_sign.submitted &&
+                (spdm_context->async_sign.request_code != 0)) {
+                /* A new request abandons the response waiting for its signature. */
+                libspdm_responder_discard_deferred_response(spdm_context);
+                spdm_context->response_state = LIBSPDM_RESPONSE_STATE_NORMAL;
+                return libspdm_generate_error_response(spdm_context, SPDM_ERROR_CODE_BUSY,
+                                                       0, response_size, response);
+            }
+#endif /* LIBSPDM_RESPONDER_ASYNC_SIGN_SUPPORT */
             spdm_context->cache_spdm_request_size = spdm_context->last_spdm_request_size;
             libspdm_copy_mem(spdm_context->cache_spdm_request,
                              libspdm_get_scratch_buffer_cache_spdm_request_capacity(spdm_context),
                              spdm_context->last_spdm_request,
                              spdm_context->last_spdm_request_size);
+            LIBSPDM_STATISTICS_RECORD_BUFFER(spdm_context, request_code,
+                                             SCRATCH_CACHE_SPDM_REQUEST,
+                                             spdm_context->cache_spdm_request_size);
             spdm_context->error_data.rd_exponent = 1;
+#if LIBSPDM_RESPONDER_ASYNC_SIGN_SUPPORT
+            if (spdm_context->async_sign.submitted) {
+                spdm_context->error_data.rd_exponent = spdm_context->async_sign.rd_exponent;
+            }
+#endif /* LIBSPDM_RESPONDER_ASYNC_SIGN_SUPPORT */
             spdm_context->error_data.rd_tm = 1;
             spdm_context->error_data.request_code = request_code;
             spdm_context->error_data.token = spdm_context->current_token++;
@@ -148,14 +148,14 @@ bool libspdm_generate_key_exchange_rsp_signature(libspdm_context_t *spdm_context
     LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "\n"));
 
 #if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
-    result = libspdm_responder_data_sign(
-        spdm_context->connection_info.version, SPDM_KEY_EXCHANGE_RSP,
+    result = libspdm_responder_data_sign_deferrable(
+        spdm_context, spdm_context->connection_info.version, SPDM_KEY_EXCHANGE_RSP,
         spdm_context->connection_info.algorithm.base_asym_algo,
         spdm_context->connection_info.algorithm.base_hash_algo,
         false, th_curr_data, th_curr_data_size, signature, &signature_size);
 #else
-    result = libspdm_responder_data_sign(
-        spdm_context->connection_info.version, SPDM_KEY_EXCHANGE_RSP,
+    result = libspdm_responder_data_sign_deferrable(
+        spdm_context, spdm_context->connection_info.version, SPDM_KEY_EXCHANGE_RSP,
         spdm_context->connection_info.algorithm.base_asym_algo,
         spdm_context->connection_info.algorithm.base_hash_algo,
         true, hash_data, hash_size, signature, &signature_size);
@@ -168,6 +168,95 @@ bool libspdm_generate_key_exchange_rsp_signature(libspdm_context_t *spdm_context
     return result;
 }
 
+libspdm_return_t libspdm_finalize_response_key_exchange(
+    libspdm_context_t *spdm_context, const spdm_key_exchange_request_t *spdm_request,
+    uint32_t session_id, uint8_t *signature, size_t *response_size, void *response)
+{
+    const spdm_key_exchange_response_t *spdm_response;
+    libspdm_session_info_t *session_info;
+    uint32_t signature_size;
+    uint32_t hmac_size;
+    uint8_t *ptr;
+    bool result;
+    libspdm_return_t status;
+    uint8_t th1_hash_data[LIBSPDM_MAX_HASH_SIZE];
+
+    spdm_response = response;
+    session_info = libspdm_get_session_info_via_session_id(spdm_context, session_id);
+    if (session_info == NULL) {
+        return libspdm_generate_error_response(spdm_context,
+                                               SPDM_ERROR_CODE_UNSPECIFIED, 0,
+                                               response_size, response);
+    }
+
+    signature_size = libspdm_get_asym_signature_size(
+        spdm_context->connection_info.algorithm.base_asym_algo);
+    hmac_size = libspdm_get_hash_size(
+        spdm_context->connection_info.algorithm.base_hash_algo);
+    ptr = signature;
+
+    status = libspdm_append_message_k(spdm_context, session_info, false, ptr, signature_size);
+    if (LIBSPDM_STATUS_IS_ERROR(status)) {
+        libspdm_free_session_id(spdm_context, session_id);
+        return libspdm_generate_error_response(spdm_context,
+                                               SPDM_ERROR_CODE_UNSPECIFIED, 0,
+                                               response_size, response);
+    }
+
+    LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "libspdm_generate_session_handshake_key[%x]\n",
+                   session_id));
+    result = libspdm_calculate_th1_hash(spdm_context, session_info, false,
+                                        th1_hash_data);
+    if (!result) {
+        libspdm_free_session_id(spdm_context, session_id);
+        return libspdm_generate_error_response(spdm_context,
+                                               SPDM_ERROR_CODE_UNSPECIFIED, 0,
+                                               response_size, response);
+    }
+    result = libspdm_generate_session_handshake_key(
+        session_info->secured_message_context, th1_hash_data);
+    if (!result) {
+        libspdm_free_session_id(spdm_context, session_id);
+        return libspdm_generate_error_response(spdm_context,
+                                               SPDM_ERROR_CODE_UNSPECIFIED, 0,
+                                               response_size, response);
+    }
+
+    ptr += signature_size;
+
+    if (!libspdm_is_capabilities_flag_supported(
+            spdm_context, false,
+            SPDM_GET_CAPABILITIES_REQUEST_FLAGS_HANDSHAKE_IN_THE_CLEAR_CAP,
+            SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_HANDSHAKE_IN_THE_CLEAR_CAP)) {
+        result = libspdm_generate_key_exchange_rsp_hmac(spdm_context,
+                                                        session_info, ptr);
+        if (!result) {
+            libspdm_free_session_id(spdm_context, session_id);
+            return libspdm_generate_error_response(
+                spdm_context,
+                SPDM_ERROR_CODE_UNSPECIFIED,
+                0, response_size, response);
+        }
+        status = libspdm_append_message_k(spdm_context, session_info, false, ptr, hmac_size);
+        if (LIBSPDM_STATUS_IS_ERROR(status)) {
+            libspdm_free_session_id(spdm_context, session_id);
+            return libspdm_generate_error_response(
+                spdm_context, SPDM_ERROR_CODE_UNSPECIFIED,
+                0, response_size, response);
+        }
+
+        ptr += hmac_size;
+    }
+
+    session_info->mut_auth_requested = spdm_response->mut_auth_requested;
+    if (spdm_request->header.spdm_version >= SPDM_MESSAGE_VERSION_12) {
+        session_info->session_policy = spdm_request->session_policy;
+    }
+    libspdm_set_session_state(spdm_context, session_id, LIBSPDM_SESSION_STATE_HANDSHAKING);
+
+    return LIBSPDM_STATUS_SUCCESS;
+}
+
 libspdm_return_t libspdm_get_response_key_exchange(libspdm_context_t *spdm_context,
                                                    size_t request_size,
                                                    const void *request,
@@ -193,7 +282,9 @@ libspdm_return_t libspdm_get_response_key_exchange(libspdm_context_t *spdm_conte
     uint16_t rsp_session_id;
     libspdm_return_t status;
     size_t opaque_key_exchange_rsp_size;
-    uint8_t th1_hash_data[LIBSPDM_MAX_HASH_SIZE];
+#if LIBSPDM_STATISTICS_SUPPORT
+    uint64_t start_us;
+#endif /* LIBSPDM_STATISTICS_SUPPORT */
 
     spdm_request = request;
 
@@ -415,27 +506,46 @@ libspdm_return_t libspdm_get_response_key_exchange(libspdm_context_t *spdm_conte
     }
 
     ptr = (void *)(spdm_response + 1);
-    dhe_context = libspdm_secured_message_dhe_new(
-        spdm_context->connection_info.version,
-        spdm_context->connection_info.algorithm.dhe_named_group, false);
+#if LIBSPDM_DHE_KEY_POOL_SUPPORT
+    dhe_context = libspdm_dhe_key_pool_take(
+        spdm_context, spdm_context->connection_info.version,
+        spdm_context->connection_info.algorithm.dhe_named_group, false, ptr, &dhe_key_size);
+#else
+    dhe_context = NULL;
+#endif /* LIBSPDM_DHE_KEY_POOL_SUPPORT */
     if (dhe_context == NULL) {
-        libspdm_free_session_id(spdm_context, session_id);
-        return libspdm_generate_error_response(spdm_context,
-                                               SPDM_ERROR_CODE_UNSPECIFIED, 0,
-                                               response_size, response);
-    }
+        dhe_context = libspdm_secured_message_dhe_new(
+            spdm_context->connection_info.version,
+            spdm_context->connection_info.algorithm.dhe_named_group, false);
+        if (dhe_context == NULL) {
+            libspdm_free_session_id(spdm_context, session_id);
+            return libspdm_generate_error_response(spdm_context,
+                                                   SPDM_ERROR_CODE_UNSPECIFIED, 0,
+                                                   response_size, response);
+        }
 
-    result = libspdm_secured_message_dhe_generate_key(
-        spdm_context->connection_info.algorithm.dhe_named_group,
-        dhe_context, ptr, &dhe_key_size);
-    if (!result) {
-        libspdm_secured_message_dhe_free(
+#if LIBSPDM_STATISTICS_SUPPORT
+        start_us = libspdm_get_timestamp_us();
+#endif /* LIBSPDM_STATISTICS_SUPPORT */
+        LIBSPDM_TRACE_BEGIN(spdm_context, LIBSPDM_TRACE_EVENT_DHE_GENERATE_KEY, SPDM_KEY_EXCHANGE,
+                            session_id, 0);
+        result = libspdm_secured_message_dhe_generate_key(
             spdm_context->connection_info.algorithm.dhe_named_group,
-            dhe_context);
-        libspdm_free_session_id(spdm_context, session_id);
-        return libspdm_generate_error_response(spdm_context,
-                                               SPDM_ERROR_CODE_UNSPECIFIED, 0,
-                                               response_size, response);
+            dhe_context, ptr, &dhe_key_size);
+#if LIBSPDM_STATISTICS_SUPPORT
+        libspdm_statistics_record_crypto(spdm_context, LIBSPDM_STATISTICS_CRYPTO_DHE, start_us);
+#endif /* LIBSPDM_STATISTICS_SUPPORT */
+        LIBSPDM_TRACE_END(spdm_context, LIBSPDM_TRACE_EVENT_DHE_GENERATE_KEY, SPDM_KEY_EXCHANGE,
+                          session_id, result ? dhe_key_size : 0);
+        if (!result) {
+            libspdm_secured_message_dhe_free(
+                spdm_context->connection_info.algorithm.dhe_named_group,
+                dhe_context);
+            libspdm_free_session_id(spdm_context, session_id);
+            return libspdm_generate_error_response(spdm_context,
+                                                   SPDM_ERROR_CODE_UNSPECIFIED, 0,
+                                                   response_size, response);
+        }
     }
     LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "Calc SelfKey (0x%x):\n", dhe_key_size));
     LIBSPDM_INTERNAL_DUMP_HEX(ptr, dhe_key_size);
@@ -445,11 +555,21 @@ libspdm_return_t libspdm_get_response_key_exchange(libspdm_context_t *spdm_conte
                               sizeof(spdm_key_exchange_request_t),
                               dhe_key_size);
 
+#if LIBSPDM_STATISTICS_SUPPORT
+    start_us = libspdm_get_timestamp_us();
+#endif /* LIBSPDM_STATISTICS_SUPPORT */
+    LIBSPDM_TRACE_BEGIN(spdm_context, LIBSPDM_TRACE_EVENT_DHE_COMPUTE_KEY, SPDM_KEY_EXCHANGE,
+                        session_id, dhe_key_size);
     result = libspdm_secured_message_dhe_compute_key(
         spdm_context->connection_info.algorithm.dhe_named_group,
         dhe_context,
         (const uint8_t *)request + sizeof(spdm_key_exchange_request_t),
         dhe_key_size, session_info->secured_message_context);
+#if LIBSPDM_STATISTICS_SUPPORT
+    libspdm_statistics_record_crypto(spdm_context, LIBSPDM_STATISTICS_CRYPTO_DHE, start_us);
+#endif /* LIBSPDM_STATISTICS_SUPPORT */
+    LIBSPDM_TRACE_END(spdm_context, LIBSPDM_TRACE_EVENT_DHE_COMPUTE_KEY, SPDM_KEY_EXCHANGE,
+                      session_id, 0);
     libspdm_secured_message_dhe_free(
         spdm_context->connection_info.algorithm.dhe_named_group,
         dhe_context);
@@ -525,66 +645,16 @@ libspdm_return_t libspdm_get_response_key_exchange(libspdm_context_t *spdm_conte
             0, response_size, response);
     }
 
-    status = libspdm_append_message_k(spdm_context, session_info, false, ptr, signature_size);
-    if (LIBSPDM_STATUS_IS_ERROR(status)) {
-        libspdm_free_session_id(spdm_context, session_id);
-        return libspdm_generate_error_response(spdm_context,
-                                               SPDM_ERROR_CODE_UNSPECIFIED, 0,
-                                               response_size, response);
-    }
-
-    LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "libspdm_generate_session_handshake_key[%x]\n",
-                   session_id));
-    result = libspdm_calculate_th1_hash(spdm_context, session_info, false,
-                                        th1_hash_data);
-    if (!result) {
-        libspdm_free_session_id(spdm_context, session_id);
-        return libspdm_generate_error_response(spdm_context,
-                                               SPDM_ERROR_CODE_UNSPECIFIED, 0,
-                                               response_size, response);
-    }
-    result = libspdm_generate_session_handshake_key(
-        session_info->secured_message_context, th1_hash_data);
-    if (!result) {
-        libspdm_free_session_id(spdm_context, session_id);
-        return libspdm_generate_error_response(spdm_context,
-                                               SPDM_ERROR_CODE_UNSPECIFIED, 0,
-                                               response_size, response);
-    }
-
-    ptr += signature_size;
-
-    if (!libspdm_is_capabilities_flag_supported(
-            spdm_context, false,
-            SPDM_GET_CAPABILITIES_REQUEST_FLAGS_HANDSHAKE_IN_THE_CLEAR_CAP,
-            SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_HANDSHAKE_IN_THE_CLEAR_CAP)) {
-        result = libspdm_generate_key_exchange_rsp_hmac(spdm_context,
-                                                        session_info, ptr);
-        if (!result) {
-            libspdm_free_session_id(spdm_context, session_id);
-            return libspdm_generate_error_response(
-                spdm_context,
-                SPDM_ERROR_CODE_UNSPECIFIED,
-                0, response_size, response);
-        }
-        status = libspdm_append_message_k(spdm_context, session_info, false, ptr, hmac_size);
-        if (LIBSPDM_STATUS_IS_ERROR(status)) {
-            libspdm_free_session_id(spdm_context, session_id);
-            return libspdm_generate_error_response(
-                spdm_context, SPDM_ERROR_CODE_UNSPECIFIED,
-                0, response_size, response);
-        }
-
-        ptr += hmac_size;
-    }
-
-    session_info->mut_auth_requested = spdm_response->mut_auth_requested;
-    if (spdm_request->header.spdm_version >= SPDM_MESSAGE_VERSION_12) {
-        session_info->session_policy = spdm_request->session_policy;
+#if LIBSPDM_RESPONDER_ASYNC_SIGN_SUPPORT
+    if (spdm_context->async_sign.submitted) {
+        return libspdm_responder_defer_response(spdm_context, SPDM_KEY_EXCHANGE, session_id,
+                                                (size_t)ptr - (size_t)spdm_response,
+                                                signature_size, response_size, response);
     }
-    libspdm_set_session_state(spdm_context, session_id, LIBSPDM_SESSION_STATE_HANDSHAKING);
+#endif /* LIBSPDM_RESPONDER_ASYNC_SIGN_SUPPORT */
 
-    return LIBSPDM_STATUS_SUCCESS;
+    return libspdm_finalize_response_key_exchange(spdm_context, spdm_request, session_id, ptr,
+                                                  response_size, response);
 }
 
 #endif /* LIBSPDM_ENABLE_CAPABILITY_KEY_EX_CAP */
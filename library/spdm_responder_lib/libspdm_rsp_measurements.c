@@ -14,21 +14,11 @@ bool libspdm_generate_measurement_signature(libspdm_context_t *spdm_context,
 {
     size_t signature_size;
     bool result;
-#if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
-    libspdm_l1l2_managed_buffer_t l1l2;
-    uint8_t *l1l2_buffer;
-    size_t l1l2_buffer_size;
-#else
     uint8_t l1l2_hash[LIBSPDM_MAX_HASH_SIZE];
     size_t l1l2_hash_size;
-#endif
 
-#if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
-    result = libspdm_calculate_l1l2(spdm_context, session_info, &l1l2);
-#else
     l1l2_hash_size = sizeof(l1l2_hash);
     result = libspdm_calculate_l1l2_hash(spdm_context, session_info, &l1l2_hash_size, l1l2_hash);
-#endif
     libspdm_reset_message_m(spdm_context, session_info);
     if (!result) {
         return false;
@@ -36,22 +26,11 @@ bool libspdm_generate_measurement_signature(libspdm_context_t *spdm_context,
 
     signature_size = libspdm_get_asym_signature_size(
         spdm_context->connection_info.algorithm.base_asym_algo);
-#if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
-    l1l2_buffer = libspdm_get_managed_buffer(&l1l2);
-    l1l2_buffer_size = libspdm_get_managed_buffer_size(&l1l2);
-
-    result = libspdm_responder_data_sign(
-        spdm_context->connection_info.version, SPDM_MEASUREMENTS,
-        spdm_context->connection_info.algorithm.base_asym_algo,
-        spdm_context->connection_info.algorithm.base_hash_algo,
-        false, l1l2_buffer, l1l2_buffer_size, signature, &signature_size);
-#else
-    result = libspdm_responder_data_sign(
-        spdm_context->connection_info.version, SPDM_MEASUREMENTS,
+    result = libspdm_responder_data_sign_deferrable(
+        spdm_context, spdm_context->connection_info.version, SPDM_MEASUREMENTS,
         spdm_context->connection_info.algorithm.base_asym_algo,
         spdm_context->connection_info.algorithm.base_hash_algo,
         true, l1l2_hash, l1l2_hash_size, signature, &signature_size);
-#endif
     return result;
 }
 
@@ -303,6 +282,20 @@ libspdm_return_t libspdm_get_response_measurements(libspdm_context_t *spdm_conte
 
     measurements = (uint8_t*)response + sizeof(spdm_measurements_response_t);
 
+#if LIBSPDM_MEASUREMENT_COLLECTION_EX_SUPPORT
+    status = libspdm_measurement_collection_ex(
+        spdm_context->connection_info.version,
+        spdm_context->connection_info.algorithm.measurement_spec,
+        spdm_context->connection_info.algorithm.measurement_hash_algo,
+        measurements_index,
+        spdm_request->header.param1,
+        &content_changed,
+        &measurements_count,
+        measurements,
+        &measurements_size,
+        (session_info == NULL) ? &spdm_context->transcript.measurement_transcript_state :
+        &session_info->session_transcript.measurement_transcript_state);
+#else
     status = libspdm_measurement_collection(
         spdm_context->connection_info.version,
         spdm_context->connection_info.algorithm.measurement_spec,
@@ -313,6 +306,7 @@ libspdm_return_t libspdm_get_response_measurements(libspdm_context_t *spdm_conte
         &measurements_count,
         measurements,
         &measurements_size);
+#endif /* LIBSPDM_MEASUREMENT_COLLECTION_EX_SUPPORT */
 
     if (LIBSPDM_STATUS_IS_ERROR(status)) {
         if (status == LIBSPDM_STATUS_MEAS_INVALID_INDEX) {
@@ -449,6 +443,13 @@ libspdm_return_t libspdm_get_response_measurements(libspdm_context_t *spdm_conte
         }
         /*reset*/
         libspdm_reset_message_m(spdm_context, session_info);
+#if LIBSPDM_RESPONDER_ASYNC_SIGN_SUPPORT
+        if (spdm_context->async_sign.submitted) {
+            return libspdm_responder_defer_response(spdm_context, SPDM_GET_MEASUREMENTS, 0,
+                                                    spdm_response_size - signature_size,
+                                                    signature_size, response_size, response);
+        }
+#endif /* LIBSPDM_RESPONDER_ASYNC_SIGN_SUPPORT */
     } else {
         status = libspdm_append_message_m(spdm_context, session_info, spdm_response,
                                           *response_size);
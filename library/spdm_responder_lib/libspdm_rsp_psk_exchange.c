@@ -410,6 +410,9 @@ libspdm_return_t libspdm_get_response_psk_exchange(libspdm_context_t *spdm_conte
                 spdm_context, SPDM_ERROR_CODE_UNSPECIFIED,
                 0, response_size, response);
         }
+        #if LIBSPDM_SESSION_PREALLOCATION_SUPPORT
+        libspdm_session_info_new_aead_context(spdm_context, session_info);
+        #endif /* LIBSPDM_SESSION_PREALLOCATION_SUPPORT */
 
         libspdm_set_session_state(spdm_context, session_id, LIBSPDM_SESSION_STATE_ESTABLISHED);
     }
@@ -215,6 +215,9 @@ libspdm_return_t libspdm_get_response_psk_finish(libspdm_context_t *spdm_context
                                                SPDM_ERROR_CODE_UNSPECIFIED, 0,
                                                response_size, response);
     }
+    #if LIBSPDM_SESSION_PREALLOCATION_SUPPORT
+    libspdm_session_info_new_aead_context(spdm_context, session_info);
+    #endif /* LIBSPDM_SESSION_PREALLOCATION_SUPPORT */
 
     #if LIBSPDM_ENABLE_CAPABILITY_HBEAT_CAP
     if (libspdm_is_capabilities_flag_supported(
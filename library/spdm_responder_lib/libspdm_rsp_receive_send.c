@@ -101,6 +101,85 @@ libspdm_get_spdm_response_func libspdm_get_response_func_via_request_code(uint8_
  *
  * @return GET_SPDM_RESPONSE function according to the last request.
  **/
+#if LIBSPDM_ALLOC_SCOPE_SUPPORT
+/**
+ * Return whether the handling of a request is an allocation scope flow.
+ *
+ * @param  request_code  The SPDM request code.
+ **/
+static bool libspdm_is_alloc_scope_flow(uint8_t request_code)
+{
+    return (request_code == SPDM_KEY_EXCHANGE) || (request_code == SPDM_FINISH) ||
+           (request_code == SPDM_PSK_EXCHANGE) || (request_code == SPDM_PSK_FINISH);
+}
+#endif /* LIBSPDM_ALLOC_SCOPE_SUPPORT */
+
+#if LIBSPDM_ENABLE_CAPABILITY_CHUNK_CAP
+/**
+ * Return whether the response to a request may be larger than the DataTransferSize of the
+ * requester or the transmit buffer size of the responder, so that it may need to be chunked.
+ *
+ * Only the handlers whose response has a small fixed format are bounded here. The ERROR
+ * responses they may build instead are smaller than that.
+ *
+ * @param  spdm_context    The SPDM context for the device.
+ * @param  is_app_message  Indicates if it is an APP message or SPDM message.
+ * @param  request_code    The SPDM request code.
+ **/
+static bool libspdm_is_response_chunkable(libspdm_context_t *spdm_context, bool is_app_message,
+                                          uint8_t request_code)
+{
+    size_t transfer_size;
+    size_t max_response_size;
+
+    transfer_size = spdm_context->connection_info.capability.data_transfer_size;
+    if ((spdm_context->local_context.capability.sender_data_transfer_size != 0) &&
+        ((transfer_size == 0) ||
+         (spdm_context->local_context.capability.sender_data_transfer_size < transfer_size))) {
+        transfer_size = spdm_context->local_context.capability.sender_data_transfer_size;
+    }
+    if (transfer_size == 0) {
+        return false;
+    }
+    if (is_app_message) {
+        return true;
+    }
+
+    switch (request_code) {
+    case SPDM_GET_VERSION:
+        max_response_size = sizeof(spdm_version_response_t) +
+                            SPDM_MAX_VERSION_COUNT * sizeof(spdm_version_number_t);
+        break;
+    case SPDM_GET_CAPABILITIES:
+        max_response_size = sizeof(spdm_capabilities_response_t);
+        break;
+    case SPDM_FINISH:
+        max_response_size = sizeof(spdm_finish_response_t) + LIBSPDM_MAX_HASH_SIZE;
+        break;
+    case SPDM_PSK_FINISH:
+        max_response_size = sizeof(spdm_psk_finish_response_t);
+        break;
+    case SPDM_HEARTBEAT:
+        max_response_size = sizeof(spdm_heartbeat_response_t);
+        break;
+    case SPDM_KEY_UPDATE:
+        max_response_size = sizeof(spdm_key_update_response_t);
+        break;
+    case SPDM_END_SESSION:
+        max_response_size = sizeof(spdm_end_session_response_t);
+        break;
+    case SPDM_CHUNK_SEND:
+    case SPDM_CHUNK_GET:
+        /* The large message region holds the large request or the response being chunked. */
+        return false;
+    default:
+        return true;
+    }
+
+    return max_response_size > transfer_size;
+}
+#endif /* LIBSPDM_ENABLE_CAPABILITY_CHUNK_CAP */
+
 static libspdm_get_spdm_response_func libspdm_get_response_func_via_last_request(
     libspdm_context_t *spdm_context)
 {
@@ -146,6 +225,9 @@ libspdm_return_t libspdm_process_request(void *spdm_context, uint32_t **session_
     size_t transport_header_size;
     uint8_t *scratch_buffer;
     size_t scratch_buffer_size;
+    #if LIBSPDM_STATISTICS_SUPPORT
+    uint8_t request_code;
+    #endif /* LIBSPDM_STATISTICS_SUPPORT */
 
     if (request == NULL) {
         return LIBSPDM_STATUS_INVALID_PARAMETER;
@@ -180,10 +262,15 @@ libspdm_return_t libspdm_process_request(void *spdm_context, uint32_t **session_
     backup_decoded_message_ptr = decoded_message_ptr;
     backup_decoded_message_size = decoded_message_size;
 
+    /* The request code is not known before the request is decoded. */
+    LIBSPDM_TRACE_BEGIN(context, LIBSPDM_TRACE_EVENT_TRANSPORT_DECODE, 0, 0, request_size);
     status = context->transport_decode_message(
         context, &message_session_id, is_app_message, true,
         request_size, request, &decoded_message_size,
         (void **)&decoded_message_ptr);
+    LIBSPDM_TRACE_END(context, LIBSPDM_TRACE_EVENT_TRANSPORT_DECODE, 0,
+                      (message_session_id != NULL) ? *message_session_id : 0,
+                      LIBSPDM_STATUS_IS_ERROR(status) ? 0 : decoded_message_size);
 
     reset_key_update = false;
     temp_session_context = NULL;
@@ -215,10 +302,14 @@ libspdm_return_t libspdm_process_request(void *spdm_context, uint32_t **session_
         message_session_id = NULL;
         decoded_message_ptr = backup_decoded_message_ptr;
         decoded_message_size = backup_decoded_message_size;
+        LIBSPDM_TRACE_BEGIN(context, LIBSPDM_TRACE_EVENT_TRANSPORT_DECODE, 0, 0, request_size);
         status = context->transport_decode_message(
             context, &message_session_id, is_app_message, true,
             request_size, request, &decoded_message_size,
             (void **)&decoded_message_ptr);
+        LIBSPDM_TRACE_END(context, LIBSPDM_TRACE_EVENT_TRANSPORT_DECODE, 0,
+                          (message_session_id != NULL) ? *message_session_id : 0,
+                          LIBSPDM_STATUS_IS_ERROR(status) ? 0 : decoded_message_size);
 
         reset_key_update = true;
     }
@@ -284,6 +375,18 @@ libspdm_return_t libspdm_process_request(void *spdm_context, uint32_t **session_
         context->last_spdm_request_session_id_valid = true;
     }
 
+    #if LIBSPDM_STATISTICS_SUPPORT
+    request_code = (*is_app_message) ?
+                   0 : ((spdm_message_header_t *)context->last_spdm_request)->request_response_code;
+    LIBSPDM_STATISTICS_RECORD_BUFFER(context, request_code, RECEIVER, request_size);
+    if (message_session_id != NULL) {
+        LIBSPDM_STATISTICS_RECORD_BUFFER(context, request_code, SCRATCH_SECURE_MESSAGE,
+                                         transport_header_size + decoded_message_size);
+    }
+    LIBSPDM_STATISTICS_RECORD_BUFFER(context, request_code, SCRATCH_LAST_SPDM_REQUEST,
+                                     decoded_message_size);
+    #endif /* LIBSPDM_STATISTICS_SUPPORT */
+
     LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "SpdmReceiveRequest[%x] msg %s(0x%x), size (0x%x): \n",
                    (message_session_id != NULL) ? *message_session_id : 0,
                    libspdm_get_code_str(((spdm_message_header_t *)context->last_spdm_request)->
@@ -414,6 +517,7 @@ libspdm_return_t libspdm_build_response(void *spdm_context, const uint32_t *sess
     libspdm_context_t *context;
     uint8_t *my_response;
     size_t my_response_size;
+    uint8_t *handler_response;
     libspdm_return_t status;
     libspdm_get_spdm_response_func get_response_func;
     libspdm_session_info_t *session_info;
@@ -428,16 +532,29 @@ libspdm_return_t libspdm_build_response(void *spdm_context, const uint32_t *sess
     bool result;
     #endif /* LIBSPDM_ENABLE_CAPABILITY_HBEAT_CAP */
 
+    #if LIBSPDM_ALLOC_SCOPE_SUPPORT
+    bool is_alloc_scope_flow;
+    #endif /* LIBSPDM_ALLOC_SCOPE_SUPPORT */
+
+    #if LIBSPDM_STATISTICS_SUPPORT
+    uint64_t start_us;
+
+    start_us = libspdm_get_timestamp_us();
+    #endif /* LIBSPDM_STATISTICS_SUPPORT */
+
     #if LIBSPDM_ENABLE_CAPABILITY_CHUNK_CAP
     uint8_t *large_buffer;
     size_t large_buffer_size;
     libspdm_chunk_info_t* get_info;
     spdm_chunk_response_response_t *chunk_rsp;
     uint8_t *chunk_ptr;
+    size_t my_response_capacity;
+    bool response_in_large_buffer;
     #endif /* LIBSPDM_ENABLE_CAPABILITY_CHUNK_CAP */
 
     context = spdm_context;
     status = LIBSPDM_STATUS_UNSUPPORTED_CAP;
+    session_info = NULL;
 
     /* For secure message, setup my_response to scratch buffer
      * For non-secure message, setup my_response to sender buffer*/
@@ -507,9 +624,14 @@ libspdm_return_t libspdm_build_response(void *spdm_context, const uint32_t *sess
                        my_response_size));
         LIBSPDM_INTERNAL_DUMP_HEX(my_response, my_response_size);
 
+        LIBSPDM_TRACE_BEGIN(context, LIBSPDM_TRACE_EVENT_TRANSPORT_ENCODE, 0,
+                            (session_id != NULL) ? *session_id : 0, my_response_size);
         status = context->transport_encode_message(
             context, session_id, false, false,
             my_response_size, my_response, response_size, response);
+        LIBSPDM_TRACE_END(context, LIBSPDM_TRACE_EVENT_TRANSPORT_ENCODE, 0,
+                          (session_id != NULL) ? *session_id : 0,
+                          LIBSPDM_STATUS_IS_ERROR(status) ? 0 : *response_size);
         if (LIBSPDM_STATUS_IS_ERROR(status)) {
             LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "transport_encode_message : %p\n", status));
             return status;
@@ -545,7 +667,30 @@ libspdm_return_t libspdm_build_response(void *spdm_context, const uint32_t *sess
         return LIBSPDM_STATUS_INVALID_STATE_LOCAL;
     }
 
+    LIBSPDM_TRACE_BEGIN(context, LIBSPDM_TRACE_EVENT_REQUEST,
+                        is_app_message ? 0 : spdm_request->request_response_code,
+                        (session_id != NULL) ? *session_id : 0, context->last_spdm_request_size);
     get_response_func = NULL;
+    handler_response = my_response;
+    #if LIBSPDM_ENABLE_CAPABILITY_CHUNK_CAP
+    /* A response that may be chunked is built directly in the large message region, so that
+     * CHUNK_GET sends it from there without copying it first. If it turns out not to be chunked
+     * it is copied back, so a response that always fits in one transfer is built in place. */
+    my_response_capacity = my_response_size;
+    response_in_large_buffer = false;
+    if (libspdm_is_response_chunkable(context, is_app_message,
+                                      spdm_request->request_response_code) &&
+        libspdm_is_capabilities_flag_supported(
+            context, false, 0,
+            SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CHUNK_CAP)) {
+        libspdm_get_scratch_buffer(context, (void **)&scratch_buffer, &scratch_buffer_size);
+        handler_response = scratch_buffer +
+                           libspdm_get_scratch_buffer_large_message_offset(context);
+        my_response_size = LIBSPDM_MIN(my_response_size,
+                                       libspdm_get_scratch_buffer_large_message_capacity(context));
+        response_in_large_buffer = true;
+    }
+    #endif /* LIBSPDM_ENABLE_CAPABILITY_CHUNK_CAP */
     if (!is_app_message) {
         get_response_func = libspdm_get_response_func_via_last_request(context);
 
@@ -577,24 +722,47 @@ libspdm_return_t libspdm_build_response(void *spdm_context, const uint32_t *sess
         #endif /* LIBSPDM_ENABLE_CAPABILITY_CHUNK_CAP */
 
         if (get_response_func != NULL) {
+            #if LIBSPDM_ALLOC_SCOPE_SUPPORT
+            is_alloc_scope_flow =
+                libspdm_is_alloc_scope_flow(spdm_request->request_response_code);
+            if (is_alloc_scope_flow) {
+                LIBSPDM_ALLOC_SCOPE(context, LIBSPDM_ALLOC_SCOPE_FLOW_BEGIN,
+                                    spdm_request->request_response_code);
+            }
+            #endif /* LIBSPDM_ALLOC_SCOPE_SUPPORT */
             status = get_response_func(
                 context,
                 context->last_spdm_request_size,
                 context->last_spdm_request,
-                &my_response_size, my_response);
+                &my_response_size, handler_response);
+            #if LIBSPDM_ALLOC_SCOPE_SUPPORT
+            if (is_alloc_scope_flow) {
+                LIBSPDM_ALLOC_SCOPE(context, LIBSPDM_ALLOC_SCOPE_FLOW_END,
+                                    spdm_request->request_response_code);
+            }
+            #endif /* LIBSPDM_ALLOC_SCOPE_SUPPORT */
         }
     }
     if (is_app_message || (get_response_func == NULL)) {
         if (context->get_response_func != NULL) {
+            #if LIBSPDM_ENABLE_CAPABILITY_CHUNK_CAP
+            if (response_in_large_buffer) {
+                libspdm_zero_mem(handler_response, my_response_size);
+            }
+            #endif /* LIBSPDM_ENABLE_CAPABILITY_CHUNK_CAP */
             status = ((libspdm_get_response_func) context->get_response_func)(
                 context, session_id, is_app_message,
                 context->last_spdm_request_size,
                 context->last_spdm_request,
-                &my_response_size, my_response);
+                &my_response_size, handler_response);
         } else {
             status = LIBSPDM_STATUS_UNSUPPORTED_CAP;
         }
     }
+    LIBSPDM_TRACE_END(context, LIBSPDM_TRACE_EVENT_REQUEST,
+                      is_app_message ? 0 : spdm_request->request_response_code,
+                      (session_id != NULL) ? *session_id : 0,
+                      LIBSPDM_STATUS_IS_ERROR(status) ? 0 : my_response_size);
 
     /* large SPDM message is the SPDM message whose size is greater than the DataTransferSize of the receiving
      * SPDM endpoint or greater than the transmit buffer size of the sending SPDM endpoint */
@@ -627,7 +795,7 @@ libspdm_return_t libspdm_build_response(void *spdm_context, const uint32_t *sess
                        libspdm_get_scratch_buffer_large_message_offset(spdm_context);
         large_buffer_size = libspdm_get_scratch_buffer_large_message_capacity(spdm_context);
 
-        if (my_response_size < large_buffer_size) {
+        if (response_in_large_buffer || (my_response_size < large_buffer_size)) {
             get_info->chunk_in_use = true;
             /* Increment chunk_handle here as opposed to end of chunk_get handler
              * in case requester never issues chunk_get. */
@@ -635,14 +803,17 @@ libspdm_return_t libspdm_build_response(void *spdm_context, const uint32_t *sess
             get_info->chunk_seq_no = 0;
             get_info->chunk_bytes_transferred = 0;
 
-            libspdm_zero_mem(large_buffer, large_buffer_size);
-
             /* It's possible that the large response that was to be sent to the requester was
              * a CHUNK_SEND_ACK + non-chunk response. In this case, to prevent chunking within
              * chunking, only send back the actual response, by saving only non-chunk portion
              * in the scratch buffer, used to respond to the next CHUNK_GET request. */
-            if (((spdm_message_header_t*) my_response)
-                ->request_response_code == SPDM_CHUNK_SEND_ACK) {
+            if (response_in_large_buffer) {
+                get_info->large_message = large_buffer;
+                get_info->large_message_size = my_response_size;
+                response_in_large_buffer = false;
+            } else if (((spdm_message_header_t*) my_response)
+                       ->request_response_code == SPDM_CHUNK_SEND_ACK) {
+                libspdm_zero_mem(large_buffer, large_buffer_size);
                 libspdm_copy_mem(large_buffer, large_buffer_size,
                                  my_response + sizeof(spdm_chunk_send_ack_response_t),
                                  my_response_size - sizeof(spdm_chunk_send_ack_response_t));
@@ -651,12 +822,16 @@ libspdm_return_t libspdm_build_response(void *spdm_context, const uint32_t *sess
                 get_info->large_message_size =
                     my_response_size - sizeof(spdm_chunk_send_ack_response_t);
             } else {
+                libspdm_zero_mem(large_buffer, large_buffer_size);
                 libspdm_copy_mem(large_buffer, large_buffer_size,
                                  my_response, my_response_size);
 
                 get_info->large_message = large_buffer;
                 get_info->large_message_size = my_response_size;
             }
+            LIBSPDM_STATISTICS_RECORD_BUFFER(context, spdm_request->request_response_code,
+                                             SCRATCH_LARGE_MESSAGE,
+                                             get_info->large_message_size);
 
             status = libspdm_generate_extended_error_response(context,
                                                               SPDM_ERROR_CODE_LARGE_RESPONSE, 0,
@@ -681,6 +856,13 @@ libspdm_return_t libspdm_build_response(void *spdm_context, const uint32_t *sess
         }
     }
 
+    #if LIBSPDM_ENABLE_CAPABILITY_CHUNK_CAP
+    if (response_in_large_buffer && !LIBSPDM_STATUS_IS_ERROR(status)) {
+        /* The response is not chunked, and it fits in the sender buffer. */
+        libspdm_copy_mem(my_response, my_response_capacity, handler_response, my_response_size);
+    }
+    #endif /* LIBSPDM_ENABLE_CAPABILITY_CHUNK_CAP */
+
     /* if return the status: Responder drop the response
      * just ignore this message
      * return UNSUPPORTED and clear response_size to continue the dispatch without send response.*/
@@ -706,14 +888,43 @@ libspdm_return_t libspdm_build_response(void *spdm_context, const uint32_t *sess
                    my_response_size));
     LIBSPDM_INTERNAL_DUMP_HEX(my_response, my_response_size);
 
+    LIBSPDM_TRACE_BEGIN(context, LIBSPDM_TRACE_EVENT_TRANSPORT_ENCODE,
+                        is_app_message ? 0 : spdm_request->request_response_code,
+                        (session_id != NULL) ? *session_id : 0, my_response_size);
     status = context->transport_encode_message(
         context, session_id, is_app_message, false,
         my_response_size, my_response, response_size, response);
+    LIBSPDM_TRACE_END(context, LIBSPDM_TRACE_EVENT_TRANSPORT_ENCODE,
+                      is_app_message ? 0 : spdm_request->request_response_code,
+                      (session_id != NULL) ? *session_id : 0,
+                      LIBSPDM_STATUS_IS_ERROR(status) ? 0 : *response_size);
     if (LIBSPDM_STATUS_IS_ERROR(status)) {
         LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "transport_encode_message : %p\n", status));
         return status;
     }
 
+    #if LIBSPDM_STATISTICS_SUPPORT
+    LIBSPDM_STATISTICS_RECORD_BUFFER(context,
+                                     is_app_message ? 0 : spdm_request->request_response_code,
+                                     SENDER, *response_size);
+    if (session_id != NULL) {
+        LIBSPDM_STATISTICS_RECORD_BUFFER(context,
+                                         is_app_message ? 0 : spdm_request->request_response_code,
+                                         SCRATCH_SECURE_MESSAGE,
+                                         transport_header_size + my_response_size);
+    }
+
+    /* Record before END_SESSION frees the session below. */
+    libspdm_statistics_record_message(context, session_info, true,
+                                      context->last_spdm_request_size, spdm_request);
+    libspdm_statistics_record_message(context, session_info, false,
+                                      my_response_size, my_response);
+    if (!is_app_message) {
+        libspdm_statistics_record_request(context, session_info,
+                                          spdm_request->request_response_code, start_us);
+    }
+    #endif /* LIBSPDM_STATISTICS_SUPPORT */
+
     request_response_code = spdm_response->request_response_code;
     #if LIBSPDM_ENABLE_CAPABILITY_CHUNK_CAP
     switch (request_response_code) {
@@ -815,6 +1026,23 @@ void libspdm_register_get_response_func(void *context, libspdm_get_response_func
     spdm_context->get_response_func = (void *)get_response_func;
 }
 
+#if LIBSPDM_RESPONDER_ASYNC_SIGN_SUPPORT
+void libspdm_register_responder_data_sign_async_func(
+    void *spdm_context,
+    libspdm_responder_data_sign_submit_func submit_func,
+    libspdm_responder_data_sign_poll_func poll_func)
+{
+    libspdm_context_t *context;
+
+    LIBSPDM_ASSERT(spdm_context != NULL);
+    LIBSPDM_ASSERT((submit_func == NULL) || (poll_func != NULL));
+
+    context = spdm_context;
+    context->async_sign.submit = (void *)submit_func;
+    context->async_sign.poll = (void *)poll_func;
+}
+#endif /* LIBSPDM_RESPONDER_ASYNC_SIGN_SUPPORT */
+
 void libspdm_register_session_state_callback_func(
     void *spdm_context,
     libspdm_session_state_callback_func spdm_session_state_callback)
@@ -25,6 +25,31 @@ libspdm_return_t libspdm_get_response_respond_if_ready(libspdm_context_t *spdm_c
                                                SPDM_ERROR_CODE_VERSION_MISMATCH, 0,
                                                response_size, response);
     }
+#if LIBSPDM_RESPONDER_ASYNC_SIGN_SUPPORT
+    /* The deferred response is returned once the asynchronous signer completes. */
+    if ((spdm_context->response_state == LIBSPDM_RESPONSE_STATE_NOT_READY) &&
+        (spdm_context->async_sign.request_code != 0) &&
+        (request_size >= sizeof(spdm_message_header_t)) &&
+        (spdm_request->param1 == spdm_context->async_sign.request_code) &&
+        (spdm_request->param2 == spdm_context->async_sign.token)) {
+        /* The deferred response is only released in the session of the original request. */
+        if ((spdm_context->last_spdm_request_session_id_valid !=
+             spdm_context->async_sign.request_in_session) ||
+            (spdm_context->async_sign.request_in_session &&
+             (spdm_context->last_spdm_request_session_id !=
+              spdm_context->async_sign.request_session_id))) {
+            return libspdm_generate_error_response(spdm_context,
+                                                   SPDM_ERROR_CODE_INVALID_REQUEST, 0,
+                                                   response_size, response);
+        }
+        libspdm_responder_poll_deferred_response(spdm_context);
+        if (spdm_context->async_sign.signature_ready) {
+            spdm_context->response_state = LIBSPDM_RESPONSE_STATE_NORMAL;
+            return libspdm_responder_complete_deferred_response(spdm_context,
+                                                                response_size, response);
+        }
+    }
+#endif /* LIBSPDM_RESPONDER_ASYNC_SIGN_SUPPORT */
     if (spdm_context->response_state == LIBSPDM_RESPONSE_STATE_NEED_RESYNC ||
         spdm_context->response_state == LIBSPDM_RESPONSE_STATE_NOT_READY) {
         return libspdm_responder_handle_response_state(
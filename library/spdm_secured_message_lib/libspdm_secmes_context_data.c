@@ -31,6 +31,79 @@ void libspdm_secured_message_init_context(void *spdm_secured_message_context)
     libspdm_zero_mem(secured_message_context, sizeof(libspdm_secured_message_context_t));
 }
 
+#if LIBSPDM_SESSION_PREALLOCATION_SUPPORT
+static void libspdm_secured_message_free_one_aead_context(
+    uint16_t aead_cipher_suite, libspdm_session_info_struct_aead_context_t *aead_context)
+{
+    if (aead_context->context != NULL) {
+        libspdm_aead_free(aead_cipher_suite, aead_context->context);
+    }
+    /*zero the key copy for security*/
+    libspdm_zero_mem(aead_context, sizeof(libspdm_session_info_struct_aead_context_t));
+}
+
+/**
+ * Free the AEAD contexts of the data keys of an SPDM secured message context.
+ *
+ * It shall be called before the secured message context is initialized again or discarded.
+ *
+ * @param  spdm_secured_message_context    A pointer to the SPDM secured message context.
+ */
+void libspdm_secured_message_free_aead_context(void *spdm_secured_message_context)
+{
+    libspdm_secured_message_context_t *secured_message_context;
+
+    secured_message_context = spdm_secured_message_context;
+    libspdm_secured_message_free_one_aead_context(secured_message_context->aead_cipher_suite,
+                                                  &secured_message_context->request_data_aead);
+    libspdm_secured_message_free_one_aead_context(secured_message_context->aead_cipher_suite,
+                                                  &secured_message_context->response_data_aead);
+}
+
+/**
+ * Allocate the AEAD context of the request or response data key of an SPDM secured message
+ * context, and set the current data key in it. The previous context of that key is freed.
+ *
+ * A context that cannot be allocated is not an error, the session then encrypts with
+ * libspdm_aead_encryption.
+ *
+ * @param  spdm_secured_message_context    A pointer to the SPDM secured message context.
+ * @param  action                          LIBSPDM_KEY_UPDATE_ACTION_REQUESTER for the request
+ *                                         data key, LIBSPDM_KEY_UPDATE_ACTION_RESPONDER for the
+ *                                         response data key.
+ */
+void libspdm_secured_message_new_aead_context(void *spdm_secured_message_context,
+                                              libspdm_key_update_action_t action)
+{
+    libspdm_secured_message_context_t *secured_message_context;
+    libspdm_session_info_struct_aead_context_t *aead_context;
+    const uint8_t *key;
+
+    secured_message_context = spdm_secured_message_context;
+    if (action == LIBSPDM_KEY_UPDATE_ACTION_REQUESTER) {
+        aead_context = &secured_message_context->request_data_aead;
+        key = secured_message_context->application_secret.request_data_encryption_key;
+    } else {
+        aead_context = &secured_message_context->response_data_aead;
+        key = secured_message_context->application_secret.response_data_encryption_key;
+    }
+
+    libspdm_secured_message_free_one_aead_context(secured_message_context->aead_cipher_suite,
+                                                  aead_context);
+    aead_context->context = libspdm_aead_new(secured_message_context->aead_cipher_suite);
+    if (aead_context->context == NULL) {
+        return;
+    }
+    aead_context->is_key_set = libspdm_aead_set_key(secured_message_context->aead_cipher_suite,
+                                                    aead_context->context, key,
+                                                    secured_message_context->aead_key_size);
+    if (aead_context->is_key_set) {
+        libspdm_copy_mem(aead_context->key, sizeof(aead_context->key),
+                         key, secured_message_context->aead_key_size);
+    }
+}
+#endif /* LIBSPDM_SESSION_PREALLOCATION_SUPPORT */
+
 /**
  * Set use_psk to an SPDM secured message context.
  *
@@ -160,6 +233,25 @@ void libspdm_secured_message_set_psk_hint(void *spdm_secured_message_context,
     }
 }
 
+#if LIBSPDM_TRACE_SUPPORT
+/**
+ * Set the trace function to an SPDM secured message context.
+ *
+ * @param  spdm_secured_message_context    A pointer to the SPDM secured message context.
+ * @param  spdm_context                    A pointer to the SPDM context passed to the function.
+ * @param  trace                           The trace function, or NULL.
+ */
+void libspdm_secured_message_set_trace_func(void *spdm_secured_message_context,
+                                            void *spdm_context, libspdm_trace_func trace)
+{
+    libspdm_secured_message_context_t *secured_message_context;
+
+    secured_message_context = spdm_secured_message_context;
+    secured_message_context->trace = trace;
+    secured_message_context->spdm_context = spdm_context;
+}
+#endif /* LIBSPDM_TRACE_SUPPORT */
+
 /**
  * Import the DHE Secret to an SPDM secured message context.
  *
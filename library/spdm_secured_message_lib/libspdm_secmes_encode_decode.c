@@ -6,26 +6,101 @@
 
 #include "internal/libspdm_secured_message_lib.h"
 
+#if LIBSPDM_SESSION_PREALLOCATION_SUPPORT
 /**
- * Encode an application message to a secured message.
+ * Return the AEAD context of a data key, with the current key set.
  *
- * @param  spdm_secured_message_context    A pointer to the SPDM secured message context.
- * @param  session_id                    The session ID of the SPDM session.
- * @param  is_requester                  Indicates if it is a requester message.
- * @param  app_message_size               size in bytes of the application message data buffer.
- * @param  app_message                   A pointer to a source buffer to store the application message.
- *                                       It shall point to the scratch buffer in spdm_context.
- *                                         Before app_message, there is room for spdm_secured_message_cipher_header_t.
- *                                         After (app_message + app_message_size), there is room for random bytes.
- * @param  secured_message_size           size in bytes of the secured message data buffer.
- * @param  secured_message               A pointer to a destination buffer to store the secured message.
- *                                       It shall point to the acquired sender buffer.
- * @param  spdm_secured_message_callbacks  A pointer to a secured message callback functions structure.
+ * @param  secured_message_context  A pointer to the SPDM secured message context.
+ * @param  aead_context             The AEAD context of the request or response data key.
+ * @param  key                      The current request or response data key.
  *
- * @retval RETURN_SUCCESS               The application message is encoded successfully.
- * @retval RETURN_INVALID_PARAMETER     The message is NULL or the message_size is zero.
+ * @return The AEAD context, or NULL to encrypt with libspdm_aead_encryption.
  **/
-libspdm_return_t libspdm_encode_secured_message(
+static void *libspdm_get_data_aead_context(
+    libspdm_secured_message_context_t *secured_message_context,
+    libspdm_session_info_struct_aead_context_t *aead_context, const uint8_t *key)
+{
+    if (aead_context->context == NULL) {
+        return NULL;
+    }
+    if (aead_context->is_key_set &&
+        libspdm_consttime_is_mem_equal(aead_context->key, key,
+                                       secured_message_context->aead_key_size)) {
+        return aead_context->context;
+    }
+
+    aead_context->is_key_set = libspdm_aead_set_key(secured_message_context->aead_cipher_suite,
+                                                    aead_context->context, key,
+                                                    secured_message_context->aead_key_size);
+    if (!aead_context->is_key_set) {
+        return NULL;
+    }
+    libspdm_copy_mem(aead_context->key, sizeof(aead_context->key),
+                     key, secured_message_context->aead_key_size);
+    return aead_context->context;
+}
+#endif /* LIBSPDM_SESSION_PREALLOCATION_SUPPORT */
+
+/**
+ * Performs the AEAD encryption of a secured message, with the AEAD context of the data key if
+ * there is one.
+ **/
+static bool libspdm_secured_message_aead_encryption(
+    libspdm_secured_message_context_t *secured_message_context, void *aead_context,
+    const uint8_t *key, const uint8_t *salt, const uint8_t *a_data, size_t a_data_size,
+    const uint8_t *data_in, size_t data_in_size, uint8_t *tag_out,
+    uint8_t *data_out, size_t *data_out_size)
+{
+#if LIBSPDM_SESSION_PREALLOCATION_SUPPORT
+    if (aead_context != NULL) {
+        return libspdm_aead_encryption_with_context(
+            secured_message_context->aead_cipher_suite, aead_context,
+            salt, secured_message_context->aead_iv_size, a_data, a_data_size,
+            data_in, data_in_size, tag_out, secured_message_context->aead_tag_size,
+            data_out, data_out_size);
+    }
+#endif /* LIBSPDM_SESSION_PREALLOCATION_SUPPORT */
+    return libspdm_aead_encryption(
+        secured_message_context->secured_message_version,
+        secured_message_context->aead_cipher_suite, key,
+        secured_message_context->aead_key_size, salt,
+        secured_message_context->aead_iv_size, a_data, a_data_size,
+        data_in, data_in_size, tag_out, secured_message_context->aead_tag_size,
+        data_out, data_out_size);
+}
+
+/**
+ * Performs the AEAD decryption of a secured message, with the AEAD context of the data key if
+ * there is one.
+ **/
+static bool libspdm_secured_message_aead_decryption(
+    libspdm_secured_message_context_t *secured_message_context, void *aead_context,
+    const uint8_t *key, const uint8_t *salt, const uint8_t *a_data, size_t a_data_size,
+    const uint8_t *data_in, size_t data_in_size, const uint8_t *tag,
+    uint8_t *data_out, size_t *data_out_size)
+{
+#if LIBSPDM_SESSION_PREALLOCATION_SUPPORT
+    if (aead_context != NULL) {
+        return libspdm_aead_decryption_with_context(
+            secured_message_context->aead_cipher_suite, aead_context,
+            salt, secured_message_context->aead_iv_size, a_data, a_data_size,
+            data_in, data_in_size, tag, secured_message_context->aead_tag_size,
+            data_out, data_out_size);
+    }
+#endif /* LIBSPDM_SESSION_PREALLOCATION_SUPPORT */
+    return libspdm_aead_decryption(
+        secured_message_context->secured_message_version,
+        secured_message_context->aead_cipher_suite, key,
+        secured_message_context->aead_key_size, salt,
+        secured_message_context->aead_iv_size, a_data, a_data_size,
+        data_in, data_in_size, tag, secured_message_context->aead_tag_size,
+        data_out, data_out_size);
+}
+
+/**
+ * Encode an application message to a secured message, see libspdm_encode_secured_message.
+ **/
+static libspdm_return_t libspdm_encode_secured_message_internal(
     void *spdm_secured_message_context, uint32_t session_id,
     bool is_requester, size_t app_message_size,
     void *app_message, size_t *secured_message_size,
@@ -37,8 +112,6 @@ libspdm_return_t libspdm_encode_secured_message(
     size_t plain_text_size;
     size_t cipher_text_size;
     size_t aead_tag_size;
-    size_t aead_key_size;
-    size_t aead_iv_size;
     uint8_t *a_data;
     uint8_t *enc_msg;
     uint8_t *dec_msg;
@@ -50,6 +123,7 @@ libspdm_return_t libspdm_encode_secured_message(
     bool result;
     const uint8_t *key;
     uint8_t *salt;
+    void *aead_context;
     uint64_t sequence_number;
     uint64_t sequence_num_in_header;
     uint64_t data64;
@@ -77,9 +151,8 @@ libspdm_return_t libspdm_encode_secured_message(
                    (session_state == LIBSPDM_SESSION_STATE_ESTABLISHED));
 
     aead_tag_size = secured_message_context->aead_tag_size;
-    aead_key_size = secured_message_context->aead_key_size;
-    aead_iv_size = secured_message_context->aead_iv_size;
 
+    aead_context = NULL;
     switch (session_state) {
     case LIBSPDM_SESSION_STATE_HANDSHAKING:
         if (is_requester) {
@@ -106,6 +179,10 @@ libspdm_return_t libspdm_encode_secured_message(
                    request_data_salt;
             sequence_number = secured_message_context->application_secret
                               .request_data_sequence_number;
+#if LIBSPDM_SESSION_PREALLOCATION_SUPPORT
+            aead_context = libspdm_get_data_aead_context(
+                secured_message_context, &secured_message_context->request_data_aead, key);
+#endif /* LIBSPDM_SESSION_PREALLOCATION_SUPPORT */
         } else {
             key = (const uint8_t *)secured_message_context->application_secret.
                   response_data_encryption_key;
@@ -113,6 +190,10 @@ libspdm_return_t libspdm_encode_secured_message(
                    response_data_salt;
             sequence_number = secured_message_context->application_secret
                               .response_data_sequence_number;
+#if LIBSPDM_SESSION_PREALLOCATION_SUPPORT
+            aead_context = libspdm_get_data_aead_context(
+                secured_message_context, &secured_message_context->response_data_aead, key);
+#endif /* LIBSPDM_SESSION_PREALLOCATION_SUPPORT */
         }
         break;
     default:
@@ -214,12 +295,14 @@ libspdm_return_t libspdm_encode_secured_message(
         tag = (uint8_t *)record_header1 + record_header_size +
               cipher_text_size;
 
-        result = libspdm_aead_encryption(
-            secured_message_context->secured_message_version,
-            secured_message_context->aead_cipher_suite, key,
-            aead_key_size, salt, aead_iv_size, (uint8_t *)a_data,
-            record_header_size, dec_msg, cipher_text_size, tag,
-            aead_tag_size, enc_msg, &cipher_text_size);
+        LIBSPDM_SECURED_MESSAGE_TRACE(secured_message_context, LIBSPDM_TRACE_EVENT_AEAD_ENCRYPT,
+                                      LIBSPDM_TRACE_PHASE_BEGIN, session_id, cipher_text_size);
+        result = libspdm_secured_message_aead_encryption(
+            secured_message_context, aead_context, key, salt, (uint8_t *)a_data,
+            record_header_size, dec_msg, cipher_text_size, tag, enc_msg, &cipher_text_size);
+        LIBSPDM_SECURED_MESSAGE_TRACE(secured_message_context, LIBSPDM_TRACE_EVENT_AEAD_ENCRYPT,
+                                      LIBSPDM_TRACE_PHASE_END, session_id,
+                                      result ? cipher_text_size + aead_tag_size : 0);
         break;
 
     case LIBSPDM_SESSION_TYPE_MAC_ONLY:
@@ -245,19 +328,24 @@ libspdm_return_t libspdm_encode_secured_message(
                          sequence_num_in_header_size);
         record_header2->length =
             (uint16_t)(app_message_size + aead_tag_size);
-        libspdm_copy_mem(record_header2 + 1,
-                         *secured_message_size
-                         - ((uint8_t*)(record_header2 + 1) - (uint8_t*)secured_message),
-                         app_message, app_message_size);
+        if ((uint8_t *)(record_header2 + 1) != (uint8_t *)app_message) {
+            libspdm_copy_mem(record_header2 + 1,
+                             *secured_message_size
+                             - ((uint8_t*)(record_header2 + 1) - (uint8_t*)secured_message),
+                             app_message, app_message_size);
+        }
         a_data = (uint8_t *)record_header1;
         tag = (uint8_t *)record_header1 + record_header_size + app_message_size;
 
-        result = libspdm_aead_encryption(
-            secured_message_context->secured_message_version,
-            secured_message_context->aead_cipher_suite, key,
-            aead_key_size, salt, aead_iv_size, (uint8_t *)a_data,
-            record_header_size + app_message_size, NULL, 0, tag,
-            aead_tag_size, NULL, NULL);
+        LIBSPDM_SECURED_MESSAGE_TRACE(secured_message_context, LIBSPDM_TRACE_EVENT_AEAD_ENCRYPT,
+                                      LIBSPDM_TRACE_PHASE_BEGIN, session_id,
+                                      record_header_size + app_message_size);
+        result = libspdm_secured_message_aead_encryption(
+            secured_message_context, aead_context, key, salt, (uint8_t *)a_data,
+            record_header_size + app_message_size, NULL, 0, tag, NULL, NULL);
+        LIBSPDM_SECURED_MESSAGE_TRACE(secured_message_context, LIBSPDM_TRACE_EVENT_AEAD_ENCRYPT,
+                                      LIBSPDM_TRACE_PHASE_END, session_id,
+                                      result ? aead_tag_size : 0);
         break;
 
     default:
@@ -271,26 +359,9 @@ libspdm_return_t libspdm_encode_secured_message(
 }
 
 /**
- * Decode an application message from a secured message.
- *
- * @param  spdm_secured_message_context    A pointer to the SPDM secured message context.
- * @param  session_id                    The session ID of the SPDM session.
- * @param  is_requester                  Indicates if it is a requester message.
- * @param  secured_message_size           size in bytes of the secured message data buffer.
- * @param  secured_message               A pointer to a source buffer to store the secured message.
- *                                       It shall point to the acquired receiver buffer.
- * @param  app_message_size               size in bytes of the application message data buffer.
- * @param  app_message                   A pointer to a destination buffer to store the application message.
- *                                       It shall point to the scratch buffer in spdm_context.
- *                                       On input, the app_message pointer shall point to a big enough buffer to hold the decrypted message
- *                                       On output, the app_message pointer shall be inside of [app_message, app_message + app_message_size]
- * @param  spdm_secured_message_callbacks  A pointer to a secured message callback functions structure.
- *
- * @retval RETURN_SUCCESS               The application message is decoded successfully.
- * @retval RETURN_INVALID_PARAMETER     The message is NULL or the message_size is zero.
- * @retval RETURN_UNSUPPORTED           The secured_message is unsupported.
+ * Decode an application message from a secured message, see libspdm_decode_secured_message.
  **/
-libspdm_return_t libspdm_decode_secured_message(
+static libspdm_return_t libspdm_decode_secured_message_internal(
     void *spdm_secured_message_context, uint32_t session_id,
     bool is_requester, size_t secured_message_size,
     void *secured_message, size_t *app_message_size,
@@ -301,8 +372,6 @@ libspdm_return_t libspdm_decode_secured_message(
     size_t plain_text_size;
     size_t cipher_text_size;
     size_t aead_tag_size;
-    size_t aead_key_size;
-    size_t aead_iv_size;
     const uint8_t *a_data;
     const uint8_t *enc_msg;
     uint8_t *dec_msg;
@@ -314,6 +383,7 @@ libspdm_return_t libspdm_decode_secured_message(
     bool result;
     const uint8_t *key;
     uint8_t *salt;
+    void *aead_context;
     uint64_t sequence_number;
     uint64_t sequence_num_in_header;
     uint64_t data64;
@@ -347,9 +417,8 @@ libspdm_return_t libspdm_decode_secured_message(
                    (session_state == LIBSPDM_SESSION_STATE_ESTABLISHED));
 
     aead_tag_size = secured_message_context->aead_tag_size;
-    aead_key_size = secured_message_context->aead_key_size;
-    aead_iv_size = secured_message_context->aead_iv_size;
 
+    aead_context = NULL;
     switch (session_state) {
     case LIBSPDM_SESSION_STATE_HANDSHAKING:
         if (is_requester) {
@@ -376,6 +445,10 @@ libspdm_return_t libspdm_decode_secured_message(
                    request_data_salt;
             sequence_number =
                 secured_message_context->application_secret.request_data_sequence_number;
+#if LIBSPDM_SESSION_PREALLOCATION_SUPPORT
+            aead_context = libspdm_get_data_aead_context(
+                secured_message_context, &secured_message_context->request_data_aead, key);
+#endif /* LIBSPDM_SESSION_PREALLOCATION_SUPPORT */
         } else {
             key = (const uint8_t *)secured_message_context->application_secret.
                   response_data_encryption_key;
@@ -383,6 +456,10 @@ libspdm_return_t libspdm_decode_secured_message(
                    response_data_salt;
             sequence_number =
                 secured_message_context->application_secret.response_data_sequence_number;
+#if LIBSPDM_SESSION_PREALLOCATION_SUPPORT
+            aead_context = libspdm_get_data_aead_context(
+                secured_message_context, &secured_message_context->response_data_aead, key);
+#endif /* LIBSPDM_SESSION_PREALLOCATION_SUPPORT */
         }
         break;
     default:
@@ -476,12 +553,15 @@ libspdm_return_t libspdm_decode_secured_message(
         dec_msg = (uint8_t *)*app_message;
         enc_msg_header = (void *)dec_msg;
         tag = (const uint8_t *)record_header1 + record_header_size + cipher_text_size;
-        result = libspdm_aead_decryption(
-            secured_message_context->secured_message_version,
-            secured_message_context->aead_cipher_suite, key,
-            aead_key_size, salt, aead_iv_size, a_data,
-            record_header_size, enc_msg, cipher_text_size, tag,
-            aead_tag_size, dec_msg, &cipher_text_size);
+        LIBSPDM_SECURED_MESSAGE_TRACE(secured_message_context, LIBSPDM_TRACE_EVENT_AEAD_DECRYPT,
+                                      LIBSPDM_TRACE_PHASE_BEGIN, session_id,
+                                      cipher_text_size + aead_tag_size);
+        result = libspdm_secured_message_aead_decryption(
+            secured_message_context, aead_context, key, salt, a_data,
+            record_header_size, enc_msg, cipher_text_size, tag, dec_msg, &cipher_text_size);
+        LIBSPDM_SECURED_MESSAGE_TRACE(secured_message_context, LIBSPDM_TRACE_EVENT_AEAD_DECRYPT,
+                                      LIBSPDM_TRACE_PHASE_END, session_id,
+                                      result ? cipher_text_size : 0);
         if (!result) {
             /* Backup keys are valid, fail and alert rollback and retry is possible. */
             if ((is_requester && secured_message_context->requester_backup_valid) ||
@@ -541,13 +621,15 @@ libspdm_return_t libspdm_decode_secured_message(
         a_data = (uint8_t *)record_header1;
         tag = (uint8_t *)record_header1 + record_header_size +
               record_header2->length - aead_tag_size;
-        result = libspdm_aead_decryption(
-            secured_message_context->secured_message_version,
-            secured_message_context->aead_cipher_suite, key,
-            aead_key_size, salt, aead_iv_size, a_data,
-            record_header_size + record_header2->length -
-            aead_tag_size,
-            NULL, 0, tag, aead_tag_size, NULL, NULL);
+        LIBSPDM_SECURED_MESSAGE_TRACE(secured_message_context, LIBSPDM_TRACE_EVENT_AEAD_DECRYPT,
+                                      LIBSPDM_TRACE_PHASE_BEGIN, session_id,
+                                      record_header_size + record_header2->length);
+        result = libspdm_secured_message_aead_decryption(
+            secured_message_context, aead_context, key, salt, a_data,
+            record_header_size + record_header2->length - aead_tag_size,
+            NULL, 0, tag, NULL, NULL);
+        LIBSPDM_SECURED_MESSAGE_TRACE(secured_message_context, LIBSPDM_TRACE_EVENT_AEAD_DECRYPT,
+                                      LIBSPDM_TRACE_PHASE_END, session_id, 0);
         if (!result) {
             /* Backup keys are valid, fail and alert rollback and retry is possible. */
             if ((is_requester && secured_message_context->requester_backup_valid) ||
@@ -573,3 +655,135 @@ libspdm_return_t libspdm_decode_secured_message(
 
     return LIBSPDM_STATUS_SUCCESS;
 }
+
+/**
+ * Return the size of the secured message in front of the application message.
+ *
+ * @param  spdm_secured_message_context    A pointer to the SPDM secured message context.
+ * @param  spdm_secured_message_callbacks  A pointer to a secured message callback functions structure.
+ *
+ * @return the size in bytes of the secured message header.
+ **/
+size_t libspdm_get_secured_message_header_size(
+    void *spdm_secured_message_context,
+    const libspdm_secured_message_callbacks_t *spdm_secured_message_callbacks)
+{
+    libspdm_secured_message_context_t *secured_message_context;
+    uint64_t sequence_num_in_header;
+    uint8_t sequence_num_in_header_size;
+    size_t header_size;
+
+    secured_message_context = spdm_secured_message_context;
+    sequence_num_in_header = 0;
+    sequence_num_in_header_size = spdm_secured_message_callbacks->get_sequence_number(
+        0, (uint8_t *)&sequence_num_in_header);
+    header_size = sizeof(spdm_secured_message_a_data_header1_t) +
+                  sequence_num_in_header_size +
+                  sizeof(spdm_secured_message_a_data_header2_t);
+    if (secured_message_context->session_type == LIBSPDM_SESSION_TYPE_ENC_MAC) {
+        header_size += sizeof(spdm_secured_message_cipher_header_t);
+    }
+    return header_size;
+}
+
+/**
+ * Encode an application message to a secured message.
+ *
+ * @param  spdm_secured_message_context    A pointer to the SPDM secured message context.
+ * @param  session_id                    The session ID of the SPDM session.
+ * @param  is_requester                  Indicates if it is a requester message.
+ * @param  app_message_size               size in bytes of the application message data buffer.
+ * @param  app_message                   A pointer to a source buffer to store the application message.
+ *                                       It shall point to the scratch buffer in spdm_context,
+ *                                       or to secured_message + libspdm_get_secured_message_header_size()
+ *                                       to encode the application message in place.
+ *                                         Before app_message, there is room for spdm_secured_message_cipher_header_t.
+ *                                         After (app_message + app_message_size), there is room for random bytes.
+ * @param  secured_message_size           size in bytes of the secured message data buffer.
+ * @param  secured_message               A pointer to a destination buffer to store the secured message.
+ *                                       It shall point to the acquired sender buffer.
+ * @param  spdm_secured_message_callbacks  A pointer to a secured message callback functions structure.
+ *
+ * @retval RETURN_SUCCESS               The application message is encoded successfully.
+ * @retval RETURN_INVALID_PARAMETER     The message is NULL or the message_size is zero.
+ **/
+libspdm_return_t libspdm_encode_secured_message(
+    void *spdm_secured_message_context, uint32_t session_id,
+    bool is_requester, size_t app_message_size,
+    void *app_message, size_t *secured_message_size,
+    void *secured_message,
+    const libspdm_secured_message_callbacks_t *spdm_secured_message_callbacks)
+{
+#if LIBSPDM_STATISTICS_SUPPORT
+    libspdm_secured_message_context_t *secured_message_context;
+    uint64_t start_us;
+    libspdm_return_t status;
+
+    secured_message_context = spdm_secured_message_context;
+    start_us = libspdm_get_timestamp_us();
+    status = libspdm_encode_secured_message_internal(
+        spdm_secured_message_context, session_id, is_requester, app_message_size, app_message,
+        secured_message_size, secured_message, spdm_secured_message_callbacks);
+    libspdm_statistics_add_latency(&secured_message_context->aead, start_us);
+    if (LIBSPDM_STATUS_IS_SUCCESS(status)) {
+        secured_message_context->secured_message_encoded++;
+    }
+    return status;
+#else
+    return libspdm_encode_secured_message_internal(
+        spdm_secured_message_context, session_id, is_requester, app_message_size, app_message,
+        secured_message_size, secured_message, spdm_secured_message_callbacks);
+#endif /* LIBSPDM_STATISTICS_SUPPORT */
+}
+
+/**
+ * Decode an application message from a secured message.
+ *
+ * @param  spdm_secured_message_context    A pointer to the SPDM secured message context.
+ * @param  session_id                    The session ID of the SPDM session.
+ * @param  is_requester                  Indicates if it is a requester message.
+ * @param  secured_message_size           size in bytes of the secured message data buffer.
+ * @param  secured_message               A pointer to a source buffer to store the secured message.
+ *                                       It shall point to the acquired receiver buffer.
+ * @param  app_message_size               size in bytes of the application message data buffer.
+ * @param  app_message                   A pointer to a destination buffer to store the application message.
+ *                                       It shall point to the scratch buffer in spdm_context.
+ *                                       On input, the app_message pointer shall point to a big enough buffer to hold the decrypted message
+ *                                       On output, the app_message pointer shall be inside of [app_message, app_message + app_message_size]
+ * @param  spdm_secured_message_callbacks  A pointer to a secured message callback functions structure.
+ *
+ * @retval RETURN_SUCCESS               The application message is decoded successfully.
+ * @retval RETURN_INVALID_PARAMETER     The message is NULL or the message_size is zero.
+ * @retval RETURN_UNSUPPORTED           The secured_message is unsupported.
+ **/
+libspdm_return_t libspdm_decode_secured_message(
+    void *spdm_secured_message_context, uint32_t session_id,
+    bool is_requester, size_t secured_message_size,
+    void *secured_message, size_t *app_message_size,
+    void **app_message,
+    const libspdm_secured_message_callbacks_t *spdm_secured_message_callbacks)
+{
+#if LIBSPDM_STATISTICS_SUPPORT
+    libspdm_secured_message_context_t *secured_message_context;
+    uint64_t start_us;
+    libspdm_return_t status;
+
+    secured_message_context = spdm_secured_message_context;
+    start_us = libspdm_get_timestamp_us();
+    status = libspdm_decode_secured_message_internal(
+        spdm_secured_message_context, session_id, is_requester, secured_message_size,
+        secured_message, app_message_size, app_message, spdm_secured_message_callbacks);
+    libspdm_statistics_add_latency(&secured_message_context->aead, start_us);
+    if (LIBSPDM_STATUS_IS_SUCCESS(status)) {
+        secured_message_context->secured_message_decoded++;
+    } else if ((status == LIBSPDM_STATUS_CRYPTO_ERROR) ||
+               (status == LIBSPDM_STATUS_SESSION_TRY_DISCARD_KEY_UPDATE)) {
+        secured_message_context->decrypt_failure++;
+    }
+    return status;
+#else
+    return libspdm_decode_secured_message_internal(
+        spdm_secured_message_context, session_id, is_requester, secured_message_size,
+        secured_message, app_message_size, app_message, spdm_secured_message_callbacks);
+#endif /* LIBSPDM_STATISTICS_SUPPORT */
+}
@@ -643,6 +643,11 @@ bool libspdm_create_update_session_data_key(void *spdm_secured_message_context,
             return status;
         }
         secured_message_context->application_secret.request_data_sequence_number = 0;
+#if LIBSPDM_SESSION_PREALLOCATION_SUPPORT
+        /* Key the new context here, so that the first message with the new key does not. */
+        libspdm_secured_message_new_aead_context(secured_message_context,
+                                                 LIBSPDM_KEY_UPDATE_ACTION_REQUESTER);
+#endif /* LIBSPDM_SESSION_PREALLOCATION_SUPPORT */
 
         secured_message_context->requester_backup_valid = true;
     } else if (action == LIBSPDM_KEY_UPDATE_ACTION_RESPONDER) {
@@ -695,6 +700,11 @@ bool libspdm_create_update_session_data_key(void *spdm_secured_message_context,
             return status;
         }
         secured_message_context->application_secret.response_data_sequence_number = 0;
+#if LIBSPDM_SESSION_PREALLOCATION_SUPPORT
+        /* Key the new context here, so that the first message with the new key does not. */
+        libspdm_secured_message_new_aead_context(secured_message_context,
+                                                 LIBSPDM_KEY_UPDATE_ACTION_RESPONDER);
+#endif /* LIBSPDM_SESSION_PREALLOCATION_SUPPORT */
 
         secured_message_context->responder_backup_valid = true;
     } else {
@@ -961,12 +971,26 @@ bool libspdm_hmac_all_with_request_finished_key(void *spdm_secured_message_conte
                                                 uint8_t *hmac_value)
 {
     libspdm_secured_message_context_t *secured_message_context;
+#if LIBSPDM_STATISTICS_SUPPORT
+    uint64_t start_us;
+    bool result;
+#endif /* LIBSPDM_STATISTICS_SUPPORT */
 
     secured_message_context = spdm_secured_message_context;
+#if LIBSPDM_STATISTICS_SUPPORT
+    start_us = libspdm_get_timestamp_us();
+    result = libspdm_hmac_all(
+        secured_message_context->base_hash_algo, data, data_size,
+        secured_message_context->handshake_secret.request_finished_key,
+        secured_message_context->hash_size, hmac_value);
+    libspdm_statistics_add_latency(&secured_message_context->hmac, start_us);
+    return result;
+#else
     return libspdm_hmac_all(
         secured_message_context->base_hash_algo, data, data_size,
         secured_message_context->handshake_secret.request_finished_key,
         secured_message_context->hash_size, hmac_value);
+#endif /* LIBSPDM_STATISTICS_SUPPORT */
 }
 
 /**
@@ -1099,10 +1123,24 @@ bool libspdm_hmac_all_with_response_finished_key(
     size_t data_size, uint8_t *hmac_value)
 {
     libspdm_secured_message_context_t *secured_message_context;
+#if LIBSPDM_STATISTICS_SUPPORT
+    uint64_t start_us;
+    bool result;
+#endif /* LIBSPDM_STATISTICS_SUPPORT */
 
     secured_message_context = spdm_secured_message_context;
+#if LIBSPDM_STATISTICS_SUPPORT
+    start_us = libspdm_get_timestamp_us();
+    result = libspdm_hmac_all(
+        secured_message_context->base_hash_algo, data, data_size,
+        secured_message_context->handshake_secret.response_finished_key,
+        secured_message_context->hash_size, hmac_value);
+    libspdm_statistics_add_latency(&secured_message_context->hmac, start_us);
+    return result;
+#else
     return libspdm_hmac_all(
         secured_message_context->base_hash_algo, data, data_size,
         secured_message_context->handshake_secret.response_finished_key,
         secured_message_context->hash_size, hmac_value);
+#endif /* LIBSPDM_STATISTICS_SUPPORT */
 }
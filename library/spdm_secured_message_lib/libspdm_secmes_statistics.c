@@ -0,0 +1,77 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2021-2022 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+#include "internal/libspdm_secured_message_lib.h"
+
+#if LIBSPDM_STATISTICS_SUPPORT
+
+void libspdm_statistics_add_latency(libspdm_latency_statistics_t *latency, uint64_t start_us)
+{
+    uint64_t now_us;
+
+    now_us = libspdm_get_timestamp_us();
+    libspdm_statistics_add_duration(latency, (now_us > start_us) ? (now_us - start_us) : 0);
+}
+
+void libspdm_statistics_add_duration(libspdm_latency_statistics_t *latency, uint64_t elapsed_us)
+{
+    size_t bucket;
+
+    if ((latency->count == 0) || (elapsed_us < latency->min_us)) {
+        latency->min_us = elapsed_us;
+    }
+    if (elapsed_us > latency->max_us) {
+        latency->max_us = elapsed_us;
+    }
+    latency->count++;
+    latency->total_us += elapsed_us;
+
+    /* The bucket is the bit length of the duration. */
+    bucket = 0;
+    while ((elapsed_us != 0) && (bucket < LIBSPDM_STATISTICS_HISTOGRAM_SIZE - 1)) {
+        elapsed_us >>= 1;
+        bucket++;
+    }
+    latency->histogram[bucket]++;
+}
+
+void libspdm_statistics_merge_latency(libspdm_latency_statistics_t *latency,
+                                      const libspdm_latency_statistics_t *other)
+{
+    size_t index;
+
+    if (other->count == 0) {
+        return;
+    }
+    if ((latency->count == 0) || (other->min_us < latency->min_us)) {
+        latency->min_us = other->min_us;
+    }
+    if (other->max_us > latency->max_us) {
+        latency->max_us = other->max_us;
+    }
+    latency->count += other->count;
+    latency->total_us += other->total_us;
+    for (index = 0; index < LIBSPDM_STATISTICS_HISTOGRAM_SIZE; index++) {
+        latency->histogram[index] += other->histogram[index];
+    }
+}
+
+void libspdm_secured_message_merge_statistics(const void *spdm_secured_message_context,
+                                              libspdm_statistics_t *statistics)
+{
+    const libspdm_secured_message_context_t *secured_message_context;
+
+    secured_message_context = spdm_secured_message_context;
+    statistics->secured_message_encoded += secured_message_context->secured_message_encoded;
+    statistics->secured_message_decoded += secured_message_context->secured_message_decoded;
+    statistics->decrypt_failure += secured_message_context->decrypt_failure;
+    libspdm_statistics_merge_latency(&statistics->crypto[LIBSPDM_STATISTICS_CRYPTO_AEAD],
+                                     &secured_message_context->aead);
+    libspdm_statistics_merge_latency(&statistics->crypto[LIBSPDM_STATISTICS_CRYPTO_HMAC],
+                                     &secured_message_context->hmac);
+}
+
+#endif /* LIBSPDM_STATISTICS_SUPPORT */
@@ -6,6 +6,7 @@
 
 #include "library/spdm_transport_mctp_lib.h"
 #include "library/spdm_secured_message_lib.h"
+#include "industry_standard/mctp.h"
 #include "hal/library/debuglib.h"
 
 /**
@@ -67,7 +68,8 @@ libspdm_return_t libspdm_mctp_decode_message(uint32_t **session_id,
  * @param  message_size                  size in bytes of the message data buffer.
  * @param  message                      A pointer to a source buffer to store the message.
  *                                      For normal message, it shall point to the acquired sender buffer.
- *                                      For secured message, it shall point to the scratch buffer in spdm_context.
+ *                                      For secured message, it shall point to the scratch buffer in spdm_context,
+ *                                      or to the transport header size in the sender buffer to be encoded in place.
  * @param  transport_message_size         size in bytes of the transport message data buffer.
  * @param  transport_message             A pointer to a destination buffer to store the transport message.
  *                                      On input, it shall be msg_buf_ptr from sender buffer.
@@ -131,9 +133,18 @@ libspdm_return_t libspdm_transport_mctp_encode_message(
             app_message = (void *)message;
             app_message_size = message_size;
         }
-        /* APP message to secured message*/
-        secured_message = (uint8_t *)*transport_message + transport_header_size;
-        secured_message_size = *transport_message_size - transport_header_size;
+        /* APP message to secured message.
+         * If the SPDM message is at the transport header size in the sender buffer, the secured
+         * message is encoded in place around it. Otherwise it follows the MCTP header. */
+        if ((uint8_t *)message == (uint8_t *)*transport_message + transport_header_size) {
+            secured_message = (uint8_t *)app_message -
+                              libspdm_get_secured_message_header_size(
+                secured_message_context, &spdm_secured_message_callbacks);
+        } else {
+            secured_message = (uint8_t *)*transport_message + sizeof(mctp_message_header_t);
+        }
+        secured_message_size = (uint8_t *)*transport_message + *transport_message_size -
+                               secured_message;
         status = libspdm_encode_secured_message(
             secured_message_context, *session_id, is_requester,
             app_message_size, app_message, &secured_message_size,
@@ -0,0 +1,284 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2021-2022 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+#include "library/spdm_transport_mctp_lib.h"
+#include "industry_standard/mctp.h"
+#include "hal/library/debuglib.h"
+#include "hal/library/memlib.h"
+
+#define LIBSPDM_MCTP_PACKET_SEQUENCE_NUMBER_COUNT 4
+
+/**
+ * Return the number of MCTP packets needed to send a message.
+ *
+ * @param  transmission_unit  The packet payload size.
+ * @param  message_size       The size in bytes of the message, including the MCTP message type.
+ *
+ * @return the number of packets. 0 if transmission_unit or message_size is zero.
+ **/
+size_t libspdm_mctp_get_packet_count(size_t transmission_unit, size_t message_size)
+{
+    if ((transmission_unit == 0) || (message_size == 0)) {
+        return 0;
+    }
+    return (message_size + transmission_unit - 1) / transmission_unit;
+}
+
+/**
+ * Split an MCTP message into packets of transmission_unit bytes of payload.
+ *
+ * @param  destination_id     The destination EID.
+ * @param  source_id          The source EID.
+ * @param  message_tag        The message tag, optionally with MCTP_MESSAGE_TAG_OWNER.
+ * @param  transmission_unit  The packet payload size. At least MCTP_BASELINE_TRANSMISSION_UNIT.
+ * @param  message_size       The size in bytes of the message.
+ * @param  message            A pointer to the message.
+ * @param  packet_count       On input, the number of entries in packet.
+ *                            On output, the number of packets of the message.
+ * @param  packet             The packets of the message.
+ *
+ * @retval LIBSPDM_STATUS_SUCCESS            The message is split into *packet_count packets.
+ * @retval LIBSPDM_STATUS_INVALID_PARAMETER  A parameter is out of range.
+ * @retval LIBSPDM_STATUS_BUFFER_TOO_SMALL   packet has fewer than *packet_count entries.
+ **/
+libspdm_return_t libspdm_mctp_packetize_message(
+    uint8_t destination_id, uint8_t source_id, uint8_t message_tag,
+    size_t transmission_unit, size_t message_size, const void *message,
+    size_t *packet_count, libspdm_mctp_packet_t *packet)
+{
+    size_t count;
+    size_t index;
+    size_t offset;
+    uint8_t flags;
+
+    if ((transmission_unit < MCTP_BASELINE_TRANSMISSION_UNIT) || (message_size == 0) ||
+        (message == NULL) ||
+        ((message_tag & ~(MCTP_MESSAGE_TAG_MASK | MCTP_MESSAGE_TAG_OWNER)) != 0)) {
+        return LIBSPDM_STATUS_INVALID_PARAMETER;
+    }
+
+    count = libspdm_mctp_get_packet_count(transmission_unit, message_size);
+    if (*packet_count < count) {
+        *packet_count = count;
+        return LIBSPDM_STATUS_BUFFER_TOO_SMALL;
+    }
+
+    offset = 0;
+    for (index = 0; index < count; index++) {
+        flags = message_tag |
+                (uint8_t)((index % LIBSPDM_MCTP_PACKET_SEQUENCE_NUMBER_COUNT) <<
+                          MCTP_PACKET_SEQUENCE_NUMBER_SHIFT);
+        if (index == 0) {
+            flags |= MCTP_START_OF_MESSAGE;
+        }
+        if (index == count - 1) {
+            flags |= MCTP_END_OF_MESSAGE;
+        }
+        packet[index].header.header_version = MCTP_HEADER_VERSION;
+        packet[index].header.destination_id = destination_id;
+        packet[index].header.source_id = source_id;
+        packet[index].header.message_tag = flags;
+        packet[index].payload = (const uint8_t *)message + offset;
+        packet[index].payload_size = LIBSPDM_MIN(transmission_unit, message_size - offset);
+        offset += packet[index].payload_size;
+    }
+    *packet_count = count;
+
+    return LIBSPDM_STATUS_SUCCESS;
+}
+
+/**
+ * Initialize a reassembler.
+ *
+ * @param  reassembler        The reassembler.
+ * @param  transmission_unit  The largest packet payload size that is accepted.
+ *                            At least MCTP_BASELINE_TRANSMISSION_UNIT.
+ * @param  slot               An array of slot_count slots.
+ * @param  slot_count         The number of messages that can be reassembled at the same time.
+ * @param  buffer             The buffer of the slots.
+ * @param  buffer_size        The size in bytes of the buffer.
+ *
+ * @retval LIBSPDM_STATUS_SUCCESS            The reassembler is initialized.
+ * @retval LIBSPDM_STATUS_INVALID_PARAMETER  A slot cannot hold one packet.
+ **/
+libspdm_return_t libspdm_mctp_init_reassembler(
+    libspdm_mctp_reassembler_t *reassembler, size_t transmission_unit,
+    libspdm_mctp_reassembly_slot_t *slot, size_t slot_count,
+    void *buffer, size_t buffer_size)
+{
+    size_t slot_buffer_size;
+    size_t index;
+
+    if ((transmission_unit < MCTP_BASELINE_TRANSMISSION_UNIT) || (slot_count == 0) ||
+        (buffer_size / slot_count < transmission_unit)) {
+        return LIBSPDM_STATUS_INVALID_PARAMETER;
+    }
+
+    slot_buffer_size = buffer_size / slot_count;
+    for (index = 0; index < slot_count; index++) {
+        libspdm_zero_mem(&slot[index], sizeof(slot[index]));
+        slot[index].buffer = (uint8_t *)buffer + index * slot_buffer_size;
+        slot[index].buffer_size = slot_buffer_size;
+        slot[index].state = LIBSPDM_MCTP_REASSEMBLY_SLOT_FREE;
+    }
+    reassembler->transmission_unit = transmission_unit;
+    reassembler->slot_count = slot_count;
+    reassembler->slot = slot;
+
+    return LIBSPDM_STATUS_SUCCESS;
+}
+
+/**
+ * Return the slot reassembling the message of a source EID and message tag, or a free slot.
+ *
+ * @param  reassembler  The reassembler.
+ * @param  source_id    The source EID of the packet.
+ * @param  message_tag  The message tag and tag owner bits of the packet.
+ * @param  is_free      If true, return a free slot. If false, return the matching slot.
+ *
+ * @return the slot, or NULL if there is none.
+ **/
+static libspdm_mctp_reassembly_slot_t *libspdm_mctp_find_reassembly_slot(
+    libspdm_mctp_reassembler_t *reassembler, uint8_t source_id, uint8_t message_tag,
+    bool is_free)
+{
+    libspdm_mctp_reassembly_slot_t *slot;
+    size_t index;
+
+    for (index = 0; index < reassembler->slot_count; index++) {
+        slot = &reassembler->slot[index];
+        if (is_free) {
+            if (slot->state == LIBSPDM_MCTP_REASSEMBLY_SLOT_FREE) {
+                return slot;
+            }
+        } else if ((slot->state == LIBSPDM_MCTP_REASSEMBLY_SLOT_ASSEMBLING) &&
+                   (slot->source_id == source_id) && (slot->message_tag == message_tag)) {
+            return slot;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Add a received MCTP packet to the message of its source EID and message tag.
+ *
+ * @param  reassembler   The reassembler.
+ * @param  packet_size   The size in bytes of the packet, including the MCTP header.
+ * @param  packet        A pointer to the packet.
+ * @param  message_size  The size in bytes of the reassembled message, or 0.
+ * @param  message       The reassembled message, or NULL if the message is not complete yet.
+ *
+ * @retval LIBSPDM_STATUS_SUCCESS             The packet is added.
+ * @retval LIBSPDM_STATUS_INVALID_MSG_FIELD   The header version or sequence number is wrong.
+ * @retval LIBSPDM_STATUS_INVALID_MSG_SIZE    The packet payload size is wrong.
+ * @retval LIBSPDM_STATUS_INVALID_STATE_PEER  The packet does not continue a message.
+ * @retval LIBSPDM_STATUS_BUFFER_FULL         No slot is free for a new message.
+ * @retval LIBSPDM_STATUS_BUFFER_TOO_SMALL    The message does not fit in a slot.
+ **/
+libspdm_return_t libspdm_mctp_reassemble_packet(
+    libspdm_mctp_reassembler_t *reassembler, size_t packet_size, const void *packet,
+    size_t *message_size, void **message)
+{
+    const mctp_header_t *mctp_header;
+    libspdm_mctp_reassembly_slot_t *slot;
+    const uint8_t *payload;
+    size_t payload_size;
+    uint8_t message_tag;
+    uint8_t sequence_number;
+    bool is_end_of_message;
+
+    *message_size = 0;
+    *message = NULL;
+
+    if (packet_size <= sizeof(mctp_header_t)) {
+        return LIBSPDM_STATUS_INVALID_MSG_SIZE;
+    }
+    mctp_header = packet;
+    if ((mctp_header->header_version & MCTP_HEADER_VERSION_MASK) != MCTP_HEADER_VERSION) {
+        return LIBSPDM_STATUS_INVALID_MSG_FIELD;
+    }
+    payload = (const uint8_t *)packet + sizeof(mctp_header_t);
+    payload_size = packet_size - sizeof(mctp_header_t);
+    if (payload_size > reassembler->transmission_unit) {
+        return LIBSPDM_STATUS_INVALID_MSG_SIZE;
+    }
+    message_tag = mctp_header->message_tag & (MCTP_MESSAGE_TAG_MASK | MCTP_MESSAGE_TAG_OWNER);
+    sequence_number = (mctp_header->message_tag & MCTP_PACKET_SEQUENCE_NUMBER_MASK) >>
+                      MCTP_PACKET_SEQUENCE_NUMBER_SHIFT;
+    is_end_of_message = (mctp_header->message_tag & MCTP_END_OF_MESSAGE) != 0;
+
+    slot = libspdm_mctp_find_reassembly_slot(reassembler, mctp_header->source_id, message_tag,
+                                             false);
+    if ((mctp_header->message_tag & MCTP_START_OF_MESSAGE) != 0) {
+        /* A new message drops the partial message with the same tag. */
+        if (slot == NULL) {
+            slot = libspdm_mctp_find_reassembly_slot(reassembler, mctp_header->source_id,
+                                                     message_tag, true);
+            if (slot == NULL) {
+                return LIBSPDM_STATUS_BUFFER_FULL;
+            }
+        }
+        slot->state = LIBSPDM_MCTP_REASSEMBLY_SLOT_ASSEMBLING;
+        slot->source_id = mctp_header->source_id;
+        slot->message_tag = message_tag;
+        slot->message_size = 0;
+        slot->packet_payload_size = payload_size;
+    } else {
+        if (slot == NULL) {
+            return LIBSPDM_STATUS_INVALID_STATE_PEER;
+        }
+        if (sequence_number != slot->next_sequence_number) {
+            slot->state = LIBSPDM_MCTP_REASSEMBLY_SLOT_FREE;
+            return LIBSPDM_STATUS_INVALID_MSG_FIELD;
+        }
+    }
+
+    /* Every packet but the last carries the payload size of the first packet. */
+    if ((is_end_of_message && (payload_size > slot->packet_payload_size)) ||
+        (!is_end_of_message && (payload_size != slot->packet_payload_size))) {
+        slot->state = LIBSPDM_MCTP_REASSEMBLY_SLOT_FREE;
+        return LIBSPDM_STATUS_INVALID_MSG_SIZE;
+    }
+    if (payload_size > slot->buffer_size - slot->message_size) {
+        slot->state = LIBSPDM_MCTP_REASSEMBLY_SLOT_FREE;
+        return LIBSPDM_STATUS_BUFFER_TOO_SMALL;
+    }
+
+    libspdm_copy_mem(slot->buffer + slot->message_size, slot->buffer_size - slot->message_size,
+                     payload, payload_size);
+    slot->message_size += payload_size;
+    slot->next_sequence_number = (sequence_number + 1) %
+                                 LIBSPDM_MCTP_PACKET_SEQUENCE_NUMBER_COUNT;
+
+    if (is_end_of_message) {
+        slot->state = LIBSPDM_MCTP_REASSEMBLY_SLOT_COMPLETE;
+        *message_size = slot->message_size;
+        *message = slot->buffer;
+    }
+
+    return LIBSPDM_STATUS_SUCCESS;
+}
+
+/**
+ * Free the slot of a message returned by libspdm_mctp_reassemble_packet.
+ *
+ * @param  reassembler  The reassembler.
+ * @param  message      The reassembled message.
+ **/
+void libspdm_mctp_release_reassembled_message(libspdm_mctp_reassembler_t *reassembler,
+                                              const void *message)
+{
+    size_t index;
+
+    for (index = 0; index < reassembler->slot_count; index++) {
+        if (reassembler->slot[index].buffer == message) {
+            LIBSPDM_ASSERT(reassembler->slot[index].state ==
+                           LIBSPDM_MCTP_REASSEMBLY_SLOT_COMPLETE);
+            reassembler->slot[index].state = LIBSPDM_MCTP_REASSEMBLY_SLOT_FREE;
+            return;
+        }
+    }
+}
@@ -6,6 +6,7 @@
 
 #include "library/spdm_transport_pcidoe_lib.h"
 #include "library/spdm_secured_message_lib.h"
+#include "industry_standard/pcidoe.h"
 #include "hal/library/debuglib.h"
 
 /**
@@ -67,7 +68,8 @@ libspdm_return_t libspdm_pci_doe_decode_message(uint32_t **session_id,
  * @param  message_size                  size in bytes of the message data buffer.
  * @param  message                      A pointer to a source buffer to store the message.
  *                                      For normal message, it shall point to the acquired sender buffer.
- *                                      For secured message, it shall point to the scratch buffer in spdm_context.
+ *                                      For secured message, it shall point to the scratch buffer in spdm_context,
+ *                                      or to the transport header size in the sender buffer to be encoded in place.
  * @param  transport_message_size         size in bytes of the transport message data buffer.
  * @param  transport_message             A pointer to a destination buffer to store the transport message.
  *                                      On input, it shall be msg_buf_ptr from sender buffer.
@@ -109,10 +111,19 @@ libspdm_return_t libspdm_transport_pci_doe_encode_message(
             return LIBSPDM_STATUS_UNSUPPORTED_CAP;
         }
 
-        /* message to secured message*/
+        /* message to secured message.
+         * If the SPDM message is at the transport header size in the sender buffer, the secured
+         * message is encoded in place around it. Otherwise it follows the PCI DOE header. */
         transport_header_size = libspdm_transport_pci_doe_get_header_size(spdm_context);
-        secured_message = (uint8_t *)*transport_message + transport_header_size;
-        secured_message_size = *transport_message_size - transport_header_size;
+        if ((uint8_t *)message == (uint8_t *)*transport_message + transport_header_size) {
+            secured_message = (uint8_t *)message -
+                              libspdm_get_secured_message_header_size(
+                secured_message_context, &spdm_secured_message_callbacks);
+        } else {
+            secured_message = (uint8_t *)*transport_message + sizeof(pci_doe_data_object_header_t);
+        }
+        secured_message_size = (uint8_t *)*transport_message + *transport_message_size -
+                               secured_message;
         status = libspdm_encode_secured_message(
             secured_message_context, *session_id, is_requester,
             message_size, message, &secured_message_size,
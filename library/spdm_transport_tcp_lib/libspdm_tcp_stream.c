@@ -0,0 +1,103 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2021-2022 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+#include "library/spdm_transport_tcp_lib.h"
+#include "industry_standard/spdm_tcp_binding.h"
+#include "hal/library/debuglib.h"
+#include "hal/library/memlib.h"
+
+/**
+ * Initialize the receive side of a stream.
+ *
+ * @param  stream       The stream.
+ * @param  buffer       The buffer of the stream. It shall hold the largest transport message.
+ * @param  buffer_size  The size in bytes of the buffer.
+ **/
+void libspdm_tcp_stream_init(libspdm_tcp_stream_t *stream, void *buffer, size_t buffer_size)
+{
+    stream->buffer = buffer;
+    stream->buffer_size = buffer_size;
+    stream->data_offset = 0;
+    stream->data_size = 0;
+}
+
+/**
+ * Return the free space of a stream, where the next bytes read from the connection go.
+ *
+ * @param  stream      The stream.
+ * @param  space_size  The size in bytes of the free space.
+ * @param  space       The free space.
+ **/
+void libspdm_tcp_stream_get_free_space(libspdm_tcp_stream_t *stream,
+                                       size_t *space_size, void **space)
+{
+    /* Move the unconsumed bytes to the start of the buffer. */
+    if (stream->data_offset != 0) {
+        libspdm_move_mem(stream->buffer, stream->buffer_size,
+                         stream->buffer + stream->data_offset, stream->data_size);
+        stream->data_offset = 0;
+    }
+
+    *space_size = stream->buffer_size - stream->data_size;
+    *space = stream->buffer + stream->data_size;
+}
+
+/**
+ * Append bytes read into the free space of a stream.
+ *
+ * @param  stream  The stream.
+ * @param  size    The number of bytes read into the free space.
+ **/
+void libspdm_tcp_stream_append(libspdm_tcp_stream_t *stream, size_t size)
+{
+    LIBSPDM_ASSERT(size <= stream->buffer_size - stream->data_offset - stream->data_size);
+    stream->data_size += size;
+}
+
+/**
+ * Consume the next complete transport message of a stream.
+ *
+ * @param  stream        The stream.
+ * @param  message_size  The size in bytes of the transport message, or 0.
+ * @param  message       The transport message, or NULL if no complete message is received yet.
+ *
+ * @retval LIBSPDM_STATUS_SUCCESS            The next message, if complete, is returned.
+ * @retval LIBSPDM_STATUS_INVALID_MSG_FIELD  The binding version of the next message is wrong.
+ * @retval LIBSPDM_STATUS_BUFFER_TOO_SMALL   The next message does not fit in the stream buffer.
+ **/
+libspdm_return_t libspdm_tcp_stream_get_message(libspdm_tcp_stream_t *stream,
+                                                size_t *message_size, void **message)
+{
+    const spdm_tcp_binding_header_t *tcp_header;
+    size_t frame_size;
+
+    *message_size = 0;
+    *message = NULL;
+
+    if (stream->data_size < sizeof(spdm_tcp_binding_header_t)) {
+        return LIBSPDM_STATUS_SUCCESS;
+    }
+    tcp_header = (const void *)(stream->buffer + stream->data_offset);
+    if (tcp_header->binding_version != SPDM_TCP_BINDING_VERSION) {
+        return LIBSPDM_STATUS_INVALID_MSG_FIELD;
+    }
+    frame_size = sizeof(spdm_tcp_binding_header_t) + tcp_header->payload_length;
+    if (frame_size > stream->buffer_size) {
+        return LIBSPDM_STATUS_BUFFER_TOO_SMALL;
+    }
+    if (stream->data_size < frame_size) {
+        return LIBSPDM_STATUS_SUCCESS;
+    }
+
+    *message_size = frame_size;
+    *message = stream->buffer + stream->data_offset;
+    stream->data_offset += frame_size;
+    stream->data_size -= frame_size;
+    if (stream->data_size == 0) {
+        stream->data_offset = 0;
+    }
+    return LIBSPDM_STATUS_SUCCESS;
+}
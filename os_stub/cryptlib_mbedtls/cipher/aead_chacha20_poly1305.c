@@ -166,3 +166,180 @@ bool libspdm_aead_chacha20_poly1305_decrypt(
 
     return true;
 }
+
+/**
+ * Allocates and initializes one AEAD ChaCha20Poly1305 context for subsequent use.
+ *
+ * @return  Pointer to the AEAD ChaCha20Poly1305 context that has been initialized.
+ *          If the allocations fails, NULL is returned.
+ **/
+void *libspdm_aead_chacha20_poly1305_new(void)
+{
+    mbedtls_chachapoly_context *ctx;
+
+    ctx = allocate_zero_pool(sizeof(mbedtls_chachapoly_context));
+    if (ctx == NULL) {
+        return NULL;
+    }
+    mbedtls_chachapoly_init(ctx);
+    return ctx;
+}
+
+/**
+ * Release the specified AEAD ChaCha20Poly1305 context.
+ *
+ * @param[in]  aead_ctx  Pointer to the AEAD ChaCha20Poly1305 context to be released.
+ **/
+void libspdm_aead_chacha20_poly1305_free(void *aead_ctx)
+{
+    if (aead_ctx == NULL) {
+        return;
+    }
+    mbedtls_chachapoly_free(aead_ctx);
+    free_pool(aead_ctx);
+}
+
+/**
+ * Set the key of an AEAD ChaCha20Poly1305 context.
+ *
+ * key_size must be 32, otherwise false is returned.
+ *
+ * @param[in, out]  aead_ctx  Pointer to the AEAD ChaCha20Poly1305 context.
+ * @param[in]       key       Pointer to the encryption key.
+ * @param[in]       key_size  Size of the encryption key in bytes.
+ *
+ * @retval true   The key is set.
+ * @retval false  The key is not set.
+ **/
+bool libspdm_aead_chacha20_poly1305_set_key(void *aead_ctx, const uint8_t *key,
+                                            size_t key_size)
+{
+    if (key_size != 32) {
+        return false;
+    }
+
+    return mbedtls_chachapoly_setkey(aead_ctx, key) == 0;
+}
+
+/**
+ * Performs AEAD ChaCha20Poly1305 authenticated encryption with the key of an AEAD context.
+ *
+ * iv_size must be 12, otherwise false is returned.
+ * tag_size must be 16, otherwise false is returned.
+ *
+ * @param[in, out]  aead_ctx       Pointer to the AEAD ChaCha20Poly1305 context.
+ * @param[in]       iv             Pointer to the IV value.
+ * @param[in]       iv_size        Size of the IV value in bytes.
+ * @param[in]       a_data         Pointer to the additional authenticated data (AAD).
+ * @param[in]       a_data_size    Size of the additional authenticated data (AAD) in bytes.
+ * @param[in]       data_in        Pointer to the input data buffer to be encrypted.
+ * @param[in]       data_in_size   Size of the input data buffer in bytes.
+ * @param[out]      tag_out        Pointer to a buffer that receives the authentication tag.
+ * @param[in]       tag_size       Size of the authentication tag in bytes.
+ * @param[out]      data_out       Pointer to a buffer that receives the encryption output.
+ * @param[out]      data_out_size  Size of the output data buffer in bytes.
+ *
+ * @retval true   AEAD ChaCha20Poly1305 authenticated encryption succeeded.
+ * @retval false  AEAD ChaCha20Poly1305 authenticated encryption failed.
+ **/
+bool libspdm_aead_chacha20_poly1305_encrypt_with_context(
+    void *aead_ctx, const uint8_t *iv, size_t iv_size,
+    const uint8_t *a_data, size_t a_data_size,
+    const uint8_t *data_in, size_t data_in_size, uint8_t *tag_out,
+    size_t tag_size, uint8_t *data_out, size_t *data_out_size)
+{
+    int32_t ret;
+
+    if (data_in_size > INT_MAX) {
+        return false;
+    }
+    if (a_data_size > INT_MAX) {
+        return false;
+    }
+    if (iv_size != 12) {
+        return false;
+    }
+    if (tag_size != 16) {
+        return false;
+    }
+    if (data_out_size != NULL) {
+        if ((*data_out_size > INT_MAX) ||
+            (*data_out_size < data_in_size)) {
+            return false;
+        }
+    }
+
+    ret = mbedtls_chachapoly_encrypt_and_tag(aead_ctx, (uint32_t)data_in_size, iv,
+                                             a_data, (uint32_t)a_data_size,
+                                             data_in, data_out, tag_out);
+    if (ret != 0) {
+        return false;
+    }
+    if (data_out_size != NULL) {
+        *data_out_size = data_in_size;
+    }
+
+    return true;
+}
+
+/**
+ * Performs AEAD ChaCha20Poly1305 authenticated decryption with the key of an AEAD context.
+ *
+ * iv_size must be 12, otherwise false is returned.
+ * tag_size must be 16, otherwise false is returned.
+ * If additional authenticated data verification fails, false is returned.
+ *
+ * @param[in, out]  aead_ctx       Pointer to the AEAD ChaCha20Poly1305 context.
+ * @param[in]       iv             Pointer to the IV value.
+ * @param[in]       iv_size        Size of the IV value in bytes.
+ * @param[in]       a_data         Pointer to the additional authenticated data (AAD).
+ * @param[in]       a_data_size    Size of the additional authenticated data (AAD) in bytes.
+ * @param[in]       data_in        Pointer to the input data buffer to be decrypted.
+ * @param[in]       data_in_size   Size of the input data buffer in bytes.
+ * @param[in]       tag            Pointer to a buffer that contains the authentication tag.
+ * @param[in]       tag_size       Size of the authentication tag in bytes.
+ * @param[out]      data_out       Pointer to a buffer that receives the decryption output.
+ * @param[out]      data_out_size  Size of the output data buffer in bytes.
+ *
+ * @retval true   AEAD ChaCha20Poly1305 authenticated decryption succeeded.
+ * @retval false  AEAD ChaCha20Poly1305 authenticated decryption failed.
+ **/
+bool libspdm_aead_chacha20_poly1305_decrypt_with_context(
+    void *aead_ctx, const uint8_t *iv, size_t iv_size,
+    const uint8_t *a_data, size_t a_data_size,
+    const uint8_t *data_in, size_t data_in_size, const uint8_t *tag,
+    size_t tag_size, uint8_t *data_out, size_t *data_out_size)
+{
+    int32_t ret;
+
+    if (data_in_size > INT_MAX) {
+        return false;
+    }
+    if (a_data_size > INT_MAX) {
+        return false;
+    }
+    if (iv_size != 12) {
+        return false;
+    }
+    if (tag_size != 16) {
+        return false;
+    }
+    if (data_out_size != NULL) {
+        if ((*data_out_size > INT_MAX) ||
+            (*data_out_size < data_in_size)) {
+            return false;
+        }
+    }
+
+    ret = mbedtls_chachapoly_auth_decrypt(aead_ctx, (uint32_t)data_in_size, iv,
+                                          a_data, (uint32_t)a_data_size, tag,
+                                          data_in, data_out);
+    if (ret != 0) {
+        return false;
+    }
+    if (data_out_size != NULL) {
+        *data_out_size = data_in_size;
+    }
+
+    return true;
+}
@@ -39,8 +39,14 @@ void *my_calloc(size_t num, size_t size)
 
     /* Adjust the size by the buffer header overhead*/
 
+    if ((num != 0) && (size > (SIZE_MAX - CRYPTMEM_OVERHEAD) / num)) {
+        return NULL;
+    }
     new_size = (size_t)(size * num) + CRYPTMEM_OVERHEAD;
 
+    /* The pool functions serve the allocation from the arena bound to the thread, if any,
+     * so the mbedtls objects of a flow are released with it.*/
+
     data = allocate_zero_pool(new_size);
     if (data != NULL) {
         pool_hdr = (CRYPTMEM_HEAD *)data;
@@ -48,7 +54,7 @@ void *my_calloc(size_t num, size_t size)
         /* Record the memory brief information*/
 
         pool_hdr->version = CRYPTMEM_HEAD_VERSION;
-        pool_hdr->size = size;
+        pool_hdr->size = size * num;
 
         return (void *)(pool_hdr + 1);
     } else {
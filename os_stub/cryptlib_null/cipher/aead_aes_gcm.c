@@ -86,3 +86,106 @@ bool libspdm_aead_aes_gcm_decrypt(const uint8_t *key, size_t key_size,
     *data_out_size = data_in_size;
     return true;
 }
+
+/**
+ * Allocates and initializes one AEAD AES-GCM context for subsequent use.
+ *
+ * @return  Pointer to the AEAD AES-GCM context that has been initialized.
+ *          The context is not supported by this library, so NULL is returned.
+ **/
+void *libspdm_aead_aes_gcm_new(void)
+{
+    return NULL;
+}
+
+/**
+ * Release the specified AEAD AES-GCM context.
+ *
+ * @param[in]  aead_ctx  Pointer to the AEAD AES-GCM context to be released.
+ **/
+void libspdm_aead_aes_gcm_free(void *aead_ctx)
+{
+}
+
+/**
+ * Set the key of an AEAD AES-GCM context.
+ *
+ * key_size must be 16, 24 or 32, otherwise false is returned.
+ *
+ * @param[in, out]  aead_ctx  Pointer to the AEAD AES-GCM context.
+ * @param[in]       key       Pointer to the encryption key.
+ * @param[in]       key_size  Size of the encryption key in bytes.
+ *
+ * @retval true   The key is set.
+ * @retval false  The key is not set.
+ **/
+bool libspdm_aead_aes_gcm_set_key(void *aead_ctx, const uint8_t *key, size_t key_size)
+{
+    LIBSPDM_ASSERT(false);
+    return false;
+}
+
+/**
+ * Performs AEAD AES-GCM authenticated encryption with the key of an AEAD context.
+ *
+ * iv_size must be 12, otherwise false is returned.
+ * tag_size must be 12, 13, 14, 15, 16, otherwise false is returned.
+ *
+ * @param[in, out]  aead_ctx       Pointer to the AEAD AES-GCM context.
+ * @param[in]       iv             Pointer to the IV value.
+ * @param[in]       iv_size        Size of the IV value in bytes.
+ * @param[in]       a_data         Pointer to the additional authenticated data (AAD).
+ * @param[in]       a_data_size    Size of the additional authenticated data (AAD) in bytes.
+ * @param[in]       data_in        Pointer to the input data buffer to be encrypted.
+ * @param[in]       data_in_size   Size of the input data buffer in bytes.
+ * @param[out]      tag_out        Pointer to a buffer that receives the authentication tag.
+ * @param[in]       tag_size       Size of the authentication tag in bytes.
+ * @param[out]      data_out       Pointer to a buffer that receives the encryption output.
+ * @param[out]      data_out_size  Size of the output data buffer in bytes.
+ *
+ * @retval true   AEAD AES-GCM authenticated encryption succeeded.
+ * @retval false  AEAD AES-GCM authenticated encryption failed.
+ **/
+bool libspdm_aead_aes_gcm_encrypt_with_context(void *aead_ctx,
+                                               const uint8_t *iv, size_t iv_size,
+                                               const uint8_t *a_data, size_t a_data_size,
+                                               const uint8_t *data_in, size_t data_in_size,
+                                               uint8_t *tag_out, size_t tag_size,
+                                               uint8_t *data_out, size_t *data_out_size)
+{
+    LIBSPDM_ASSERT(false);
+    return false;
+}
+
+/**
+ * Performs AEAD AES-GCM authenticated decryption with the key of an AEAD context.
+ *
+ * iv_size must be 12, otherwise false is returned.
+ * tag_size must be 12, 13, 14, 15, 16, otherwise false is returned.
+ * If additional authenticated data verification fails, false is returned.
+ *
+ * @param[in, out]  aead_ctx       Pointer to the AEAD AES-GCM context.
+ * @param[in]       iv             Pointer to the IV value.
+ * @param[in]       iv_size        Size of the IV value in bytes.
+ * @param[in]       a_data         Pointer to the additional authenticated data (AAD).
+ * @param[in]       a_data_size    Size of the additional authenticated data (AAD) in bytes.
+ * @param[in]       data_in        Pointer to the input data buffer to be decrypted.
+ * @param[in]       data_in_size   Size of the input data buffer in bytes.
+ * @param[in]       tag            Pointer to a buffer that contains the authentication tag.
+ * @param[in]       tag_size       Size of the authentication tag in bytes.
+ * @param[out]      data_out       Pointer to a buffer that receives the decryption output.
+ * @param[out]      data_out_size  Size of the output data buffer in bytes.
+ *
+ * @retval true   AEAD AES-GCM authenticated decryption succeeded.
+ * @retval false  AEAD AES-GCM authenticated decryption failed.
+ **/
+bool libspdm_aead_aes_gcm_decrypt_with_context(void *aead_ctx,
+                                               const uint8_t *iv, size_t iv_size,
+                                               const uint8_t *a_data, size_t a_data_size,
+                                               const uint8_t *data_in, size_t data_in_size,
+                                               const uint8_t *tag, size_t tag_size,
+                                               uint8_t *data_out, size_t *data_out_size)
+{
+    LIBSPDM_ASSERT(false);
+    return false;
+}
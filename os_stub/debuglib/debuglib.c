@@ -13,6 +13,7 @@
 #include <stdarg.h>
 
 #include "library/debuglib.h"
+#include "library/debuglib_ext.h"
 
 #if LIBSPDM_DEBUG_ASSERT_ENABLE
 #define LIBSPDM_DEBUG_LIBSPDM_ASSERT_NATIVE 0
@@ -56,12 +57,402 @@ void libspdm_debug_assert(const char *file_name, size_t line_number, const char
 #define LIBSPDM_DEBUG_LEVEL_CONFIG (LIBSPDM_DEBUG_INFO | LIBSPDM_DEBUG_ERROR)
 #endif
 
+static size_t m_libspdm_debug_level = LIBSPDM_DEBUG_LEVEL_CONFIG;
+
+static bool libspdm_debug_level_enabled(size_t error_level)
+{
+    return (error_level & m_libspdm_debug_level) != 0;
+}
+
+#if LIBSPDM_DEBUG_LEVEL_FILTER_ENABLE
+bool libspdm_debug_print_enabled(size_t error_level)
+{
+    return libspdm_debug_level_enabled(error_level);
+}
+#endif /* LIBSPDM_DEBUG_LEVEL_FILTER_ENABLE */
+
+void libspdm_debug_set_level(size_t error_level)
+{
+    m_libspdm_debug_level = error_level;
+}
+
+#if LIBSPDM_DEBUG_BINARY_LOG_ENABLE
+
+/* Type of the argument consumed by a conversion specification. */
+typedef enum {
+    LIBSPDM_DEBUG_ARG_NONE,
+    LIBSPDM_DEBUG_ARG_INT,
+    LIBSPDM_DEBUG_ARG_UINT,
+    LIBSPDM_DEBUG_ARG_LONG,
+    LIBSPDM_DEBUG_ARG_ULONG,
+    LIBSPDM_DEBUG_ARG_LLONG,
+    LIBSPDM_DEBUG_ARG_ULLONG,
+    LIBSPDM_DEBUG_ARG_SIZE,
+    LIBSPDM_DEBUG_ARG_INTMAX,
+    LIBSPDM_DEBUG_ARG_UINTMAX,
+    LIBSPDM_DEBUG_ARG_PTRDIFF,
+    LIBSPDM_DEBUG_ARG_DOUBLE,
+    LIBSPDM_DEBUG_ARG_LONG_DOUBLE,
+    LIBSPDM_DEBUG_ARG_POINTER,
+} libspdm_debug_arg_type_t;
+
+static libspdm_debug_binary_log_entry_t
+    m_libspdm_debug_binary_log[LIBSPDM_DEBUG_BINARY_LOG_ENTRY_COUNT];
+static size_t m_libspdm_debug_binary_log_head;
+static size_t m_libspdm_debug_binary_log_count;
+static uint64_t m_libspdm_debug_binary_log_lost_count;
+
+/**
+ * Parse the conversion specification following a '%'.
+ *
+ * @param  format      The character following the '%'.
+ * @param  type        The type of the argument of the conversion.
+ * @param  star_count  The number of int arguments consumed by '*' width and precision before the
+ *                     argument of the conversion.
+ *
+ * @return The character following the conversion specification.
+ **/
+static const char *libspdm_debug_parse_conversion(const char *format,
+                                                  libspdm_debug_arg_type_t *type,
+                                                  size_t *star_count)
+{
+    char length;
+
+    *type = LIBSPDM_DEBUG_ARG_NONE;
+    *star_count = 0;
+
+    while ((*format != '\0') && (strchr("-+ #0", *format) != NULL)) {
+        format++;
+    }
+    if (*format == '*') {
+        (*star_count)++;
+        format++;
+    }
+    while ((*format >= '0') && (*format <= '9')) {
+        format++;
+    }
+    if (*format == '.') {
+        format++;
+        if (*format == '*') {
+            (*star_count)++;
+            format++;
+        }
+        while ((*format >= '0') && (*format <= '9')) {
+            format++;
+        }
+    }
+
+    /* 'q' stands for "ll". "hh" and "h" arguments are promoted to int. */
+    length = '\0';
+    switch (*format) {
+    case 'h':
+        format++;
+        if (*format == 'h') {
+            format++;
+        }
+        break;
+    case 'l':
+        length = 'l';
+        format++;
+        if (*format == 'l') {
+            length = 'q';
+            format++;
+        }
+        break;
+    case 'L':
+    case 'z':
+    case 'j':
+    case 't':
+        length = *format;
+        format++;
+        break;
+    default:
+        break;
+    }
+
+    switch (*format) {
+    case 'd':
+    case 'i':
+    case 'c':
+        *type = (length == 'l') ? LIBSPDM_DEBUG_ARG_LONG :
+                (length == 'q') ? LIBSPDM_DEBUG_ARG_LLONG :
+                (length == 'z') ? LIBSPDM_DEBUG_ARG_SIZE :
+                (length == 'j') ? LIBSPDM_DEBUG_ARG_INTMAX :
+                (length == 't') ? LIBSPDM_DEBUG_ARG_PTRDIFF : LIBSPDM_DEBUG_ARG_INT;
+        break;
+    case 'u':
+    case 'x':
+    case 'X':
+    case 'o':
+        *type = (length == 'l') ? LIBSPDM_DEBUG_ARG_ULONG :
+                (length == 'q') ? LIBSPDM_DEBUG_ARG_ULLONG :
+                (length == 'z') ? LIBSPDM_DEBUG_ARG_SIZE :
+                (length == 'j') ? LIBSPDM_DEBUG_ARG_UINTMAX :
+                (length == 't') ? LIBSPDM_DEBUG_ARG_PTRDIFF : LIBSPDM_DEBUG_ARG_UINT;
+        break;
+    case 'f':
+    case 'F':
+    case 'e':
+    case 'E':
+    case 'g':
+    case 'G':
+    case 'a':
+    case 'A':
+        *type = (length == 'L') ? LIBSPDM_DEBUG_ARG_LONG_DOUBLE : LIBSPDM_DEBUG_ARG_DOUBLE;
+        break;
+    case 's':
+    case 'p':
+        *type = LIBSPDM_DEBUG_ARG_POINTER;
+        break;
+    default:
+        /* "%%", or a conversion that is not supported. */
+        *star_count = 0;
+        break;
+    }
+
+    if (*format != '\0') {
+        format++;
+    }
+    return format;
+}
+
+static void libspdm_debug_binary_log_add_arg(libspdm_debug_binary_log_entry_t *entry,
+                                             uint64_t value)
+{
+    if (entry->arg_count < LIBSPDM_DEBUG_BINARY_LOG_MAX_ARG_COUNT) {
+        entry->arg[entry->arg_count] = value;
+        entry->arg_count++;
+    }
+}
+
+void libspdm_debug_print(size_t error_level, const char *format, ...)
+{
+    libspdm_debug_binary_log_entry_t *entry;
+    libspdm_debug_arg_type_t type;
+    size_t star_count;
+    const char *cursor;
+    uint64_t value;
+    double double_value;
+    va_list marker;
+
+    if (!libspdm_debug_level_enabled(error_level)) {
+        return;
+    }
+
+    if (m_libspdm_debug_binary_log_count == LIBSPDM_DEBUG_BINARY_LOG_ENTRY_COUNT) {
+        m_libspdm_debug_binary_log_head =
+            (m_libspdm_debug_binary_log_head + 1) % LIBSPDM_DEBUG_BINARY_LOG_ENTRY_COUNT;
+        m_libspdm_debug_binary_log_count--;
+        m_libspdm_debug_binary_log_lost_count++;
+    }
+    entry = &m_libspdm_debug_binary_log[
+        (m_libspdm_debug_binary_log_head + m_libspdm_debug_binary_log_count) %
+        LIBSPDM_DEBUG_BINARY_LOG_ENTRY_COUNT];
+    m_libspdm_debug_binary_log_count++;
+
+    entry->format = format;
+    entry->error_level = (uint32_t)error_level;
+    entry->arg_count = 0;
+
+    va_start(marker, format);
+    cursor = strchr(format, '%');
+    while ((cursor != NULL) && (entry->arg_count < LIBSPDM_DEBUG_BINARY_LOG_MAX_ARG_COUNT)) {
+        cursor = libspdm_debug_parse_conversion(cursor + 1, &type, &star_count);
+        for (; star_count > 0; star_count--) {
+            libspdm_debug_binary_log_add_arg(entry, (uint64_t)(int64_t)va_arg(marker, int));
+        }
+        switch (type) {
+        case LIBSPDM_DEBUG_ARG_INT:
+            value = (uint64_t)(int64_t)va_arg(marker, int);
+            break;
+        case LIBSPDM_DEBUG_ARG_UINT:
+            value = va_arg(marker, unsigned int);
+            break;
+        case LIBSPDM_DEBUG_ARG_LONG:
+            value = (uint64_t)(int64_t)va_arg(marker, long);
+            break;
+        case LIBSPDM_DEBUG_ARG_ULONG:
+            value = va_arg(marker, unsigned long);
+            break;
+        case LIBSPDM_DEBUG_ARG_LLONG:
+            value = (uint64_t)va_arg(marker, long long);
+            break;
+        case LIBSPDM_DEBUG_ARG_ULLONG:
+            value = va_arg(marker, unsigned long long);
+            break;
+        case LIBSPDM_DEBUG_ARG_SIZE:
+            value = va_arg(marker, size_t);
+            break;
+        case LIBSPDM_DEBUG_ARG_INTMAX:
+            value = (uint64_t)va_arg(marker, intmax_t);
+            break;
+        case LIBSPDM_DEBUG_ARG_UINTMAX:
+            value = va_arg(marker, uintmax_t);
+            break;
+        case LIBSPDM_DEBUG_ARG_PTRDIFF:
+            value = (uint64_t)(int64_t)va_arg(marker, ptrdiff_t);
+            break;
+        case LIBSPDM_DEBUG_ARG_DOUBLE:
+        case LIBSPDM_DEBUG_ARG_LONG_DOUBLE:
+            if (type == LIBSPDM_DEBUG_ARG_DOUBLE) {
+                double_value = va_arg(marker, double);
+            } else {
+                double_value = (double)va_arg(marker, long double);
+            }
+            memcpy(&value, &double_value, sizeof(value));
+            break;
+        case LIBSPDM_DEBUG_ARG_POINTER:
+            value = (uintptr_t)va_arg(marker, void *);
+            break;
+        default:
+            cursor = strchr(cursor, '%');
+            continue;
+        }
+        libspdm_debug_binary_log_add_arg(entry, value);
+        cursor = strchr(cursor, '%');
+    }
+    va_end(marker);
+}
+
+size_t libspdm_debug_binary_log_read(libspdm_debug_binary_log_entry_t *entry, size_t entry_count)
+{
+    size_t index;
+
+    for (index = 0; (index < entry_count) && (m_libspdm_debug_binary_log_count > 0); index++) {
+        entry[index] = m_libspdm_debug_binary_log[m_libspdm_debug_binary_log_head];
+        m_libspdm_debug_binary_log_head =
+            (m_libspdm_debug_binary_log_head + 1) % LIBSPDM_DEBUG_BINARY_LOG_ENTRY_COUNT;
+        m_libspdm_debug_binary_log_count--;
+    }
+    return index;
+}
+
+uint64_t libspdm_debug_binary_log_get_lost_count(void)
+{
+    return m_libspdm_debug_binary_log_lost_count;
+}
+
+/* Format one argument with the conversion specification spec, which is NUL-terminated. */
+static int libspdm_debug_binary_log_format_arg(char *buffer, size_t buffer_size, const char *spec,
+                                               libspdm_debug_arg_type_t type, size_t star_count,
+                                               const int *star, uint64_t value)
+{
+    double double_value;
+
+    #define LIBSPDM_DEBUG_SNPRINTF(arg) \
+    ((star_count == 0) ? snprintf(buffer, buffer_size, spec, arg) : \
+     (star_count == 1) ? snprintf(buffer, buffer_size, spec, star[0], arg) : \
+     snprintf(buffer, buffer_size, spec, star[0], star[1], arg))
+
+    switch (type) {
+    case LIBSPDM_DEBUG_ARG_INT:
+        return LIBSPDM_DEBUG_SNPRINTF((int)(int64_t)value);
+    case LIBSPDM_DEBUG_ARG_UINT:
+        return LIBSPDM_DEBUG_SNPRINTF((unsigned int)value);
+    case LIBSPDM_DEBUG_ARG_LONG:
+        return LIBSPDM_DEBUG_SNPRINTF((long)(int64_t)value);
+    case LIBSPDM_DEBUG_ARG_ULONG:
+        return LIBSPDM_DEBUG_SNPRINTF((unsigned long)value);
+    case LIBSPDM_DEBUG_ARG_LLONG:
+        return LIBSPDM_DEBUG_SNPRINTF((long long)value);
+    case LIBSPDM_DEBUG_ARG_ULLONG:
+        return LIBSPDM_DEBUG_SNPRINTF((unsigned long long)value);
+    case LIBSPDM_DEBUG_ARG_SIZE:
+        return LIBSPDM_DEBUG_SNPRINTF((size_t)value);
+    case LIBSPDM_DEBUG_ARG_INTMAX:
+        return LIBSPDM_DEBUG_SNPRINTF((intmax_t)value);
+    case LIBSPDM_DEBUG_ARG_UINTMAX:
+        return LIBSPDM_DEBUG_SNPRINTF((uintmax_t)value);
+    case LIBSPDM_DEBUG_ARG_PTRDIFF:
+        return LIBSPDM_DEBUG_SNPRINTF((ptrdiff_t)(int64_t)value);
+    case LIBSPDM_DEBUG_ARG_DOUBLE:
+        memcpy(&double_value, &value, sizeof(double_value));
+        return LIBSPDM_DEBUG_SNPRINTF(double_value);
+    case LIBSPDM_DEBUG_ARG_LONG_DOUBLE:
+        memcpy(&double_value, &value, sizeof(double_value));
+        return LIBSPDM_DEBUG_SNPRINTF((long double)double_value);
+    case LIBSPDM_DEBUG_ARG_POINTER:
+        return LIBSPDM_DEBUG_SNPRINTF((void *)(uintptr_t)value);
+    default:
+        return snprintf(buffer, buffer_size, "%s", (strcmp(spec, "%%") == 0) ? "%" : spec);
+    }
+
+    #undef LIBSPDM_DEBUG_SNPRINTF
+}
+
+void libspdm_debug_binary_log_format(const libspdm_debug_binary_log_entry_t *entry,
+                                     char *buffer, size_t buffer_size)
+{
+    char spec[32];
+    int star[2];
+    libspdm_debug_arg_type_t type;
+    size_t star_count;
+    size_t arg_index;
+    size_t used;
+    size_t size;
+    const char *cursor;
+    const char *end;
+    int result;
+
+    if (buffer_size == 0) {
+        return;
+    }
+    buffer[0] = '\0';
+    used = 0;
+    arg_index = 0;
+    cursor = entry->format;
+
+    while ((*cursor != '\0') && (used + 1 < buffer_size)) {
+        end = strchr(cursor, '%');
+        if (end == NULL) {
+            end = cursor + strlen(cursor);
+        }
+        size = (size_t)(end - cursor);
+        if (size > buffer_size - used - 1) {
+            size = buffer_size - used - 1;
+        }
+        memcpy(buffer + used, cursor, size);
+        used += size;
+        buffer[used] = '\0';
+        if (*end == '\0') {
+            break;
+        }
+
+        cursor = libspdm_debug_parse_conversion(end + 1, &type, &star_count);
+        size = (size_t)(cursor - end);
+        if ((size >= sizeof(spec)) ||
+            (arg_index + star_count + ((type == LIBSPDM_DEBUG_ARG_NONE) ? 0 : 1) >
+             entry->arg_count)) {
+            /* The arguments of the rest of the message were not recorded. */
+            break;
+        }
+        memcpy(spec, end, size);
+        spec[size] = '\0';
+        for (size = 0; size < star_count; size++) {
+            star[size] = (int)(int64_t)entry->arg[arg_index];
+            arg_index++;
+        }
+        result = libspdm_debug_binary_log_format_arg(
+            buffer + used, buffer_size - used, spec, type, star_count, star,
+            (type == LIBSPDM_DEBUG_ARG_NONE) ? 0 : entry->arg[arg_index]);
+        if (type != LIBSPDM_DEBUG_ARG_NONE) {
+            arg_index++;
+        }
+        if (result < 0) {
+            break;
+        }
+        used += ((size_t)result < buffer_size - used) ? (size_t)result : buffer_size - used - 1;
+    }
+}
+
+#else /* LIBSPDM_DEBUG_BINARY_LOG_ENABLE */
+
 void libspdm_debug_print(size_t error_level, const char *format, ...)
 {
     char buffer[LIBSPDM_MAX_DEBUG_MESSAGE_LENGTH];
     va_list marker;
 
-    if ((error_level & LIBSPDM_DEBUG_LEVEL_CONFIG) == 0) {
+    if (!libspdm_debug_level_enabled(error_level)) {
         return;
     }
 
@@ -73,4 +464,5 @@ void libspdm_debug_print(size_t error_level, const char *format, ...)
 
     printf("%s", buffer);
 }
+#endif /* LIBSPDM_DEBUG_BINARY_LOG_ENABLE */
 #endif /* LIBSPDM_DEBUG_PRINT_ENABLE */
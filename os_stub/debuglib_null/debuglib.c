@@ -5,6 +5,7 @@
  **/
 
 #include <base.h>
+#include "library/debuglib.h"
 
 void libspdm_debug_assert(const char *file_name, size_t line_number,
                           const char *description)
@@ -14,3 +15,10 @@ void libspdm_debug_assert(const char *file_name, size_t line_number,
 void libspdm_debug_print(size_t error_level, const char *format, ...)
 {
 }
+
+#if LIBSPDM_DEBUG_LEVEL_FILTER_ENABLE
+bool libspdm_debug_print_enabled(size_t error_level)
+{
+    return false;
+}
+#endif /* LIBSPDM_DEBUG_LEVEL_FILTER_ENABLE */
@@ -0,0 +1,82 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2021-2022 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+/** @file
+ * Provides the run time debug level and the binary log of the sample debug library.
+ **/
+
+#ifndef DEBUG_LIB_EXT_H
+#define DEBUG_LIB_EXT_H
+
+#include "hal/base.h"
+#include "hal/library/debuglib.h"
+
+#if LIBSPDM_DEBUG_PRINT_ENABLE
+
+/**
+ * Set the error levels that are output at run time.
+ *
+ * The initial value is LIBSPDM_DEBUG_LEVEL_CONFIG. Levels removed at compile time by
+ * LIBSPDM_DEBUG_LEVEL_MASK cannot be enabled again.
+ *
+ * @param  error_level  A bitwise OR of LIBSPDM_DEBUG_INFO and LIBSPDM_DEBUG_ERROR.
+ **/
+void libspdm_debug_set_level(size_t error_level);
+
+#if LIBSPDM_DEBUG_BINARY_LOG_ENABLE
+
+/* Number of messages held by the binary log. Older messages are overwritten. */
+#ifndef LIBSPDM_DEBUG_BINARY_LOG_ENTRY_COUNT
+#define LIBSPDM_DEBUG_BINARY_LOG_ENTRY_COUNT 256
+#endif
+
+/* Maximum number of arguments recorded per message. Further arguments are dropped. */
+#define LIBSPDM_DEBUG_BINARY_LOG_MAX_ARG_COUNT 6
+
+/**
+ * One message of the binary log.
+ *
+ * The format string is recorded by address, so it identifies the message and can be resolved
+ * against the image offline. Integer, floating point and pointer arguments are recorded by value.
+ * String arguments are recorded by address and are only valid as long as the string is.
+ **/
+typedef struct {
+    const char *format;
+    uint32_t error_level;
+    uint32_t arg_count;
+    uint64_t arg[LIBSPDM_DEBUG_BINARY_LOG_MAX_ARG_COUNT];
+} libspdm_debug_binary_log_entry_t;
+
+/**
+ * Read and remove the oldest messages of the binary log.
+ *
+ * @param  entry        The buffer receiving the messages, oldest first.
+ * @param  entry_count  The number of messages the buffer can hold.
+ *
+ * @return The number of messages read.
+ **/
+size_t libspdm_debug_binary_log_read(libspdm_debug_binary_log_entry_t *entry, size_t entry_count);
+
+/**
+ * Return the number of messages overwritten before they were read.
+ **/
+uint64_t libspdm_debug_binary_log_get_lost_count(void);
+
+/**
+ * Format a message of the binary log as libspdm_debug_print() would have printed it.
+ *
+ * @param  entry        The message.
+ * @param  buffer       The buffer receiving the NUL-terminated text.
+ * @param  buffer_size  The size in bytes of the buffer. Longer text is truncated.
+ **/
+void libspdm_debug_binary_log_format(const libspdm_debug_binary_log_entry_t *entry,
+                                     char *buffer, size_t buffer_size);
+
+#endif /* LIBSPDM_DEBUG_BINARY_LOG_ENABLE */
+
+#endif /* LIBSPDM_DEBUG_PRINT_ENABLE */
+
+#endif /* DEBUG_LIB_EXT_H */
@@ -61,4 +61,91 @@ void *allocate_zero_pool(size_t AllocationSize);
  **/
 void free_pool(void *buffer);
 
+#if LIBSPDM_STATISTICS_SUPPORT
+
+/* Heap usage through the pool allocation functions. */
+typedef struct {
+    uint64_t allocation_count;
+    uint64_t free_count;
+    /* Total bytes requested by all allocations. */
+    uint64_t allocated_bytes;
+    /* Bytes currently allocated and not freed. */
+    uint64_t current_bytes;
+    /* High-water mark of current_bytes. */
+    uint64_t peak_bytes;
+} libspdm_malloc_statistics_t;
+
+/**
+ * Get the heap usage through the pool allocation functions.
+ *
+ * The allocations of all the threads are counted. The counters are read one by one, so they are
+ * consistent with each other only if no other thread allocates meanwhile.
+ *
+ * @param  statistics            The heap usage since the last libspdm_malloc_reset_statistics().
+ **/
+void libspdm_malloc_get_statistics(libspdm_malloc_statistics_t *statistics);
+
+/**
+ * Reset the counters of the heap usage.
+ *
+ * The bytes currently allocated are kept, and the peak restarts from them, so the peak of an
+ * operation can be measured by a reset before it.
+ **/
+void libspdm_malloc_reset_statistics(void);
+
+#endif /* LIBSPDM_STATISTICS_SUPPORT */
+
+#if LIBSPDM_ALLOC_SCOPE_SUPPORT
+
+/* An arena serving the pool allocations of one flow, see libspdm_register_alloc_scope_func. */
+typedef struct {
+    uint8_t *buffer;
+    size_t size;
+    /* Bytes of the buffer in use, including the buffer headers. */
+    size_t used;
+    /* Buffers allocated from the arena and not freed. */
+    size_t live_count;
+    /* High-water mark of used. */
+    size_t peak_used;
+    /* Allocations served by the heap because the arena was full or not yet released. */
+    uint64_t fallback_count;
+    /* Releases with buffers not freed yet. */
+    uint64_t leak_count;
+    bool release_pending;
+} libspdm_malloc_arena_t;
+
+/**
+ * Initialize an arena on a buffer provided by the caller.
+ *
+ * @param  arena                 The arena.
+ * @param  buffer                The memory of the arena. It must be kept until the arena is not
+ *                               used anymore.
+ * @param  size                  The size in bytes of the buffer.
+ **/
+void libspdm_malloc_arena_init(libspdm_malloc_arena_t *arena, void *buffer, size_t size);
+
+/**
+ * Bind an arena to the calling thread.
+ *
+ * While an arena is bound, the pool allocations of the thread are served by it, or by the heap if
+ * it is full. free_pool() may be called on buffers of any arena, from the thread owning it.
+ *
+ * @param  arena                 The arena, or NULL to serve the allocations by the heap.
+ *
+ * @return The arena bound before, so that it can be bound again when the caller is done.
+ **/
+libspdm_malloc_arena_t *libspdm_malloc_arena_bind(libspdm_malloc_arena_t *arena);
+
+/**
+ * Release all the buffers of an arena at once and zero its memory.
+ *
+ * The buffers of the arena are normally freed when the flow completes. If some are not, the arena
+ * is released when the last one is freed, and the allocations until then are served by the heap.
+ *
+ * @param  arena                 The arena.
+ **/
+void libspdm_malloc_arena_release(libspdm_malloc_arena_t *arena);
+
+#endif /* LIBSPDM_ALLOC_SCOPE_SUPPORT */
+
 #endif
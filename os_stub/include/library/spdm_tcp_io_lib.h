@@ -0,0 +1,62 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2021-2022 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+/** @file
+ * Reference device IO for SPDM over TCP, on a non-blocking stream socket.
+ *
+ * libspdm_tcp_io_send_message and libspdm_tcp_io_receive_message are registered with
+ * libspdm_register_device_io_func, together with spdm_transport_tcp_lib. They find the socket
+ * through LIBSPDM_DATA_APP_CONTEXT_DATA, which shall point to a libspdm_tcp_io_t, or to a
+ * structure that starts with one.
+ *
+ * The socket can be a TCP socket or a Unix domain stream socket.
+ **/
+
+#ifndef __SPDM_TCP_IO_LIB_H__
+#define __SPDM_TCP_IO_LIB_H__
+
+#include "library/spdm_transport_tcp_lib.h"
+
+typedef struct {
+    /* A connected stream socket. */
+    int socket;
+    /* Received bytes that are not consumed yet, possibly several messages. */
+    libspdm_tcp_stream_t stream;
+} libspdm_tcp_io_t;
+
+/**
+ * Initialize the device IO of a connected socket, and set the socket to non-blocking.
+ *
+ * @param  tcp_io       The device IO.
+ * @param  socket_fd    A connected stream socket.
+ * @param  buffer       The receive buffer. It shall hold the largest transport message.
+ * @param  buffer_size  The size in bytes of the receive buffer.
+ *
+ * @retval true   The device IO is initialized.
+ * @retval false  The socket cannot be set to non-blocking.
+ **/
+bool libspdm_tcp_io_init(libspdm_tcp_io_t *tcp_io, int socket_fd,
+                         void *buffer, size_t buffer_size);
+
+/**
+ * Send a transport message on the socket. See libspdm_device_send_message_func.
+ *
+ * The timeout, in us, bounds the whole send. 0 waits indefinitely.
+ **/
+libspdm_return_t libspdm_tcp_io_send_message(void *spdm_context, size_t message_size,
+                                             const void *message, uint64_t timeout);
+
+/**
+ * Receive the next transport message from the socket. See libspdm_device_receive_message_func.
+ *
+ * A message that was already received with a previous one is returned without reading the
+ * socket. The message is copied to *message. The timeout, in us, bounds the whole receive.
+ * 0 waits indefinitely.
+ **/
+libspdm_return_t libspdm_tcp_io_receive_message(void *spdm_context, size_t *message_size,
+                                                void **message, uint64_t timeout);
+
+#endif /* __SPDM_TCP_IO_LIB_H__ */
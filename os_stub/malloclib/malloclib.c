@@ -11,23 +11,260 @@
 #include <string.h>
 #include <assert.h>
 
+#include "internal/libspdm_lib_config.h"
+#include "library/malloclib.h"
+
+#if LIBSPDM_STATISTICS_SUPPORT || LIBSPDM_ALLOC_SCOPE_SUPPORT
+
+/* Each buffer is preceded by a header recording its size and the arena holding it, if any.
+ * The header size keeps the alignment of malloc(). */
+#define LIBSPDM_MALLOC_HEADER_SIZE 16
+
+typedef struct {
+    size_t size;
+    /* The libspdm_malloc_arena_t holding the buffer, or NULL if it is from the heap. */
+    void *arena;
+} libspdm_malloc_header_t;
+
+#if LIBSPDM_STATISTICS_SUPPORT
+static libspdm_malloc_statistics_t m_libspdm_malloc_statistics;
+
+/* The counters are updated by every allocating thread, such as the workers hashing the chunks of
+ * a measurement image. A target without 64-bit atomics is single-threaded only. */
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define LIBSPDM_MALLOC_ATOMIC_CAS(counter, expected, desired) \
+    (_InterlockedCompareExchange64((volatile __int64 *)(counter), (__int64)(desired), \
+                                   (__int64)(expected)) == (__int64)(expected))
+#elif defined(__GCC_ATOMIC_LLONG_LOCK_FREE) && (__GCC_ATOMIC_LLONG_LOCK_FREE == 2)
+#define LIBSPDM_MALLOC_ATOMIC_CAS(counter, expected, desired) \
+    __atomic_compare_exchange_n((counter), &(expected), (desired), true, \
+                                __ATOMIC_RELAXED, __ATOMIC_RELAXED)
+#else
+#define LIBSPDM_MALLOC_ATOMIC_CAS(counter, expected, desired) \
+    ((*(counter) = (desired)), true)
+#endif
+
+/* Add a value to a counter and return the new value. */
+static uint64_t libspdm_malloc_counter_add(uint64_t *counter, uint64_t value)
+{
+    uint64_t old_value;
+
+    do {
+        old_value = *(volatile uint64_t *)counter;
+    } while (!LIBSPDM_MALLOC_ATOMIC_CAS(counter, old_value, old_value + value));
+    return old_value + value;
+}
+
+/* Raise a counter to a value if it is lower. */
+static void libspdm_malloc_counter_max(uint64_t *counter, uint64_t value)
+{
+    uint64_t old_value;
+
+    do {
+        old_value = *(volatile uint64_t *)counter;
+        if (old_value >= value) {
+            return;
+        }
+    } while (!LIBSPDM_MALLOC_ATOMIC_CAS(counter, old_value, value));
+}
+#endif /* LIBSPDM_STATISTICS_SUPPORT */
+
+#if LIBSPDM_ALLOC_SCOPE_SUPPORT
+
+#if defined(_MSC_VER)
+#define LIBSPDM_MALLOC_THREAD_LOCAL __declspec(thread)
+#else
+#define LIBSPDM_MALLOC_THREAD_LOCAL __thread
+#endif
+
+static LIBSPDM_MALLOC_THREAD_LOCAL libspdm_malloc_arena_t *m_libspdm_malloc_arena;
+
+/* Round a size up to the alignment of the arena buffers. */
+#define LIBSPDM_MALLOC_ARENA_ALIGN(size) \
+    (((size) + LIBSPDM_MALLOC_HEADER_SIZE - 1) & ~((size_t)LIBSPDM_MALLOC_HEADER_SIZE - 1))
+
+static uint8_t *libspdm_malloc_arena_allocate(libspdm_malloc_arena_t *arena,
+                                              size_t allocation_size)
+{
+    uint8_t *header;
+    size_t block_size;
+
+    if (allocation_size > arena->size) {
+        return NULL;
+    }
+    block_size = LIBSPDM_MALLOC_HEADER_SIZE + LIBSPDM_MALLOC_ARENA_ALIGN(allocation_size);
+    if (block_size > arena->size - arena->used) {
+        return NULL;
+    }
+    header = arena->buffer + arena->used;
+    arena->used += block_size;
+    arena->live_count++;
+    if (arena->used > arena->peak_used) {
+        arena->peak_used = arena->used;
+    }
+    return header;
+}
+
+static void libspdm_malloc_arena_reset(libspdm_malloc_arena_t *arena)
+{
+    memset(arena->buffer, 0, arena->used);
+    arena->used = 0;
+    arena->release_pending = false;
+}
+
+static void libspdm_malloc_arena_free(libspdm_malloc_arena_t *arena, uint8_t *header,
+                                      size_t allocation_size)
+{
+    size_t block_size;
+
+    block_size = LIBSPDM_MALLOC_HEADER_SIZE + LIBSPDM_MALLOC_ARENA_ALIGN(allocation_size);
+    assert(arena->live_count != 0);
+    arena->live_count--;
+    memset(header, 0, block_size);
+    if (header + block_size == arena->buffer + arena->used) {
+        /* The last buffer is given back, so that a flow freeing in reverse order reuses it. */
+        arena->used -= block_size;
+    }
+    if (arena->live_count == 0) {
+        /* All the buffers are free and zeroed, a pending release is complete. */
+        arena->used = 0;
+        arena->release_pending = false;
+    }
+}
+
+void libspdm_malloc_arena_init(libspdm_malloc_arena_t *arena, void *buffer, size_t size)
+{
+    memset(arena, 0, sizeof(*arena));
+    /* Start the first buffer at the alignment of malloc(). */
+    arena->buffer = (uint8_t *)LIBSPDM_MALLOC_ARENA_ALIGN((size_t)buffer);
+    if ((size_t)(arena->buffer - (uint8_t *)buffer) < size) {
+        arena->size = size - (size_t)(arena->buffer - (uint8_t *)buffer);
+    }
+}
+
+libspdm_malloc_arena_t *libspdm_malloc_arena_bind(libspdm_malloc_arena_t *arena)
+{
+    libspdm_malloc_arena_t *previous_arena;
+
+    previous_arena = m_libspdm_malloc_arena;
+    m_libspdm_malloc_arena = arena;
+    return previous_arena;
+}
+
+void libspdm_malloc_arena_release(libspdm_malloc_arena_t *arena)
+{
+    if (arena->live_count == 0) {
+        libspdm_malloc_arena_reset(arena);
+    } else {
+        /* Some buffers outlive the flow. The arena is released when the last one is freed. */
+        arena->release_pending = true;
+        arena->leak_count++;
+    }
+}
+
+#endif /* LIBSPDM_ALLOC_SCOPE_SUPPORT */
+
+void *allocate_pool(size_t AllocationSize)
+{
+    uint8_t *header;
+    libspdm_malloc_header_t header_data;
+
+    header = NULL;
+    header_data.arena = NULL;
+#if LIBSPDM_ALLOC_SCOPE_SUPPORT
+    if ((m_libspdm_malloc_arena != NULL) && !m_libspdm_malloc_arena->release_pending) {
+        header = libspdm_malloc_arena_allocate(m_libspdm_malloc_arena, AllocationSize);
+        if (header != NULL) {
+            header_data.arena = m_libspdm_malloc_arena;
+        } else {
+            m_libspdm_malloc_arena->fallback_count++;
+        }
+    }
+#endif /* LIBSPDM_ALLOC_SCOPE_SUPPORT */
+    if (header == NULL) {
+        header = malloc(LIBSPDM_MALLOC_HEADER_SIZE + AllocationSize);
+        if (header == NULL) {
+            return NULL;
+        }
+    }
+    header_data.size = AllocationSize;
+    memcpy(header, &header_data, sizeof(header_data));
+
+#if LIBSPDM_STATISTICS_SUPPORT
+    libspdm_malloc_counter_add(&m_libspdm_malloc_statistics.allocation_count, 1);
+    libspdm_malloc_counter_add(&m_libspdm_malloc_statistics.allocated_bytes, AllocationSize);
+    libspdm_malloc_counter_max(
+        &m_libspdm_malloc_statistics.peak_bytes,
+        libspdm_malloc_counter_add(&m_libspdm_malloc_statistics.current_bytes, AllocationSize));
+#endif /* LIBSPDM_STATISTICS_SUPPORT */
+    return header + LIBSPDM_MALLOC_HEADER_SIZE;
+}
+
+void free_pool(void *buffer)
+{
+    uint8_t *header;
+    libspdm_malloc_header_t header_data;
+
+    if (buffer == NULL) {
+        return;
+    }
+    header = (uint8_t *)buffer - LIBSPDM_MALLOC_HEADER_SIZE;
+    memcpy(&header_data, header, sizeof(header_data));
+
+#if LIBSPDM_STATISTICS_SUPPORT
+    libspdm_malloc_counter_add(&m_libspdm_malloc_statistics.free_count, 1);
+    libspdm_malloc_counter_add(&m_libspdm_malloc_statistics.current_bytes,
+                               (uint64_t)0 - header_data.size);
+#endif /* LIBSPDM_STATISTICS_SUPPORT */
+
+#if LIBSPDM_ALLOC_SCOPE_SUPPORT
+    if (header_data.arena != NULL) {
+        libspdm_malloc_arena_free(header_data.arena, header, header_data.size);
+        return;
+    }
+#endif /* LIBSPDM_ALLOC_SCOPE_SUPPORT */
+    free(header);
+}
+
+#if LIBSPDM_STATISTICS_SUPPORT
+void libspdm_malloc_get_statistics(libspdm_malloc_statistics_t *statistics)
+{
+    *statistics = m_libspdm_malloc_statistics;
+}
+
+void libspdm_malloc_reset_statistics(void)
+{
+    uint64_t current_bytes;
+
+    current_bytes = m_libspdm_malloc_statistics.current_bytes;
+    memset(&m_libspdm_malloc_statistics, 0, sizeof(m_libspdm_malloc_statistics));
+    m_libspdm_malloc_statistics.current_bytes = current_bytes;
+    m_libspdm_malloc_statistics.peak_bytes = current_bytes;
+}
+#endif /* LIBSPDM_STATISTICS_SUPPORT */
+
+#else
+
 void *allocate_pool(size_t AllocationSize)
 {
     return malloc(AllocationSize);
 }
 
+void free_pool(void *buffer)
+{
+    free(buffer);
+}
+
+#endif /* LIBSPDM_STATISTICS_SUPPORT || LIBSPDM_ALLOC_SCOPE_SUPPORT */
+
 void *allocate_zero_pool(size_t AllocationSize)
 {
     void *buffer;
-    buffer = malloc(AllocationSize);
+    buffer = allocate_pool(AllocationSize);
     if (buffer == NULL) {
         return NULL;
     }
     memset(buffer, 0, AllocationSize);
     return buffer;
 }
-
-void free_pool(void *buffer)
-{
-    free(buffer);
-}
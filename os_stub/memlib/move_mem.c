@@ -0,0 +1,88 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2021-2022 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+/** @file
+ * libspdm_move_mem() implementation.
+ **/
+
+#include "base.h"
+#include "library/debuglib.h"
+#include "hal/library/memlib.h"
+
+/**
+ * Copies bytes from a source buffer to a destination buffer that may overlap it.
+ *
+ * This function copies "src_len" bytes from "src_buf" to "dst_buf" as if the bytes were first
+ * copied to a temporary buffer.
+ *
+ * Asserts and returns a non-zero value if any of the following are true:
+ *   1) "src_buf" or "dst_buf" are NULL.
+ *   2) "src_len" or "dst_len" is greater than (SIZE_MAX >> 1).
+ *   3) "src_len" is greater than "dst_len".
+ *
+ * If any of these cases fail, a non-zero value is returned. Additionally if
+ * "dst_buf" points to a non-NULL value and "dst_len" is valid, then "dst_len"
+ * bytes of "dst_buf" are zeroed.
+ *
+ * This function follows the C11 cppreference description of memmove_s.
+ * https://en.cppreference.com/w/c/string/byte/memmove
+ *
+ * @param    dst_buf   Destination buffer to copy to.
+ * @param    dst_len   Maximum length in bytes of the destination buffer.
+ * @param    src_buf   Source buffer to copy from.
+ * @param    src_len   The number of bytes to copy from the source buffer.
+ *
+ * @return   0 on success. non-zero on error.
+ *
+ **/
+int libspdm_move_mem(void *dst_buf, size_t dst_len,
+                     const void *src_buf, size_t src_len)
+{
+    volatile uint8_t* dst;
+    const volatile uint8_t* src;
+
+    dst = (volatile uint8_t*) dst_buf;
+    src = (const volatile uint8_t*) src_buf;
+
+    /* Check for case where "dst" or "dst_len" may be invalid.
+     * Do not zero "dst" in this case. */
+    if (dst == NULL || dst_len > (SIZE_MAX >> 1)) {
+        LIBSPDM_ASSERT(0);
+        return -1;
+    }
+
+    /* Gaurd against invalid source. Zero "dst" in this case. */
+    if (src == NULL) {
+        libspdm_zero_mem(dst_buf, dst_len);
+        LIBSPDM_ASSERT(0);
+        return -1;
+    }
+
+    /* Guard against invalid lengths. Zero "dst" in these cases. */
+    if (src_len > dst_len ||
+        src_len > (SIZE_MAX >> 1)) {
+
+        libspdm_zero_mem(dst_buf, dst_len);
+        LIBSPDM_ASSERT(0);
+        return -1;
+    }
+
+    /* Copy forward when the destination is below the source, backward otherwise, so that no
+     * source byte is overwritten before it is read. */
+    if (dst < src) {
+        while (src_len-- != 0) {
+            *(dst++) = *(src++);
+        }
+    } else if (dst > src) {
+        dst += src_len;
+        src += src_len;
+        while (src_len-- != 0) {
+            *(--dst) = *(--src);
+        }
+    }
+
+    return 0;
+}
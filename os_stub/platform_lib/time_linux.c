@@ -4,9 +4,13 @@
  * License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
  **/
 
+#define _POSIX_C_SOURCE 200112L
+
 #include <base.h>
 #include <stdlib.h>
+#include <sys/select.h>
 #include <sys/time.h>
+#include <time.h>
 #include <errno.h>
 
 /**
@@ -27,3 +31,18 @@ void libspdm_sleep(uint64_t microseconds)
         err=select(0, NULL, NULL, NULL, &tv);
     } while(err<0 && errno==EINTR);
 }
+
+/**
+ * Return a monotonic timestamp.
+ *
+ * @return  The current timestamp, in units of microseconds.
+ **/
+uint64_t libspdm_get_timestamp_us(void)
+{
+    struct timespec ts;
+
+    if (clock_gettime(CLOCK_MONOTONIC, &ts) != 0) {
+        return 0;
+    }
+    return (uint64_t)ts.tv_sec * 1000000 + (uint64_t)ts.tv_nsec / 1000;
+}
@@ -26,3 +26,14 @@ void libspdm_sleep(uint64_t microseconds)
     /*the feature for armclang build is TBD*/
     LIBSPDM_ASSERT(false);
 }
+
+/**
+ * Return a monotonic timestamp.
+ *
+ * @return  The current timestamp, in units of microseconds.
+ **/
+uint64_t libspdm_get_timestamp_us(void)
+{
+    /*the feature for armclang build is TBD*/
+    return 0;
+}
@@ -29,3 +29,21 @@ void libspdm_sleep(uint64_t microseconds)
     milliseconds = (microseconds + 1000 - 1) / 1000;
     Sleep((DWORD)milliseconds);
 }
+
+/**
+ * Return a monotonic timestamp.
+ *
+ * @return  The current timestamp, in units of microseconds.
+ **/
+uint64_t libspdm_get_timestamp_us(void)
+{
+    LARGE_INTEGER frequency;
+    LARGE_INTEGER counter;
+
+    if (!QueryPerformanceFrequency(&frequency) || !QueryPerformanceCounter(&counter)) {
+        return 0;
+    }
+    return (uint64_t)(counter.QuadPart / frequency.QuadPart) * 1000000 +
+           (uint64_t)(counter.QuadPart % frequency.QuadPart) * 1000000 /
+           (uint64_t)frequency.QuadPart;
+}
@@ -15,3 +15,13 @@
 void libspdm_sleep(uint64_t microseconds)
 {
 }
+
+/**
+ * Return a monotonic timestamp.
+ *
+ * @return  The current timestamp, in units of microseconds.
+ **/
+uint64_t libspdm_get_timestamp_us(void)
+{
+    return 0;
+}
@@ -228,6 +228,134 @@ bool libspdm_measurement_hash_all(uint32_t measurement_hash_algo,
     return hash_function(data, data_size, hash_value);
 }
 
+/* The number of chunk hashes computed by one dispatch in manifest mode. */
+#define LIBSPDM_MEASUREMENT_HASH_CHUNK_BATCH 32
+
+typedef struct {
+    uint32_t measurement_hash_algo;
+    const uint8_t *data;
+    size_t data_size;
+    bool result;
+    uint8_t hash_value[LIBSPDM_MAX_HASH_SIZE];
+} libspdm_measurement_hash_chunk_task_t;
+
+static void libspdm_measurement_hash_chunk_task(void *task_param)
+{
+    libspdm_measurement_hash_chunk_task_t *task;
+
+    task = task_param;
+    task->result = libspdm_measurement_hash_all(task->measurement_hash_algo,
+                                                task->data, task->data_size,
+                                                task->hash_value);
+}
+
+/**
+ * Return the base hash algorithm of the same hash function as a measurement hash algorithm.
+ *
+ * @return base_hash_algo, or 0 if the measurement hash algorithm is not a hash function.
+ **/
+static uint32_t libspdm_measurement_hash_algo_to_base_hash_algo(uint32_t measurement_hash_algo)
+{
+    switch (measurement_hash_algo) {
+    case SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_TPM_ALG_SHA_256:
+        return SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_256;
+    case SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_TPM_ALG_SHA_384:
+        return SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_384;
+    case SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_TPM_ALG_SHA_512:
+        return SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_512;
+    case SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_TPM_ALG_SHA3_256:
+        return SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA3_256;
+    case SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_TPM_ALG_SHA3_384:
+        return SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA3_384;
+    case SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_TPM_ALG_SHA3_512:
+        return SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA3_512;
+    case SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_TPM_ALG_SM3_256:
+        return SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SM3_256;
+    default:
+        return 0;
+    }
+}
+
+bool libspdm_measurement_hash_all_chunked(uint32_t measurement_hash_algo,
+                                          const void *data, size_t data_size,
+                                          size_t chunk_size, bool is_manifest,
+                                          libspdm_dispatch_task_func dispatch_task,
+                                          void *dispatch_context,
+                                          uint8_t *hash_value)
+{
+    libspdm_measurement_hash_chunk_task_t task[LIBSPDM_MEASUREMENT_HASH_CHUNK_BATCH];
+    uint32_t base_hash_algo;
+    void *hash_context;
+    const uint8_t *ptr;
+    size_t remaining_size;
+    size_t size_in_chunk;
+    size_t task_count;
+    size_t hash_size;
+    size_t index;
+    bool result;
+
+    if (chunk_size == 0) {
+        return false;
+    }
+    base_hash_algo = libspdm_measurement_hash_algo_to_base_hash_algo(measurement_hash_algo);
+    if (base_hash_algo == 0) {
+        return false;
+    }
+    hash_size = libspdm_get_hash_size(base_hash_algo);
+
+    hash_context = libspdm_hash_new(base_hash_algo);
+    if (hash_context == NULL) {
+        return false;
+    }
+    result = libspdm_hash_init(base_hash_algo, hash_context);
+
+    ptr = data;
+    remaining_size = data_size;
+    while (result && (remaining_size > 0)) {
+        if (!is_manifest) {
+            size_in_chunk = (remaining_size < chunk_size) ? remaining_size : chunk_size;
+            result = libspdm_hash_update(base_hash_algo, hash_context, ptr, size_in_chunk);
+            ptr += size_in_chunk;
+            remaining_size -= size_in_chunk;
+            continue;
+        }
+
+        for (task_count = 0;
+             (task_count < LIBSPDM_MEASUREMENT_HASH_CHUNK_BATCH) && (remaining_size > 0);
+             task_count++) {
+            task[task_count].measurement_hash_algo = measurement_hash_algo;
+            task[task_count].data = ptr;
+            task[task_count].data_size =
+                (remaining_size < chunk_size) ? remaining_size : chunk_size;
+            task[task_count].result = false;
+            ptr += task[task_count].data_size;
+            remaining_size -= task[task_count].data_size;
+        }
+
+        if ((dispatch_task == NULL) ||
+            !dispatch_task(dispatch_context, libspdm_measurement_hash_chunk_task,
+                           task, sizeof(task[0]), task_count)) {
+            for (index = 0; index < task_count; index++) {
+                libspdm_measurement_hash_chunk_task(&task[index]);
+            }
+        }
+
+        /* Reduce in chunk order so the result does not depend on the scheduling. */
+        for (index = 0; (index < task_count) && result; index++) {
+            result = task[index].result &&
+                     libspdm_hash_update(base_hash_algo, hash_context,
+                                         task[index].hash_value, hash_size);
+        }
+    }
+
+    if (result) {
+        result = libspdm_hash_final(base_hash_algo, hash_context, hash_value);
+    }
+    libspdm_hash_free(base_hash_algo, hash_context);
+
+    return result;
+}
+
 size_t libspdm_get_aysm_nid(uint32_t base_asym_algo)
 {
     switch (base_asym_algo)
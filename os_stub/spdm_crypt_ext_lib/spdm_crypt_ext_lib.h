@@ -8,6 +8,7 @@
 #define SPDM_CRYPT_EXT_LIB_H
 
 #include "hal/base.h"
+#include "library/spdm_crypt_lib.h"
 
 /**
  * Retrieve the Private key from the password-protected PEM key data.
@@ -92,4 +93,34 @@ bool libspdm_measurement_hash_all(uint32_t measurement_hash_algo,
                                   const void *data, size_t data_size,
                                   uint8_t *hash_value);
 
+/**
+ * Computes the measurement hash of a large input data buffer, processing chunk_size bytes at a time.
+ *
+ * If is_manifest is false, the hash value is the hash of the data buffer, identical to
+ * libspdm_measurement_hash_all. The chunks are streamed into one hash in order.
+ *
+ * If is_manifest is true, each chunk is hashed independently, through dispatch_task if it is not
+ * NULL, and the hash value is the hash of the concatenated chunk hashes in chunk order:
+ * H(H(chunk_0) || H(chunk_1) || ... || H(chunk_n-1)). The result only depends on the data and
+ * chunk_size.
+ *
+ * @param  measurement_hash_algo  SPDM measurement_hash_algo
+ * @param  data                   Pointer to the buffer containing the data to be hashed.
+ * @param  data_size              Size of data buffer in bytes.
+ * @param  chunk_size             Size of one chunk in bytes.
+ * @param  is_manifest            Indicates if the chunk hashes are combined into a manifest hash.
+ * @param  dispatch_task          The function to dispatch the chunk hashes, or NULL to hash serially.
+ * @param  dispatch_context       The context passed to dispatch_task.
+ * @param  hash_value             Pointer to a buffer that receives the hash value.
+ *
+ * @retval true   Hash computation succeeded.
+ * @retval false  Hash computation failed.
+ **/
+bool libspdm_measurement_hash_all_chunked(uint32_t measurement_hash_algo,
+                                          const void *data, size_t data_size,
+                                          size_t chunk_size, bool is_manifest,
+                                          libspdm_dispatch_task_func dispatch_task,
+                                          void *dispatch_context,
+                                          uint8_t *hash_value);
+
 #endif /* SPDM_CRYPT_EXT_LIB_H */
@@ -27,6 +27,23 @@ libspdm_return_t libspdm_measurement_collection(
     return LIBSPDM_STATUS_UNSUPPORTED_CAP;
 }
 
+#if LIBSPDM_MEASUREMENT_COLLECTION_EX_SUPPORT
+libspdm_return_t libspdm_measurement_collection_ex(
+    spdm_version_number_t spdm_version,
+    uint8_t measurement_specification,
+    uint32_t measurement_hash_algo,
+    uint8_t mesurements_index,
+    uint8_t request_attribute,
+    uint8_t *content_changed,
+    uint8_t *device_measurement_count,
+    void *device_measurement,
+    size_t *device_measurement_size,
+    uint32_t *transcript_state)
+{
+    return LIBSPDM_STATUS_UNSUPPORTED_CAP;
+}
+#endif /* LIBSPDM_MEASUREMENT_COLLECTION_EX_SUPPORT */
+
 bool libspdm_generate_measurement_summary_hash(
     spdm_version_number_t spdm_version,
     uint32_t base_hash_algo,
@@ -1249,6 +1249,9 @@ size_t libspdm_fill_measurement_image_hash_block (
     size_t hash_size;
     uint8_t data[LIBSPDM_MEASUREMENT_RAW_DATA_SIZE];
     bool result;
+#if LIBSPDM_MEASUREMENT_IMAGE_FILE_SUPPORT
+    bool measured;
+#endif
 
     hash_size = libspdm_get_measurement_hash_size(measurement_hash_algo);
 
@@ -1273,6 +1276,17 @@ size_t libspdm_fill_measurement_image_hash_block (
             (uint16_t)(sizeof(spdm_measurement_block_dmtf_header_t) +
                        (uint16_t)hash_size);
 
+#if LIBSPDM_MEASUREMENT_IMAGE_FILE_SUPPORT
+        result = libspdm_measure_image_block(measurements_index, measurement_hash_algo,
+                                             &measured, (void *)(measurement_block + 1));
+        if (!result) {
+            return 0;
+        }
+        if (measured) {
+            return sizeof(spdm_measurement_block_dmtf_t) + hash_size;
+        }
+#endif
+
         result = libspdm_measurement_hash_all(
             measurement_hash_algo, data,
             sizeof(data),
@@ -1433,7 +1447,181 @@ size_t libspdm_fill_measurement_device_mode_block (
     return sizeof(spdm_measurement_block_dmtf_t) + sizeof(device_mode);
 }
 
-libspdm_return_t libspdm_measurement_collection(
+/* Pre-serialized measurement blocks for one measurement hash algo and representation. */
+typedef struct {
+    uint32_t measurement_hash_algo; /* 0 if the entry is empty */
+    bool use_bit_stream;
+    uint32_t generation;
+    uint8_t block_index[LIBSPDM_MEASUREMENT_BLOCK_NUMBER];
+    size_t block_offset[LIBSPDM_MEASUREMENT_BLOCK_NUMBER];
+    size_t block_size[LIBSPDM_MEASUREMENT_BLOCK_NUMBER];
+    size_t record_size;
+    uint8_t record[LIBSPDM_MAX_MEASUREMENT_RECORD_SIZE];
+} libspdm_measurement_store_entry_t;
+
+static libspdm_measurement_store_entry_t
+    m_libspdm_measurement_store[LIBSPDM_MEASUREMENT_STORE_ENTRY_COUNT];
+static size_t m_libspdm_measurement_store_victim;
+static uint32_t m_libspdm_measurement_generation = 1;
+
+/* The generation when the L1/L2 transcript started, for content_changed, or 0 if none is started.
+ * libspdm_measurement_collection cannot tell transcripts apart, so it tracks a single one.
+ * libspdm_measurement_collection_ex uses the state that libspdm keeps per transcript instead. */
+static uint32_t m_libspdm_measurement_transcript_generation;
+
+/**
+ * Serialize all measurement blocks into a store entry.
+ **/
+static bool libspdm_measurement_store_build(libspdm_measurement_store_entry_t *entry,
+                                            uint32_t measurement_hash_algo,
+                                            bool use_bit_stream)
+{
+    spdm_measurement_block_dmtf_t *measurement_block;
+    size_t measurement_block_size;
+    size_t hash_size;
+    size_t total_size_needed;
+    uint8_t block;
+    uint8_t index;
+
+    hash_size = libspdm_get_measurement_hash_size(measurement_hash_algo);
+    LIBSPDM_ASSERT(hash_size != 0);
+
+    /* Calculate total_size_needed based on hash algo selected.
+     * If we have an hash algo, then the first HASH_NUMBER elements will be
+     * hash values, otherwise HASH_NUMBER raw bitstream values.*/
+    if (!use_bit_stream) {
+        total_size_needed =
+            LIBSPDM_MEASUREMENT_BLOCK_HASH_NUMBER *
+            (sizeof(spdm_measurement_block_dmtf_t) + hash_size);
+    } else {
+        total_size_needed =
+            LIBSPDM_MEASUREMENT_BLOCK_HASH_NUMBER *
+            (sizeof(spdm_measurement_block_dmtf_t) + LIBSPDM_MEASUREMENT_RAW_DATA_SIZE);
+    }
+    /* Next one - SVN is always raw bitstream data.*/
+    total_size_needed +=
+        (sizeof(spdm_measurement_block_dmtf_t) +
+         sizeof(spdm_measurements_secure_version_number_t));
+    /* Next one - manifest is always raw bitstream data.*/
+    total_size_needed +=
+        (sizeof(spdm_measurement_block_dmtf_t) + LIBSPDM_MEASUREMENT_MANIFEST_SIZE);
+    /* Next one - device_mode is always raw bitstream data.*/
+    total_size_needed +=
+        (sizeof(spdm_measurement_block_dmtf_t) + sizeof(spdm_measurements_device_mode_t));
+
+    LIBSPDM_ASSERT(total_size_needed <= sizeof(entry->record));
+    if (total_size_needed > sizeof(entry->record)) {
+        return false;
+    }
+
+    libspdm_zero_mem(entry, sizeof(*entry));
+    measurement_block = (void *)entry->record;
+    for (block = 0; block < LIBSPDM_MEASUREMENT_BLOCK_NUMBER; block++) {
+        if (block < LIBSPDM_MEASUREMENT_BLOCK_HASH_NUMBER) {
+            /* The first HASH_NUMBER blocks may be hash values or raw bitstream*/
+            index = block + 1;
+            measurement_block_size = libspdm_fill_measurement_image_hash_block (use_bit_stream,
+                                                                                measurement_hash_algo,
+                                                                                index,
+                                                                                measurement_block);
+        } else if (block == LIBSPDM_MEASUREMENT_BLOCK_HASH_NUMBER) {
+            index = LIBSPDM_MEASUREMENT_INDEX_SVN;
+            measurement_block_size = libspdm_fill_measurement_svn_block (measurement_block);
+        } else if (block == LIBSPDM_MEASUREMENT_BLOCK_HASH_NUMBER + 1) {
+            index = SPDM_MEASUREMENT_BLOCK_MEASUREMENT_INDEX_MEASUREMENT_MANIFEST;
+            measurement_block_size = libspdm_fill_measurement_manifest_block (measurement_block);
+        } else {
+            index = SPDM_MEASUREMENT_BLOCK_MEASUREMENT_INDEX_DEVICE_MODE;
+            measurement_block_size = libspdm_fill_measurement_device_mode_block (
+                measurement_block);
+        }
+        if (measurement_block_size == 0) {
+            libspdm_zero_mem(entry, sizeof(*entry));
+            return false;
+        }
+        entry->block_index[block] = index;
+        entry->block_offset[block] = entry->record_size;
+        entry->block_size[block] = measurement_block_size;
+        entry->record_size += measurement_block_size;
+        measurement_block = (void *)((uint8_t *)measurement_block + measurement_block_size);
+    }
+    LIBSPDM_ASSERT(entry->record_size == total_size_needed);
+
+    entry->measurement_hash_algo = measurement_hash_algo;
+    entry->use_bit_stream = use_bit_stream;
+    entry->generation = m_libspdm_measurement_generation;
+
+    return true;
+}
+
+/**
+ * Find the store entry of the current generation, or build it.
+ *
+ * @return the store entry, or NULL if the measurement blocks cannot be built.
+ **/
+static libspdm_measurement_store_entry_t *libspdm_measurement_store_get(
+    uint32_t measurement_hash_algo, bool use_bit_stream)
+{
+    libspdm_measurement_store_entry_t *entry;
+    size_t index;
+
+    entry = NULL;
+    for (index = 0; index < LIBSPDM_MEASUREMENT_STORE_ENTRY_COUNT; index++) {
+        if ((m_libspdm_measurement_store[index].measurement_hash_algo ==
+             measurement_hash_algo) &&
+            (m_libspdm_measurement_store[index].use_bit_stream == use_bit_stream)) {
+            entry = &m_libspdm_measurement_store[index];
+            if (entry->generation == m_libspdm_measurement_generation) {
+                return entry;
+            }
+            break;
+        }
+    }
+
+    if (entry == NULL) {
+        for (index = 0; index < LIBSPDM_MEASUREMENT_STORE_ENTRY_COUNT; index++) {
+            if (m_libspdm_measurement_store[index].measurement_hash_algo == 0) {
+                entry = &m_libspdm_measurement_store[index];
+                break;
+            }
+        }
+    }
+    if (entry == NULL) {
+        entry = &m_libspdm_measurement_store[m_libspdm_measurement_store_victim];
+        m_libspdm_measurement_store_victim =
+            (m_libspdm_measurement_store_victim + 1) % LIBSPDM_MEASUREMENT_STORE_ENTRY_COUNT;
+    }
+
+    if (!libspdm_measurement_store_build(entry, measurement_hash_algo, use_bit_stream)) {
+        return NULL;
+    }
+    return entry;
+}
+
+void libspdm_measurement_store_invalidate(void)
+{
+    m_libspdm_measurement_generation++;
+    /* 0 is never a valid generation of a store entry. */
+    if (m_libspdm_measurement_generation == 0) {
+        m_libspdm_measurement_generation++;
+    }
+}
+
+bool libspdm_measurement_store_update(uint32_t measurement_hash_algo, bool use_bit_stream)
+{
+    return libspdm_measurement_store_get(measurement_hash_algo, use_bit_stream) != NULL;
+}
+
+uint32_t libspdm_measurement_store_get_generation(void)
+{
+    return m_libspdm_measurement_generation;
+}
+
+/**
+ * Collect the measurements, and report content_changed against the generation stored in
+ * transcript_generation when the L1/L2 transcript started.
+ **/
+static libspdm_return_t libspdm_measurement_collect(
     spdm_version_number_t spdm_version,
     uint8_t measurement_specification,
     uint32_t measurement_hash_algo,
@@ -1442,14 +1630,12 @@ libspdm_return_t libspdm_measurement_collection(
     uint8_t *content_changed,
     uint8_t *measurements_count,
     void *measurements,
-    size_t *measurements_size)
+    size_t *measurements_size,
+    uint32_t *transcript_generation)
 {
-    spdm_measurement_block_dmtf_t *measurement_block;
-    size_t hash_size;
-    uint8_t index;
-    size_t total_size_needed;
+    libspdm_measurement_store_entry_t *entry;
+    uint8_t block;
     bool use_bit_stream;
-    size_t measurement_block_size;
 
     if ((measurement_specification !=
          SPDM_MEASUREMENT_BLOCK_HEADER_SPECIFICATION_DMTF) ||
@@ -1457,9 +1643,6 @@ libspdm_return_t libspdm_measurement_collection(
         return LIBSPDM_STATUS_UNSUPPORTED_CAP;
     }
 
-    hash_size = libspdm_get_measurement_hash_size(measurement_hash_algo);
-    LIBSPDM_ASSERT(hash_size != 0);
-
     use_bit_stream = false;
     if ((measurement_hash_algo == SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_RAW_BIT_STREAM_ONLY) ||
         ((request_attribute & SPDM_GET_MEASUREMENTS_REQUEST_ATTRIBUTES_RAW_BIT_STREAM_REQUESTED) !=
@@ -1471,162 +1654,63 @@ libspdm_return_t libspdm_measurement_collection(
         SPDM_GET_MEASUREMENTS_REQUEST_MEASUREMENT_OPERATION_TOTAL_NUMBER_OF_MEASUREMENTS) {
         *measurements_count = LIBSPDM_MEASUREMENT_BLOCK_NUMBER;
         goto successful_return;
-    } else if (measurements_index ==
-               SPDM_GET_MEASUREMENTS_REQUEST_MEASUREMENT_OPERATION_ALL_MEASUREMENTS) {
-
-        /* Calculate total_size_needed based on hash algo selected.
-         * If we have an hash algo, then the first HASH_NUMBER elements will be
-         * hash values, otherwise HASH_NUMBER raw bitstream values.*/
-        if (!use_bit_stream) {
-            total_size_needed =
-                LIBSPDM_MEASUREMENT_BLOCK_HASH_NUMBER *
-                (sizeof(spdm_measurement_block_dmtf_t) + hash_size);
-        } else {
-            total_size_needed =
-                LIBSPDM_MEASUREMENT_BLOCK_HASH_NUMBER *
-                (sizeof(spdm_measurement_block_dmtf_t) + LIBSPDM_MEASUREMENT_RAW_DATA_SIZE);
-        }
-        /* Next one - SVN is always raw bitstream data.*/
-        total_size_needed +=
-            (sizeof(spdm_measurement_block_dmtf_t) +
-             sizeof(spdm_measurements_secure_version_number_t));
-        /* Next one - manifest is always raw bitstream data.*/
-        total_size_needed +=
-            (sizeof(spdm_measurement_block_dmtf_t) + LIBSPDM_MEASUREMENT_MANIFEST_SIZE);
-        /* Next one - device_mode is always raw bitstream data.*/
-        total_size_needed +=
-            (sizeof(spdm_measurement_block_dmtf_t) + sizeof(spdm_measurements_device_mode_t));
-
-        LIBSPDM_ASSERT(total_size_needed <= *measurements_size);
-        if (total_size_needed > *measurements_size) {
-            return LIBSPDM_STATUS_BUFFER_TOO_SMALL;
-        }
+    }
 
-        *measurements_size = total_size_needed;
-        *measurements_count = LIBSPDM_MEASUREMENT_BLOCK_NUMBER;
-        measurement_block = measurements;
+    entry = libspdm_measurement_store_get(measurement_hash_algo, use_bit_stream);
+    if (entry == NULL) {
+        return LIBSPDM_STATUS_MEAS_INTERNAL_ERROR;
+    }
 
-        /* The first HASH_NUMBER blocks may be hash values or raw bitstream*/
-        for (index = 1; index <= LIBSPDM_MEASUREMENT_BLOCK_HASH_NUMBER; index++) {
-            measurement_block_size = libspdm_fill_measurement_image_hash_block (use_bit_stream,
-                                                                                measurement_hash_algo,
-                                                                                index,
-                                                                                measurement_block);
-            if (measurement_block_size == 0) {
-                return LIBSPDM_STATUS_MEAS_INTERNAL_ERROR;
-            }
-            measurement_block = (void *)((uint8_t *)measurement_block + measurement_block_size);
-        }
-        /* Next one - SVN is always raw bitstream data.*/
-        {
-            measurement_block_size = libspdm_fill_measurement_svn_block (measurement_block);
-            measurement_block = (void *)((uint8_t *)measurement_block + measurement_block_size);
-        }
-        /* Next one - manifest is always raw bitstream data.*/
-        {
-            measurement_block_size = libspdm_fill_measurement_manifest_block (measurement_block);
-            measurement_block = (void *)((uint8_t *)measurement_block + measurement_block_size);
-        }
-        /* Next one - device_mode is always raw bitstream data.*/
-        {
-            measurement_block_size = libspdm_fill_measurement_device_mode_block (measurement_block);
-            measurement_block = (void *)((uint8_t *)measurement_block + measurement_block_size);
+    if (measurements_index ==
+        SPDM_GET_MEASUREMENTS_REQUEST_MEASUREMENT_OPERATION_ALL_MEASUREMENTS) {
+        LIBSPDM_ASSERT(entry->record_size <= *measurements_size);
+        if (entry->record_size > *measurements_size) {
+            return LIBSPDM_STATUS_BUFFER_TOO_SMALL;
         }
 
+        libspdm_copy_mem(measurements, *measurements_size, entry->record, entry->record_size);
+        *measurements_size = entry->record_size;
+        *measurements_count = LIBSPDM_MEASUREMENT_BLOCK_NUMBER;
         goto successful_return;
-    } else {
-        /* One Index */
-        if (measurements_index <= LIBSPDM_MEASUREMENT_BLOCK_HASH_NUMBER) {
-            if (!use_bit_stream) {
-                total_size_needed =
-                    sizeof(spdm_measurement_block_dmtf_t) +
-                    hash_size;
-            } else {
-                total_size_needed =
-                    sizeof(spdm_measurement_block_dmtf_t) +
-                    LIBSPDM_MEASUREMENT_RAW_DATA_SIZE;
-            }
-            LIBSPDM_ASSERT(total_size_needed <= *measurements_size);
-            if (total_size_needed > *measurements_size) {
-                return LIBSPDM_STATUS_BUFFER_TOO_SMALL;
-            }
-
-            *measurements_count = 1;
-            *measurements_size = total_size_needed;
-
-            measurement_block = measurements;
-            measurement_block_size = libspdm_fill_measurement_image_hash_block (use_bit_stream,
-                                                                                measurement_hash_algo,
-                                                                                measurements_index,
-                                                                                measurement_block);
-            if (measurement_block_size == 0) {
-                return LIBSPDM_STATUS_MEAS_INTERNAL_ERROR;
-            }
-        } else if (measurements_index == LIBSPDM_MEASUREMENT_INDEX_SVN) {
-            total_size_needed =
-                sizeof(spdm_measurement_block_dmtf_t) +
-                sizeof(spdm_measurements_secure_version_number_t);
-            LIBSPDM_ASSERT(total_size_needed <= *measurements_size);
-            if (total_size_needed > *measurements_size) {
-                return LIBSPDM_STATUS_BUFFER_TOO_SMALL;
-            }
-
-            *measurements_count = 1;
-            *measurements_size = total_size_needed;
-
-            measurement_block = measurements;
-            measurement_block_size = libspdm_fill_measurement_svn_block (measurement_block);
-            if (measurement_block_size == 0) {
-                return LIBSPDM_STATUS_MEAS_INTERNAL_ERROR;
-            }
-        } else if (measurements_index ==
-                   SPDM_MEASUREMENT_BLOCK_MEASUREMENT_INDEX_MEASUREMENT_MANIFEST) {
-            total_size_needed =
-                sizeof(spdm_measurement_block_dmtf_t) +
-                LIBSPDM_MEASUREMENT_MANIFEST_SIZE;
-            LIBSPDM_ASSERT(total_size_needed <= *measurements_size);
-            if (total_size_needed > *measurements_size) {
-                return LIBSPDM_STATUS_BUFFER_TOO_SMALL;
-            }
-
-            *measurements_count = 1;
-            *measurements_size = total_size_needed;
-
-            measurement_block = measurements;
-            measurement_block_size = libspdm_fill_measurement_manifest_block (measurement_block);
-            if (measurement_block_size == 0) {
-                return LIBSPDM_STATUS_MEAS_INTERNAL_ERROR;
-            }
-        } else if (measurements_index == SPDM_MEASUREMENT_BLOCK_MEASUREMENT_INDEX_DEVICE_MODE) {
-            total_size_needed =
-                sizeof(spdm_measurement_block_dmtf_t) +
-                sizeof(spdm_measurements_device_mode_t);
-            LIBSPDM_ASSERT(total_size_needed <= *measurements_size);
-            if (total_size_needed > *measurements_size) {
-                return LIBSPDM_STATUS_BUFFER_TOO_SMALL;
-            }
-
-            *measurements_count = 1;
-            *measurements_size = total_size_needed;
+    }
 
-            measurement_block = measurements;
-            measurement_block_size = libspdm_fill_measurement_device_mode_block (measurement_block);
-            if (measurement_block_size == 0) {
-                return LIBSPDM_STATUS_MEAS_INTERNAL_ERROR;
-            }
-        } else {
-            *measurements_count = 0;
-            return LIBSPDM_STATUS_MEAS_INVALID_INDEX;
+    /* One Index */
+    for (block = 0; block < LIBSPDM_MEASUREMENT_BLOCK_NUMBER; block++) {
+        if (entry->block_index[block] == measurements_index) {
+            break;
         }
     }
+    if (block == LIBSPDM_MEASUREMENT_BLOCK_NUMBER) {
+        *measurements_count = 0;
+        return LIBSPDM_STATUS_MEAS_INVALID_INDEX;
+    }
+
+    LIBSPDM_ASSERT(entry->block_size[block] <= *measurements_size);
+    if (entry->block_size[block] > *measurements_size) {
+        return LIBSPDM_STATUS_BUFFER_TOO_SMALL;
+    }
+
+    libspdm_copy_mem(measurements, *measurements_size,
+                     entry->record + entry->block_offset[block], entry->block_size[block]);
+    *measurements_size = entry->block_size[block];
+    *measurements_count = 1;
 
 successful_return:
     if ((content_changed != NULL) &&
         ((spdm_version >> SPDM_VERSION_NUMBER_SHIFT_BIT) >= SPDM_MESSAGE_VERSION_12)) {
+        if (*transcript_generation == 0) {
+            *transcript_generation = m_libspdm_measurement_generation;
+        }
         /* return content change*/
         if ((request_attribute & SPDM_GET_MEASUREMENTS_REQUEST_ATTRIBUTES_GENERATE_SIGNATURE) !=
             0) {
-            *content_changed = SPDM_MEASUREMENTS_RESPONSE_CONTENT_NO_CHANGE_DETECTED;
+            if (*transcript_generation == m_libspdm_measurement_generation) {
+                *content_changed = SPDM_MEASUREMENTS_RESPONSE_CONTENT_NO_CHANGE_DETECTED;
+            } else {
+                *content_changed = SPDM_MEASUREMENTS_RESPONSE_CONTENT_CHANGE_DETECTED;
+            }
+            /* The signature ends the transcript. */
+            *transcript_generation = 0;
         } else {
             *content_changed = SPDM_MEASUREMENTS_RESPONSE_CONTENT_CHANGE_NO_DETECTION;
         }
@@ -1635,6 +1719,44 @@ successful_return:
     return LIBSPDM_STATUS_SUCCESS;
 }
 
+libspdm_return_t libspdm_measurement_collection(
+    spdm_version_number_t spdm_version,
+    uint8_t measurement_specification,
+    uint32_t measurement_hash_algo,
+    uint8_t measurements_index,
+    uint8_t request_attribute,
+    uint8_t *content_changed,
+    uint8_t *measurements_count,
+    void *measurements,
+    size_t *measurements_size)
+{
+    return libspdm_measurement_collect(spdm_version, measurement_specification,
+                                       measurement_hash_algo, measurements_index,
+                                       request_attribute, content_changed, measurements_count,
+                                       measurements, measurements_size,
+                                       &m_libspdm_measurement_transcript_generation);
+}
+
+#if LIBSPDM_MEASUREMENT_COLLECTION_EX_SUPPORT
+libspdm_return_t libspdm_measurement_collection_ex(
+    spdm_version_number_t spdm_version,
+    uint8_t measurement_specification,
+    uint32_t measurement_hash_algo,
+    uint8_t measurements_index,
+    uint8_t request_attribute,
+    uint8_t *content_changed,
+    uint8_t *measurements_count,
+    void *measurements,
+    size_t *measurements_size,
+    uint32_t *transcript_state)
+{
+    return libspdm_measurement_collect(spdm_version, measurement_specification,
+                                       measurement_hash_algo, measurements_index,
+                                       request_attribute, content_changed, measurements_count,
+                                       measurements, measurements_size, transcript_state);
+}
+#endif /* LIBSPDM_MEASUREMENT_COLLECTION_EX_SUPPORT */
+
 bool libspdm_generate_measurement_summary_hash(
     spdm_version_number_t spdm_version, uint32_t base_hash_algo,
     uint8_t measurement_specification, uint32_t measurement_hash_algo,
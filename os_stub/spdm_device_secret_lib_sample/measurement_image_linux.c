@@ -0,0 +1,275 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2021-2022 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+/* Measurement of large images on Linux responder hosts. */
+
+#define _DEFAULT_SOURCE
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "spdm_device_secret_lib_internal.h"
+
+#define LIBSPDM_THREAD_POOL_MAX_THREAD_COUNT 64
+
+typedef struct {
+    pthread_mutex_t mutex;
+    pthread_cond_t work_cond;
+    pthread_cond_t done_cond;
+    pthread_t thread[LIBSPDM_THREAD_POOL_MAX_THREAD_COUNT];
+    size_t thread_count;
+    bool stop;
+    /* The batch being dispatched. The batch is complete when done_count reaches task_count. */
+    libspdm_task_func task_func;
+    uint8_t *task_param_array;
+    size_t task_param_size;
+    size_t task_count;
+    size_t next_task;
+    size_t done_count;
+} libspdm_thread_pool_t;
+
+/* The image file measured for each hash measurement block, NULL if the block uses sample data. */
+typedef struct {
+    char *file_name;
+    bool is_manifest;
+} libspdm_measurement_image_t;
+
+static libspdm_measurement_image_t
+    m_libspdm_measurement_image[LIBSPDM_MEASUREMENT_BLOCK_HASH_NUMBER];
+static void *m_libspdm_measurement_thread_pool;
+
+/**
+ * Run the tasks of the current batch until none is left. The pool mutex is held on entry and on
+ * return.
+ **/
+static void libspdm_thread_pool_run_tasks(libspdm_thread_pool_t *pool)
+{
+    size_t index;
+
+    while (pool->next_task < pool->task_count) {
+        index = pool->next_task++;
+        pthread_mutex_unlock(&pool->mutex);
+        pool->task_func(pool->task_param_array + index * pool->task_param_size);
+        pthread_mutex_lock(&pool->mutex);
+        pool->done_count++;
+        if (pool->done_count == pool->task_count) {
+            pthread_cond_broadcast(&pool->done_cond);
+        }
+    }
+}
+
+static void *libspdm_thread_pool_worker(void *arg)
+{
+    libspdm_thread_pool_t *pool;
+
+    pool = arg;
+    pthread_mutex_lock(&pool->mutex);
+    for (;;) {
+        while (!pool->stop && (pool->next_task >= pool->task_count)) {
+            pthread_cond_wait(&pool->work_cond, &pool->mutex);
+        }
+        if (pool->stop) {
+            break;
+        }
+        libspdm_thread_pool_run_tasks(pool);
+    }
+    pthread_mutex_unlock(&pool->mutex);
+    return NULL;
+}
+
+void *libspdm_thread_pool_new(void)
+{
+    libspdm_thread_pool_t *pool;
+    long cpu_count;
+    size_t thread_count;
+
+    pool = calloc(1, sizeof(libspdm_thread_pool_t));
+    if (pool == NULL) {
+        return NULL;
+    }
+    if (pthread_mutex_init(&pool->mutex, NULL) != 0) {
+        free(pool);
+        return NULL;
+    }
+    pthread_cond_init(&pool->work_cond, NULL);
+    pthread_cond_init(&pool->done_cond, NULL);
+
+    /* The dispatching thread is one of the workers. */
+    cpu_count = sysconf(_SC_NPROCESSORS_ONLN);
+    thread_count = (cpu_count > 1) ? (size_t)cpu_count - 1 : 0;
+    if (thread_count > LIBSPDM_THREAD_POOL_MAX_THREAD_COUNT) {
+        thread_count = LIBSPDM_THREAD_POOL_MAX_THREAD_COUNT;
+    }
+    for (pool->thread_count = 0; pool->thread_count < thread_count; pool->thread_count++) {
+        if (pthread_create(&pool->thread[pool->thread_count], NULL,
+                           libspdm_thread_pool_worker, pool) != 0) {
+            break;
+        }
+    }
+
+    return pool;
+}
+
+void libspdm_thread_pool_free(void *thread_pool)
+{
+    libspdm_thread_pool_t *pool;
+    size_t index;
+
+    if (thread_pool == NULL) {
+        return;
+    }
+    pool = thread_pool;
+
+    pthread_mutex_lock(&pool->mutex);
+    pool->stop = true;
+    pthread_cond_broadcast(&pool->work_cond);
+    pthread_mutex_unlock(&pool->mutex);
+    for (index = 0; index < pool->thread_count; index++) {
+        pthread_join(pool->thread[index], NULL);
+    }
+
+    pthread_cond_destroy(&pool->done_cond);
+    pthread_cond_destroy(&pool->work_cond);
+    pthread_mutex_destroy(&pool->mutex);
+    free(pool);
+}
+
+bool libspdm_thread_dispatch_task(void *dispatch_context,
+                                  libspdm_task_func task_func,
+                                  void *task_param_array,
+                                  size_t task_param_size,
+                                  size_t task_count)
+{
+    libspdm_thread_pool_t *pool;
+
+    pool = dispatch_context;
+    if (pool == NULL) {
+        return false;
+    }
+
+    pthread_mutex_lock(&pool->mutex);
+    /* Wait for the batch of another dispatching thread. */
+    while (pool->done_count < pool->task_count) {
+        pthread_cond_wait(&pool->done_cond, &pool->mutex);
+    }
+    pool->task_func = task_func;
+    pool->task_param_array = task_param_array;
+    pool->task_param_size = task_param_size;
+    pool->task_count = task_count;
+    pool->next_task = 0;
+    pool->done_count = 0;
+    pthread_cond_broadcast(&pool->work_cond);
+
+    libspdm_thread_pool_run_tasks(pool);
+    while (pool->done_count < pool->task_count) {
+        pthread_cond_wait(&pool->done_cond, &pool->mutex);
+    }
+    pthread_mutex_unlock(&pool->mutex);
+
+    return true;
+}
+
+bool libspdm_measure_image_file(const char *file_name, uint32_t measurement_hash_algo,
+                                size_t chunk_size, bool is_manifest,
+                                libspdm_dispatch_task_func dispatch_task,
+                                void *dispatch_context, uint8_t *hash_value)
+{
+    struct stat file_stat;
+    void *image;
+    size_t image_size;
+    int fd;
+    bool result;
+
+    fd = open(file_name, O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    if (fstat(fd, &file_stat) != 0) {
+        close(fd);
+        return false;
+    }
+    image_size = (size_t)file_stat.st_size;
+
+    if (image_size == 0) {
+        close(fd);
+        return libspdm_measurement_hash_all(measurement_hash_algo, NULL, 0, hash_value);
+    }
+
+    image = mmap(NULL, image_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (image == MAP_FAILED) {
+        return false;
+    }
+    /* Flat hashing reads the image front to back, manifest chunks are read concurrently. */
+    madvise(image, image_size, is_manifest ? MADV_WILLNEED : MADV_SEQUENTIAL);
+
+    result = libspdm_measurement_hash_all_chunked(measurement_hash_algo, image, image_size,
+                                                  chunk_size, is_manifest,
+                                                  dispatch_task, dispatch_context,
+                                                  hash_value);
+
+    munmap(image, image_size);
+    return result;
+}
+
+bool libspdm_measurement_set_image_file(uint8_t measurements_index, const char *file_name,
+                                        bool is_manifest)
+{
+    libspdm_measurement_image_t *image;
+    char *image_file_name;
+
+    if ((measurements_index == 0) ||
+        (measurements_index > LIBSPDM_MEASUREMENT_BLOCK_HASH_NUMBER)) {
+        return false;
+    }
+    image = &m_libspdm_measurement_image[measurements_index - 1];
+
+    image_file_name = NULL;
+    if (file_name != NULL) {
+        image_file_name = strdup(file_name);
+        if (image_file_name == NULL) {
+            return false;
+        }
+        if (is_manifest && (m_libspdm_measurement_thread_pool == NULL)) {
+            /* Serial hashing is used if the pool cannot be created. */
+            m_libspdm_measurement_thread_pool = libspdm_thread_pool_new();
+        }
+    }
+    free(image->file_name);
+    image->file_name = image_file_name;
+    image->is_manifest = is_manifest;
+
+    libspdm_measurement_store_invalidate();
+    return true;
+}
+
+bool libspdm_measure_image_block(uint8_t measurements_index, uint32_t measurement_hash_algo,
+                                 bool *measured, uint8_t *hash_value)
+{
+    libspdm_measurement_image_t *image;
+
+    *measured = false;
+    if ((measurements_index == 0) ||
+        (measurements_index > LIBSPDM_MEASUREMENT_BLOCK_HASH_NUMBER)) {
+        return true;
+    }
+    image = &m_libspdm_measurement_image[measurements_index - 1];
+    if (image->file_name == NULL) {
+        return true;
+    }
+
+    *measured = true;
+    return libspdm_measure_image_file(
+        image->file_name, measurement_hash_algo, LIBSPDM_MEASUREMENT_IMAGE_CHUNK_SIZE,
+        image->is_manifest,
+        (m_libspdm_measurement_thread_pool != NULL) ? libspdm_thread_dispatch_task : NULL,
+        m_libspdm_measurement_thread_pool, hash_value);
+}
@@ -28,6 +28,9 @@
 #define LIBSPDM_MEASUREMENT_MANIFEST_SIZE 128
 #define LIBSPDM_MEASUREMENT_INDEX_SVN 0x10
 
+/* The number of measurement hash algo and representation combinations kept pre-serialized. */
+#define LIBSPDM_MEASUREMENT_STORE_ENTRY_COUNT 4
+
 #define LIBSPDM_TEST_PSK_DATA_STRING "TestPskData"
 #define LIBSPDM_TEST_PSK_HINT_STRING "TestPskHint"
 
@@ -85,6 +88,106 @@ bool libspdm_read_responder_public_key(
 bool libspdm_read_requester_public_key(
     uint16_t req_base_asym_alg, void **data, size_t *size);
 
+/* measurement store*/
+
+/**
+ * Invalidate the stored measurement blocks, for example after a firmware or configuration update.
+ *
+ * The measurement generation is incremented. The blocks are rebuilt on the next use and
+ * GET_MEASUREMENTS reports a content change for a transcript spanning the update.
+ **/
+void libspdm_measurement_store_invalidate(void);
+
+/**
+ * Build the measurement blocks of the current generation ahead of GET_MEASUREMENTS.
+ *
+ * @param  measurement_hash_algo  Indicates the measurement hash algorithm.
+ * @param  use_bit_stream         Indicates if the blocks carry raw bit stream instead of digests.
+ *
+ * @retval true  the measurement blocks are stored.
+ * @retval false the measurement blocks cannot be built.
+ **/
+bool libspdm_measurement_store_update(uint32_t measurement_hash_algo, bool use_bit_stream);
+
+/**
+ * Return the current measurement generation.
+ **/
+uint32_t libspdm_measurement_store_get_generation(void);
+
+/* large image measurement (Linux)*/
+
+/* The default chunk size for libspdm_measure_image_file. */
+#define LIBSPDM_MEASUREMENT_IMAGE_CHUNK_SIZE (1024 * 1024)
+
+/**
+ * Create a pool of worker threads that lives until libspdm_thread_pool_free.
+ * Together with the calling thread, the pool uses one thread per online CPU.
+ *
+ * @return the thread pool, or NULL if it cannot be created.
+ **/
+void *libspdm_thread_pool_new(void);
+
+/**
+ * Stop the worker threads of a pool created by libspdm_thread_pool_new and free it.
+ **/
+void libspdm_thread_pool_free(void *thread_pool);
+
+/**
+ * Dispatch a batch of independent tasks to the workers of a thread pool and the calling thread.
+ * It is a libspdm_dispatch_task_func. dispatch_context is the thread pool.
+ **/
+bool libspdm_thread_dispatch_task(void *dispatch_context,
+                                  libspdm_task_func task_func,
+                                  void *task_param_array,
+                                  size_t task_param_size,
+                                  size_t task_count);
+
+/**
+ * Measure an image file without copying it, by mapping it into memory.
+ *
+ * See libspdm_measurement_hash_all_chunked for the chunk_size, is_manifest, dispatch_task and
+ * dispatch_context parameters. If is_manifest is false, the hash value is the hash of the image.
+ *
+ * @param  file_name              The path of the image file.
+ * @param  measurement_hash_algo  SPDM measurement_hash_algo
+ * @param  hash_value             Pointer to a buffer that receives the hash value.
+ *
+ * @retval true   the image is measured.
+ * @retval false  the image cannot be read or hashed.
+ **/
+bool libspdm_measure_image_file(const char *file_name, uint32_t measurement_hash_algo,
+                                size_t chunk_size, bool is_manifest,
+                                libspdm_dispatch_task_func dispatch_task,
+                                void *dispatch_context, uint8_t *hash_value);
+
+/**
+ * Measure an image file for a hash measurement block (index 1 to
+ * LIBSPDM_MEASUREMENT_BLOCK_HASH_NUMBER), instead of the sample data. The file is read when the
+ * measurement blocks are built, so this invalidates the current measurements.
+ *
+ * If is_manifest is true, the chunks of the image are hashed by a thread pool. Otherwise the block
+ * holds the hash of the image.
+ *
+ * @param  file_name  The path of the image file, or NULL to measure the sample data again.
+ *
+ * @retval true   the image file is set.
+ * @retval false  the index is not a hash measurement block, or out of memory.
+ **/
+bool libspdm_measurement_set_image_file(uint8_t measurements_index, const char *file_name,
+                                        bool is_manifest);
+
+/**
+ * Measure the image file set for a hash measurement block.
+ *
+ * @param  measured  Set to true if an image file is set for the block, and false if the block
+ *                   uses the sample data.
+ *
+ * @retval true   the image is measured, or no image file is set.
+ * @retval false  the image cannot be read or hashed.
+ **/
+bool libspdm_measure_image_block(uint8_t measurements_index, uint32_t measurement_hash_algo,
+                                 bool *measured, uint8_t *hash_value);
+
 /* External*/
 
 bool libspdm_read_input_file(const char *file_name, void **file_data,
@@ -0,0 +1,188 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2021-2022 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+#define _POSIX_C_SOURCE 200112L
+
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <poll.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <time.h>
+
+#include "library/spdm_tcp_io_lib.h"
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+bool libspdm_tcp_io_init(libspdm_tcp_io_t *tcp_io, int socket_fd,
+                         void *buffer, size_t buffer_size)
+{
+    int flags;
+
+    flags = fcntl(socket_fd, F_GETFL, 0);
+    if ((flags == -1) || (fcntl(socket_fd, F_SETFL, flags | O_NONBLOCK) == -1)) {
+        return false;
+    }
+    tcp_io->socket = socket_fd;
+    libspdm_tcp_stream_init(&tcp_io->stream, buffer, buffer_size);
+    return true;
+}
+
+static libspdm_tcp_io_t *libspdm_tcp_io_get(void *spdm_context)
+{
+    libspdm_data_parameter_t parameter;
+    void *app_context_data;
+    size_t data_size;
+
+    memset(&parameter, 0, sizeof(parameter));
+    parameter.location = LIBSPDM_DATA_LOCATION_LOCAL;
+    app_context_data = NULL;
+    data_size = sizeof(app_context_data);
+    if (LIBSPDM_STATUS_IS_ERROR(libspdm_get_data(spdm_context, LIBSPDM_DATA_APP_CONTEXT_DATA,
+                                                 &parameter, &app_context_data,
+                                                 &data_size))) {
+        return NULL;
+    }
+    return app_context_data;
+}
+
+static uint64_t libspdm_tcp_io_now_us(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000 + (uint64_t)ts.tv_nsec / 1000;
+}
+
+/**
+ * Wait until the socket is ready for events, or the deadline passes.
+ *
+ * @param  socket_fd    The socket.
+ * @param  events       POLLIN or POLLOUT.
+ * @param  deadline_us  The deadline from libspdm_tcp_io_now_us, or 0 to wait indefinitely.
+ *
+ * @retval true   The socket is ready.
+ * @retval false  The deadline passed or poll failed.
+ **/
+static bool libspdm_tcp_io_wait(int socket_fd, short events, uint64_t deadline_us)
+{
+    struct pollfd poll_fd;
+    uint64_t now_us;
+    uint64_t timeout_ms;
+    int result;
+
+    for (;;) {
+        if (deadline_us == 0) {
+            timeout_ms = (uint64_t)-1;
+        } else {
+            now_us = libspdm_tcp_io_now_us();
+            if (now_us >= deadline_us) {
+                return false;
+            }
+            timeout_ms = (deadline_us - now_us + 999) / 1000;
+        }
+        poll_fd.fd = socket_fd;
+        poll_fd.events = events;
+        poll_fd.revents = 0;
+        result = poll(&poll_fd, 1, (timeout_ms > INT_MAX) ? -1 : (int)timeout_ms);
+        if (result > 0) {
+            return true;
+        }
+        if ((result < 0) && (errno != EINTR)) {
+            return false;
+        }
+    }
+}
+
+libspdm_return_t libspdm_tcp_io_send_message(void *spdm_context, size_t message_size,
+                                             const void *message, uint64_t timeout)
+{
+    libspdm_tcp_io_t *tcp_io;
+    const uint8_t *data;
+    uint64_t deadline_us;
+    ssize_t result;
+
+    tcp_io = libspdm_tcp_io_get(spdm_context);
+    if (tcp_io == NULL) {
+        return LIBSPDM_STATUS_SEND_FAIL;
+    }
+    deadline_us = (timeout == 0) ? 0 : libspdm_tcp_io_now_us() + timeout;
+
+    data = message;
+    while (message_size != 0) {
+        result = send(tcp_io->socket, data, message_size, MSG_NOSIGNAL);
+        if (result > 0) {
+            data += result;
+            message_size -= (size_t)result;
+            continue;
+        }
+        if ((result < 0) && (errno == EINTR)) {
+            continue;
+        }
+        if ((result == 0) || ((errno != EAGAIN) && (errno != EWOULDBLOCK))) {
+            return LIBSPDM_STATUS_SEND_FAIL;
+        }
+        if (!libspdm_tcp_io_wait(tcp_io->socket, POLLOUT, deadline_us)) {
+            return LIBSPDM_STATUS_SEND_FAIL;
+        }
+    }
+    return LIBSPDM_STATUS_SUCCESS;
+}
+
+libspdm_return_t libspdm_tcp_io_receive_message(void *spdm_context, size_t *message_size,
+                                                void **message, uint64_t timeout)
+{
+    libspdm_tcp_io_t *tcp_io;
+    libspdm_return_t status;
+    uint64_t deadline_us;
+    size_t frame_size;
+    void *frame;
+    size_t space_size;
+    void *space;
+    ssize_t result;
+
+    tcp_io = libspdm_tcp_io_get(spdm_context);
+    if (tcp_io == NULL) {
+        return LIBSPDM_STATUS_RECEIVE_FAIL;
+    }
+    deadline_us = (timeout == 0) ? 0 : libspdm_tcp_io_now_us() + timeout;
+
+    for (;;) {
+        status = libspdm_tcp_stream_get_message(&tcp_io->stream, &frame_size, &frame);
+        if (LIBSPDM_STATUS_IS_ERROR(status)) {
+            return LIBSPDM_STATUS_RECEIVE_FAIL;
+        }
+        if (frame != NULL) {
+            if (frame_size > *message_size) {
+                return LIBSPDM_STATUS_RECEIVE_FAIL;
+            }
+            memcpy(*message, frame, frame_size);
+            *message_size = frame_size;
+            return LIBSPDM_STATUS_SUCCESS;
+        }
+
+        libspdm_tcp_stream_get_free_space(&tcp_io->stream, &space_size, &space);
+        result = recv(tcp_io->socket, space, space_size, 0);
+        if (result > 0) {
+            libspdm_tcp_stream_append(&tcp_io->stream, (size_t)result);
+            continue;
+        }
+        if ((result < 0) && (errno == EINTR)) {
+            continue;
+        }
+        /* 0 is a closed connection. */
+        if ((result == 0) || ((errno != EAGAIN) && (errno != EWOULDBLOCK))) {
+            return LIBSPDM_STATUS_RECEIVE_FAIL;
+        }
+        if (!libspdm_tcp_io_wait(tcp_io->socket, POLLIN, deadline_us)) {
+            return LIBSPDM_STATUS_RECEIVE_FAIL;
+        }
+    }
+}
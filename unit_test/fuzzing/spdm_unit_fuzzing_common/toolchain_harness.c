@@ -40,7 +40,7 @@ bool libspdm_init_test_buffer(const char *file_name, size_t max_buffer_size,
     size_t BytesRead;
 
     /* 1. Allocate buffer*/
-    buffer = malloc(max_buffer_size);
+    buffer = allocate_pool(max_buffer_size);
     if (buffer == NULL) {
         return false;
     }
@@ -61,7 +61,7 @@ bool libspdm_init_test_buffer(const char *file_name, size_t max_buffer_size,
     file = fopen(file_name, "rb");
     if (file == NULL) {
         fputs("file error", stderr);
-        free(buffer);
+        free_pool(buffer);
         exit(1);
     }
     fseek(file, 0, SEEK_END);
@@ -71,14 +71,14 @@ bool libspdm_init_test_buffer(const char *file_name, size_t max_buffer_size,
 
     if (file_size == 0) {
         printf("\033[1;33m file_size of the seed file is 0, so exit.\033[0m \n");
-        free(buffer);
+        free_pool(buffer);
         exit(1);
     }
     file_size = file_size > max_buffer_size ? max_buffer_size : file_size;
     BytesRead = fread((char *)buffer, 1, file_size, file);
     if (BytesRead != file_size) {
         fputs("file error", stderr);
-        free(buffer);
+        free_pool(buffer);
         exit(1);
     }
     fclose(file);
@@ -110,7 +110,7 @@ int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
     }
     if (size == 0) {
         printf("\033[1;33m file_size of the seed file is 0, so exit.\033[0m \n");
-        free(test_buffer);
+        free_pool(test_buffer);
         return 0;
     }
     if (size > max_buffer_size) {
@@ -123,7 +123,7 @@ int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
     /* 2. Run test*/
     libspdm_run_test_harness(test_buffer, size);
     /* 3. Clean up*/
-    free(test_buffer);
+    free_pool(test_buffer);
     return 0;
 }
 #else
@@ -151,7 +151,7 @@ int main(int argc, char **argv)
     /* 2. Run test*/
     libspdm_run_test_harness(test_buffer, test_buffer_size);
     /* 3. Clean up*/
-    free(test_buffer);
+    free_pool(test_buffer);
     return 0;
 }
 #endif
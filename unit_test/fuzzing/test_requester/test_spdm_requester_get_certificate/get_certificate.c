@@ -173,14 +173,12 @@ void libspdm_test_requester_get_certificate_case1(void **State)
     libspdm_get_certificate(spdm_context, NULL, 0, &cert_chain_size, cert_chain);
     free(data);
     libspdm_reset_message_b(spdm_context);
-#if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
-#else
     if (spdm_context->connection_info.peer_used_cert_chain[0].leaf_cert_public_key != NULL) {
         libspdm_asym_free(
             spdm_context->connection_info.algorithm.base_asym_algo,
             spdm_context->connection_info.peer_used_cert_chain[0].leaf_cert_public_key);
+        spdm_context->connection_info.peer_used_cert_chain[0].leaf_cert_public_key = NULL;
     }
-#endif
 }
 
 void libspdm_test_requester_get_certificate_case2(void **State)
@@ -233,14 +231,12 @@ void libspdm_test_requester_get_certificate_case2(void **State)
     libspdm_get_certificate(spdm_context, NULL, 0, &cert_chain_size, cert_chain);
     free(data);
     libspdm_reset_message_b(spdm_context);
-#if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
-#else
     if (spdm_context->connection_info.peer_used_cert_chain[0].leaf_cert_public_key != NULL) {
         libspdm_asym_free(
             spdm_context->connection_info.algorithm.base_asym_algo,
             spdm_context->connection_info.peer_used_cert_chain[0].leaf_cert_public_key);
+        spdm_context->connection_info.peer_used_cert_chain[0].leaf_cert_public_key = NULL;
     }
-#endif
 }
 
 void libspdm_test_requester_get_certificate_ex_case1(void **State)
@@ -293,14 +289,12 @@ void libspdm_test_requester_get_certificate_ex_case1(void **State)
 
     free(data);
     libspdm_reset_message_b(spdm_context);
-#if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
-#else
     if (spdm_context->connection_info.peer_used_cert_chain[0].leaf_cert_public_key != NULL) {
         libspdm_asym_free(
             spdm_context->connection_info.algorithm.base_asym_algo,
             spdm_context->connection_info.peer_used_cert_chain[0].leaf_cert_public_key);
+        spdm_context->connection_info.peer_used_cert_chain[0].leaf_cert_public_key = NULL;
     }
-#endif
 }
 
 void libspdm_test_requester_get_certificate_in_session_case1(void **State)
@@ -388,14 +382,12 @@ void libspdm_test_requester_get_certificate_in_session_case1(void **State)
 
     free(data);
     libspdm_reset_message_b(spdm_context);
-#if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
-#else
     if (spdm_context->connection_info.peer_used_cert_chain[0].leaf_cert_public_key != NULL) {
         libspdm_asym_free(
             spdm_context->connection_info.algorithm.base_asym_algo,
             spdm_context->connection_info.peer_used_cert_chain[0].leaf_cert_public_key);
+        spdm_context->connection_info.peer_used_cert_chain[0].leaf_cert_public_key = NULL;
     }
-#endif
 }
 
 libspdm_test_context_t m_libspdm_requester_get_certificate_test_context = {
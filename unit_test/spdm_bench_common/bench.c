@@ -0,0 +1,153 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2021-2022 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "spdm_bench.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+double libspdm_bench_now_us(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e6 + (double)ts.tv_nsec / 1e3;
+}
+
+uint64_t libspdm_bench_cycles(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#elif defined(__aarch64__)
+    uint64_t value;
+
+    __asm__ __volatile__ ("mrs %0, cntvct_el0" : "=r" (value));
+    return value;
+#else
+    return 0;
+#endif
+}
+
+bool libspdm_bench_stat_init(libspdm_bench_stat_t *stat, const char *name,
+                             size_t max_sample_count)
+{
+    stat->name = name;
+    stat->sample_count = 0;
+    stat->max_sample_count = max_sample_count;
+    stat->sample = malloc(max_sample_count * sizeof(double));
+    return stat->sample != NULL;
+}
+
+void libspdm_bench_stat_free(libspdm_bench_stat_t *stat)
+{
+    free(stat->sample);
+    stat->sample = NULL;
+    stat->sample_count = 0;
+    stat->max_sample_count = 0;
+}
+
+void libspdm_bench_stat_reset(libspdm_bench_stat_t *stat)
+{
+    stat->sample_count = 0;
+}
+
+void libspdm_bench_stat_add(libspdm_bench_stat_t *stat, double value_us)
+{
+    if (stat->sample_count < stat->max_sample_count) {
+        stat->sample[stat->sample_count] = value_us;
+        stat->sample_count++;
+    }
+}
+
+static int libspdm_bench_compare_double(const void *a, const void *b)
+{
+    double value_a;
+    double value_b;
+
+    value_a = *(const double *)a;
+    value_b = *(const double *)b;
+    if (value_a < value_b) {
+        return -1;
+    }
+    if (value_a > value_b) {
+        return 1;
+    }
+    return 0;
+}
+
+/* Nearest-rank percentile of sorted samples. */
+static double libspdm_bench_percentile(const double *sample, size_t count, size_t percent)
+{
+    size_t rank;
+
+    rank = (percent * count + 99) / 100;
+    if (rank == 0) {
+        rank = 1;
+    }
+    return sample[rank - 1];
+}
+
+void libspdm_bench_stat_summarize(libspdm_bench_stat_t *stat, libspdm_bench_summary_t *summary)
+{
+    size_t index;
+    double sum;
+
+    memset(summary, 0, sizeof(*summary));
+    summary->count = stat->sample_count;
+    if (stat->sample_count == 0) {
+        return;
+    }
+
+    qsort(stat->sample, stat->sample_count, sizeof(double), libspdm_bench_compare_double);
+
+    sum = 0;
+    for (index = 0; index < stat->sample_count; index++) {
+        sum += stat->sample[index];
+    }
+    summary->min = stat->sample[0];
+    summary->max = stat->sample[stat->sample_count - 1];
+    summary->mean = sum / (double)stat->sample_count;
+    summary->p50 = libspdm_bench_percentile(stat->sample, stat->sample_count, 50);
+    summary->p90 = libspdm_bench_percentile(stat->sample, stat->sample_count, 90);
+    summary->p99 = libspdm_bench_percentile(stat->sample, stat->sample_count, 99);
+}
+
+void libspdm_bench_json_write_string(FILE *fp, const char *string)
+{
+    fputc('"', fp);
+    for (; *string != '\0'; string++) {
+        if ((*string == '"') || (*string == '\\')) {
+            fputc('\\', fp);
+            fputc(*string, fp);
+        } else if ((unsigned char)*string < 0x20) {
+            fprintf(fp, "\\u%04x", (unsigned char)*string);
+        } else {
+            fputc(*string, fp);
+        }
+    }
+    fputc('"', fp);
+}
+
+void libspdm_bench_json_write_stat(FILE *fp, libspdm_bench_stat_t *stat, const char *indent)
+{
+    libspdm_bench_summary_t summary;
+
+    libspdm_bench_stat_summarize(stat, &summary);
+
+    fprintf(fp, "%s", indent);
+    libspdm_bench_json_write_string(fp, stat->name);
+    fprintf(fp, ": {\"count\": %zu, \"min_us\": %.3f, \"mean_us\": %.3f, "
+            "\"p50_us\": %.3f, \"p90_us\": %.3f, \"p99_us\": %.3f, \"max_us\": %.3f}",
+            summary.count, summary.min, summary.mean,
+            summary.p50, summary.p90, summary.p99, summary.max);
+}
@@ -0,0 +1,87 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2021-2022 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+#ifndef __SPDM_BENCH_H__
+#define __SPDM_BENCH_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+/* Version of the JSON report layout. Bump it when a field is renamed or removed. */
+#define LIBSPDM_BENCH_REPORT_VERSION 1
+
+/* Latency samples of one benchmarked operation, in microseconds. */
+typedef struct {
+    const char *name;
+    size_t sample_count;
+    size_t max_sample_count;
+    double *sample;
+} libspdm_bench_stat_t;
+
+/* Summary of a libspdm_bench_stat_t. */
+typedef struct {
+    size_t count;
+    double min;
+    double mean;
+    double p50;
+    double p90;
+    double p99;
+    double max;
+} libspdm_bench_summary_t;
+
+/**
+ * Return a monotonic timestamp in microseconds.
+ **/
+double libspdm_bench_now_us(void);
+
+/**
+ * Return the CPU timestamp counter, or 0 if the architecture does not have one.
+ **/
+uint64_t libspdm_bench_cycles(void);
+
+/**
+ * Initialize a statistic that can hold up to max_sample_count samples.
+ *
+ * @retval true   the sample buffer is allocated.
+ * @retval false  out of memory.
+ **/
+bool libspdm_bench_stat_init(libspdm_bench_stat_t *stat, const char *name,
+                             size_t max_sample_count);
+
+/**
+ * Free the sample buffer of a statistic.
+ **/
+void libspdm_bench_stat_free(libspdm_bench_stat_t *stat);
+
+/**
+ * Drop all samples of a statistic, keeping its sample buffer.
+ **/
+void libspdm_bench_stat_reset(libspdm_bench_stat_t *stat);
+
+/**
+ * Record one sample. Samples beyond max_sample_count are dropped.
+ **/
+void libspdm_bench_stat_add(libspdm_bench_stat_t *stat, double value_us);
+
+/**
+ * Compute min, mean, max and the nearest-rank percentiles of a statistic.
+ * The samples are sorted in place.
+ **/
+void libspdm_bench_stat_summarize(libspdm_bench_stat_t *stat, libspdm_bench_summary_t *summary);
+
+/**
+ * Write a statistic as a JSON member: "name": {"count": .., "min_us": .., ..}.
+ **/
+void libspdm_bench_json_write_stat(FILE *fp, libspdm_bench_stat_t *stat, const char *indent);
+
+/**
+ * Write a string as a JSON string, escaping quotes, backslashes and control characters.
+ **/
+void libspdm_bench_json_write_string(FILE *fp, const char *string);
+
+#endif
@@ -0,0 +1,61 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2021-2022 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+#ifndef __SPDM_BENCH_TRACE_H__
+#define __SPDM_BENCH_TRACE_H__
+
+#include "spdm_bench.h"
+#include "hal/base.h"
+#include "library/spdm_common_lib.h"
+
+#if LIBSPDM_TRACE_SUPPORT
+
+/* Maximum number of SPDM contexts that can be traced at the same time. */
+#define LIBSPDM_BENCH_TRACE_MAX_CONTEXT 4
+
+/**
+ * Open a Chrome trace file (chrome://tracing, Perfetto).
+ *
+ * Each traced SPDM context becomes one thread of the trace, and each libspdm trace event becomes
+ * a duration event with the request code, session ID and size as arguments.
+ *
+ * @retval true   the file is open.
+ * @retval false  the file cannot be created.
+ **/
+bool libspdm_bench_trace_open(const char *file_name);
+
+/**
+ * Finish and close the Chrome trace file, if it is open.
+ **/
+void libspdm_bench_trace_close(void);
+
+/**
+ * Enable or disable the USDT probes libspdm:begin and libspdm:end.
+ *
+ * @retval true   the probes are enabled or disabled as requested.
+ * @retval false  the benchmark is built without USDT support.
+ **/
+bool libspdm_bench_trace_enable_usdt(bool enable);
+
+/**
+ * Register libspdm_bench_trace_func on an SPDM context, if the Chrome trace is open or the USDT
+ * probes are enabled.
+ *
+ * @param  spdm_context  A pointer to the SPDM context.
+ * @param  name          The thread name of the context in the Chrome trace.
+ **/
+void libspdm_bench_trace_register(void *spdm_context, const char *name);
+
+/**
+ * libspdm_trace_func writing the Chrome trace and firing the USDT probes.
+ **/
+void libspdm_bench_trace_func(void *spdm_context, libspdm_trace_event_t event,
+                              libspdm_trace_phase_t phase, uint8_t request_code,
+                              uint32_t session_id, size_t size);
+
+#endif /* LIBSPDM_TRACE_SUPPORT */
+
+#endif
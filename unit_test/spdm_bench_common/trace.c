@@ -0,0 +1,144 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2021-2022 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+#include "spdm_bench_trace.h"
+
+#if LIBSPDM_TRACE_SUPPORT
+
+#if LIBSPDM_BENCH_USDT_SUPPORT
+#include <sys/sdt.h>
+#endif
+
+typedef struct {
+    void *spdm_context;
+    uint32_t tid;
+} libspdm_bench_trace_context_t;
+
+static FILE *m_libspdm_bench_trace_fp;
+static bool m_libspdm_bench_trace_first_event;
+static double m_libspdm_bench_trace_start_us;
+static bool m_libspdm_bench_trace_usdt;
+
+static libspdm_bench_trace_context_t
+    m_libspdm_bench_trace_context[LIBSPDM_BENCH_TRACE_MAX_CONTEXT];
+static size_t m_libspdm_bench_trace_context_count;
+
+static uint32_t libspdm_bench_trace_get_tid(void *spdm_context)
+{
+    size_t index;
+
+    for (index = 0; index < m_libspdm_bench_trace_context_count; index++) {
+        if (m_libspdm_bench_trace_context[index].spdm_context == spdm_context) {
+            return m_libspdm_bench_trace_context[index].tid;
+        }
+    }
+    return 0;
+}
+
+static void libspdm_bench_trace_write_separator(void)
+{
+    if (m_libspdm_bench_trace_first_event) {
+        m_libspdm_bench_trace_first_event = false;
+        fprintf(m_libspdm_bench_trace_fp, "\n");
+    } else {
+        fprintf(m_libspdm_bench_trace_fp, ",\n");
+    }
+}
+
+bool libspdm_bench_trace_open(const char *file_name)
+{
+    libspdm_bench_trace_close();
+
+    m_libspdm_bench_trace_fp = fopen(file_name, "w");
+    if (m_libspdm_bench_trace_fp == NULL) {
+        return false;
+    }
+    fprintf(m_libspdm_bench_trace_fp, "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [");
+    m_libspdm_bench_trace_first_event = true;
+    m_libspdm_bench_trace_start_us = libspdm_bench_now_us();
+    return true;
+}
+
+void libspdm_bench_trace_close(void)
+{
+    if (m_libspdm_bench_trace_fp == NULL) {
+        return;
+    }
+    fprintf(m_libspdm_bench_trace_fp, "\n]}\n");
+    fclose(m_libspdm_bench_trace_fp);
+    m_libspdm_bench_trace_fp = NULL;
+}
+
+bool libspdm_bench_trace_enable_usdt(bool enable)
+{
+#if LIBSPDM_BENCH_USDT_SUPPORT
+    m_libspdm_bench_trace_usdt = enable;
+    return true;
+#else
+    m_libspdm_bench_trace_usdt = false;
+    return !enable;
+#endif
+}
+
+void libspdm_bench_trace_register(void *spdm_context, const char *name)
+{
+    libspdm_bench_trace_context_t *trace_context;
+
+    if ((m_libspdm_bench_trace_fp == NULL) && !m_libspdm_bench_trace_usdt) {
+        return;
+    }
+
+    if (libspdm_bench_trace_get_tid(spdm_context) == 0) {
+        if (m_libspdm_bench_trace_context_count == LIBSPDM_BENCH_TRACE_MAX_CONTEXT) {
+            return;
+        }
+        trace_context = &m_libspdm_bench_trace_context[m_libspdm_bench_trace_context_count];
+        trace_context->spdm_context = spdm_context;
+        trace_context->tid = (uint32_t)(m_libspdm_bench_trace_context_count + 1);
+        m_libspdm_bench_trace_context_count++;
+
+        if (m_libspdm_bench_trace_fp != NULL) {
+            libspdm_bench_trace_write_separator();
+            fprintf(m_libspdm_bench_trace_fp,
+                    "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": %u, "
+                    "\"args\": {\"name\": \"%s\"}}",
+                    trace_context->tid, name);
+        }
+    }
+
+    libspdm_register_trace_func(spdm_context, libspdm_bench_trace_func);
+}
+
+void libspdm_bench_trace_func(void *spdm_context, libspdm_trace_event_t event,
+                              libspdm_trace_phase_t phase, uint8_t request_code,
+                              uint32_t session_id, size_t size)
+{
+#if LIBSPDM_BENCH_USDT_SUPPORT
+    if (m_libspdm_bench_trace_usdt) {
+        if (phase == LIBSPDM_TRACE_PHASE_BEGIN) {
+            DTRACE_PROBE4(libspdm, begin, event, request_code, session_id, size);
+        } else {
+            DTRACE_PROBE4(libspdm, end, event, request_code, session_id, size);
+        }
+    }
+#endif
+
+    if (m_libspdm_bench_trace_fp == NULL) {
+        return;
+    }
+
+    libspdm_bench_trace_write_separator();
+    fprintf(m_libspdm_bench_trace_fp,
+            "{\"name\": \"%s\", \"cat\": \"libspdm\", \"ph\": \"%s\", \"ts\": %.3f, "
+            "\"pid\": 1, \"tid\": %u, \"args\": {\"request_code\": \"0x%02x\", "
+            "\"session_id\": \"0x%08x\", \"size\": %zu}}",
+            libspdm_trace_get_event_name(event),
+            (phase == LIBSPDM_TRACE_PHASE_BEGIN) ? "B" : "E",
+            libspdm_bench_now_us() - m_libspdm_bench_trace_start_us,
+            libspdm_bench_trace_get_tid(spdm_context), request_code, session_id, size);
+}
+
+#endif /* LIBSPDM_TRACE_SUPPORT */
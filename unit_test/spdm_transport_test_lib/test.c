@@ -173,7 +173,8 @@ libspdm_return_t libspdm_test_decode_message(uint32_t **session_id,
 
 /**
  * Return the maximum transport layer message header size.
- *   Transport Message Header Size + sizeof(spdm_secured_message_cipher_header_t))
+ *   Transport Message Header Size + secured message header + APP message header.
+ *   An SPDM message at this offset in the sender buffer is encoded in place.
  *
  *   For MCTP, Transport Message Header Size = sizeof(mctp_message_header_t)
  *   For PCI_DOE, Transport Message Header Size = sizeof(pci_doe_data_object_header_t)
@@ -185,5 +186,5 @@ libspdm_return_t libspdm_test_decode_message(uint32_t **session_id,
 uint32_t libspdm_transport_test_get_header_size(
     void *spdm_context)
 {
-    return sizeof(libspdm_test_message_header_t) + sizeof(spdm_secured_message_cipher_header_t);
+    return LIBSPDM_TEST_TRANSPORT_HEADER_SIZE;
 }
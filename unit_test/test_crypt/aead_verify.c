@@ -137,7 +137,13 @@ bool libspdm_validate_crypt_aead_cipher(void)
     size_t OutBufferSize;
     uint8_t OutTag[1024];
     size_t OutTagSize;
+    #endif
+    #if (LIBSPDM_AEAD_GCM_SUPPORT_TEST) || (LIBSPDM_AEAD_CHACHA20_POLY1305_SUPPORT_TEST)
+    void *aead_ctx;
+    #endif
 
+    #if (LIBSPDM_AEAD_GCM_SUPPORT_TEST) || (LIBSPDM_AEAD_CHACHA20_POLY1305_SUPPORT_TEST) || \
+    (LIBSPDM_AEAD_SM4_SUPPORT_TEST)
     libspdm_my_print("\nCrypto AEAD Testing: ");
     #else
     return true;
@@ -190,6 +196,45 @@ bool libspdm_validate_crypt_aead_cipher(void)
         return false;
     }
 
+    libspdm_my_print("[Pass]");
+
+    libspdm_my_print("\n- AES-GCM Context Encryption: ");
+    aead_ctx = libspdm_aead_aes_gcm_new();
+    if (aead_ctx == NULL) {
+        libspdm_my_print("[Fail]");
+        return false;
+    }
+    status = libspdm_aead_aes_gcm_set_key(aead_ctx, m_libspdm_gcm_key, sizeof(m_libspdm_gcm_key));
+    if (!status) {
+        libspdm_my_print("[Fail]");
+        libspdm_aead_aes_gcm_free(aead_ctx);
+        return false;
+    }
+    OutBufferSize = sizeof(OutBuffer);
+    status = libspdm_aead_aes_gcm_encrypt_with_context(
+        aead_ctx, m_libspdm_gcm_iv, sizeof(m_libspdm_gcm_iv),
+        m_libspdm_gcm_aad, sizeof(m_libspdm_gcm_aad), m_libspdm_gcm_pt, sizeof(m_libspdm_gcm_pt),
+        OutTag, OutTagSize, OutBuffer, &OutBufferSize);
+    if (!status || (OutBufferSize != sizeof(m_libspdm_gcm_ct)) ||
+        (memcmp(OutBuffer, m_libspdm_gcm_ct, sizeof(m_libspdm_gcm_ct)) != 0) ||
+        (memcmp(OutTag, m_libspdm_gcm_tag, sizeof(m_libspdm_gcm_tag)) != 0)) {
+        libspdm_my_print("[Fail]");
+        libspdm_aead_aes_gcm_free(aead_ctx);
+        return false;
+    }
+    libspdm_my_print("[Pass]");
+
+    libspdm_my_print("\n- AES-GCM Context Decryption: ");
+    status = libspdm_aead_aes_gcm_decrypt_with_context(
+        aead_ctx, m_libspdm_gcm_iv, sizeof(m_libspdm_gcm_iv),
+        m_libspdm_gcm_aad, sizeof(m_libspdm_gcm_aad), m_libspdm_gcm_ct, sizeof(m_libspdm_gcm_ct),
+        m_libspdm_gcm_tag, sizeof(m_libspdm_gcm_tag), OutBuffer, &OutBufferSize);
+    libspdm_aead_aes_gcm_free(aead_ctx);
+    if (!status || (OutBufferSize != sizeof(m_libspdm_gcm_pt)) ||
+        (memcmp(OutBuffer, m_libspdm_gcm_pt, sizeof(m_libspdm_gcm_pt)) != 0)) {
+        libspdm_my_print("[Fail]");
+        return false;
+    }
     libspdm_my_print("[Pass]");
     #endif /* LIBSPDM_AEAD_GCM_SUPPORT_TEST */
 
@@ -246,6 +291,52 @@ bool libspdm_validate_crypt_aead_cipher(void)
         return false;
     }
 
+    libspdm_my_print("[Pass]");
+
+    libspdm_my_print("\n- ChaCha20Poly1305 Context Encryption: ");
+    aead_ctx = libspdm_aead_chacha20_poly1305_new();
+    if (aead_ctx == NULL) {
+        libspdm_my_print("[Fail]");
+        return false;
+    }
+    status = libspdm_aead_chacha20_poly1305_set_key(aead_ctx, m_libspdm_chacha20_poly1305_key,
+                                                    sizeof(m_libspdm_chacha20_poly1305_key));
+    if (!status) {
+        libspdm_my_print("[Fail]");
+        libspdm_aead_chacha20_poly1305_free(aead_ctx);
+        return false;
+    }
+    OutBufferSize = sizeof(OutBuffer);
+    status = libspdm_aead_chacha20_poly1305_encrypt_with_context(
+        aead_ctx, m_libspdm_chacha20_poly1305_iv, sizeof(m_libspdm_chacha20_poly1305_iv),
+        m_libspdm_chacha20_poly1305_aad, sizeof(m_libspdm_chacha20_poly1305_aad),
+        m_libspdm_chacha20_poly1305_pt, sizeof(m_libspdm_chacha20_poly1305_pt), OutTag,
+        OutTagSize, OutBuffer, &OutBufferSize);
+    if (!status || (OutBufferSize != sizeof(m_libspdm_chacha20_poly1305_ct)) ||
+        (memcmp(OutBuffer, m_libspdm_chacha20_poly1305_ct,
+                sizeof(m_libspdm_chacha20_poly1305_ct)) != 0) ||
+        (memcmp(OutTag, m_libspdm_chacha20_poly1305_tag,
+                sizeof(m_libspdm_chacha20_poly1305_tag)) != 0)) {
+        libspdm_my_print("[Fail]");
+        libspdm_aead_chacha20_poly1305_free(aead_ctx);
+        return false;
+    }
+    libspdm_my_print("[Pass]");
+
+    libspdm_my_print("\n- ChaCha20Poly1305 Context Decryption: ");
+    status = libspdm_aead_chacha20_poly1305_decrypt_with_context(
+        aead_ctx, m_libspdm_chacha20_poly1305_iv, sizeof(m_libspdm_chacha20_poly1305_iv),
+        m_libspdm_chacha20_poly1305_aad, sizeof(m_libspdm_chacha20_poly1305_aad),
+        m_libspdm_chacha20_poly1305_ct, sizeof(m_libspdm_chacha20_poly1305_ct),
+        m_libspdm_chacha20_poly1305_tag, sizeof(m_libspdm_chacha20_poly1305_tag),
+        OutBuffer, &OutBufferSize);
+    libspdm_aead_chacha20_poly1305_free(aead_ctx);
+    if (!status || (OutBufferSize != sizeof(m_libspdm_chacha20_poly1305_pt)) ||
+        (memcmp(OutBuffer, m_libspdm_chacha20_poly1305_pt,
+                sizeof(m_libspdm_chacha20_poly1305_pt)) != 0)) {
+        libspdm_my_print("[Fail]");
+        return false;
+    }
     libspdm_my_print("[Pass]");
     #endif /* LIBSPDM_AEAD_CHACHA20_POLY1305_SUPPORT_TEST */
 
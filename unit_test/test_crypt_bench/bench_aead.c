@@ -0,0 +1,113 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2021-2022 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+#include "test_crypt_bench.h"
+
+#define LIBSPDM_CRYPT_BENCH_AEAD_IV_SIZE 12
+#define LIBSPDM_CRYPT_BENCH_AEAD_TAG_SIZE 16
+
+/* Secured messages authenticate the session ID, sequence number and length. */
+#define LIBSPDM_CRYPT_BENCH_AEAD_AAD_SIZE 16
+
+typedef bool (*libspdm_crypt_bench_aead_encrypt_func_t)(
+    const uint8_t *key, size_t key_size, const uint8_t *iv, size_t iv_size,
+    const uint8_t *a_data, size_t a_data_size, const uint8_t *data_in, size_t data_in_size,
+    uint8_t *tag_out, size_t tag_size, uint8_t *data_out, size_t *data_out_size);
+
+typedef bool (*libspdm_crypt_bench_aead_decrypt_func_t)(
+    const uint8_t *key, size_t key_size, const uint8_t *iv, size_t iv_size,
+    const uint8_t *a_data, size_t a_data_size, const uint8_t *data_in, size_t data_in_size,
+    const uint8_t *tag, size_t tag_size, uint8_t *data_out, size_t *data_out_size);
+
+typedef struct {
+    const char *name;
+    size_t key_size;
+    libspdm_crypt_bench_aead_encrypt_func_t encrypt;
+    libspdm_crypt_bench_aead_decrypt_func_t decrypt;
+} libspdm_crypt_bench_aead_t;
+
+static libspdm_crypt_bench_aead_t m_libspdm_crypt_bench_aead[] = {
+#if LIBSPDM_AEAD_GCM_SUPPORT_TEST
+    { "aes_128_gcm", 16, libspdm_aead_aes_gcm_encrypt, libspdm_aead_aes_gcm_decrypt },
+    { "aes_256_gcm", 32, libspdm_aead_aes_gcm_encrypt, libspdm_aead_aes_gcm_decrypt },
+#endif
+#if LIBSPDM_AEAD_CHACHA20_POLY1305_SUPPORT_TEST
+    { "chacha20_poly1305", 32, libspdm_aead_chacha20_poly1305_encrypt,
+      libspdm_aead_chacha20_poly1305_decrypt },
+#endif
+#if LIBSPDM_AEAD_SM4_SUPPORT_TEST
+    { "sm4_128_gcm", 16, libspdm_aead_sm4_gcm_encrypt, libspdm_aead_sm4_gcm_decrypt },
+#endif
+};
+
+static uint8_t m_libspdm_crypt_bench_aead_key[32];
+static uint8_t m_libspdm_crypt_bench_aead_iv[LIBSPDM_CRYPT_BENCH_AEAD_IV_SIZE];
+static uint8_t m_libspdm_crypt_bench_aead_tag[LIBSPDM_CRYPT_BENCH_AEAD_TAG_SIZE];
+
+/* Ciphertext produced by the encrypt benchmark and consumed by the decrypt benchmark. */
+static uint8_t m_libspdm_crypt_bench_aead_cipher[LIBSPDM_CRYPT_BENCH_MAX_DATA_SIZE];
+
+static bool libspdm_crypt_bench_aead_encrypt(void *param, size_t data_size)
+{
+    const libspdm_crypt_bench_aead_t *aead;
+    size_t data_out_size;
+
+    aead = param;
+    data_out_size = sizeof(m_libspdm_crypt_bench_aead_cipher);
+    return aead->encrypt(m_libspdm_crypt_bench_aead_key, aead->key_size,
+                         m_libspdm_crypt_bench_aead_iv, sizeof(m_libspdm_crypt_bench_aead_iv),
+                         m_libspdm_crypt_bench_data, LIBSPDM_CRYPT_BENCH_AEAD_AAD_SIZE,
+                         m_libspdm_crypt_bench_data, data_size,
+                         m_libspdm_crypt_bench_aead_tag, sizeof(m_libspdm_crypt_bench_aead_tag),
+                         m_libspdm_crypt_bench_aead_cipher, &data_out_size);
+}
+
+static bool libspdm_crypt_bench_aead_decrypt(void *param, size_t data_size)
+{
+    const libspdm_crypt_bench_aead_t *aead;
+    size_t data_out_size;
+
+    aead = param;
+    data_out_size = sizeof(m_libspdm_crypt_bench_output);
+    return aead->decrypt(m_libspdm_crypt_bench_aead_key, aead->key_size,
+                         m_libspdm_crypt_bench_aead_iv, sizeof(m_libspdm_crypt_bench_aead_iv),
+                         m_libspdm_crypt_bench_data, LIBSPDM_CRYPT_BENCH_AEAD_AAD_SIZE,
+                         m_libspdm_crypt_bench_aead_cipher, data_size,
+                         m_libspdm_crypt_bench_aead_tag, sizeof(m_libspdm_crypt_bench_aead_tag),
+                         m_libspdm_crypt_bench_output, &data_out_size);
+}
+
+void libspdm_crypt_bench_aead(void)
+{
+    libspdm_crypt_bench_aead_t *aead;
+    size_t aead_index;
+    size_t index;
+    size_t data_size;
+
+    for (index = 0; index < sizeof(m_libspdm_crypt_bench_aead_key); index++) {
+        m_libspdm_crypt_bench_aead_key[index] = (uint8_t)(0xa5 ^ index);
+    }
+    for (index = 0; index < sizeof(m_libspdm_crypt_bench_aead_iv); index++) {
+        m_libspdm_crypt_bench_aead_iv[index] = (uint8_t)index;
+    }
+
+    for (aead_index = 0; aead_index < LIBSPDM_CRYPT_BENCH_ARRAY_SIZE(m_libspdm_crypt_bench_aead);
+         aead_index++) {
+        aead = &m_libspdm_crypt_bench_aead[aead_index];
+        if (!libspdm_crypt_bench_selected(aead->name)) {
+            continue;
+        }
+        for (index = 0; index < LIBSPDM_CRYPT_BENCH_DATA_SIZE_COUNT; index++) {
+            data_size = m_libspdm_crypt_bench_data_size[index];
+            /* The last encryption leaves the ciphertext and tag that the decryption checks. */
+            if (libspdm_crypt_bench_run(aead->name, "encrypt", data_size,
+                                        libspdm_crypt_bench_aead_encrypt, aead)) {
+                libspdm_crypt_bench_run(aead->name, "decrypt", data_size,
+                                        libspdm_crypt_bench_aead_decrypt, aead);
+            }
+        }
+    }
+}
@@ -0,0 +1,494 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2021-2022 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+#include "test_crypt_bench.h"
+
+#define LIBSPDM_CRYPT_BENCH_MAX_SIGNATURE_SIZE 1024
+#define LIBSPDM_CRYPT_BENCH_MAX_DHE_KEY_SIZE 1024
+
+typedef enum {
+    LIBSPDM_CRYPT_BENCH_SIGN_RSA_SSA,
+    LIBSPDM_CRYPT_BENCH_SIGN_RSA_PSS,
+    LIBSPDM_CRYPT_BENCH_SIGN_ECDSA,
+    LIBSPDM_CRYPT_BENCH_SIGN_EDDSA,
+    LIBSPDM_CRYPT_BENCH_SIGN_SM2,
+} libspdm_crypt_bench_sign_type_t;
+
+typedef enum {
+    LIBSPDM_CRYPT_BENCH_DHE_FFDHE,
+    LIBSPDM_CRYPT_BENCH_DHE_ECDHE,
+    LIBSPDM_CRYPT_BENCH_DHE_SM2,
+} libspdm_crypt_bench_dhe_type_t;
+
+typedef struct {
+    const char *name;
+    libspdm_crypt_bench_sign_type_t type;
+    /* Private key in the sample key directory. */
+    const char *key_file;
+    size_t hash_nid;
+    /* Size of the signed digest. 0 if the algorithm signs the message itself. */
+    size_t hash_size;
+
+    /* Runtime state. */
+    void *pem_data;
+    size_t pem_size;
+    void *context;
+    uint8_t signature[LIBSPDM_CRYPT_BENCH_MAX_SIGNATURE_SIZE];
+    size_t signature_size;
+} libspdm_crypt_bench_sign_t;
+
+typedef struct {
+    const char *name;
+    libspdm_crypt_bench_dhe_type_t type;
+    size_t nid;
+
+    /* Runtime state. */
+    void *context;
+    uint8_t peer_public_key[LIBSPDM_CRYPT_BENCH_MAX_DHE_KEY_SIZE];
+    size_t peer_public_key_size;
+} libspdm_crypt_bench_dhe_t;
+
+#if (LIBSPDM_SM2_DSA_SUPPORT_TEST) || (LIBSPDM_SM2_KEY_EXCHANGE_SUPPORT_TEST)
+/* Identity of the SM2 signer and key exchange parties. */
+static const uint8_t m_libspdm_crypt_bench_sm2_id[] = "1234567812345678";
+#endif
+
+static libspdm_crypt_bench_sign_t m_libspdm_crypt_bench_sign[] = {
+#if LIBSPDM_RSA_SSA_SUPPORT_TEST
+    { "rsassa_2048", LIBSPDM_CRYPT_BENCH_SIGN_RSA_SSA, "rsa2048/end_responder.key",
+      LIBSPDM_CRYPTO_NID_SHA256, LIBSPDM_SHA256_DIGEST_SIZE },
+    { "rsassa_3072", LIBSPDM_CRYPT_BENCH_SIGN_RSA_SSA, "rsa3072/end_responder.key",
+      LIBSPDM_CRYPTO_NID_SHA384, LIBSPDM_SHA384_DIGEST_SIZE },
+    { "rsassa_4096", LIBSPDM_CRYPT_BENCH_SIGN_RSA_SSA, "rsa4096/end_responder.key",
+      LIBSPDM_CRYPTO_NID_SHA512, LIBSPDM_SHA512_DIGEST_SIZE },
+#endif
+#if LIBSPDM_RSA_PSS_SUPPORT_TEST
+    { "rsapss_2048", LIBSPDM_CRYPT_BENCH_SIGN_RSA_PSS, "rsa2048/end_responder.key",
+      LIBSPDM_CRYPTO_NID_SHA256, LIBSPDM_SHA256_DIGEST_SIZE },
+    { "rsapss_3072", LIBSPDM_CRYPT_BENCH_SIGN_RSA_PSS, "rsa3072/end_responder.key",
+      LIBSPDM_CRYPTO_NID_SHA384, LIBSPDM_SHA384_DIGEST_SIZE },
+    { "rsapss_4096", LIBSPDM_CRYPT_BENCH_SIGN_RSA_PSS, "rsa4096/end_responder.key",
+      LIBSPDM_CRYPTO_NID_SHA512, LIBSPDM_SHA512_DIGEST_SIZE },
+#endif
+#if LIBSPDM_ECDSA_SUPPORT_TEST
+    { "ecdsa_p256", LIBSPDM_CRYPT_BENCH_SIGN_ECDSA, "ecp256/end_responder.key",
+      LIBSPDM_CRYPTO_NID_SHA256, LIBSPDM_SHA256_DIGEST_SIZE },
+    { "ecdsa_p384", LIBSPDM_CRYPT_BENCH_SIGN_ECDSA, "ecp384/end_responder.key",
+      LIBSPDM_CRYPTO_NID_SHA384, LIBSPDM_SHA384_DIGEST_SIZE },
+    { "ecdsa_p521", LIBSPDM_CRYPT_BENCH_SIGN_ECDSA, "ecp521/end_responder.key",
+      LIBSPDM_CRYPTO_NID_SHA512, LIBSPDM_SHA512_DIGEST_SIZE },
+#endif
+#if LIBSPDM_EDDSA_ED25519_SUPPORT_TEST
+    { "eddsa_ed25519", LIBSPDM_CRYPT_BENCH_SIGN_EDDSA, "ed25519/end_responder.key",
+      LIBSPDM_CRYPTO_NID_NULL, 0 },
+#endif
+#if LIBSPDM_EDDSA_ED448_SUPPORT_TEST
+    { "eddsa_ed448", LIBSPDM_CRYPT_BENCH_SIGN_EDDSA, "ed448/end_responder.key",
+      LIBSPDM_CRYPTO_NID_NULL, 0 },
+#endif
+#if LIBSPDM_SM2_DSA_SUPPORT_TEST
+    { "sm2_dsa_p256", LIBSPDM_CRYPT_BENCH_SIGN_SM2, "sm2/end_responder.key",
+      LIBSPDM_CRYPTO_NID_SM3_256, 0 },
+#endif
+};
+
+static libspdm_crypt_bench_dhe_t m_libspdm_crypt_bench_dhe[] = {
+#if LIBSPDM_FFDHE_SUPPORT_TEST
+    { "ffdhe_2048", LIBSPDM_CRYPT_BENCH_DHE_FFDHE, LIBSPDM_CRYPTO_NID_FFDHE2048 },
+    { "ffdhe_3072", LIBSPDM_CRYPT_BENCH_DHE_FFDHE, LIBSPDM_CRYPTO_NID_FFDHE3072 },
+    { "ffdhe_4096", LIBSPDM_CRYPT_BENCH_DHE_FFDHE, LIBSPDM_CRYPTO_NID_FFDHE4096 },
+#endif
+#if LIBSPDM_ECDHE_SUPPORT_TEST
+    { "secp256r1", LIBSPDM_CRYPT_BENCH_DHE_ECDHE, LIBSPDM_CRYPTO_NID_SECP256R1 },
+    { "secp384r1", LIBSPDM_CRYPT_BENCH_DHE_ECDHE, LIBSPDM_CRYPTO_NID_SECP384R1 },
+    { "secp521r1", LIBSPDM_CRYPT_BENCH_DHE_ECDHE, LIBSPDM_CRYPTO_NID_SECP521R1 },
+#endif
+#if LIBSPDM_SM2_KEY_EXCHANGE_SUPPORT_TEST
+    { "sm2_key_exchange_p256", LIBSPDM_CRYPT_BENCH_DHE_SM2,
+      LIBSPDM_CRYPTO_NID_SM2_KEY_EXCHANGE_P256 },
+#endif
+};
+
+static void *libspdm_crypt_bench_key_new(void *param)
+{
+    libspdm_crypt_bench_sign_t *sign;
+    void *context;
+    bool result;
+
+    sign = param;
+    context = NULL;
+    switch (sign->type) {
+#if (LIBSPDM_RSA_SSA_SUPPORT_TEST) || (LIBSPDM_RSA_PSS_SUPPORT_TEST)
+    case LIBSPDM_CRYPT_BENCH_SIGN_RSA_SSA:
+    case LIBSPDM_CRYPT_BENCH_SIGN_RSA_PSS:
+        result = libspdm_rsa_get_private_key_from_pem(sign->pem_data, sign->pem_size, NULL,
+                                                      &context);
+        break;
+#endif
+#if LIBSPDM_ECDSA_SUPPORT_TEST
+    case LIBSPDM_CRYPT_BENCH_SIGN_ECDSA:
+        result = libspdm_ec_get_private_key_from_pem(sign->pem_data, sign->pem_size, NULL,
+                                                     &context);
+        break;
+#endif
+#if (LIBSPDM_EDDSA_ED25519_SUPPORT_TEST) || (LIBSPDM_EDDSA_ED448_SUPPORT_TEST)
+    case LIBSPDM_CRYPT_BENCH_SIGN_EDDSA:
+        result = libspdm_ecd_get_private_key_from_pem(sign->pem_data, sign->pem_size, NULL,
+                                                      &context);
+        break;
+#endif
+#if LIBSPDM_SM2_DSA_SUPPORT_TEST
+    case LIBSPDM_CRYPT_BENCH_SIGN_SM2:
+        result = libspdm_sm2_get_private_key_from_pem(sign->pem_data, sign->pem_size, NULL,
+                                                      &context);
+        break;
+#endif
+    default:
+        result = false;
+        break;
+    }
+    return result ? context : NULL;
+}
+
+static void libspdm_crypt_bench_key_free(void *param, void *context)
+{
+    libspdm_crypt_bench_sign_t *sign;
+
+    sign = param;
+    switch (sign->type) {
+#if (LIBSPDM_RSA_SSA_SUPPORT_TEST) || (LIBSPDM_RSA_PSS_SUPPORT_TEST)
+    case LIBSPDM_CRYPT_BENCH_SIGN_RSA_SSA:
+    case LIBSPDM_CRYPT_BENCH_SIGN_RSA_PSS:
+        libspdm_rsa_free(context);
+        break;
+#endif
+#if LIBSPDM_ECDSA_SUPPORT_TEST
+    case LIBSPDM_CRYPT_BENCH_SIGN_ECDSA:
+        libspdm_ec_free(context);
+        break;
+#endif
+#if (LIBSPDM_EDDSA_ED25519_SUPPORT_TEST) || (LIBSPDM_EDDSA_ED448_SUPPORT_TEST)
+    case LIBSPDM_CRYPT_BENCH_SIGN_EDDSA:
+        libspdm_ecd_free(context);
+        break;
+#endif
+#if LIBSPDM_SM2_DSA_SUPPORT_TEST
+    case LIBSPDM_CRYPT_BENCH_SIGN_SM2:
+        libspdm_sm2_dsa_free(context);
+        break;
+#endif
+    default:
+        break;
+    }
+}
+
+static bool libspdm_crypt_bench_sign(void *param, size_t data_size)
+{
+    libspdm_crypt_bench_sign_t *sign;
+
+    sign = param;
+    sign->signature_size = sizeof(sign->signature);
+    switch (sign->type) {
+#if LIBSPDM_RSA_SSA_SUPPORT_TEST
+    case LIBSPDM_CRYPT_BENCH_SIGN_RSA_SSA:
+        return libspdm_rsa_pkcs1_sign_with_nid(sign->context, sign->hash_nid,
+                                               m_libspdm_crypt_bench_data, data_size,
+                                               sign->signature, &sign->signature_size);
+#endif
+#if LIBSPDM_RSA_PSS_SUPPORT_TEST
+    case LIBSPDM_CRYPT_BENCH_SIGN_RSA_PSS:
+        return libspdm_rsa_pss_sign(sign->context, sign->hash_nid,
+                                    m_libspdm_crypt_bench_data, data_size,
+                                    sign->signature, &sign->signature_size);
+#endif
+#if LIBSPDM_ECDSA_SUPPORT_TEST
+    case LIBSPDM_CRYPT_BENCH_SIGN_ECDSA:
+        return libspdm_ecdsa_sign(sign->context, sign->hash_nid,
+                                  m_libspdm_crypt_bench_data, data_size,
+                                  sign->signature, &sign->signature_size);
+#endif
+#if (LIBSPDM_EDDSA_ED25519_SUPPORT_TEST) || (LIBSPDM_EDDSA_ED448_SUPPORT_TEST)
+    case LIBSPDM_CRYPT_BENCH_SIGN_EDDSA:
+        return libspdm_eddsa_sign(sign->context, sign->hash_nid, NULL, 0,
+                                  m_libspdm_crypt_bench_data, data_size,
+                                  sign->signature, &sign->signature_size);
+#endif
+#if LIBSPDM_SM2_DSA_SUPPORT_TEST
+    case LIBSPDM_CRYPT_BENCH_SIGN_SM2:
+        return libspdm_sm2_dsa_sign(sign->context, sign->hash_nid,
+                                    m_libspdm_crypt_bench_sm2_id,
+                                    sizeof(m_libspdm_crypt_bench_sm2_id) - 1,
+                                    m_libspdm_crypt_bench_data, data_size,
+                                    sign->signature, &sign->signature_size);
+#endif
+    default:
+        return false;
+    }
+}
+
+static bool libspdm_crypt_bench_verify(void *param, size_t data_size)
+{
+    libspdm_crypt_bench_sign_t *sign;
+
+    sign = param;
+    switch (sign->type) {
+#if LIBSPDM_RSA_SSA_SUPPORT_TEST
+    case LIBSPDM_CRYPT_BENCH_SIGN_RSA_SSA:
+        return libspdm_rsa_pkcs1_verify_with_nid(sign->context, sign->hash_nid,
+                                                 m_libspdm_crypt_bench_data, data_size,
+                                                 sign->signature, sign->signature_size);
+#endif
+#if LIBSPDM_RSA_PSS_SUPPORT_TEST
+    case LIBSPDM_CRYPT_BENCH_SIGN_RSA_PSS:
+        return libspdm_rsa_pss_verify(sign->context, sign->hash_nid,
+                                      m_libspdm_crypt_bench_data, data_size,
+                                      sign->signature, sign->signature_size);
+#endif
+#if LIBSPDM_ECDSA_SUPPORT_TEST
+    case LIBSPDM_CRYPT_BENCH_SIGN_ECDSA:
+        return libspdm_ecdsa_verify(sign->context, sign->hash_nid,
+                                    m_libspdm_crypt_bench_data, data_size,
+                                    sign->signature, sign->signature_size);
+#endif
+#if (LIBSPDM_EDDSA_ED25519_SUPPORT_TEST) || (LIBSPDM_EDDSA_ED448_SUPPORT_TEST)
+    case LIBSPDM_CRYPT_BENCH_SIGN_EDDSA:
+        return libspdm_eddsa_verify(sign->context, sign->hash_nid, NULL, 0,
+                                    m_libspdm_crypt_bench_data, data_size,
+                                    sign->signature, sign->signature_size);
+#endif
+#if LIBSPDM_SM2_DSA_SUPPORT_TEST
+    case LIBSPDM_CRYPT_BENCH_SIGN_SM2:
+        return libspdm_sm2_dsa_verify(sign->context, sign->hash_nid,
+                                      m_libspdm_crypt_bench_sm2_id,
+                                      sizeof(m_libspdm_crypt_bench_sm2_id) - 1,
+                                      m_libspdm_crypt_bench_data, data_size,
+                                      sign->signature, sign->signature_size);
+#endif
+    default:
+        return false;
+    }
+}
+
+/**
+ * Benchmark signing and verification of one message or digest size.
+ * Every signature is checked, so the verification uses the signature of the last signing.
+ **/
+static void libspdm_crypt_bench_sign_verify(libspdm_crypt_bench_sign_t *sign, size_t data_size)
+{
+    if (libspdm_crypt_bench_run(sign->name, "sign", data_size, libspdm_crypt_bench_sign, sign)) {
+        libspdm_crypt_bench_run(sign->name, "verify", data_size, libspdm_crypt_bench_verify,
+                                sign);
+    }
+}
+
+static void libspdm_crypt_bench_one_sign(libspdm_crypt_bench_sign_t *sign)
+{
+    size_t index;
+
+    if (!libspdm_read_input_file(sign->key_file, &sign->pem_data, &sign->pem_size)) {
+        fprintf(stderr, "%-20s cannot read %s, run from the sample key directory\n",
+                sign->name, sign->key_file);
+        return;
+    }
+
+    /* Loading the private key is part of every signing in the sample device library. */
+    libspdm_crypt_bench_run_lifecycle(sign->name, "key_", libspdm_crypt_bench_key_new, NULL,
+                                      libspdm_crypt_bench_key_free, sign);
+
+    sign->context = libspdm_crypt_bench_key_new(sign);
+    if (sign->context != NULL) {
+        if (sign->hash_size != 0) {
+            libspdm_crypt_bench_sign_verify(sign, sign->hash_size);
+        } else {
+            for (index = 0; index < LIBSPDM_CRYPT_BENCH_DATA_SIZE_COUNT; index++) {
+                libspdm_crypt_bench_sign_verify(sign, m_libspdm_crypt_bench_data_size[index]);
+            }
+        }
+        libspdm_crypt_bench_key_free(sign, sign->context);
+        sign->context = NULL;
+    }
+
+    free(sign->pem_data);
+    sign->pem_data = NULL;
+}
+
+static void *libspdm_crypt_bench_dhe_new(void *param)
+{
+    libspdm_crypt_bench_dhe_t *dhe;
+
+    dhe = param;
+    switch (dhe->type) {
+#if LIBSPDM_FFDHE_SUPPORT_TEST
+    case LIBSPDM_CRYPT_BENCH_DHE_FFDHE:
+        return libspdm_dh_new_by_nid(dhe->nid);
+#endif
+#if LIBSPDM_ECDHE_SUPPORT_TEST
+    case LIBSPDM_CRYPT_BENCH_DHE_ECDHE:
+        return libspdm_ec_new_by_nid(dhe->nid);
+#endif
+#if LIBSPDM_SM2_KEY_EXCHANGE_SUPPORT_TEST
+    case LIBSPDM_CRYPT_BENCH_DHE_SM2:
+        return libspdm_sm2_key_exchange_new_by_nid(dhe->nid);
+#endif
+    default:
+        return NULL;
+    }
+}
+
+static void libspdm_crypt_bench_dhe_free(void *param, void *context)
+{
+    libspdm_crypt_bench_dhe_t *dhe;
+
+    dhe = param;
+    switch (dhe->type) {
+#if LIBSPDM_FFDHE_SUPPORT_TEST
+    case LIBSPDM_CRYPT_BENCH_DHE_FFDHE:
+        libspdm_dh_free(context);
+        break;
+#endif
+#if LIBSPDM_ECDHE_SUPPORT_TEST
+    case LIBSPDM_CRYPT_BENCH_DHE_ECDHE:
+        libspdm_ec_free(context);
+        break;
+#endif
+#if LIBSPDM_SM2_KEY_EXCHANGE_SUPPORT_TEST
+    case LIBSPDM_CRYPT_BENCH_DHE_SM2:
+        libspdm_sm2_key_exchange_free(context);
+        break;
+#endif
+    default:
+        break;
+    }
+}
+
+static bool libspdm_crypt_bench_dhe_generate_key_of(libspdm_crypt_bench_dhe_t *dhe,
+                                                    void *context, uint8_t *public_key,
+                                                    size_t *public_key_size)
+{
+    switch (dhe->type) {
+#if LIBSPDM_FFDHE_SUPPORT_TEST
+    case LIBSPDM_CRYPT_BENCH_DHE_FFDHE:
+        return libspdm_dh_generate_key(context, public_key, public_key_size);
+#endif
+#if LIBSPDM_ECDHE_SUPPORT_TEST
+    case LIBSPDM_CRYPT_BENCH_DHE_ECDHE:
+        return libspdm_ec_generate_key(context, public_key, public_key_size);
+#endif
+#if LIBSPDM_SM2_KEY_EXCHANGE_SUPPORT_TEST
+    case LIBSPDM_CRYPT_BENCH_DHE_SM2:
+        return libspdm_sm2_key_exchange_init(context, LIBSPDM_CRYPTO_NID_SM3_256,
+                                             m_libspdm_crypt_bench_sm2_id,
+                                             sizeof(m_libspdm_crypt_bench_sm2_id) - 1,
+                                             m_libspdm_crypt_bench_sm2_id,
+                                             sizeof(m_libspdm_crypt_bench_sm2_id) - 1,
+                                             true) &&
+               libspdm_sm2_key_exchange_generate_key(context, public_key, public_key_size);
+#endif
+    default:
+        return false;
+    }
+}
+
+static bool libspdm_crypt_bench_dhe_init(void *param, void *context)
+{
+    size_t public_key_size;
+
+    public_key_size = LIBSPDM_CRYPT_BENCH_MAX_DHE_KEY_SIZE;
+    return libspdm_crypt_bench_dhe_generate_key_of(param, context, m_libspdm_crypt_bench_output,
+                                                   &public_key_size);
+}
+
+static bool libspdm_crypt_bench_dhe_generate_key(void *param, size_t data_size)
+{
+    libspdm_crypt_bench_dhe_t *dhe;
+
+    dhe = param;
+    return libspdm_crypt_bench_dhe_init(dhe, dhe->context);
+}
+
+static bool libspdm_crypt_bench_dhe_compute_key(void *param, size_t data_size)
+{
+    libspdm_crypt_bench_dhe_t *dhe;
+    size_t key_size;
+
+    dhe = param;
+    key_size = LIBSPDM_CRYPT_BENCH_MAX_DHE_KEY_SIZE;
+    switch (dhe->type) {
+#if LIBSPDM_FFDHE_SUPPORT_TEST
+    case LIBSPDM_CRYPT_BENCH_DHE_FFDHE:
+        return libspdm_dh_compute_key(dhe->context, dhe->peer_public_key,
+                                      dhe->peer_public_key_size,
+                                      m_libspdm_crypt_bench_output, &key_size);
+#endif
+#if LIBSPDM_ECDHE_SUPPORT_TEST
+    case LIBSPDM_CRYPT_BENCH_DHE_ECDHE:
+        return libspdm_ec_compute_key(dhe->context, dhe->peer_public_key,
+                                      dhe->peer_public_key_size,
+                                      m_libspdm_crypt_bench_output, &key_size);
+#endif
+#if LIBSPDM_SM2_KEY_EXCHANGE_SUPPORT_TEST
+    case LIBSPDM_CRYPT_BENCH_DHE_SM2:
+        return libspdm_sm2_key_exchange_compute_key(dhe->context, dhe->peer_public_key,
+                                                    dhe->peer_public_key_size,
+                                                    m_libspdm_crypt_bench_output, &key_size);
+#endif
+    default:
+        return false;
+    }
+}
+
+static void libspdm_crypt_bench_one_dhe(libspdm_crypt_bench_dhe_t *dhe)
+{
+    void *peer_context;
+    bool result;
+
+    libspdm_crypt_bench_run_lifecycle(dhe->name, "", libspdm_crypt_bench_dhe_new,
+                                      libspdm_crypt_bench_dhe_init,
+                                      libspdm_crypt_bench_dhe_free, dhe);
+
+    dhe->context = libspdm_crypt_bench_dhe_new(dhe);
+    peer_context = libspdm_crypt_bench_dhe_new(dhe);
+    result = (dhe->context != NULL) && (peer_context != NULL);
+    if (result) {
+        dhe->peer_public_key_size = sizeof(dhe->peer_public_key);
+        result = libspdm_crypt_bench_dhe_generate_key_of(dhe, peer_context,
+                                                         dhe->peer_public_key,
+                                                         &dhe->peer_public_key_size);
+    }
+    if (result) {
+        /* The generate_key benchmark leaves the context with a key pair for compute_key. */
+        if (libspdm_crypt_bench_run(dhe->name, "generate_key", 0,
+                                    libspdm_crypt_bench_dhe_generate_key, dhe)) {
+            libspdm_crypt_bench_run(dhe->name, "compute_key", 0,
+                                    libspdm_crypt_bench_dhe_compute_key, dhe);
+        }
+    }
+    if (peer_context != NULL) {
+        libspdm_crypt_bench_dhe_free(dhe, peer_context);
+    }
+    if (dhe->context != NULL) {
+        libspdm_crypt_bench_dhe_free(dhe, dhe->context);
+        dhe->context = NULL;
+    }
+}
+
+void libspdm_crypt_bench_asym(void)
+{
+    size_t index;
+
+    for (index = 0; index < LIBSPDM_CRYPT_BENCH_ARRAY_SIZE(m_libspdm_crypt_bench_sign);
+         index++) {
+        if (libspdm_crypt_bench_selected(m_libspdm_crypt_bench_sign[index].name)) {
+            libspdm_crypt_bench_one_sign(&m_libspdm_crypt_bench_sign[index]);
+        }
+    }
+    for (index = 0; index < LIBSPDM_CRYPT_BENCH_ARRAY_SIZE(m_libspdm_crypt_bench_dhe);
+         index++) {
+        if (libspdm_crypt_bench_selected(m_libspdm_crypt_bench_dhe[index].name)) {
+            libspdm_crypt_bench_one_dhe(&m_libspdm_crypt_bench_dhe[index]);
+        }
+    }
+}
@@ -0,0 +1,313 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2021-2022 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+#include "test_crypt_bench.h"
+
+/* HMAC key and HKDF PRK size. SPDM derives them from a hash, so they have the digest size. */
+#define LIBSPDM_CRYPT_BENCH_MAX_DIGEST_SIZE 64
+
+typedef struct {
+    const char *name;
+    size_t digest_size;
+
+    void *(*hash_new)(void);
+    void (*hash_free)(void *context);
+    bool (*hash_init)(void *context);
+    bool (*hash_update)(void *context, const void *data, size_t data_size);
+    bool (*hash_final)(void *context, uint8_t *hash_value);
+    bool (*hash_all)(const void *data, size_t data_size, uint8_t *hash_value);
+
+    void *(*hmac_new)(void);
+    void (*hmac_free)(void *context);
+    bool (*hmac_set_key)(void *context, const uint8_t *key, size_t key_size);
+    bool (*hmac_update)(void *context, const void *data, size_t data_size);
+    bool (*hmac_final)(void *context, uint8_t *hmac_value);
+    bool (*hmac_all)(const void *data, size_t data_size, const uint8_t *key, size_t key_size,
+                     uint8_t *hmac_value);
+
+    bool (*hkdf_extract)(const uint8_t *key, size_t key_size, const uint8_t *salt,
+                         size_t salt_size, uint8_t *prk_out, size_t prk_out_size);
+    bool (*hkdf_expand)(const uint8_t *prk, size_t prk_size, const uint8_t *info,
+                        size_t info_size, uint8_t *out, size_t out_size);
+} libspdm_crypt_bench_digest_t;
+
+typedef struct {
+    const libspdm_crypt_bench_digest_t *digest;
+    void *context;
+} libspdm_crypt_bench_digest_param_t;
+
+static const libspdm_crypt_bench_digest_t m_libspdm_crypt_bench_digest[] = {
+#if LIBSPDM_SHA256_SUPPORT_TEST
+    {
+        "sha256", LIBSPDM_SHA256_DIGEST_SIZE,
+        libspdm_sha256_new, libspdm_sha256_free, libspdm_sha256_init,
+        libspdm_sha256_update, libspdm_sha256_final, libspdm_sha256_hash_all,
+        libspdm_hmac_sha256_new, libspdm_hmac_sha256_free, libspdm_hmac_sha256_set_key,
+        libspdm_hmac_sha256_update, libspdm_hmac_sha256_final, libspdm_hmac_sha256_all,
+        libspdm_hkdf_sha256_extract, libspdm_hkdf_sha256_expand,
+    },
+#endif
+#if LIBSPDM_SHA384_SUPPORT_TEST
+    {
+        "sha384", LIBSPDM_SHA384_DIGEST_SIZE,
+        libspdm_sha384_new, libspdm_sha384_free, libspdm_sha384_init,
+        libspdm_sha384_update, libspdm_sha384_final, libspdm_sha384_hash_all,
+        libspdm_hmac_sha384_new, libspdm_hmac_sha384_free, libspdm_hmac_sha384_set_key,
+        libspdm_hmac_sha384_update, libspdm_hmac_sha384_final, libspdm_hmac_sha384_all,
+        libspdm_hkdf_sha384_extract, libspdm_hkdf_sha384_expand,
+    },
+#endif
+#if LIBSPDM_SHA512_SUPPORT_TEST
+    {
+        "sha512", LIBSPDM_SHA512_DIGEST_SIZE,
+        libspdm_sha512_new, libspdm_sha512_free, libspdm_sha512_init,
+        libspdm_sha512_update, libspdm_sha512_final, libspdm_sha512_hash_all,
+        libspdm_hmac_sha512_new, libspdm_hmac_sha512_free, libspdm_hmac_sha512_set_key,
+        libspdm_hmac_sha512_update, libspdm_hmac_sha512_final, libspdm_hmac_sha512_all,
+        libspdm_hkdf_sha512_extract, libspdm_hkdf_sha512_expand,
+    },
+#endif
+#if LIBSPDM_SHA3_256_SUPPORT_TEST
+    {
+        "sha3_256", LIBSPDM_SHA3_256_DIGEST_SIZE,
+        libspdm_sha3_256_new, libspdm_sha3_256_free, libspdm_sha3_256_init,
+        libspdm_sha3_256_update, libspdm_sha3_256_final, libspdm_sha3_256_hash_all,
+        libspdm_hmac_sha3_256_new, libspdm_hmac_sha3_256_free, libspdm_hmac_sha3_256_set_key,
+        libspdm_hmac_sha3_256_update, libspdm_hmac_sha3_256_final, libspdm_hmac_sha3_256_all,
+        libspdm_hkdf_sha3_256_extract, libspdm_hkdf_sha3_256_expand,
+    },
+#endif
+#if LIBSPDM_SHA3_384_SUPPORT_TEST
+    {
+        "sha3_384", LIBSPDM_SHA3_384_DIGEST_SIZE,
+        libspdm_sha3_384_new, libspdm_sha3_384_free, libspdm_sha3_384_init,
+        libspdm_sha3_384_update, libspdm_sha3_384_final, libspdm_sha3_384_hash_all,
+        libspdm_hmac_sha3_384_new, libspdm_hmac_sha3_384_free, libspdm_hmac_sha3_384_set_key,
+        libspdm_hmac_sha3_384_update, libspdm_hmac_sha3_384_final, libspdm_hmac_sha3_384_all,
+        libspdm_hkdf_sha3_384_extract, libspdm_hkdf_sha3_384_expand,
+    },
+#endif
+#if LIBSPDM_SHA3_512_SUPPORT_TEST
+    {
+        "sha3_512", LIBSPDM_SHA3_512_DIGEST_SIZE,
+        libspdm_sha3_512_new, libspdm_sha3_512_free, libspdm_sha3_512_init,
+        libspdm_sha3_512_update, libspdm_sha3_512_final, libspdm_sha3_512_hash_all,
+        libspdm_hmac_sha3_512_new, libspdm_hmac_sha3_512_free, libspdm_hmac_sha3_512_set_key,
+        libspdm_hmac_sha3_512_update, libspdm_hmac_sha3_512_final, libspdm_hmac_sha3_512_all,
+        libspdm_hkdf_sha3_512_extract, libspdm_hkdf_sha3_512_expand,
+    },
+#endif
+#if LIBSPDM_SM3_256_SUPPORT_TEST
+    {
+        "sm3_256", LIBSPDM_SM3_256_DIGEST_SIZE,
+        libspdm_sm3_256_new, libspdm_sm3_256_free, libspdm_sm3_256_init,
+        libspdm_sm3_256_update, libspdm_sm3_256_final, libspdm_sm3_256_hash_all,
+        libspdm_hmac_sm3_256_new, libspdm_hmac_sm3_256_free, libspdm_hmac_sm3_256_set_key,
+        libspdm_hmac_sm3_256_update, libspdm_hmac_sm3_256_final, libspdm_hmac_sm3_256_all,
+        libspdm_hkdf_sm3_256_extract, libspdm_hkdf_sm3_256_expand,
+    },
+#endif
+};
+
+static uint8_t m_libspdm_crypt_bench_key[LIBSPDM_CRYPT_BENCH_MAX_DIGEST_SIZE];
+
+static void *libspdm_crypt_bench_hash_new(void *param)
+{
+    return ((libspdm_crypt_bench_digest_param_t *)param)->digest->hash_new();
+}
+
+static bool libspdm_crypt_bench_hash_init(void *param, void *context)
+{
+    return ((libspdm_crypt_bench_digest_param_t *)param)->digest->hash_init(context);
+}
+
+static void libspdm_crypt_bench_hash_free(void *param, void *context)
+{
+    ((libspdm_crypt_bench_digest_param_t *)param)->digest->hash_free(context);
+}
+
+static bool libspdm_crypt_bench_hash_update(void *param, size_t data_size)
+{
+    libspdm_crypt_bench_digest_param_t *digest_param;
+
+    digest_param = param;
+    return digest_param->digest->hash_update(digest_param->context,
+                                             m_libspdm_crypt_bench_data, data_size);
+}
+
+static bool libspdm_crypt_bench_hash_final(void *param, size_t data_size)
+{
+    libspdm_crypt_bench_digest_param_t *digest_param;
+
+    digest_param = param;
+    /* A final context cannot be finalized again, so the timed call includes the init. */
+    return digest_param->digest->hash_init(digest_param->context) &&
+           digest_param->digest->hash_final(digest_param->context,
+                                            m_libspdm_crypt_bench_output);
+}
+
+static bool libspdm_crypt_bench_hash_all(void *param, size_t data_size)
+{
+    return ((libspdm_crypt_bench_digest_param_t *)param)->digest->hash_all(
+        m_libspdm_crypt_bench_data, data_size, m_libspdm_crypt_bench_output);
+}
+
+static void *libspdm_crypt_bench_hmac_new(void *param)
+{
+    return ((libspdm_crypt_bench_digest_param_t *)param)->digest->hmac_new();
+}
+
+static bool libspdm_crypt_bench_hmac_set_key(void *param, void *context)
+{
+    libspdm_crypt_bench_digest_param_t *digest_param;
+
+    digest_param = param;
+    return digest_param->digest->hmac_set_key(context, m_libspdm_crypt_bench_key,
+                                              digest_param->digest->digest_size);
+}
+
+static void libspdm_crypt_bench_hmac_free(void *param, void *context)
+{
+    ((libspdm_crypt_bench_digest_param_t *)param)->digest->hmac_free(context);
+}
+
+static bool libspdm_crypt_bench_hmac_update(void *param, size_t data_size)
+{
+    libspdm_crypt_bench_digest_param_t *digest_param;
+
+    digest_param = param;
+    return digest_param->digest->hmac_update(digest_param->context,
+                                             m_libspdm_crypt_bench_data, data_size);
+}
+
+static bool libspdm_crypt_bench_hmac_final(void *param, size_t data_size)
+{
+    libspdm_crypt_bench_digest_param_t *digest_param;
+
+    digest_param = param;
+    /* A final context cannot be finalized again, so the timed call includes the set_key. */
+    return libspdm_crypt_bench_hmac_set_key(param, digest_param->context) &&
+           digest_param->digest->hmac_final(digest_param->context,
+                                            m_libspdm_crypt_bench_output);
+}
+
+static bool libspdm_crypt_bench_hmac_all(void *param, size_t data_size)
+{
+    libspdm_crypt_bench_digest_param_t *digest_param;
+
+    digest_param = param;
+    return digest_param->digest->hmac_all(m_libspdm_crypt_bench_data, data_size,
+                                          m_libspdm_crypt_bench_key,
+                                          digest_param->digest->digest_size,
+                                          m_libspdm_crypt_bench_output);
+}
+
+static bool libspdm_crypt_bench_hkdf_extract(void *param, size_t data_size)
+{
+    libspdm_crypt_bench_digest_param_t *digest_param;
+
+    digest_param = param;
+    return digest_param->digest->hkdf_extract(m_libspdm_crypt_bench_data, data_size,
+                                              m_libspdm_crypt_bench_key,
+                                              digest_param->digest->digest_size,
+                                              m_libspdm_crypt_bench_output,
+                                              digest_param->digest->digest_size);
+}
+
+static bool libspdm_crypt_bench_hkdf_expand(void *param, size_t data_size)
+{
+    libspdm_crypt_bench_digest_param_t *digest_param;
+
+    digest_param = param;
+    return digest_param->digest->hkdf_expand(m_libspdm_crypt_bench_key,
+                                             digest_param->digest->digest_size,
+                                             m_libspdm_crypt_bench_data, 64,
+                                             m_libspdm_crypt_bench_output, data_size);
+}
+
+static void libspdm_crypt_bench_one_digest(const libspdm_crypt_bench_digest_t *digest)
+{
+    libspdm_crypt_bench_digest_param_t param;
+    size_t index;
+    size_t data_size;
+
+    param.digest = digest;
+    param.context = NULL;
+
+    libspdm_crypt_bench_run_lifecycle(digest->name, "", libspdm_crypt_bench_hash_new,
+                                      libspdm_crypt_bench_hash_init,
+                                      libspdm_crypt_bench_hash_free, &param);
+    for (index = 0; index < LIBSPDM_CRYPT_BENCH_DATA_SIZE_COUNT; index++) {
+        libspdm_crypt_bench_run(digest->name, "hash_all", m_libspdm_crypt_bench_data_size[index],
+                                libspdm_crypt_bench_hash_all, &param);
+    }
+    param.context = digest->hash_new();
+    if ((param.context != NULL) && digest->hash_init(param.context)) {
+        for (index = 0; index < LIBSPDM_CRYPT_BENCH_DATA_SIZE_COUNT; index++) {
+            libspdm_crypt_bench_run(digest->name, "update", m_libspdm_crypt_bench_data_size[index],
+                                    libspdm_crypt_bench_hash_update, &param);
+        }
+        libspdm_crypt_bench_run(digest->name, "init_final", 0,
+                                libspdm_crypt_bench_hash_final, &param);
+    }
+    if (param.context != NULL) {
+        digest->hash_free(param.context);
+    }
+
+    libspdm_crypt_bench_run_lifecycle(digest->name, "hmac_", libspdm_crypt_bench_hmac_new,
+                                      libspdm_crypt_bench_hmac_set_key,
+                                      libspdm_crypt_bench_hmac_free, &param);
+    for (index = 0; index < LIBSPDM_CRYPT_BENCH_DATA_SIZE_COUNT; index++) {
+        libspdm_crypt_bench_run(digest->name, "hmac_all", m_libspdm_crypt_bench_data_size[index],
+                                libspdm_crypt_bench_hmac_all, &param);
+    }
+    param.context = digest->hmac_new();
+    if ((param.context != NULL) &&
+        libspdm_crypt_bench_hmac_set_key(&param, param.context)) {
+        for (index = 0; index < LIBSPDM_CRYPT_BENCH_DATA_SIZE_COUNT; index++) {
+            libspdm_crypt_bench_run(digest->name, "hmac_update",
+                                    m_libspdm_crypt_bench_data_size[index],
+                                    libspdm_crypt_bench_hmac_update, &param);
+        }
+        libspdm_crypt_bench_run(digest->name, "hmac_set_key_final", 0,
+                                libspdm_crypt_bench_hmac_final, &param);
+    }
+    if (param.context != NULL) {
+        digest->hmac_free(param.context);
+    }
+    param.context = NULL;
+
+    for (index = 0; index < LIBSPDM_CRYPT_BENCH_DATA_SIZE_COUNT; index++) {
+        libspdm_crypt_bench_run(digest->name, "hkdf_extract",
+                                m_libspdm_crypt_bench_data_size[index],
+                                libspdm_crypt_bench_hkdf_extract, &param);
+    }
+    /* HKDF-Expand output is limited to 255 blocks. */
+    for (index = 0; index < LIBSPDM_CRYPT_BENCH_DATA_SIZE_COUNT; index++) {
+        data_size = m_libspdm_crypt_bench_data_size[index];
+        if (data_size > 255 * digest->digest_size) {
+            break;
+        }
+        libspdm_crypt_bench_run(digest->name, "hkdf_expand", data_size,
+                                libspdm_crypt_bench_hkdf_expand, &param);
+    }
+}
+
+void libspdm_crypt_bench_digest(void)
+{
+    size_t index;
+
+    for (index = 0; index < sizeof(m_libspdm_crypt_bench_key); index++) {
+        m_libspdm_crypt_bench_key[index] = (uint8_t)(0x5a ^ index);
+    }
+
+    for (index = 0; index < LIBSPDM_CRYPT_BENCH_ARRAY_SIZE(m_libspdm_crypt_bench_digest);
+         index++) {
+        if (libspdm_crypt_bench_selected(m_libspdm_crypt_bench_digest[index].name)) {
+            libspdm_crypt_bench_one_digest(&m_libspdm_crypt_bench_digest[index]);
+        }
+    }
+}
@@ -0,0 +1,360 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2021-2022 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+/*
+ * Crypto primitive microbenchmark.
+ *
+ * Every cryptlib entry point used by libspdm is timed over the message sizes SPDM uses, from
+ * 4 bytes to 64 KiB, with the same harness for every crypto backend. The context setup and
+ * teardown calls (_new, _init or _set_key, _free) are reported separately from the
+ * steady-state calls.
+ *
+ * For each operation the report gives the latency distribution per call (min/mean/p50/p90/p99/max
+ * in microseconds), the number of calls per second and the cycles per call. Operations that
+ * process a message also report MB/s and cycles per byte.
+ *
+ * Run it from the directory holding the sample keys (the build output directory).
+ * The report goes to crypt_bench.json unless -o is given; "-o -" selects stdout.
+ *
+ * usage: test_crypt_bench [-n samples] [-o report.json] [--algo NAME]
+ */
+
+#include "test_crypt_bench.h"
+
+#ifndef LIBSPDM_BENCH_CRYPTO_NAME
+#define LIBSPDM_BENCH_CRYPTO_NAME "unknown"
+#endif
+
+#define LIBSPDM_CRYPT_BENCH_DEFAULT_SAMPLES 100
+#define LIBSPDM_CRYPT_BENCH_DEFAULT_OUTPUT_FILE "crypt_bench.json"
+
+/* A timed batch runs for at least this long, so that the clock resolution does not matter. */
+#define LIBSPDM_CRYPT_BENCH_MIN_BATCH_US 10.0
+
+/* Upper bound of the calls in one timed batch. */
+#define LIBSPDM_CRYPT_BENCH_MAX_BATCH 4096
+
+/* Upper bound of the contexts allocated in one timed batch of the lifecycle benchmark. */
+#define LIBSPDM_CRYPT_BENCH_MAX_CONTEXT 64
+
+typedef enum {
+    LIBSPDM_CRYPT_BENCH_STAT_OP,
+    LIBSPDM_CRYPT_BENCH_STAT_NEW,
+    LIBSPDM_CRYPT_BENCH_STAT_INIT,
+    LIBSPDM_CRYPT_BENCH_STAT_FREE,
+    LIBSPDM_CRYPT_BENCH_STAT_MAX
+} libspdm_crypt_bench_stat_index_t;
+
+const size_t m_libspdm_crypt_bench_data_size[LIBSPDM_CRYPT_BENCH_DATA_SIZE_COUNT] = {
+    4, 16, 64, 256, 1024, 4096, 16384, 65536
+};
+
+uint8_t m_libspdm_crypt_bench_data[LIBSPDM_CRYPT_BENCH_MAX_DATA_SIZE];
+uint8_t m_libspdm_crypt_bench_output[LIBSPDM_CRYPT_BENCH_MAX_DATA_SIZE + 1024];
+
+static FILE *m_libspdm_crypt_bench_fp;
+static bool m_libspdm_crypt_bench_first_result;
+static size_t m_libspdm_crypt_bench_samples;
+static const char *m_libspdm_crypt_bench_filter;
+static libspdm_bench_stat_t m_libspdm_crypt_bench_stat[LIBSPDM_CRYPT_BENCH_STAT_MAX];
+static void *m_libspdm_crypt_bench_context[LIBSPDM_CRYPT_BENCH_MAX_CONTEXT];
+
+bool libspdm_crypt_bench_selected(const char *algorithm)
+{
+    return (m_libspdm_crypt_bench_filter == NULL) ||
+           (strcmp(m_libspdm_crypt_bench_filter, algorithm) == 0);
+}
+
+/**
+ * Write one result to the report and a one-line summary to stderr.
+ *
+ * @param total_calls   number of calls timed, across all samples.
+ * @param total_us      time spent in the timed calls.
+ * @param total_cycles  CPU cycles spent in the timed calls, 0 if unknown.
+ **/
+static void libspdm_crypt_bench_report(const char *algorithm, const char *operation,
+                                       size_t data_size, bool success,
+                                       libspdm_bench_stat_t *stat, size_t total_calls,
+                                       double total_us, uint64_t total_cycles)
+{
+    FILE *fp;
+    libspdm_bench_summary_t summary;
+    double ops_per_sec;
+    double mb_per_sec;
+
+    fp = m_libspdm_crypt_bench_fp;
+    fprintf(fp, "%s    {\n", m_libspdm_crypt_bench_first_result ? "" : ",\n");
+    m_libspdm_crypt_bench_first_result = false;
+
+    fprintf(fp, "      \"algorithm\": \"%s\",\n", algorithm);
+    fprintf(fp, "      \"operation\": \"%s\",\n", operation);
+    fprintf(fp, "      \"data_size\": %zu,\n", data_size);
+    if (!success || (total_calls == 0) || (total_us <= 0.0)) {
+        fprintf(fp, "      \"status\": \"failed\"\n    }");
+        fprintf(stderr, "%-20s %-22s %6zu  failed\n", algorithm, operation, data_size);
+        return;
+    }
+
+    ops_per_sec = (double)total_calls * 1e6 / total_us;
+    mb_per_sec = (double)data_size * ops_per_sec / 1e6;
+    fprintf(fp, "      \"status\": \"ok\",\n");
+    fprintf(fp, "      \"ops_per_sec\": %.1f,\n", ops_per_sec);
+    if (total_cycles != 0) {
+        fprintf(fp, "      \"cycles_per_op\": %.1f,\n",
+                (double)total_cycles / (double)total_calls);
+    }
+    if (data_size != 0) {
+        fprintf(fp, "      \"mb_per_sec\": %.3f,\n", mb_per_sec);
+        if (total_cycles != 0) {
+            fprintf(fp, "      \"cycles_per_byte\": %.3f,\n",
+                    (double)total_cycles / (double)total_calls / (double)data_size);
+        }
+    }
+    stat->name = "latency";
+    libspdm_bench_json_write_stat(fp, stat, "      ");
+    fprintf(fp, "\n    }");
+
+    libspdm_bench_stat_summarize(stat, &summary);
+    if (data_size != 0) {
+        fprintf(stderr, "%-20s %-22s %6zu  p50 %10.3f us  %10.2f MB/s\n",
+                algorithm, operation, data_size, summary.p50, mb_per_sec);
+    } else {
+        fprintf(stderr, "%-20s %-22s %6s  p50 %10.3f us  %10.1f op/s\n",
+                algorithm, operation, "-", summary.p50, ops_per_sec);
+    }
+}
+
+bool libspdm_crypt_bench_run(const char *algorithm, const char *operation, size_t data_size,
+                             libspdm_crypt_bench_op_func_t func, void *param)
+{
+    libspdm_bench_stat_t *stat;
+    size_t batch;
+    size_t index;
+    size_t sample;
+    size_t total_calls;
+    double total_us;
+    uint64_t total_cycles;
+    double start;
+    double elapsed;
+    uint64_t start_cycles;
+    bool result;
+
+    stat = &m_libspdm_crypt_bench_stat[LIBSPDM_CRYPT_BENCH_STAT_OP];
+    libspdm_bench_stat_reset(stat);
+    total_calls = 0;
+    total_us = 0.0;
+    total_cycles = 0;
+    result = true;
+
+    /* Find the batch size. This also warms up the caches and the backend. */
+    batch = 1;
+    while (true) {
+        start = libspdm_bench_now_us();
+        for (index = 0; index < batch; index++) {
+            result = func(param, data_size) && result;
+        }
+        elapsed = libspdm_bench_now_us() - start;
+        if (!result || (elapsed >= LIBSPDM_CRYPT_BENCH_MIN_BATCH_US) ||
+            (batch >= LIBSPDM_CRYPT_BENCH_MAX_BATCH)) {
+            break;
+        }
+        batch *= 2;
+    }
+
+    for (sample = 0; result && (sample < m_libspdm_crypt_bench_samples); sample++) {
+        start_cycles = libspdm_bench_cycles();
+        start = libspdm_bench_now_us();
+        for (index = 0; index < batch; index++) {
+            result = func(param, data_size) && result;
+        }
+        elapsed = libspdm_bench_now_us() - start;
+        total_cycles += libspdm_bench_cycles() - start_cycles;
+        total_us += elapsed;
+        total_calls += batch;
+        libspdm_bench_stat_add(stat, elapsed / (double)batch);
+    }
+
+    libspdm_crypt_bench_report(algorithm, operation, data_size, result, stat,
+                               total_calls, total_us, total_cycles);
+    return result;
+}
+
+bool libspdm_crypt_bench_run_lifecycle(const char *algorithm, const char *prefix,
+                                       libspdm_crypt_bench_new_func_t new_func,
+                                       libspdm_crypt_bench_init_func_t init_func,
+                                       libspdm_crypt_bench_free_func_t free_func,
+                                       void *param)
+{
+    static const char *step_name[LIBSPDM_CRYPT_BENCH_STAT_MAX] = { NULL, "new", "init", "free" };
+    size_t total_calls;
+    double total_us[LIBSPDM_CRYPT_BENCH_STAT_MAX];
+    uint64_t total_cycles[LIBSPDM_CRYPT_BENCH_STAT_MAX];
+    char operation[64];
+    size_t batch;
+    size_t allocated;
+    size_t index;
+    size_t sample;
+    size_t step;
+    double start;
+    double elapsed;
+    uint64_t start_cycles;
+    bool result;
+
+    for (step = 0; step < LIBSPDM_CRYPT_BENCH_STAT_MAX; step++) {
+        libspdm_bench_stat_reset(&m_libspdm_crypt_bench_stat[step]);
+        total_us[step] = 0.0;
+        total_cycles[step] = 0;
+    }
+    total_calls = 0;
+    result = true;
+
+    /* Find the batch size from complete new/init/free cycles. */
+    batch = 1;
+    while (result) {
+        start = libspdm_bench_now_us();
+        for (index = 0; index < batch; index++) {
+            m_libspdm_crypt_bench_context[index] = new_func(param);
+            if (m_libspdm_crypt_bench_context[index] == NULL) {
+                result = false;
+                break;
+            }
+            if (init_func != NULL) {
+                result = init_func(param, m_libspdm_crypt_bench_context[index]) && result;
+            }
+            free_func(param, m_libspdm_crypt_bench_context[index]);
+        }
+        elapsed = libspdm_bench_now_us() - start;
+        if ((elapsed >= LIBSPDM_CRYPT_BENCH_MIN_BATCH_US) ||
+            (batch >= LIBSPDM_CRYPT_BENCH_MAX_CONTEXT)) {
+            break;
+        }
+        batch *= 2;
+    }
+
+    for (sample = 0; result && (sample < m_libspdm_crypt_bench_samples); sample++) {
+        start_cycles = libspdm_bench_cycles();
+        start = libspdm_bench_now_us();
+        for (allocated = 0; allocated < batch; allocated++) {
+            m_libspdm_crypt_bench_context[allocated] = new_func(param);
+            if (m_libspdm_crypt_bench_context[allocated] == NULL) {
+                result = false;
+                break;
+            }
+        }
+        elapsed = libspdm_bench_now_us() - start;
+        total_cycles[LIBSPDM_CRYPT_BENCH_STAT_NEW] += libspdm_bench_cycles() - start_cycles;
+        total_us[LIBSPDM_CRYPT_BENCH_STAT_NEW] += elapsed;
+        libspdm_bench_stat_add(&m_libspdm_crypt_bench_stat[LIBSPDM_CRYPT_BENCH_STAT_NEW],
+                               elapsed / (double)batch);
+
+        if (result && (init_func != NULL)) {
+            start_cycles = libspdm_bench_cycles();
+            start = libspdm_bench_now_us();
+            for (index = 0; index < batch; index++) {
+                result = init_func(param, m_libspdm_crypt_bench_context[index]) && result;
+            }
+            elapsed = libspdm_bench_now_us() - start;
+            total_cycles[LIBSPDM_CRYPT_BENCH_STAT_INIT] += libspdm_bench_cycles() - start_cycles;
+            total_us[LIBSPDM_CRYPT_BENCH_STAT_INIT] += elapsed;
+            libspdm_bench_stat_add(&m_libspdm_crypt_bench_stat[LIBSPDM_CRYPT_BENCH_STAT_INIT],
+                                   elapsed / (double)batch);
+        }
+
+        start_cycles = libspdm_bench_cycles();
+        start = libspdm_bench_now_us();
+        for (index = 0; index < allocated; index++) {
+            free_func(param, m_libspdm_crypt_bench_context[index]);
+        }
+        elapsed = libspdm_bench_now_us() - start;
+        total_cycles[LIBSPDM_CRYPT_BENCH_STAT_FREE] += libspdm_bench_cycles() - start_cycles;
+        total_us[LIBSPDM_CRYPT_BENCH_STAT_FREE] += elapsed;
+        libspdm_bench_stat_add(&m_libspdm_crypt_bench_stat[LIBSPDM_CRYPT_BENCH_STAT_FREE],
+                               elapsed / (double)batch);
+
+        total_calls += batch;
+    }
+
+    for (step = LIBSPDM_CRYPT_BENCH_STAT_NEW; step < LIBSPDM_CRYPT_BENCH_STAT_MAX; step++) {
+        if ((step == LIBSPDM_CRYPT_BENCH_STAT_INIT) && (init_func == NULL)) {
+            continue;
+        }
+        snprintf(operation, sizeof(operation), "%s%s", prefix, step_name[step]);
+        libspdm_crypt_bench_report(algorithm, operation, 0, result,
+                                   &m_libspdm_crypt_bench_stat[step], total_calls,
+                                   total_us[step], total_cycles[step]);
+    }
+    return result;
+}
+
+int main(int argc, char **argv)
+{
+    const char *output_file;
+    size_t index;
+    int arg_index;
+    FILE *fp;
+
+    m_libspdm_crypt_bench_samples = LIBSPDM_CRYPT_BENCH_DEFAULT_SAMPLES;
+    m_libspdm_crypt_bench_filter = NULL;
+    output_file = LIBSPDM_CRYPT_BENCH_DEFAULT_OUTPUT_FILE;
+    for (arg_index = 1; arg_index + 1 < argc; arg_index += 2) {
+        if (strcmp(argv[arg_index], "-n") == 0) {
+            m_libspdm_crypt_bench_samples = (size_t)strtoul(argv[arg_index + 1], NULL, 0);
+        } else if (strcmp(argv[arg_index], "-o") == 0) {
+            output_file = argv[arg_index + 1];
+        } else if (strcmp(argv[arg_index], "--algo") == 0) {
+            m_libspdm_crypt_bench_filter = argv[arg_index + 1];
+        } else {
+            break;
+        }
+    }
+    if ((arg_index < argc) || (m_libspdm_crypt_bench_samples == 0)) {
+        fprintf(stderr, "usage: %s [-n samples] [-o report.json] [--algo NAME]\n", argv[0]);
+        return 1;
+    }
+
+    for (index = 0; index < LIBSPDM_CRYPT_BENCH_STAT_MAX; index++) {
+        if (!libspdm_bench_stat_init(&m_libspdm_crypt_bench_stat[index], "latency",
+                                     m_libspdm_crypt_bench_samples)) {
+            fprintf(stderr, "out of memory\n");
+            return 1;
+        }
+    }
+    for (index = 0; index < sizeof(m_libspdm_crypt_bench_data); index++) {
+        m_libspdm_crypt_bench_data[index] = (uint8_t)(index * 131 + (index >> 8));
+    }
+
+    fp = stdout;
+    if (strcmp(output_file, "-") != 0) {
+        fp = fopen(output_file, "w");
+        if (fp == NULL) {
+            fprintf(stderr, "Unable to open file %s\n", output_file);
+            return 1;
+        }
+    }
+    m_libspdm_crypt_bench_fp = fp;
+    m_libspdm_crypt_bench_first_result = true;
+
+    fprintf(fp, "{\n");
+    fprintf(fp, "  \"benchmark\": \"crypt\",\n");
+    fprintf(fp, "  \"version\": %d,\n", LIBSPDM_BENCH_REPORT_VERSION);
+    fprintf(fp, "  \"crypto\": \"%s\",\n", LIBSPDM_BENCH_CRYPTO_NAME);
+    fprintf(fp, "  \"samples\": %zu,\n", m_libspdm_crypt_bench_samples);
+    fprintf(fp, "  \"results\": [\n");
+
+    libspdm_crypt_bench_digest();
+    libspdm_crypt_bench_aead();
+    libspdm_crypt_bench_asym();
+
+    fprintf(fp, "\n  ]\n}\n");
+    if (fp != stdout) {
+        fclose(fp);
+    }
+
+    for (index = 0; index < LIBSPDM_CRYPT_BENCH_STAT_MAX; index++) {
+        libspdm_bench_stat_free(&m_libspdm_crypt_bench_stat[index]);
+    }
+    return 0;
+}
@@ -0,0 +1,223 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2021-2022 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+#ifndef __CRYPT_BENCH_H__
+#define __CRYPT_BENCH_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "spdm_bench.h"
+#include "hal/base.h"
+#include "internal/libspdm_lib_config.h"
+
+#include "hal/library/memlib.h"
+#include "hal/library/cryptlib.h"
+#include "spdm_crypt_ext_lib/cryptlib_ext.h"
+
+#if LIBSPDM_RSA_SSA_SUPPORT == 0
+#undef LIBSPDM_RSA_SSA_SUPPORT_TEST
+#define LIBSPDM_RSA_SSA_SUPPORT_TEST 0
+#endif
+
+#if LIBSPDM_RSA_PSS_SUPPORT == 0
+#undef LIBSPDM_RSA_PSS_SUPPORT_TEST
+#define LIBSPDM_RSA_PSS_SUPPORT_TEST 0
+#endif
+
+#if LIBSPDM_ECDSA_SUPPORT == 0
+#undef LIBSPDM_ECDSA_SUPPORT_TEST
+#define LIBSPDM_ECDSA_SUPPORT_TEST 0
+#endif
+
+#if LIBSPDM_SM2_DSA_SUPPORT == 0
+#undef LIBSPDM_SM2_DSA_SUPPORT_TEST
+#define LIBSPDM_SM2_DSA_SUPPORT_TEST 0
+#endif
+
+#if LIBSPDM_EDDSA_ED25519_SUPPORT == 0
+#undef LIBSPDM_EDDSA_ED25519_SUPPORT_TEST
+#define LIBSPDM_EDDSA_ED25519_SUPPORT_TEST 0
+#endif
+
+#if LIBSPDM_EDDSA_ED448_SUPPORT == 0
+#undef LIBSPDM_EDDSA_ED448_SUPPORT_TEST
+#define LIBSPDM_EDDSA_ED448_SUPPORT_TEST 0
+#endif
+
+#if LIBSPDM_FFDHE_SUPPORT == 0
+#undef LIBSPDM_FFDHE_SUPPORT_TEST
+#define LIBSPDM_FFDHE_SUPPORT_TEST 0
+#endif
+
+#if LIBSPDM_ECDHE_SUPPORT == 0
+#undef LIBSPDM_ECDHE_SUPPORT_TEST
+#define LIBSPDM_ECDHE_SUPPORT_TEST 0
+#endif
+
+#if LIBSPDM_SM2_KEY_EXCHANGE_SUPPORT == 0
+#undef LIBSPDM_SM2_KEY_EXCHANGE_SUPPORT_TEST
+#define LIBSPDM_SM2_KEY_EXCHANGE_SUPPORT_TEST 0
+#endif
+
+#if LIBSPDM_AEAD_GCM_SUPPORT == 0
+#undef LIBSPDM_AEAD_GCM_SUPPORT_TEST
+#define LIBSPDM_AEAD_GCM_SUPPORT_TEST 0
+#endif
+
+#if LIBSPDM_AEAD_CHACHA20_POLY1305_SUPPORT == 0
+#undef LIBSPDM_AEAD_CHACHA20_POLY1305_SUPPORT_TEST
+#define LIBSPDM_AEAD_CHACHA20_POLY1305_SUPPORT_TEST 0
+#endif
+
+#if LIBSPDM_AEAD_SM4_SUPPORT == 0
+#undef LIBSPDM_AEAD_SM4_SUPPORT_TEST
+#define LIBSPDM_AEAD_SM4_SUPPORT_TEST 0
+#endif
+
+#if LIBSPDM_SHA256_SUPPORT == 0
+#undef LIBSPDM_SHA256_SUPPORT_TEST
+#define LIBSPDM_SHA256_SUPPORT_TEST 0
+#endif
+
+#if LIBSPDM_SHA384_SUPPORT == 0
+#undef LIBSPDM_SHA384_SUPPORT_TEST
+#define LIBSPDM_SHA384_SUPPORT_TEST 0
+#endif
+
+#if LIBSPDM_SHA512_SUPPORT == 0
+#undef LIBSPDM_SHA512_SUPPORT_TEST
+#define LIBSPDM_SHA512_SUPPORT_TEST 0
+#endif
+
+#if LIBSPDM_SHA3_256_SUPPORT == 0
+#undef LIBSPDM_SHA3_256_SUPPORT_TEST
+#define LIBSPDM_SHA3_256_SUPPORT_TEST 0
+#endif
+
+#if LIBSPDM_SHA3_384_SUPPORT == 0
+#undef LIBSPDM_SHA3_384_SUPPORT_TEST
+#define LIBSPDM_SHA3_384_SUPPORT_TEST 0
+#endif
+
+#if LIBSPDM_SHA3_512_SUPPORT == 0
+#undef LIBSPDM_SHA3_512_SUPPORT_TEST
+#define LIBSPDM_SHA3_512_SUPPORT_TEST 0
+#endif
+
+#if LIBSPDM_SM3_256_SUPPORT == 0
+#undef LIBSPDM_SM3_256_SUPPORT_TEST
+#define LIBSPDM_SM3_256_SUPPORT_TEST 0
+#endif
+
+/* Largest message size benchmarked. It matches the largest SPDM message libspdm can assemble. */
+#define LIBSPDM_CRYPT_BENCH_MAX_DATA_SIZE 0x10000
+
+/* Number of entries in m_libspdm_crypt_bench_data_size. */
+#define LIBSPDM_CRYPT_BENCH_DATA_SIZE_COUNT 8
+
+#define LIBSPDM_CRYPT_BENCH_ARRAY_SIZE(array) (sizeof(array) / sizeof((array)[0]))
+
+/* Message sizes of the throughput benchmarks, from a 4 byte header to a 64 KiB large message. */
+extern const size_t m_libspdm_crypt_bench_data_size[LIBSPDM_CRYPT_BENCH_DATA_SIZE_COUNT];
+
+/* Pseudo-random input shared by all benchmarks. */
+extern uint8_t m_libspdm_crypt_bench_data[LIBSPDM_CRYPT_BENCH_MAX_DATA_SIZE];
+
+/* Output buffer shared by all benchmarks. It has room for a tag or a signature after the data. */
+extern uint8_t m_libspdm_crypt_bench_output[LIBSPDM_CRYPT_BENCH_MAX_DATA_SIZE + 1024];
+
+/**
+ * Run one cryptlib call on data_size bytes of m_libspdm_crypt_bench_data.
+ *
+ * @retval true   the call succeeded.
+ * @retval false  the call failed. The benchmark is reported as failed.
+ **/
+typedef bool (*libspdm_crypt_bench_op_func_t)(void *param, size_t data_size);
+
+/**
+ * Allocate a context, for example libspdm_sha256_new().
+ *
+ * @return the new context, or NULL on failure.
+ **/
+typedef void *(*libspdm_crypt_bench_new_func_t)(void *param);
+
+/**
+ * Initialize a context returned by libspdm_crypt_bench_new_func_t, for example libspdm_sha256_init().
+ **/
+typedef bool (*libspdm_crypt_bench_init_func_t)(void *param, void *context);
+
+/**
+ * Free a context returned by libspdm_crypt_bench_new_func_t.
+ **/
+typedef void (*libspdm_crypt_bench_free_func_t)(void *param, void *context);
+
+/**
+ * Check if the algorithm is selected on the command line.
+ **/
+bool libspdm_crypt_bench_selected(const char *algorithm);
+
+/**
+ * Measure the steady-state cost of a cryptlib call and add it to the report.
+ *
+ * Calls are timed in batches of at least a few microseconds, so that cheap calls on small
+ * messages are not lost in the clock resolution. The latency samples are per call.
+ *
+ * @param algorithm  algorithm name in the report.
+ * @param operation  operation name in the report.
+ * @param data_size  message size passed to func. 0 if the call does not process a message.
+ * @param func       the benchmarked call.
+ * @param param      opaque parameter of func.
+ *
+ * @retval true   the benchmark completed.
+ * @retval false  func failed.
+ **/
+bool libspdm_crypt_bench_run(const char *algorithm, const char *operation, size_t data_size,
+                             libspdm_crypt_bench_op_func_t func, void *param);
+
+/**
+ * Measure the setup and teardown cost of a cryptlib context and add it to the report.
+ *
+ * The new, init and free steps are timed separately and reported as the operations
+ * "<prefix>new", "<prefix>init" and "<prefix>free".
+ *
+ * @param algorithm  algorithm name in the report.
+ * @param prefix     operation name prefix, for example "hmac_". It may be empty.
+ * @param new_func   allocates a context.
+ * @param init_func  initializes a context. NULL if the context has no separate init step.
+ * @param free_func  frees a context.
+ * @param param      opaque parameter of the functions.
+ *
+ * @retval true   the benchmark completed.
+ * @retval false  one of the functions failed.
+ **/
+bool libspdm_crypt_bench_run_lifecycle(const char *algorithm, const char *prefix,
+                                       libspdm_crypt_bench_new_func_t new_func,
+                                       libspdm_crypt_bench_init_func_t init_func,
+                                       libspdm_crypt_bench_free_func_t free_func,
+                                       void *param);
+
+bool libspdm_read_input_file(const char *file_name, void **file_data, size_t *file_size);
+
+/**
+ * Benchmark hash, HMAC and HKDF.
+ **/
+void libspdm_crypt_bench_digest(void);
+
+/**
+ * Benchmark AEAD encryption and decryption.
+ **/
+void libspdm_crypt_bench_aead(void);
+
+/**
+ * Benchmark signing, verification and key exchange.
+ **/
+void libspdm_crypt_bench_asym(void);
+
+#endif
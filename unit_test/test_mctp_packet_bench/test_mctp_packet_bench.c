@@ -0,0 +1,482 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2021-2022 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+/*
+ * MCTP packetization and reassembly benchmark.
+ *
+ * A message of the message size, starting with the MCTP message type, is split into packets and
+ * reassembled for each transmission unit. Each sample times a batch of messages, and is reported
+ * per message:
+ *   fragment_copy:   each packet is copied to a packet buffer, header then payload, and the
+ *                    packet buffer is handed to the bus.
+ *   fragment_iovec:  libspdm_mctp_packetize_message, and the header and the payload of each packet
+ *                    are handed to the bus as two segments.
+ *   reassemble_copy: each packet payload is appended to a receive buffer, and the whole message
+ *                    is copied to the caller's buffer on EOM.
+ *   reassemble_slot: libspdm_mctp_reassemble_packet, and the message is used in its slot.
+ * The bus only counts the bytes it is handed and reads the first byte of each segment.
+ * All copies use libspdm_copy_mem, as the library does, so the operations differ only in the
+ * number of copies.
+ * The transmission unit is 64 (the baseline transmission unit), 128, 256 and 1024 unless --btu
+ * is given.
+ * The results are written as JSON with min/mean/p50/p90/p99/max latency in microseconds, and the
+ * throughput in MB/s computed from the mean.
+ *
+ * The report goes to mctp_packet_bench.json unless -o is given; "-o -" selects stdout.
+ *
+ * usage: test_mctp_packet_bench [-n iterations] [-o report.json] [--size bytes] [--btu bytes]
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "spdm_bench.h"
+#include "hal/base.h"
+#include "library/spdm_transport_mctp_lib.h"
+#include "hal/library/memlib.h"
+
+#define LIBSPDM_BENCH_DEFAULT_ITERATIONS 200
+#define LIBSPDM_BENCH_DEFAULT_OUTPUT_FILE "mctp_packet_bench.json"
+
+/* Messages timed in one sample. */
+#define LIBSPDM_BENCH_BATCH_SIZE 64
+
+#define LIBSPDM_BENCH_DEFAULT_MESSAGE_SIZE 0x1000
+#define LIBSPDM_BENCH_MAX_MESSAGE_SIZE 0x10000
+#define LIBSPDM_BENCH_MAX_TRANSMISSION_UNIT 0x1000
+
+#define LIBSPDM_BENCH_DESTINATION_ID 0x10
+#define LIBSPDM_BENCH_SOURCE_ID 0x20
+
+static const size_t m_libspdm_bench_transmission_unit[] = { 64, 128, 256, 1024 };
+
+#define LIBSPDM_BENCH_ARRAY_SIZE(array) (sizeof(array) / sizeof((array)[0]))
+
+typedef enum {
+    LIBSPDM_BENCH_OP_FRAGMENT_COPY,
+    LIBSPDM_BENCH_OP_FRAGMENT_IOVEC,
+    LIBSPDM_BENCH_OP_REASSEMBLE_COPY,
+    LIBSPDM_BENCH_OP_REASSEMBLE_SLOT,
+    LIBSPDM_BENCH_OP_MAX
+} libspdm_bench_op_t;
+
+static const char *m_libspdm_bench_op_name[LIBSPDM_BENCH_OP_MAX] = {
+    "fragment_copy",
+    "fragment_iovec",
+    "reassemble_copy",
+    "reassemble_slot",
+};
+
+static libspdm_bench_stat_t m_libspdm_bench_stat[LIBSPDM_BENCH_OP_MAX];
+
+static uint8_t *m_libspdm_bench_message;
+static libspdm_mctp_packet_t *m_libspdm_bench_packet;
+static size_t m_libspdm_bench_max_packet_count;
+
+/* The packets of the message as received from the bus, one after the other. */
+static uint8_t *m_libspdm_bench_bus_packet;
+static size_t *m_libspdm_bench_bus_packet_size;
+
+/* Buffers of the copy-based fragmentation and reassembly. */
+static uint8_t m_libspdm_bench_packet_buffer[sizeof(mctp_header_t) +
+                                             LIBSPDM_BENCH_MAX_TRANSMISSION_UNIT];
+static uint8_t *m_libspdm_bench_receive_buffer;
+static uint8_t *m_libspdm_bench_caller_buffer;
+
+/* Reassembler with one slot per message tag. */
+#define LIBSPDM_BENCH_SLOT_COUNT 8
+static libspdm_mctp_reassembly_slot_t m_libspdm_bench_slot[LIBSPDM_BENCH_SLOT_COUNT];
+static libspdm_mctp_reassembler_t m_libspdm_bench_reassembler;
+static uint8_t *m_libspdm_bench_slot_buffer;
+
+static size_t m_libspdm_bench_bus_bytes;
+static uint8_t m_libspdm_bench_bus_check;
+
+static void libspdm_bench_bus_send(const void *segment, size_t segment_size)
+{
+    m_libspdm_bench_bus_bytes += segment_size;
+    m_libspdm_bench_bus_check ^= *(const uint8_t *)segment;
+}
+
+static bool libspdm_bench_fragment_copy(size_t transmission_unit, size_t message_size)
+{
+    mctp_header_t *mctp_header;
+    size_t payload_size;
+    size_t offset;
+    size_t index;
+
+    mctp_header = (void *)m_libspdm_bench_packet_buffer;
+    offset = 0;
+    for (index = 0; offset < message_size; index++) {
+        payload_size = LIBSPDM_MIN(transmission_unit, message_size - offset);
+        mctp_header->header_version = MCTP_HEADER_VERSION;
+        mctp_header->destination_id = LIBSPDM_BENCH_DESTINATION_ID;
+        mctp_header->source_id = LIBSPDM_BENCH_SOURCE_ID;
+        mctp_header->message_tag = (uint8_t)((index & 3) << MCTP_PACKET_SEQUENCE_NUMBER_SHIFT);
+        if (index == 0) {
+            mctp_header->message_tag |= MCTP_START_OF_MESSAGE;
+        }
+        if (offset + payload_size == message_size) {
+            mctp_header->message_tag |= MCTP_END_OF_MESSAGE;
+        }
+        libspdm_copy_mem(mctp_header + 1, LIBSPDM_BENCH_MAX_TRANSMISSION_UNIT,
+                         m_libspdm_bench_message + offset, payload_size);
+        libspdm_bench_bus_send(m_libspdm_bench_packet_buffer,
+                               sizeof(mctp_header_t) + payload_size);
+        offset += payload_size;
+    }
+    return true;
+}
+
+static bool libspdm_bench_fragment_iovec(size_t transmission_unit, size_t message_size)
+{
+    size_t packet_count;
+    size_t index;
+
+    packet_count = m_libspdm_bench_max_packet_count;
+    if (libspdm_mctp_packetize_message(LIBSPDM_BENCH_DESTINATION_ID, LIBSPDM_BENCH_SOURCE_ID, 0,
+                                       transmission_unit, message_size, m_libspdm_bench_message,
+                                       &packet_count, m_libspdm_bench_packet) !=
+        LIBSPDM_STATUS_SUCCESS) {
+        return false;
+    }
+    for (index = 0; index < packet_count; index++) {
+        libspdm_bench_bus_send(&m_libspdm_bench_packet[index].header, sizeof(mctp_header_t));
+        libspdm_bench_bus_send(m_libspdm_bench_packet[index].payload,
+                               m_libspdm_bench_packet[index].payload_size);
+    }
+    return true;
+}
+
+static bool libspdm_bench_reassemble_copy(size_t packet_count, size_t message_size)
+{
+    const uint8_t *packet;
+    const mctp_header_t *mctp_header;
+    size_t payload_size;
+    size_t receive_size;
+    size_t index;
+
+    packet = m_libspdm_bench_bus_packet;
+    receive_size = 0;
+    for (index = 0; index < packet_count; index++) {
+        mctp_header = (const void *)packet;
+        payload_size = m_libspdm_bench_bus_packet_size[index] - sizeof(mctp_header_t);
+        if ((mctp_header->message_tag & MCTP_START_OF_MESSAGE) != 0) {
+            receive_size = 0;
+        }
+        libspdm_copy_mem(m_libspdm_bench_receive_buffer + receive_size,
+                         message_size - receive_size, mctp_header + 1, payload_size);
+        receive_size += payload_size;
+        if ((mctp_header->message_tag & MCTP_END_OF_MESSAGE) != 0) {
+            libspdm_copy_mem(m_libspdm_bench_caller_buffer, message_size,
+                             m_libspdm_bench_receive_buffer, receive_size);
+            libspdm_bench_bus_send(m_libspdm_bench_caller_buffer, receive_size);
+        }
+        packet += m_libspdm_bench_bus_packet_size[index];
+    }
+    return receive_size == message_size;
+}
+
+static bool libspdm_bench_reassemble_slot(size_t packet_count, size_t message_size)
+{
+    const uint8_t *packet;
+    size_t reassembled_size;
+    void *reassembled;
+    size_t index;
+
+    packet = m_libspdm_bench_bus_packet;
+    reassembled = NULL;
+    reassembled_size = 0;
+    for (index = 0; index < packet_count; index++) {
+        if (libspdm_mctp_reassemble_packet(&m_libspdm_bench_reassembler,
+                                           m_libspdm_bench_bus_packet_size[index], packet,
+                                           &reassembled_size, &reassembled) !=
+            LIBSPDM_STATUS_SUCCESS) {
+            return false;
+        }
+        packet += m_libspdm_bench_bus_packet_size[index];
+    }
+    if (reassembled == NULL) {
+        return false;
+    }
+    libspdm_bench_bus_send(reassembled, reassembled_size);
+    libspdm_mctp_release_reassembled_message(&m_libspdm_bench_reassembler, reassembled);
+    return reassembled_size == message_size;
+}
+
+/* Build the packets of the message as they arrive from the bus. */
+static size_t libspdm_bench_build_bus_packets(size_t transmission_unit, size_t message_size)
+{
+    size_t packet_count;
+    size_t index;
+    uint8_t *packet;
+
+    packet_count = m_libspdm_bench_max_packet_count;
+    if (libspdm_mctp_packetize_message(LIBSPDM_BENCH_DESTINATION_ID, LIBSPDM_BENCH_SOURCE_ID, 0,
+                                       transmission_unit, message_size, m_libspdm_bench_message,
+                                       &packet_count, m_libspdm_bench_packet) !=
+        LIBSPDM_STATUS_SUCCESS) {
+        return 0;
+    }
+    packet = m_libspdm_bench_bus_packet;
+    for (index = 0; index < packet_count; index++) {
+        memcpy(packet, &m_libspdm_bench_packet[index].header, sizeof(mctp_header_t));
+        memcpy(packet + sizeof(mctp_header_t), m_libspdm_bench_packet[index].payload,
+               m_libspdm_bench_packet[index].payload_size);
+        m_libspdm_bench_bus_packet_size[index] =
+            sizeof(mctp_header_t) + m_libspdm_bench_packet[index].payload_size;
+        packet += m_libspdm_bench_bus_packet_size[index];
+    }
+    return packet_count;
+}
+
+static bool libspdm_bench_time(libspdm_bench_op_t op, size_t transmission_unit,
+                               size_t packet_count, size_t message_size)
+{
+    double start_us;
+    size_t index;
+    bool result;
+
+    result = true;
+    start_us = libspdm_bench_now_us();
+    for (index = 0; (index < LIBSPDM_BENCH_BATCH_SIZE) && result; index++) {
+        switch (op) {
+        case LIBSPDM_BENCH_OP_FRAGMENT_COPY:
+            result = libspdm_bench_fragment_copy(transmission_unit, message_size);
+            break;
+        case LIBSPDM_BENCH_OP_FRAGMENT_IOVEC:
+            result = libspdm_bench_fragment_iovec(transmission_unit, message_size);
+            break;
+        case LIBSPDM_BENCH_OP_REASSEMBLE_COPY:
+            result = libspdm_bench_reassemble_copy(packet_count, message_size);
+            break;
+        default:
+            result = libspdm_bench_reassemble_slot(packet_count, message_size);
+            break;
+        }
+    }
+    if (result) {
+        libspdm_bench_stat_add(&m_libspdm_bench_stat[op],
+                               (libspdm_bench_now_us() - start_us) / LIBSPDM_BENCH_BATCH_SIZE);
+    }
+    return result;
+}
+
+static bool libspdm_bench_run_transmission_unit(FILE *fp, bool first, size_t transmission_unit,
+                                                size_t message_size, size_t iterations)
+{
+    libspdm_bench_summary_t summary;
+    libspdm_bench_op_t failed_op;
+    size_t packet_count;
+    size_t iteration;
+    size_t op;
+    bool result;
+    bool first_op;
+
+    for (op = 0; op < LIBSPDM_BENCH_OP_MAX; op++) {
+        libspdm_bench_stat_reset(&m_libspdm_bench_stat[op]);
+    }
+
+    failed_op = LIBSPDM_BENCH_OP_MAX;
+    iteration = 0;
+    packet_count = libspdm_bench_build_bus_packets(transmission_unit, message_size);
+    result = (packet_count != 0) &&
+             (libspdm_mctp_init_reassembler(&m_libspdm_bench_reassembler, transmission_unit,
+                                            m_libspdm_bench_slot, LIBSPDM_BENCH_SLOT_COUNT,
+                                            m_libspdm_bench_slot_buffer,
+                                            LIBSPDM_BENCH_SLOT_COUNT *
+                                            LIBSPDM_BENCH_MAX_MESSAGE_SIZE) ==
+              LIBSPDM_STATUS_SUCCESS);
+    while (result && (iteration < iterations)) {
+        for (op = 0; op < LIBSPDM_BENCH_OP_MAX; op++) {
+            result = libspdm_bench_time((libspdm_bench_op_t)op, transmission_unit,
+                                        packet_count, message_size);
+            if (!result) {
+                failed_op = (libspdm_bench_op_t)op;
+                break;
+            }
+        }
+        if (result) {
+            iteration++;
+        }
+    }
+    if (result &&
+        ((memcmp(m_libspdm_bench_caller_buffer, m_libspdm_bench_message, message_size) != 0) ||
+         (memcmp(m_libspdm_bench_slot_buffer, m_libspdm_bench_message, message_size) != 0))) {
+        failed_op = LIBSPDM_BENCH_OP_MAX;
+        result = false;
+    }
+
+    fprintf(stderr, "transmission_unit %-5zu %s\n", transmission_unit, result ? "ok" : "failed");
+
+    fprintf(fp, "%s    {\n", first ? "" : ",\n");
+    fprintf(fp, "      \"transmission_unit\": %zu,\n", transmission_unit);
+    fprintf(fp, "      \"packets\": %zu,\n", packet_count);
+    if (!result) {
+        fprintf(fp, "      \"status\": \"failed\",\n");
+        fprintf(fp, "      \"failed_operation\": \"%s\",\n",
+                (failed_op < LIBSPDM_BENCH_OP_MAX) ? m_libspdm_bench_op_name[failed_op] :
+                "verify");
+        fprintf(fp, "      \"completed_iterations\": %zu,\n", iteration);
+    } else {
+        fprintf(fp, "      \"status\": \"ok\",\n");
+    }
+    fprintf(fp, "      \"operations\": {");
+    first_op = true;
+    for (op = 0; op < LIBSPDM_BENCH_OP_MAX; op++) {
+        if (m_libspdm_bench_stat[op].sample_count == 0) {
+            continue;
+        }
+        fprintf(fp, "%s\n", first_op ? "" : ",");
+        libspdm_bench_json_write_stat(fp, &m_libspdm_bench_stat[op], "        ");
+        first_op = false;
+    }
+    fprintf(fp, "%s},\n", first_op ? "" : "\n      ");
+    fprintf(fp, "      \"throughput_mbps\": {");
+    first_op = true;
+    for (op = 0; op < LIBSPDM_BENCH_OP_MAX; op++) {
+        if (m_libspdm_bench_stat[op].sample_count == 0) {
+            continue;
+        }
+        libspdm_bench_stat_summarize(&m_libspdm_bench_stat[op], &summary);
+        fprintf(fp, "%s\"%s\": %.1f", first_op ? "" : ", ", m_libspdm_bench_op_name[op],
+                (summary.mean > 0) ? (double)message_size / summary.mean : 0.0);
+        first_op = false;
+    }
+    fprintf(fp, "}");
+    fprintf(fp, "\n    }");
+
+    return result;
+}
+
+int main(int argc, char **argv)
+{
+    const char *output_file;
+    size_t iterations;
+    size_t message_size;
+    size_t filter_transmission_unit;
+    bool passed;
+    size_t btu_index;
+    size_t op;
+    size_t index;
+    FILE *fp;
+    bool first;
+    int arg_index;
+
+    iterations = LIBSPDM_BENCH_DEFAULT_ITERATIONS;
+    output_file = LIBSPDM_BENCH_DEFAULT_OUTPUT_FILE;
+    message_size = LIBSPDM_BENCH_DEFAULT_MESSAGE_SIZE;
+    filter_transmission_unit = 0;
+    passed = true;
+    for (arg_index = 1; arg_index + 1 < argc; arg_index += 2) {
+        if (strcmp(argv[arg_index], "-n") == 0) {
+            iterations = (size_t)strtoul(argv[arg_index + 1], NULL, 0);
+        } else if (strcmp(argv[arg_index], "-o") == 0) {
+            output_file = argv[arg_index + 1];
+        } else if (strcmp(argv[arg_index], "--size") == 0) {
+            message_size = (size_t)strtoul(argv[arg_index + 1], NULL, 0);
+        } else if (strcmp(argv[arg_index], "--btu") == 0) {
+            filter_transmission_unit = (size_t)strtoul(argv[arg_index + 1], NULL, 0);
+        } else {
+            break;
+        }
+    }
+    if ((arg_index < argc) || (iterations == 0) || (message_size == 0) ||
+        (message_size > LIBSPDM_BENCH_MAX_MESSAGE_SIZE) ||
+        ((filter_transmission_unit != 0) &&
+         ((filter_transmission_unit < MCTP_BASELINE_TRANSMISSION_UNIT) ||
+          (filter_transmission_unit > LIBSPDM_BENCH_MAX_TRANSMISSION_UNIT)))) {
+        fprintf(stderr,
+                "usage: %s [-n iterations] [-o report.json] [--size bytes] [--btu bytes]\n"
+                "  --size is from 1 to %d, --btu is from %d to %d\n",
+                argv[0], LIBSPDM_BENCH_MAX_MESSAGE_SIZE, MCTP_BASELINE_TRANSMISSION_UNIT,
+                LIBSPDM_BENCH_MAX_TRANSMISSION_UNIT);
+        return 1;
+    }
+
+    m_libspdm_bench_max_packet_count =
+        libspdm_mctp_get_packet_count(MCTP_BASELINE_TRANSMISSION_UNIT, message_size);
+    m_libspdm_bench_message = malloc(message_size);
+    m_libspdm_bench_packet = malloc(m_libspdm_bench_max_packet_count *
+                                    sizeof(libspdm_mctp_packet_t));
+    m_libspdm_bench_bus_packet = malloc(m_libspdm_bench_max_packet_count *
+                                        sizeof(mctp_header_t) + message_size);
+    m_libspdm_bench_bus_packet_size = malloc(m_libspdm_bench_max_packet_count * sizeof(size_t));
+    m_libspdm_bench_receive_buffer = malloc(message_size);
+    m_libspdm_bench_caller_buffer = malloc(message_size);
+    m_libspdm_bench_slot_buffer = malloc(LIBSPDM_BENCH_SLOT_COUNT *
+                                         LIBSPDM_BENCH_MAX_MESSAGE_SIZE);
+    if ((m_libspdm_bench_message == NULL) || (m_libspdm_bench_packet == NULL) ||
+        (m_libspdm_bench_bus_packet == NULL) || (m_libspdm_bench_bus_packet_size == NULL) ||
+        (m_libspdm_bench_receive_buffer == NULL) || (m_libspdm_bench_caller_buffer == NULL) ||
+        (m_libspdm_bench_slot_buffer == NULL)) {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+    m_libspdm_bench_message[0] = MCTP_MESSAGE_TYPE_SPDM;
+    for (index = 1; index < message_size; index++) {
+        m_libspdm_bench_message[index] = (uint8_t)(index * 31);
+    }
+    for (op = 0; op < LIBSPDM_BENCH_OP_MAX; op++) {
+        if (!libspdm_bench_stat_init(&m_libspdm_bench_stat[op], m_libspdm_bench_op_name[op],
+                                     iterations)) {
+            fprintf(stderr, "out of memory\n");
+            return 1;
+        }
+    }
+
+    fp = stdout;
+    if (strcmp(output_file, "-") != 0) {
+        fp = fopen(output_file, "w");
+        if (fp == NULL) {
+            fprintf(stderr, "Unable to open file %s\n", output_file);
+            return 1;
+        }
+    }
+
+    fprintf(fp, "{\n");
+    fprintf(fp, "  \"benchmark\": \"mctp_packet\",\n");
+    fprintf(fp, "  \"version\": %d,\n", LIBSPDM_BENCH_REPORT_VERSION);
+    fprintf(fp, "  \"iterations\": %zu,\n", iterations);
+    fprintf(fp, "  \"batch_size\": %d,\n", LIBSPDM_BENCH_BATCH_SIZE);
+    fprintf(fp, "  \"message_size\": %zu,\n", message_size);
+    fprintf(fp, "  \"results\": [\n");
+
+    first = true;
+    if (filter_transmission_unit != 0) {
+        passed = libspdm_bench_run_transmission_unit(fp, first, filter_transmission_unit,
+                                                     message_size, iterations);
+        first = false;
+    } else {
+        for (btu_index = 0;
+             btu_index < LIBSPDM_BENCH_ARRAY_SIZE(m_libspdm_bench_transmission_unit);
+             btu_index++) {
+            passed &= libspdm_bench_run_transmission_unit(
+                fp, first, m_libspdm_bench_transmission_unit[btu_index],
+                message_size, iterations);
+            first = false;
+        }
+    }
+
+    fprintf(fp, "%s  ]\n}\n", first ? "" : "\n");
+    if (fp != stdout) {
+        fclose(fp);
+    }
+    fprintf(stderr, "bus bytes %zu check 0x%02x\n", m_libspdm_bench_bus_bytes,
+            m_libspdm_bench_bus_check);
+
+    for (op = 0; op < LIBSPDM_BENCH_OP_MAX; op++) {
+        libspdm_bench_stat_free(&m_libspdm_bench_stat[op]);
+    }
+    free(m_libspdm_bench_message);
+    free(m_libspdm_bench_packet);
+    free(m_libspdm_bench_bus_packet);
+    free(m_libspdm_bench_bus_packet_size);
+    free(m_libspdm_bench_receive_buffer);
+    free(m_libspdm_bench_caller_buffer);
+    free(m_libspdm_bench_slot_buffer);
+    return passed ? 0 : 1;
+}
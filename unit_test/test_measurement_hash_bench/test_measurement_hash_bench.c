@@ -0,0 +1,177 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2021-2022 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+/*
+ * Measure image files of 1 MiB up to 1 GiB (or the size in MiB given as the first argument)
+ * with libspdm_measure_image_file, and report the throughput of:
+ *   flat            - one hash over the image, same digest as libspdm_measurement_hash_all.
+ *   manifest-serial - hash of the chunk hashes, computed on the calling thread.
+ *   manifest-mt     - hash of the chunk hashes, chunks dispatched to a thread pool.
+ *   block-mt        - measurement block 1 set to the image, as libspdm_measurement_collection
+ *                     builds it.
+ */
+
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "spdm_device_secret_lib_internal.h"
+
+#define LIBSPDM_BENCH_MAX_IMAGE_SIZE_MB 1024
+#define LIBSPDM_BENCH_WRITE_BLOCK_SIZE (1024 * 1024)
+
+static double libspdm_bench_now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static bool libspdm_bench_create_image(const char *file_name, int fd, size_t size_mb)
+{
+    uint8_t *block;
+    size_t index;
+    size_t offset;
+    bool result;
+
+    block = malloc(LIBSPDM_BENCH_WRITE_BLOCK_SIZE);
+    if (block == NULL) {
+        return false;
+    }
+
+    result = true;
+    for (index = 0; index < size_mb; index++) {
+        for (offset = 0; offset < LIBSPDM_BENCH_WRITE_BLOCK_SIZE; offset++) {
+            block[offset] = (uint8_t)(offset * 31 + index);
+        }
+        if (write(fd, block, LIBSPDM_BENCH_WRITE_BLOCK_SIZE) !=
+            LIBSPDM_BENCH_WRITE_BLOCK_SIZE) {
+            printf("failed to write %s\n", file_name);
+            result = false;
+            break;
+        }
+    }
+
+    free(block);
+    return result;
+}
+
+static bool libspdm_bench_run(const char *name, const char *file_name, size_t size_mb,
+                              uint32_t measurement_hash_algo, bool is_manifest,
+                              libspdm_dispatch_task_func dispatch_task, void *dispatch_context)
+{
+    uint8_t hash_value[LIBSPDM_MAX_HASH_SIZE];
+    double start;
+    double elapsed;
+
+    start = libspdm_bench_now();
+    if (!libspdm_measure_image_file(file_name, measurement_hash_algo,
+                                    LIBSPDM_MEASUREMENT_IMAGE_CHUNK_SIZE, is_manifest,
+                                    dispatch_task, dispatch_context, hash_value)) {
+        printf("%-16s %6zu MiB  FAILED\n", name, size_mb);
+        return false;
+    }
+    elapsed = libspdm_bench_now() - start;
+
+    printf("%-16s %6zu MiB  %10.3f ms  %10.1f MiB/s\n",
+           name, size_mb, elapsed * 1000, (double)size_mb / elapsed);
+    return true;
+}
+
+static bool libspdm_bench_run_block(const char *file_name, size_t size_mb,
+                                    uint32_t measurement_hash_algo)
+{
+    uint8_t measurements[LIBSPDM_MAX_MEASUREMENT_RECORD_SIZE];
+    size_t measurements_size;
+    uint8_t measurements_count;
+    double start;
+    double elapsed;
+
+    if (!libspdm_measurement_set_image_file(1, file_name, true)) {
+        printf("%-16s %6zu MiB  FAILED\n", "block-mt", size_mb);
+        return false;
+    }
+    measurements_size = sizeof(measurements);
+    start = libspdm_bench_now();
+    if (libspdm_measurement_collection(
+            SPDM_MESSAGE_VERSION_12 << SPDM_VERSION_NUMBER_SHIFT_BIT,
+            SPDM_MEASUREMENT_BLOCK_HEADER_SPECIFICATION_DMTF, measurement_hash_algo, 1, 0, NULL,
+            &measurements_count, measurements, &measurements_size) !=
+        LIBSPDM_STATUS_SUCCESS) {
+        printf("%-16s %6zu MiB  FAILED\n", "block-mt", size_mb);
+        libspdm_measurement_set_image_file(1, NULL, false);
+        return false;
+    }
+    elapsed = libspdm_bench_now() - start;
+    libspdm_measurement_set_image_file(1, NULL, false);
+
+    printf("%-16s %6zu MiB  %10.3f ms  %10.1f MiB/s\n",
+           "block-mt", size_mb, elapsed * 1000, (double)size_mb / elapsed);
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    char file_name[] = "/tmp/libspdm_measurement_XXXXXX";
+    size_t max_size_mb;
+    size_t size_mb;
+    size_t image_size_mb;
+    uint32_t measurement_hash_algo;
+    void *thread_pool;
+    bool result;
+    int fd;
+
+    max_size_mb = LIBSPDM_BENCH_MAX_IMAGE_SIZE_MB;
+    if (argc > 1) {
+        max_size_mb = (size_t)strtoul(argv[1], NULL, 0);
+    }
+    measurement_hash_algo = SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_TPM_ALG_SHA_256;
+
+    fd = mkstemp(file_name);
+    if (fd < 0) {
+        printf("failed to create temporary image\n");
+        return 1;
+    }
+    thread_pool = libspdm_thread_pool_new();
+    if (thread_pool == NULL) {
+        printf("failed to create thread pool\n");
+        close(fd);
+        unlink(file_name);
+        return 1;
+    }
+
+    result = true;
+    image_size_mb = 0;
+    for (size_mb = 1; size_mb <= max_size_mb; size_mb *= 4) {
+        /* Grow the image file to size_mb. */
+        if (!libspdm_bench_create_image(file_name, fd, size_mb - image_size_mb)) {
+            result = false;
+            break;
+        }
+        image_size_mb = size_mb;
+
+        result = libspdm_bench_run("flat", file_name, size_mb, measurement_hash_algo,
+                                   false, NULL, NULL) &&
+                 libspdm_bench_run("manifest-serial", file_name, size_mb,
+                                   measurement_hash_algo, true, NULL, NULL) &&
+                 libspdm_bench_run("manifest-mt", file_name, size_mb, measurement_hash_algo,
+                                   true, libspdm_thread_dispatch_task, thread_pool) &&
+                 libspdm_bench_run_block(file_name, size_mb, measurement_hash_algo);
+        if (!result) {
+            break;
+        }
+    }
+
+    libspdm_thread_pool_free(thread_pool);
+    close(fd);
+    unlink(file_name);
+    return result ? 0 : 1;
+}
@@ -48,43 +48,9 @@
 #define LIBSPDM_MAX_SPDM_MSG_SIZE 0x1200
 #endif
 
-#if LIBSPDM_ENABLE_CAPABILITY_CHUNK_CAP
-#define LIBSPDM_SCRATCH_BUFFER_SECURE_MESSAGE_CAPACITY (LIBSPDM_MAX_SPDM_MSG_SIZE + \
-                                                        LIBSPDM_TRANSPORT_ADDITIONAL_SIZE)
-#else
-#define LIBSPDM_SCRATCH_BUFFER_SECURE_MESSAGE_CAPACITY 0
-#endif
-
-#if LIBSPDM_ENABLE_CAPABILITY_CHUNK_CAP
-#define LIBSPDM_SCRATCH_BUFFER_LARGE_MESSAGE_CAPACITY (LIBSPDM_MAX_SPDM_MSG_SIZE)
-#else
-#define LIBSPDM_SCRATCH_BUFFER_LARGE_MESSAGE_CAPACITY 0
-#endif
-
-#define LIBSPDM_SCRATCH_BUFFER_SENDER_RECEIVER_CAPACITY (LIBSPDM_MAX_SPDM_MSG_SIZE + \
-                                                         LIBSPDM_TRANSPORT_ADDITIONAL_SIZE)
-
-#if LIBSPDM_ENABLE_CAPABILITY_CHUNK_CAP
-#define LIBSPDM_SCRATCH_BUFFER_LARGE_SENDER_RECEIVER_CAPACITY (LIBSPDM_MAX_SPDM_MSG_SIZE + \
-                                                               LIBSPDM_TRANSPORT_ADDITIONAL_SIZE)
-#else
-#define LIBSPDM_SCRATCH_BUFFER_LARGE_SENDER_RECEIVER_CAPACITY 0
-#endif
-
-#define LIBSPDM_SCRATCH_BUFFER_LAST_SPDM_REQUEST_CAPACITY (LIBSPDM_MAX_SPDM_MSG_SIZE)
-
-#if LIBSPDM_RESPOND_IF_READY_SUPPORT
-#define LIBSPDM_SCRATCH_BUFFER_CACHE_SPDM_REQUEST_CAPACITY (LIBSPDM_MAX_SPDM_MSG_SIZE)
-#else
-#define LIBSPDM_SCRATCH_BUFFER_CACHE_SPDM_REQUEST_CAPACITY 0
-#endif
-
-#define LIBSPDM_SCRATCH_BUFFER_SIZE (LIBSPDM_SCRATCH_BUFFER_SECURE_MESSAGE_CAPACITY + \
-                                     LIBSPDM_SCRATCH_BUFFER_LARGE_MESSAGE_CAPACITY + \
-                                     LIBSPDM_SCRATCH_BUFFER_SENDER_RECEIVER_CAPACITY + \
-                                     LIBSPDM_SCRATCH_BUFFER_LARGE_SENDER_RECEIVER_CAPACITY + \
-                                     LIBSPDM_SCRATCH_BUFFER_LAST_SPDM_REQUEST_CAPACITY + \
-                                     LIBSPDM_SCRATCH_BUFFER_CACHE_SPDM_REQUEST_CAPACITY)
+#define LIBSPDM_SCRATCH_BUFFER_SIZE \
+    LIBSPDM_REQUIRED_SCRATCH_BUFFER_SIZE(LIBSPDM_MAX_SPDM_MSG_SIZE, \
+                                         LIBSPDM_TRANSPORT_ADDITIONAL_SIZE)
 
 libspdm_return_t do_authentication_via_spdm(void *spdm_context);
 
@@ -0,0 +1,251 @@
+#!/usr/bin/env python3
+#
+#  Copyright Notice:
+#  Copyright 2021-2022 DMTF. All rights reserved.
+#  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+#
+
+"""
+Worst-case stack depth of the libspdm flows of test_size_of_spdm_requester and
+test_size_of_spdm_responder.
+
+The call graph and the frame size of every function come from the .ci files that GCC writes with
+-fcallgraph-info=su (STACK_USAGE=ON). A flow starts at a libspdm API function. Indirect calls are
+resolved by caller: the request handler tables reach the handlers of the flow, and the callbacks
+registered in the SPDM context reach the device IO and transport functions of the test_size
+images. Integrator notification callbacks are not registered there and are not followed.
+Recursion is reported and the recursive edge is not followed.
+
+usage: stack_usage.py requester|responder BUILD_DIR [--json FILE] [--max BYTES]
+"""
+
+import argparse
+import glob
+import json
+import os
+import re
+import sys
+
+# Libraries linked into each test_size image, see the test_size CMakeLists.txt files.
+LIBRARIES = {
+    'requester': ['test_size_of_spdm_requester', 'spdm_requester_lib', 'spdm_common_lib',
+                  'spdm_crypt_lib', 'spdm_secured_message_lib', 'spdm_transport_mctp_lib',
+                  'spdm_device_secret_lib_null', 'cryptlib_null', 'memlib', 'debuglib_null',
+                  'malloclib_simple', 'platform_lib_null', 'intrinsiclib'],
+    'responder': ['test_size_of_spdm_responder', 'spdm_responder_lib', 'spdm_common_lib',
+                  'spdm_crypt_lib', 'spdm_secured_message_lib', 'spdm_transport_mctp_lib',
+                  'spdm_device_secret_lib_null', 'cryptlib_null', 'memlib', 'debuglib_null',
+                  'malloclib_simple', 'platform_lib_null', 'intrinsiclib'],
+}
+
+# Callbacks registered by the test_size images: device IO, device buffers and MCTP transport.
+CALLBACKS = [r'spdm_(requester|responder)_(send|receive)_message',
+             r'spdm_device_(acquire|release)_(sender|receiver)_buffer',
+             r'libspdm_(transport_)?mctp_.*']
+
+# Handlers of the flow, see FLOWS.
+HANDLERS = None
+
+# Handlers that dispatch a request again. Only libspdm_build_response reaches them, the request
+# they dispatch (cached, chunked or encapsulated) is handled by the other handlers.
+DISPATCHERS = (r'libspdm_get_response_respond_if_ready|libspdm_get_response_chunk_send|'
+               r'libspdm_get_response_encapsulated_.*')
+
+# Targets of the indirect calls of each caller. The first matching caller applies, and the
+# indirect calls of other callers reach CALLBACKS.
+INDIRECT_CALLS = [
+    (r'libspdm_build_response|libspdm_get_response_respond_if_ready|'
+     r'libspdm_get_response_chunk_send|libspdm_encapsulated_request',
+     CALLBACKS + [HANDLERS]),
+    (r'libspdm_get_response_encapsulated_.*|libspdm_process_encapsulated_response',
+     CALLBACKS + [r'libspdm_get_encap_request_.*', r'libspdm_process_encap_response_.*']),
+    (r'libspdm_(encode|decode)_secured_message', [r'libspdm_mctp_get_.*']),
+    (r'libspdm_(req_)?asym_get_public_key_from_x509',
+     [r'libspdm_(rsa|ec|ecd|sm2)_get_public_key_from_x509']),
+    (r'libspdm_set_connection_state|libspdm_set_session_state|'
+     r'libspdm_trigger_key_update_callback', []),
+]
+
+# Flow name, entry function, and the handlers that indirect calls may reach in the flow.
+FLOWS = {
+    'requester': [
+        ('init_connection', 'libspdm_init_connection', []),
+        ('get_digest', 'libspdm_get_digest', []),
+        ('get_certificate', 'libspdm_get_certificate', []),
+        ('challenge', 'libspdm_challenge', []),
+        ('get_measurement', 'libspdm_get_measurement', []),
+        ('start_session', 'libspdm_start_session', [r'libspdm_get_encap_response_.*']),
+        ('send_receive_data', 'libspdm_send_receive_data', []),
+        ('heartbeat', 'libspdm_heartbeat', []),
+        ('key_update', 'libspdm_key_update', []),
+        ('stop_session', 'libspdm_stop_session', []),
+    ],
+    'responder': [
+        ('dispatch', 'libspdm_responder_dispatch_message', [r'libspdm_get_response_.*']),
+        ('get_version', 'libspdm_responder_dispatch_message', [r'libspdm_get_response_version']),
+        ('get_capabilities', 'libspdm_responder_dispatch_message',
+         [r'libspdm_get_response_capabilities']),
+        ('negotiate_algorithms', 'libspdm_responder_dispatch_message',
+         [r'libspdm_get_response_algorithms']),
+        ('get_digest', 'libspdm_responder_dispatch_message', [r'libspdm_get_response_digests']),
+        ('get_certificate', 'libspdm_responder_dispatch_message',
+         [r'libspdm_get_response_certificate']),
+        ('challenge', 'libspdm_responder_dispatch_message',
+         [r'libspdm_get_response_challenge_auth']),
+        ('get_measurement', 'libspdm_responder_dispatch_message',
+         [r'libspdm_get_response_measurements']),
+        ('key_exchange', 'libspdm_responder_dispatch_message',
+         [r'libspdm_get_response_key_exchange']),
+        ('finish', 'libspdm_responder_dispatch_message', [r'libspdm_get_response_finish']),
+        ('psk_exchange', 'libspdm_responder_dispatch_message',
+         [r'libspdm_get_response_psk_exchange']),
+        ('psk_finish', 'libspdm_responder_dispatch_message',
+         [r'libspdm_get_response_psk_finish']),
+    ],
+}
+
+NODE_PATTERN = re.compile(r'node: \{ title: "([^"]*)" label: "([^"]*)"')
+EDGE_PATTERN = re.compile(r'edge: \{ sourcename: "([^"]*)" targetname: "([^"]*)"')
+SIZE_PATTERN = re.compile(r'\\n(\d+) bytes \(([a-z,]*)\)')
+INDIRECT_CALL = '__indirect_call'
+
+
+class CallGraph:
+    def __init__(self):
+        self.frame_size = {}
+        self.dynamic = set()
+        self.callees = {}
+
+    def load(self, file_name):
+        with open(file_name, 'r', errors='replace') as ci_file:
+            for line in ci_file:
+                match = NODE_PATTERN.search(line)
+                if match:
+                    size = SIZE_PATTERN.search(match.group(2))
+                    if size:
+                        title = match.group(1)
+                        # A function linked twice keeps its largest frame.
+                        self.frame_size[title] = max(self.frame_size.get(title, 0),
+                                                     int(size.group(1)))
+                        if size.group(2) == 'dynamic':
+                            self.dynamic.add(title)
+                    continue
+                match = EDGE_PATTERN.search(line)
+                if match:
+                    self.callees.setdefault(match.group(1), set()).add(match.group(2))
+
+    def function_name(self, title):
+        # Static functions are titled "file:function".
+        return title.rsplit(':', 1)[-1]
+
+    def match(self, patterns):
+        if not patterns:
+            return []
+        regex = re.compile('|'.join('(?:%s)$' % pattern for pattern in patterns))
+        return sorted(title for title in self.frame_size
+                      if regex.match(self.function_name(title)))
+
+    def indirect_targets(self, title, handlers):
+        name = self.function_name(title)
+        for caller, patterns in INDIRECT_CALLS:
+            if re.match('(?:%s)$' % caller, name):
+                break
+        else:
+            patterns = CALLBACKS
+        expanded = []
+        for pattern in patterns:
+            if pattern is HANDLERS:
+                expanded.extend(handlers)
+            else:
+                expanded.append(pattern)
+        targets = self.match(expanded)
+        if name != 'libspdm_build_response':
+            targets = [target for target in targets
+                       if not re.match('(?:%s)$' % DISPATCHERS, self.function_name(target))]
+        return targets
+
+    def worst_path(self, entry, handlers, recursion):
+        """Return (stack bytes, call path) of the deepest path from entry."""
+        memo = {}
+        active = set()
+
+        def visit(title):
+            if title in memo:
+                return memo[title]
+            active.add(title)
+            best = (0, [])
+            callees = set(self.callees.get(title, ()))
+            if INDIRECT_CALL in callees:
+                callees.discard(INDIRECT_CALL)
+                callees.update(self.indirect_targets(title, handlers))
+            for callee in sorted(callees):
+                if callee not in self.frame_size:
+                    # Compiler builtins and functions outside the image.
+                    continue
+                if callee in active:
+                    recursion.add((self.function_name(title), self.function_name(callee)))
+                    continue
+                result = visit(callee)
+                if result[0] > best[0]:
+                    best = result
+            active.discard(title)
+            memo[title] = (self.frame_size[title] + best[0], [title] + best[1])
+            return memo[title]
+
+        return visit(entry)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='libspdm worst-case stack depth per flow')
+    parser.add_argument('side', choices=sorted(FLOWS))
+    parser.add_argument('build_dir')
+    parser.add_argument('--json', help='write the results to a JSON file')
+    parser.add_argument('--max', type=int, help='fail if a flow needs more stack bytes')
+    args = parser.parse_args()
+
+    graph = CallGraph()
+    file_count = 0
+    for library in LIBRARIES[args.side]:
+        for file_name in glob.glob(os.path.join(args.build_dir, '**', 'CMakeFiles',
+                                                library + '.dir', '**', '*.ci'),
+                                   recursive=True):
+            graph.load(file_name)
+            file_count += 1
+    if file_count == 0:
+        print('no .ci file found, build with -DSTACK_USAGE=ON and GCC 10 or later',
+              file=sys.stderr)
+        return 1
+
+    results = []
+    recursion = set()
+    for name, entry, handlers in FLOWS[args.side]:
+        if entry not in graph.frame_size:
+            continue
+        stack_size, path = graph.worst_path(entry, handlers, recursion)
+        results.append({'flow': name, 'entry': entry, 'stack_bytes': stack_size,
+                        'dynamic': any(title in graph.dynamic for title in path),
+                        'path': [graph.function_name(title) for title in path]})
+
+    print('test_size_of_spdm_%s worst-case stack depth:' % args.side)
+    for result in results:
+        print('  %-22s %8d%s' % (result['flow'], result['stack_bytes'],
+                                 ' (dynamic)' if result['dynamic'] else ''))
+        print('    ' + ' -> '.join(result['path']))
+    for caller, callee in sorted(recursion):
+        print('  recursion not followed: %s -> %s' % (caller, callee))
+
+    if args.json:
+        with open(args.json, 'w') as json_file:
+            json.dump({'side': args.side, 'flows': results}, json_file, indent=2)
+
+    if args.max is not None:
+        over = [result['flow'] for result in results if result['stack_bytes'] > args.max]
+        if over:
+            print('stack depth above %d bytes: %s' % (args.max, ', '.join(over)),
+                  file=sys.stderr)
+            return 1
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,619 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2021-2022 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+/*
+ * Large message chunking benchmark.
+ *
+ * A requester and a responder run in the same process, as in test_spdm_handshake_bench. They use
+ * the MCTP transport, which does not pad the chunks beyond the DataTransferSize. After
+ * GET_VERSION, GET_CAPABILITIES and NEGOTIATE_ALGORITHMS, with CHUNK_CAP on both sides and the
+ * DataTransferSize of both endpoints set to the benchmarked value, each iteration times:
+ *   large_request:  a VENDOR_DEFINED_REQUEST of the message size, sent with CHUNK_SEND,
+ *                   and its small response.
+ *   large_response: a small VENDOR_DEFINED_REQUEST, and its VENDOR_DEFINED_RESPONSE of the
+ *                   message size, received with CHUNK_GET.
+ * The DataTransferSize is 42 (the minimum of SPDM 1.2), 64 and 256 unless --dts is given.
+ * The DataTransferSize is set through the size of the receiver buffers.
+ * The results are written as JSON with min/mean/p50/p90/p99/max latency in microseconds, and the
+ * number of transport messages sent by the requester for one operation.
+ *
+ * The report goes to spdm_chunk_bench.json unless -o is given; "-o -" selects stdout.
+ *
+ * usage: test_spdm_chunk_bench [-n iterations] [-o report.json] [--size bytes] [--dts bytes]
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "spdm_bench.h"
+#include "hal/base.h"
+#include "internal/libspdm_requester_lib.h"
+#include "library/spdm_responder_lib.h"
+#include "library/spdm_transport_mctp_lib.h"
+
+#ifndef LIBSPDM_BENCH_CRYPTO_NAME
+#define LIBSPDM_BENCH_CRYPTO_NAME "unknown"
+#endif
+
+#define LIBSPDM_BENCH_DEFAULT_ITERATIONS 200
+#define LIBSPDM_BENCH_DEFAULT_OUTPUT_FILE "spdm_chunk_bench.json"
+
+/* Size of the vendor defined payload of the large messages. */
+#define LIBSPDM_BENCH_DEFAULT_MESSAGE_SIZE 0x1000
+#define LIBSPDM_BENCH_MAX_MESSAGE_SIZE 0x1000
+
+#define LIBSPDM_BENCH_SENDER_BUFFER_SIZE (0x1100 + LIBSPDM_MCTP_TRANSPORT_ADDITIONAL_SIZE)
+#define LIBSPDM_BENCH_RECEIVER_BUFFER_SIZE (0x1200 + LIBSPDM_MCTP_TRANSPORT_ADDITIONAL_SIZE)
+#define LIBSPDM_BENCH_MAX_SPDM_MSG_SIZE 0x1200
+
+/* A VENDOR_DEFINED_REQUEST or VENDOR_DEFINED_RESPONSE with no vendor ID, followed by the
+ * payload length. */
+#define LIBSPDM_BENCH_VENDOR_HEADER_SIZE \
+    (sizeof(spdm_vendor_defined_request_msg_t) + sizeof(uint16_t))
+
+static const uint32_t m_libspdm_bench_data_transfer_size[] = { 42, 64, 256 };
+
+/* NEGOTIATE_ALGORITHMS is not chunked, and with its four algorithm structure tables it does not fit
+ * in a DataTransferSize of 42. The responder is given at least this size for the connection, and
+ * its DataTransferSize is lowered to the benchmarked value afterwards. */
+#define LIBSPDM_BENCH_NEGOTIATE_ALGORITHMS_SIZE 48
+
+#define LIBSPDM_BENCH_ARRAY_SIZE(array) (sizeof(array) / sizeof((array)[0]))
+
+typedef enum {
+    LIBSPDM_BENCH_OP_LARGE_REQUEST,
+    LIBSPDM_BENCH_OP_LARGE_RESPONSE,
+    LIBSPDM_BENCH_OP_MAX
+} libspdm_bench_op_t;
+
+static const char *m_libspdm_bench_op_name[LIBSPDM_BENCH_OP_MAX] = {
+    "large_request",
+    "large_response",
+};
+
+typedef struct {
+    void *spdm_context;
+    void *scratch_buffer;
+    size_t scratch_buffer_size;
+    uint8_t sender_buffer[LIBSPDM_BENCH_SENDER_BUFFER_SIZE];
+    uint8_t receiver_buffer[LIBSPDM_BENCH_RECEIVER_BUFFER_SIZE];
+} libspdm_bench_endpoint_t;
+
+static libspdm_bench_endpoint_t m_libspdm_bench_requester;
+static libspdm_bench_endpoint_t m_libspdm_bench_responder;
+
+/* The in-process link: holds the last transport message sent by either side. */
+static uint8_t m_libspdm_bench_link_buffer[LIBSPDM_BENCH_RECEIVER_BUFFER_SIZE];
+static size_t m_libspdm_bench_link_size;
+
+/* Transport messages sent by the requester. */
+static size_t m_libspdm_bench_message_count;
+
+static libspdm_bench_stat_t m_libspdm_bench_stat[LIBSPDM_BENCH_OP_MAX];
+static size_t m_libspdm_bench_op_message_count[LIBSPDM_BENCH_OP_MAX];
+
+static libspdm_bench_endpoint_t *libspdm_bench_get_endpoint(void *spdm_context)
+{
+    if (spdm_context == m_libspdm_bench_requester.spdm_context) {
+        return &m_libspdm_bench_requester;
+    }
+    return &m_libspdm_bench_responder;
+}
+
+static libspdm_return_t libspdm_bench_acquire_sender_buffer(void *spdm_context,
+                                                            void **msg_buf_ptr)
+{
+    *msg_buf_ptr = libspdm_bench_get_endpoint(spdm_context)->sender_buffer;
+    return LIBSPDM_STATUS_SUCCESS;
+}
+
+static void libspdm_bench_release_sender_buffer(void *spdm_context, const void *msg_buf_ptr)
+{
+}
+
+static libspdm_return_t libspdm_bench_acquire_receiver_buffer(void *spdm_context,
+                                                              void **msg_buf_ptr)
+{
+    *msg_buf_ptr = libspdm_bench_get_endpoint(spdm_context)->receiver_buffer;
+    return LIBSPDM_STATUS_SUCCESS;
+}
+
+static void libspdm_bench_release_receiver_buffer(void *spdm_context, const void *msg_buf_ptr)
+{
+}
+
+static libspdm_return_t libspdm_bench_link_send(size_t message_size, const void *message)
+{
+    if (message_size > sizeof(m_libspdm_bench_link_buffer)) {
+        return LIBSPDM_STATUS_SEND_FAIL;
+    }
+    memcpy(m_libspdm_bench_link_buffer, message, message_size);
+    m_libspdm_bench_link_size = message_size;
+    return LIBSPDM_STATUS_SUCCESS;
+}
+
+static libspdm_return_t libspdm_bench_link_receive(size_t *message_size, void **message)
+{
+    if ((m_libspdm_bench_link_size == 0) || (m_libspdm_bench_link_size > *message_size)) {
+        return LIBSPDM_STATUS_RECEIVE_FAIL;
+    }
+    memcpy(*message, m_libspdm_bench_link_buffer, m_libspdm_bench_link_size);
+    *message_size = m_libspdm_bench_link_size;
+    m_libspdm_bench_link_size = 0;
+    return LIBSPDM_STATUS_SUCCESS;
+}
+
+/* Requester side: sending a request runs the responder synchronously. */
+static libspdm_return_t libspdm_bench_requester_send_message(void *spdm_context,
+                                                             size_t message_size,
+                                                             const void *message,
+                                                             uint64_t timeout)
+{
+    libspdm_return_t status;
+
+    status = libspdm_bench_link_send(message_size, message);
+    if (LIBSPDM_STATUS_IS_ERROR(status)) {
+        return status;
+    }
+    m_libspdm_bench_message_count++;
+    return libspdm_responder_dispatch_message(m_libspdm_bench_responder.spdm_context);
+}
+
+static libspdm_return_t libspdm_bench_requester_receive_message(void *spdm_context,
+                                                                size_t *message_size,
+                                                                void **message,
+                                                                uint64_t timeout)
+{
+    return libspdm_bench_link_receive(message_size, message);
+}
+
+static libspdm_return_t libspdm_bench_responder_send_message(void *spdm_context,
+                                                             size_t message_size,
+                                                             const void *message,
+                                                             uint64_t timeout)
+{
+    return libspdm_bench_link_send(message_size, message);
+}
+
+static libspdm_return_t libspdm_bench_responder_receive_message(void *spdm_context,
+                                                                size_t *message_size,
+                                                                void **message,
+                                                                uint64_t timeout)
+{
+    return libspdm_bench_link_receive(message_size, message);
+}
+
+/* Responder VENDOR_DEFINED_REQUEST handler. A request payload of four bytes holds the payload
+ * size of the response, any other request gets an empty response. */
+static libspdm_return_t libspdm_bench_get_response(
+    void *spdm_context, const uint32_t *session_id, bool is_app_message,
+    size_t request_size, const void *request, size_t *response_size,
+    void *response)
+{
+    const spdm_vendor_defined_request_msg_t *spdm_request;
+    spdm_vendor_defined_response_msg_t *spdm_response;
+    uint16_t request_payload_size;
+    uint32_t response_payload_size;
+    uint8_t *response_payload;
+
+    spdm_request = request;
+    if (is_app_message || (request_size < LIBSPDM_BENCH_VENDOR_HEADER_SIZE) ||
+        (spdm_request->header.request_response_code != SPDM_VENDOR_DEFINED_REQUEST)) {
+        return LIBSPDM_STATUS_UNSUPPORTED_CAP;
+    }
+    memcpy(&request_payload_size, spdm_request + 1, sizeof(request_payload_size));
+    response_payload_size = 0;
+    if ((request_payload_size == sizeof(uint32_t)) &&
+        (request_size >= LIBSPDM_BENCH_VENDOR_HEADER_SIZE + sizeof(uint32_t))) {
+        memcpy(&response_payload_size, (const uint8_t *)request + LIBSPDM_BENCH_VENDOR_HEADER_SIZE,
+               sizeof(response_payload_size));
+    }
+    if ((response_payload_size > LIBSPDM_BENCH_MAX_MESSAGE_SIZE) ||
+        (*response_size < LIBSPDM_BENCH_VENDOR_HEADER_SIZE + response_payload_size)) {
+        return LIBSPDM_STATUS_UNSUPPORTED_CAP;
+    }
+
+    spdm_response = response;
+    spdm_response->header.spdm_version = spdm_request->header.spdm_version;
+    spdm_response->header.request_response_code = SPDM_VENDOR_DEFINED_RESPONSE;
+    spdm_response->header.param1 = 0;
+    spdm_response->header.param2 = 0;
+    spdm_response->standard_id = SPDM_REGISTRY_ID_DMTF;
+    spdm_response->len = 0;
+    memcpy(spdm_response + 1, &response_payload_size, sizeof(uint16_t));
+    response_payload = (uint8_t *)response + LIBSPDM_BENCH_VENDOR_HEADER_SIZE;
+    memset(response_payload, 0xA5, response_payload_size);
+    *response_size = LIBSPDM_BENCH_VENDOR_HEADER_SIZE + response_payload_size;
+    return LIBSPDM_STATUS_SUCCESS;
+}
+
+/* The DataTransferSize of an endpoint is the size of its receiver buffer without the transport
+ * header. The sender buffers hold a whole large request, which is then sent in chunks. */
+static void libspdm_bench_register_transport(void *spdm_context, uint32_t data_transfer_size)
+{
+    libspdm_register_transport_layer_func(spdm_context,
+                                          LIBSPDM_BENCH_MAX_SPDM_MSG_SIZE,
+                                          LIBSPDM_MCTP_TRANSPORT_ADDITIONAL_SIZE,
+                                          libspdm_transport_mctp_encode_message,
+                                          libspdm_transport_mctp_decode_message,
+                                          libspdm_transport_mctp_get_header_size);
+    libspdm_register_device_buffer_func(spdm_context,
+                                        LIBSPDM_BENCH_SENDER_BUFFER_SIZE,
+                                        data_transfer_size +
+                                        LIBSPDM_MCTP_TRANSPORT_ADDITIONAL_SIZE,
+                                        libspdm_bench_acquire_sender_buffer,
+                                        libspdm_bench_release_sender_buffer,
+                                        libspdm_bench_acquire_receiver_buffer,
+                                        libspdm_bench_release_receiver_buffer);
+}
+
+static libspdm_return_t libspdm_bench_init_endpoint(libspdm_bench_endpoint_t *endpoint,
+                                                    bool is_requester,
+                                                    uint32_t data_transfer_size)
+{
+    libspdm_data_parameter_t parameter;
+    libspdm_return_t status;
+    uint8_t data8;
+    uint32_t data32;
+
+    status = libspdm_init_context(endpoint->spdm_context);
+    if (LIBSPDM_STATUS_IS_ERROR(status)) {
+        return status;
+    }
+
+    if (is_requester) {
+        libspdm_register_device_io_func(endpoint->spdm_context,
+                                        libspdm_bench_requester_send_message,
+                                        libspdm_bench_requester_receive_message);
+    } else {
+        libspdm_register_device_io_func(endpoint->spdm_context,
+                                        libspdm_bench_responder_send_message,
+                                        libspdm_bench_responder_receive_message);
+        libspdm_register_get_response_func(endpoint->spdm_context,
+                                           libspdm_bench_get_response);
+    }
+    libspdm_bench_register_transport(endpoint->spdm_context, data_transfer_size);
+    libspdm_set_scratch_buffer(endpoint->spdm_context, endpoint->scratch_buffer,
+                               endpoint->scratch_buffer_size);
+
+    libspdm_zero_mem(&parameter, sizeof(parameter));
+    parameter.location = LIBSPDM_DATA_LOCATION_LOCAL;
+
+    data32 = is_requester ? SPDM_GET_CAPABILITIES_REQUEST_FLAGS_CHUNK_CAP :
+             SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CHUNK_CAP;
+    status = libspdm_set_data(endpoint->spdm_context, LIBSPDM_DATA_CAPABILITY_FLAGS, &parameter,
+                              &data32, sizeof(data32));
+    if (LIBSPDM_STATUS_IS_ERROR(status)) {
+        return status;
+    }
+    data8 = 0;
+    libspdm_set_data(endpoint->spdm_context, LIBSPDM_DATA_CAPABILITY_CT_EXPONENT, &parameter,
+                     &data8, sizeof(data8));
+    data32 = SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_ECDSA_ECC_NIST_P256;
+    libspdm_set_data(endpoint->spdm_context, LIBSPDM_DATA_BASE_ASYM_ALGO, &parameter,
+                     &data32, sizeof(data32));
+    data32 = SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_256;
+    libspdm_set_data(endpoint->spdm_context, LIBSPDM_DATA_BASE_HASH_ALGO, &parameter,
+                     &data32, sizeof(data32));
+    return LIBSPDM_STATUS_SUCCESS;
+}
+
+static void libspdm_bench_teardown(void)
+{
+    libspdm_deinit_context(m_libspdm_bench_requester.spdm_context);
+    libspdm_deinit_context(m_libspdm_bench_responder.spdm_context);
+    m_libspdm_bench_link_size = 0;
+}
+
+/**
+ * Send a VENDOR_DEFINED_REQUEST with a payload of request_payload_size bytes, and receive its
+ * response, which must have a payload of response_payload_size bytes.
+ *
+ * The request is built in the sender buffer, as the requester flows of libspdm build theirs.
+ * A request payload holding response_payload_size asks the responder for a large response.
+ **/
+static libspdm_return_t libspdm_bench_vendor_request(libspdm_context_t *spdm_context,
+                                                     size_t request_payload_size,
+                                                     uint32_t response_payload_size)
+{
+    libspdm_return_t status;
+    spdm_vendor_defined_request_msg_t *spdm_request;
+    size_t spdm_request_size;
+    spdm_vendor_defined_response_msg_t *spdm_response;
+    size_t spdm_response_size;
+    size_t transport_header_size;
+    uint8_t *message;
+    size_t message_size;
+    uint16_t payload_size;
+
+    transport_header_size = spdm_context->transport_get_header_size(spdm_context);
+    status = libspdm_acquire_sender_buffer(spdm_context, &message_size, (void **)&message);
+    if (LIBSPDM_STATUS_IS_ERROR(status)) {
+        return status;
+    }
+    spdm_request = (void *)(message + transport_header_size);
+    spdm_request_size = LIBSPDM_BENCH_VENDOR_HEADER_SIZE + request_payload_size;
+    if (spdm_request_size > message_size - transport_header_size) {
+        libspdm_release_sender_buffer(spdm_context);
+        return LIBSPDM_STATUS_BUFFER_TOO_SMALL;
+    }
+
+    spdm_request->header.spdm_version = libspdm_get_connection_version(spdm_context);
+    spdm_request->header.request_response_code = SPDM_VENDOR_DEFINED_REQUEST;
+    spdm_request->header.param1 = 0;
+    spdm_request->header.param2 = 0;
+    spdm_request->standard_id = SPDM_REGISTRY_ID_DMTF;
+    spdm_request->len = 0;
+    payload_size = (uint16_t)request_payload_size;
+    memcpy(spdm_request + 1, &payload_size, sizeof(payload_size));
+    if (response_payload_size != 0) {
+        memcpy((uint8_t *)spdm_request + LIBSPDM_BENCH_VENDOR_HEADER_SIZE,
+               &response_payload_size, sizeof(response_payload_size));
+    } else {
+        memset((uint8_t *)spdm_request + LIBSPDM_BENCH_VENDOR_HEADER_SIZE, 0x5A,
+               request_payload_size);
+    }
+
+    status = libspdm_send_spdm_request(spdm_context, NULL, spdm_request_size, spdm_request);
+    libspdm_release_sender_buffer(spdm_context);
+    if (LIBSPDM_STATUS_IS_ERROR(status)) {
+        return status;
+    }
+
+    status = libspdm_acquire_receiver_buffer(spdm_context, &message_size, (void **)&message);
+    if (LIBSPDM_STATUS_IS_ERROR(status)) {
+        return status;
+    }
+    spdm_response = (void *)message;
+    spdm_response_size = message_size;
+    status = libspdm_receive_spdm_response(spdm_context, NULL, &spdm_response_size,
+                                           (void **)&spdm_response);
+    if (LIBSPDM_STATUS_IS_SUCCESS(status)) {
+        if ((spdm_response_size != LIBSPDM_BENCH_VENDOR_HEADER_SIZE + response_payload_size) ||
+            (spdm_response->header.request_response_code != SPDM_VENDOR_DEFINED_RESPONSE)) {
+            status = LIBSPDM_STATUS_INVALID_MSG_FIELD;
+        }
+    }
+    libspdm_release_receiver_buffer(spdm_context);
+    return status;
+}
+
+static libspdm_return_t libspdm_bench_time(libspdm_bench_op_t op, size_t message_size)
+{
+    libspdm_return_t status;
+    double start_us;
+    size_t message_count;
+
+    message_count = m_libspdm_bench_message_count;
+    start_us = libspdm_bench_now_us();
+    if (op == LIBSPDM_BENCH_OP_LARGE_REQUEST) {
+        status = libspdm_bench_vendor_request(m_libspdm_bench_requester.spdm_context,
+                                              message_size, 0);
+    } else {
+        status = libspdm_bench_vendor_request(m_libspdm_bench_requester.spdm_context,
+                                              sizeof(uint32_t), (uint32_t)message_size);
+    }
+    if (LIBSPDM_STATUS_IS_ERROR(status)) {
+        return status;
+    }
+    libspdm_bench_stat_add(&m_libspdm_bench_stat[op], libspdm_bench_now_us() - start_us);
+    m_libspdm_bench_op_message_count[op] = m_libspdm_bench_message_count - message_count;
+    return LIBSPDM_STATUS_SUCCESS;
+}
+
+static bool libspdm_bench_run_data_transfer_size(FILE *fp, bool first,
+                                                 uint32_t data_transfer_size,
+                                                 size_t message_size, size_t iterations)
+{
+    libspdm_return_t status;
+    libspdm_bench_op_t failed_op;
+    libspdm_context_t *requester_context;
+    libspdm_context_t *responder_context;
+    size_t iteration;
+    size_t op;
+    bool first_op;
+
+    for (op = 0; op < LIBSPDM_BENCH_OP_MAX; op++) {
+        libspdm_bench_stat_reset(&m_libspdm_bench_stat[op]);
+        m_libspdm_bench_op_message_count[op] = 0;
+    }
+
+    failed_op = LIBSPDM_BENCH_OP_MAX;
+    iteration = 0;
+    status = libspdm_bench_init_endpoint(
+        &m_libspdm_bench_responder, false,
+        (data_transfer_size < LIBSPDM_BENCH_NEGOTIATE_ALGORITHMS_SIZE) ?
+        LIBSPDM_BENCH_NEGOTIATE_ALGORITHMS_SIZE : data_transfer_size);
+    if (LIBSPDM_STATUS_IS_SUCCESS(status)) {
+        status = libspdm_bench_init_endpoint(&m_libspdm_bench_requester, true,
+                                             data_transfer_size);
+    }
+    if (LIBSPDM_STATUS_IS_SUCCESS(status)) {
+        status = libspdm_init_connection(m_libspdm_bench_requester.spdm_context, false);
+    }
+    if (LIBSPDM_STATUS_IS_SUCCESS(status) &&
+        (libspdm_get_connection_version(m_libspdm_bench_requester.spdm_context) <
+         SPDM_MESSAGE_VERSION_12)) {
+        status = LIBSPDM_STATUS_UNSUPPORTED_CAP;
+    }
+    if (LIBSPDM_STATUS_IS_SUCCESS(status)) {
+        responder_context = m_libspdm_bench_responder.spdm_context;
+        requester_context = m_libspdm_bench_requester.spdm_context;
+        responder_context->local_context.capability.data_transfer_size = data_transfer_size;
+        requester_context->connection_info.capability.data_transfer_size = data_transfer_size;
+    }
+    while (LIBSPDM_STATUS_IS_SUCCESS(status) && (iteration < iterations)) {
+        for (op = 0; op < LIBSPDM_BENCH_OP_MAX; op++) {
+            status = libspdm_bench_time((libspdm_bench_op_t)op, message_size);
+            if (LIBSPDM_STATUS_IS_ERROR(status)) {
+                failed_op = (libspdm_bench_op_t)op;
+                break;
+            }
+        }
+        if (LIBSPDM_STATUS_IS_SUCCESS(status)) {
+            iteration++;
+        }
+    }
+    libspdm_bench_teardown();
+
+    fprintf(stderr, "data_transfer_size %-5u %s\n", data_transfer_size,
+            LIBSPDM_STATUS_IS_ERROR(status) ? "failed" : "ok");
+
+    fprintf(fp, "%s    {\n", first ? "" : ",\n");
+    fprintf(fp, "      \"data_transfer_size\": %u,\n", data_transfer_size);
+    if (LIBSPDM_STATUS_IS_ERROR(status)) {
+        fprintf(fp, "      \"status\": \"failed\",\n");
+        fprintf(fp, "      \"error\": \"0x%08x\",\n", (uint32_t)status);
+        fprintf(fp, "      \"failed_operation\": \"%s\",\n",
+                (failed_op < LIBSPDM_BENCH_OP_MAX) ? m_libspdm_bench_op_name[failed_op] : "setup");
+        fprintf(fp, "      \"completed_iterations\": %zu,\n", iteration);
+    } else {
+        fprintf(fp, "      \"status\": \"ok\",\n");
+    }
+    fprintf(fp, "      \"messages\": {");
+    for (op = 0; op < LIBSPDM_BENCH_OP_MAX; op++) {
+        fprintf(fp, "%s\"%s\": %zu", (op == 0) ? "" : ", ", m_libspdm_bench_op_name[op],
+                m_libspdm_bench_op_message_count[op]);
+    }
+    fprintf(fp, "},\n");
+    fprintf(fp, "      \"operations\": {");
+    first_op = true;
+    for (op = 0; op < LIBSPDM_BENCH_OP_MAX; op++) {
+        if (m_libspdm_bench_stat[op].sample_count == 0) {
+            continue;
+        }
+        fprintf(fp, "%s\n", first_op ? "" : ",");
+        libspdm_bench_json_write_stat(fp, &m_libspdm_bench_stat[op], "        ");
+        first_op = false;
+    }
+    fprintf(fp, "%s}", first_op ? "" : "\n      ");
+    fprintf(fp, "\n    }");
+
+    return LIBSPDM_STATUS_IS_SUCCESS(status);
+}
+
+static libspdm_return_t libspdm_bench_alloc_endpoint(libspdm_bench_endpoint_t *endpoint)
+{
+    endpoint->spdm_context = malloc(libspdm_get_context_size());
+    if (endpoint->spdm_context == NULL) {
+        return LIBSPDM_STATUS_BUFFER_FULL;
+    }
+    libspdm_init_context(endpoint->spdm_context);
+    libspdm_bench_register_transport(endpoint->spdm_context,
+                                     LIBSPDM_BENCH_RECEIVER_BUFFER_SIZE -
+                                     LIBSPDM_MCTP_TRANSPORT_ADDITIONAL_SIZE);
+    endpoint->scratch_buffer_size =
+        libspdm_get_sizeof_required_scratch_buffer(endpoint->spdm_context);
+    endpoint->scratch_buffer = malloc(endpoint->scratch_buffer_size);
+    libspdm_deinit_context(endpoint->spdm_context);
+    if (endpoint->scratch_buffer == NULL) {
+        return LIBSPDM_STATUS_BUFFER_FULL;
+    }
+    return LIBSPDM_STATUS_SUCCESS;
+}
+
+int main(int argc, char **argv)
+{
+    const char *output_file;
+    size_t iterations;
+    size_t message_size;
+    uint32_t filter_data_transfer_size;
+    bool passed;
+    size_t dts_index;
+    size_t op;
+    FILE *fp;
+    bool first;
+    int index;
+
+    iterations = LIBSPDM_BENCH_DEFAULT_ITERATIONS;
+    output_file = LIBSPDM_BENCH_DEFAULT_OUTPUT_FILE;
+    message_size = LIBSPDM_BENCH_DEFAULT_MESSAGE_SIZE;
+    filter_data_transfer_size = 0;
+    passed = true;
+    for (index = 1; index + 1 < argc; index += 2) {
+        if (strcmp(argv[index], "-n") == 0) {
+            iterations = (size_t)strtoul(argv[index + 1], NULL, 0);
+        } else if (strcmp(argv[index], "-o") == 0) {
+            output_file = argv[index + 1];
+        } else if (strcmp(argv[index], "--size") == 0) {
+            message_size = (size_t)strtoul(argv[index + 1], NULL, 0);
+        } else if (strcmp(argv[index], "--dts") == 0) {
+            filter_data_transfer_size = (uint32_t)strtoul(argv[index + 1], NULL, 0);
+        } else {
+            break;
+        }
+    }
+    if ((index < argc) || (iterations == 0) || (message_size < sizeof(uint32_t)) ||
+        (message_size > LIBSPDM_BENCH_MAX_MESSAGE_SIZE) ||
+        ((filter_data_transfer_size != 0) &&
+         (filter_data_transfer_size < SPDM_MIN_DATA_TRANSFER_SIZE_VERSION_12))) {
+        fprintf(stderr,
+                "usage: %s [-n iterations] [-o report.json] [--size bytes] [--dts bytes]\n"
+                "  --size is from 4 to %d, --dts is at least %d\n",
+                argv[0], LIBSPDM_BENCH_MAX_MESSAGE_SIZE, SPDM_MIN_DATA_TRANSFER_SIZE_VERSION_12);
+        return 1;
+    }
+
+    if ((libspdm_bench_alloc_endpoint(&m_libspdm_bench_requester) != LIBSPDM_STATUS_SUCCESS) ||
+        (libspdm_bench_alloc_endpoint(&m_libspdm_bench_responder) != LIBSPDM_STATUS_SUCCESS)) {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+    for (op = 0; op < LIBSPDM_BENCH_OP_MAX; op++) {
+        if (!libspdm_bench_stat_init(&m_libspdm_bench_stat[op], m_libspdm_bench_op_name[op],
+                                     iterations)) {
+            fprintf(stderr, "out of memory\n");
+            return 1;
+        }
+    }
+
+    fp = stdout;
+    if (strcmp(output_file, "-") != 0) {
+        fp = fopen(output_file, "w");
+        if (fp == NULL) {
+            fprintf(stderr, "Unable to open file %s\n", output_file);
+            return 1;
+        }
+    }
+
+    fprintf(fp, "{\n");
+    fprintf(fp, "  \"benchmark\": \"spdm_chunk\",\n");
+    fprintf(fp, "  \"version\": %d,\n", LIBSPDM_BENCH_REPORT_VERSION);
+    fprintf(fp, "  \"crypto\": \"%s\",\n", LIBSPDM_BENCH_CRYPTO_NAME);
+    fprintf(fp, "  \"iterations\": %zu,\n", iterations);
+    fprintf(fp, "  \"message_size\": %zu,\n", message_size);
+    fprintf(fp, "  \"results\": [\n");
+
+    first = true;
+    if (filter_data_transfer_size != 0) {
+        passed = libspdm_bench_run_data_transfer_size(fp, first, filter_data_transfer_size,
+                                                      message_size, iterations);
+        first = false;
+    } else {
+        for (dts_index = 0;
+             dts_index < LIBSPDM_BENCH_ARRAY_SIZE(m_libspdm_bench_data_transfer_size);
+             dts_index++) {
+            passed &= libspdm_bench_run_data_transfer_size(
+                fp, first, m_libspdm_bench_data_transfer_size[dts_index],
+                message_size, iterations);
+            first = false;
+        }
+    }
+
+    fprintf(fp, "%s  ]\n}\n", first ? "" : "\n");
+    if (fp != stdout) {
+        fclose(fp);
+    }
+
+    for (op = 0; op < LIBSPDM_BENCH_OP_MAX; op++) {
+        libspdm_bench_stat_free(&m_libspdm_bench_stat[op]);
+    }
+    free(m_libspdm_bench_requester.scratch_buffer);
+    free(m_libspdm_bench_requester.spdm_context);
+    free(m_libspdm_bench_responder.scratch_buffer);
+    free(m_libspdm_bench_responder.spdm_context);
+    return passed ? 0 : 1;
+}
@@ -1502,6 +1502,468 @@ static void libspdm_test_max_session_count_case21(void **state)
     }
 }
 
+#if LIBSPDM_DHE_KEY_POOL_SUPPORT
+static void libspdm_test_dhe_key_pool_case22(void **state)
+{
+    libspdm_context_t *spdm_context;
+    libspdm_return_t status;
+    uint8_t public_key[LIBSPDM_MAX_DHE_KEY_SIZE];
+    size_t public_key_size;
+    void *dhe_context;
+    void *pooled_dhe_context;
+    uint16_t dhe_named_group;
+
+    dhe_named_group = SPDM_ALGORITHMS_DHE_NAMED_GROUP_SECP_256_R1;
+
+    spdm_context = (libspdm_context_t *)malloc(libspdm_get_context_size());
+    libspdm_init_context (spdm_context);
+    spdm_context->connection_info.version = SPDM_MESSAGE_VERSION_12 <<
+                                            SPDM_VERSION_NUMBER_SHIFT_BIT;
+    spdm_context->local_context.is_requester = true;
+
+    /* Fill is capped at the pool size and is idempotent. */
+    status = libspdm_dhe_key_pool_fill(spdm_context, dhe_named_group,
+                                       LIBSPDM_DHE_KEY_POOL_SIZE + 1);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    assert_int_equal(spdm_context->dhe_key_pool_count, LIBSPDM_DHE_KEY_POOL_SIZE);
+    pooled_dhe_context = spdm_context->dhe_key_pool[0].dhe_context;
+    status = libspdm_dhe_key_pool_fill(spdm_context, dhe_named_group, 1);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    assert_int_equal(spdm_context->dhe_key_pool_count, LIBSPDM_DHE_KEY_POOL_SIZE);
+
+    /* A full pool cannot hold another group. */
+    status = libspdm_dhe_key_pool_fill(spdm_context,
+                                       SPDM_ALGORITHMS_DHE_NAMED_GROUP_SECP_384_R1, 1);
+    assert_int_equal(status, LIBSPDM_STATUS_BUFFER_FULL);
+
+    /* No key pair for another group. */
+    public_key_size = sizeof(public_key);
+    dhe_context = libspdm_dhe_key_pool_take(spdm_context, spdm_context->connection_info.version,
+                                            SPDM_ALGORITHMS_DHE_NAMED_GROUP_SECP_384_R1, true,
+                                            public_key, &public_key_size);
+    assert_null(dhe_context);
+
+    /* A key pair is taken only once. */
+    public_key_size = sizeof(public_key);
+    dhe_context = libspdm_dhe_key_pool_take(spdm_context, spdm_context->connection_info.version,
+                                            dhe_named_group, true,
+                                            public_key, &public_key_size);
+    assert_ptr_equal(dhe_context, pooled_dhe_context);
+    assert_int_equal(public_key_size, libspdm_get_dhe_pub_key_size(dhe_named_group));
+    assert_int_equal(spdm_context->dhe_key_pool_count, LIBSPDM_DHE_KEY_POOL_SIZE - 1);
+    assert_ptr_not_equal(spdm_context->dhe_key_pool[0].dhe_context, pooled_dhe_context);
+    libspdm_dhe_free(dhe_named_group, dhe_context);
+
+    libspdm_dhe_key_pool_flush(spdm_context);
+    assert_int_equal(spdm_context->dhe_key_pool_count, 0);
+    assert_null(spdm_context->dhe_key_pool[0].dhe_context);
+
+    free(spdm_context);
+}
+#endif /* LIBSPDM_DHE_KEY_POOL_SUPPORT */
+
+#if LIBSPDM_STATISTICS_SUPPORT
+static void libspdm_test_statistics_case23(void **state)
+{
+    libspdm_context_t *spdm_context;
+    libspdm_data_parameter_t parameter;
+    libspdm_return_t status;
+    static libspdm_statistics_t statistics;
+    size_t data_size;
+    libspdm_session_info_t *session_info;
+    libspdm_secured_message_context_t *secured_message_context;
+    uint32_t session_id;
+    spdm_error_response_t error_response;
+    size_t index;
+    uint64_t start_us;
+
+    assert_int_equal(libspdm_statistics_get_request_index(SPDM_GET_VERSION), 4);
+    assert_int_equal(libspdm_statistics_get_request_index(SPDM_RESPOND_IF_READY), 0x2F);
+    assert_int_equal(libspdm_statistics_get_request_index(SPDM_VENDOR_DEFINED_REQUEST), 0x2E);
+    assert_int_equal(libspdm_statistics_get_request_index(SPDM_VERSION),
+                     LIBSPDM_STATISTICS_REQUEST_CODE_COUNT);
+
+    spdm_context = (libspdm_context_t *)malloc(libspdm_get_context_size());
+    libspdm_init_context (spdm_context);
+    spdm_context->connection_info.capability.flags =
+        SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP |
+        SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
+    spdm_context->local_context.capability.flags =
+        SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_ENCRYPT_CAP |
+        SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MAC_CAP;
+
+    session_id = 0xFFFFFFFF;
+    session_info = libspdm_assign_session_id(spdm_context, session_id, false);
+    assert_non_null(session_info);
+    secured_message_context = session_info->secured_message_context;
+
+    start_us = libspdm_get_timestamp_us();
+
+    /* One request out of session and one in session, with a Busy response. */
+    libspdm_statistics_record_request(spdm_context, NULL, SPDM_GET_VERSION, start_us);
+    libspdm_statistics_record_request(spdm_context, session_info, SPDM_HEARTBEAT, start_us);
+    libspdm_statistics_record_request(spdm_context, NULL, SPDM_VERSION, start_us);
+    error_response.header.spdm_version = SPDM_MESSAGE_VERSION_12;
+    error_response.header.request_response_code = SPDM_ERROR;
+    error_response.header.param1 = SPDM_ERROR_CODE_BUSY;
+    error_response.header.param2 = 0;
+    libspdm_statistics_record_message(spdm_context, session_info, false,
+                                      sizeof(error_response), &error_response);
+    libspdm_statistics_record_crypto(spdm_context, LIBSPDM_STATISTICS_CRYPTO_DHE, start_us);
+    secured_message_context->secured_message_decoded = 2;
+    secured_message_context->decrypt_failure = 1;
+
+    parameter.location = LIBSPDM_DATA_LOCATION_LOCAL;
+    data_size = sizeof(statistics) - 1;
+    status = libspdm_get_data(spdm_context, LIBSPDM_DATA_STATISTICS, &parameter,
+                              &statistics, &data_size);
+    assert_int_equal(status, LIBSPDM_STATUS_BUFFER_TOO_SMALL);
+    assert_int_equal(data_size, sizeof(statistics));
+
+    status = libspdm_get_data(spdm_context, LIBSPDM_DATA_STATISTICS, &parameter,
+                              &statistics, &data_size);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    assert_int_equal(
+        statistics.request[libspdm_statistics_get_request_index(SPDM_GET_VERSION)].count, 1);
+    assert_int_equal(
+        statistics.request[libspdm_statistics_get_request_index(SPDM_HEARTBEAT)].count, 1);
+    assert_int_equal(statistics.bytes_out, sizeof(error_response));
+    assert_int_equal(statistics.busy, 1);
+    assert_int_equal(statistics.crypto[LIBSPDM_STATISTICS_CRYPTO_DHE].count, 1);
+    assert_int_equal(statistics.secured_message_decoded, 2);
+    assert_int_equal(statistics.decrypt_failure, 1);
+
+    /* The session block only holds the session. */
+    parameter.location = LIBSPDM_DATA_LOCATION_SESSION;
+    libspdm_write_uint32(parameter.additional_data, session_id);
+    data_size = sizeof(statistics);
+    status = libspdm_get_data(spdm_context, LIBSPDM_DATA_STATISTICS, &parameter,
+                              &statistics, &data_size);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    assert_int_equal(
+        statistics.request[libspdm_statistics_get_request_index(SPDM_GET_VERSION)].count, 0);
+    assert_int_equal(
+        statistics.request[libspdm_statistics_get_request_index(SPDM_HEARTBEAT)].count, 1);
+    assert_int_equal(statistics.busy, 1);
+    assert_int_equal(statistics.crypto[LIBSPDM_STATISTICS_CRYPTO_DHE].count, 0);
+    assert_int_equal(statistics.secured_message_decoded, 2);
+
+    /* The secured message counters outlive the session. */
+    libspdm_free_session_id(spdm_context, session_id);
+    status = libspdm_get_data(spdm_context, LIBSPDM_DATA_STATISTICS, &parameter,
+                              &statistics, &data_size);
+    assert_int_equal(status, LIBSPDM_STATUS_INVALID_PARAMETER);
+
+    parameter.location = LIBSPDM_DATA_LOCATION_LOCAL;
+    data_size = sizeof(statistics);
+    status = libspdm_get_data(spdm_context, LIBSPDM_DATA_STATISTICS, &parameter,
+                              &statistics, &data_size);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    assert_int_equal(statistics.secured_message_decoded, 2);
+    assert_int_equal(statistics.decrypt_failure, 1);
+
+    /* The histogram buckets add up to the count. */
+    data_size = 0;
+    for (index = 0; index < LIBSPDM_STATISTICS_HISTOGRAM_SIZE; index++) {
+        data_size += (size_t)statistics.request[
+            libspdm_statistics_get_request_index(SPDM_GET_VERSION)].histogram[index];
+    }
+    assert_int_equal(data_size, 1);
+
+    free(spdm_context);
+}
+#endif /* LIBSPDM_STATISTICS_SUPPORT */
+
+#if LIBSPDM_CONNECTION_SNAPSHOT_SUPPORT
+static void libspdm_test_connection_snapshot_case24(void **state)
+{
+    libspdm_context_t *spdm_context;
+    libspdm_context_t *restored_context;
+    libspdm_data_parameter_t parameter;
+    libspdm_return_t status;
+    void *data;
+    size_t data_size;
+    void *hash;
+    size_t hash_size;
+    uint8_t key[32];
+    uint8_t snapshot[LIBSPDM_MAX_CERT_CHAIN_SIZE + LIBSPDM_MAX_MESSAGE_VCA_BUFFER_SIZE + 0x400];
+    size_t snapshot_size;
+    uint8_t vca[] = {SPDM_GET_VERSION, SPDM_VERSION, SPDM_GET_CAPABILITIES, SPDM_CAPABILITIES};
+    void *public_key;
+    bool need_free;
+
+    libspdm_read_responder_public_certificate_chain(m_libspdm_use_hash_algo,
+                                                    m_libspdm_use_asym_algo, &data,
+                                                    &data_size, &hash, &hash_size);
+    libspdm_set_mem(key, sizeof(key), 0x5a);
+
+    spdm_context = (libspdm_context_t *)malloc(libspdm_get_context_size());
+    libspdm_init_context (spdm_context);
+    spdm_context->local_context.is_requester = true;
+    spdm_context->connection_info.version = SPDM_MESSAGE_VERSION_12 <<
+                                            SPDM_VERSION_NUMBER_SHIFT_BIT;
+    spdm_context->connection_info.algorithm.base_hash_algo = m_libspdm_use_hash_algo;
+    spdm_context->connection_info.algorithm.base_asym_algo = m_libspdm_use_asym_algo;
+    spdm_context->connection_info.capability.flags =
+        SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
+
+    /* A connection that is not negotiated has no snapshot. */
+    snapshot_size = sizeof(snapshot);
+    status = libspdm_get_connection_snapshot(spdm_context, key, sizeof(key),
+                                             snapshot, &snapshot_size);
+    assert_int_equal(status, LIBSPDM_STATUS_INVALID_STATE_LOCAL);
+
+    libspdm_zero_mem(&parameter, sizeof(parameter));
+    parameter.location = LIBSPDM_DATA_LOCATION_CONNECTION;
+    status = libspdm_set_data(spdm_context, LIBSPDM_DATA_VCA_CACHE, &parameter,
+                              vca, sizeof(vca));
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    parameter.additional_data[0] = 1;
+    status = libspdm_set_data(spdm_context, LIBSPDM_DATA_PEER_USED_CERT_CHAIN_BUFFER,
+                              &parameter, data, data_size);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    spdm_context->connection_info.peer_digest_slot_mask = 0x02;
+    libspdm_copy_mem(spdm_context->connection_info.peer_total_digest_buffer,
+                     sizeof(spdm_context->connection_info.peer_total_digest_buffer),
+                     hash, hash_size);
+    spdm_context->connection_info.connection_state = LIBSPDM_CONNECTION_STATE_AFTER_CERTIFICATE;
+
+    /* The required size is returned for a small buffer. */
+    snapshot_size = 0;
+    status = libspdm_get_connection_snapshot(spdm_context, key, sizeof(key),
+                                             snapshot, &snapshot_size);
+    assert_int_equal(status, LIBSPDM_STATUS_BUFFER_TOO_SMALL);
+    assert_true(snapshot_size > data_size + sizeof(vca));
+    assert_true(snapshot_size <= sizeof(snapshot));
+    status = libspdm_get_connection_snapshot(spdm_context, key, sizeof(key),
+                                             snapshot, &snapshot_size);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+
+    restored_context = (libspdm_context_t *)malloc(libspdm_get_context_size());
+    libspdm_init_context (restored_context);
+    restored_context->local_context.is_requester = true;
+    restored_context->local_context.algorithm.base_hash_algo = m_libspdm_use_hash_algo;
+    restored_context->local_context.algorithm.base_asym_algo = m_libspdm_use_asym_algo;
+
+    /* A wrong key or a modified snapshot is rejected, and the context is not changed. */
+    key[0] ^= 1;
+    status = libspdm_set_connection_snapshot(restored_context, key, sizeof(key),
+                                             snapshot, snapshot_size);
+    assert_int_equal(status, LIBSPDM_STATUS_VERIF_FAIL);
+    key[0] ^= 1;
+    snapshot[snapshot_size / 2] ^= 1;
+    status = libspdm_set_connection_snapshot(restored_context, key, sizeof(key),
+                                             snapshot, snapshot_size);
+    assert_int_equal(status, LIBSPDM_STATUS_VERIF_FAIL);
+    snapshot[snapshot_size / 2] ^= 1;
+    status = libspdm_set_connection_snapshot(restored_context, key, sizeof(key),
+                                             snapshot, snapshot_size - 1);
+    assert_int_equal(status, LIBSPDM_STATUS_INVALID_PARAMETER);
+    assert_int_equal(restored_context->connection_info.connection_state,
+                     LIBSPDM_CONNECTION_STATE_NOT_STARTED);
+
+    status = libspdm_set_connection_snapshot(restored_context, key, sizeof(key),
+                                             snapshot, snapshot_size);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    assert_int_equal(restored_context->connection_info.connection_state,
+                     LIBSPDM_CONNECTION_STATE_AFTER_CERTIFICATE);
+    assert_int_equal(restored_context->connection_info.version,
+                     spdm_context->connection_info.version);
+    assert_int_equal(restored_context->connection_info.capability.flags,
+                     SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP);
+    assert_int_equal(restored_context->connection_info.algorithm.base_asym_algo,
+                     m_libspdm_use_asym_algo);
+    assert_int_equal(restored_context->connection_info.peer_digest_slot_mask, 0x02);
+    assert_int_equal(restored_context->connection_info.peer_used_cert_chain_slot_id, 1);
+    assert_memory_equal(restored_context->connection_info.peer_total_digest_buffer,
+                        hash, hash_size);
+    assert_int_equal(restored_context->transcript.message_a.buffer_size, sizeof(vca));
+    assert_memory_equal(restored_context->transcript.message_a.buffer, vca, sizeof(vca));
+    assert_true(libspdm_get_peer_leaf_cert_public_key(restored_context, true, 1,
+                                                      &public_key, &need_free));
+    assert_non_null(public_key);
+    if (need_free) {
+        libspdm_asym_free(m_libspdm_use_asym_algo, public_key);
+    }
+
+    /* A context that does not support the negotiated algorithms cannot restore it. */
+    libspdm_deinit_context(restored_context);
+    libspdm_init_context (restored_context);
+    restored_context->local_context.is_requester = true;
+    restored_context->local_context.algorithm.base_hash_algo = m_libspdm_use_hash_algo;
+    status = libspdm_set_connection_snapshot(restored_context, key, sizeof(key),
+                                             snapshot, snapshot_size);
+    assert_int_equal(status, LIBSPDM_STATUS_INVALID_PARAMETER);
+
+#if !(LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT)
+    /* An authentic snapshot whose certificate chain cannot be parsed does not change the
+     * context. */
+    restored_context->local_context.algorithm.base_asym_algo = m_libspdm_use_asym_algo;
+    snapshot[snapshot_size - hash_size - data_size + sizeof(spdm_cert_chain_t) + hash_size] = 0;
+    assert_true(libspdm_hmac_all(m_libspdm_use_hash_algo, snapshot, snapshot_size - hash_size,
+                                 key, sizeof(key), snapshot + snapshot_size - hash_size));
+    status = libspdm_set_connection_snapshot(restored_context, key, sizeof(key),
+                                             snapshot, snapshot_size);
+    assert_int_equal(status, LIBSPDM_STATUS_CRYPTO_ERROR);
+    assert_int_equal(restored_context->connection_info.connection_state,
+                     LIBSPDM_CONNECTION_STATE_NOT_STARTED);
+    assert_int_equal(restored_context->connection_info.version, 0);
+    assert_int_equal(restored_context->connection_info.algorithm.base_hash_algo, 0);
+    assert_int_equal(restored_context->connection_info.peer_digest_slot_mask, 0);
+    assert_int_equal(restored_context->transcript.message_a.buffer_size, 0);
+    assert_null(restored_context->connection_info.peer_used_cert_chain[1].leaf_cert_public_key);
+#endif /* !(LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT) */
+
+    libspdm_deinit_context(restored_context);
+    free(restored_context);
+    libspdm_deinit_context(spdm_context);
+    free(spdm_context);
+    free(data);
+}
+#endif /* LIBSPDM_CONNECTION_SNAPSHOT_SUPPORT */
+
+/**
+ * Return true if the two scratch buffer regions do not share any byte.
+ **/
+static bool libspdm_test_scratch_region_disjoint(uint32_t offset1, uint32_t capacity1,
+                                                 uint32_t offset2, uint32_t capacity2)
+{
+    return (offset1 + capacity1 <= offset2) || (offset2 + capacity2 <= offset1);
+}
+
+/**
+ * Test 25: The scratch buffer regions used by the requester flow or by the responder flow never
+ * overlap, and the required size matches the build time size.
+ **/
+static void libspdm_test_scratch_buffer_layout_case25(void **state)
+{
+    libspdm_context_t *spdm_context;
+    uint32_t capacity;
+    uint32_t last_request_offset;
+    uint32_t last_request_capacity;
+    uint8_t *scratch_buffer;
+    void *returned_scratch_buffer;
+    size_t scratch_buffer_size;
+#if LIBSPDM_ENABLE_CAPABILITY_CHUNK_CAP
+    uint32_t secure_message_offset;
+    uint32_t secure_message_capacity;
+    uint32_t large_message_offset;
+    uint32_t large_message_capacity;
+    uint32_t sender_receiver_offset;
+    uint32_t sender_receiver_capacity;
+    uint32_t large_sender_receiver_offset;
+    uint32_t large_sender_receiver_capacity;
+#endif /* LIBSPDM_ENABLE_CAPABILITY_CHUNK_CAP */
+#if LIBSPDM_RESPOND_IF_READY_SUPPORT
+    uint32_t cache_request_offset;
+    uint32_t cache_request_capacity;
+#endif /* LIBSPDM_RESPOND_IF_READY_SUPPORT */
+
+    spdm_context = (libspdm_context_t *)malloc(libspdm_get_context_size());
+    libspdm_init_context (spdm_context);
+    spdm_context->local_context.capability.max_spdm_msg_size = 0x1200;
+    spdm_context->local_context.capability.transport_additional_size = 0x40;
+
+    capacity = libspdm_get_scratch_buffer_capacity(spdm_context);
+    assert_int_equal(libspdm_get_sizeof_required_scratch_buffer(spdm_context), capacity);
+    assert_int_equal(capacity, LIBSPDM_REQUIRED_SCRATCH_BUFFER_SIZE(0x1200, 0x40));
+
+    last_request_offset = libspdm_get_scratch_buffer_last_spdm_request_offset(spdm_context);
+    last_request_capacity = libspdm_get_scratch_buffer_last_spdm_request_capacity(spdm_context);
+    assert_true(last_request_offset + last_request_capacity <= capacity);
+
+#if LIBSPDM_ENABLE_CAPABILITY_CHUNK_CAP
+    secure_message_offset = libspdm_get_scratch_buffer_secure_message_offset(spdm_context);
+    secure_message_capacity = libspdm_get_scratch_buffer_secure_message_capacity(spdm_context);
+    large_message_offset = libspdm_get_scratch_buffer_large_message_offset(spdm_context);
+    large_message_capacity = libspdm_get_scratch_buffer_large_message_capacity(spdm_context);
+    sender_receiver_offset = libspdm_get_scratch_buffer_sender_receiver_offset(spdm_context);
+    sender_receiver_capacity = libspdm_get_scratch_buffer_sender_receiver_capacity(spdm_context);
+    large_sender_receiver_offset =
+        libspdm_get_scratch_buffer_large_sender_receiver_offset(spdm_context);
+    large_sender_receiver_capacity =
+        libspdm_get_scratch_buffer_large_sender_receiver_capacity(spdm_context);
+
+    /* Requester: secured message, large message, sender/receiver and last request. */
+    assert_true(libspdm_test_scratch_region_disjoint(
+                    secure_message_offset, secure_message_capacity,
+                    large_message_offset, large_message_capacity));
+    assert_true(libspdm_test_scratch_region_disjoint(
+                    secure_message_offset, secure_message_capacity,
+                    sender_receiver_offset, sender_receiver_capacity));
+    assert_true(libspdm_test_scratch_region_disjoint(
+                    large_message_offset, large_message_capacity,
+                    sender_receiver_offset, sender_receiver_capacity));
+    assert_true(libspdm_test_scratch_region_disjoint(
+                    secure_message_offset, secure_message_capacity,
+                    large_sender_receiver_offset, large_sender_receiver_capacity));
+    assert_true(libspdm_test_scratch_region_disjoint(
+                    large_message_offset, large_message_capacity,
+                    large_sender_receiver_offset, large_sender_receiver_capacity));
+    /* Requests are built in the large sender/receiver region and sent in chunks from the
+     * sender/receiver region without copying them first. */
+    assert_true(libspdm_test_scratch_region_disjoint(
+                    sender_receiver_offset, sender_receiver_capacity,
+                    large_sender_receiver_offset, large_sender_receiver_capacity));
+    assert_true(libspdm_test_scratch_region_disjoint(
+                    sender_receiver_offset, sender_receiver_capacity,
+                    last_request_offset, last_request_capacity));
+    assert_true(libspdm_test_scratch_region_disjoint(
+                    large_sender_receiver_offset, large_sender_receiver_capacity,
+                    last_request_offset, last_request_capacity));
+    assert_true(libspdm_test_scratch_region_disjoint(
+                    secure_message_offset, secure_message_capacity,
+                    last_request_offset, last_request_capacity));
+    assert_true(libspdm_test_scratch_region_disjoint(
+                    large_message_offset, large_message_capacity,
+                    last_request_offset, last_request_capacity));
+    assert_true(sender_receiver_offset + sender_receiver_capacity <= capacity);
+    assert_true(large_sender_receiver_offset + large_sender_receiver_capacity <= capacity);
+#endif /* LIBSPDM_ENABLE_CAPABILITY_CHUNK_CAP */
+
+#if LIBSPDM_RESPOND_IF_READY_SUPPORT
+    /* Responder: the cached request must survive the handling of every later request. */
+    cache_request_offset = libspdm_get_scratch_buffer_cache_spdm_request_offset(spdm_context);
+    cache_request_capacity = libspdm_get_scratch_buffer_cache_spdm_request_capacity(spdm_context);
+    assert_true(cache_request_offset + cache_request_capacity <= capacity);
+    assert_true(libspdm_test_scratch_region_disjoint(
+                    cache_request_offset, cache_request_capacity,
+                    last_request_offset, last_request_capacity));
+#if LIBSPDM_ENABLE_CAPABILITY_CHUNK_CAP
+    assert_true(libspdm_test_scratch_region_disjoint(
+                    cache_request_offset, cache_request_capacity,
+                    secure_message_offset, secure_message_capacity));
+    assert_true(libspdm_test_scratch_region_disjoint(
+                    cache_request_offset, cache_request_capacity,
+                    large_message_offset, large_message_capacity));
+    /* The responder builds responses in the sender/receiver regions handed out by
+     * libspdm_acquire_sender_buffer() and libspdm_acquire_receiver_buffer(). */
+    assert_true(libspdm_test_scratch_region_disjoint(
+                    cache_request_offset, cache_request_capacity,
+                    sender_receiver_offset, sender_receiver_capacity));
+    assert_true(libspdm_test_scratch_region_disjoint(
+                    cache_request_offset, cache_request_capacity,
+                    large_sender_receiver_offset, large_sender_receiver_capacity));
+#endif /* LIBSPDM_ENABLE_CAPABILITY_CHUNK_CAP */
+#endif /* LIBSPDM_RESPOND_IF_READY_SUPPORT */
+
+    /* The scratch buffer handed out for message processing ends where the internal state
+     * track starts. */
+    scratch_buffer = (uint8_t *)malloc(capacity);
+    libspdm_set_scratch_buffer(spdm_context, scratch_buffer, capacity);
+    assert_ptr_equal(spdm_context->last_spdm_request, scratch_buffer + last_request_offset);
+#if LIBSPDM_RESPOND_IF_READY_SUPPORT
+    assert_ptr_equal(spdm_context->cache_spdm_request, scratch_buffer + cache_request_offset);
+#endif /* LIBSPDM_RESPOND_IF_READY_SUPPORT */
+    libspdm_get_scratch_buffer(spdm_context, &returned_scratch_buffer, &scratch_buffer_size);
+    assert_ptr_equal(returned_scratch_buffer, scratch_buffer);
+    assert_int_equal(scratch_buffer_size, last_request_offset);
+
+    free(scratch_buffer);
+    libspdm_deinit_context(spdm_context);
+    free(spdm_context);
+}
+
 static libspdm_test_context_t m_libspdm_common_context_data_test_context = {
     LIBSPDM_TEST_CONTEXT_VERSION,
     true,
@@ -1509,6 +1971,141 @@ static libspdm_test_context_t m_libspdm_common_context_data_test_context = {
     NULL,
 };
 
+#if LIBSPDM_CONNECTION_SNAPSHOT_SUPPORT
+/**
+ * Test 26: The certificate chains of two slots are retrieved, then the first slot is used.
+ * Expected Behavior: the snapshot never restores the chain of one slot for another slot, and a
+ * connection without a slot in use is saved and restored.
+ **/
+static void libspdm_test_connection_snapshot_case26(void **state)
+{
+    libspdm_context_t *spdm_context;
+    libspdm_context_t *restored_context;
+    libspdm_data_parameter_t parameter;
+    libspdm_return_t status;
+    void *data;
+    size_t data_size;
+    void *hash;
+    size_t hash_size;
+    uint8_t key[32];
+    uint8_t snapshot[LIBSPDM_MAX_CERT_CHAIN_SIZE + LIBSPDM_MAX_MESSAGE_VCA_BUFFER_SIZE + 0x400];
+    size_t snapshot_size;
+    size_t snapshot_size_without_chain;
+    uint8_t vca[] = {SPDM_GET_VERSION, SPDM_VERSION, SPDM_GET_CAPABILITIES, SPDM_CAPABILITIES};
+
+    libspdm_read_responder_public_certificate_chain(m_libspdm_use_hash_algo,
+                                                    m_libspdm_use_asym_algo, &data,
+                                                    &data_size, &hash, &hash_size);
+    libspdm_set_mem(key, sizeof(key), 0x5a);
+
+    spdm_context = (libspdm_context_t *)malloc(libspdm_get_context_size());
+    libspdm_init_context (spdm_context);
+    spdm_context->local_context.is_requester = true;
+    spdm_context->connection_info.version = SPDM_MESSAGE_VERSION_12 <<
+                                            SPDM_VERSION_NUMBER_SHIFT_BIT;
+    spdm_context->connection_info.algorithm.base_hash_algo = m_libspdm_use_hash_algo;
+    spdm_context->connection_info.algorithm.base_asym_algo = m_libspdm_use_asym_algo;
+    spdm_context->connection_info.capability.flags =
+        SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
+
+    libspdm_zero_mem(&parameter, sizeof(parameter));
+    parameter.location = LIBSPDM_DATA_LOCATION_CONNECTION;
+    status = libspdm_set_data(spdm_context, LIBSPDM_DATA_VCA_CACHE, &parameter,
+                              vca, sizeof(vca));
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    parameter.additional_data[0] = 0;
+    status = libspdm_set_data(spdm_context, LIBSPDM_DATA_PEER_USED_CERT_CHAIN_BUFFER,
+                              &parameter, data, data_size);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    parameter.additional_data[0] = 1;
+    status = libspdm_set_data(spdm_context, LIBSPDM_DATA_PEER_USED_CERT_CHAIN_BUFFER,
+                              &parameter, data, data_size);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    spdm_context->connection_info.peer_digest_slot_mask = 0x03;
+    spdm_context->connection_info.connection_state = LIBSPDM_CONNECTION_STATE_AUTHENTICATED;
+
+    restored_context = (libspdm_context_t *)malloc(libspdm_get_context_size());
+
+    /* Without a slot in use, such as with a provisioned public key, no chain is saved. */
+    spdm_context->connection_info.peer_used_cert_chain_slot_id = 0xFF;
+    snapshot_size = sizeof(snapshot);
+    status = libspdm_get_connection_snapshot(spdm_context, key, sizeof(key),
+                                             snapshot, &snapshot_size);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    snapshot_size_without_chain = snapshot_size;
+    libspdm_init_context (restored_context);
+    restored_context->local_context.is_requester = true;
+    restored_context->local_context.algorithm.base_hash_algo = m_libspdm_use_hash_algo;
+    restored_context->local_context.algorithm.base_asym_algo = m_libspdm_use_asym_algo;
+    status = libspdm_set_connection_snapshot(restored_context, key, sizeof(key),
+                                             snapshot, snapshot_size);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    assert_int_equal(restored_context->connection_info.peer_used_cert_chain_slot_id, 0xFF);
+    libspdm_deinit_context(restored_context);
+
+    /* The chain of slot 1 is the last one retrieved, as by a CHALLENGE of slot 0 after the
+     * GET_CERTIFICATE of both slots. */
+    spdm_context->connection_info.peer_used_cert_chain_slot_id = 0;
+    snapshot_size = sizeof(snapshot);
+    status = libspdm_get_connection_snapshot(spdm_context, key, sizeof(key),
+                                             snapshot, &snapshot_size);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    libspdm_init_context (restored_context);
+    restored_context->local_context.is_requester = true;
+    restored_context->local_context.algorithm.base_hash_algo = m_libspdm_use_hash_algo;
+    restored_context->local_context.algorithm.base_asym_algo = m_libspdm_use_asym_algo;
+    status = libspdm_set_connection_snapshot(restored_context, key, sizeof(key),
+                                             snapshot, snapshot_size);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    assert_int_equal(restored_context->connection_info.peer_used_cert_chain_slot_id, 0);
+    assert_null(restored_context->connection_info.peer_used_cert_chain[1].leaf_cert_public_key);
+#if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
+    /* Each slot keeps its own chain. */
+    assert_int_equal(snapshot_size, snapshot_size_without_chain + data_size);
+    assert_int_equal(restored_context->connection_info.peer_used_cert_chain[0].buffer_size,
+                     data_size);
+    assert_memory_equal(restored_context->connection_info.peer_used_cert_chain[0].buffer,
+                        data, data_size);
+#else
+    /* Only the chain of slot 1 is kept, so slot 0 is restored without a chain. */
+    assert_int_equal(snapshot_size, snapshot_size_without_chain);
+    assert_int_equal(restored_context->connection_info.peer_used_cert_chain[0].buffer_hash_size,
+                     0);
+    assert_null(restored_context->connection_info.peer_used_cert_chain[0].leaf_cert_public_key);
+#endif /* LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT */
+    libspdm_deinit_context(restored_context);
+
+    /* The chain of the slot it was retrieved for is saved. */
+    spdm_context->connection_info.peer_used_cert_chain_slot_id = 1;
+    snapshot_size = sizeof(snapshot);
+    status = libspdm_get_connection_snapshot(spdm_context, key, sizeof(key),
+                                             snapshot, &snapshot_size);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    assert_int_equal(snapshot_size, snapshot_size_without_chain + data_size);
+    libspdm_init_context (restored_context);
+    restored_context->local_context.is_requester = true;
+    restored_context->local_context.algorithm.base_hash_algo = m_libspdm_use_hash_algo;
+    restored_context->local_context.algorithm.base_asym_algo = m_libspdm_use_asym_algo;
+    status = libspdm_set_connection_snapshot(restored_context, key, sizeof(key),
+                                             snapshot, snapshot_size);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    assert_int_equal(restored_context->connection_info.peer_used_cert_chain_slot_id, 1);
+#if !(LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT)
+    assert_non_null(
+        restored_context->connection_info.peer_used_cert_chain[1].leaf_cert_public_key);
+    assert_memory_equal(restored_context->connection_info.peer_used_cert_chain[1].buffer_hash,
+                        spdm_context->connection_info.peer_used_cert_chain[1].buffer_hash,
+                        hash_size);
+#endif /* !(LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT) */
+
+    libspdm_deinit_context(restored_context);
+    free(restored_context);
+    libspdm_deinit_context(spdm_context);
+    free(spdm_context);
+    free(data);
+}
+#endif /* LIBSPDM_CONNECTION_SNAPSHOT_SUPPORT */
+
 int libspdm_common_context_data_test_main(void)
 {
     const struct CMUnitTest spdm_common_context_data_tests[] = {
@@ -1550,6 +2147,29 @@ int libspdm_common_context_data_test_main(void)
 
         /* Test the max DHE/PSK session count */
         cmocka_unit_test(libspdm_test_max_session_count_case21),
+
+#if LIBSPDM_DHE_KEY_POOL_SUPPORT
+        /* Test the pre-generated DHE key pool */
+        cmocka_unit_test(libspdm_test_dhe_key_pool_case22),
+#endif /* LIBSPDM_DHE_KEY_POOL_SUPPORT */
+
+#if LIBSPDM_STATISTICS_SUPPORT
+        /* Test the statistics block of the context and of a session */
+        cmocka_unit_test(libspdm_test_statistics_case23),
+#endif /* LIBSPDM_STATISTICS_SUPPORT */
+
+#if LIBSPDM_CONNECTION_SNAPSHOT_SUPPORT
+        /* Test the snapshot and restore of a negotiated connection */
+        cmocka_unit_test(libspdm_test_connection_snapshot_case24),
+#endif /* LIBSPDM_CONNECTION_SNAPSHOT_SUPPORT */
+
+        /* Scratch buffer regions do not alias within a flow */
+        cmocka_unit_test(libspdm_test_scratch_buffer_layout_case25),
+
+#if LIBSPDM_CONNECTION_SNAPSHOT_SUPPORT
+        /* Test the snapshot of a connection after the certificate chains of two slots */
+        cmocka_unit_test(libspdm_test_connection_snapshot_case26),
+#endif /* LIBSPDM_CONNECTION_SNAPSHOT_SUPPORT */
     };
 
     libspdm_setup_test_context(&m_libspdm_common_context_data_test_context);
@@ -0,0 +1,117 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2021-2022 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+#include "spdm_unit_test.h"
+#include "library/debuglib_ext.h"
+
+#include <stdio.h>
+
+#if (LIBSPDM_DEBUG_PRINT_ENABLE) && (LIBSPDM_DEBUG_BINARY_LOG_ENABLE)
+
+#define LIBSPDM_TEST_DEBUG_MESSAGE_SIZE 0x100
+
+static char m_libspdm_test_debug_expected[LIBSPDM_TEST_DEBUG_MESSAGE_SIZE];
+
+/* Drop the messages recorded before the test. */
+static void libspdm_test_debug_binary_log_drain(void)
+{
+    libspdm_debug_binary_log_entry_t entry;
+
+    while (libspdm_debug_binary_log_read(&entry, 1) != 0) {
+    }
+}
+
+/* Read the oldest message and check its formatted text. */
+static void libspdm_test_debug_binary_log_check(uint32_t error_level, const char *expected)
+{
+    libspdm_debug_binary_log_entry_t entry;
+    char buffer[LIBSPDM_TEST_DEBUG_MESSAGE_SIZE];
+
+    assert_int_equal(libspdm_debug_binary_log_read(&entry, 1), 1);
+    assert_int_equal(entry.error_level, error_level);
+    libspdm_debug_binary_log_format(&entry, buffer, sizeof(buffer));
+    assert_string_equal(buffer, expected);
+}
+
+/* Record a message and check that it is formatted as printf would format it. */
+#define LIBSPDM_TEST_DEBUG_ROUND_TRIP(...) \
+    do { \
+        snprintf(m_libspdm_test_debug_expected, sizeof(m_libspdm_test_debug_expected), \
+                 __VA_ARGS__); \
+        libspdm_debug_print(LIBSPDM_DEBUG_INFO, __VA_ARGS__); \
+        libspdm_test_debug_binary_log_check(LIBSPDM_DEBUG_INFO, m_libspdm_test_debug_expected); \
+    } while (false)
+
+/**
+ * Test 1: messages with arguments of each width are recorded and formatted back.
+ * Expected Behavior: the formatted text is the text printf produces.
+ **/
+static void libspdm_test_debug_binary_log_case1(void **state)
+{
+    static const char string[] = "abcdef";
+    int width;
+
+    libspdm_debug_set_level(LIBSPDM_DEBUG_INFO | LIBSPDM_DEBUG_ERROR);
+    libspdm_test_debug_binary_log_drain();
+
+    LIBSPDM_TEST_DEBUG_ROUND_TRIP("int %d uint %u hex 0x%08x\n", -5, 7u, 0xABCDu);
+    LIBSPDM_TEST_DEBUG_ROUND_TRIP("long %ld ulong %lu llong %lld ullong %llx\n",
+                                  -123456789L, 123456789UL, -1234567890123LL,
+                                  0x123456789ABCDEFULL);
+    LIBSPDM_TEST_DEBUG_ROUND_TRIP("size %zu intmax %jd ptrdiff %td char %c\n",
+                                  (size_t)42, (intmax_t)-9, (ptrdiff_t)-3, 'A');
+    LIBSPDM_TEST_DEBUG_ROUND_TRIP("short %hd byte %02hhx width [%*d] precision [%.*s]\n",
+                                  (short)-2, (unsigned char)0xFE, 5, 17, 3, string);
+    LIBSPDM_TEST_DEBUG_ROUND_TRIP("double %.3f exp %e 100%% pointer %p\n",
+                                  3.14159, 1.5e10, (const void *)string);
+    LIBSPDM_TEST_DEBUG_ROUND_TRIP("no argument\n");
+
+    /* Arguments beyond LIBSPDM_DEBUG_BINARY_LOG_MAX_ARG_COUNT are dropped with the rest of the
+     * message. */
+    width = 2;
+    libspdm_debug_print(LIBSPDM_DEBUG_INFO, "%*d %d %d %d %d %d\n", width, 1, 2, 3, 4, 5, 6);
+    libspdm_test_debug_binary_log_check(LIBSPDM_DEBUG_INFO, " 1 2 3 4 5 ");
+}
+
+/**
+ * Test 2: messages of a level disabled at run time, and messages overwritten before they are read.
+ * Expected Behavior: disabled levels are not recorded, overwritten messages are counted as lost.
+ **/
+static void libspdm_test_debug_binary_log_case2(void **state)
+{
+    libspdm_debug_binary_log_entry_t entry;
+    uint64_t lost_count;
+    size_t index;
+
+    libspdm_test_debug_binary_log_drain();
+
+    libspdm_debug_set_level(LIBSPDM_DEBUG_ERROR);
+    libspdm_debug_print(LIBSPDM_DEBUG_INFO, "info %d\n", 1);
+    libspdm_debug_print(LIBSPDM_DEBUG_ERROR, "error %d\n", 2);
+    libspdm_test_debug_binary_log_check(LIBSPDM_DEBUG_ERROR, "error 2\n");
+    assert_int_equal(libspdm_debug_binary_log_read(&entry, 1), 0);
+
+    libspdm_debug_set_level(LIBSPDM_DEBUG_INFO | LIBSPDM_DEBUG_ERROR);
+    lost_count = libspdm_debug_binary_log_get_lost_count();
+    for (index = 0; index < LIBSPDM_DEBUG_BINARY_LOG_ENTRY_COUNT + 2; index++) {
+        libspdm_debug_print(LIBSPDM_DEBUG_INFO, "message %zu\n", index);
+    }
+    assert_int_equal(libspdm_debug_binary_log_get_lost_count(), lost_count + 2);
+    libspdm_test_debug_binary_log_check(LIBSPDM_DEBUG_INFO, "message 2\n");
+    libspdm_test_debug_binary_log_drain();
+}
+
+int libspdm_common_debug_binary_log_test_main(void)
+{
+    const struct CMUnitTest spdm_common_debug_binary_log_tests[] = {
+        cmocka_unit_test(libspdm_test_debug_binary_log_case1),
+        cmocka_unit_test(libspdm_test_debug_binary_log_case2),
+    };
+
+    return cmocka_run_group_tests(spdm_common_debug_binary_log_tests, NULL, NULL);
+}
+
+#endif /* (LIBSPDM_DEBUG_PRINT_ENABLE) && (LIBSPDM_DEBUG_BINARY_LOG_ENABLE) */
@@ -0,0 +1,276 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2021-2022 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+#include "spdm_unit_test.h"
+#include "library/spdm_transport_mctp_lib.h"
+
+#define LIBSPDM_TEST_MCTP_MESSAGE_SIZE 200
+#define LIBSPDM_TEST_MCTP_MAX_PACKET_COUNT 8
+#define LIBSPDM_TEST_MCTP_SLOT_COUNT 2
+#define LIBSPDM_TEST_MCTP_SLOT_SIZE 256
+#define LIBSPDM_TEST_MCTP_MAX_PACKET_SIZE (sizeof(mctp_header_t) + 128)
+
+#define LIBSPDM_TEST_MCTP_DESTINATION_ID 0x10
+#define LIBSPDM_TEST_MCTP_SOURCE_ID 0x20
+
+static uint8_t m_libspdm_test_mctp_message[2][LIBSPDM_TEST_MCTP_MESSAGE_SIZE];
+static uint8_t m_libspdm_test_mctp_slot_buffer[LIBSPDM_TEST_MCTP_SLOT_COUNT *
+                                               LIBSPDM_TEST_MCTP_SLOT_SIZE];
+static libspdm_mctp_reassembly_slot_t m_libspdm_test_mctp_slot[LIBSPDM_TEST_MCTP_SLOT_COUNT];
+static libspdm_mctp_reassembler_t m_libspdm_test_mctp_reassembler;
+
+static void libspdm_test_mctp_init_message(void)
+{
+    size_t index;
+
+    for (index = 0; index < LIBSPDM_TEST_MCTP_MESSAGE_SIZE; index++) {
+        m_libspdm_test_mctp_message[0][index] = (uint8_t)index;
+        m_libspdm_test_mctp_message[1][index] = (uint8_t)(0xFF - index);
+    }
+    m_libspdm_test_mctp_message[0][0] = MCTP_MESSAGE_TYPE_SPDM;
+    m_libspdm_test_mctp_message[1][0] = MCTP_MESSAGE_TYPE_SECURED_MCTP;
+}
+
+/* Copy a packet to the bus buffer, as a transport sends it. */
+static size_t libspdm_test_mctp_build_packet(const libspdm_mctp_packet_t *packet,
+                                             uint8_t *packet_buffer)
+{
+    memcpy(packet_buffer, &packet->header, sizeof(mctp_header_t));
+    memcpy(packet_buffer + sizeof(mctp_header_t), packet->payload, packet->payload_size);
+    return sizeof(mctp_header_t) + packet->payload_size;
+}
+
+static libspdm_return_t libspdm_test_mctp_reassemble(const libspdm_mctp_packet_t *packet,
+                                                     size_t *message_size, void **message)
+{
+    uint8_t packet_buffer[LIBSPDM_TEST_MCTP_MAX_PACKET_SIZE];
+    size_t packet_size;
+
+    packet_size = libspdm_test_mctp_build_packet(packet, packet_buffer);
+    return libspdm_mctp_reassemble_packet(&m_libspdm_test_mctp_reassembler, packet_size,
+                                          packet_buffer, message_size, message);
+}
+
+/**
+ * Test 1: a message is split into baseline transmission unit packets that point into it.
+ **/
+static void libspdm_test_mctp_packetize_case1(void **state)
+{
+    libspdm_mctp_packet_t packet[LIBSPDM_TEST_MCTP_MAX_PACKET_COUNT];
+    libspdm_return_t status;
+    size_t packet_count;
+    size_t index;
+
+    libspdm_test_mctp_init_message();
+    assert_int_equal(libspdm_mctp_get_packet_count(MCTP_BASELINE_TRANSMISSION_UNIT,
+                                                   LIBSPDM_TEST_MCTP_MESSAGE_SIZE), 4);
+
+    packet_count = LIBSPDM_TEST_MCTP_MAX_PACKET_COUNT;
+    status = libspdm_mctp_packetize_message(
+        LIBSPDM_TEST_MCTP_DESTINATION_ID, LIBSPDM_TEST_MCTP_SOURCE_ID,
+        MCTP_MESSAGE_TAG_OWNER | 3, MCTP_BASELINE_TRANSMISSION_UNIT,
+        LIBSPDM_TEST_MCTP_MESSAGE_SIZE, m_libspdm_test_mctp_message[0], &packet_count, packet);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    assert_int_equal(packet_count, 4);
+
+    for (index = 0; index < packet_count; index++) {
+        assert_int_equal(packet[index].header.header_version, MCTP_HEADER_VERSION);
+        assert_int_equal(packet[index].header.destination_id, LIBSPDM_TEST_MCTP_DESTINATION_ID);
+        assert_int_equal(packet[index].header.source_id, LIBSPDM_TEST_MCTP_SOURCE_ID);
+        assert_int_equal(packet[index].header.message_tag &
+                         (MCTP_MESSAGE_TAG_MASK | MCTP_MESSAGE_TAG_OWNER),
+                         MCTP_MESSAGE_TAG_OWNER | 3);
+        assert_int_equal((packet[index].header.message_tag & MCTP_PACKET_SEQUENCE_NUMBER_MASK) >>
+                         MCTP_PACKET_SEQUENCE_NUMBER_SHIFT, index);
+        assert_int_equal((packet[index].header.message_tag & MCTP_START_OF_MESSAGE) != 0,
+                         index == 0);
+        assert_int_equal((packet[index].header.message_tag & MCTP_END_OF_MESSAGE) != 0,
+                         index == packet_count - 1);
+        assert_ptr_equal(packet[index].payload,
+                         m_libspdm_test_mctp_message[0] + index * MCTP_BASELINE_TRANSMISSION_UNIT);
+    }
+    assert_int_equal(packet[0].payload_size, MCTP_BASELINE_TRANSMISSION_UNIT);
+    assert_int_equal(packet[3].payload_size,
+                     LIBSPDM_TEST_MCTP_MESSAGE_SIZE - 3 * MCTP_BASELINE_TRANSMISSION_UNIT);
+}
+
+/**
+ * Test 2: packetizing fails for a short packet array and for out of range parameters.
+ **/
+static void libspdm_test_mctp_packetize_case2(void **state)
+{
+    libspdm_mctp_packet_t packet[LIBSPDM_TEST_MCTP_MAX_PACKET_COUNT];
+    libspdm_return_t status;
+    size_t packet_count;
+
+    libspdm_test_mctp_init_message();
+
+    packet_count = 2;
+    status = libspdm_mctp_packetize_message(
+        LIBSPDM_TEST_MCTP_DESTINATION_ID, LIBSPDM_TEST_MCTP_SOURCE_ID, 0,
+        MCTP_BASELINE_TRANSMISSION_UNIT, LIBSPDM_TEST_MCTP_MESSAGE_SIZE,
+        m_libspdm_test_mctp_message[0], &packet_count, packet);
+    assert_int_equal(status, LIBSPDM_STATUS_BUFFER_TOO_SMALL);
+    assert_int_equal(packet_count, 4);
+
+    packet_count = LIBSPDM_TEST_MCTP_MAX_PACKET_COUNT;
+    status = libspdm_mctp_packetize_message(
+        LIBSPDM_TEST_MCTP_DESTINATION_ID, LIBSPDM_TEST_MCTP_SOURCE_ID, 0,
+        MCTP_BASELINE_TRANSMISSION_UNIT - 1, LIBSPDM_TEST_MCTP_MESSAGE_SIZE,
+        m_libspdm_test_mctp_message[0], &packet_count, packet);
+    assert_int_equal(status, LIBSPDM_STATUS_INVALID_PARAMETER);
+
+    status = libspdm_mctp_packetize_message(
+        LIBSPDM_TEST_MCTP_DESTINATION_ID, LIBSPDM_TEST_MCTP_SOURCE_ID, MCTP_START_OF_MESSAGE,
+        MCTP_BASELINE_TRANSMISSION_UNIT, LIBSPDM_TEST_MCTP_MESSAGE_SIZE,
+        m_libspdm_test_mctp_message[0], &packet_count, packet);
+    assert_int_equal(status, LIBSPDM_STATUS_INVALID_PARAMETER);
+}
+
+/**
+ * Test 3: two messages with different tags are packetized with a larger transmission unit,
+ * their packets are interleaved, and both are reassembled in their own slot.
+ **/
+static void libspdm_test_mctp_reassemble_case3(void **state)
+{
+    libspdm_mctp_packet_t packet[2][LIBSPDM_TEST_MCTP_MAX_PACKET_COUNT];
+    size_t packet_count[2];
+    libspdm_return_t status;
+    size_t message_size[2];
+    void *message[2];
+    size_t index;
+
+    libspdm_test_mctp_init_message();
+    status = libspdm_mctp_init_reassembler(&m_libspdm_test_mctp_reassembler, 128,
+                                           m_libspdm_test_mctp_slot,
+                                           LIBSPDM_TEST_MCTP_SLOT_COUNT,
+                                           m_libspdm_test_mctp_slot_buffer,
+                                           sizeof(m_libspdm_test_mctp_slot_buffer));
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+
+    for (index = 0; index < 2; index++) {
+        packet_count[index] = LIBSPDM_TEST_MCTP_MAX_PACKET_COUNT;
+        status = libspdm_mctp_packetize_message(
+            LIBSPDM_TEST_MCTP_DESTINATION_ID, LIBSPDM_TEST_MCTP_SOURCE_ID,
+            (uint8_t)index, 96, LIBSPDM_TEST_MCTP_MESSAGE_SIZE,
+            m_libspdm_test_mctp_message[index], &packet_count[index], packet[index]);
+        assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+        assert_int_equal(packet_count[index], 3);
+    }
+
+    for (index = 0; index < 3; index++) {
+        status = libspdm_test_mctp_reassemble(&packet[1][index], &message_size[1], &message[1]);
+        assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+        status = libspdm_test_mctp_reassemble(&packet[0][index], &message_size[0], &message[0]);
+        assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+        if (index < 2) {
+            assert_null(message[0]);
+            assert_null(message[1]);
+        }
+    }
+
+    for (index = 0; index < 2; index++) {
+        assert_int_equal(message_size[index], LIBSPDM_TEST_MCTP_MESSAGE_SIZE);
+        assert_memory_equal(message[index], m_libspdm_test_mctp_message[index],
+                            LIBSPDM_TEST_MCTP_MESSAGE_SIZE);
+    }
+    assert_ptr_not_equal(message[0], message[1]);
+
+    /* Both slots are held until the messages are released. */
+    status = libspdm_test_mctp_reassemble(&packet[0][0], &message_size[0], &message[0]);
+    assert_int_equal(status, LIBSPDM_STATUS_BUFFER_FULL);
+    libspdm_mctp_release_reassembled_message(&m_libspdm_test_mctp_reassembler, message[1]);
+    status = libspdm_test_mctp_reassemble(&packet[0][0], &message_size[0], &message[0]);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+}
+
+/**
+ * Test 4: a lost packet, a packet without SOM, an oversized message and a restarted message.
+ **/
+static void libspdm_test_mctp_reassemble_case4(void **state)
+{
+    libspdm_mctp_packet_t packet[LIBSPDM_TEST_MCTP_MAX_PACKET_COUNT];
+    libspdm_mctp_packet_t large_packet[LIBSPDM_TEST_MCTP_MAX_PACKET_COUNT];
+    uint8_t large_message[LIBSPDM_TEST_MCTP_SLOT_SIZE + 1];
+    size_t packet_count;
+    size_t large_packet_count;
+    libspdm_return_t status;
+    size_t message_size;
+    void *message;
+    size_t index;
+
+    libspdm_test_mctp_init_message();
+    status = libspdm_mctp_init_reassembler(&m_libspdm_test_mctp_reassembler,
+                                           MCTP_BASELINE_TRANSMISSION_UNIT,
+                                           m_libspdm_test_mctp_slot,
+                                           LIBSPDM_TEST_MCTP_SLOT_COUNT,
+                                           m_libspdm_test_mctp_slot_buffer,
+                                           sizeof(m_libspdm_test_mctp_slot_buffer));
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+
+    packet_count = LIBSPDM_TEST_MCTP_MAX_PACKET_COUNT;
+    status = libspdm_mctp_packetize_message(
+        LIBSPDM_TEST_MCTP_DESTINATION_ID, LIBSPDM_TEST_MCTP_SOURCE_ID, 5,
+        MCTP_BASELINE_TRANSMISSION_UNIT, LIBSPDM_TEST_MCTP_MESSAGE_SIZE,
+        m_libspdm_test_mctp_message[0], &packet_count, packet);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+
+    /* The second packet is lost: the third one drops the message. */
+    status = libspdm_test_mctp_reassemble(&packet[0], &message_size, &message);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    status = libspdm_test_mctp_reassemble(&packet[2], &message_size, &message);
+    assert_int_equal(status, LIBSPDM_STATUS_INVALID_MSG_FIELD);
+    status = libspdm_test_mctp_reassemble(&packet[3], &message_size, &message);
+    assert_int_equal(status, LIBSPDM_STATUS_INVALID_STATE_PEER);
+
+    /* A new SOM restarts a partial message with the same tag. */
+    status = libspdm_test_mctp_reassemble(&packet[0], &message_size, &message);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    status = libspdm_test_mctp_reassemble(&packet[1], &message_size, &message);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    for (index = 0; index < packet_count; index++) {
+        status = libspdm_test_mctp_reassemble(&packet[index], &message_size, &message);
+        assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    }
+    assert_int_equal(message_size, LIBSPDM_TEST_MCTP_MESSAGE_SIZE);
+    assert_memory_equal(message, m_libspdm_test_mctp_message[0], LIBSPDM_TEST_MCTP_MESSAGE_SIZE);
+    libspdm_mctp_release_reassembled_message(&m_libspdm_test_mctp_reassembler, message);
+
+    /* A message larger than a slot is dropped. */
+    memset(large_message, 0x5A, sizeof(large_message));
+    large_packet_count = LIBSPDM_TEST_MCTP_MAX_PACKET_COUNT;
+    status = libspdm_mctp_packetize_message(
+        LIBSPDM_TEST_MCTP_DESTINATION_ID, LIBSPDM_TEST_MCTP_SOURCE_ID, 6,
+        MCTP_BASELINE_TRANSMISSION_UNIT, sizeof(large_message), large_message,
+        &large_packet_count, large_packet);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    for (index = 0; index < large_packet_count - 1; index++) {
+        status = libspdm_test_mctp_reassemble(&large_packet[index], &message_size, &message);
+        assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    }
+    status = libspdm_test_mctp_reassemble(&large_packet[index], &message_size, &message);
+    assert_int_equal(status, LIBSPDM_STATUS_BUFFER_TOO_SMALL);
+    assert_null(message);
+
+    /* A middle packet shorter than the first one is dropped. */
+    status = libspdm_test_mctp_reassemble(&packet[0], &message_size, &message);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    packet[1].payload_size--;
+    status = libspdm_test_mctp_reassemble(&packet[1], &message_size, &message);
+    assert_int_equal(status, LIBSPDM_STATUS_INVALID_MSG_SIZE);
+}
+
+int libspdm_common_mctp_packet_test_main(void)
+{
+    const struct CMUnitTest spdm_common_mctp_packet_tests[] = {
+        cmocka_unit_test(libspdm_test_mctp_packetize_case1),
+        cmocka_unit_test(libspdm_test_mctp_packetize_case2),
+        cmocka_unit_test(libspdm_test_mctp_reassemble_case3),
+        cmocka_unit_test(libspdm_test_mctp_reassemble_case4),
+    };
+
+    return cmocka_run_group_tests(spdm_common_mctp_packet_tests, NULL, NULL);
+}
@@ -0,0 +1,327 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2021-2022 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+#include "spdm_unit_test.h"
+#include "library/spdm_transport_mctp_lib.h"
+#include "library/spdm_transport_pcidoe_lib.h"
+#include "industry_standard/mctp.h"
+#include "industry_standard/pcidoe.h"
+
+#define LIBSPDM_TEST_SECURED_TRANSPORT_BUFFER_SIZE 0x200
+#define LIBSPDM_TEST_SECURED_TRANSPORT_MESSAGE_SIZE 0x30
+#define LIBSPDM_TEST_SECURED_TRANSPORT_SESSION_ID 0xFFFFFFFF
+
+/* A transport under test, and the headers it places around the secured message. */
+typedef struct {
+    libspdm_transport_encode_message_func encode_message;
+    libspdm_transport_decode_message_func decode_message;
+    libspdm_transport_get_header_size_func get_header_size;
+    libspdm_secured_message_callbacks_t secured_message_callbacks;
+    /* Transport header in front of the secured message. */
+    size_t header_size;
+    /* APP header in front of the SPDM message inside the secured message. */
+    size_t app_header_size;
+} libspdm_test_secured_transport_t;
+
+static const libspdm_test_secured_transport_t m_libspdm_test_mctp_transport = {
+    libspdm_transport_mctp_encode_message,
+    libspdm_transport_mctp_decode_message,
+    libspdm_transport_mctp_get_header_size,
+    {
+        LIBSPDM_SECURED_MESSAGE_CALLBACKS_VERSION,
+        libspdm_mctp_get_sequence_number,
+        libspdm_mctp_get_max_random_number_count,
+        libspdm_mctp_get_secured_spdm_version,
+    },
+    sizeof(mctp_message_header_t),
+    sizeof(mctp_message_header_t),
+};
+
+static const libspdm_test_secured_transport_t m_libspdm_test_pci_doe_transport = {
+    libspdm_transport_pci_doe_encode_message,
+    libspdm_transport_pci_doe_decode_message,
+    libspdm_transport_pci_doe_get_header_size,
+    {
+        LIBSPDM_SECURED_MESSAGE_CALLBACKS_VERSION,
+        libspdm_pci_doe_get_sequence_number,
+        libspdm_pci_doe_get_max_random_number_count,
+        libspdm_pci_doe_get_secured_spdm_version,
+    },
+    sizeof(pci_doe_data_object_header_t),
+    0,
+};
+
+static uint8_t m_libspdm_test_secured_transport_message[LIBSPDM_TEST_SECURED_TRANSPORT_MESSAGE_SIZE];
+static uint8_t m_libspdm_test_in_place_buffer[LIBSPDM_TEST_SECURED_TRANSPORT_BUFFER_SIZE];
+static uint8_t m_libspdm_test_copy_buffer[LIBSPDM_TEST_SECURED_TRANSPORT_BUFFER_SIZE];
+static uint8_t m_libspdm_test_source_buffer[LIBSPDM_TEST_SECURED_TRANSPORT_BUFFER_SIZE];
+static uint8_t m_libspdm_test_decode_buffer[LIBSPDM_TEST_SECURED_TRANSPORT_BUFFER_SIZE];
+
+/* Establish a session of the given type, and return its secured message context. */
+static libspdm_secured_message_context_t *libspdm_test_secured_transport_init_session(
+    libspdm_context_t *spdm_context, libspdm_session_type_t session_type)
+{
+    libspdm_session_info_t *session_info;
+    uint32_t flags;
+
+    flags = SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
+    if (session_type == LIBSPDM_SESSION_TYPE_ENC_MAC) {
+        flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
+    }
+    spdm_context->connection_info.version = SPDM_MESSAGE_VERSION_12 <<
+                                            SPDM_VERSION_NUMBER_SHIFT_BIT;
+    spdm_context->connection_info.capability.flags &=
+        ~(SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_ENCRYPT_CAP |
+          SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MAC_CAP);
+    spdm_context->connection_info.capability.flags |= flags;
+    spdm_context->local_context.capability.flags &=
+        ~(SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP |
+          SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP);
+    spdm_context->local_context.capability.flags |= flags;
+    spdm_context->connection_info.algorithm.base_hash_algo = m_libspdm_use_hash_algo;
+    spdm_context->connection_info.algorithm.dhe_named_group = m_libspdm_use_dhe_algo;
+    spdm_context->connection_info.algorithm.aead_cipher_suite = m_libspdm_use_aead_algo;
+
+    session_info = &spdm_context->session_info[0];
+    libspdm_session_info_init(spdm_context, session_info,
+                              LIBSPDM_TEST_SECURED_TRANSPORT_SESSION_ID, true);
+    libspdm_secured_message_set_session_state(session_info->secured_message_context,
+                                              LIBSPDM_SESSION_STATE_ESTABLISHED);
+    assert_int_equal(((libspdm_secured_message_context_t *)
+                      session_info->secured_message_context)->session_type, session_type);
+    return session_info->secured_message_context;
+}
+
+/**
+ * Encode the same SPDM request in place in the transport buffer and through a separate source
+ * buffer. Both are checked against the expected position in their transport buffer.
+ * If the secured message has no random padding, both must be equal byte for byte.
+ * Otherwise both must decode to the request.
+ **/
+static void libspdm_test_secured_transport_encode(libspdm_context_t *spdm_context,
+                                                  const libspdm_test_secured_transport_t *transport,
+                                                  libspdm_session_type_t session_type)
+{
+    libspdm_secured_message_context_t *secured_message_context;
+    libspdm_return_t status;
+    uint32_t session_id;
+    uint32_t *decoded_session_id;
+    bool is_app_message;
+    size_t transport_header_size;
+    size_t secured_message_header_size;
+    size_t in_place_message_size;
+    void *in_place_message;
+    size_t copy_message_size;
+    void *copy_message;
+    size_t decoded_message_size;
+    void *decoded_message;
+    size_t index;
+    bool has_random_padding;
+
+    secured_message_context = libspdm_test_secured_transport_init_session(spdm_context,
+                                                                          session_type);
+    session_id = LIBSPDM_TEST_SECURED_TRANSPORT_SESSION_ID;
+    transport_header_size = transport->get_header_size(spdm_context);
+    secured_message_header_size = libspdm_get_secured_message_header_size(
+        secured_message_context, &transport->secured_message_callbacks);
+
+    for (index = 0; index < LIBSPDM_TEST_SECURED_TRANSPORT_MESSAGE_SIZE; index++) {
+        m_libspdm_test_secured_transport_message[index] = (uint8_t)index;
+    }
+    m_libspdm_test_secured_transport_message[0] = SPDM_MESSAGE_VERSION_12;
+    m_libspdm_test_secured_transport_message[1] = SPDM_HEARTBEAT;
+
+    /* In place: the request is built at the transport header size in the transport buffer. */
+    libspdm_zero_mem(m_libspdm_test_in_place_buffer, sizeof(m_libspdm_test_in_place_buffer));
+    libspdm_copy_mem(m_libspdm_test_in_place_buffer + transport_header_size,
+                     sizeof(m_libspdm_test_in_place_buffer) - transport_header_size,
+                     m_libspdm_test_secured_transport_message,
+                     LIBSPDM_TEST_SECURED_TRANSPORT_MESSAGE_SIZE);
+    secured_message_context->application_secret.request_data_sequence_number = 0;
+    in_place_message = m_libspdm_test_in_place_buffer;
+    in_place_message_size = sizeof(m_libspdm_test_in_place_buffer);
+    status = transport->encode_message(
+        spdm_context, &session_id, false, true, LIBSPDM_TEST_SECURED_TRANSPORT_MESSAGE_SIZE,
+        m_libspdm_test_in_place_buffer + transport_header_size,
+        &in_place_message_size, &in_place_message);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    assert_ptr_equal(in_place_message,
+                     m_libspdm_test_in_place_buffer + transport_header_size -
+                     transport->app_header_size - secured_message_header_size -
+                     transport->header_size);
+
+    /* Copy: the request is in a separate buffer, as it was in the scratch buffer. */
+    libspdm_zero_mem(m_libspdm_test_copy_buffer, sizeof(m_libspdm_test_copy_buffer));
+    libspdm_copy_mem(m_libspdm_test_source_buffer + transport_header_size,
+                     sizeof(m_libspdm_test_source_buffer) - transport_header_size,
+                     m_libspdm_test_secured_transport_message,
+                     LIBSPDM_TEST_SECURED_TRANSPORT_MESSAGE_SIZE);
+    secured_message_context->application_secret.request_data_sequence_number = 0;
+    copy_message = m_libspdm_test_copy_buffer;
+    copy_message_size = sizeof(m_libspdm_test_copy_buffer);
+    status = transport->encode_message(
+        spdm_context, &session_id, false, true, LIBSPDM_TEST_SECURED_TRANSPORT_MESSAGE_SIZE,
+        m_libspdm_test_source_buffer + transport_header_size,
+        &copy_message_size, &copy_message);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    assert_ptr_equal(copy_message, m_libspdm_test_copy_buffer);
+
+    has_random_padding = (session_type == LIBSPDM_SESSION_TYPE_ENC_MAC) &&
+                         (transport->secured_message_callbacks.get_max_random_number_count() != 0);
+    if (!has_random_padding) {
+        assert_int_equal(in_place_message_size, copy_message_size);
+        assert_memory_equal(in_place_message, copy_message, copy_message_size);
+        return;
+    }
+
+    /* The random padding differs, but the transport and record headers up to the length,
+     * and the decoded request, do not. */
+    assert_memory_equal(in_place_message, copy_message,
+                        transport->header_size + secured_message_header_size -
+                        sizeof(spdm_secured_message_a_data_header2_t) -
+                        sizeof(spdm_secured_message_cipher_header_t));
+
+    secured_message_context->application_secret.request_data_sequence_number = 0;
+    decoded_message = m_libspdm_test_decode_buffer;
+    decoded_message_size = sizeof(m_libspdm_test_decode_buffer);
+    status = transport->decode_message(spdm_context, &decoded_session_id, &is_app_message, true,
+                                       in_place_message_size, in_place_message,
+                                       &decoded_message_size, &decoded_message);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    assert_false(is_app_message);
+    assert_int_equal(decoded_message_size, LIBSPDM_TEST_SECURED_TRANSPORT_MESSAGE_SIZE);
+    assert_memory_equal(decoded_message, m_libspdm_test_secured_transport_message,
+                        LIBSPDM_TEST_SECURED_TRANSPORT_MESSAGE_SIZE);
+
+    secured_message_context->application_secret.request_data_sequence_number = 0;
+    decoded_message = m_libspdm_test_decode_buffer;
+    decoded_message_size = sizeof(m_libspdm_test_decode_buffer);
+    status = transport->decode_message(spdm_context, &decoded_session_id, &is_app_message, true,
+                                       copy_message_size, copy_message,
+                                       &decoded_message_size, &decoded_message);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    assert_false(is_app_message);
+    assert_int_equal(decoded_message_size, LIBSPDM_TEST_SECURED_TRANSPORT_MESSAGE_SIZE);
+    assert_memory_equal(decoded_message, m_libspdm_test_secured_transport_message,
+                        LIBSPDM_TEST_SECURED_TRANSPORT_MESSAGE_SIZE);
+}
+
+/**
+ * Test 1: the secured message header size covers the record header, and the application data
+ * length if the session is encrypted.
+ **/
+static void libspdm_test_secured_message_header_size_case1(void **state)
+{
+    libspdm_test_context_t *spdm_test_context;
+    libspdm_context_t *spdm_context;
+    libspdm_secured_message_context_t *secured_message_context;
+    size_t record_header_size;
+
+    spdm_test_context = *state;
+    spdm_context = spdm_test_context->spdm_context;
+    record_header_size = sizeof(spdm_secured_message_a_data_header1_t) +
+                         sizeof(spdm_secured_message_a_data_header2_t);
+
+    secured_message_context = libspdm_test_secured_transport_init_session(
+        spdm_context, LIBSPDM_SESSION_TYPE_ENC_MAC);
+    assert_int_equal(libspdm_get_secured_message_header_size(
+                         secured_message_context,
+                         &m_libspdm_test_mctp_transport.secured_message_callbacks),
+                     record_header_size + LIBSPDM_MCTP_SEQUENCE_NUMBER_COUNT +
+                     sizeof(spdm_secured_message_cipher_header_t));
+    assert_int_equal(libspdm_get_secured_message_header_size(
+                         secured_message_context,
+                         &m_libspdm_test_pci_doe_transport.secured_message_callbacks),
+                     record_header_size + LIBSPDM_PCI_DOE_SEQUENCE_NUMBER_COUNT +
+                     sizeof(spdm_secured_message_cipher_header_t));
+
+    secured_message_context = libspdm_test_secured_transport_init_session(
+        spdm_context, LIBSPDM_SESSION_TYPE_MAC_ONLY);
+    assert_int_equal(libspdm_get_secured_message_header_size(
+                         secured_message_context,
+                         &m_libspdm_test_mctp_transport.secured_message_callbacks),
+                     record_header_size + LIBSPDM_MCTP_SEQUENCE_NUMBER_COUNT);
+    assert_int_equal(libspdm_get_secured_message_header_size(
+                         secured_message_context,
+                         &m_libspdm_test_pci_doe_transport.secured_message_callbacks),
+                     record_header_size + LIBSPDM_PCI_DOE_SEQUENCE_NUMBER_COUNT);
+}
+
+/**
+ * Test 2: an MCTP request in an encrypted session is encoded in place.
+ **/
+static void libspdm_test_secured_transport_mctp_enc_mac_case2(void **state)
+{
+    libspdm_test_context_t *spdm_test_context;
+
+    spdm_test_context = *state;
+    libspdm_test_secured_transport_encode(spdm_test_context->spdm_context,
+                                          &m_libspdm_test_mctp_transport,
+                                          LIBSPDM_SESSION_TYPE_ENC_MAC);
+}
+
+/**
+ * Test 3: an MCTP request in a MAC only session is encoded in place.
+ **/
+static void libspdm_test_secured_transport_mctp_mac_only_case3(void **state)
+{
+    libspdm_test_context_t *spdm_test_context;
+
+    spdm_test_context = *state;
+    libspdm_test_secured_transport_encode(spdm_test_context->spdm_context,
+                                          &m_libspdm_test_mctp_transport,
+                                          LIBSPDM_SESSION_TYPE_MAC_ONLY);
+}
+
+/**
+ * Test 4: a PCI DOE request in an encrypted session is encoded in place.
+ **/
+static void libspdm_test_secured_transport_pci_doe_enc_mac_case4(void **state)
+{
+    libspdm_test_context_t *spdm_test_context;
+
+    spdm_test_context = *state;
+    libspdm_test_secured_transport_encode(spdm_test_context->spdm_context,
+                                          &m_libspdm_test_pci_doe_transport,
+                                          LIBSPDM_SESSION_TYPE_ENC_MAC);
+}
+
+/**
+ * Test 5: a PCI DOE request in a MAC only session is encoded in place.
+ **/
+static void libspdm_test_secured_transport_pci_doe_mac_only_case5(void **state)
+{
+    libspdm_test_context_t *spdm_test_context;
+
+    spdm_test_context = *state;
+    libspdm_test_secured_transport_encode(spdm_test_context->spdm_context,
+                                          &m_libspdm_test_pci_doe_transport,
+                                          LIBSPDM_SESSION_TYPE_MAC_ONLY);
+}
+
+static libspdm_test_context_t m_libspdm_common_secured_transport_test_context = {
+    LIBSPDM_TEST_CONTEXT_VERSION,
+    true,
+    NULL,
+    NULL,
+};
+
+int libspdm_common_secured_transport_test_main(void)
+{
+    const struct CMUnitTest spdm_common_secured_transport_tests[] = {
+        cmocka_unit_test(libspdm_test_secured_message_header_size_case1),
+        cmocka_unit_test(libspdm_test_secured_transport_mctp_enc_mac_case2),
+        cmocka_unit_test(libspdm_test_secured_transport_mctp_mac_only_case3),
+        cmocka_unit_test(libspdm_test_secured_transport_pci_doe_enc_mac_case4),
+        cmocka_unit_test(libspdm_test_secured_transport_pci_doe_mac_only_case5),
+    };
+
+    libspdm_setup_test_context(&m_libspdm_common_secured_transport_test_context);
+
+    return cmocka_run_group_tests(spdm_common_secured_transport_tests,
+                                  libspdm_unit_test_group_setup,
+                                  libspdm_unit_test_group_teardown);
+}
@@ -0,0 +1,237 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2021-2022 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+#include "spdm_unit_test.h"
+#include "library/spdm_transport_tcp_lib.h"
+#include "industry_standard/spdm_tcp_binding.h"
+
+#define LIBSPDM_TEST_TCP_BUFFER_SIZE 0x200
+#define LIBSPDM_TEST_TCP_STREAM_BUFFER_SIZE 0x180
+
+static uint8_t m_libspdm_test_tcp_buffer[LIBSPDM_TEST_TCP_BUFFER_SIZE];
+static uint8_t m_libspdm_test_tcp_stream_buffer[LIBSPDM_TEST_TCP_STREAM_BUFFER_SIZE];
+
+/* Write a transport message of payload_size bytes with a payload of fill bytes. */
+static size_t libspdm_test_tcp_build_message(uint8_t *buffer, uint16_t payload_size,
+                                             uint8_t fill)
+{
+    spdm_tcp_binding_header_t *tcp_header;
+
+    tcp_header = (void *)buffer;
+    tcp_header->payload_length = payload_size;
+    tcp_header->binding_version = SPDM_TCP_BINDING_VERSION;
+    tcp_header->message_type = SPDM_TCP_MESSAGE_TYPE_OUT_OF_SESSION;
+    memset(tcp_header + 1, fill, payload_size);
+    return sizeof(spdm_tcp_binding_header_t) + payload_size;
+}
+
+/* Append bytes to a stream as a read from the connection would. */
+static void libspdm_test_tcp_stream_receive(libspdm_tcp_stream_t *stream, const uint8_t *data,
+                                            size_t data_size)
+{
+    size_t space_size;
+    void *space;
+
+    libspdm_tcp_stream_get_free_space(stream, &space_size, &space);
+    assert_true(data_size <= space_size);
+    memcpy(space, data, data_size);
+    libspdm_tcp_stream_append(stream, data_size);
+}
+
+/**
+ * Test 1: an SPDM message is encoded in place behind the TCP binding header, and decoded.
+ **/
+static void libspdm_test_tcp_encode_decode_case1(void **state)
+{
+    libspdm_test_context_t *spdm_test_context;
+    libspdm_context_t *spdm_context;
+    const spdm_tcp_binding_header_t *tcp_header;
+    libspdm_return_t status;
+    uint8_t *message;
+    size_t transport_message_size;
+    void *transport_message;
+    uint32_t *session_id;
+    bool is_app_message;
+    size_t decoded_message_size;
+    void *decoded_message;
+
+    spdm_test_context = *state;
+    spdm_context = spdm_test_context->spdm_context;
+
+    message = m_libspdm_test_tcp_buffer + LIBSPDM_TCP_TRANSPORT_HEADER_SIZE;
+    memset(message, 0x5A, 0x20);
+    transport_message = m_libspdm_test_tcp_buffer;
+    transport_message_size = sizeof(m_libspdm_test_tcp_buffer);
+    status = libspdm_transport_tcp_encode_message(spdm_context, NULL, false, true, 0x20,
+                                                  message, &transport_message_size,
+                                                  &transport_message);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    assert_int_equal(transport_message_size, sizeof(spdm_tcp_binding_header_t) + 0x20);
+    assert_ptr_equal(transport_message, message - sizeof(spdm_tcp_binding_header_t));
+    tcp_header = transport_message;
+    assert_int_equal(tcp_header->payload_length, 0x20);
+    assert_int_equal(tcp_header->binding_version, SPDM_TCP_BINDING_VERSION);
+    assert_int_equal(tcp_header->message_type, SPDM_TCP_MESSAGE_TYPE_OUT_OF_SESSION);
+
+    status = libspdm_transport_tcp_decode_message(spdm_context, &session_id, &is_app_message,
+                                                  false, transport_message_size,
+                                                  transport_message, &decoded_message_size,
+                                                  &decoded_message);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    assert_null(session_id);
+    assert_false(is_app_message);
+    assert_int_equal(decoded_message_size, 0x20);
+    assert_ptr_equal(decoded_message, message);
+}
+
+/**
+ * Test 2: a transport message with a wrong binding version, length or message type is rejected.
+ **/
+static void libspdm_test_tcp_decode_case2(void **state)
+{
+    libspdm_test_context_t *spdm_test_context;
+    libspdm_context_t *spdm_context;
+    spdm_tcp_binding_header_t *tcp_header;
+    libspdm_return_t status;
+    size_t transport_message_size;
+    uint32_t *session_id;
+    bool is_app_message;
+    size_t message_size;
+    void *message;
+
+    spdm_test_context = *state;
+    spdm_context = spdm_test_context->spdm_context;
+    tcp_header = (void *)m_libspdm_test_tcp_buffer;
+
+    transport_message_size = libspdm_test_tcp_build_message(m_libspdm_test_tcp_buffer, 0x10, 0);
+    tcp_header->binding_version = SPDM_TCP_BINDING_VERSION + 1;
+    status = libspdm_transport_tcp_decode_message(spdm_context, &session_id, &is_app_message,
+                                                  false, transport_message_size,
+                                                  m_libspdm_test_tcp_buffer, &message_size,
+                                                  &message);
+    assert_int_equal(status, LIBSPDM_STATUS_INVALID_MSG_FIELD);
+
+    transport_message_size = libspdm_test_tcp_build_message(m_libspdm_test_tcp_buffer, 0x10, 0);
+    status = libspdm_transport_tcp_decode_message(spdm_context, &session_id, &is_app_message,
+                                                  false, transport_message_size - 1,
+                                                  m_libspdm_test_tcp_buffer, &message_size,
+                                                  &message);
+    assert_int_equal(status, LIBSPDM_STATUS_INVALID_MSG_SIZE);
+
+    tcp_header->message_type = 0xFF;
+    status = libspdm_transport_tcp_decode_message(spdm_context, &session_id, &is_app_message,
+                                                  false, transport_message_size,
+                                                  m_libspdm_test_tcp_buffer, &message_size,
+                                                  &message);
+    assert_int_equal(status, LIBSPDM_STATUS_UNSUPPORTED_CAP);
+}
+
+/**
+ * Test 3: messages split across reads and several messages in one read are returned one by one.
+ **/
+static void libspdm_test_tcp_stream_case3(void **state)
+{
+    libspdm_tcp_stream_t stream;
+    libspdm_return_t status;
+    size_t first_size;
+    size_t second_size;
+    size_t third_size;
+    size_t message_size;
+    void *message;
+
+    first_size = libspdm_test_tcp_build_message(m_libspdm_test_tcp_buffer, 0x10, 0x11);
+    second_size = libspdm_test_tcp_build_message(m_libspdm_test_tcp_buffer + first_size, 0x100,
+                                                 0x22);
+    third_size = libspdm_test_tcp_build_message(m_libspdm_test_tcp_buffer + first_size +
+                                                second_size, 0x40, 0x33);
+
+    libspdm_tcp_stream_init(&stream, m_libspdm_test_tcp_stream_buffer,
+                            sizeof(m_libspdm_test_tcp_stream_buffer));
+
+    /* A partial header. */
+    libspdm_test_tcp_stream_receive(&stream, m_libspdm_test_tcp_buffer, 3);
+    status = libspdm_tcp_stream_get_message(&stream, &message_size, &message);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    assert_null(message);
+
+    /* The rest of the first message and a part of the second one. */
+    libspdm_test_tcp_stream_receive(&stream, m_libspdm_test_tcp_buffer + 3, first_size + 0x20);
+    status = libspdm_tcp_stream_get_message(&stream, &message_size, &message);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    assert_int_equal(message_size, first_size);
+    assert_memory_equal(message, m_libspdm_test_tcp_buffer, first_size);
+    status = libspdm_tcp_stream_get_message(&stream, &message_size, &message);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    assert_null(message);
+
+    /* The rest of the second message and the whole third one in one read. */
+    libspdm_test_tcp_stream_receive(&stream, m_libspdm_test_tcp_buffer + first_size + 3 + 0x20,
+                                    second_size + third_size - 3 - 0x20);
+    status = libspdm_tcp_stream_get_message(&stream, &message_size, &message);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    assert_int_equal(message_size, second_size);
+    assert_memory_equal(message, m_libspdm_test_tcp_buffer + first_size, second_size);
+    status = libspdm_tcp_stream_get_message(&stream, &message_size, &message);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    assert_int_equal(message_size, third_size);
+    assert_memory_equal(message, m_libspdm_test_tcp_buffer + first_size + second_size,
+                        third_size);
+    status = libspdm_tcp_stream_get_message(&stream, &message_size, &message);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    assert_null(message);
+    assert_int_equal(stream.data_size, 0);
+}
+
+/**
+ * Test 4: a message larger than the stream buffer, or with a wrong binding version, is rejected.
+ **/
+static void libspdm_test_tcp_stream_case4(void **state)
+{
+    libspdm_tcp_stream_t stream;
+    libspdm_return_t status;
+    size_t message_size;
+    void *message;
+
+    libspdm_tcp_stream_init(&stream, m_libspdm_test_tcp_stream_buffer,
+                            sizeof(m_libspdm_test_tcp_stream_buffer));
+    libspdm_test_tcp_build_message(m_libspdm_test_tcp_buffer,
+                                   LIBSPDM_TEST_TCP_STREAM_BUFFER_SIZE, 0);
+    libspdm_test_tcp_stream_receive(&stream, m_libspdm_test_tcp_buffer, 0x10);
+    status = libspdm_tcp_stream_get_message(&stream, &message_size, &message);
+    assert_int_equal(status, LIBSPDM_STATUS_BUFFER_TOO_SMALL);
+    assert_null(message);
+
+    libspdm_tcp_stream_init(&stream, m_libspdm_test_tcp_stream_buffer,
+                            sizeof(m_libspdm_test_tcp_stream_buffer));
+    libspdm_test_tcp_build_message(m_libspdm_test_tcp_buffer, 0x10, 0);
+    m_libspdm_test_tcp_buffer[2] = SPDM_TCP_BINDING_VERSION + 1;
+    libspdm_test_tcp_stream_receive(&stream, m_libspdm_test_tcp_buffer, 0x14);
+    status = libspdm_tcp_stream_get_message(&stream, &message_size, &message);
+    assert_int_equal(status, LIBSPDM_STATUS_INVALID_MSG_FIELD);
+}
+
+static libspdm_test_context_t m_libspdm_common_tcp_transport_test_context = {
+    LIBSPDM_TEST_CONTEXT_VERSION,
+    true,
+    NULL,
+    NULL,
+};
+
+int libspdm_common_tcp_transport_test_main(void)
+{
+    const struct CMUnitTest spdm_common_tcp_transport_tests[] = {
+        cmocka_unit_test(libspdm_test_tcp_encode_decode_case1),
+        cmocka_unit_test(libspdm_test_tcp_decode_case2),
+        cmocka_unit_test(libspdm_test_tcp_stream_case3),
+        cmocka_unit_test(libspdm_test_tcp_stream_case4),
+    };
+
+    libspdm_setup_test_context(&m_libspdm_common_tcp_transport_test_context);
+
+    return cmocka_run_group_tests(spdm_common_tcp_transport_tests,
+                                  libspdm_unit_test_group_setup,
+                                  libspdm_unit_test_group_teardown);
+}
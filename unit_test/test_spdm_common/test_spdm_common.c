@@ -4,8 +4,15 @@
  *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
  **/
 
+#include "spdm_unit_test.h"
 
 extern int libspdm_common_context_data_test_main(void);
+extern int libspdm_common_mctp_packet_test_main(void);
+extern int libspdm_common_tcp_transport_test_main(void);
+extern int libspdm_common_secured_transport_test_main(void);
+#if (LIBSPDM_DEBUG_PRINT_ENABLE) && (LIBSPDM_DEBUG_BINARY_LOG_ENABLE)
+extern int libspdm_common_debug_binary_log_test_main(void);
+#endif /* (LIBSPDM_DEBUG_PRINT_ENABLE) && (LIBSPDM_DEBUG_BINARY_LOG_ENABLE) */
 
 int main(void)
 {
@@ -15,5 +22,23 @@ int main(void)
         return_value = 1;
     }
 
+    if (libspdm_common_mctp_packet_test_main() != 0) {
+        return_value = 1;
+    }
+
+    if (libspdm_common_tcp_transport_test_main() != 0) {
+        return_value = 1;
+    }
+
+    if (libspdm_common_secured_transport_test_main() != 0) {
+        return_value = 1;
+    }
+
+    #if (LIBSPDM_DEBUG_PRINT_ENABLE) && (LIBSPDM_DEBUG_BINARY_LOG_ENABLE)
+    if (libspdm_common_debug_binary_log_test_main() != 0) {
+        return_value = 1;
+    }
+    #endif /* (LIBSPDM_DEBUG_PRINT_ENABLE) && (LIBSPDM_DEBUG_BINARY_LOG_ENABLE) */
+
     return return_value;
 }
@@ -6,6 +6,12 @@
 
 #include "spdm_unit_test.h"
 #include "library/spdm_common_lib.h"
+#include "library/malloclib.h"
+
+#if LIBSPDM_SESSION_PREALLOCATION_SUPPORT && LIBSPDM_STATISTICS_SUPPORT && \
+    LIBSPDM_TEST_OPENSSL_SUPPORT
+#include <openssl/crypto.h>
+#endif
 
 /* https://lapo.it/asn1js/#MCQGCisGAQQBgxyCEgEMFkFDTUU6V0lER0VUOjEyMzQ1Njc4OTA*/
 uint8_t m_libspdm_subject_alt_name_buffer1[] = {
@@ -402,6 +408,190 @@ void libspdm_test_crypt_spdm_x509_certificate_check(void **state)
     }
 }
 
+#if LIBSPDM_PARALLEL_TASK_SUPPORT
+static size_t m_libspdm_dispatched_task_count;
+
+static bool libspdm_test_dispatch_task(void *dispatch_context,
+                                       libspdm_task_func task_func,
+                                       void *task_param_array,
+                                       size_t task_param_size,
+                                       size_t task_count)
+{
+    size_t index;
+
+    /* Run the tasks in reverse order to make sure no ordering is assumed. */
+    for (index = task_count; index > 0; index--) {
+        task_func((uint8_t *)task_param_array + (index - 1) * task_param_size);
+    }
+    m_libspdm_dispatched_task_count += task_count;
+    return true;
+}
+
+void libspdm_test_crypt_spdm_verify_cert_chain_parallel(void **state)
+{
+    bool status;
+    uint8_t *data;
+    size_t data_size;
+    void *hash;
+    size_t hash_size;
+    uint32_t base_hash_algo;
+    uint32_t base_asym_algo;
+
+    base_hash_algo = SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_256;
+    base_asym_algo = SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_ECDSA_ECC_NIST_P256;
+
+    status = libspdm_read_responder_public_certificate_chain(base_hash_algo, base_asym_algo,
+                                                             (void **)&data, &data_size,
+                                                             &hash, &hash_size);
+    assert_true(status);
+
+    /* Serial fallback. */
+    status = libspdm_verify_certificate_chain_buffer_parallel(base_hash_algo, base_asym_algo,
+                                                              data, data_size, false, true,
+                                                              NULL, NULL);
+    assert_true(status);
+
+    /* Every issuer/subject pair is dispatched as its own task. */
+    m_libspdm_dispatched_task_count = 0;
+    status = libspdm_verify_certificate_chain_buffer_parallel(base_hash_algo, base_asym_algo,
+                                                              data, data_size, false, true,
+                                                              libspdm_test_dispatch_task, NULL);
+    assert_true(status);
+    assert_int_not_equal(m_libspdm_dispatched_task_count, 0);
+
+    /* Corrupt the signature of the leaf certificate. */
+    data[data_size - 1] ^= 0xFF;
+    status = libspdm_verify_certificate_chain_buffer_parallel(base_hash_algo, base_asym_algo,
+                                                              data, data_size, false, true,
+                                                              libspdm_test_dispatch_task, NULL);
+    assert_false(status);
+
+    free(data);
+}
+#endif /* LIBSPDM_PARALLEL_TASK_SUPPORT */
+
+#if LIBSPDM_SESSION_PREALLOCATION_SUPPORT && LIBSPDM_STATISTICS_SUPPORT
+#define LIBSPDM_TEST_AEAD_ROUND_COUNT 16
+#define LIBSPDM_TEST_AEAD_MESSAGE_SIZE 256
+
+/* OpenSSL allocates with malloc() unless told otherwise. Its allocations are routed to the pool
+ * functions, so that the malloclib statistics include them. Each buffer records its size for
+ * realloc. */
+#if LIBSPDM_TEST_OPENSSL_SUPPORT
+#define LIBSPDM_TEST_OPENSSL_HEADER_SIZE 16
+
+static void *libspdm_test_openssl_malloc(size_t size, const char *file, int line)
+{
+    uint8_t *buffer;
+
+    buffer = allocate_pool(LIBSPDM_TEST_OPENSSL_HEADER_SIZE + size);
+    if (buffer == NULL) {
+        return NULL;
+    }
+    memcpy(buffer, &size, sizeof(size));
+    return buffer + LIBSPDM_TEST_OPENSSL_HEADER_SIZE;
+}
+
+static void libspdm_test_openssl_free(void *buffer, const char *file, int line)
+{
+    if (buffer != NULL) {
+        free_pool((uint8_t *)buffer - LIBSPDM_TEST_OPENSSL_HEADER_SIZE);
+    }
+}
+
+static void *libspdm_test_openssl_realloc(void *buffer, size_t size, const char *file, int line)
+{
+    uint8_t *new_buffer;
+    size_t old_size;
+
+    if (buffer == NULL) {
+        return libspdm_test_openssl_malloc(size, file, line);
+    }
+    if (size == 0) {
+        libspdm_test_openssl_free(buffer, file, line);
+        return NULL;
+    }
+    new_buffer = libspdm_test_openssl_malloc(size, file, line);
+    if (new_buffer == NULL) {
+        return NULL;
+    }
+    memcpy(&old_size, (uint8_t *)buffer - LIBSPDM_TEST_OPENSSL_HEADER_SIZE, sizeof(old_size));
+    memcpy(new_buffer, buffer, (old_size < size) ? old_size : size);
+    libspdm_test_openssl_free(buffer, file, line);
+    return new_buffer;
+}
+#endif /* LIBSPDM_TEST_OPENSSL_SUPPORT */
+
+/**
+ * Encrypt and decrypt with an AEAD context, and check that no round allocates from the heap.
+ * The first round is not counted, so that a backend may allocate lazily once per context.
+ **/
+static void libspdm_test_crypt_aead_with_context(uint16_t aead_cipher_suite)
+{
+    void *aead_ctx;
+    uint8_t key[LIBSPDM_MAX_AEAD_KEY_SIZE];
+    uint8_t iv[LIBSPDM_MAX_AEAD_IV_SIZE];
+    uint8_t tag[LIBSPDM_MAX_AEAD_TAG_SIZE];
+    uint8_t a_data[16];
+    uint8_t plain_text[LIBSPDM_TEST_AEAD_MESSAGE_SIZE];
+    uint8_t cipher_text[LIBSPDM_TEST_AEAD_MESSAGE_SIZE];
+    uint8_t decrypted_text[LIBSPDM_TEST_AEAD_MESSAGE_SIZE];
+    size_t data_out_size;
+    size_t round;
+    libspdm_malloc_statistics_t statistics;
+    bool status;
+
+    aead_ctx = libspdm_aead_new(aead_cipher_suite);
+    if (aead_ctx == NULL) {
+        /* The AEAD algorithm is not supported by the crypto backend. */
+        return;
+    }
+
+    libspdm_set_mem(key, sizeof(key), 0x11);
+    libspdm_set_mem(iv, sizeof(iv), 0x22);
+    libspdm_set_mem(a_data, sizeof(a_data), 0x33);
+    libspdm_set_mem(plain_text, sizeof(plain_text), 0x44);
+    status = libspdm_aead_set_key(aead_cipher_suite, aead_ctx, key,
+                                  libspdm_get_aead_key_size(aead_cipher_suite));
+    assert_true(status);
+
+    for (round = 0; round <= LIBSPDM_TEST_AEAD_ROUND_COUNT; round++) {
+        if (round == 1) {
+            libspdm_malloc_reset_statistics();
+        }
+        iv[0] = (uint8_t)round;
+
+        data_out_size = sizeof(cipher_text);
+        status = libspdm_aead_encryption_with_context(
+            aead_cipher_suite, aead_ctx, iv, libspdm_get_aead_iv_size(aead_cipher_suite),
+            a_data, sizeof(a_data), plain_text, sizeof(plain_text),
+            tag, libspdm_get_aead_tag_size(aead_cipher_suite), cipher_text, &data_out_size);
+        assert_true(status);
+        assert_int_equal(data_out_size, sizeof(plain_text));
+
+        data_out_size = sizeof(decrypted_text);
+        status = libspdm_aead_decryption_with_context(
+            aead_cipher_suite, aead_ctx, iv, libspdm_get_aead_iv_size(aead_cipher_suite),
+            a_data, sizeof(a_data), cipher_text, sizeof(cipher_text),
+            tag, libspdm_get_aead_tag_size(aead_cipher_suite), decrypted_text, &data_out_size);
+        assert_true(status);
+        assert_int_equal(data_out_size, sizeof(plain_text));
+        assert_memory_equal(decrypted_text, plain_text, sizeof(plain_text));
+    }
+
+    libspdm_malloc_get_statistics(&statistics);
+    libspdm_aead_free(aead_cipher_suite, aead_ctx);
+    assert_int_equal(statistics.allocation_count, 0);
+}
+
+void libspdm_test_crypt_aead_with_context_no_allocation(void **state)
+{
+    libspdm_test_crypt_aead_with_context(SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_128_GCM);
+    libspdm_test_crypt_aead_with_context(SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_256_GCM);
+    libspdm_test_crypt_aead_with_context(SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_CHACHA20_POLY1305);
+}
+#endif /* LIBSPDM_SESSION_PREALLOCATION_SUPPORT && LIBSPDM_STATISTICS_SUPPORT */
+
 int libspdm_crypt_lib_setup(void **state)
 {
     return 0;
@@ -420,7 +610,15 @@ int libspdm_crypt_lib_test_main(void)
 
         cmocka_unit_test(libspdm_test_crypt_spdm_get_dmtf_subject_alt_name),
 
-        cmocka_unit_test(libspdm_test_crypt_spdm_x509_certificate_check)
+        cmocka_unit_test(libspdm_test_crypt_spdm_x509_certificate_check),
+
+#if LIBSPDM_PARALLEL_TASK_SUPPORT
+        cmocka_unit_test(libspdm_test_crypt_spdm_verify_cert_chain_parallel),
+#endif /* LIBSPDM_PARALLEL_TASK_SUPPORT */
+
+#if LIBSPDM_SESSION_PREALLOCATION_SUPPORT && LIBSPDM_STATISTICS_SUPPORT
+        cmocka_unit_test(libspdm_test_crypt_aead_with_context_no_allocation),
+#endif /* LIBSPDM_SESSION_PREALLOCATION_SUPPORT && LIBSPDM_STATISTICS_SUPPORT */
     };
 
     return cmocka_run_group_tests(spdm_crypt_lib_tests,
@@ -432,6 +630,14 @@ int main(void)
 {
     int return_value = 0;
 
+#if LIBSPDM_SESSION_PREALLOCATION_SUPPORT && LIBSPDM_STATISTICS_SUPPORT && \
+    LIBSPDM_TEST_OPENSSL_SUPPORT
+    if (!CRYPTO_set_mem_functions(libspdm_test_openssl_malloc, libspdm_test_openssl_realloc,
+                                  libspdm_test_openssl_free)) {
+        return 1;
+    }
+#endif
+
     if (libspdm_crypt_lib_test_main() != 0) {
         return_value = 1;
     }
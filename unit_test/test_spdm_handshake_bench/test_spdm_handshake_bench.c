@@ -0,0 +1,1309 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2021-2022 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+/*
+ * End-to-end handshake benchmark.
+ *
+ * A requester and a responder run in the same process. The requester device IO hands every
+ * request to libspdm_responder_dispatch_message on the responder context, so each timed call
+ * covers the full requester and responder work, including transport and secured message
+ * encoding, but without any real IO.
+ *
+ * For every combination of base asym, DHE group, AEAD suite and hash, each iteration times:
+ *   init_connection, get_digest, get_certificate, challenge, get_measurement,
+ *   start_session_dhe, start_session_psk and send_receive_data (secured APP messages).
+ * The results are written as JSON with min/mean/p50/p90/p99/max latency in microseconds.
+ *
+ * Run it from the directory holding the sample keys (the build output directory).
+ * The report goes to spdm_handshake_bench.json unless -o is given; "-o -" selects stdout.
+ *
+ * With LIBSPDM_STATISTICS_SUPPORT, every combination also reports a "memory" section: the heap
+ * usage of each operation through the malloclib pool functions, and the peak size of the data in
+ * the sender, receiver and scratch buffer regions of both endpoints against their capacity.
+ *
+ * With LIBSPDM_ALLOC_SCOPE_SUPPORT, the pool allocations of the KEY_EXCHANGE, FINISH,
+ * PSK_EXCHANGE and PSK_FINISH flows of each endpoint are served by an arena, and every combination
+ * reports an "arena" section: the peak arena usage and the allocations served by the heap instead.
+ * The first iteration runs without the arenas, so at least two iterations are needed to use them.
+ * With the openssl crypto, the sample PEM key reader registers its ciphers again in the OpenSSL
+ * name table each time it reads a key, so the flows of the responder leave name entries in its
+ * arena, and they are counted in its leak_count.
+ *
+ * With LIBSPDM_STATISTICS_SUPPORT, "--soak ROUNDS" runs ROUNDS rounds of established-session
+ * traffic (an APP message, HEARTBEAT and both KEY_UPDATE operations) on every DHE session, reports
+ * them in a "soak" section, and fails if an APP message or HEARTBEAT allocates from the heap. The
+ * KEY_UPDATE allocations are reported apart, as the new keys are derived by the HKDF of the crypto
+ * library. With the openssl crypto, the OpenSSL allocations are routed to the malloclib pool
+ * functions, so they are counted. The soak passes with LIBSPDM_SESSION_PREALLOCATION_SUPPORT.
+ *
+ * With LIBSPDM_TRACE_SUPPORT, "--trace FILE" writes the libspdm trace events of both endpoints
+ * to a Chrome trace file, and "--usdt on" fires the libspdm:begin and libspdm:end USDT probes
+ * when the benchmark is built with sys/sdt.h.
+ *
+ * usage: test_spdm_handshake_bench [-n iterations] [-o report.json]
+ *                                  [--asym NAME] [--dhe NAME] [--aead NAME] [--hash NAME]
+ *                                  [--soak rounds] [--trace trace.json] [--usdt on]
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "spdm_bench.h"
+#include "spdm_bench_trace.h"
+#include "hal/base.h"
+#include "library/spdm_requester_lib.h"
+#include "library/spdm_responder_lib.h"
+#include "library/spdm_transport_test_lib.h"
+#include "spdm_device_secret_lib_internal.h"
+#if LIBSPDM_STATISTICS_SUPPORT || LIBSPDM_ALLOC_SCOPE_SUPPORT
+#include "library/malloclib.h"
+#endif /* LIBSPDM_STATISTICS_SUPPORT || LIBSPDM_ALLOC_SCOPE_SUPPORT */
+#if LIBSPDM_STATISTICS_SUPPORT && LIBSPDM_BENCH_OPENSSL_SUPPORT
+#include <openssl/crypto.h>
+#endif /* LIBSPDM_STATISTICS_SUPPORT && LIBSPDM_BENCH_OPENSSL_SUPPORT */
+
+#ifndef LIBSPDM_BENCH_CRYPTO_NAME
+#define LIBSPDM_BENCH_CRYPTO_NAME "unknown"
+#endif
+
+#define LIBSPDM_BENCH_DEFAULT_ITERATIONS 20
+#define LIBSPDM_BENCH_DEFAULT_OUTPUT_FILE "spdm_handshake_bench.json"
+
+/* Secured APP messages sent per session and iteration. */
+#define LIBSPDM_BENCH_SECURED_MESSAGE_COUNT 16
+#define LIBSPDM_BENCH_SECURED_MESSAGE_SIZE 256
+
+/* HEARTBEAT period of the responder, in seconds. */
+#define LIBSPDM_BENCH_HEARTBEAT_PERIOD 10
+
+/* First byte of a benchmark APP message. It must not be a test transport message type. */
+#define LIBSPDM_BENCH_APP_MESSAGE_TYPE 0xFF
+
+#define LIBSPDM_BENCH_SENDER_BUFFER_SIZE (0x1100 + LIBSPDM_TEST_TRANSPORT_ADDITIONAL_SIZE)
+#define LIBSPDM_BENCH_RECEIVER_BUFFER_SIZE (0x1200 + LIBSPDM_TEST_TRANSPORT_ADDITIONAL_SIZE)
+#define LIBSPDM_BENCH_MAX_SPDM_MSG_SIZE 0x1200
+
+/* Size of the allocation arena of each endpoint. */
+#define LIBSPDM_BENCH_ARENA_SIZE 0x10000
+
+typedef struct {
+    uint32_t value;
+    const char *name;
+} libspdm_bench_algo_name_t;
+
+static const libspdm_bench_algo_name_t m_libspdm_bench_base_asym_algo[] = {
+    { SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_RSASSA_2048, "RSASSA_2048" },
+    { SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_RSASSA_3072, "RSASSA_3072" },
+    { SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_RSASSA_4096, "RSASSA_4096" },
+    { SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_RSAPSS_2048, "RSAPSS_2048" },
+    { SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_RSAPSS_3072, "RSAPSS_3072" },
+    { SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_RSAPSS_4096, "RSAPSS_4096" },
+    { SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_ECDSA_ECC_NIST_P256, "ECDSA_P256" },
+    { SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_ECDSA_ECC_NIST_P384, "ECDSA_P384" },
+    { SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_ECDSA_ECC_NIST_P521, "ECDSA_P521" },
+    { SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_SM2_ECC_SM2_P256, "SM2_P256" },
+    { SPDM_ALGORITHMS_BASE_ASYM_ALGO_EDDSA_ED25519, "EDDSA_ED25519" },
+    { SPDM_ALGORITHMS_BASE_ASYM_ALGO_EDDSA_ED448, "EDDSA_ED448" },
+};
+
+static const libspdm_bench_algo_name_t m_libspdm_bench_dhe_named_group[] = {
+    { SPDM_ALGORITHMS_DHE_NAMED_GROUP_FFDHE_2048, "FFDHE_2048" },
+    { SPDM_ALGORITHMS_DHE_NAMED_GROUP_FFDHE_3072, "FFDHE_3072" },
+    { SPDM_ALGORITHMS_DHE_NAMED_GROUP_FFDHE_4096, "FFDHE_4096" },
+    { SPDM_ALGORITHMS_DHE_NAMED_GROUP_SECP_256_R1, "SECP_256_R1" },
+    { SPDM_ALGORITHMS_DHE_NAMED_GROUP_SECP_384_R1, "SECP_384_R1" },
+    { SPDM_ALGORITHMS_DHE_NAMED_GROUP_SECP_521_R1, "SECP_521_R1" },
+    { SPDM_ALGORITHMS_DHE_NAMED_GROUP_SM2_P256, "SM2_P256" },
+};
+
+static const libspdm_bench_algo_name_t m_libspdm_bench_aead_cipher_suite[] = {
+    { SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_128_GCM, "AES_128_GCM" },
+    { SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_256_GCM, "AES_256_GCM" },
+    { SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_CHACHA20_POLY1305, "CHACHA20_POLY1305" },
+    { SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AEAD_SM4_GCM, "SM4_GCM" },
+};
+
+static const libspdm_bench_algo_name_t m_libspdm_bench_base_hash_algo[] = {
+    { SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_256, "SHA_256" },
+    { SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_384, "SHA_384" },
+    { SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_512, "SHA_512" },
+    { SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA3_256, "SHA3_256" },
+    { SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA3_384, "SHA3_384" },
+    { SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA3_512, "SHA3_512" },
+    { SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SM3_256, "SM3_256" },
+};
+
+#define LIBSPDM_BENCH_ARRAY_SIZE(array) (sizeof(array) / sizeof((array)[0]))
+
+typedef struct {
+    uint32_t base_asym_algo;
+    uint16_t dhe_named_group;
+    uint16_t aead_cipher_suite;
+    uint32_t base_hash_algo;
+    uint32_t measurement_hash_algo;
+} libspdm_bench_algo_t;
+
+typedef enum {
+    LIBSPDM_BENCH_OP_INIT_CONNECTION,
+    LIBSPDM_BENCH_OP_GET_DIGEST,
+    LIBSPDM_BENCH_OP_GET_CERTIFICATE,
+    LIBSPDM_BENCH_OP_CHALLENGE,
+    LIBSPDM_BENCH_OP_GET_MEASUREMENT,
+    LIBSPDM_BENCH_OP_START_SESSION_DHE,
+    LIBSPDM_BENCH_OP_START_SESSION_PSK,
+    LIBSPDM_BENCH_OP_SEND_RECEIVE_DATA,
+    LIBSPDM_BENCH_OP_MAX
+} libspdm_bench_op_t;
+
+static const char *m_libspdm_bench_op_name[LIBSPDM_BENCH_OP_MAX] = {
+    "init_connection",
+    "get_digest",
+    "get_certificate",
+    "challenge",
+    "get_measurement",
+    "start_session_dhe",
+    "start_session_psk",
+    "send_receive_data",
+};
+
+typedef struct {
+    void *spdm_context;
+    void *scratch_buffer;
+    size_t scratch_buffer_size;
+    uint8_t sender_buffer[LIBSPDM_BENCH_SENDER_BUFFER_SIZE];
+    uint8_t receiver_buffer[LIBSPDM_BENCH_RECEIVER_BUFFER_SIZE];
+#if LIBSPDM_ALLOC_SCOPE_SUPPORT
+    libspdm_malloc_arena_t arena;
+    /* The arenas bound before the flow and before the persistent allocations of the flow. */
+    libspdm_malloc_arena_t *flow_previous_arena;
+    libspdm_malloc_arena_t *persistent_previous_arena;
+    uint8_t arena_buffer[LIBSPDM_BENCH_ARENA_SIZE];
+#endif /* LIBSPDM_ALLOC_SCOPE_SUPPORT */
+} libspdm_bench_endpoint_t;
+
+static libspdm_bench_endpoint_t m_libspdm_bench_requester;
+static libspdm_bench_endpoint_t m_libspdm_bench_responder;
+
+/* The in-process link: holds the last transport message sent by either side. */
+static uint8_t m_libspdm_bench_link_buffer[LIBSPDM_BENCH_RECEIVER_BUFFER_SIZE];
+static size_t m_libspdm_bench_link_size;
+
+static libspdm_bench_stat_t m_libspdm_bench_stat[LIBSPDM_BENCH_OP_MAX];
+
+#if LIBSPDM_STATISTICS_SUPPORT
+/* Heap usage of an operation, over all its samples. */
+typedef struct {
+    uint64_t allocation_count;
+    uint64_t allocated_bytes;
+    /* Maximum of the bytes allocated during one sample above those allocated before it. */
+    uint64_t peak_bytes;
+} libspdm_bench_heap_t;
+
+static libspdm_bench_heap_t m_libspdm_bench_heap[LIBSPDM_BENCH_OP_MAX];
+
+/* Rounds of established-session traffic run on every DHE session, see --soak. */
+static size_t m_libspdm_bench_soak_rounds;
+/* Heap usage of all the soak rounds of a combination, by the APP messages and HEARTBEAT, and by
+ * the KEY_UPDATE operations. */
+static uint64_t m_libspdm_bench_soak_completed;
+static uint64_t m_libspdm_bench_soak_allocation_count;
+static uint64_t m_libspdm_bench_soak_free_count;
+static uint64_t m_libspdm_bench_soak_key_update_allocation_count;
+static uint64_t m_libspdm_bench_soak_key_update_free_count;
+
+static const char *m_libspdm_bench_buffer_name[LIBSPDM_STATISTICS_BUFFER_MAX] = {
+    "sender",
+    "receiver",
+    "scratch_secure_message",
+    "scratch_large_message",
+    "scratch_sender_receiver",
+    "scratch_large_sender_receiver",
+    "scratch_last_spdm_request",
+    "scratch_cache_spdm_request",
+};
+
+/* Buffer peaks and capacities of the requester (0) and the responder (1). */
+static libspdm_buffer_statistics_t m_libspdm_bench_buffer[2];
+static uint32_t m_libspdm_bench_buffer_capacity[2][LIBSPDM_STATISTICS_BUFFER_MAX];
+#endif /* LIBSPDM_STATISTICS_SUPPORT */
+
+static libspdm_bench_endpoint_t *libspdm_bench_get_endpoint(void *spdm_context)
+{
+    if (spdm_context == m_libspdm_bench_requester.spdm_context) {
+        return &m_libspdm_bench_requester;
+    }
+    return &m_libspdm_bench_responder;
+}
+
+static libspdm_return_t libspdm_bench_acquire_sender_buffer(void *spdm_context,
+                                                            void **msg_buf_ptr)
+{
+    *msg_buf_ptr = libspdm_bench_get_endpoint(spdm_context)->sender_buffer;
+    return LIBSPDM_STATUS_SUCCESS;
+}
+
+static void libspdm_bench_release_sender_buffer(void *spdm_context, const void *msg_buf_ptr)
+{
+}
+
+static libspdm_return_t libspdm_bench_acquire_receiver_buffer(void *spdm_context,
+                                                              void **msg_buf_ptr)
+{
+    *msg_buf_ptr = libspdm_bench_get_endpoint(spdm_context)->receiver_buffer;
+    return LIBSPDM_STATUS_SUCCESS;
+}
+
+static void libspdm_bench_release_receiver_buffer(void *spdm_context, const void *msg_buf_ptr)
+{
+}
+
+static libspdm_return_t libspdm_bench_link_send(size_t message_size, const void *message)
+{
+    if (message_size > sizeof(m_libspdm_bench_link_buffer)) {
+        return LIBSPDM_STATUS_SEND_FAIL;
+    }
+    memcpy(m_libspdm_bench_link_buffer, message, message_size);
+    m_libspdm_bench_link_size = message_size;
+    return LIBSPDM_STATUS_SUCCESS;
+}
+
+static libspdm_return_t libspdm_bench_link_receive(size_t *message_size, void **message)
+{
+    if ((m_libspdm_bench_link_size == 0) || (m_libspdm_bench_link_size > *message_size)) {
+        return LIBSPDM_STATUS_RECEIVE_FAIL;
+    }
+    memcpy(*message, m_libspdm_bench_link_buffer, m_libspdm_bench_link_size);
+    *message_size = m_libspdm_bench_link_size;
+    m_libspdm_bench_link_size = 0;
+    return LIBSPDM_STATUS_SUCCESS;
+}
+
+/* Requester side: sending a request runs the responder synchronously. */
+static libspdm_return_t libspdm_bench_requester_send_message(void *spdm_context,
+                                                             size_t message_size,
+                                                             const void *message,
+                                                             uint64_t timeout)
+{
+    libspdm_return_t status;
+
+    status = libspdm_bench_link_send(message_size, message);
+    if (LIBSPDM_STATUS_IS_ERROR(status)) {
+        return status;
+    }
+    return libspdm_responder_dispatch_message(m_libspdm_bench_responder.spdm_context);
+}
+
+static libspdm_return_t libspdm_bench_requester_receive_message(void *spdm_context,
+                                                                size_t *message_size,
+                                                                void **message,
+                                                                uint64_t timeout)
+{
+    return libspdm_bench_link_receive(message_size, message);
+}
+
+static libspdm_return_t libspdm_bench_responder_send_message(void *spdm_context,
+                                                             size_t message_size,
+                                                             const void *message,
+                                                             uint64_t timeout)
+{
+    return libspdm_bench_link_send(message_size, message);
+}
+
+static libspdm_return_t libspdm_bench_responder_receive_message(void *spdm_context,
+                                                                size_t *message_size,
+                                                                void **message,
+                                                                uint64_t timeout)
+{
+    return libspdm_bench_link_receive(message_size, message);
+}
+
+/* Responder APP message handler: echo the request. */
+static libspdm_return_t libspdm_bench_get_response(
+    void *spdm_context, const uint32_t *session_id, bool is_app_message,
+    size_t request_size, const void *request, size_t *response_size,
+    void *response)
+{
+    if (!is_app_message || (session_id == NULL) || (*response_size < request_size)) {
+        return LIBSPDM_STATUS_UNSUPPORTED_CAP;
+    }
+    memcpy(response, request, request_size);
+    *response_size = request_size;
+    return LIBSPDM_STATUS_SUCCESS;
+}
+
+static uint32_t libspdm_bench_get_measurement_hash_algo(uint32_t base_hash_algo)
+{
+    switch (base_hash_algo) {
+    case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_256:
+        return SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_TPM_ALG_SHA_256;
+    case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_384:
+        return SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_TPM_ALG_SHA_384;
+    case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_512:
+        return SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_TPM_ALG_SHA_512;
+    case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA3_256:
+        return SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_TPM_ALG_SHA3_256;
+    case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA3_384:
+        return SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_TPM_ALG_SHA3_384;
+    case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA3_512:
+        return SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_TPM_ALG_SHA3_512;
+    case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SM3_256:
+        return SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_TPM_ALG_SM3_256;
+    default:
+        return 0;
+    }
+}
+
+static libspdm_return_t libspdm_bench_set_algo(void *spdm_context,
+                                               const libspdm_bench_algo_t *algo,
+                                               uint32_t capability_flags)
+{
+    libspdm_data_parameter_t parameter;
+    libspdm_return_t status;
+    uint8_t data8;
+    uint16_t data16;
+    uint32_t data32;
+
+    libspdm_zero_mem(&parameter, sizeof(parameter));
+    parameter.location = LIBSPDM_DATA_LOCATION_LOCAL;
+
+    data32 = capability_flags;
+    status = libspdm_set_data(spdm_context, LIBSPDM_DATA_CAPABILITY_FLAGS, &parameter,
+                              &data32, sizeof(data32));
+    if (LIBSPDM_STATUS_IS_ERROR(status)) {
+        return status;
+    }
+    data8 = 0;
+    libspdm_set_data(spdm_context, LIBSPDM_DATA_CAPABILITY_CT_EXPONENT, &parameter,
+                     &data8, sizeof(data8));
+    data8 = SPDM_MEASUREMENT_BLOCK_HEADER_SPECIFICATION_DMTF;
+    libspdm_set_data(spdm_context, LIBSPDM_DATA_MEASUREMENT_SPEC, &parameter,
+                     &data8, sizeof(data8));
+    data32 = algo->measurement_hash_algo;
+    libspdm_set_data(spdm_context, LIBSPDM_DATA_MEASUREMENT_HASH_ALGO, &parameter,
+                     &data32, sizeof(data32));
+    data32 = algo->base_asym_algo;
+    libspdm_set_data(spdm_context, LIBSPDM_DATA_BASE_ASYM_ALGO, &parameter,
+                     &data32, sizeof(data32));
+    data32 = algo->base_hash_algo;
+    libspdm_set_data(spdm_context, LIBSPDM_DATA_BASE_HASH_ALGO, &parameter,
+                     &data32, sizeof(data32));
+    data16 = algo->dhe_named_group;
+    libspdm_set_data(spdm_context, LIBSPDM_DATA_DHE_NAME_GROUP, &parameter,
+                     &data16, sizeof(data16));
+    data16 = algo->aead_cipher_suite;
+    libspdm_set_data(spdm_context, LIBSPDM_DATA_AEAD_CIPHER_SUITE, &parameter,
+                     &data16, sizeof(data16));
+    data16 = SPDM_ALGORITHMS_KEY_SCHEDULE_HMAC_HASH;
+    libspdm_set_data(spdm_context, LIBSPDM_DATA_KEY_SCHEDULE, &parameter,
+                     &data16, sizeof(data16));
+    data8 = SPDM_ALGORITHMS_OPAQUE_DATA_FORMAT_1;
+    libspdm_set_data(spdm_context, LIBSPDM_DATA_OTHER_PARAMS_SUPPORT, &parameter,
+                     &data8, sizeof(data8));
+
+    return LIBSPDM_STATUS_SUCCESS;
+}
+
+static void libspdm_bench_register_transport(void *spdm_context)
+{
+    libspdm_register_transport_layer_func(spdm_context,
+                                          LIBSPDM_BENCH_MAX_SPDM_MSG_SIZE,
+                                          LIBSPDM_TEST_TRANSPORT_ADDITIONAL_SIZE,
+                                          libspdm_transport_test_encode_message,
+                                          libspdm_transport_test_decode_message,
+                                          libspdm_transport_test_get_header_size);
+    libspdm_register_device_buffer_func(spdm_context,
+                                        LIBSPDM_BENCH_SENDER_BUFFER_SIZE,
+                                        LIBSPDM_BENCH_RECEIVER_BUFFER_SIZE,
+                                        libspdm_bench_acquire_sender_buffer,
+                                        libspdm_bench_release_sender_buffer,
+                                        libspdm_bench_acquire_receiver_buffer,
+                                        libspdm_bench_release_receiver_buffer);
+}
+
+#if LIBSPDM_ALLOC_SCOPE_SUPPORT
+/* The first iteration of a combination runs without the arenas, so that the process-wide caches
+ * of the crypto library are filled from the heap. */
+static bool m_libspdm_bench_arena_enabled;
+
+static void libspdm_bench_alloc_scope(void *spdm_context, libspdm_alloc_scope_t scope,
+                                      uint8_t request_code)
+{
+    libspdm_bench_endpoint_t *endpoint;
+
+    endpoint = libspdm_bench_get_endpoint(spdm_context);
+    switch (scope) {
+    case LIBSPDM_ALLOC_SCOPE_FLOW_BEGIN:
+        if (m_libspdm_bench_arena_enabled) {
+            endpoint->flow_previous_arena = libspdm_malloc_arena_bind(&endpoint->arena);
+        }
+        break;
+    case LIBSPDM_ALLOC_SCOPE_FLOW_END:
+        if (m_libspdm_bench_arena_enabled) {
+            libspdm_malloc_arena_bind(endpoint->flow_previous_arena);
+            libspdm_malloc_arena_release(&endpoint->arena);
+        }
+        break;
+    case LIBSPDM_ALLOC_SCOPE_PERSISTENT_BEGIN:
+        endpoint->persistent_previous_arena = libspdm_malloc_arena_bind(NULL);
+        break;
+    case LIBSPDM_ALLOC_SCOPE_PERSISTENT_END:
+        libspdm_malloc_arena_bind(endpoint->persistent_previous_arena);
+        break;
+    default:
+        break;
+    }
+}
+#endif /* LIBSPDM_ALLOC_SCOPE_SUPPORT */
+
+static libspdm_return_t libspdm_bench_init_endpoint(libspdm_bench_endpoint_t *endpoint,
+                                                    bool is_requester)
+{
+    libspdm_return_t status;
+
+    status = libspdm_init_context(endpoint->spdm_context);
+    if (LIBSPDM_STATUS_IS_ERROR(status)) {
+        return status;
+    }
+
+    if (is_requester) {
+        libspdm_register_device_io_func(endpoint->spdm_context,
+                                        libspdm_bench_requester_send_message,
+                                        libspdm_bench_requester_receive_message);
+    } else {
+        libspdm_register_device_io_func(endpoint->spdm_context,
+                                        libspdm_bench_responder_send_message,
+                                        libspdm_bench_responder_receive_message);
+        libspdm_register_get_response_func(endpoint->spdm_context,
+                                           libspdm_bench_get_response);
+    }
+    libspdm_bench_register_transport(endpoint->spdm_context);
+    libspdm_set_scratch_buffer(endpoint->spdm_context, endpoint->scratch_buffer,
+                               endpoint->scratch_buffer_size);
+#if LIBSPDM_TRACE_SUPPORT
+    libspdm_bench_trace_register(endpoint->spdm_context,
+                                 is_requester ? "requester" : "responder");
+#endif /* LIBSPDM_TRACE_SUPPORT */
+#if LIBSPDM_ALLOC_SCOPE_SUPPORT
+    libspdm_register_alloc_scope_func(endpoint->spdm_context, libspdm_bench_alloc_scope);
+#endif /* LIBSPDM_ALLOC_SCOPE_SUPPORT */
+
+    return LIBSPDM_STATUS_SUCCESS;
+}
+
+/* Certificate material of one combination, read once and shared by all iterations. */
+typedef struct {
+    void *cert_chain;
+    size_t cert_chain_size;
+    void *root_cert_chain;
+    uint8_t *root_cert;
+    size_t root_cert_size;
+} libspdm_bench_cert_t;
+
+static bool libspdm_bench_read_cert(const libspdm_bench_algo_t *algo,
+                                    libspdm_bench_cert_t *cert)
+{
+    size_t root_cert_chain_size;
+    const uint8_t *root_cert;
+    void *root_hash;
+    size_t root_hash_size;
+
+    libspdm_zero_mem(cert, sizeof(*cert));
+
+    if (!libspdm_read_responder_public_certificate_chain(algo->base_hash_algo,
+                                                         algo->base_asym_algo,
+                                                         &cert->cert_chain,
+                                                         &cert->cert_chain_size,
+                                                         NULL, NULL)) {
+        return false;
+    }
+    if (!libspdm_read_responder_root_public_certificate(algo->base_hash_algo,
+                                                        algo->base_asym_algo,
+                                                        &cert->root_cert_chain,
+                                                        &root_cert_chain_size,
+                                                        &root_hash, &root_hash_size)) {
+        return false;
+    }
+    if (!libspdm_x509_get_cert_from_cert_chain(
+            (uint8_t *)cert->root_cert_chain + sizeof(spdm_cert_chain_t) + root_hash_size,
+            root_cert_chain_size - sizeof(spdm_cert_chain_t) - root_hash_size, 0,
+            &root_cert, &cert->root_cert_size)) {
+        return false;
+    }
+    /* The root certificate lies inside root_cert_chain. */
+    cert->root_cert = (uint8_t *)cert->root_cert_chain +
+                      (root_cert - (const uint8_t *)cert->root_cert_chain);
+    return true;
+}
+
+static void libspdm_bench_free_cert(libspdm_bench_cert_t *cert)
+{
+    free(cert->cert_chain);
+    free(cert->root_cert_chain);
+    libspdm_zero_mem(cert, sizeof(*cert));
+}
+
+static libspdm_return_t libspdm_bench_setup(const libspdm_bench_algo_t *algo,
+                                            const libspdm_bench_cert_t *cert)
+{
+    libspdm_data_parameter_t parameter;
+    libspdm_return_t status;
+    uint8_t heartbeat_period;
+
+    status = libspdm_bench_init_endpoint(&m_libspdm_bench_responder, false);
+    if (LIBSPDM_STATUS_IS_ERROR(status)) {
+        return status;
+    }
+    status = libspdm_bench_set_algo(
+        m_libspdm_bench_responder.spdm_context, algo,
+        SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP |
+        SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CHAL_CAP |
+        SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP_SIG |
+        SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_FRESH_CAP |
+        SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_ENCRYPT_CAP |
+        SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MAC_CAP |
+        SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP |
+        SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_PSK_CAP_RESPONDER |
+        SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_HBEAT_CAP |
+        SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_UPD_CAP);
+    if (LIBSPDM_STATUS_IS_ERROR(status)) {
+        return status;
+    }
+    libspdm_zero_mem(&parameter, sizeof(parameter));
+    parameter.location = LIBSPDM_DATA_LOCATION_LOCAL;
+    parameter.additional_data[0] = 0;
+    status = libspdm_set_data(m_libspdm_bench_responder.spdm_context,
+                              LIBSPDM_DATA_LOCAL_PUBLIC_CERT_CHAIN, &parameter,
+                              cert->cert_chain, cert->cert_chain_size);
+    if (LIBSPDM_STATUS_IS_ERROR(status)) {
+        return status;
+    }
+    /* Any period allows HEARTBEAT, the benchmark has no timer. */
+    heartbeat_period = LIBSPDM_BENCH_HEARTBEAT_PERIOD;
+    libspdm_set_data(m_libspdm_bench_responder.spdm_context, LIBSPDM_DATA_HEARTBEAT_PERIOD,
+                     &parameter, &heartbeat_period, sizeof(heartbeat_period));
+
+    status = libspdm_bench_init_endpoint(&m_libspdm_bench_requester, true);
+    if (LIBSPDM_STATUS_IS_ERROR(status)) {
+        return status;
+    }
+    status = libspdm_bench_set_algo(
+        m_libspdm_bench_requester.spdm_context, algo,
+        SPDM_GET_CAPABILITIES_REQUEST_FLAGS_CERT_CAP |
+        SPDM_GET_CAPABILITIES_REQUEST_FLAGS_CHAL_CAP |
+        SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP |
+        SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP |
+        SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP |
+        SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP_REQUESTER |
+        SPDM_GET_CAPABILITIES_REQUEST_FLAGS_HBEAT_CAP |
+        SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_UPD_CAP);
+    if (LIBSPDM_STATUS_IS_ERROR(status)) {
+        return status;
+    }
+    libspdm_zero_mem(&parameter, sizeof(parameter));
+    parameter.location = LIBSPDM_DATA_LOCATION_LOCAL;
+    return libspdm_set_data(m_libspdm_bench_requester.spdm_context,
+                            LIBSPDM_DATA_PEER_PUBLIC_ROOT_CERT, &parameter,
+                            cert->root_cert, cert->root_cert_size);
+}
+
+#if LIBSPDM_STATISTICS_SUPPORT
+/* Merge the buffer peaks of an endpoint, before its context is deinitialized. */
+static void libspdm_bench_collect_buffer(size_t endpoint_index, void *spdm_context)
+{
+    static libspdm_statistics_t statistics;
+    libspdm_data_parameter_t parameter;
+    size_t data_size;
+    size_t buffer;
+
+    libspdm_zero_mem(&parameter, sizeof(parameter));
+    parameter.location = LIBSPDM_DATA_LOCATION_LOCAL;
+    data_size = sizeof(statistics);
+    if (libspdm_get_data(spdm_context, LIBSPDM_DATA_STATISTICS, &parameter,
+                         &statistics, &data_size) != LIBSPDM_STATUS_SUCCESS) {
+        return;
+    }
+    for (buffer = 0; buffer < LIBSPDM_STATISTICS_BUFFER_MAX; buffer++) {
+        if (statistics.buffer.peak[buffer] > m_libspdm_bench_buffer[endpoint_index].peak[buffer]) {
+            m_libspdm_bench_buffer[endpoint_index].peak[buffer] = statistics.buffer.peak[buffer];
+        }
+        m_libspdm_bench_buffer_capacity[endpoint_index][buffer] =
+            statistics.buffer_capacity[buffer];
+    }
+}
+#endif /* LIBSPDM_STATISTICS_SUPPORT */
+
+static void libspdm_bench_teardown(void)
+{
+#if LIBSPDM_STATISTICS_SUPPORT
+    libspdm_bench_collect_buffer(0, m_libspdm_bench_requester.spdm_context);
+    libspdm_bench_collect_buffer(1, m_libspdm_bench_responder.spdm_context);
+#endif /* LIBSPDM_STATISTICS_SUPPORT */
+    libspdm_deinit_context(m_libspdm_bench_requester.spdm_context);
+    libspdm_deinit_context(m_libspdm_bench_responder.spdm_context);
+    m_libspdm_bench_link_size = 0;
+}
+
+#if LIBSPDM_STATISTICS_SUPPORT
+static void libspdm_bench_heap_add(libspdm_bench_op_t op, uint64_t start_bytes)
+{
+    libspdm_malloc_statistics_t statistics;
+    libspdm_bench_heap_t *heap;
+
+    libspdm_malloc_get_statistics(&statistics);
+    heap = &m_libspdm_bench_heap[op];
+    heap->allocation_count += statistics.allocation_count;
+    heap->allocated_bytes += statistics.allocated_bytes;
+    if (statistics.peak_bytes - start_bytes > heap->peak_bytes) {
+        heap->peak_bytes = statistics.peak_bytes - start_bytes;
+    }
+}
+
+#define LIBSPDM_BENCH_HEAP_BEGIN(start_bytes) \
+    do { \
+        libspdm_malloc_statistics_t malloc_statistics; \
+        libspdm_malloc_reset_statistics(); \
+        libspdm_malloc_get_statistics(&malloc_statistics); \
+        (start_bytes) = malloc_statistics.current_bytes; \
+    } while (0)
+#define LIBSPDM_BENCH_HEAP_END(op, start_bytes) libspdm_bench_heap_add((op), (start_bytes))
+#else
+#define LIBSPDM_BENCH_HEAP_BEGIN(start_bytes) ((start_bytes) = 0)
+#define LIBSPDM_BENCH_HEAP_END(op, start_bytes) ((void)(start_bytes))
+#endif /* LIBSPDM_STATISTICS_SUPPORT */
+
+#define LIBSPDM_BENCH_TIME(op, call) \
+    do { \
+        double start_us; \
+        uint64_t start_bytes; \
+        LIBSPDM_BENCH_HEAP_BEGIN(start_bytes); \
+        start_us = libspdm_bench_now_us(); \
+        status = (call); \
+        if (LIBSPDM_STATUS_IS_ERROR(status)) { \
+            *failed_op = (op); \
+            return status; \
+        } \
+        libspdm_bench_stat_add(&m_libspdm_bench_stat[(op)], \
+                               libspdm_bench_now_us() - start_us); \
+        LIBSPDM_BENCH_HEAP_END(op, start_bytes); \
+    } while (0)
+
+#if (LIBSPDM_ENABLE_CAPABILITY_KEY_EX_CAP) || (LIBSPDM_ENABLE_CAPABILITY_PSK_EX_CAP)
+static libspdm_return_t libspdm_bench_secured_messages(void *spdm_context, uint32_t session_id,
+                                                       libspdm_bench_op_t *failed_op)
+{
+    libspdm_return_t status;
+    uint8_t request[LIBSPDM_BENCH_SECURED_MESSAGE_SIZE];
+    uint8_t response[LIBSPDM_BENCH_SECURED_MESSAGE_SIZE];
+    size_t response_size;
+    size_t index;
+
+    memset(request, 0x5A, sizeof(request));
+    request[0] = LIBSPDM_BENCH_APP_MESSAGE_TYPE;
+
+    for (index = 0; index < LIBSPDM_BENCH_SECURED_MESSAGE_COUNT; index++) {
+        response_size = sizeof(response);
+        LIBSPDM_BENCH_TIME(LIBSPDM_BENCH_OP_SEND_RECEIVE_DATA,
+                           libspdm_send_receive_data(spdm_context, &session_id, true,
+                                                     request, sizeof(request),
+                                                     response, &response_size));
+        if ((response_size != sizeof(request)) ||
+            (memcmp(request, response, sizeof(request)) != 0)) {
+            *failed_op = LIBSPDM_BENCH_OP_SEND_RECEIVE_DATA;
+            return LIBSPDM_STATUS_INVALID_MSG_FIELD;
+        }
+    }
+    return LIBSPDM_STATUS_SUCCESS;
+}
+#endif /* (LIBSPDM_ENABLE_CAPABILITY_KEY_EX_CAP) || (LIBSPDM_ENABLE_CAPABILITY_PSK_EX_CAP) */
+
+#if LIBSPDM_STATISTICS_SUPPORT && LIBSPDM_ENABLE_CAPABILITY_KEY_EX_CAP
+/* Established-session traffic of the soak run, counting the heap usage of both endpoints. */
+static libspdm_return_t libspdm_bench_soak(void *spdm_context, uint32_t session_id)
+{
+    libspdm_return_t status;
+    libspdm_malloc_statistics_t statistics;
+    uint8_t request[LIBSPDM_BENCH_SECURED_MESSAGE_SIZE];
+    uint8_t response[LIBSPDM_BENCH_SECURED_MESSAGE_SIZE];
+    size_t response_size;
+    size_t round;
+
+    memset(request, 0x5A, sizeof(request));
+    request[0] = LIBSPDM_BENCH_APP_MESSAGE_TYPE;
+
+    status = LIBSPDM_STATUS_SUCCESS;
+    for (round = 0; round < m_libspdm_bench_soak_rounds; round++) {
+        libspdm_malloc_reset_statistics();
+        response_size = sizeof(response);
+        status = libspdm_send_receive_data(spdm_context, &session_id, true,
+                                           request, sizeof(request), response, &response_size);
+        if (LIBSPDM_STATUS_IS_ERROR(status)) {
+            break;
+        }
+        if ((response_size != sizeof(request)) ||
+            (memcmp(request, response, sizeof(request)) != 0)) {
+            status = LIBSPDM_STATUS_INVALID_MSG_FIELD;
+            break;
+        }
+        status = libspdm_heartbeat(spdm_context, session_id);
+        if (LIBSPDM_STATUS_IS_ERROR(status)) {
+            break;
+        }
+        libspdm_malloc_get_statistics(&statistics);
+        m_libspdm_bench_soak_allocation_count += statistics.allocation_count;
+        m_libspdm_bench_soak_free_count += statistics.free_count;
+
+        libspdm_malloc_reset_statistics();
+        status = libspdm_key_update(spdm_context, session_id, true);
+        if (LIBSPDM_STATUS_IS_ERROR(status)) {
+            break;
+        }
+        status = libspdm_key_update(spdm_context, session_id, false);
+        if (LIBSPDM_STATUS_IS_ERROR(status)) {
+            break;
+        }
+        libspdm_malloc_get_statistics(&statistics);
+        m_libspdm_bench_soak_key_update_allocation_count += statistics.allocation_count;
+        m_libspdm_bench_soak_key_update_free_count += statistics.free_count;
+        m_libspdm_bench_soak_completed++;
+    }
+    return status;
+}
+#endif /* LIBSPDM_STATISTICS_SUPPORT && LIBSPDM_ENABLE_CAPABILITY_KEY_EX_CAP */
+
+/* One timed pass over the whole flow, on freshly initialized contexts. */
+static libspdm_return_t libspdm_bench_iteration(libspdm_bench_op_t *failed_op)
+{
+    libspdm_return_t status;
+    void *spdm_context;
+    uint8_t slot_mask;
+    uint8_t total_digest_buffer[LIBSPDM_MAX_HASH_SIZE * SPDM_MAX_SLOT_COUNT];
+    static uint8_t cert_chain[LIBSPDM_MAX_CERT_CHAIN_SIZE];
+    size_t cert_chain_size;
+    uint8_t number_of_blocks;
+    static uint8_t measurement_record[LIBSPDM_MAX_MEASUREMENT_RECORD_SIZE];
+    uint32_t measurement_record_length;
+    uint32_t session_id;
+    uint8_t heartbeat_period;
+
+    spdm_context = m_libspdm_bench_requester.spdm_context;
+
+    LIBSPDM_BENCH_TIME(LIBSPDM_BENCH_OP_INIT_CONNECTION,
+                       libspdm_init_connection(spdm_context, false));
+
+#if LIBSPDM_ENABLE_CAPABILITY_CERT_CAP
+    LIBSPDM_BENCH_TIME(LIBSPDM_BENCH_OP_GET_DIGEST,
+                       libspdm_get_digest(spdm_context, NULL, &slot_mask,
+                                          total_digest_buffer));
+    cert_chain_size = sizeof(cert_chain);
+    LIBSPDM_BENCH_TIME(LIBSPDM_BENCH_OP_GET_CERTIFICATE,
+                       libspdm_get_certificate(spdm_context, NULL, 0,
+                                               &cert_chain_size, cert_chain));
+#endif /* LIBSPDM_ENABLE_CAPABILITY_CERT_CAP */
+
+#if LIBSPDM_ENABLE_CAPABILITY_CHAL_CAP
+    LIBSPDM_BENCH_TIME(LIBSPDM_BENCH_OP_CHALLENGE,
+                       libspdm_challenge(spdm_context, NULL, 0,
+                                         SPDM_CHALLENGE_REQUEST_NO_MEASUREMENT_SUMMARY_HASH,
+                                         NULL, NULL));
+#endif /* LIBSPDM_ENABLE_CAPABILITY_CHAL_CAP */
+
+#if LIBSPDM_ENABLE_CAPABILITY_MEAS_CAP
+    measurement_record_length = sizeof(measurement_record);
+    LIBSPDM_BENCH_TIME(LIBSPDM_BENCH_OP_GET_MEASUREMENT,
+                       libspdm_get_measurement(
+                           spdm_context, NULL,
+                           SPDM_GET_MEASUREMENTS_REQUEST_ATTRIBUTES_GENERATE_SIGNATURE,
+                           SPDM_GET_MEASUREMENTS_REQUEST_MEASUREMENT_OPERATION_ALL_MEASUREMENTS,
+                           0, NULL, &number_of_blocks, &measurement_record_length,
+                           measurement_record));
+#endif /* LIBSPDM_ENABLE_CAPABILITY_MEAS_CAP */
+
+#if LIBSPDM_ENABLE_CAPABILITY_KEY_EX_CAP
+    LIBSPDM_BENCH_TIME(LIBSPDM_BENCH_OP_START_SESSION_DHE,
+                       libspdm_start_session(spdm_context, false, NULL, 0,
+                                             SPDM_KEY_EXCHANGE_REQUEST_NO_MEASUREMENT_SUMMARY_HASH,
+                                             0, 0, &session_id, &heartbeat_period, NULL));
+    status = libspdm_bench_secured_messages(spdm_context, session_id, failed_op);
+    if (LIBSPDM_STATUS_IS_ERROR(status)) {
+        return status;
+    }
+#if LIBSPDM_STATISTICS_SUPPORT
+    status = libspdm_bench_soak(spdm_context, session_id);
+    if (LIBSPDM_STATUS_IS_ERROR(status)) {
+        *failed_op = LIBSPDM_BENCH_OP_START_SESSION_DHE;
+        return status;
+    }
+#endif /* LIBSPDM_STATISTICS_SUPPORT */
+    status = libspdm_stop_session(spdm_context, session_id, 0);
+    if (LIBSPDM_STATUS_IS_ERROR(status)) {
+        *failed_op = LIBSPDM_BENCH_OP_START_SESSION_DHE;
+        return status;
+    }
+#endif /* LIBSPDM_ENABLE_CAPABILITY_KEY_EX_CAP */
+
+#if LIBSPDM_ENABLE_CAPABILITY_PSK_EX_CAP
+    LIBSPDM_BENCH_TIME(LIBSPDM_BENCH_OP_START_SESSION_PSK,
+                       libspdm_start_session(spdm_context, true,
+                                             LIBSPDM_TEST_PSK_HINT_STRING,
+                                             sizeof(LIBSPDM_TEST_PSK_HINT_STRING),
+                                             SPDM_KEY_EXCHANGE_REQUEST_NO_MEASUREMENT_SUMMARY_HASH,
+                                             0, 0, &session_id, &heartbeat_period, NULL));
+    status = libspdm_bench_secured_messages(spdm_context, session_id, failed_op);
+    if (LIBSPDM_STATUS_IS_ERROR(status)) {
+        return status;
+    }
+    status = libspdm_stop_session(spdm_context, session_id, 0);
+    if (LIBSPDM_STATUS_IS_ERROR(status)) {
+        *failed_op = LIBSPDM_BENCH_OP_START_SESSION_PSK;
+        return status;
+    }
+#endif /* LIBSPDM_ENABLE_CAPABILITY_PSK_EX_CAP */
+
+    return LIBSPDM_STATUS_SUCCESS;
+}
+
+#if LIBSPDM_STATISTICS_SUPPORT
+static void libspdm_bench_json_write_memory(FILE *fp)
+{
+    static const char *endpoint_name[2] = { "requester", "responder" };
+    size_t op;
+    size_t endpoint_index;
+    size_t buffer;
+    bool first_op;
+
+    fprintf(fp, ",\n      \"memory\": {\n        \"heap\": {");
+    first_op = true;
+    for (op = 0; op < LIBSPDM_BENCH_OP_MAX; op++) {
+        if (m_libspdm_bench_stat[op].sample_count == 0) {
+            continue;
+        }
+        fprintf(fp, "%s\n          \"%s\": {\"allocation_count\": %.1f, "
+                "\"allocated_bytes\": %.1f, \"peak_bytes\": %llu}",
+                first_op ? "" : ",", m_libspdm_bench_op_name[op],
+                (double)m_libspdm_bench_heap[op].allocation_count /
+                (double)m_libspdm_bench_stat[op].sample_count,
+                (double)m_libspdm_bench_heap[op].allocated_bytes /
+                (double)m_libspdm_bench_stat[op].sample_count,
+                (unsigned long long)m_libspdm_bench_heap[op].peak_bytes);
+        first_op = false;
+    }
+    fprintf(fp, "%s}", first_op ? "" : "\n        ");
+    for (endpoint_index = 0; endpoint_index < 2; endpoint_index++) {
+        fprintf(fp, ",\n        \"%s_buffers\": {", endpoint_name[endpoint_index]);
+        for (buffer = 0; buffer < LIBSPDM_STATISTICS_BUFFER_MAX; buffer++) {
+            fprintf(fp, "%s\n          \"%s\": {\"peak\": %u, \"capacity\": %u}",
+                    (buffer == 0) ? "" : ",", m_libspdm_bench_buffer_name[buffer],
+                    m_libspdm_bench_buffer[endpoint_index].peak[buffer],
+                    m_libspdm_bench_buffer_capacity[endpoint_index][buffer]);
+        }
+        fprintf(fp, "\n        }");
+    }
+    fprintf(fp, "\n      }");
+}
+
+static void libspdm_bench_json_write_soak(FILE *fp)
+{
+    fprintf(fp, ",\n      \"soak\": {\"completed_rounds\": %llu, \"allocation_count\": %llu, "
+            "\"free_count\": %llu, \"key_update_allocation_count\": %llu, "
+            "\"key_update_free_count\": %llu}",
+            (unsigned long long)m_libspdm_bench_soak_completed,
+            (unsigned long long)m_libspdm_bench_soak_allocation_count,
+            (unsigned long long)m_libspdm_bench_soak_free_count,
+            (unsigned long long)m_libspdm_bench_soak_key_update_allocation_count,
+            (unsigned long long)m_libspdm_bench_soak_key_update_free_count);
+}
+
+/* OpenSSL allocates with malloc() unless told otherwise. Its allocations are routed to the pool
+ * functions, so that the heap usage includes them. Each buffer records its size for realloc. */
+#if LIBSPDM_BENCH_OPENSSL_SUPPORT
+#define LIBSPDM_BENCH_OPENSSL_HEADER_SIZE 16
+
+static void *libspdm_bench_openssl_malloc(size_t size, const char *file, int line)
+{
+    uint8_t *buffer;
+
+    buffer = allocate_pool(LIBSPDM_BENCH_OPENSSL_HEADER_SIZE + size);
+    if (buffer == NULL) {
+        return NULL;
+    }
+    memcpy(buffer, &size, sizeof(size));
+    return buffer + LIBSPDM_BENCH_OPENSSL_HEADER_SIZE;
+}
+
+static void libspdm_bench_openssl_free(void *buffer, const char *file, int line)
+{
+    if (buffer != NULL) {
+        free_pool((uint8_t *)buffer - LIBSPDM_BENCH_OPENSSL_HEADER_SIZE);
+    }
+}
+
+static void *libspdm_bench_openssl_realloc(void *buffer, size_t size, const char *file, int line)
+{
+    uint8_t *new_buffer;
+    size_t old_size;
+
+    if (buffer == NULL) {
+        return libspdm_bench_openssl_malloc(size, file, line);
+    }
+    if (size == 0) {
+        libspdm_bench_openssl_free(buffer, file, line);
+        return NULL;
+    }
+    new_buffer = libspdm_bench_openssl_malloc(size, file, line);
+    if (new_buffer == NULL) {
+        return NULL;
+    }
+    memcpy(&old_size, (uint8_t *)buffer - LIBSPDM_BENCH_OPENSSL_HEADER_SIZE, sizeof(old_size));
+    memcpy(new_buffer, buffer, (old_size < size) ? old_size : size);
+    libspdm_bench_openssl_free(buffer, file, line);
+    return new_buffer;
+}
+#endif /* LIBSPDM_BENCH_OPENSSL_SUPPORT */
+#endif /* LIBSPDM_STATISTICS_SUPPORT */
+
+#if LIBSPDM_ALLOC_SCOPE_SUPPORT
+/* The arena is initialized once: buffers of the OpenSSL name table may still be live in it. */
+static void libspdm_bench_reset_arena(libspdm_malloc_arena_t *arena)
+{
+    arena->peak_used = arena->used;
+    arena->fallback_count = 0;
+    arena->leak_count = 0;
+}
+
+static void libspdm_bench_json_write_arena(FILE *fp)
+{
+    static const char *endpoint_name[2] = { "requester", "responder" };
+    const libspdm_malloc_arena_t *arena[2];
+    size_t endpoint_index;
+
+    arena[0] = &m_libspdm_bench_requester.arena;
+    arena[1] = &m_libspdm_bench_responder.arena;
+    fprintf(fp, ",\n      \"arena\": {");
+    for (endpoint_index = 0; endpoint_index < 2; endpoint_index++) {
+        fprintf(fp, "%s\n        \"%s\": {\"peak_used\": %zu, \"size\": %zu, "
+                "\"fallback_count\": %llu, \"leak_count\": %llu}",
+                (endpoint_index == 0) ? "" : ",", endpoint_name[endpoint_index],
+                arena[endpoint_index]->peak_used, arena[endpoint_index]->size,
+                (unsigned long long)arena[endpoint_index]->fallback_count,
+                (unsigned long long)arena[endpoint_index]->leak_count);
+    }
+    fprintf(fp, "\n      }");
+}
+#endif /* LIBSPDM_ALLOC_SCOPE_SUPPORT */
+
+/* Return false if the APP messages or HEARTBEAT of the soak run allocated from the heap. */
+static bool libspdm_bench_run_combination(FILE *fp, bool first, const libspdm_bench_algo_t *algo,
+                                          const char *asym_name, const char *dhe_name,
+                                          const char *aead_name, const char *hash_name,
+                                          size_t iterations)
+{
+    libspdm_bench_cert_t cert;
+    libspdm_return_t status;
+    libspdm_bench_op_t failed_op;
+    size_t iteration;
+    size_t op;
+    bool first_op;
+
+    for (op = 0; op < LIBSPDM_BENCH_OP_MAX; op++) {
+        libspdm_bench_stat_reset(&m_libspdm_bench_stat[op]);
+    }
+#if LIBSPDM_STATISTICS_SUPPORT
+    m_libspdm_bench_soak_completed = 0;
+    m_libspdm_bench_soak_allocation_count = 0;
+    m_libspdm_bench_soak_free_count = 0;
+    m_libspdm_bench_soak_key_update_allocation_count = 0;
+    m_libspdm_bench_soak_key_update_free_count = 0;
+    libspdm_zero_mem(m_libspdm_bench_heap, sizeof(m_libspdm_bench_heap));
+    libspdm_zero_mem(m_libspdm_bench_buffer, sizeof(m_libspdm_bench_buffer));
+    libspdm_zero_mem(m_libspdm_bench_buffer_capacity, sizeof(m_libspdm_bench_buffer_capacity));
+#endif /* LIBSPDM_STATISTICS_SUPPORT */
+#if LIBSPDM_ALLOC_SCOPE_SUPPORT
+    libspdm_bench_reset_arena(&m_libspdm_bench_requester.arena);
+    libspdm_bench_reset_arena(&m_libspdm_bench_responder.arena);
+#endif /* LIBSPDM_ALLOC_SCOPE_SUPPORT */
+
+    status = LIBSPDM_STATUS_SUCCESS;
+    failed_op = LIBSPDM_BENCH_OP_MAX;
+    iteration = 0;
+    if (!libspdm_bench_read_cert(algo, &cert)) {
+        status = LIBSPDM_STATUS_UNSUPPORTED_CAP;
+    } else {
+        for (iteration = 0; iteration < iterations; iteration++) {
+            status = libspdm_bench_setup(algo, &cert);
+            if (LIBSPDM_STATUS_IS_ERROR(status)) {
+                libspdm_bench_teardown();
+                break;
+            }
+#if LIBSPDM_ALLOC_SCOPE_SUPPORT
+            m_libspdm_bench_arena_enabled = (iteration != 0);
+#endif /* LIBSPDM_ALLOC_SCOPE_SUPPORT */
+            status = libspdm_bench_iteration(&failed_op);
+            libspdm_bench_teardown();
+            if (LIBSPDM_STATUS_IS_ERROR(status)) {
+                break;
+            }
+        }
+    }
+    libspdm_bench_free_cert(&cert);
+
+    fprintf(stderr, "%-14s %-12s %-18s %-9s %s\n", asym_name, dhe_name, aead_name, hash_name,
+            LIBSPDM_STATUS_IS_ERROR(status) ? "failed" : "ok");
+
+    fprintf(fp, "%s    {\n", first ? "" : ",\n");
+    fprintf(fp, "      \"base_asym_algo\": \"%s\",\n", asym_name);
+    fprintf(fp, "      \"dhe_named_group\": \"%s\",\n", dhe_name);
+    fprintf(fp, "      \"aead_cipher_suite\": \"%s\",\n", aead_name);
+    fprintf(fp, "      \"base_hash_algo\": \"%s\",\n", hash_name);
+    if (LIBSPDM_STATUS_IS_ERROR(status)) {
+        fprintf(fp, "      \"status\": \"failed\",\n");
+        fprintf(fp, "      \"error\": \"0x%08x\",\n", (uint32_t)status);
+        fprintf(fp, "      \"failed_operation\": \"%s\",\n",
+                (failed_op < LIBSPDM_BENCH_OP_MAX) ? m_libspdm_bench_op_name[failed_op] : "setup");
+        fprintf(fp, "      \"completed_iterations\": %zu,\n", iteration);
+    } else {
+        fprintf(fp, "      \"status\": \"ok\",\n");
+    }
+    fprintf(fp, "      \"operations\": {");
+    first_op = true;
+    for (op = 0; op < LIBSPDM_BENCH_OP_MAX; op++) {
+        if (m_libspdm_bench_stat[op].sample_count == 0) {
+            continue;
+        }
+        fprintf(fp, "%s\n", first_op ? "" : ",");
+        libspdm_bench_json_write_stat(fp, &m_libspdm_bench_stat[op], "        ");
+        first_op = false;
+    }
+    fprintf(fp, "%s}", first_op ? "" : "\n      ");
+#if LIBSPDM_STATISTICS_SUPPORT
+    libspdm_bench_json_write_memory(fp);
+    if (m_libspdm_bench_soak_rounds != 0) {
+        libspdm_bench_json_write_soak(fp);
+    }
+#endif /* LIBSPDM_STATISTICS_SUPPORT */
+#if LIBSPDM_ALLOC_SCOPE_SUPPORT
+    libspdm_bench_json_write_arena(fp);
+#endif /* LIBSPDM_ALLOC_SCOPE_SUPPORT */
+    fprintf(fp, "\n    }");
+
+#if LIBSPDM_STATISTICS_SUPPORT
+    if ((m_libspdm_bench_soak_allocation_count != 0) || (m_libspdm_bench_soak_free_count != 0)) {
+        fprintf(stderr, "  soak: %llu allocations and %llu frees by APP messages and HEARTBEAT\n",
+                (unsigned long long)m_libspdm_bench_soak_allocation_count,
+                (unsigned long long)m_libspdm_bench_soak_free_count);
+        return false;
+    }
+#endif /* LIBSPDM_STATISTICS_SUPPORT */
+    return true;
+}
+
+static bool libspdm_bench_name_match(const char *filter, const char *name)
+{
+    return (filter == NULL) || (strcmp(filter, name) == 0);
+}
+
+static libspdm_return_t libspdm_bench_alloc_endpoint(libspdm_bench_endpoint_t *endpoint)
+{
+    endpoint->spdm_context = malloc(libspdm_get_context_size());
+    if (endpoint->spdm_context == NULL) {
+        return LIBSPDM_STATUS_BUFFER_FULL;
+    }
+    libspdm_init_context(endpoint->spdm_context);
+    libspdm_bench_register_transport(endpoint->spdm_context);
+    endpoint->scratch_buffer_size =
+        libspdm_get_sizeof_required_scratch_buffer(endpoint->spdm_context);
+    endpoint->scratch_buffer = malloc(endpoint->scratch_buffer_size);
+    libspdm_deinit_context(endpoint->spdm_context);
+    if (endpoint->scratch_buffer == NULL) {
+        return LIBSPDM_STATUS_BUFFER_FULL;
+    }
+#if LIBSPDM_ALLOC_SCOPE_SUPPORT
+    libspdm_malloc_arena_init(&endpoint->arena, endpoint->arena_buffer,
+                              LIBSPDM_BENCH_ARENA_SIZE);
+#endif /* LIBSPDM_ALLOC_SCOPE_SUPPORT */
+    return LIBSPDM_STATUS_SUCCESS;
+}
+
+int main(int argc, char **argv)
+{
+    const char *output_file;
+    const char *filter_asym;
+    const char *filter_dhe;
+    const char *filter_aead;
+    const char *filter_hash;
+    const char *trace_file;
+    bool usdt;
+    size_t iterations;
+    bool soak_passed;
+    libspdm_bench_algo_t algo;
+    size_t asym_index;
+    size_t dhe_index;
+    size_t aead_index;
+    size_t hash_index;
+    size_t op;
+    FILE *fp;
+    bool first;
+    int index;
+
+    iterations = LIBSPDM_BENCH_DEFAULT_ITERATIONS;
+    output_file = LIBSPDM_BENCH_DEFAULT_OUTPUT_FILE;
+    filter_asym = NULL;
+    filter_dhe = NULL;
+    filter_aead = NULL;
+    filter_hash = NULL;
+    trace_file = NULL;
+    usdt = false;
+    soak_passed = true;
+    for (index = 1; index + 1 < argc; index += 2) {
+        if (strcmp(argv[index], "-n") == 0) {
+            iterations = (size_t)strtoul(argv[index + 1], NULL, 0);
+        } else if (strcmp(argv[index], "-o") == 0) {
+            output_file = argv[index + 1];
+        } else if (strcmp(argv[index], "--asym") == 0) {
+            filter_asym = argv[index + 1];
+        } else if (strcmp(argv[index], "--dhe") == 0) {
+            filter_dhe = argv[index + 1];
+        } else if (strcmp(argv[index], "--aead") == 0) {
+            filter_aead = argv[index + 1];
+        } else if (strcmp(argv[index], "--hash") == 0) {
+            filter_hash = argv[index + 1];
+        } else if (strcmp(argv[index], "--soak") == 0) {
+#if LIBSPDM_STATISTICS_SUPPORT
+            m_libspdm_bench_soak_rounds = (size_t)strtoul(argv[index + 1], NULL, 0);
+#else
+            fprintf(stderr, "the soak run requires LIBSPDM_STATISTICS_SUPPORT\n");
+            return 1;
+#endif /* LIBSPDM_STATISTICS_SUPPORT */
+        } else if (strcmp(argv[index], "--trace") == 0) {
+            trace_file = argv[index + 1];
+        } else if (strcmp(argv[index], "--usdt") == 0) {
+            usdt = (strcmp(argv[index + 1], "on") == 0);
+        } else {
+            break;
+        }
+    }
+    if ((index < argc) || (iterations == 0)) {
+        fprintf(stderr,
+                "usage: %s [-n iterations] [-o report.json] "
+                "[--asym NAME] [--dhe NAME] [--aead NAME] [--hash NAME] "
+                "[--soak rounds] [--trace trace.json] [--usdt on]\n", argv[0]);
+        return 1;
+    }
+
+#if LIBSPDM_TRACE_SUPPORT
+    if ((trace_file != NULL) && !libspdm_bench_trace_open(trace_file)) {
+        fprintf(stderr, "Unable to open file %s\n", trace_file);
+        return 1;
+    }
+    if (!libspdm_bench_trace_enable_usdt(usdt)) {
+        fprintf(stderr, "USDT probes are not supported by this build\n");
+        return 1;
+    }
+#else
+    if ((trace_file != NULL) || usdt) {
+        fprintf(stderr, "tracing requires LIBSPDM_TRACE_SUPPORT\n");
+        return 1;
+    }
+#endif /* LIBSPDM_TRACE_SUPPORT */
+
+#if LIBSPDM_STATISTICS_SUPPORT && LIBSPDM_BENCH_OPENSSL_SUPPORT
+    if (!CRYPTO_set_mem_functions(libspdm_bench_openssl_malloc, libspdm_bench_openssl_realloc,
+                                  libspdm_bench_openssl_free)) {
+        fprintf(stderr, "Unable to route the OpenSSL allocations\n");
+        return 1;
+    }
+#endif /* LIBSPDM_STATISTICS_SUPPORT && LIBSPDM_BENCH_OPENSSL_SUPPORT */
+
+    if ((libspdm_bench_alloc_endpoint(&m_libspdm_bench_requester) != LIBSPDM_STATUS_SUCCESS) ||
+        (libspdm_bench_alloc_endpoint(&m_libspdm_bench_responder) != LIBSPDM_STATUS_SUCCESS)) {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+    for (op = 0; op < LIBSPDM_BENCH_OP_MAX; op++) {
+        if (!libspdm_bench_stat_init(&m_libspdm_bench_stat[op], m_libspdm_bench_op_name[op],
+                                     iterations * LIBSPDM_BENCH_SECURED_MESSAGE_COUNT)) {
+            fprintf(stderr, "out of memory\n");
+            return 1;
+        }
+    }
+
+    fp = stdout;
+    if (strcmp(output_file, "-") != 0) {
+        fp = fopen(output_file, "w");
+        if (fp == NULL) {
+            fprintf(stderr, "Unable to open file %s\n", output_file);
+            return 1;
+        }
+    }
+
+    fprintf(fp, "{\n");
+    fprintf(fp, "  \"benchmark\": \"spdm_handshake\",\n");
+    fprintf(fp, "  \"version\": %d,\n", LIBSPDM_BENCH_REPORT_VERSION);
+    fprintf(fp, "  \"crypto\": \"%s\",\n", LIBSPDM_BENCH_CRYPTO_NAME);
+    fprintf(fp, "  \"iterations\": %zu,\n", iterations);
+    fprintf(fp, "  \"secured_message_size\": %d,\n", LIBSPDM_BENCH_SECURED_MESSAGE_SIZE);
+    fprintf(fp, "  \"results\": [\n");
+
+    first = true;
+    for (asym_index = 0; asym_index < LIBSPDM_BENCH_ARRAY_SIZE(m_libspdm_bench_base_asym_algo);
+         asym_index++) {
+        for (dhe_index = 0; dhe_index < LIBSPDM_BENCH_ARRAY_SIZE(m_libspdm_bench_dhe_named_group);
+             dhe_index++) {
+            for (aead_index = 0;
+                 aead_index < LIBSPDM_BENCH_ARRAY_SIZE(m_libspdm_bench_aead_cipher_suite);
+                 aead_index++) {
+                for (hash_index = 0;
+                     hash_index < LIBSPDM_BENCH_ARRAY_SIZE(m_libspdm_bench_base_hash_algo);
+                     hash_index++) {
+                    if (!libspdm_bench_name_match(
+                            filter_asym, m_libspdm_bench_base_asym_algo[asym_index].name) ||
+                        !libspdm_bench_name_match(
+                            filter_dhe, m_libspdm_bench_dhe_named_group[dhe_index].name) ||
+                        !libspdm_bench_name_match(
+                            filter_aead, m_libspdm_bench_aead_cipher_suite[aead_index].name) ||
+                        !libspdm_bench_name_match(
+                            filter_hash, m_libspdm_bench_base_hash_algo[hash_index].name)) {
+                        continue;
+                    }
+
+                    algo.base_asym_algo = m_libspdm_bench_base_asym_algo[asym_index].value;
+                    algo.dhe_named_group =
+                        (uint16_t)m_libspdm_bench_dhe_named_group[dhe_index].value;
+                    algo.aead_cipher_suite =
+                        (uint16_t)m_libspdm_bench_aead_cipher_suite[aead_index].value;
+                    algo.base_hash_algo = m_libspdm_bench_base_hash_algo[hash_index].value;
+                    algo.measurement_hash_algo =
+                        libspdm_bench_get_measurement_hash_algo(algo.base_hash_algo);
+
+                    soak_passed &= libspdm_bench_run_combination(
+                        fp, first, &algo,
+                        m_libspdm_bench_base_asym_algo[asym_index].name,
+                        m_libspdm_bench_dhe_named_group[dhe_index].name,
+                        m_libspdm_bench_aead_cipher_suite[aead_index].name,
+                        m_libspdm_bench_base_hash_algo[hash_index].name,
+                        iterations);
+                    first = false;
+                }
+            }
+        }
+    }
+
+    fprintf(fp, "%s  ]\n}\n", first ? "" : "\n");
+    if (fp != stdout) {
+        fclose(fp);
+    }
+#if LIBSPDM_TRACE_SUPPORT
+    libspdm_bench_trace_close();
+#endif /* LIBSPDM_TRACE_SUPPORT */
+
+    for (op = 0; op < LIBSPDM_BENCH_OP_MAX; op++) {
+        libspdm_bench_stat_free(&m_libspdm_bench_stat[op]);
+    }
+    free(m_libspdm_bench_requester.scratch_buffer);
+    free(m_libspdm_bench_requester.spdm_context);
+    free(m_libspdm_bench_responder.scratch_buffer);
+    free(m_libspdm_bench_responder.spdm_context);
+    return soak_passed ? 0 : 1;
+}
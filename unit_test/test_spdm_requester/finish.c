@@ -3689,6 +3689,79 @@ libspdm_test_context_t m_libspdm_requester_finish_test_context = {
     libspdm_requester_finish_test_receive_message,
 };
 
+#if LIBSPDM_ALLOC_SCOPE_SUPPORT && LIBSPDM_SESSION_PREALLOCATION_SUPPORT
+static size_t m_libspdm_finish_test_flow_depth;
+static bool m_libspdm_finish_test_aead_allocated;
+static size_t m_libspdm_finish_test_persistent_aead_count;
+
+/* Count the persistent scopes in which the AEAD contexts of session 0 are allocated. */
+static void libspdm_requester_finish_test_alloc_scope(void *spdm_context,
+                                                      libspdm_alloc_scope_t scope,
+                                                      uint8_t request_code)
+{
+    libspdm_secured_message_context_t *secured_message_context;
+
+    secured_message_context =
+        ((libspdm_context_t *)spdm_context)->session_info[0].secured_message_context;
+    switch (scope) {
+    case LIBSPDM_ALLOC_SCOPE_FLOW_BEGIN:
+        assert_int_equal(request_code, SPDM_FINISH);
+        m_libspdm_finish_test_flow_depth++;
+        break;
+    case LIBSPDM_ALLOC_SCOPE_FLOW_END:
+        m_libspdm_finish_test_flow_depth--;
+        break;
+    case LIBSPDM_ALLOC_SCOPE_PERSISTENT_BEGIN:
+        assert_int_equal(m_libspdm_finish_test_flow_depth, 1);
+        m_libspdm_finish_test_aead_allocated =
+            (secured_message_context->request_data_aead.context != NULL);
+        break;
+    case LIBSPDM_ALLOC_SCOPE_PERSISTENT_END:
+        if (!m_libspdm_finish_test_aead_allocated &&
+            (secured_message_context->request_data_aead.context != NULL) &&
+            (secured_message_context->response_data_aead.context != NULL)) {
+            m_libspdm_finish_test_persistent_aead_count++;
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+/**
+ * Test 24: successful response, with an allocation scope function and session preallocation.
+ * Expected Behavior: the AEAD contexts of the data keys are allocated once, in a persistent scope
+ * inside the FINISH flow, and a KEY_UPDATE keys a new context with the new data key.
+ **/
+void libspdm_test_requester_finish_case24(void **state)
+{
+    libspdm_context_t *spdm_context;
+    libspdm_secured_message_context_t *secured_message_context;
+    bool result;
+
+    spdm_context = ((libspdm_test_context_t *)*state)->spdm_context;
+    m_libspdm_finish_test_flow_depth = 0;
+    m_libspdm_finish_test_persistent_aead_count = 0;
+    libspdm_register_alloc_scope_func(spdm_context, libspdm_requester_finish_test_alloc_scope);
+
+    libspdm_test_requester_finish_case2(state);
+
+    libspdm_register_alloc_scope_func(spdm_context, NULL);
+    assert_int_equal(m_libspdm_finish_test_flow_depth, 0);
+    assert_int_equal(m_libspdm_finish_test_persistent_aead_count, 1);
+
+    secured_message_context = spdm_context->session_info[0].secured_message_context;
+    result = libspdm_create_update_session_data_key(secured_message_context,
+                                                    LIBSPDM_KEY_UPDATE_ACTION_REQUESTER);
+    assert_true(result);
+    assert_non_null(secured_message_context->request_data_aead.context);
+    assert_true(secured_message_context->request_data_aead.is_key_set);
+    assert_memory_equal(secured_message_context->request_data_aead.key,
+                        secured_message_context->application_secret.request_data_encryption_key,
+                        secured_message_context->aead_key_size);
+}
+#endif /* LIBSPDM_ALLOC_SCOPE_SUPPORT && LIBSPDM_SESSION_PREALLOCATION_SUPPORT */
+
 int libspdm_requester_finish_test_main(void)
 {
     const struct CMUnitTest spdm_requester_finish_tests[] = {
@@ -3733,6 +3806,10 @@ int libspdm_requester_finish_test_main(void)
         cmocka_unit_test(libspdm_test_requester_finish_case22),
         /* Successful response using provisioned public key (slot_id 0xFF) */
         cmocka_unit_test(libspdm_test_requester_finish_case23),
+#if LIBSPDM_ALLOC_SCOPE_SUPPORT && LIBSPDM_SESSION_PREALLOCATION_SUPPORT
+        /* AEAD contexts allocated in a persistent scope */
+        cmocka_unit_test(libspdm_test_requester_finish_case24),
+#endif /* LIBSPDM_ALLOC_SCOPE_SUPPORT && LIBSPDM_SESSION_PREALLOCATION_SUPPORT */
     };
 
     libspdm_setup_test_context(&m_libspdm_requester_finish_test_context);
@@ -2178,6 +2178,8 @@ void libspdm_test_requester_get_certificate_case2(void **state)
     status = libspdm_get_certificate(spdm_context, NULL, 0, &cert_chain_size,
                                      cert_chain);
     assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    /* The leaf cert public key is cached for later signature verification. */
+    assert_non_null(spdm_context->connection_info.peer_used_cert_chain[0].leaf_cert_public_key);
 #if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
     count = (data_size + LIBSPDM_MAX_CERT_CHAIN_BLOCK_LEN - 1) /
             LIBSPDM_MAX_CERT_CHAIN_BLOCK_LEN;
@@ -2188,7 +2190,6 @@ void libspdm_test_requester_get_certificate_case2(void **state)
     assert_int_equal(spdm_context->transcript.message_m.buffer_size, 0);
 #else
     /*
-     * libspdm_get_certificate will get leaf_cert_public_key when LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT is not enabled.
      * The follow check is for libspdm_set_data.
      **/
     assert_int_equal(set_data_buffer_hash_size,
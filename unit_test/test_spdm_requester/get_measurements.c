@@ -17,6 +17,137 @@ static size_t m_libspdm_local_buffer_size;
 static uint8_t m_libspdm_local_buffer[LIBSPDM_MAX_MESSAGE_L1L2_BUFFER_SIZE];
 static uint8_t m_libspdm_msg_log_buffer[LIBSPDM_MAX_MESSAGE_L1L2_BUFFER_SIZE * 2];
 
+/* The measurement operation of the last request, for the cases of libspdm_get_measurement_blocks */
+static uint8_t m_libspdm_get_measurements_test_operation;
+
+#if LIBSPDM_MEASUREMENT_CACHE_SUPPORT
+/* The number of requests sent, and the content changed field of the signed responses, for the
+ * cases of libspdm_get_measurement_blocks_cached */
+static size_t m_libspdm_get_measurements_test_request_count;
+static uint8_t m_libspdm_get_measurements_test_content_changed;
+#endif /* LIBSPDM_MEASUREMENT_CACHE_SUPPORT */
+
+/* The way the record of case 0x2A is short: 0 if a block is missing, 1 if the last block runs
+ * past the end of the record. */
+static uint8_t m_libspdm_get_measurements_test_short_record;
+
+#if LIBSPDM_TRACE_SUPPORT
+/* The number of trace events of each phase, and the signature size traced on ASYM_VERIFY */
+static size_t m_libspdm_get_measurements_test_trace_count[LIBSPDM_TRACE_EVENT_MAX][2];
+static size_t m_libspdm_get_measurements_test_trace_sig_size;
+
+static void libspdm_requester_get_measurements_test_trace(
+    void *spdm_context, libspdm_trace_event_t event, libspdm_trace_phase_t phase,
+    uint8_t request_code, uint32_t session_id, size_t size)
+{
+    assert_int_equal(session_id, 0);
+    assert_true(event < LIBSPDM_TRACE_EVENT_MAX);
+    assert_true(phase <= LIBSPDM_TRACE_PHASE_END);
+    if ((event == LIBSPDM_TRACE_EVENT_REQUEST) || (event == LIBSPDM_TRACE_EVENT_ASYM_VERIFY)) {
+        assert_int_equal(request_code, SPDM_GET_MEASUREMENTS);
+    }
+    if ((event == LIBSPDM_TRACE_EVENT_ASYM_VERIFY) && (phase == LIBSPDM_TRACE_PHASE_BEGIN)) {
+        m_libspdm_get_measurements_test_trace_sig_size = size;
+    }
+    m_libspdm_get_measurements_test_trace_count[event][phase]++;
+}
+#endif /* LIBSPDM_TRACE_SUPPORT */
+
+/**
+ * Build a MEASUREMENTS response with the blocks of the measurement indices, each with a
+ * measurement hash filled with its index, and append it to m_libspdm_local_buffer.
+ **/
+static void libspdm_test_build_measurements_response(void *spdm_context,
+                                                     const uint8_t *indices,
+                                                     uint8_t index_count,
+                                                     uint8_t total_number_of_blocks,
+                                                     bool sign,
+                                                     size_t *response_size, void **response)
+{
+    spdm_measurements_response_t *spdm_response;
+    spdm_measurement_block_dmtf_t *measurment_block;
+    size_t measurement_hash_size;
+    size_t transport_header_size;
+    size_t sig_size;
+    uint8_t *ptr;
+    uint8_t index;
+
+    measurement_hash_size = libspdm_get_measurement_hash_size(m_libspdm_use_measurement_hash_algo);
+    transport_header_size = libspdm_transport_test_get_header_size(spdm_context);
+    spdm_response = (void *)((uint8_t *)*response + transport_header_size);
+
+    spdm_response->header.spdm_version = SPDM_MESSAGE_VERSION_12;
+    spdm_response->header.request_response_code = SPDM_MEASUREMENTS;
+    spdm_response->header.param1 = total_number_of_blocks;
+    spdm_response->header.param2 = sign ? 0x0F : 0;
+#if LIBSPDM_MEASUREMENT_CACHE_SUPPORT
+    if (sign) {
+        spdm_response->header.param2 |= m_libspdm_get_measurements_test_content_changed;
+    }
+#endif /* LIBSPDM_MEASUREMENT_CACHE_SUPPORT */
+    spdm_response->number_of_blocks = index_count;
+    libspdm_write_uint24(spdm_response->measurement_record_length,
+                         (uint32_t)(index_count * (sizeof(spdm_measurement_block_dmtf_t) +
+                                                   measurement_hash_size)));
+    ptr = (void *)(spdm_response + 1);
+    for (index = 0; index < index_count; index++) {
+        measurment_block = (void *)ptr;
+        libspdm_set_mem(measurment_block,
+                        sizeof(spdm_measurement_block_dmtf_t) + measurement_hash_size,
+                        indices[index]);
+        measurment_block->measurement_block_common_header.index = indices[index];
+        measurment_block->measurement_block_common_header.measurement_specification =
+            SPDM_MEASUREMENT_BLOCK_HEADER_SPECIFICATION_DMTF;
+        measurment_block->measurement_block_common_header.measurement_size =
+            (uint16_t)(sizeof(spdm_measurement_block_dmtf_header_t) + measurement_hash_size);
+        ptr += sizeof(spdm_measurement_block_dmtf_t) + measurement_hash_size;
+    }
+    libspdm_get_random_number(SPDM_NONCE_SIZE, ptr);
+    ptr += SPDM_NONCE_SIZE;
+    *(uint16_t *)ptr = 0;
+    ptr += sizeof(uint16_t);
+    libspdm_copy_mem(&m_libspdm_local_buffer[m_libspdm_local_buffer_size],
+                     sizeof(m_libspdm_local_buffer) - m_libspdm_local_buffer_size,
+                     spdm_response, (size_t)ptr - (size_t)spdm_response);
+    m_libspdm_local_buffer_size += ((size_t)ptr - (size_t)spdm_response);
+    if (sign) {
+        sig_size = libspdm_get_asym_signature_size(m_libspdm_use_asym_algo);
+        libspdm_responder_data_sign(
+            spdm_response->header.spdm_version << SPDM_VERSION_NUMBER_SHIFT_BIT,
+                SPDM_MEASUREMENTS,
+                m_libspdm_use_asym_algo, m_libspdm_use_hash_algo,
+                false, m_libspdm_local_buffer, m_libspdm_local_buffer_size,
+                ptr, &sig_size);
+        ptr += sig_size;
+        m_libspdm_local_buffer_size = 0;
+    }
+
+    libspdm_transport_test_encode_message(spdm_context, NULL, false, false,
+                                          (size_t)ptr - (size_t)spdm_response, spdm_response,
+                                          response_size, response);
+}
+
+/**
+ * Build an ERROR response.
+ **/
+static void libspdm_test_build_error_response(void *spdm_context, uint8_t error_code,
+                                              size_t *response_size, void **response)
+{
+    spdm_error_response_t *spdm_response;
+    size_t transport_header_size;
+
+    transport_header_size = libspdm_transport_test_get_header_size(spdm_context);
+    spdm_response = (void *)((uint8_t *)*response + transport_header_size);
+    libspdm_zero_mem(spdm_response, sizeof(spdm_error_response_t));
+    spdm_response->header.spdm_version = SPDM_MESSAGE_VERSION_12;
+    spdm_response->header.request_response_code = SPDM_ERROR;
+    spdm_response->header.param1 = error_code;
+    spdm_response->header.param2 = 0;
+    libspdm_transport_test_encode_message(spdm_context, NULL, false, false,
+                                          sizeof(spdm_error_response_t), spdm_response,
+                                          response_size, response);
+}
+
 static size_t libspdm_test_get_measurement_request_size(const void *spdm_context,
                                                         const void *buffer,
                                                         size_t buffer_size)
@@ -438,6 +569,40 @@ static libspdm_return_t libspdm_requester_get_measurements_test_send_message(
                          (const uint8_t *)request + header_size, message_size);
         m_libspdm_local_buffer_size += message_size;
         return LIBSPDM_STATUS_SUCCESS;
+    case 0x27:
+    case 0x28:
+    case 0x2A:
+        /* The requests answered with an ERROR are not in the transcript. */
+        m_libspdm_get_measurements_test_operation =
+            ((const spdm_message_header_t *)((const uint8_t *)request + header_size))->param2;
+        if ((spdm_test_context->case_id == 0x27) &&
+            ((m_libspdm_get_measurements_test_operation ==
+              SPDM_GET_MEASUREMENTS_REQUEST_MEASUREMENT_OPERATION_ALL_MEASUREMENTS) ||
+             (m_libspdm_get_measurements_test_operation == 2))) {
+            return LIBSPDM_STATUS_SUCCESS;
+        }
+        message_size = libspdm_test_get_measurement_request_size(
+            spdm_context, (const uint8_t *)request + header_size,
+            request_size - header_size);
+        libspdm_copy_mem(m_libspdm_local_buffer + m_libspdm_local_buffer_size,
+                         sizeof(m_libspdm_local_buffer) - m_libspdm_local_buffer_size,
+                         (const uint8_t *)request + header_size, message_size);
+        m_libspdm_local_buffer_size += message_size;
+        return LIBSPDM_STATUS_SUCCESS;
+#if LIBSPDM_MEASUREMENT_CACHE_SUPPORT
+    case 0x29:
+        m_libspdm_get_measurements_test_operation =
+            ((const spdm_message_header_t *)((const uint8_t *)request + header_size))->param2;
+        m_libspdm_get_measurements_test_request_count++;
+        message_size = libspdm_test_get_measurement_request_size(
+            spdm_context, (const uint8_t *)request + header_size,
+            request_size - header_size);
+        libspdm_copy_mem(m_libspdm_local_buffer + m_libspdm_local_buffer_size,
+                         sizeof(m_libspdm_local_buffer) - m_libspdm_local_buffer_size,
+                         (const uint8_t *)request + header_size, message_size);
+        m_libspdm_local_buffer_size += message_size;
+        return LIBSPDM_STATUS_SUCCESS;
+#endif /* LIBSPDM_MEASUREMENT_CACHE_SUPPORT */
     default:
         return LIBSPDM_STATUS_SEND_FAIL;
     }
@@ -2968,6 +3133,78 @@ static libspdm_return_t libspdm_requester_get_measurements_test_receive_message(
     }
         return LIBSPDM_STATUS_SUCCESS;
 
+    case 0x27: {
+        /* The measurement record does not fit a response, and index 2 has no measurement. */
+        static const uint8_t m_libspdm_index_1[] = {1};
+        static const uint8_t m_libspdm_index_3[] = {3};
+
+        switch (m_libspdm_get_measurements_test_operation) {
+        case SPDM_GET_MEASUREMENTS_REQUEST_MEASUREMENT_OPERATION_ALL_MEASUREMENTS:
+            libspdm_test_build_error_response(spdm_context, SPDM_ERROR_CODE_RESPONSE_TOO_LARGE,
+                                              response_size, response);
+            break;
+        case SPDM_GET_MEASUREMENTS_REQUEST_MEASUREMENT_OPERATION_TOTAL_NUMBER_OF_MEASUREMENTS:
+            libspdm_test_build_measurements_response(spdm_context, NULL, 0, 2, false,
+                                                     response_size, response);
+            break;
+        case 1:
+            libspdm_test_build_measurements_response(spdm_context, m_libspdm_index_1, 1, 0,
+                                                     false, response_size, response);
+            break;
+        case 3:
+            libspdm_test_build_measurements_response(spdm_context, m_libspdm_index_3, 1, 0,
+                                                     true, response_size, response);
+            break;
+        default:
+            libspdm_test_build_error_response(spdm_context, SPDM_ERROR_CODE_INVALID_REQUEST,
+                                              response_size, response);
+            break;
+        }
+    }
+        return LIBSPDM_STATUS_SUCCESS;
+
+    case 0x28: {
+        static const uint8_t m_libspdm_indices[] = {1, 3};
+
+        libspdm_test_build_measurements_response(spdm_context, m_libspdm_indices, 2, 0, true,
+                                                 response_size, response);
+    }
+        return LIBSPDM_STATUS_SUCCESS;
+
+#if LIBSPDM_MEASUREMENT_CACHE_SUPPORT
+    case 0x29: {
+        static const uint8_t m_libspdm_indices[] = {1, 3};
+
+        if (m_libspdm_get_measurements_test_operation ==
+            SPDM_GET_MEASUREMENTS_REQUEST_MEASUREMENT_OPERATION_TOTAL_NUMBER_OF_MEASUREMENTS) {
+            libspdm_test_build_measurements_response(spdm_context, NULL, 0, 2, true,
+                                                     response_size, response);
+        } else {
+            libspdm_test_build_measurements_response(spdm_context, m_libspdm_indices, 2, 0,
+                                                     true, response_size, response);
+        }
+    }
+        return LIBSPDM_STATUS_SUCCESS;
+#endif /* LIBSPDM_MEASUREMENT_CACHE_SUPPORT */
+
+    case 0x2A: {
+        static const uint8_t m_libspdm_index_1[] = {1};
+        spdm_measurements_response_t *spdm_response;
+
+        /* The response is encoded in place. */
+        spdm_response = (void *)((uint8_t *)*response +
+                                 libspdm_transport_test_get_header_size(spdm_context));
+        libspdm_test_build_measurements_response(spdm_context, m_libspdm_index_1, 1, 0, false,
+                                                 response_size, response);
+        if (m_libspdm_get_measurements_test_short_record == 0) {
+            spdm_response->number_of_blocks = 2;
+        } else {
+            ((spdm_measurement_block_common_header_t *)(spdm_response + 1))->measurement_size +=
+                (uint16_t)sizeof(spdm_measurement_block_common_header_t);
+        }
+    }
+        return LIBSPDM_STATUS_SUCCESS;
+
     default:
         return LIBSPDM_STATUS_RECEIVE_FAIL;
     }
@@ -5777,6 +6014,516 @@ void libspdm_test_requester_get_measurements_case38(void **state)
     free(data);
 }
 
+/**
+ * Test 39: the measurement blocks are requested one by one when all the blocks do not fit a
+ * response, skipping an index without measurement, with the signature on the last block.
+ * Expected Behavior: the blocks are returned with an empty transcript.message_m.
+ **/
+static void libspdm_test_requester_get_measurements_case39(void **state)
+{
+    libspdm_return_t status;
+    libspdm_test_context_t *spdm_test_context;
+    libspdm_context_t *spdm_context;
+    uint8_t number_of_blocks;
+    libspdm_measurement_block_t blocks[4];
+    uint32_t measurement_record_length;
+    uint8_t measurement_record[LIBSPDM_MAX_MEASUREMENT_RECORD_SIZE];
+    void *data;
+    size_t data_size;
+
+    spdm_test_context = *state;
+    spdm_context = spdm_test_context->spdm_context;
+    spdm_test_context->case_id = 0x27;
+    spdm_context->connection_info.version = SPDM_MESSAGE_VERSION_12 <<
+                                            SPDM_VERSION_NUMBER_SHIFT_BIT;
+    spdm_context->connection_info.connection_state =
+        LIBSPDM_CONNECTION_STATE_AUTHENTICATED;
+    spdm_context->connection_info.capability.flags |=
+        SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP_SIG;
+    spdm_context->connection_info.capability.flags |=
+        SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_PUB_KEY_ID_CAP;
+    libspdm_read_responder_public_key(m_libspdm_use_asym_algo, &data, &data_size);
+    spdm_context->local_context.peer_public_key_provision = data;
+    spdm_context->local_context.peer_public_key_provision_size = data_size;
+
+    libspdm_reset_message_m(spdm_context, NULL);
+    m_libspdm_local_buffer_size = 0;
+    spdm_context->connection_info.algorithm.measurement_spec =
+        m_libspdm_use_measurement_spec;
+    spdm_context->connection_info.algorithm.measurement_hash_algo =
+        m_libspdm_use_measurement_hash_algo;
+    spdm_context->connection_info.algorithm.base_hash_algo =
+        m_libspdm_use_hash_algo;
+    spdm_context->connection_info.algorithm.base_asym_algo =
+        m_libspdm_use_asym_algo;
+
+    number_of_blocks = LIBSPDM_ARRAY_SIZE(blocks);
+    measurement_record_length = sizeof(measurement_record);
+    status = libspdm_get_measurement_blocks(
+        spdm_context, NULL, SPDM_GET_MEASUREMENTS_REQUEST_ATTRIBUTES_GENERATE_SIGNATURE, 0xF,
+        NULL, &number_of_blocks, blocks, &measurement_record_length, measurement_record);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    assert_int_equal(number_of_blocks, 2);
+    assert_int_equal(measurement_record_length,
+                     2 * (sizeof(spdm_measurement_block_dmtf_t) +
+                          libspdm_get_measurement_hash_size(m_libspdm_use_measurement_hash_algo)));
+    assert_int_equal(blocks[0].index, 1);
+    assert_int_equal(blocks[1].index, 3);
+    assert_int_equal(blocks[1].measurement_size,
+                     sizeof(spdm_measurement_block_dmtf_header_t) +
+                     libspdm_get_measurement_hash_size(m_libspdm_use_measurement_hash_algo));
+    assert_int_equal(blocks[1].measurement[blocks[1].measurement_size - 1], 3);
+#if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
+    assert_int_equal(spdm_context->transcript.message_m.buffer_size, 0);
+#endif
+    free(data);
+}
+
+/**
+ * Test 40: all the measurement blocks fit a response.
+ * Expected Behavior: the blocks are returned from a single signed response, and a blocks array
+ * too small is reported with the number of blocks.
+ **/
+static void libspdm_test_requester_get_measurements_case40(void **state)
+{
+    libspdm_return_t status;
+    libspdm_test_context_t *spdm_test_context;
+    libspdm_context_t *spdm_context;
+    uint8_t number_of_blocks;
+    libspdm_measurement_block_t blocks[2];
+    uint32_t measurement_record_length;
+    uint8_t measurement_record[LIBSPDM_MAX_MEASUREMENT_RECORD_SIZE];
+    void *data;
+    size_t data_size;
+
+    spdm_test_context = *state;
+    spdm_context = spdm_test_context->spdm_context;
+    spdm_test_context->case_id = 0x28;
+    spdm_context->connection_info.version = SPDM_MESSAGE_VERSION_12 <<
+                                            SPDM_VERSION_NUMBER_SHIFT_BIT;
+    spdm_context->connection_info.connection_state =
+        LIBSPDM_CONNECTION_STATE_AUTHENTICATED;
+    spdm_context->connection_info.capability.flags |=
+        SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP_SIG;
+    spdm_context->connection_info.capability.flags |=
+        SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_PUB_KEY_ID_CAP;
+    libspdm_read_responder_public_key(m_libspdm_use_asym_algo, &data, &data_size);
+    spdm_context->local_context.peer_public_key_provision = data;
+    spdm_context->local_context.peer_public_key_provision_size = data_size;
+
+    libspdm_reset_message_m(spdm_context, NULL);
+    m_libspdm_local_buffer_size = 0;
+    spdm_context->connection_info.algorithm.measurement_spec =
+        m_libspdm_use_measurement_spec;
+    spdm_context->connection_info.algorithm.measurement_hash_algo =
+        m_libspdm_use_measurement_hash_algo;
+    spdm_context->connection_info.algorithm.base_hash_algo =
+        m_libspdm_use_hash_algo;
+    spdm_context->connection_info.algorithm.base_asym_algo =
+        m_libspdm_use_asym_algo;
+
+    number_of_blocks = LIBSPDM_ARRAY_SIZE(blocks);
+    measurement_record_length = sizeof(measurement_record);
+    status = libspdm_get_measurement_blocks(
+        spdm_context, NULL, SPDM_GET_MEASUREMENTS_REQUEST_ATTRIBUTES_GENERATE_SIGNATURE, 0xF,
+        NULL, &number_of_blocks, blocks, &measurement_record_length, measurement_record);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    assert_int_equal(number_of_blocks, 2);
+    assert_int_equal(blocks[0].index, 1);
+    assert_int_equal(blocks[1].index, 3);
+    assert_ptr_equal(blocks[0].measurement,
+                     measurement_record + sizeof(spdm_measurement_block_common_header_t));
+
+    number_of_blocks = 1;
+    measurement_record_length = sizeof(measurement_record);
+    status = libspdm_get_measurement_blocks(
+        spdm_context, NULL, SPDM_GET_MEASUREMENTS_REQUEST_ATTRIBUTES_GENERATE_SIGNATURE, 0xF,
+        NULL, &number_of_blocks, blocks, &measurement_record_length, measurement_record);
+    assert_int_equal(status, LIBSPDM_STATUS_BUFFER_TOO_SMALL);
+    assert_int_equal(number_of_blocks, 2);
+    free(data);
+}
+
+#if LIBSPDM_MEASUREMENT_CACHE_SUPPORT
+/**
+ * Test 41: the measurement blocks are got again through libspdm_get_measurement_blocks_cached.
+ * Expected Behavior: the kept blocks are returned after a signed probe reporting no change, or
+ * without any request for the same measurement summary hash. The blocks are got from the device
+ * if a change is reported or the measurement summary hash differs.
+ **/
+static void libspdm_test_requester_get_measurements_case41(void **state)
+{
+    libspdm_return_t status;
+    libspdm_test_context_t *spdm_test_context;
+    libspdm_context_t *spdm_context;
+    uint8_t number_of_blocks;
+    libspdm_measurement_block_t blocks[2];
+    uint32_t measurement_record_length;
+    uint8_t measurement_record[LIBSPDM_MAX_MEASUREMENT_RECORD_SIZE];
+    uint8_t content_changed;
+    uint8_t measurement_summary_hash[LIBSPDM_MAX_HASH_SIZE];
+    void *data;
+    size_t data_size;
+
+    spdm_test_context = *state;
+    spdm_context = spdm_test_context->spdm_context;
+    spdm_test_context->case_id = 0x29;
+    spdm_context->connection_info.version = SPDM_MESSAGE_VERSION_12 <<
+                                            SPDM_VERSION_NUMBER_SHIFT_BIT;
+    spdm_context->connection_info.connection_state =
+        LIBSPDM_CONNECTION_STATE_AUTHENTICATED;
+    spdm_context->connection_info.capability.flags |=
+        SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP_SIG;
+    spdm_context->connection_info.capability.flags |=
+        SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_PUB_KEY_ID_CAP;
+    libspdm_read_responder_public_key(m_libspdm_use_asym_algo, &data, &data_size);
+    spdm_context->local_context.peer_public_key_provision = data;
+    spdm_context->local_context.peer_public_key_provision_size = data_size;
+
+    libspdm_reset_message_m(spdm_context, NULL);
+    m_libspdm_local_buffer_size = 0;
+    spdm_context->connection_info.algorithm.measurement_spec =
+        m_libspdm_use_measurement_spec;
+    spdm_context->connection_info.algorithm.measurement_hash_algo =
+        m_libspdm_use_measurement_hash_algo;
+    spdm_context->connection_info.algorithm.base_hash_algo =
+        m_libspdm_use_hash_algo;
+    spdm_context->connection_info.algorithm.base_asym_algo =
+        m_libspdm_use_asym_algo;
+    spdm_context->connection_info.measurement_cache.valid = false;
+
+    /* Nothing is kept yet, the blocks are got from the device. */
+    m_libspdm_get_measurements_test_request_count = 0;
+    m_libspdm_get_measurements_test_content_changed =
+        SPDM_MEASUREMENTS_RESPONSE_CONTENT_NO_CHANGE_DETECTED;
+    number_of_blocks = LIBSPDM_ARRAY_SIZE(blocks);
+    measurement_record_length = sizeof(measurement_record);
+    status = libspdm_get_measurement_blocks_cached(
+        spdm_context, NULL, SPDM_GET_MEASUREMENTS_REQUEST_ATTRIBUTES_GENERATE_SIGNATURE, 0xF,
+        NULL, &content_changed, &number_of_blocks, blocks, &measurement_record_length,
+        measurement_record);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    assert_int_equal(m_libspdm_get_measurements_test_request_count, 1);
+    assert_int_equal(number_of_blocks, 2);
+    assert_true(spdm_context->connection_info.measurement_cache.valid);
+
+    /* The signed probe reports no change, the kept blocks are returned. */
+    m_libspdm_get_measurements_test_request_count = 0;
+    number_of_blocks = LIBSPDM_ARRAY_SIZE(blocks);
+    measurement_record_length = sizeof(measurement_record);
+    libspdm_zero_mem(measurement_record, sizeof(measurement_record));
+    status = libspdm_get_measurement_blocks_cached(
+        spdm_context, NULL, SPDM_GET_MEASUREMENTS_REQUEST_ATTRIBUTES_GENERATE_SIGNATURE, 0xF,
+        NULL, &content_changed, &number_of_blocks, blocks, &measurement_record_length,
+        measurement_record);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    assert_int_equal(m_libspdm_get_measurements_test_request_count, 1);
+    assert_int_equal(
+        m_libspdm_get_measurements_test_operation,
+        SPDM_GET_MEASUREMENTS_REQUEST_MEASUREMENT_OPERATION_TOTAL_NUMBER_OF_MEASUREMENTS);
+    assert_int_equal(content_changed,
+                     SPDM_MEASUREMENTS_RESPONSE_CONTENT_NO_CHANGE_DETECTED);
+    assert_int_equal(number_of_blocks, 2);
+    assert_int_equal(blocks[0].index, 1);
+    assert_int_equal(blocks[1].index, 3);
+    assert_int_equal(blocks[1].measurement[blocks[1].measurement_size - 1], 3);
+
+    /* The same measurement summary hash needs no request. */
+    libspdm_hash_all(m_libspdm_use_hash_algo, measurement_record, measurement_record_length,
+                     measurement_summary_hash);
+    m_libspdm_get_measurements_test_request_count = 0;
+    number_of_blocks = LIBSPDM_ARRAY_SIZE(blocks);
+    measurement_record_length = sizeof(measurement_record);
+    status = libspdm_get_measurement_blocks_cached(
+        spdm_context, NULL, SPDM_GET_MEASUREMENTS_REQUEST_ATTRIBUTES_GENERATE_SIGNATURE, 0xF,
+        measurement_summary_hash, &content_changed, &number_of_blocks, blocks,
+        &measurement_record_length, measurement_record);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    assert_int_equal(m_libspdm_get_measurements_test_request_count, 0);
+    assert_int_equal(number_of_blocks, 2);
+
+    /* Another measurement summary hash, the blocks are got from the device. */
+    measurement_summary_hash[0] ^= 0xFF;
+    m_libspdm_get_measurements_test_request_count = 0;
+    number_of_blocks = LIBSPDM_ARRAY_SIZE(blocks);
+    measurement_record_length = sizeof(measurement_record);
+    status = libspdm_get_measurement_blocks_cached(
+        spdm_context, NULL, SPDM_GET_MEASUREMENTS_REQUEST_ATTRIBUTES_GENERATE_SIGNATURE, 0xF,
+        measurement_summary_hash, &content_changed, &number_of_blocks, blocks,
+        &measurement_record_length, measurement_record);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    assert_int_equal(m_libspdm_get_measurements_test_request_count, 1);
+    assert_int_equal(m_libspdm_get_measurements_test_operation,
+                     SPDM_GET_MEASUREMENTS_REQUEST_MEASUREMENT_OPERATION_ALL_MEASUREMENTS);
+
+    /* The signed probe reports a change, the blocks are got from the device. */
+    m_libspdm_get_measurements_test_content_changed =
+        SPDM_MEASUREMENTS_RESPONSE_CONTENT_CHANGE_DETECTED;
+    m_libspdm_get_measurements_test_request_count = 0;
+    number_of_blocks = LIBSPDM_ARRAY_SIZE(blocks);
+    measurement_record_length = sizeof(measurement_record);
+    status = libspdm_get_measurement_blocks_cached(
+        spdm_context, NULL, SPDM_GET_MEASUREMENTS_REQUEST_ATTRIBUTES_GENERATE_SIGNATURE, 0xF,
+        NULL, &content_changed, &number_of_blocks, blocks, &measurement_record_length,
+        measurement_record);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    assert_int_equal(m_libspdm_get_measurements_test_request_count, 2);
+    assert_int_equal(m_libspdm_get_measurements_test_operation,
+                     SPDM_GET_MEASUREMENTS_REQUEST_MEASUREMENT_OPERATION_ALL_MEASUREMENTS);
+    assert_int_equal(content_changed, SPDM_MEASUREMENTS_RESPONSE_CONTENT_CHANGE_DETECTED);
+    assert_int_equal(number_of_blocks, 2);
+
+    m_libspdm_get_measurements_test_content_changed = 0;
+    free(data);
+}
+#endif /* LIBSPDM_MEASUREMENT_CACHE_SUPPORT */
+
+#if LIBSPDM_TRACE_SUPPORT
+/**
+ * Test 42: get a measurement with signature with a trace function registered, then with the
+ * trace function unregistered.
+ * Expected Behavior: each traced operation begins and ends once per occurrence, with the request
+ * code of GET_MEASUREMENTS, and nothing is traced once NULL is registered.
+ **/
+static void libspdm_test_requester_get_measurements_case42(void **state)
+{
+    libspdm_return_t status;
+    libspdm_test_context_t *spdm_test_context;
+    libspdm_context_t *spdm_context;
+    uint8_t number_of_block;
+    uint32_t measurement_record_length;
+    uint8_t measurement_record[LIBSPDM_MAX_MEASUREMENT_RECORD_SIZE];
+    void *data;
+    size_t data_size;
+    void *hash;
+    size_t hash_size;
+    size_t event;
+
+    spdm_test_context = *state;
+    spdm_context = spdm_test_context->spdm_context;
+    spdm_test_context->case_id = 0x2;
+    spdm_context->connection_info.version = SPDM_MESSAGE_VERSION_11 <<
+                                            SPDM_VERSION_NUMBER_SHIFT_BIT;
+    spdm_context->connection_info.connection_state = LIBSPDM_CONNECTION_STATE_AUTHENTICATED;
+    spdm_context->connection_info.capability.flags |=
+        SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP_SIG;
+    libspdm_read_responder_public_certificate_chain(m_libspdm_use_hash_algo,
+                                                    m_libspdm_use_asym_algo, &data,
+                                                    &data_size, &hash, &hash_size);
+    libspdm_reset_message_m(spdm_context, NULL);
+    spdm_context->connection_info.algorithm.measurement_spec = m_libspdm_use_measurement_spec;
+    spdm_context->connection_info.algorithm.measurement_hash_algo =
+        m_libspdm_use_measurement_hash_algo;
+    spdm_context->connection_info.algorithm.base_hash_algo = m_libspdm_use_hash_algo;
+    spdm_context->connection_info.algorithm.base_asym_algo = m_libspdm_use_asym_algo;
+    spdm_context->local_context.algorithm.measurement_spec =
+        SPDM_MEASUREMENT_BLOCK_HEADER_SPECIFICATION_DMTF;
+#if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
+    spdm_context->connection_info.peer_used_cert_chain[0].buffer_size = data_size;
+    libspdm_copy_mem(spdm_context->connection_info.peer_used_cert_chain[0].buffer,
+                     sizeof(spdm_context->connection_info.peer_used_cert_chain[0].buffer),
+                     data, data_size);
+#else
+    libspdm_hash_all(
+        spdm_context->connection_info.algorithm.base_hash_algo,
+        data, data_size,
+        spdm_context->connection_info.peer_used_cert_chain[0].buffer_hash);
+    spdm_context->connection_info.peer_used_cert_chain[0].buffer_hash_size =
+        libspdm_get_hash_size(spdm_context->connection_info.algorithm.base_hash_algo);
+    libspdm_get_leaf_cert_public_key_from_cert_chain(
+        spdm_context->connection_info.algorithm.base_hash_algo,
+        spdm_context->connection_info.algorithm.base_asym_algo,
+        data, data_size,
+        &spdm_context->connection_info.peer_used_cert_chain[0].leaf_cert_public_key);
+#endif
+
+    libspdm_zero_mem(m_libspdm_get_measurements_test_trace_count,
+                     sizeof(m_libspdm_get_measurements_test_trace_count));
+    m_libspdm_get_measurements_test_trace_sig_size = 0;
+    libspdm_register_trace_func(spdm_context, libspdm_requester_get_measurements_test_trace);
+
+    measurement_record_length = sizeof(measurement_record);
+    status = libspdm_get_measurement(spdm_context, NULL,
+                                     SPDM_GET_MEASUREMENTS_REQUEST_ATTRIBUTES_GENERATE_SIGNATURE,
+                                     1, 0, NULL, &number_of_block,
+                                     &measurement_record_length, measurement_record);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+
+    for (event = 0; event < LIBSPDM_TRACE_EVENT_MAX; event++) {
+        assert_int_equal(m_libspdm_get_measurements_test_trace_count[event][
+                             LIBSPDM_TRACE_PHASE_BEGIN],
+                         m_libspdm_get_measurements_test_trace_count[event][
+                             LIBSPDM_TRACE_PHASE_END]);
+    }
+    assert_int_equal(m_libspdm_get_measurements_test_trace_count[
+                         LIBSPDM_TRACE_EVENT_REQUEST][LIBSPDM_TRACE_PHASE_BEGIN], 1);
+    assert_int_equal(m_libspdm_get_measurements_test_trace_count[
+                         LIBSPDM_TRACE_EVENT_TRANSPORT_ENCODE][LIBSPDM_TRACE_PHASE_BEGIN], 1);
+    assert_int_equal(m_libspdm_get_measurements_test_trace_count[
+                         LIBSPDM_TRACE_EVENT_TRANSPORT_DECODE][LIBSPDM_TRACE_PHASE_BEGIN], 1);
+    assert_int_equal(m_libspdm_get_measurements_test_trace_count[
+                         LIBSPDM_TRACE_EVENT_ASYM_VERIFY][LIBSPDM_TRACE_PHASE_BEGIN], 1);
+    assert_int_not_equal(m_libspdm_get_measurements_test_trace_count[
+                             LIBSPDM_TRACE_EVENT_HASH_FINAL][LIBSPDM_TRACE_PHASE_BEGIN], 0);
+    assert_int_equal(m_libspdm_get_measurements_test_trace_count[
+                         LIBSPDM_TRACE_EVENT_AEAD_ENCRYPT][LIBSPDM_TRACE_PHASE_BEGIN], 0);
+    assert_int_equal(m_libspdm_get_measurements_test_trace_sig_size,
+                     libspdm_get_asym_signature_size(m_libspdm_use_asym_algo));
+
+    /* Unregister the trace function. */
+    libspdm_zero_mem(m_libspdm_get_measurements_test_trace_count,
+                     sizeof(m_libspdm_get_measurements_test_trace_count));
+    libspdm_register_trace_func(spdm_context, NULL);
+
+    measurement_record_length = sizeof(measurement_record);
+    status = libspdm_get_measurement(spdm_context, NULL,
+                                     SPDM_GET_MEASUREMENTS_REQUEST_ATTRIBUTES_GENERATE_SIGNATURE,
+                                     1, 0, NULL, &number_of_block,
+                                     &measurement_record_length, measurement_record);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    for (event = 0; event < LIBSPDM_TRACE_EVENT_MAX; event++) {
+        assert_int_equal(m_libspdm_get_measurements_test_trace_count[event][
+                             LIBSPDM_TRACE_PHASE_BEGIN], 0);
+    }
+    free(data);
+}
+#endif /* LIBSPDM_TRACE_SUPPORT */
+
+/**
+ * Test 43: the measurement record of the response is shorter than its blocks.
+ * Expected Behavior: a record holding fewer blocks than announced, or a block running past the
+ * end of the record, is rejected with LIBSPDM_STATUS_INVALID_MSG_FIELD.
+ **/
+static void libspdm_test_requester_get_measurements_case43(void **state)
+{
+    libspdm_return_t status;
+    libspdm_test_context_t *spdm_test_context;
+    libspdm_context_t *spdm_context;
+    uint8_t number_of_blocks;
+    libspdm_measurement_block_t blocks[2];
+    uint32_t measurement_record_length;
+    uint8_t measurement_record[LIBSPDM_MAX_MEASUREMENT_RECORD_SIZE];
+
+    spdm_test_context = *state;
+    spdm_context = spdm_test_context->spdm_context;
+    spdm_test_context->case_id = 0x2A;
+    spdm_context->connection_info.version = SPDM_MESSAGE_VERSION_12 <<
+                                            SPDM_VERSION_NUMBER_SHIFT_BIT;
+    spdm_context->connection_info.connection_state =
+        LIBSPDM_CONNECTION_STATE_AUTHENTICATED;
+    spdm_context->connection_info.capability.flags |=
+        SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP_SIG;
+
+    libspdm_reset_message_m(spdm_context, NULL);
+    m_libspdm_local_buffer_size = 0;
+    spdm_context->connection_info.algorithm.measurement_spec =
+        m_libspdm_use_measurement_spec;
+    spdm_context->connection_info.algorithm.measurement_hash_algo =
+        m_libspdm_use_measurement_hash_algo;
+    spdm_context->connection_info.algorithm.base_hash_algo =
+        m_libspdm_use_hash_algo;
+    spdm_context->connection_info.algorithm.base_asym_algo =
+        m_libspdm_use_asym_algo;
+
+    for (m_libspdm_get_measurements_test_short_record = 0;
+         m_libspdm_get_measurements_test_short_record < 2;
+         m_libspdm_get_measurements_test_short_record++) {
+        libspdm_zero_mem(blocks, sizeof(blocks));
+        number_of_blocks = LIBSPDM_ARRAY_SIZE(blocks);
+        measurement_record_length = sizeof(measurement_record);
+        status = libspdm_get_measurement_blocks(
+            spdm_context, NULL, 0, 0, NULL, &number_of_blocks, blocks,
+            &measurement_record_length, measurement_record);
+        assert_int_equal(status, LIBSPDM_STATUS_INVALID_MSG_FIELD);
+        assert_null(blocks[0].measurement);
+    }
+}
+
+#if LIBSPDM_MEASUREMENT_CACHE_SUPPORT
+/**
+ * Test 44: a signed libspdm_get_measurement between two libspdm_get_measurement_blocks_cached.
+ * Expected Behavior: the direct signed request drops the kept blocks, so the second call gets the
+ * blocks from the device instead of probing for a change since the direct request.
+ **/
+static void libspdm_test_requester_get_measurements_case44(void **state)
+{
+    libspdm_return_t status;
+    libspdm_test_context_t *spdm_test_context;
+    libspdm_context_t *spdm_context;
+    uint8_t number_of_blocks;
+    libspdm_measurement_block_t blocks[2];
+    uint32_t measurement_record_length;
+    uint8_t measurement_record[LIBSPDM_MAX_MEASUREMENT_RECORD_SIZE];
+    uint8_t content_changed;
+    void *data;
+    size_t data_size;
+
+    spdm_test_context = *state;
+    spdm_context = spdm_test_context->spdm_context;
+    spdm_test_context->case_id = 0x29;
+    spdm_context->connection_info.version = SPDM_MESSAGE_VERSION_12 <<
+                                            SPDM_VERSION_NUMBER_SHIFT_BIT;
+    spdm_context->connection_info.connection_state =
+        LIBSPDM_CONNECTION_STATE_AUTHENTICATED;
+    spdm_context->connection_info.capability.flags |=
+        SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP_SIG;
+    spdm_context->connection_info.capability.flags |=
+        SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_PUB_KEY_ID_CAP;
+    libspdm_read_responder_public_key(m_libspdm_use_asym_algo, &data, &data_size);
+    spdm_context->local_context.peer_public_key_provision = data;
+    spdm_context->local_context.peer_public_key_provision_size = data_size;
+
+    libspdm_reset_message_m(spdm_context, NULL);
+    m_libspdm_local_buffer_size = 0;
+    spdm_context->connection_info.algorithm.measurement_spec =
+        m_libspdm_use_measurement_spec;
+    spdm_context->connection_info.algorithm.measurement_hash_algo =
+        m_libspdm_use_measurement_hash_algo;
+    spdm_context->connection_info.algorithm.base_hash_algo =
+        m_libspdm_use_hash_algo;
+    spdm_context->connection_info.algorithm.base_asym_algo =
+        m_libspdm_use_asym_algo;
+    spdm_context->connection_info.measurement_cache.valid = false;
+    m_libspdm_get_measurements_test_content_changed =
+        SPDM_MEASUREMENTS_RESPONSE_CONTENT_NO_CHANGE_DETECTED;
+
+    number_of_blocks = LIBSPDM_ARRAY_SIZE(blocks);
+    measurement_record_length = sizeof(measurement_record);
+    status = libspdm_get_measurement_blocks_cached(
+        spdm_context, NULL, SPDM_GET_MEASUREMENTS_REQUEST_ATTRIBUTES_GENERATE_SIGNATURE, 0xF,
+        NULL, &content_changed, &number_of_blocks, blocks, &measurement_record_length,
+        measurement_record);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    assert_true(spdm_context->connection_info.measurement_cache.valid);
+
+    number_of_blocks = 0;
+    measurement_record_length = sizeof(measurement_record);
+    status = libspdm_get_measurement(
+        spdm_context, NULL, SPDM_GET_MEASUREMENTS_REQUEST_ATTRIBUTES_GENERATE_SIGNATURE,
+        SPDM_GET_MEASUREMENTS_REQUEST_MEASUREMENT_OPERATION_ALL_MEASUREMENTS, 0xF, NULL,
+        &number_of_blocks, &measurement_record_length, measurement_record);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    assert_false(spdm_context->connection_info.measurement_cache.valid);
+
+    m_libspdm_get_measurements_test_request_count = 0;
+    number_of_blocks = LIBSPDM_ARRAY_SIZE(blocks);
+    measurement_record_length = sizeof(measurement_record);
+    status = libspdm_get_measurement_blocks_cached(
+        spdm_context, NULL, SPDM_GET_MEASUREMENTS_REQUEST_ATTRIBUTES_GENERATE_SIGNATURE, 0xF,
+        NULL, &content_changed, &number_of_blocks, blocks, &measurement_record_length,
+        measurement_record);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    assert_int_equal(m_libspdm_get_measurements_test_request_count, 1);
+    assert_int_equal(m_libspdm_get_measurements_test_operation,
+                     SPDM_GET_MEASUREMENTS_REQUEST_MEASUREMENT_OPERATION_ALL_MEASUREMENTS);
+    assert_int_equal(number_of_blocks, 2);
+    assert_true(spdm_context->connection_info.measurement_cache.valid);
+
+    m_libspdm_get_measurements_test_content_changed = 0;
+    free(data);
+}
+#endif /* LIBSPDM_MEASUREMENT_CACHE_SUPPORT */
+
 libspdm_test_context_t m_libspdm_requester_get_measurements_test_context = {
     LIBSPDM_TEST_CONTEXT_VERSION,
     true,
@@ -5825,6 +6572,18 @@ int libspdm_requester_get_measurements_test_main(void)
         cmocka_unit_test(libspdm_test_requester_get_measurements_case36),
         cmocka_unit_test(libspdm_test_requester_get_measurements_case37),
         cmocka_unit_test(libspdm_test_requester_get_measurements_case38),
+        cmocka_unit_test(libspdm_test_requester_get_measurements_case39),
+        cmocka_unit_test(libspdm_test_requester_get_measurements_case40),
+#if LIBSPDM_MEASUREMENT_CACHE_SUPPORT
+        cmocka_unit_test(libspdm_test_requester_get_measurements_case41),
+#endif /* LIBSPDM_MEASUREMENT_CACHE_SUPPORT */
+#if LIBSPDM_TRACE_SUPPORT
+        cmocka_unit_test(libspdm_test_requester_get_measurements_case42),
+#endif /* LIBSPDM_TRACE_SUPPORT */
+        cmocka_unit_test(libspdm_test_requester_get_measurements_case43),
+#if LIBSPDM_MEASUREMENT_CACHE_SUPPORT
+        cmocka_unit_test(libspdm_test_requester_get_measurements_case44),
+#endif /* LIBSPDM_MEASUREMENT_CACHE_SUPPORT */
     };
 
     libspdm_setup_test_context(&m_libspdm_requester_get_measurements_test_context);
@@ -19,6 +19,12 @@ typedef struct {
 static size_t m_libspdm_local_buffer_size;
 static uint8_t m_libspdm_local_buffer[LIBSPDM_MAX_MESSAGE_VCA_BUFFER_SIZE];
 
+#if LIBSPDM_ADAPTIVE_RETRY_SUPPORT
+/* The number of requests sent, and of Busy responses before the VERSION response. */
+static size_t m_libspdm_get_version_test_request_count;
+static size_t m_libspdm_get_version_test_busy_count;
+#endif /* LIBSPDM_ADAPTIVE_RETRY_SUPPORT */
+
 static libspdm_return_t libspdm_requester_get_version_test_send_message(
     void *spdm_context, size_t request_size, const void *request,
     uint64_t timeout)
@@ -70,6 +76,11 @@ static libspdm_return_t libspdm_requester_get_version_test_send_message(
         return LIBSPDM_STATUS_SUCCESS;
     case 0x12:
         return LIBSPDM_STATUS_SUCCESS;
+#if LIBSPDM_ADAPTIVE_RETRY_SUPPORT
+    case 0x13:
+        m_libspdm_get_version_test_request_count++;
+        return LIBSPDM_STATUS_SUCCESS;
+#endif /* LIBSPDM_ADAPTIVE_RETRY_SUPPORT */
     default:
         return LIBSPDM_STATUS_SEND_FAIL;
     }
@@ -525,6 +536,44 @@ static libspdm_return_t libspdm_requester_get_version_test_receive_message(
     }
         return LIBSPDM_STATUS_SUCCESS;
 
+#if LIBSPDM_ADAPTIVE_RETRY_SUPPORT
+    case 0x13: {
+        size_t transport_header_size;
+
+        transport_header_size = libspdm_transport_test_get_header_size(spdm_context);
+        if (m_libspdm_get_version_test_request_count <= m_libspdm_get_version_test_busy_count) {
+            spdm_error_response_t *spdm_response;
+
+            spdm_response = (void *)((uint8_t *)*response + transport_header_size);
+            libspdm_zero_mem(spdm_response, sizeof(spdm_error_response_t));
+            spdm_response->header.spdm_version = SPDM_MESSAGE_VERSION_10;
+            spdm_response->header.request_response_code = SPDM_ERROR;
+            spdm_response->header.param1 = SPDM_ERROR_CODE_BUSY;
+            spdm_response->header.param2 = 0;
+            libspdm_transport_test_encode_message(spdm_context, NULL, false, false,
+                                                  sizeof(spdm_error_response_t), spdm_response,
+                                                  response_size, response);
+        } else {
+            libspdm_version_response_mine_t *spdm_response;
+            size_t spdm_response_size;
+
+            spdm_response_size = sizeof(spdm_version_response_t) +
+                                 2 * sizeof(spdm_version_number_t);
+            spdm_response = (void *)((uint8_t *)*response + transport_header_size);
+            libspdm_zero_mem(spdm_response, spdm_response_size);
+            spdm_response->header.spdm_version = SPDM_MESSAGE_VERSION_10;
+            spdm_response->header.request_response_code = SPDM_VERSION;
+            spdm_response->version_number_entry_count = 2;
+            spdm_response->version_number_entry[0] = 0x10 << SPDM_VERSION_NUMBER_SHIFT_BIT;
+            spdm_response->version_number_entry[1] = 0x11 << SPDM_VERSION_NUMBER_SHIFT_BIT;
+            libspdm_transport_test_encode_message(spdm_context, NULL, false, false,
+                                                  spdm_response_size, spdm_response,
+                                                  response_size, response);
+        }
+    }
+        return LIBSPDM_STATUS_SUCCESS;
+#endif /* LIBSPDM_ADAPTIVE_RETRY_SUPPORT */
+
     default:
         return LIBSPDM_STATUS_RECEIVE_FAIL;
     }
@@ -788,6 +837,102 @@ static void libspdm_test_requester_get_version_case16(void **state)
  * }
  */
 
+#if LIBSPDM_ADAPTIVE_RETRY_SUPPORT
+/**
+ * Test 19: receiving Busy ERROR messages with the adaptive retry policy.
+ * Expected behavior: the time the peer stays Busy is learned, the delays are bounded by
+ * LIBSPDM_DATA_REQUEST_RETRY_MAX_DELAY_TIME, and LIBSPDM_DATA_REQUEST_RETRY_DEADLINE stops the
+ * retries before LIBSPDM_DATA_REQUEST_RETRY_TIMES.
+ **/
+static void libspdm_test_requester_get_version_case19(void **state)
+{
+    libspdm_return_t status;
+    libspdm_test_context_t *spdm_test_context;
+    libspdm_context_t *spdm_context;
+    libspdm_data_parameter_t parameter;
+    uint64_t data64;
+    size_t data_size;
+    uint8_t retry_times;
+#if LIBSPDM_STATISTICS_SUPPORT
+    static libspdm_statistics_t statistics;
+#endif /* LIBSPDM_STATISTICS_SUPPORT */
+
+    spdm_test_context = *state;
+    spdm_context = spdm_test_context->spdm_context;
+    spdm_test_context->case_id = 0x13;
+
+    libspdm_zero_mem(&parameter, sizeof(parameter));
+    parameter.location = LIBSPDM_DATA_LOCATION_LOCAL;
+    retry_times = 3;
+    libspdm_set_data(spdm_context, LIBSPDM_DATA_REQUEST_RETRY_TIMES, &parameter,
+                     &retry_times, sizeof(retry_times));
+    data64 = 100;
+    libspdm_set_data(spdm_context, LIBSPDM_DATA_REQUEST_RETRY_DELAY_TIME, &parameter,
+                     &data64, sizeof(data64));
+    data64 = 200;
+    status = libspdm_set_data(spdm_context, LIBSPDM_DATA_REQUEST_RETRY_MAX_DELAY_TIME,
+                              &parameter, &data64, sizeof(data64));
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    data64 = 0;
+    data_size = sizeof(data64);
+    status = libspdm_get_data(spdm_context, LIBSPDM_DATA_REQUEST_RETRY_MAX_DELAY_TIME,
+                              &parameter, &data64, &data_size);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    assert_int_equal(data64, 200);
+#if LIBSPDM_STATISTICS_SUPPORT
+    libspdm_zero_mem(&spdm_context->statistics, sizeof(spdm_context->statistics));
+#endif /* LIBSPDM_STATISTICS_SUPPORT */
+
+    /* Busy twice, then the VERSION response. The peer stays Busy for at least the two delays of
+     * at least half of LIBSPDM_DATA_REQUEST_RETRY_DELAY_TIME. */
+    m_libspdm_get_version_test_request_count = 0;
+    m_libspdm_get_version_test_busy_count = 2;
+    status = libspdm_get_version(spdm_context, NULL, NULL);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    assert_int_equal(m_libspdm_get_version_test_request_count, 3);
+    assert_true(spdm_context->retry_policy.busy_time_us >= 100);
+    assert_false(spdm_context->retry_policy.retry_pending);
+#if LIBSPDM_STATISTICS_SUPPORT
+    assert_int_equal(spdm_context->statistics.busy_retry_delay.count, 2);
+    assert_true(spdm_context->statistics.busy_retry_delay.min_us >= 50);
+    assert_true(spdm_context->statistics.busy_retry_delay.max_us <= 200);
+#endif /* LIBSPDM_STATISTICS_SUPPORT */
+
+    /* Always Busy, the deadline stops the retries. */
+    retry_times = 0xFF;
+    libspdm_set_data(spdm_context, LIBSPDM_DATA_REQUEST_RETRY_TIMES, &parameter,
+                     &retry_times, sizeof(retry_times));
+    data64 = 1000;
+    libspdm_set_data(spdm_context, LIBSPDM_DATA_REQUEST_RETRY_DEADLINE, &parameter,
+                     &data64, sizeof(data64));
+    m_libspdm_get_version_test_request_count = 0;
+    m_libspdm_get_version_test_busy_count = (size_t)-1;
+    status = libspdm_get_version(spdm_context, NULL, NULL);
+    assert_int_equal(status, LIBSPDM_STATUS_BUSY_PEER);
+    assert_true(m_libspdm_get_version_test_request_count < (size_t)retry_times + 1);
+#if LIBSPDM_STATISTICS_SUPPORT
+    parameter.location = LIBSPDM_DATA_LOCATION_LOCAL;
+    data_size = sizeof(statistics);
+    status = libspdm_get_data(spdm_context, LIBSPDM_DATA_STATISTICS, &parameter,
+                              &statistics, &data_size);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    assert_int_equal(statistics.busy_retry_delay.count,
+                     2 + m_libspdm_get_version_test_request_count - 1);
+#endif /* LIBSPDM_STATISTICS_SUPPORT */
+
+    retry_times = 0;
+    libspdm_set_data(spdm_context, LIBSPDM_DATA_REQUEST_RETRY_TIMES, &parameter,
+                     &retry_times, sizeof(retry_times));
+    data64 = 0;
+    libspdm_set_data(spdm_context, LIBSPDM_DATA_REQUEST_RETRY_DELAY_TIME, &parameter,
+                     &data64, sizeof(data64));
+    libspdm_set_data(spdm_context, LIBSPDM_DATA_REQUEST_RETRY_MAX_DELAY_TIME, &parameter,
+                     &data64, sizeof(data64));
+    libspdm_set_data(spdm_context, LIBSPDM_DATA_REQUEST_RETRY_DEADLINE, &parameter,
+                     &data64, sizeof(data64));
+}
+#endif /* LIBSPDM_ADAPTIVE_RETRY_SUPPORT */
+
 libspdm_test_context_t m_libspdm_requester_get_version_test_context = {
     LIBSPDM_TEST_CONTEXT_VERSION,
     true,
@@ -816,6 +961,9 @@ int libspdm_requester_get_version_test_main(void)
         cmocka_unit_test(libspdm_test_requester_get_version_case16),
         /* cmocka_unit_test(libspdm_test_requester_get_version_case17),
          * cmocka_unit_test(libspdm_test_requester_get_version_case18), */
+#if LIBSPDM_ADAPTIVE_RETRY_SUPPORT
+        cmocka_unit_test(libspdm_test_requester_get_version_case19),
+#endif /* LIBSPDM_ADAPTIVE_RETRY_SUPPORT */
     };
 
     libspdm_setup_test_context(&m_libspdm_requester_get_version_test_context);
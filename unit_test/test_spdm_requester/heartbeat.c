@@ -11,6 +11,12 @@
 static uint8_t m_libspdm_dummy_key_buffer[LIBSPDM_MAX_AEAD_KEY_SIZE];
 static uint8_t m_libspdm_dummy_salt_buffer[LIBSPDM_MAX_AEAD_IV_SIZE];
 
+/* The secured request sent in case 14, the buffer it was built in, and whether the scratch
+ * buffer was left untouched. */
+static const void *m_libspdm_heartbeat_sent_request;
+static const uint8_t *m_libspdm_heartbeat_sender_buffer;
+static bool m_libspdm_heartbeat_scratch_untouched;
+
 void libspdm_secured_message_set_response_data_encryption_key(
     void *spdm_secured_message_context, const void *key, size_t key_size)
 {
@@ -69,6 +75,30 @@ libspdm_return_t libspdm_requester_heartbeat_test_send_message(void *spdm_contex
         return LIBSPDM_STATUS_SUCCESS;
     case 0xC:
         return LIBSPDM_STATUS_SUCCESS;
+    case 0xE: {
+        uint8_t *scratch_buffer;
+        size_t scratch_buffer_size;
+        size_t transport_header_size;
+        size_t index;
+
+        /* The request was encoded in place, so nothing was copied to the scratch buffer. */
+        m_libspdm_heartbeat_sent_request = request;
+        transport_header_size = libspdm_transport_test_get_header_size(spdm_context);
+        libspdm_get_scratch_buffer(spdm_context, (void **)&scratch_buffer, &scratch_buffer_size);
+#if LIBSPDM_ENABLE_CAPABILITY_CHUNK_CAP
+        m_libspdm_heartbeat_sender_buffer =
+            scratch_buffer + libspdm_get_scratch_buffer_large_sender_receiver_offset(spdm_context);
+#else
+        m_libspdm_heartbeat_sender_buffer = ((libspdm_context_t *)spdm_context)->sender_buffer;
+#endif /* LIBSPDM_ENABLE_CAPABILITY_CHUNK_CAP */
+        m_libspdm_heartbeat_scratch_untouched = true;
+        for (index = 0; index < sizeof(spdm_heartbeat_request_t); index++) {
+            if (scratch_buffer[transport_header_size + index] != 0xA5) {
+                m_libspdm_heartbeat_scratch_untouched = false;
+            }
+        }
+    }
+        return LIBSPDM_STATUS_SUCCESS;
     default:
         return LIBSPDM_STATUS_SEND_FAIL;
     }
@@ -85,7 +115,8 @@ libspdm_return_t libspdm_requester_heartbeat_test_receive_message(
     case 0x1:
         return LIBSPDM_STATUS_RECEIVE_FAIL;
 
-    case 0x2: {
+    case 0x2:
+    case 0xE: {
         spdm_heartbeat_response_t *spdm_response;
         size_t spdm_response_size;
         size_t transport_header_size;
@@ -1924,6 +1955,86 @@ void libspdm_test_requester_heartbeat_case13(void **state)
     free(data);
 }
 
+/**
+ * Test 14: a secured request built at the transport header size in the sender buffer is encoded
+ * in place, without a copy to the scratch buffer.
+ **/
+void libspdm_test_requester_heartbeat_case14(void **state)
+{
+    libspdm_return_t status;
+    libspdm_test_context_t *spdm_test_context;
+    libspdm_context_t *spdm_context;
+    uint32_t session_id;
+    libspdm_session_info_t *session_info;
+    libspdm_secured_message_context_t *secured_message_context;
+    uint8_t *scratch_buffer;
+    size_t scratch_buffer_size;
+    size_t transport_header_size;
+    size_t secured_message_header_size;
+
+    spdm_test_context = *state;
+    spdm_context = spdm_test_context->spdm_context;
+    spdm_test_context->case_id = 0xE;
+    spdm_context->connection_info.version = SPDM_MESSAGE_VERSION_11 <<
+                                            SPDM_VERSION_NUMBER_SHIFT_BIT;
+    spdm_context->connection_info.connection_state = LIBSPDM_CONNECTION_STATE_NEGOTIATED;
+    spdm_context->connection_info.capability.flags |=
+        SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_HBEAT_CAP;
+    spdm_context->connection_info.capability.flags |=
+        SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_ENCRYPT_CAP;
+    spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MAC_CAP;
+    spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_HBEAT_CAP;
+    spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
+    spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
+    libspdm_reset_message_a(spdm_context);
+    spdm_context->connection_info.algorithm.base_hash_algo = m_libspdm_use_hash_algo;
+    spdm_context->connection_info.algorithm.base_asym_algo = m_libspdm_use_asym_algo;
+    spdm_context->connection_info.algorithm.dhe_named_group = m_libspdm_use_dhe_algo;
+    spdm_context->connection_info.algorithm.aead_cipher_suite = m_libspdm_use_aead_algo;
+
+    session_id = 0xFFFFFFFF;
+    session_info = &spdm_context->session_info[0];
+    libspdm_session_info_init(spdm_context, session_info, session_id, true);
+    libspdm_secured_message_set_session_state(
+        session_info->secured_message_context,
+        LIBSPDM_SESSION_STATE_ESTABLISHED);
+    session_info->heartbeat_period = 1;
+    secured_message_context = session_info->secured_message_context;
+    libspdm_set_mem(m_libspdm_dummy_key_buffer, secured_message_context->aead_key_size,
+                    (uint8_t)(0xFF));
+    libspdm_secured_message_set_response_data_encryption_key(
+        secured_message_context, m_libspdm_dummy_key_buffer,
+        secured_message_context->aead_key_size);
+    libspdm_set_mem(m_libspdm_dummy_salt_buffer, secured_message_context->aead_iv_size,
+                    (uint8_t)(0xFF));
+    libspdm_secured_message_set_response_data_salt(
+        secured_message_context, m_libspdm_dummy_salt_buffer,
+        secured_message_context->aead_iv_size);
+    secured_message_context->application_secret.response_data_sequence_number = 0;
+
+    transport_header_size = libspdm_transport_test_get_header_size(spdm_context);
+    libspdm_get_scratch_buffer(spdm_context, (void **)&scratch_buffer, &scratch_buffer_size);
+    libspdm_set_mem(scratch_buffer + transport_header_size, sizeof(spdm_heartbeat_request_t),
+                    0xA5);
+    m_libspdm_heartbeat_sent_request = NULL;
+    m_libspdm_heartbeat_sender_buffer = NULL;
+    m_libspdm_heartbeat_scratch_untouched = false;
+
+    status = libspdm_heartbeat(spdm_context, session_id);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    assert_true(m_libspdm_heartbeat_scratch_untouched);
+
+    /* The secured message header and both test headers are placed in front of the request. */
+    secured_message_header_size = sizeof(spdm_secured_message_a_data_header1_t) +
+                                  LIBSPDM_TEST_SEQUENCE_NUMBER_COUNT +
+                                  sizeof(spdm_secured_message_a_data_header2_t) +
+                                  sizeof(spdm_secured_message_cipher_header_t);
+    assert_ptr_equal(m_libspdm_heartbeat_sent_request,
+                     m_libspdm_heartbeat_sender_buffer + transport_header_size -
+                     sizeof(libspdm_test_message_header_t) - secured_message_header_size -
+                     sizeof(libspdm_test_message_header_t));
+}
+
 libspdm_test_context_t m_libspdm_requester_heartbeat_test_context = {
     LIBSPDM_TEST_CONTEXT_VERSION,
     true,
@@ -1959,6 +2070,8 @@ int libspdm_requester_heartbeat_test_main(void)
         /* Error response: SPDM_ERROR_CODE_DECRYPT_ERROR*/
         cmocka_unit_test(libspdm_test_requester_heartbeat_case12),
         cmocka_unit_test(libspdm_test_requester_heartbeat_case13),
+        /* Secured request is encoded in place */
+        cmocka_unit_test(libspdm_test_requester_heartbeat_case14),
     };
 
     libspdm_setup_test_context(&m_libspdm_requester_heartbeat_test_context);
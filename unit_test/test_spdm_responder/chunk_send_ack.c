@@ -1703,6 +1703,167 @@ void libspdm_test_responder_chunk_send_ack_rsp_case19(void** state)
     libspdm_test_responder_chunk_send_ack_reset_send_state(spdm_context);
 }
 
+#define CHUNK_SEND_ACK_RESPONDER_UNIT_TEST_VENDOR_PAYLOAD_SIZE (100)
+
+libspdm_return_t libspdm_test_responder_chunk_send_ack_vendor_response_func(
+    void *spdm_context, const uint32_t *session_id, bool is_app_message,
+    size_t request_size, const void *request, size_t *response_size,
+    void *response)
+{
+    const spdm_vendor_defined_request_msg_t *spdm_request;
+    spdm_vendor_defined_response_msg_t *spdm_response;
+
+    spdm_request = request;
+    if (is_app_message ||
+        (request_size != sizeof(spdm_vendor_defined_request_msg_t) + sizeof(uint16_t) +
+         CHUNK_SEND_ACK_RESPONDER_UNIT_TEST_VENDOR_PAYLOAD_SIZE) ||
+        (spdm_request->header.request_response_code != SPDM_VENDOR_DEFINED_REQUEST)) {
+        return LIBSPDM_STATUS_UNSUPPORTED_CAP;
+    }
+
+    spdm_response = response;
+    spdm_response->header.spdm_version = spdm_request->header.spdm_version;
+    spdm_response->header.request_response_code = SPDM_VENDOR_DEFINED_RESPONSE;
+    spdm_response->header.param1 = 0;
+    spdm_response->header.param2 = 0;
+    spdm_response->standard_id = SPDM_REGISTRY_ID_DMTF;
+    spdm_response->len = 0;
+    *(uint16_t *)(spdm_response + 1) = 0;
+    *response_size = sizeof(spdm_vendor_defined_response_msg_t) + sizeof(uint16_t);
+    return LIBSPDM_STATUS_SUCCESS;
+}
+
+/**
+ * Test 20: Large VENDOR_DEFINED_REQUEST sent in multiple chunks.
+ * Expected Behavior: The request is passed to the registered get_response_func and its
+ * VENDOR_DEFINED_RESPONSE follows the last CHUNK_SEND_ACK.
+ **/
+void libspdm_test_responder_chunk_send_ack_rsp_case20(void** state)
+{
+    libspdm_return_t status;
+
+    libspdm_test_context_t* spdm_test_context;
+    libspdm_context_t* spdm_context;
+
+    size_t request_size;
+    size_t response_size;
+
+    uint8_t request[LIBSPDM_MAX_SPDM_MSG_SIZE];
+    uint8_t response[LIBSPDM_MAX_SPDM_MSG_SIZE];
+    uint8_t vendor_request[sizeof(spdm_vendor_defined_request_msg_t) + sizeof(uint16_t) +
+                           CHUNK_SEND_ACK_RESPONDER_UNIT_TEST_VENDOR_PAYLOAD_SIZE];
+
+    spdm_vendor_defined_request_msg_t *vendor_request_header;
+    spdm_chunk_send_request_t* chunk_send_request;
+    spdm_chunk_send_ack_response_t* chunk_send_ack_response;
+    spdm_vendor_defined_response_msg_t *vendor_response;
+
+    const uint8_t* chunk_src;
+    uint8_t* chunk_dst;
+    uint16_t chunk_num;
+    uint32_t bytes_sent;
+    uint32_t bytes_total;
+
+    spdm_test_context = *state;
+    spdm_context = spdm_test_context->spdm_context;
+    spdm_test_context->case_id = 20;
+
+    libspdm_test_responder_chunk_send_ack_setup_algo_state(spdm_context);
+    spdm_context->connection_info.connection_state = LIBSPDM_CONNECTION_STATE_NEGOTIATED;
+    libspdm_register_get_response_func(
+        spdm_context, libspdm_test_responder_chunk_send_ack_vendor_response_func);
+
+    libspdm_set_mem(vendor_request, sizeof(vendor_request), 0xA5);
+    vendor_request_header = (spdm_vendor_defined_request_msg_t *)vendor_request;
+    vendor_request_header->header.spdm_version = SPDM_MESSAGE_VERSION_12;
+    vendor_request_header->header.request_response_code = SPDM_VENDOR_DEFINED_REQUEST;
+    vendor_request_header->header.param1 = 0;
+    vendor_request_header->header.param2 = 0;
+    vendor_request_header->standard_id = SPDM_REGISTRY_ID_DMTF;
+    vendor_request_header->len = 0;
+    *(uint16_t *)(vendor_request_header + 1) =
+        CHUNK_SEND_ACK_RESPONDER_UNIT_TEST_VENDOR_PAYLOAD_SIZE;
+
+    chunk_num = 0;
+    bytes_sent = 0;
+    bytes_total = sizeof(vendor_request);
+    chunk_src = vendor_request;
+
+    do {
+        libspdm_zero_mem(request, sizeof(request));
+        chunk_send_request = (spdm_chunk_send_request_t*)request;
+
+        chunk_send_request->header.spdm_version = SPDM_MESSAGE_VERSION_12;
+        chunk_send_request->header.request_response_code = SPDM_CHUNK_SEND;
+        chunk_send_request->header.param1 = 0;
+        chunk_send_request->header.param2 = (uint8_t) spdm_test_context->case_id; /* chunk_handle */
+        chunk_send_request->chunk_seq_no = chunk_num;
+
+        if (chunk_num == 0) {
+            *((uint32_t*) (chunk_send_request + 1)) = bytes_total;
+            chunk_send_request->chunk_size =
+                spdm_context->local_context.capability.data_transfer_size
+                - sizeof(spdm_chunk_send_request_t) - sizeof(uint32_t);
+
+            chunk_dst = ((uint8_t*) (chunk_send_request + 1)) + sizeof(uint32_t);
+
+            request_size = sizeof(spdm_chunk_send_request_t)
+                           + sizeof(uint32_t)
+                           + chunk_send_request->chunk_size;
+        }
+        else {
+            chunk_send_request->chunk_size =
+                LIBSPDM_MIN(
+                    spdm_context->local_context.capability.data_transfer_size
+                    - sizeof(spdm_chunk_send_request_t),
+                    bytes_total - bytes_sent);
+
+            chunk_dst = ((uint8_t*) (chunk_send_request + 1));
+
+            request_size = sizeof(spdm_chunk_send_request_t)
+                           + chunk_send_request->chunk_size;
+
+            if (bytes_total - bytes_sent == chunk_send_request->chunk_size) {
+                chunk_send_request->header.param1 = SPDM_CHUNK_SEND_REQUEST_ATTRIBUTE_LAST_CHUNK;
+            }
+        }
+
+        libspdm_copy_mem(chunk_dst, chunk_send_request->chunk_size,
+                         chunk_src, chunk_send_request->chunk_size);
+
+        chunk_src += chunk_send_request->chunk_size;
+        bytes_sent += chunk_send_request->chunk_size;
+        chunk_num++;
+
+        response_size = sizeof(response);
+        status = libspdm_get_response_chunk_send(
+            spdm_context,
+            request_size, request,
+            &response_size, response);
+
+        assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+        assert_true(response_size >= sizeof(spdm_chunk_send_ack_response_t));
+
+        chunk_send_ack_response = (spdm_chunk_send_ack_response_t*) response;
+        assert_int_equal(chunk_send_ack_response->header.request_response_code,
+                         SPDM_CHUNK_SEND_ACK);
+        assert_int_equal(chunk_send_ack_response->header.param1, 0);
+        assert_int_equal(chunk_send_ack_response->chunk_seq_no, chunk_send_request->chunk_seq_no);
+
+    } while (bytes_sent < bytes_total);
+
+    assert_int_equal(response_size, sizeof(spdm_chunk_send_ack_response_t) +
+                     sizeof(spdm_vendor_defined_response_msg_t) + sizeof(uint16_t));
+    vendor_response = (spdm_vendor_defined_response_msg_t *)(chunk_send_ack_response + 1);
+    assert_int_equal(vendor_response->header.spdm_version, SPDM_MESSAGE_VERSION_12);
+    assert_int_equal(vendor_response->header.request_response_code,
+                     SPDM_VENDOR_DEFINED_RESPONSE);
+    assert_int_equal(vendor_response->standard_id, SPDM_REGISTRY_ID_DMTF);
+
+    libspdm_register_get_response_func(spdm_context, NULL);
+    libspdm_test_responder_chunk_send_ack_reset_send_state(spdm_context);
+}
+
 libspdm_test_context_t m_libspdm_responder_chunk_send_ack_rsp_test_context = {
     LIBSPDM_TEST_CONTEXT_VERSION,
     false,
@@ -1753,6 +1914,8 @@ int libspdm_responder_chunk_send_ack_test_main(void)
         cmocka_unit_test(libspdm_test_responder_chunk_send_ack_rsp_case18),
         /* Request missing LAST_CHUNK when request size != data transfer size. */
         cmocka_unit_test(libspdm_test_responder_chunk_send_ack_rsp_case19),
+        /* Large vendor defined request is passed to the registered get_response_func. */
+        cmocka_unit_test(libspdm_test_responder_chunk_send_ack_rsp_case20),
     };
 
     libspdm_setup_test_context(&m_libspdm_responder_chunk_send_ack_rsp_test_context);
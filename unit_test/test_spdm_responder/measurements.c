@@ -1720,6 +1720,255 @@ void libspdm_test_responder_measurements_case28(void **state)
     free(data);
 }
 
+/**
+ * Test 29: the measurements are invalidated between an unsigned and a signed GET_MEASUREMENTS
+ * Expected Behavior: the signed response reports a content change, a later one does not
+ **/
+void libspdm_test_responder_measurements_case29(void **state)
+{
+    libspdm_return_t status;
+    libspdm_test_context_t *spdm_test_context;
+    libspdm_context_t *spdm_context;
+    size_t response_size;
+    uint8_t response[LIBSPDM_MAX_SPDM_MSG_SIZE];
+    spdm_measurements_response_t *spdm_response;
+    spdm_get_measurements_request_t get_measurements_request;
+    void *data;
+    size_t data_size;
+
+    spdm_test_context = *state;
+    spdm_context = spdm_test_context->spdm_context;
+    spdm_test_context->case_id = 0x1D;
+    spdm_context->connection_info.connection_state =
+        LIBSPDM_CONNECTION_STATE_AUTHENTICATED;
+    spdm_context->local_context.capability.flags |=
+        SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP_SIG;
+    spdm_context->connection_info.algorithm.base_hash_algo =
+        m_libspdm_use_hash_algo;
+    spdm_context->connection_info.algorithm.base_asym_algo =
+        m_libspdm_use_asym_algo;
+    spdm_context->connection_info.algorithm.measurement_hash_algo =
+        m_libspdm_use_measurement_hash_algo;
+    spdm_context->connection_info.algorithm.measurement_spec =
+        m_libspdm_use_measurement_spec;
+    spdm_context->connection_info.version = SPDM_MESSAGE_VERSION_12 <<
+                                            SPDM_VERSION_NUMBER_SHIFT_BIT;
+    libspdm_reset_message_m(spdm_context, NULL);
+    spdm_context->local_context.opaque_measurement_rsp_size = 0;
+    spdm_context->local_context.opaque_measurement_rsp = NULL;
+    libspdm_read_responder_public_certificate_chain(m_libspdm_use_hash_algo,
+                                                    m_libspdm_use_asym_algo, &data,
+                                                    &data_size, NULL, NULL);
+    for (int i = 0; i < SPDM_MAX_SLOT_COUNT; i++) {
+        spdm_context->local_context.local_cert_chain_provision_size[i] =
+            data_size;
+        spdm_context->local_context.local_cert_chain_provision[i] =
+            data;
+    }
+    m_libspdm_get_measurements_request15.slot_id_param = 0;
+
+    /* a signed response ends any previous transcript*/
+    response_size = sizeof(response);
+    libspdm_get_random_number(SPDM_NONCE_SIZE,
+                              m_libspdm_get_measurements_request15.nonce);
+    status = libspdm_get_response_measurements(
+        spdm_context, m_libspdm_get_measurements_request15_size,
+        &m_libspdm_get_measurements_request15, &response_size, response);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+
+    /* an unsigned response starts the transcript*/
+    libspdm_zero_mem(&get_measurements_request, sizeof(get_measurements_request));
+    get_measurements_request.header.spdm_version = SPDM_MESSAGE_VERSION_12;
+    get_measurements_request.header.request_response_code = SPDM_GET_MEASUREMENTS;
+    get_measurements_request.header.param1 = 0;
+    get_measurements_request.header.param2 = 1;
+    response_size = sizeof(response);
+    status = libspdm_get_response_measurements(
+        spdm_context, sizeof(spdm_message_header_t),
+        &get_measurements_request, &response_size, response);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    spdm_response = (void *)response;
+    assert_int_equal(spdm_response->header.request_response_code,
+                     SPDM_MEASUREMENTS);
+    assert_int_equal(spdm_response->header.param2 &
+                     SPDM_MEASUREMENTS_RESPONSE_CONTENT_CHANGE_MASK,
+                     SPDM_MEASUREMENTS_RESPONSE_CONTENT_CHANGE_NO_DETECTION);
+
+    /* the firmware is updated*/
+    libspdm_measurement_store_invalidate();
+
+    response_size = sizeof(response);
+    libspdm_get_random_number(SPDM_NONCE_SIZE,
+                              m_libspdm_get_measurements_request15.nonce);
+    status = libspdm_get_response_measurements(
+        spdm_context, m_libspdm_get_measurements_request15_size,
+        &m_libspdm_get_measurements_request15, &response_size, response);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    spdm_response = (void *)response;
+    assert_int_equal(spdm_response->header.request_response_code,
+                     SPDM_MEASUREMENTS);
+    assert_int_equal(spdm_response->header.param2 &
+                     SPDM_MEASUREMENTS_RESPONSE_CONTENT_CHANGE_MASK,
+                     SPDM_MEASUREMENTS_RESPONSE_CONTENT_CHANGE_DETECTED);
+
+    /* the next transcript does not span the update*/
+    response_size = sizeof(response);
+    libspdm_get_random_number(SPDM_NONCE_SIZE,
+                              m_libspdm_get_measurements_request15.nonce);
+    status = libspdm_get_response_measurements(
+        spdm_context, m_libspdm_get_measurements_request15_size,
+        &m_libspdm_get_measurements_request15, &response_size, response);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    spdm_response = (void *)response;
+    assert_int_equal(spdm_response->header.param2 &
+                     SPDM_MEASUREMENTS_RESPONSE_CONTENT_CHANGE_MASK,
+                     SPDM_MEASUREMENTS_RESPONSE_CONTENT_NO_CHANGE_DETECTED);
+
+    free(data);
+}
+
+#if LIBSPDM_MEASUREMENT_COLLECTION_EX_SUPPORT
+/**
+ * Test 30: the measurements are invalidated while one transcript is started
+ * Expected Behavior: only that transcript reports a content change, not another transcript
+ **/
+void libspdm_test_responder_measurements_case30(void **state)
+{
+    libspdm_return_t status;
+    libspdm_test_context_t *spdm_test_context;
+    spdm_version_number_t spdm_version;
+    uint8_t measurements[LIBSPDM_MAX_MEASUREMENT_RECORD_SIZE];
+    size_t measurements_size;
+    uint8_t measurements_count;
+    uint8_t content_changed;
+    uint32_t transcript_state;
+    uint32_t other_transcript_state;
+
+    spdm_test_context = *state;
+    spdm_test_context->case_id = 0x1E;
+    spdm_version = SPDM_MESSAGE_VERSION_12 << SPDM_VERSION_NUMBER_SHIFT_BIT;
+    transcript_state = 0;
+    other_transcript_state = 0;
+
+    /* one transcript is started*/
+    measurements_size = sizeof(measurements);
+    status = libspdm_measurement_collection_ex(
+        spdm_version, m_libspdm_use_measurement_spec,
+        m_libspdm_use_measurement_hash_algo, 1, 0, &content_changed,
+        &measurements_count, measurements, &measurements_size, &transcript_state);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    assert_int_equal(content_changed, SPDM_MEASUREMENTS_RESPONSE_CONTENT_CHANGE_NO_DETECTION);
+
+    /* the firmware is updated*/
+    libspdm_measurement_store_invalidate();
+
+    /* another transcript does not span the update*/
+    measurements_size = sizeof(measurements);
+    status = libspdm_measurement_collection_ex(
+        spdm_version, m_libspdm_use_measurement_spec,
+        m_libspdm_use_measurement_hash_algo, 1,
+        SPDM_GET_MEASUREMENTS_REQUEST_ATTRIBUTES_GENERATE_SIGNATURE, &content_changed,
+        &measurements_count, measurements, &measurements_size, &other_transcript_state);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    assert_int_equal(content_changed, SPDM_MEASUREMENTS_RESPONSE_CONTENT_NO_CHANGE_DETECTED);
+    assert_int_equal(other_transcript_state, 0);
+
+    /* the started transcript spans the update*/
+    measurements_size = sizeof(measurements);
+    status = libspdm_measurement_collection_ex(
+        spdm_version, m_libspdm_use_measurement_spec,
+        m_libspdm_use_measurement_hash_algo, 1,
+        SPDM_GET_MEASUREMENTS_REQUEST_ATTRIBUTES_GENERATE_SIGNATURE, &content_changed,
+        &measurements_count, measurements, &measurements_size, &transcript_state);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    assert_int_equal(content_changed, SPDM_MEASUREMENTS_RESPONSE_CONTENT_CHANGE_DETECTED);
+    assert_int_equal(transcript_state, 0);
+}
+
+/**
+ * Test 31: the measurements are invalidated while a transcript is started, then the transcript
+ * is reset
+ * Expected Behavior: the next signed response does not report a content change
+ **/
+void libspdm_test_responder_measurements_case31(void **state)
+{
+    libspdm_return_t status;
+    libspdm_test_context_t *spdm_test_context;
+    libspdm_context_t *spdm_context;
+    size_t response_size;
+    uint8_t response[LIBSPDM_MAX_SPDM_MSG_SIZE];
+    spdm_measurements_response_t *spdm_response;
+    spdm_get_measurements_request_t get_measurements_request;
+    void *data;
+    size_t data_size;
+
+    spdm_test_context = *state;
+    spdm_context = spdm_test_context->spdm_context;
+    spdm_test_context->case_id = 0x1F;
+    spdm_context->connection_info.connection_state =
+        LIBSPDM_CONNECTION_STATE_AUTHENTICATED;
+    spdm_context->local_context.capability.flags |=
+        SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP_SIG;
+    spdm_context->connection_info.algorithm.base_hash_algo =
+        m_libspdm_use_hash_algo;
+    spdm_context->connection_info.algorithm.base_asym_algo =
+        m_libspdm_use_asym_algo;
+    spdm_context->connection_info.algorithm.measurement_hash_algo =
+        m_libspdm_use_measurement_hash_algo;
+    spdm_context->connection_info.algorithm.measurement_spec =
+        m_libspdm_use_measurement_spec;
+    spdm_context->connection_info.version = SPDM_MESSAGE_VERSION_12 <<
+                                            SPDM_VERSION_NUMBER_SHIFT_BIT;
+    libspdm_reset_message_m(spdm_context, NULL);
+    spdm_context->local_context.opaque_measurement_rsp_size = 0;
+    spdm_context->local_context.opaque_measurement_rsp = NULL;
+    libspdm_read_responder_public_certificate_chain(m_libspdm_use_hash_algo,
+                                                    m_libspdm_use_asym_algo, &data,
+                                                    &data_size, NULL, NULL);
+    for (int i = 0; i < SPDM_MAX_SLOT_COUNT; i++) {
+        spdm_context->local_context.local_cert_chain_provision_size[i] =
+            data_size;
+        spdm_context->local_context.local_cert_chain_provision[i] =
+            data;
+    }
+    m_libspdm_get_measurements_request15.slot_id_param = 0;
+
+    /* an unsigned response starts the transcript*/
+    libspdm_zero_mem(&get_measurements_request, sizeof(get_measurements_request));
+    get_measurements_request.header.spdm_version = SPDM_MESSAGE_VERSION_12;
+    get_measurements_request.header.request_response_code = SPDM_GET_MEASUREMENTS;
+    get_measurements_request.header.param1 = 0;
+    get_measurements_request.header.param2 = 1;
+    response_size = sizeof(response);
+    status = libspdm_get_response_measurements(
+        spdm_context, sizeof(spdm_message_header_t),
+        &get_measurements_request, &response_size, response);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    assert_int_not_equal(spdm_context->transcript.measurement_transcript_state, 0);
+
+    /* the firmware is updated, then the transcript is reset*/
+    libspdm_measurement_store_invalidate();
+    libspdm_reset_message_m(spdm_context, NULL);
+    assert_int_equal(spdm_context->transcript.measurement_transcript_state, 0);
+
+    response_size = sizeof(response);
+    libspdm_get_random_number(SPDM_NONCE_SIZE,
+                              m_libspdm_get_measurements_request15.nonce);
+    status = libspdm_get_response_measurements(
+        spdm_context, m_libspdm_get_measurements_request15_size,
+        &m_libspdm_get_measurements_request15, &response_size, response);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    spdm_response = (void *)response;
+    assert_int_equal(spdm_response->header.request_response_code,
+                     SPDM_MEASUREMENTS);
+    assert_int_equal(spdm_response->header.param2 &
+                     SPDM_MEASUREMENTS_RESPONSE_CONTENT_CHANGE_MASK,
+                     SPDM_MEASUREMENTS_RESPONSE_CONTENT_NO_CHANGE_DETECTED);
+
+    free(data);
+}
+#endif /* LIBSPDM_MEASUREMENT_COLLECTION_EX_SUPPORT */
+
 libspdm_test_context_t m_libspdm_responder_measurements_test_context = {
     LIBSPDM_TEST_CONTEXT_VERSION,
     false,
@@ -1787,6 +2036,14 @@ int libspdm_responder_measurements_test_main(void)
         cmocka_unit_test(libspdm_test_responder_measurements_case27),
         /* Success Case to get measurement with signature using slot_id 0xFF */
         cmocka_unit_test(libspdm_test_responder_measurements_case28),
+        /* Content change detected after the measurements are invalidated */
+        cmocka_unit_test(libspdm_test_responder_measurements_case29),
+        #if LIBSPDM_MEASUREMENT_COLLECTION_EX_SUPPORT
+        /* Content change is tracked per transcript */
+        cmocka_unit_test(libspdm_test_responder_measurements_case30),
+        /* Content change is not reported after the transcript is reset */
+        cmocka_unit_test(libspdm_test_responder_measurements_case31),
+        #endif /* LIBSPDM_MEASUREMENT_COLLECTION_EX_SUPPORT */
     };
 
     libspdm_setup_test_context(&m_libspdm_responder_measurements_test_context);
@@ -21,6 +21,22 @@ libspdm_return_t my_test_get_response_func(
     return LIBSPDM_STATUS_SUCCESS;
 }
 
+#define CHUNK_GET_UNIT_TEST_LARGE_RESPONSE_SIZE (200)
+
+libspdm_return_t my_test_get_large_response_func(
+    void *spdm_context, const uint32_t *session_id, bool is_app_message,
+    size_t request_size, const void *request, size_t *response_size,
+    void *response)
+{
+    size_t index;
+
+    for (index = 0; index < CHUNK_GET_UNIT_TEST_LARGE_RESPONSE_SIZE; index++) {
+        ((uint8_t *)response)[index] = (uint8_t)index;
+    }
+    *response_size = CHUNK_GET_UNIT_TEST_LARGE_RESPONSE_SIZE;
+    return LIBSPDM_STATUS_SUCCESS;
+}
+
 /**
  * Test 1: Test Responder Receive Send flow triggers chunk get mode
  * if response buffer is larger than requester data_transfer_size.
@@ -220,6 +236,173 @@ void libspdm_test_responder_receive_send_rsp_case2(void** state)
     libspdm_release_sender_buffer(spdm_context);
 }
 
+/**
+ * Test 3: Test Responder Receive Send flow builds a large response in the large message region,
+ * and sends its first chunk from there.
+ **/
+void libspdm_test_responder_receive_send_rsp_case3(void** state)
+{
+    libspdm_return_t status;
+    libspdm_test_context_t* spdm_test_context;
+    libspdm_context_t* spdm_context;
+    size_t response_size;
+    uint8_t* response;
+    spdm_chunk_response_response_t* spdm_response;
+    spdm_vendor_defined_request_msg_t spdm_request;
+    spdm_chunk_get_request_t chunk_get_request;
+    void* message;
+    size_t message_size;
+    void* scratch_buffer;
+    size_t scratch_buffer_size;
+    uint32_t transport_header_size;
+    uint8_t* chunk_ptr;
+    uint32_t index;
+
+    spdm_test_context = *state;
+    spdm_context = spdm_test_context->spdm_context;
+    spdm_test_context->case_id = 3;
+    spdm_context->connection_info.version = SPDM_MESSAGE_VERSION_12 <<
+                                            SPDM_VERSION_NUMBER_SHIFT_BIT;
+
+    spdm_context->connection_info.connection_state =
+        LIBSPDM_CONNECTION_STATE_AUTHENTICATED;
+
+    spdm_context->local_context.capability.flags |=
+        SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CHUNK_CAP;
+    spdm_context->connection_info.capability.data_transfer_size =
+        CHUNK_GET_UNIT_TEST_OVERRIDE_DATA_TRANSFER_SIZE;
+
+    libspdm_zero_mem(&spdm_request, sizeof(spdm_request));
+    spdm_request.header.spdm_version = SPDM_MESSAGE_VERSION_12;
+    spdm_request.header.request_response_code = SPDM_VENDOR_DEFINED_REQUEST;
+
+    libspdm_copy_mem(spdm_context->last_spdm_request,
+                     libspdm_get_scratch_buffer_last_spdm_request_capacity(spdm_context),
+                     &spdm_request, sizeof(spdm_request));
+    spdm_context->last_spdm_request_size = sizeof(spdm_request);
+
+    libspdm_acquire_sender_buffer(spdm_context, &message_size, (void**) &message);
+    response = message;
+    response_size = message_size;
+    libspdm_zero_mem(response, response_size);
+
+    spdm_context->get_response_func = (void *)my_test_get_large_response_func;
+
+    status = libspdm_build_response(spdm_context, NULL, false,
+                                    &response_size, (void**)&response);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    assert_int_equal(spdm_context->chunk_context.get.chunk_in_use, true);
+
+    /* The large response was built in place. */
+    libspdm_get_scratch_buffer(spdm_context, &scratch_buffer, &scratch_buffer_size);
+    assert_ptr_equal(spdm_context->chunk_context.get.large_message,
+                     (uint8_t*)scratch_buffer +
+                     libspdm_get_scratch_buffer_large_message_offset(spdm_context));
+    assert_int_equal(spdm_context->chunk_context.get.large_message_size,
+                     CHUNK_GET_UNIT_TEST_LARGE_RESPONSE_SIZE);
+    libspdm_release_sender_buffer(spdm_context);
+
+    libspdm_zero_mem(&chunk_get_request, sizeof(chunk_get_request));
+    chunk_get_request.header.spdm_version = SPDM_MESSAGE_VERSION_12;
+    chunk_get_request.header.request_response_code = SPDM_CHUNK_GET;
+    chunk_get_request.header.param2 = spdm_context->chunk_context.get.chunk_handle;
+    chunk_get_request.chunk_seq_no = 0;
+
+    libspdm_copy_mem(spdm_context->last_spdm_request,
+                     libspdm_get_scratch_buffer_last_spdm_request_capacity(spdm_context),
+                     &chunk_get_request, sizeof(chunk_get_request));
+    spdm_context->last_spdm_request_size = sizeof(chunk_get_request);
+
+    libspdm_acquire_sender_buffer(spdm_context, &message_size, (void**) &message);
+    response = message;
+    response_size = message_size;
+
+    status = libspdm_build_response(spdm_context, NULL, false,
+                                    &response_size, (void**)&response);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    transport_header_size = spdm_context->transport_get_header_size(spdm_context);
+
+    spdm_response = (spdm_chunk_response_response_t*) ((uint8_t*)message + transport_header_size);
+    assert_int_equal(spdm_response->header.request_response_code, SPDM_CHUNK_RESPONSE);
+    assert_int_equal(spdm_response->chunk_seq_no, 0);
+    assert_int_equal(spdm_response->chunk_size,
+                     CHUNK_GET_UNIT_TEST_OVERRIDE_DATA_TRANSFER_SIZE -
+                     sizeof(spdm_chunk_response_response_t) - sizeof(uint32_t));
+    assert_int_equal(*(uint32_t*)(spdm_response + 1), CHUNK_GET_UNIT_TEST_LARGE_RESPONSE_SIZE);
+
+    chunk_ptr = (uint8_t*)(((uint32_t*) (spdm_response + 1)) + 1);
+    for (index = 0; index < spdm_response->chunk_size; index++) {
+        assert_int_equal(chunk_ptr[index], (uint8_t)index);
+    }
+    libspdm_release_sender_buffer(spdm_context);
+}
+
+/**
+ * Test 4: Test Responder Receive Send flow builds a response that always fits in one transfer
+ * in the sender buffer, and leaves the large message region untouched.
+ **/
+void libspdm_test_responder_receive_send_rsp_case4(void** state)
+{
+    libspdm_return_t status;
+    libspdm_test_context_t* spdm_test_context;
+    libspdm_context_t* spdm_context;
+    size_t response_size;
+    uint8_t* response;
+    spdm_version_response_t* spdm_response;
+    spdm_get_version_request_t spdm_request;
+    void* message;
+    size_t message_size;
+    uint8_t* scratch_buffer;
+    size_t scratch_buffer_size;
+    uint8_t* large_buffer;
+    size_t large_buffer_size;
+    uint32_t transport_header_size;
+    size_t index;
+
+    spdm_test_context = *state;
+    spdm_context = spdm_test_context->spdm_context;
+    spdm_test_context->case_id = 4;
+
+    spdm_context->local_context.capability.flags |=
+        SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CHUNK_CAP;
+    spdm_context->connection_info.capability.flags |=
+        SPDM_GET_CAPABILITIES_REQUEST_FLAGS_CHUNK_CAP;
+    spdm_context->connection_info.capability.data_transfer_size =
+        CHUNK_GET_UNIT_TEST_OVERRIDE_DATA_TRANSFER_SIZE;
+
+    libspdm_get_scratch_buffer(spdm_context, (void**) &scratch_buffer, &scratch_buffer_size);
+    large_buffer = scratch_buffer + libspdm_get_scratch_buffer_large_message_offset(spdm_context);
+    large_buffer_size = libspdm_get_scratch_buffer_large_message_capacity(spdm_context);
+    libspdm_set_mem(large_buffer, large_buffer_size, 0xA5);
+
+    libspdm_zero_mem(&spdm_request, sizeof(spdm_request));
+    spdm_request.header.spdm_version = SPDM_MESSAGE_VERSION_10;
+    spdm_request.header.request_response_code = SPDM_GET_VERSION;
+
+    libspdm_copy_mem(spdm_context->last_spdm_request,
+                     libspdm_get_scratch_buffer_last_spdm_request_capacity(spdm_context),
+                     &spdm_request, sizeof(spdm_request));
+    spdm_context->last_spdm_request_size = sizeof(spdm_request);
+
+    libspdm_acquire_sender_buffer(spdm_context, &message_size, (void**) &message);
+    response = message;
+    response_size = message_size;
+
+    status = libspdm_build_response(spdm_context, NULL, false,
+                                    &response_size, (void**)&response);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    assert_int_equal(spdm_context->chunk_context.get.chunk_in_use, false);
+
+    transport_header_size = spdm_context->transport_get_header_size(spdm_context);
+    spdm_response = (spdm_version_response_t*) ((uint8_t*)message + transport_header_size);
+    assert_int_equal(spdm_response->header.request_response_code, SPDM_VERSION);
+
+    for (index = 0; index < large_buffer_size; index++) {
+        assert_int_equal(large_buffer[index], 0xA5);
+    }
+    libspdm_release_sender_buffer(spdm_context);
+}
+
 libspdm_test_context_t m_libspdm_responder_receive_send_test_context = {
     LIBSPDM_TEST_CONTEXT_VERSION,
     false,
@@ -233,6 +416,12 @@ int libspdm_responder_receive_send_test_main(void)
         /* response message size is larger than responder sending transmit buffer size */
         cmocka_unit_test_setup(libspdm_test_responder_receive_send_rsp_case2,
                                libspdm_unit_test_group_setup),
+        /* large response is built in place and chunked from there */
+        cmocka_unit_test_setup(libspdm_test_responder_receive_send_rsp_case3,
+                               libspdm_unit_test_group_setup),
+        /* response that always fits in one transfer is not built in the large message region */
+        cmocka_unit_test_setup(libspdm_test_responder_receive_send_rsp_case4,
+                               libspdm_unit_test_group_setup),
     };
 
     libspdm_setup_test_context(&m_libspdm_responder_receive_send_test_context);
@@ -1352,6 +1352,540 @@ void libspdm_test_responder_respond_if_ready_case14(void **state) {
 }
 #endif /* LIBSPDM_ENABLE_CAPABILITY_CERT_CAP*/
 
+#if LIBSPDM_RESPONDER_ASYNC_SIGN_SUPPORT
+static uint8_t m_libspdm_async_signature[LIBSPDM_MAX_ASYM_KEY_SIZE];
+static size_t m_libspdm_async_signature_size;
+static size_t m_libspdm_async_poll_count;
+
+static bool libspdm_test_async_sign_submit(
+    void *spdm_context, spdm_version_number_t spdm_version,
+    uint8_t op_code, uint32_t base_asym_algo,
+    uint32_t base_hash_algo, bool is_data_hash,
+    const uint8_t *message, size_t message_size,
+    uint64_t *completion_time)
+{
+    m_libspdm_async_signature_size = sizeof(m_libspdm_async_signature);
+    m_libspdm_async_poll_count = 0;
+    *completion_time = 1000;
+    return libspdm_responder_data_sign(spdm_version, op_code, base_asym_algo, base_hash_algo,
+                                       is_data_hash, message, message_size,
+                                       m_libspdm_async_signature,
+                                       &m_libspdm_async_signature_size);
+}
+
+static bool libspdm_test_async_sign_poll(void *spdm_context, bool *is_ready,
+                                         uint8_t *signature, size_t *sig_size)
+{
+    /* The signature is ready on the second poll. */
+    m_libspdm_async_poll_count++;
+    if (m_libspdm_async_poll_count < 2) {
+        *is_ready = false;
+        return true;
+    }
+    libspdm_copy_mem(signature, *sig_size,
+                     m_libspdm_async_signature, m_libspdm_async_signature_size);
+    *sig_size = m_libspdm_async_signature_size;
+    *is_ready = true;
+    return true;
+}
+
+#if LIBSPDM_ENABLE_CAPABILITY_CHAL_CAP
+/**
+ * Test 15: a CHALLENGE is signed by an asynchronous signer.
+ * Expected behavior: the responder returns ResponseNotReady with the RDTExponent of the signer,
+ * rejects a RESPOND_IF_READY that arrives in a session,
+ * keeps returning ResponseNotReady to RESPOND_IF_READY until the signature is ready,
+ * then returns the CHALLENGE_AUTH response and the connection is authenticated.
+ **/
+void libspdm_test_responder_respond_if_ready_case15(void **state) {
+    libspdm_return_t status;
+    libspdm_test_context_t    *spdm_test_context;
+    libspdm_context_t  *spdm_context;
+    size_t response_size;
+    uint8_t response[LIBSPDM_MAX_SPDM_MSG_SIZE];
+    spdm_error_response_data_response_not_ready_t *spdm_error_response;
+    spdm_challenge_auth_response_t *spdm_response;
+    spdm_response_if_ready_request_t respond_if_ready_request;
+    void                 *data;
+    size_t data_size;
+
+    spdm_test_context = *state;
+    spdm_context = spdm_test_context->spdm_context;
+    spdm_test_context->case_id = 0xF;
+    spdm_context->response_state = LIBSPDM_RESPONSE_STATE_NORMAL;
+
+    spdm_context->connection_info.connection_state = LIBSPDM_CONNECTION_STATE_NEGOTIATED;
+    spdm_context->local_context.capability.flags = 0;
+    spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
+    spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CHAL_CAP;
+    spdm_context->connection_info.algorithm.base_hash_algo = m_libspdm_use_hash_algo;
+    spdm_context->connection_info.algorithm.base_asym_algo = m_libspdm_use_asym_algo;
+    spdm_context->connection_info.algorithm.measurement_spec = m_libspdm_use_measurement_spec;
+    spdm_context->connection_info.algorithm.measurement_hash_algo =
+        m_libspdm_use_measurement_hash_algo;
+
+    spdm_context->connection_info.version = SPDM_MESSAGE_VERSION_11 <<
+                                            SPDM_VERSION_NUMBER_SHIFT_BIT;
+    libspdm_read_responder_public_certificate_chain (m_libspdm_use_hash_algo,
+                                                     m_libspdm_use_asym_algo,
+                                                     &data, &data_size,
+                                                     NULL, NULL);
+    spdm_context->local_context.local_cert_chain_provision[0] = data;
+    spdm_context->local_context.local_cert_chain_provision_size[0] = data_size;
+
+    spdm_context->local_context.opaque_challenge_auth_rsp_size = 0;
+
+    libspdm_register_responder_data_sign_async_func(spdm_context,
+                                                    libspdm_test_async_sign_submit,
+                                                    libspdm_test_async_sign_poll);
+
+    libspdm_get_random_number (SPDM_NONCE_SIZE, m_libspdm_challenge_request.nonce);
+    spdm_context->last_spdm_request_size = m_libspdm_challenge_request_size;
+    libspdm_copy_mem(spdm_context->last_spdm_request,
+                     libspdm_get_scratch_buffer_last_spdm_request_capacity(spdm_context),
+                     &m_libspdm_challenge_request, m_libspdm_challenge_request_size);
+
+    /*the CHALLENGE waits for its signature*/
+    spdm_context->last_spdm_request_session_id_valid = false;
+    response_size = sizeof(response);
+    status = libspdm_get_response_challenge_auth(spdm_context,
+                                                 m_libspdm_challenge_request_size,
+                                                 &m_libspdm_challenge_request,
+                                                 &response_size,
+                                                 response);
+    assert_int_equal (status, LIBSPDM_STATUS_SUCCESS);
+    assert_int_equal (response_size, sizeof(spdm_error_response_data_response_not_ready_t));
+    spdm_error_response = (void *)response;
+    assert_int_equal (spdm_error_response->header.request_response_code, SPDM_ERROR);
+    assert_int_equal (spdm_error_response->header.param1, SPDM_ERROR_CODE_RESPONSE_NOT_READY);
+    assert_int_equal (spdm_error_response->extend_error_data.request_code, SPDM_CHALLENGE);
+    assert_int_equal (spdm_error_response->extend_error_data.rd_exponent, 10);
+    assert_int_equal (spdm_context->response_state, LIBSPDM_RESPONSE_STATE_NOT_READY);
+
+    respond_if_ready_request.header.spdm_version = SPDM_MESSAGE_VERSION_11;
+    respond_if_ready_request.header.request_response_code = SPDM_RESPOND_IF_READY;
+    respond_if_ready_request.header.param1 = SPDM_CHALLENGE;
+    respond_if_ready_request.header.param2 = spdm_error_response->extend_error_data.token;
+
+    /*a RESPOND_IF_READY in a session does not get the response of a request out of session*/
+    spdm_context->last_spdm_request_session_id_valid = true;
+    spdm_context->last_spdm_request_session_id = 0xFFFFFFFF;
+    response_size = sizeof(response);
+    status = libspdm_get_response_respond_if_ready(spdm_context,
+                                                   sizeof(spdm_message_header_t),
+                                                   &respond_if_ready_request,
+                                                   &response_size,
+                                                   response);
+    assert_int_equal (status, LIBSPDM_STATUS_SUCCESS);
+    assert_int_equal (spdm_error_response->header.request_response_code, SPDM_ERROR);
+    assert_int_equal (spdm_error_response->header.param1, SPDM_ERROR_CODE_INVALID_REQUEST);
+    assert_int_equal (m_libspdm_async_poll_count, 0);
+    spdm_context->last_spdm_request_session_id_valid = false;
+    spdm_context->last_spdm_request_session_id = 0;
+
+    /*the signature is not ready yet*/
+    response_size = sizeof(response);
+    status = libspdm_get_response_respond_if_ready(spdm_context,
+                                                   sizeof(spdm_message_header_t),
+                                                   &respond_if_ready_request,
+                                                   &response_size,
+                                                   response);
+    assert_int_equal (status, LIBSPDM_STATUS_SUCCESS);
+    assert_int_equal (spdm_error_response->header.request_response_code, SPDM_ERROR);
+    assert_int_equal (spdm_error_response->header.param1, SPDM_ERROR_CODE_RESPONSE_NOT_READY);
+
+    /*the signature is ready*/
+    response_size = sizeof(response);
+    status = libspdm_get_response_respond_if_ready(spdm_context,
+                                                   sizeof(spdm_message_header_t),
+                                                   &respond_if_ready_request,
+                                                   &response_size,
+                                                   response);
+    assert_int_equal (status, LIBSPDM_STATUS_SUCCESS);
+    assert_int_equal (response_size, sizeof(spdm_challenge_auth_response_t) + libspdm_get_hash_size (
+                          m_libspdm_use_hash_algo) + SPDM_NONCE_SIZE + 0 + sizeof(uint16_t) + 0 + libspdm_get_asym_signature_size (
+                          m_libspdm_use_asym_algo));
+    spdm_response = (void *)response;
+    assert_int_equal (spdm_response->header.request_response_code, SPDM_CHALLENGE_AUTH);
+    assert_memory_equal ((uint8_t *)response + response_size - m_libspdm_async_signature_size,
+                         m_libspdm_async_signature, m_libspdm_async_signature_size);
+    assert_int_equal (spdm_context->response_state, LIBSPDM_RESPONSE_STATE_NORMAL);
+    assert_int_equal (spdm_context->connection_info.connection_state,
+                      LIBSPDM_CONNECTION_STATE_AUTHENTICATED);
+
+    libspdm_register_responder_data_sign_async_func(spdm_context, NULL, NULL);
+    free(data);
+}
+#endif /* LIBSPDM_ENABLE_CAPABILITY_CHAL_CAP */
+
+#if LIBSPDM_ENABLE_CAPABILITY_MEAS_CAP
+spdm_get_measurements_request_t m_libspdm_get_measurements_request_signed = {
+    {
+        SPDM_MESSAGE_VERSION_11,
+        SPDM_GET_MEASUREMENTS,
+        SPDM_GET_MEASUREMENTS_REQUEST_ATTRIBUTES_GENERATE_SIGNATURE,
+        1
+    },
+};
+size_t m_libspdm_get_measurements_request_signed_size =
+    sizeof(m_libspdm_get_measurements_request_signed);
+
+/**
+ * Test 16: a signed GET_MEASUREMENTS in a session is signed by an asynchronous signer.
+ * Expected behavior: the responder returns ResponseNotReady,
+ * rejects a RESPOND_IF_READY that arrives outside the session or in another session,
+ * then returns the MEASUREMENTS response in the session of the request.
+ **/
+void libspdm_test_responder_respond_if_ready_case16(void **state) {
+    libspdm_return_t status;
+    libspdm_test_context_t    *spdm_test_context;
+    libspdm_context_t  *spdm_context;
+    size_t response_size;
+    uint8_t response[LIBSPDM_MAX_SPDM_MSG_SIZE];
+    spdm_error_response_data_response_not_ready_t *spdm_error_response;
+    spdm_measurements_response_t *spdm_response;
+    spdm_response_if_ready_request_t respond_if_ready_request;
+    libspdm_session_info_t    *session_info;
+    uint32_t session_id;
+
+    spdm_test_context = *state;
+    spdm_context = spdm_test_context->spdm_context;
+    spdm_test_context->case_id = 0x10;
+    spdm_context->response_state = LIBSPDM_RESPONSE_STATE_NORMAL;
+
+    spdm_context->connection_info.connection_state = LIBSPDM_CONNECTION_STATE_AUTHENTICATED;
+    spdm_context->local_context.capability.flags = 0;
+    spdm_context->local_context.capability.flags |=
+        SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP_SIG;
+    spdm_context->connection_info.algorithm.base_hash_algo = m_libspdm_use_hash_algo;
+    spdm_context->connection_info.algorithm.base_asym_algo = m_libspdm_use_asym_algo;
+    spdm_context->connection_info.algorithm.measurement_spec = m_libspdm_use_measurement_spec;
+    spdm_context->connection_info.algorithm.measurement_hash_algo =
+        m_libspdm_use_measurement_hash_algo;
+
+    spdm_context->connection_info.version = SPDM_MESSAGE_VERSION_11 <<
+                                            SPDM_VERSION_NUMBER_SHIFT_BIT;
+    spdm_context->local_context.opaque_measurement_rsp_size = 0;
+    spdm_context->local_context.opaque_measurement_rsp = NULL;
+
+    session_id = 0xFFFFFFFF;
+    spdm_context->latest_session_id = session_id;
+    session_info = &spdm_context->session_info[0];
+    libspdm_session_info_init (spdm_context, session_info, session_id, true);
+    libspdm_secured_message_set_session_state (session_info->secured_message_context,
+                                               LIBSPDM_SESSION_STATE_ESTABLISHED);
+
+    libspdm_register_responder_data_sign_async_func(spdm_context,
+                                                    libspdm_test_async_sign_submit,
+                                                    libspdm_test_async_sign_poll);
+
+    libspdm_get_random_number (SPDM_NONCE_SIZE, m_libspdm_get_measurements_request_signed.nonce);
+    spdm_context->last_spdm_request_size = m_libspdm_get_measurements_request_signed_size;
+    libspdm_copy_mem(spdm_context->last_spdm_request,
+                     libspdm_get_scratch_buffer_last_spdm_request_capacity(spdm_context),
+                     &m_libspdm_get_measurements_request_signed,
+                     m_libspdm_get_measurements_request_signed_size);
+
+    /*the GET_MEASUREMENTS waits for its signature*/
+    spdm_context->last_spdm_request_session_id_valid = true;
+    spdm_context->last_spdm_request_session_id = session_id;
+    response_size = sizeof(response);
+    status = libspdm_get_response_measurements(spdm_context,
+                                               m_libspdm_get_measurements_request_signed_size,
+                                               &m_libspdm_get_measurements_request_signed,
+                                               &response_size,
+                                               response);
+    assert_int_equal (status, LIBSPDM_STATUS_SUCCESS);
+    assert_int_equal (response_size, sizeof(spdm_error_response_data_response_not_ready_t));
+    spdm_error_response = (void *)response;
+    assert_int_equal (spdm_error_response->header.request_response_code, SPDM_ERROR);
+    assert_int_equal (spdm_error_response->header.param1, SPDM_ERROR_CODE_RESPONSE_NOT_READY);
+    assert_int_equal (spdm_error_response->extend_error_data.request_code,
+                      SPDM_GET_MEASUREMENTS);
+    assert_int_equal (spdm_context->response_state, LIBSPDM_RESPONSE_STATE_NOT_READY);
+
+    respond_if_ready_request.header.spdm_version = SPDM_MESSAGE_VERSION_11;
+    respond_if_ready_request.header.request_response_code = SPDM_RESPOND_IF_READY;
+    respond_if_ready_request.header.param1 = SPDM_GET_MEASUREMENTS;
+    respond_if_ready_request.header.param2 = spdm_error_response->extend_error_data.token;
+
+    /*a RESPOND_IF_READY outside the session does not get the response*/
+    spdm_context->last_spdm_request_session_id_valid = false;
+    response_size = sizeof(response);
+    status = libspdm_get_response_respond_if_ready(spdm_context,
+                                                   sizeof(spdm_message_header_t),
+                                                   &respond_if_ready_request,
+                                                   &response_size,
+                                                   response);
+    assert_int_equal (status, LIBSPDM_STATUS_SUCCESS);
+    assert_int_equal (spdm_error_response->header.request_response_code, SPDM_ERROR);
+    assert_int_equal (spdm_error_response->header.param1, SPDM_ERROR_CODE_INVALID_REQUEST);
+
+    /*a RESPOND_IF_READY in another session does not get the response*/
+    spdm_context->last_spdm_request_session_id_valid = true;
+    spdm_context->last_spdm_request_session_id = 0xFFFFFFFE;
+    response_size = sizeof(response);
+    status = libspdm_get_response_respond_if_ready(spdm_context,
+                                                   sizeof(spdm_message_header_t),
+                                                   &respond_if_ready_request,
+                                                   &response_size,
+                                                   response);
+    assert_int_equal (status, LIBSPDM_STATUS_SUCCESS);
+    assert_int_equal (spdm_error_response->header.request_response_code, SPDM_ERROR);
+    assert_int_equal (spdm_error_response->header.param1, SPDM_ERROR_CODE_INVALID_REQUEST);
+    assert_int_equal (m_libspdm_async_poll_count, 0);
+    assert_int_equal (spdm_context->async_sign.request_code, SPDM_GET_MEASUREMENTS);
+
+    /*the signature is not ready yet*/
+    spdm_context->last_spdm_request_session_id = session_id;
+    response_size = sizeof(response);
+    status = libspdm_get_response_respond_if_ready(spdm_context,
+                                                   sizeof(spdm_message_header_t),
+                                                   &respond_if_ready_request,
+                                                   &response_size,
+                                                   response);
+    assert_int_equal (status, LIBSPDM_STATUS_SUCCESS);
+    assert_int_equal (spdm_error_response->header.request_response_code, SPDM_ERROR);
+    assert_int_equal (spdm_error_response->header.param1, SPDM_ERROR_CODE_RESPONSE_NOT_READY);
+
+    /*the signature is ready*/
+    response_size = sizeof(response);
+    status = libspdm_get_response_respond_if_ready(spdm_context,
+                                                   sizeof(spdm_message_header_t),
+                                                   &respond_if_ready_request,
+                                                   &response_size,
+                                                   response);
+    assert_int_equal (status, LIBSPDM_STATUS_SUCCESS);
+    spdm_response = (void *)response;
+    assert_int_equal (spdm_response->header.request_response_code, SPDM_MEASUREMENTS);
+    assert_int_equal (spdm_response->number_of_blocks, 1);
+    assert_memory_equal ((uint8_t *)response + response_size - m_libspdm_async_signature_size,
+                         m_libspdm_async_signature, m_libspdm_async_signature_size);
+    assert_int_equal (spdm_context->response_state, LIBSPDM_RESPONSE_STATE_NORMAL);
+    assert_int_equal (spdm_context->async_sign.request_code, 0);
+
+    libspdm_register_responder_data_sign_async_func(spdm_context, NULL, NULL);
+    spdm_context->last_spdm_request_session_id_valid = false;
+    spdm_context->last_spdm_request_session_id = 0;
+    libspdm_free_session_id (spdm_context, session_id);
+}
+#endif /* LIBSPDM_ENABLE_CAPABILITY_MEAS_CAP */
+
+#if LIBSPDM_ENABLE_CAPABILITY_KEY_EX_CAP
+/**
+ * Send a KEY_EXCHANGE that waits for the asynchronous signer, and return the ResponseNotReady
+ * token. The caller frees data.
+ **/
+static uint8_t libspdm_test_responder_respond_if_ready_defer_key_exchange(
+    libspdm_context_t *spdm_context, void **data, size_t *dhe_key_size)
+{
+    libspdm_return_t status;
+    size_t response_size;
+    uint8_t response[LIBSPDM_MAX_SPDM_MSG_SIZE];
+    spdm_error_response_data_response_not_ready_t *spdm_error_response;
+    size_t data_size;
+    uint8_t                *ptr;
+    void                 *dhe_context;
+    size_t opaque_key_exchange_req_size;
+
+    spdm_context->response_state = LIBSPDM_RESPONSE_STATE_NORMAL;
+    spdm_context->connection_info.connection_state = LIBSPDM_CONNECTION_STATE_AUTHENTICATED;
+    spdm_context->local_context.capability.flags = 0;
+    spdm_context->connection_info.capability.flags |=
+        SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
+    spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP;
+    spdm_context->connection_info.algorithm.base_hash_algo = m_libspdm_use_hash_algo;
+    spdm_context->connection_info.algorithm.base_asym_algo = m_libspdm_use_asym_algo;
+    spdm_context->connection_info.algorithm.measurement_spec = m_libspdm_use_measurement_spec;
+    spdm_context->connection_info.algorithm.measurement_hash_algo =
+        m_libspdm_use_measurement_hash_algo;
+    spdm_context->connection_info.algorithm.dhe_named_group = m_libspdm_use_dhe_algo;
+    spdm_context->connection_info.algorithm.aead_cipher_suite = m_libspdm_use_aead_algo;
+
+    spdm_context->connection_info.version = SPDM_MESSAGE_VERSION_11 <<
+                                            SPDM_VERSION_NUMBER_SHIFT_BIT;
+    libspdm_read_responder_public_certificate_chain (m_libspdm_use_hash_algo,
+                                                     m_libspdm_use_asym_algo,
+                                                     data, &data_size,
+                                                     NULL, NULL);
+    spdm_context->local_context.local_cert_chain_provision[0] = *data;
+    spdm_context->local_context.local_cert_chain_provision_size[0] = data_size;
+
+    spdm_context->local_context.mut_auth_requested = 0;
+
+    m_libspdm_key_exchange_request.req_session_id = 0xFFFF;
+    m_libspdm_key_exchange_request.reserved = 0;
+    ptr = m_libspdm_key_exchange_request.random_data;
+    libspdm_get_random_number (SPDM_RANDOM_DATA_SIZE, ptr);
+    ptr += SPDM_RANDOM_DATA_SIZE;
+    *dhe_key_size = libspdm_get_dhe_pub_key_size (m_libspdm_use_dhe_algo);
+    dhe_context = libspdm_dhe_new (spdm_context->connection_info.version, m_libspdm_use_dhe_algo,
+                                   false);
+    libspdm_dhe_generate_key (m_libspdm_use_dhe_algo, dhe_context, ptr, dhe_key_size);
+    ptr += *dhe_key_size;
+    libspdm_dhe_free (m_libspdm_use_dhe_algo, dhe_context);
+    opaque_key_exchange_req_size =
+        libspdm_get_opaque_data_supported_version_data_size (spdm_context);
+    *(uint16_t *)ptr = (uint16_t)opaque_key_exchange_req_size;
+    ptr += sizeof(uint16_t);
+    libspdm_build_opaque_data_supported_version_data (spdm_context, &opaque_key_exchange_req_size,
+                                                      ptr);
+
+    spdm_context->last_spdm_request_size = m_libspdm_key_exchange_request_size;
+    libspdm_copy_mem(spdm_context->last_spdm_request,
+                     libspdm_get_scratch_buffer_last_spdm_request_capacity(spdm_context),
+                     &m_libspdm_key_exchange_request, m_libspdm_key_exchange_request_size);
+
+    libspdm_register_responder_data_sign_async_func(spdm_context,
+                                                    libspdm_test_async_sign_submit,
+                                                    libspdm_test_async_sign_poll);
+
+    spdm_context->last_spdm_request_session_id_valid = false;
+    response_size = sizeof(response);
+    status = libspdm_get_response_key_exchange(spdm_context,
+                                               m_libspdm_key_exchange_request_size,
+                                               &m_libspdm_key_exchange_request,
+                                               &response_size,
+                                               response);
+    assert_int_equal (status, LIBSPDM_STATUS_SUCCESS);
+    assert_int_equal (response_size, sizeof(spdm_error_response_data_response_not_ready_t));
+    spdm_error_response = (void *)response;
+    assert_int_equal (spdm_error_response->header.request_response_code, SPDM_ERROR);
+    assert_int_equal (spdm_error_response->header.param1, SPDM_ERROR_CODE_RESPONSE_NOT_READY);
+    assert_int_equal (spdm_error_response->extend_error_data.request_code, SPDM_KEY_EXCHANGE);
+    assert_int_equal (spdm_context->response_state, LIBSPDM_RESPONSE_STATE_NOT_READY);
+    assert_int_equal (spdm_context->async_sign.request_code, SPDM_KEY_EXCHANGE);
+
+    return spdm_error_response->extend_error_data.token;
+}
+
+/**
+ * Test 17: a KEY_EXCHANGE is signed by an asynchronous signer.
+ * Expected behavior: the responder returns ResponseNotReady, then returns the KEY_EXCHANGE_RSP
+ * response to RESPOND_IF_READY once the signature is ready, and the session is handshaking.
+ **/
+void libspdm_test_responder_respond_if_ready_case17(void **state) {
+    libspdm_return_t status;
+    libspdm_test_context_t    *spdm_test_context;
+    libspdm_context_t  *spdm_context;
+    size_t response_size;
+    uint8_t response[LIBSPDM_MAX_SPDM_MSG_SIZE];
+    spdm_error_response_t *spdm_error_response;
+    spdm_key_exchange_response_t *spdm_response;
+    spdm_response_if_ready_request_t respond_if_ready_request;
+    void                 *data;
+    size_t dhe_key_size;
+    size_t signature_offset;
+
+    spdm_test_context = *state;
+    spdm_context = spdm_test_context->spdm_context;
+    spdm_test_context->case_id = 0x11;
+
+    respond_if_ready_request.header.spdm_version = SPDM_MESSAGE_VERSION_11;
+    respond_if_ready_request.header.request_response_code = SPDM_RESPOND_IF_READY;
+    respond_if_ready_request.header.param1 = SPDM_KEY_EXCHANGE;
+    respond_if_ready_request.header.param2 =
+        libspdm_test_responder_respond_if_ready_defer_key_exchange(spdm_context, &data,
+                                                                   &dhe_key_size);
+
+    /*the signature is not ready yet*/
+    response_size = sizeof(response);
+    status = libspdm_get_response_respond_if_ready(spdm_context,
+                                                   sizeof(spdm_message_header_t),
+                                                   &respond_if_ready_request,
+                                                   &response_size,
+                                                   response);
+    assert_int_equal (status, LIBSPDM_STATUS_SUCCESS);
+    spdm_error_response = (void *)response;
+    assert_int_equal (spdm_error_response->header.request_response_code, SPDM_ERROR);
+    assert_int_equal (spdm_error_response->header.param1, SPDM_ERROR_CODE_RESPONSE_NOT_READY);
+
+    /*the signature is ready*/
+    response_size = sizeof(response);
+    status = libspdm_get_response_respond_if_ready(spdm_context,
+                                                   sizeof(spdm_message_header_t),
+                                                   &respond_if_ready_request,
+                                                   &response_size,
+                                                   response);
+    assert_int_equal (status, LIBSPDM_STATUS_SUCCESS);
+    assert_int_equal (response_size,
+                      sizeof(spdm_key_exchange_response_t) + dhe_key_size + sizeof(uint16_t) +
+                      libspdm_get_opaque_data_version_selection_data_size(spdm_context) +
+                      libspdm_get_asym_signature_size (m_libspdm_use_asym_algo) +
+                      libspdm_get_hash_size (m_libspdm_use_hash_algo));
+    spdm_response = (void *)response;
+    assert_int_equal (spdm_response->header.request_response_code, SPDM_KEY_EXCHANGE_RSP);
+    assert_int_equal (spdm_response->rsp_session_id, 0xFFFF);
+    signature_offset = response_size - libspdm_get_hash_size (m_libspdm_use_hash_algo) -
+                       m_libspdm_async_signature_size;
+    assert_memory_equal ((uint8_t *)response + signature_offset,
+                         m_libspdm_async_signature, m_libspdm_async_signature_size);
+    assert_int_equal (libspdm_secured_message_get_session_state (spdm_context->session_info[0].
+                                                                 secured_message_context),
+                      LIBSPDM_SESSION_STATE_HANDSHAKING);
+    assert_int_equal (spdm_context->response_state, LIBSPDM_RESPONSE_STATE_NORMAL);
+    assert_int_equal (spdm_context->async_sign.request_code, 0);
+
+    libspdm_register_responder_data_sign_async_func(spdm_context, NULL, NULL);
+    free(data);
+    libspdm_free_session_id (spdm_context, (0xFFFFFFFF));
+}
+
+/**
+ * Test 18: a different request arrives while a KEY_EXCHANGE waits for its signature.
+ * Expected behavior: the responder returns Busy, drops the pending signature and frees the
+ * session of the KEY_EXCHANGE, and a later KEY_EXCHANGE is deferred again.
+ **/
+void libspdm_test_responder_respond_if_ready_case18(void **state) {
+    libspdm_return_t status;
+    libspdm_test_context_t    *spdm_test_context;
+    libspdm_context_t  *spdm_context;
+    size_t response_size;
+    uint8_t response[LIBSPDM_MAX_SPDM_MSG_SIZE];
+    spdm_error_response_t *spdm_error_response;
+    spdm_get_version_request_t get_version_request;
+    void                 *data;
+    size_t dhe_key_size;
+
+    spdm_test_context = *state;
+    spdm_context = spdm_test_context->spdm_context;
+    spdm_test_context->case_id = 0x12;
+
+    libspdm_test_responder_respond_if_ready_defer_key_exchange(spdm_context, &data,
+                                                               &dhe_key_size);
+    free(data);
+    assert_int_equal (spdm_context->session_info[0].session_id, 0xFFFFFFFF);
+
+    /*a GET_VERSION abandons the response waiting for its signature*/
+    get_version_request.header.spdm_version = SPDM_MESSAGE_VERSION_10;
+    get_version_request.header.request_response_code = SPDM_GET_VERSION;
+    get_version_request.header.param1 = 0;
+    get_version_request.header.param2 = 0;
+    response_size = sizeof(response);
+    status = libspdm_get_response_version(spdm_context, sizeof(get_version_request),
+                                          &get_version_request, &response_size, response);
+    assert_int_equal (status, LIBSPDM_STATUS_SUCCESS);
+    spdm_error_response = (void *)response;
+    assert_int_equal (spdm_error_response->header.request_response_code, SPDM_ERROR);
+    assert_int_equal (spdm_error_response->header.param1, SPDM_ERROR_CODE_BUSY);
+    assert_int_equal (spdm_context->response_state, LIBSPDM_RESPONSE_STATE_NORMAL);
+    assert_int_equal (spdm_context->async_sign.request_code, 0);
+    assert_int_equal (spdm_context->async_sign.response_size, 0);
+    assert_int_equal (spdm_context->session_info[0].session_id, INVALID_SESSION_ID);
+
+    /*the signer is free for the next response*/
+    libspdm_test_responder_respond_if_ready_defer_key_exchange(spdm_context, &data,
+                                                               &dhe_key_size);
+    free(data);
+    libspdm_responder_discard_deferred_response(spdm_context);
+    spdm_context->response_state = LIBSPDM_RESPONSE_STATE_NORMAL;
+    assert_int_equal (spdm_context->session_info[0].session_id, INVALID_SESSION_ID);
+
+    libspdm_register_responder_data_sign_async_func(spdm_context, NULL, NULL);
+}
+#endif /* LIBSPDM_ENABLE_CAPABILITY_KEY_EX_CAP */
+#endif /* LIBSPDM_RESPONDER_ASYNC_SIGN_SUPPORT */
+
 libspdm_test_context_t m_libspdm_responder_respond_if_ready_test_context = {
     LIBSPDM_TEST_CONTEXT_VERSION,
     false,
@@ -1392,6 +1926,19 @@ int libspdm_responder_respond_if_ready_test_main(void) {
         cmocka_unit_test(libspdm_test_responder_respond_if_ready_case14),
     #endif /* LIBSPDM_ENABLE_CAPABILITY_CERT_CAP*/
 
+    #if LIBSPDM_RESPONDER_ASYNC_SIGN_SUPPORT && LIBSPDM_ENABLE_CAPABILITY_CHAL_CAP
+        cmocka_unit_test(libspdm_test_responder_respond_if_ready_case15),
+    #endif /* LIBSPDM_RESPONDER_ASYNC_SIGN_SUPPORT && LIBSPDM_ENABLE_CAPABILITY_CHAL_CAP */
+
+    #if LIBSPDM_RESPONDER_ASYNC_SIGN_SUPPORT && LIBSPDM_ENABLE_CAPABILITY_MEAS_CAP
+        cmocka_unit_test(libspdm_test_responder_respond_if_ready_case16),
+    #endif /* LIBSPDM_RESPONDER_ASYNC_SIGN_SUPPORT && LIBSPDM_ENABLE_CAPABILITY_MEAS_CAP */
+
+    #if LIBSPDM_RESPONDER_ASYNC_SIGN_SUPPORT && LIBSPDM_ENABLE_CAPABILITY_KEY_EX_CAP
+        cmocka_unit_test(libspdm_test_responder_respond_if_ready_case17),
+        cmocka_unit_test(libspdm_test_responder_respond_if_ready_case18),
+    #endif /* LIBSPDM_RESPONDER_ASYNC_SIGN_SUPPORT && LIBSPDM_ENABLE_CAPABILITY_KEY_EX_CAP */
+
     };
 
     libspdm_setup_test_context (&m_libspdm_responder_respond_if_ready_test_context);
@@ -0,0 +1,551 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2021-2022 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+/*
+ * SPDM over TCP loopback benchmark.
+ *
+ * A requester and a responder run in the same process and talk over a Unix domain stream socket
+ * pair, with spdm_transport_tcp_lib and the non-blocking socket IO of spdm_tcp_io_lib. No network
+ * is needed. After GET_VERSION, GET_CAPABILITIES and NEGOTIATE_ALGORITHMS, each iteration times:
+ *   round_trip: a VENDOR_DEFINED_REQUEST with a payload of the message size, and its
+ *               VENDOR_DEFINED_RESPONSE with a payload of the same size. The responder handles
+ *               the request as soon as it is sent.
+ *   pipelined:  LIBSPDM_BENCH_PIPELINE_DEPTH such requests are sent before the responder handles
+ *               them, so several messages are in flight on the connection in each direction.
+ *               The time is reported per request.
+ * The message size is 64, 1024 and 4096 unless --size is given.
+ * The results are written as JSON with min/mean/p50/p90/p99/max latency in microseconds, and the
+ * throughput in MB/s of request and response payload computed from the mean.
+ *
+ * The report goes to spdm_tcp_bench.json unless -o is given; "-o -" selects stdout.
+ *
+ * usage: test_spdm_tcp_bench [-n iterations] [-o report.json] [--size bytes]
+ */
+
+#define _DEFAULT_SOURCE
+
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "spdm_bench.h"
+#include "hal/base.h"
+#include "internal/libspdm_requester_lib.h"
+#include "library/spdm_responder_lib.h"
+#include "library/spdm_transport_tcp_lib.h"
+#include "library/spdm_tcp_io_lib.h"
+
+#ifndef LIBSPDM_BENCH_CRYPTO_NAME
+#define LIBSPDM_BENCH_CRYPTO_NAME "unknown"
+#endif
+
+#define LIBSPDM_BENCH_DEFAULT_ITERATIONS 200
+#define LIBSPDM_BENCH_DEFAULT_OUTPUT_FILE "spdm_tcp_bench.json"
+
+#define LIBSPDM_BENCH_MAX_MESSAGE_SIZE 0x1000
+#define LIBSPDM_BENCH_PIPELINE_DEPTH 8
+
+#define LIBSPDM_BENCH_MAX_SPDM_MSG_SIZE 0x1100
+#define LIBSPDM_BENCH_BUFFER_SIZE (LIBSPDM_BENCH_MAX_SPDM_MSG_SIZE + \
+                                   LIBSPDM_TCP_TRANSPORT_ADDITIONAL_SIZE)
+
+/* A VENDOR_DEFINED_REQUEST or VENDOR_DEFINED_RESPONSE with no vendor ID, followed by the
+ * payload length. */
+#define LIBSPDM_BENCH_VENDOR_HEADER_SIZE \
+    (sizeof(spdm_vendor_defined_request_msg_t) + sizeof(uint16_t))
+
+static const size_t m_libspdm_bench_message_size[] = { 64, 1024, 4096 };
+
+#define LIBSPDM_BENCH_ARRAY_SIZE(array) (sizeof(array) / sizeof((array)[0]))
+
+typedef enum {
+    LIBSPDM_BENCH_OP_ROUND_TRIP,
+    LIBSPDM_BENCH_OP_PIPELINED,
+    LIBSPDM_BENCH_OP_MAX
+} libspdm_bench_op_t;
+
+static const char *m_libspdm_bench_op_name[LIBSPDM_BENCH_OP_MAX] = {
+    "round_trip",
+    "pipelined",
+};
+
+typedef struct {
+    /* First member: the socket IO finds it through LIBSPDM_DATA_APP_CONTEXT_DATA. */
+    libspdm_tcp_io_t tcp_io;
+    void *spdm_context;
+    void *scratch_buffer;
+    size_t scratch_buffer_size;
+    uint8_t sender_buffer[LIBSPDM_BENCH_BUFFER_SIZE];
+    uint8_t receiver_buffer[LIBSPDM_BENCH_BUFFER_SIZE];
+    /* Holds the bytes received from the socket, up to the pipeline depth of messages. */
+    uint8_t stream_buffer[LIBSPDM_BENCH_PIPELINE_DEPTH * LIBSPDM_BENCH_BUFFER_SIZE];
+} libspdm_bench_endpoint_t;
+
+static libspdm_bench_endpoint_t m_libspdm_bench_requester;
+static libspdm_bench_endpoint_t m_libspdm_bench_responder;
+
+/* If true, the responder handles a request as soon as the requester sends it. */
+static bool m_libspdm_bench_dispatch_on_send;
+
+static libspdm_bench_stat_t m_libspdm_bench_stat[LIBSPDM_BENCH_OP_MAX];
+
+static libspdm_bench_endpoint_t *libspdm_bench_get_endpoint(void *spdm_context)
+{
+    if (spdm_context == m_libspdm_bench_requester.spdm_context) {
+        return &m_libspdm_bench_requester;
+    }
+    return &m_libspdm_bench_responder;
+}
+
+static libspdm_return_t libspdm_bench_acquire_sender_buffer(void *spdm_context,
+                                                            void **msg_buf_ptr)
+{
+    *msg_buf_ptr = libspdm_bench_get_endpoint(spdm_context)->sender_buffer;
+    return LIBSPDM_STATUS_SUCCESS;
+}
+
+static void libspdm_bench_release_sender_buffer(void *spdm_context, const void *msg_buf_ptr)
+{
+}
+
+static libspdm_return_t libspdm_bench_acquire_receiver_buffer(void *spdm_context,
+                                                              void **msg_buf_ptr)
+{
+    *msg_buf_ptr = libspdm_bench_get_endpoint(spdm_context)->receiver_buffer;
+    return LIBSPDM_STATUS_SUCCESS;
+}
+
+static void libspdm_bench_release_receiver_buffer(void *spdm_context, const void *msg_buf_ptr)
+{
+}
+
+/* Requester side: in round trip mode, sending a request runs the responder synchronously. */
+static libspdm_return_t libspdm_bench_requester_send_message(void *spdm_context,
+                                                             size_t message_size,
+                                                             const void *message,
+                                                             uint64_t timeout)
+{
+    libspdm_return_t status;
+
+    status = libspdm_tcp_io_send_message(spdm_context, message_size, message, timeout);
+    if (LIBSPDM_STATUS_IS_ERROR(status) || !m_libspdm_bench_dispatch_on_send) {
+        return status;
+    }
+    return libspdm_responder_dispatch_message(m_libspdm_bench_responder.spdm_context);
+}
+
+/* Responder VENDOR_DEFINED_REQUEST handler: the response payload has the size of the request
+ * payload. */
+static libspdm_return_t libspdm_bench_get_response(
+    void *spdm_context, const uint32_t *session_id, bool is_app_message,
+    size_t request_size, const void *request, size_t *response_size,
+    void *response)
+{
+    const spdm_vendor_defined_request_msg_t *spdm_request;
+    spdm_vendor_defined_response_msg_t *spdm_response;
+    uint16_t payload_size;
+
+    spdm_request = request;
+    if (is_app_message || (request_size < LIBSPDM_BENCH_VENDOR_HEADER_SIZE) ||
+        (spdm_request->header.request_response_code != SPDM_VENDOR_DEFINED_REQUEST)) {
+        return LIBSPDM_STATUS_UNSUPPORTED_CAP;
+    }
+    memcpy(&payload_size, spdm_request + 1, sizeof(payload_size));
+    if ((request_size != LIBSPDM_BENCH_VENDOR_HEADER_SIZE + payload_size) ||
+        (*response_size < LIBSPDM_BENCH_VENDOR_HEADER_SIZE + payload_size)) {
+        return LIBSPDM_STATUS_UNSUPPORTED_CAP;
+    }
+
+    spdm_response = response;
+    spdm_response->header.spdm_version = spdm_request->header.spdm_version;
+    spdm_response->header.request_response_code = SPDM_VENDOR_DEFINED_RESPONSE;
+    spdm_response->header.param1 = 0;
+    spdm_response->header.param2 = 0;
+    spdm_response->standard_id = SPDM_REGISTRY_ID_DMTF;
+    spdm_response->len = 0;
+    memcpy(spdm_response + 1, &payload_size, sizeof(payload_size));
+    memset((uint8_t *)response + LIBSPDM_BENCH_VENDOR_HEADER_SIZE, 0xA5, payload_size);
+    *response_size = LIBSPDM_BENCH_VENDOR_HEADER_SIZE + payload_size;
+    return LIBSPDM_STATUS_SUCCESS;
+}
+
+static void libspdm_bench_register_transport(void *spdm_context)
+{
+    libspdm_register_transport_layer_func(spdm_context,
+                                          LIBSPDM_BENCH_MAX_SPDM_MSG_SIZE,
+                                          LIBSPDM_TCP_TRANSPORT_ADDITIONAL_SIZE,
+                                          libspdm_transport_tcp_encode_message,
+                                          libspdm_transport_tcp_decode_message,
+                                          libspdm_transport_tcp_get_header_size);
+    libspdm_register_device_buffer_func(spdm_context,
+                                        LIBSPDM_BENCH_BUFFER_SIZE,
+                                        LIBSPDM_BENCH_BUFFER_SIZE,
+                                        libspdm_bench_acquire_sender_buffer,
+                                        libspdm_bench_release_sender_buffer,
+                                        libspdm_bench_acquire_receiver_buffer,
+                                        libspdm_bench_release_receiver_buffer);
+}
+
+static libspdm_return_t libspdm_bench_init_endpoint(libspdm_bench_endpoint_t *endpoint,
+                                                    bool is_requester, int socket_fd)
+{
+    libspdm_data_parameter_t parameter;
+    libspdm_return_t status;
+    uint8_t data8;
+    uint32_t data32;
+    void *app_context_data;
+
+    status = libspdm_init_context(endpoint->spdm_context);
+    if (LIBSPDM_STATUS_IS_ERROR(status)) {
+        return status;
+    }
+    if (!libspdm_tcp_io_init(&endpoint->tcp_io, socket_fd, endpoint->stream_buffer,
+                             sizeof(endpoint->stream_buffer))) {
+        return LIBSPDM_STATUS_INVALID_STATE_LOCAL;
+    }
+
+    if (is_requester) {
+        libspdm_register_device_io_func(endpoint->spdm_context,
+                                        libspdm_bench_requester_send_message,
+                                        libspdm_tcp_io_receive_message);
+    } else {
+        libspdm_register_device_io_func(endpoint->spdm_context,
+                                        libspdm_tcp_io_send_message,
+                                        libspdm_tcp_io_receive_message);
+        libspdm_register_get_response_func(endpoint->spdm_context,
+                                           libspdm_bench_get_response);
+    }
+    libspdm_bench_register_transport(endpoint->spdm_context);
+    libspdm_set_scratch_buffer(endpoint->spdm_context, endpoint->scratch_buffer,
+                               endpoint->scratch_buffer_size);
+
+    libspdm_zero_mem(&parameter, sizeof(parameter));
+    parameter.location = LIBSPDM_DATA_LOCATION_LOCAL;
+
+    app_context_data = endpoint;
+    status = libspdm_set_data(endpoint->spdm_context, LIBSPDM_DATA_APP_CONTEXT_DATA, &parameter,
+                              &app_context_data, sizeof(app_context_data));
+    if (LIBSPDM_STATUS_IS_ERROR(status)) {
+        return status;
+    }
+    data8 = 0;
+    libspdm_set_data(endpoint->spdm_context, LIBSPDM_DATA_CAPABILITY_CT_EXPONENT, &parameter,
+                     &data8, sizeof(data8));
+    data32 = SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_ECDSA_ECC_NIST_P256;
+    libspdm_set_data(endpoint->spdm_context, LIBSPDM_DATA_BASE_ASYM_ALGO, &parameter,
+                     &data32, sizeof(data32));
+    data32 = SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_256;
+    libspdm_set_data(endpoint->spdm_context, LIBSPDM_DATA_BASE_HASH_ALGO, &parameter,
+                     &data32, sizeof(data32));
+    return LIBSPDM_STATUS_SUCCESS;
+}
+
+/**
+ * Send a VENDOR_DEFINED_REQUEST with a payload of payload_size bytes.
+ *
+ * The request is built in the sender buffer, as the requester flows of libspdm build theirs.
+ **/
+static libspdm_return_t libspdm_bench_send_vendor_request(libspdm_context_t *spdm_context,
+                                                          size_t payload_size)
+{
+    libspdm_return_t status;
+    spdm_vendor_defined_request_msg_t *spdm_request;
+    size_t spdm_request_size;
+    size_t transport_header_size;
+    uint8_t *message;
+    size_t message_size;
+    uint16_t payload_length;
+
+    transport_header_size = spdm_context->transport_get_header_size(spdm_context);
+    status = libspdm_acquire_sender_buffer(spdm_context, &message_size, (void **)&message);
+    if (LIBSPDM_STATUS_IS_ERROR(status)) {
+        return status;
+    }
+    spdm_request = (void *)(message + transport_header_size);
+    spdm_request_size = LIBSPDM_BENCH_VENDOR_HEADER_SIZE + payload_size;
+
+    spdm_request->header.spdm_version = libspdm_get_connection_version(spdm_context);
+    spdm_request->header.request_response_code = SPDM_VENDOR_DEFINED_REQUEST;
+    spdm_request->header.param1 = 0;
+    spdm_request->header.param2 = 0;
+    spdm_request->standard_id = SPDM_REGISTRY_ID_DMTF;
+    spdm_request->len = 0;
+    payload_length = (uint16_t)payload_size;
+    memcpy(spdm_request + 1, &payload_length, sizeof(payload_length));
+    memset((uint8_t *)spdm_request + LIBSPDM_BENCH_VENDOR_HEADER_SIZE, 0x5A, payload_size);
+
+    status = libspdm_send_spdm_request(spdm_context, NULL, spdm_request_size, spdm_request);
+    libspdm_release_sender_buffer(spdm_context);
+    return status;
+}
+
+/**
+ * Receive a VENDOR_DEFINED_RESPONSE, which must have a payload of payload_size bytes.
+ **/
+static libspdm_return_t libspdm_bench_receive_vendor_response(libspdm_context_t *spdm_context,
+                                                              size_t payload_size)
+{
+    libspdm_return_t status;
+    spdm_vendor_defined_response_msg_t *spdm_response;
+    size_t spdm_response_size;
+    uint8_t *message;
+    size_t message_size;
+
+    status = libspdm_acquire_receiver_buffer(spdm_context, &message_size, (void **)&message);
+    if (LIBSPDM_STATUS_IS_ERROR(status)) {
+        return status;
+    }
+    spdm_response = (void *)message;
+    spdm_response_size = message_size;
+    status = libspdm_receive_spdm_response(spdm_context, NULL, &spdm_response_size,
+                                           (void **)&spdm_response);
+    if (LIBSPDM_STATUS_IS_SUCCESS(status)) {
+        if ((spdm_response_size != LIBSPDM_BENCH_VENDOR_HEADER_SIZE + payload_size) ||
+            (spdm_response->header.request_response_code != SPDM_VENDOR_DEFINED_RESPONSE)) {
+            status = LIBSPDM_STATUS_INVALID_MSG_FIELD;
+        }
+    }
+    libspdm_release_receiver_buffer(spdm_context);
+    return status;
+}
+
+static libspdm_return_t libspdm_bench_time(libspdm_bench_op_t op, size_t payload_size)
+{
+    libspdm_context_t *requester_context;
+    libspdm_return_t status;
+    double start_us;
+    size_t count;
+    size_t index;
+
+    requester_context = m_libspdm_bench_requester.spdm_context;
+    count = (op == LIBSPDM_BENCH_OP_ROUND_TRIP) ? 1 : LIBSPDM_BENCH_PIPELINE_DEPTH;
+    m_libspdm_bench_dispatch_on_send = (op == LIBSPDM_BENCH_OP_ROUND_TRIP);
+    status = LIBSPDM_STATUS_SUCCESS;
+
+    start_us = libspdm_bench_now_us();
+    for (index = 0; (index < count) && LIBSPDM_STATUS_IS_SUCCESS(status); index++) {
+        status = libspdm_bench_send_vendor_request(requester_context, payload_size);
+    }
+    if (!m_libspdm_bench_dispatch_on_send) {
+        for (index = 0; (index < count) && LIBSPDM_STATUS_IS_SUCCESS(status); index++) {
+            status = libspdm_responder_dispatch_message(m_libspdm_bench_responder.spdm_context);
+        }
+    }
+    for (index = 0; (index < count) && LIBSPDM_STATUS_IS_SUCCESS(status); index++) {
+        status = libspdm_bench_receive_vendor_response(requester_context, payload_size);
+    }
+    if (LIBSPDM_STATUS_IS_ERROR(status)) {
+        return status;
+    }
+    libspdm_bench_stat_add(&m_libspdm_bench_stat[op],
+                           (libspdm_bench_now_us() - start_us) / (double)count);
+    return LIBSPDM_STATUS_SUCCESS;
+}
+
+static bool libspdm_bench_run_message_size(FILE *fp, bool first, size_t message_size,
+                                           size_t iterations)
+{
+    libspdm_bench_summary_t summary;
+    libspdm_return_t status;
+    libspdm_bench_op_t failed_op;
+    int socket_fd[2];
+    size_t iteration;
+    size_t op;
+    bool first_op;
+
+    for (op = 0; op < LIBSPDM_BENCH_OP_MAX; op++) {
+        libspdm_bench_stat_reset(&m_libspdm_bench_stat[op]);
+    }
+
+    failed_op = LIBSPDM_BENCH_OP_MAX;
+    iteration = 0;
+    status = LIBSPDM_STATUS_INVALID_STATE_LOCAL;
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, socket_fd) == 0) {
+        status = libspdm_bench_init_endpoint(&m_libspdm_bench_responder, false, socket_fd[1]);
+        if (LIBSPDM_STATUS_IS_SUCCESS(status)) {
+            status = libspdm_bench_init_endpoint(&m_libspdm_bench_requester, true,
+                                                 socket_fd[0]);
+        }
+        if (LIBSPDM_STATUS_IS_SUCCESS(status)) {
+            m_libspdm_bench_dispatch_on_send = true;
+            status = libspdm_init_connection(m_libspdm_bench_requester.spdm_context, false);
+        }
+        while (LIBSPDM_STATUS_IS_SUCCESS(status) && (iteration < iterations)) {
+            for (op = 0; op < LIBSPDM_BENCH_OP_MAX; op++) {
+                status = libspdm_bench_time((libspdm_bench_op_t)op, message_size);
+                if (LIBSPDM_STATUS_IS_ERROR(status)) {
+                    failed_op = (libspdm_bench_op_t)op;
+                    break;
+                }
+            }
+            if (LIBSPDM_STATUS_IS_SUCCESS(status)) {
+                iteration++;
+            }
+        }
+        libspdm_deinit_context(m_libspdm_bench_requester.spdm_context);
+        libspdm_deinit_context(m_libspdm_bench_responder.spdm_context);
+        close(socket_fd[0]);
+        close(socket_fd[1]);
+    }
+
+    fprintf(stderr, "message_size %-5zu %s\n", message_size,
+            LIBSPDM_STATUS_IS_ERROR(status) ? "failed" : "ok");
+
+    fprintf(fp, "%s    {\n", first ? "" : ",\n");
+    fprintf(fp, "      \"message_size\": %zu,\n", message_size);
+    if (LIBSPDM_STATUS_IS_ERROR(status)) {
+        fprintf(fp, "      \"status\": \"failed\",\n");
+        fprintf(fp, "      \"error\": \"0x%08x\",\n", (uint32_t)status);
+        fprintf(fp, "      \"failed_operation\": \"%s\",\n",
+                (failed_op < LIBSPDM_BENCH_OP_MAX) ? m_libspdm_bench_op_name[failed_op] : "setup");
+        fprintf(fp, "      \"completed_iterations\": %zu,\n", iteration);
+    } else {
+        fprintf(fp, "      \"status\": \"ok\",\n");
+    }
+    fprintf(fp, "      \"operations\": {");
+    first_op = true;
+    for (op = 0; op < LIBSPDM_BENCH_OP_MAX; op++) {
+        if (m_libspdm_bench_stat[op].sample_count == 0) {
+            continue;
+        }
+        fprintf(fp, "%s\n", first_op ? "" : ",");
+        libspdm_bench_json_write_stat(fp, &m_libspdm_bench_stat[op], "        ");
+        first_op = false;
+    }
+    fprintf(fp, "%s},\n", first_op ? "" : "\n      ");
+    fprintf(fp, "      \"throughput_mbps\": {");
+    first_op = true;
+    for (op = 0; op < LIBSPDM_BENCH_OP_MAX; op++) {
+        if (m_libspdm_bench_stat[op].sample_count == 0) {
+            continue;
+        }
+        libspdm_bench_stat_summarize(&m_libspdm_bench_stat[op], &summary);
+        fprintf(fp, "%s\"%s\": %.1f", first_op ? "" : ", ", m_libspdm_bench_op_name[op],
+                (summary.mean > 0) ? (double)(2 * message_size) / summary.mean : 0.0);
+        first_op = false;
+    }
+    fprintf(fp, "}");
+    fprintf(fp, "\n    }");
+
+    return LIBSPDM_STATUS_IS_SUCCESS(status);
+}
+
+static libspdm_return_t libspdm_bench_alloc_endpoint(libspdm_bench_endpoint_t *endpoint)
+{
+    endpoint->spdm_context = malloc(libspdm_get_context_size());
+    if (endpoint->spdm_context == NULL) {
+        return LIBSPDM_STATUS_BUFFER_FULL;
+    }
+    libspdm_init_context(endpoint->spdm_context);
+    libspdm_bench_register_transport(endpoint->spdm_context);
+    endpoint->scratch_buffer_size =
+        libspdm_get_sizeof_required_scratch_buffer(endpoint->spdm_context);
+    endpoint->scratch_buffer = malloc(endpoint->scratch_buffer_size);
+    libspdm_deinit_context(endpoint->spdm_context);
+    if (endpoint->scratch_buffer == NULL) {
+        return LIBSPDM_STATUS_BUFFER_FULL;
+    }
+    return LIBSPDM_STATUS_SUCCESS;
+}
+
+int main(int argc, char **argv)
+{
+    const char *output_file;
+    size_t iterations;
+    size_t filter_message_size;
+    bool passed;
+    size_t size_index;
+    size_t op;
+    FILE *fp;
+    bool first;
+    int index;
+
+    iterations = LIBSPDM_BENCH_DEFAULT_ITERATIONS;
+    output_file = LIBSPDM_BENCH_DEFAULT_OUTPUT_FILE;
+    filter_message_size = 0;
+    passed = true;
+    for (index = 1; index + 1 < argc; index += 2) {
+        if (strcmp(argv[index], "-n") == 0) {
+            iterations = (size_t)strtoul(argv[index + 1], NULL, 0);
+        } else if (strcmp(argv[index], "-o") == 0) {
+            output_file = argv[index + 1];
+        } else if (strcmp(argv[index], "--size") == 0) {
+            filter_message_size = (size_t)strtoul(argv[index + 1], NULL, 0);
+            if (filter_message_size == 0) {
+                break;
+            }
+        } else {
+            break;
+        }
+    }
+    if ((index < argc) || (iterations == 0) ||
+        (filter_message_size > LIBSPDM_BENCH_MAX_MESSAGE_SIZE)) {
+        fprintf(stderr,
+                "usage: %s [-n iterations] [-o report.json] [--size bytes]\n"
+                "  --size is from 1 to %d\n",
+                argv[0], LIBSPDM_BENCH_MAX_MESSAGE_SIZE);
+        return 1;
+    }
+
+    if ((libspdm_bench_alloc_endpoint(&m_libspdm_bench_requester) != LIBSPDM_STATUS_SUCCESS) ||
+        (libspdm_bench_alloc_endpoint(&m_libspdm_bench_responder) != LIBSPDM_STATUS_SUCCESS)) {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+    for (op = 0; op < LIBSPDM_BENCH_OP_MAX; op++) {
+        if (!libspdm_bench_stat_init(&m_libspdm_bench_stat[op], m_libspdm_bench_op_name[op],
+                                     iterations)) {
+            fprintf(stderr, "out of memory\n");
+            return 1;
+        }
+    }
+
+    fp = stdout;
+    if (strcmp(output_file, "-") != 0) {
+        fp = fopen(output_file, "w");
+        if (fp == NULL) {
+            fprintf(stderr, "Unable to open file %s\n", output_file);
+            return 1;
+        }
+    }
+
+    fprintf(fp, "{\n");
+    fprintf(fp, "  \"benchmark\": \"spdm_tcp\",\n");
+    fprintf(fp, "  \"version\": %d,\n", LIBSPDM_BENCH_REPORT_VERSION);
+    fprintf(fp, "  \"crypto\": \"%s\",\n", LIBSPDM_BENCH_CRYPTO_NAME);
+    fprintf(fp, "  \"iterations\": %zu,\n", iterations);
+    fprintf(fp, "  \"pipeline_depth\": %d,\n", LIBSPDM_BENCH_PIPELINE_DEPTH);
+    fprintf(fp, "  \"results\": [\n");
+
+    first = true;
+    if (filter_message_size != 0) {
+        passed = libspdm_bench_run_message_size(fp, first, filter_message_size, iterations);
+        first = false;
+    } else {
+        for (size_index = 0;
+             size_index < LIBSPDM_BENCH_ARRAY_SIZE(m_libspdm_bench_message_size);
+             size_index++) {
+            passed &= libspdm_bench_run_message_size(
+                fp, first, m_libspdm_bench_message_size[size_index], iterations);
+            first = false;
+        }
+    }
+
+    fprintf(fp, "%s  ]\n}\n", first ? "" : "\n");
+    if (fp != stdout) {
+        fclose(fp);
+    }
+
+    for (op = 0; op < LIBSPDM_BENCH_OP_MAX; op++) {
+        libspdm_bench_stat_free(&m_libspdm_bench_stat[op]);
+    }
+    free(m_libspdm_bench_requester.scratch_buffer);
+    free(m_libspdm_bench_requester.spdm_context);
+    free(m_libspdm_bench_responder.scratch_buffer);
+    free(m_libspdm_bench_responder.spdm_context);
+    return passed ? 0 : 1;
+}